@@ -0,0 +1,36 @@
+#ifndef _CAPTURE_H_
+#define _CAPTURE_H_
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+
+#include "capture_stats.h"
+
+// Declara un buffer circular para DMA de 2^bits palabras, alineado a su tamaño
+#define CAPTURE_RING(name, bits) \
+    static uint32_t name[1u << (bits)] __attribute__((aligned(4u << (bits))))
+
+/**
+ * @brief Instancia de captura sobre un pin
+ */
+typedef struct {
+    PIO pio;                    // PIO usado
+    uint sm;                    // Maquina de estados
+    uint offset;                // Posicion del programa
+    int dma_chan;               // Canal de DMA que vacia el FIFO
+    int rearm_chan;             // Canal que rearma al de captura en RP2040, -1 en RP2350
+    const uint32_t *ring;       // Buffer circular de marcas de tiempo
+    uint32_t ring_mask;         // Mascara de indices del buffer
+    uint32_t read_index;        // Proxima marca a leer
+    capture_decoder_t decoder;  // Decodificador de pulsos
+} capture_t;
+
+// Prototipos de funciones
+bool capture_init(capture_t *cap, PIO pio, uint gpio, uint32_t *ring, uint ring_bits);
+void capture_stop(capture_t *cap);
+uint32_t capture_available(const capture_t *cap);
+int capture_read(capture_t *cap, capture_pulse_t *pulses, int max);
+int capture_read_stats(capture_t *cap, capture_stats_t *stats);
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef _CAPTURE_STATS_H_
+#define _CAPTURE_STATS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Ciclos de reloj por cada decremento del contador del programa PIO
+#define CAPTURE_CYCLES_PER_COUNT    2
+// Ciclos fijos de las instrucciones de cada flanco (ver capture.pio)
+#define CAPTURE_HIGH_OVERHEAD       2
+#define CAPTURE_LOW_OVERHEAD        3
+
+/**
+ * @brief Pulso completo medido en ciclos de reloj de la PIO
+ */
+typedef struct {
+    uint32_t high;      // Tiempo en alto
+    uint32_t low;       // Tiempo en bajo
+} capture_pulse_t;
+
+/**
+ * @brief Estado del decodificador de marcas de tiempo
+ */
+typedef struct {
+    uint32_t rise;      // Ultima marca de flanco ascendente
+    uint32_t fall;      // Ultima marca de flanco descendente
+    uint8_t state;      // Flancos validos que se tienen del pulso en curso
+} capture_decoder_t;
+
+/**
+ * @brief Estadisticas acumuladas de una serie de pulsos
+ */
+typedef struct {
+    uint32_t count;         // Cantidad de pulsos
+    uint64_t sum_high;      // Suma de tiempos en alto
+    uint64_t sum_period;    // Suma de periodos
+    uint32_t min_period;    // Periodo minimo
+    uint32_t max_period;    // Periodo maximo
+    uint32_t min_high;      // Tiempo en alto minimo
+    uint32_t max_high;      // Tiempo en alto maximo
+} capture_stats_t;
+
+// Prototipos de funciones
+void capture_decoder_reset(capture_decoder_t *decoder);
+bool capture_decoder_push(capture_decoder_t *decoder, uint32_t timestamp, bool rising, capture_pulse_t *pulse);
+void capture_stats_reset(capture_stats_t *stats);
+void capture_stats_add(capture_stats_t *stats, const capture_pulse_t *pulse);
+float capture_stats_frequency(const capture_stats_t *stats, uint32_t clk_hz);
+float capture_stats_duty(const capture_stats_t *stats);
+
+#endif
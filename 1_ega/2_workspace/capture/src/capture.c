@@ -0,0 +1,164 @@
+#include "capture.h"
+#include "capture.pio.h"
+
+#if !PICO_RP2350
+// Cantidad que el canal de rearmado vuelve a cargar en el canal de captura
+static const uint32_t capture_rearm_count = UINT32_MAX;
+#endif
+
+/**
+ * @brief Devuelve el indice del buffer que va a escribir el DMA
+ * @param cap puntero a la instancia
+ * @return indice de la proxima palabra que escribe el DMA
+ */
+static inline uint32_t capture_write_index(const capture_t *cap) {
+    uintptr_t addr = dma_channel_hw_addr(cap->dma_chan)->write_addr;
+    return (uint32_t)((addr - (uintptr_t)cap->ring) / sizeof(uint32_t)) & cap->ring_mask;
+}
+
+/**
+ * @brief Inicializa la captura de pulsos en un pin. La PIO marca cada flanco y
+ * el DMA mueve las marcas al buffer circular, sin intervencion del CPU
+ * @param cap puntero a la instancia
+ * @param pio PIO a usar (pio0 o pio1)
+ * @param gpio GPIO de entrada
+ * @param ring buffer declarado con CAPTURE_RING
+ * @param ring_bits log2 de la cantidad de palabras del buffer (1 a 13)
+ * @return true si habia maquina de estados, memoria de instrucciones y DMA libres
+ * (dos canales en RP2040)
+ */
+bool capture_init(capture_t *cap, PIO pio, uint gpio, uint32_t *ring, uint ring_bits) {
+    // El DMA admite buffers circulares de hasta 2^15 bytes
+    if (ring_bits < 1 || ring_bits > 13) { return false; }
+    if (!pio_can_add_program(pio, &capture_program)) { return false; }
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) { return false; }
+    int chan = dma_claim_unused_channel(false);
+    if (chan < 0) {
+        pio_sm_unclaim(pio, sm);
+        return false;
+    }
+#if PICO_RP2350
+    int rearm = -1;
+#else
+    int rearm = dma_claim_unused_channel(false);
+    if (rearm < 0) {
+        dma_channel_unclaim(chan);
+        pio_sm_unclaim(pio, sm);
+        return false;
+    }
+#endif
+
+    cap->pio = pio;
+    cap->sm = sm;
+    cap->offset = pio_add_program(pio, &capture_program);
+    cap->dma_chan = chan;
+    cap->rearm_chan = rearm;
+    cap->ring = ring;
+    cap->ring_mask = (1u << ring_bits) - 1;
+    cap->read_index = 0;
+    capture_decoder_reset(&cap->decoder);
+
+    capture_program_init(pio, sm, cap->offset, gpio);
+
+    // DMA desde el FIFO de RX al buffer circular, pedido por la PIO
+    dma_channel_config c = dma_channel_get_default_config(chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, ring_bits + 2);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, false));
+#if PICO_RP2350
+    // En RP2350 el canal puede transferir indefinidamente
+    uint32_t count = dma_encode_endless_transfer_count();
+#else
+    // En RP2040 la cuenta se termina despues de 2^32 marcas (mas de 5 horas a 100 kHz).
+    // Al terminar se encadena al segundo canal, que carga otra vez la cuenta y lo dispara.
+    // La direccion de escritura sigue donde estaba dentro del buffer circular
+    uint32_t count = capture_rearm_count;
+    channel_config_set_chain_to(&c, rearm);
+
+    dma_channel_config r = dma_channel_get_default_config(rearm);
+    channel_config_set_transfer_data_size(&r, DMA_SIZE_32);
+    channel_config_set_read_increment(&r, false);
+    channel_config_set_write_increment(&r, false);
+    dma_channel_configure(rearm, &r, &dma_hw->ch[chan].al1_transfer_count_trig, &capture_rearm_count, 1, false);
+#endif
+    dma_channel_configure(chan, &c, ring, &pio->rxf[sm], count, true);
+
+    pio_sm_set_enabled(pio, sm, true);
+    return true;
+}
+
+/**
+ * @brief Detiene la captura y libera los recursos
+ * @param cap puntero a la instancia
+ */
+void capture_stop(capture_t *cap) {
+    pio_sm_set_enabled(cap->pio, cap->sm, false);
+    if (cap->rearm_chan >= 0) {
+        // Primero el que rearma, para que no vuelva a disparar al de captura
+        dma_channel_abort(cap->rearm_chan);
+        dma_channel_unclaim(cap->rearm_chan);
+    }
+    dma_channel_abort(cap->dma_chan);
+    dma_channel_unclaim(cap->dma_chan);
+    pio_remove_program(cap->pio, &capture_program, cap->offset);
+    pio_sm_unclaim(cap->pio, cap->sm);
+}
+
+/**
+ * @brief Cantidad de marcas de tiempo sin leer en el buffer
+ * @param cap puntero a la instancia
+ * @return marcas pendientes. Si se leen con menos frecuencia que el
+ * tamaño del buffer, las mas viejas se pisan
+ */
+uint32_t capture_available(const capture_t *cap) {
+    return (capture_write_index(cap) - cap->read_index) & cap->ring_mask;
+}
+
+/**
+ * @brief Lee los pulsos completos que haya en el buffer
+ * @param cap puntero a la instancia
+ * @param pulses arreglo donde guardar los pulsos
+ * @param max tamaño del arreglo
+ * @return cantidad de pulsos leidos
+ */
+int capture_read(capture_t *cap, capture_pulse_t *pulses, int max) {
+    uint32_t end = capture_write_index(cap);
+    int count = 0;
+
+    while (cap->read_index != end && count < max) {
+        // La PIO alterna siempre, las posiciones pares son flancos ascendentes
+        uint32_t index = cap->read_index;
+        if (capture_decoder_push(&cap->decoder, cap->ring[index], !(index & 1), &pulses[count])) {
+            count++;
+        }
+        cap->read_index = (index + 1) & cap->ring_mask;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Agrega a las estadisticas todos los pulsos pendientes, sin copiarlos
+ * @param cap puntero a la instancia
+ * @param stats puntero a las estadisticas
+ * @return cantidad de pulsos agregados
+ */
+int capture_read_stats(capture_t *cap, capture_stats_t *stats) {
+    uint32_t end = capture_write_index(cap);
+    capture_pulse_t pulse;
+    int count = 0;
+
+    while (cap->read_index != end) {
+        uint32_t index = cap->read_index;
+        if (capture_decoder_push(&cap->decoder, cap->ring[index], !(index & 1), &pulse)) {
+            capture_stats_add(stats, &pulse);
+            count++;
+        }
+        cap->read_index = (index + 1) & cap->ring_mask;
+    }
+
+    return count;
+}
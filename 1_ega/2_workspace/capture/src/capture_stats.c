@@ -0,0 +1,99 @@
+#include "capture_stats.h"
+
+// Estados del decodificador
+#define DECODER_EMPTY   0
+#define DECODER_RISE    1
+#define DECODER_FALL    2
+
+/**
+ * @brief Reinicia el decodificador, descarta el pulso en curso
+ * @param decoder puntero al decodificador
+ */
+void capture_decoder_reset(capture_decoder_t *decoder) {
+    decoder->rise = 0;
+    decoder->fall = 0;
+    decoder->state = DECODER_EMPTY;
+}
+
+/**
+ * @brief Procesa una marca de tiempo del programa PIO
+ * @param decoder puntero al decodificador
+ * @param timestamp valor del contador descendente en el flanco
+ * @param rising true si es un flanco ascendente
+ * @param pulse puntero donde se guarda el pulso si se completo
+ * @return true si la marca completo un pulso (ascendente, descendente, ascendente)
+ */
+bool capture_decoder_push(capture_decoder_t *decoder, uint32_t timestamp, bool rising, capture_pulse_t *pulse) {
+    bool complete = false;
+
+    // El contador baja sin dar la vuelta dentro de un pulso. Una marca que no es menor
+    // que la anterior viene de una resincronizacion de la PIO y el pulso se descarta
+    if (rising) {
+        if (decoder->state == DECODER_FALL && timestamp < decoder->fall) {
+            pulse->high = (decoder->rise - decoder->fall) * CAPTURE_CYCLES_PER_COUNT + CAPTURE_HIGH_OVERHEAD;
+            pulse->low = (decoder->fall - timestamp) * CAPTURE_CYCLES_PER_COUNT + CAPTURE_LOW_OVERHEAD;
+            complete = true;
+        }
+        decoder->rise = timestamp;
+        decoder->state = DECODER_RISE;
+    } else if (decoder->state == DECODER_RISE && timestamp < decoder->rise) {
+        decoder->fall = timestamp;
+        decoder->state = DECODER_FALL;
+    } else {
+        decoder->state = DECODER_EMPTY;
+    }
+
+    return complete;
+}
+
+/**
+ * @brief Reinicia las estadisticas
+ * @param stats puntero a las estadisticas
+ */
+void capture_stats_reset(capture_stats_t *stats) {
+    stats->count = 0;
+    stats->sum_high = 0;
+    stats->sum_period = 0;
+    stats->min_period = UINT32_MAX;
+    stats->max_period = 0;
+    stats->min_high = UINT32_MAX;
+    stats->max_high = 0;
+}
+
+/**
+ * @brief Agrega un pulso a las estadisticas, costo constante por pulso
+ * @param stats puntero a las estadisticas
+ * @param pulse puntero al pulso medido
+ */
+void capture_stats_add(capture_stats_t *stats, const capture_pulse_t *pulse) {
+    uint32_t period = pulse->high + pulse->low;
+
+    stats->count++;
+    stats->sum_high += pulse->high;
+    stats->sum_period += period;
+    if (period < stats->min_period) { stats->min_period = period; }
+    if (period > stats->max_period) { stats->max_period = period; }
+    if (pulse->high < stats->min_high) { stats->min_high = pulse->high; }
+    if (pulse->high > stats->max_high) { stats->max_high = pulse->high; }
+}
+
+/**
+ * @brief Frecuencia media de los pulsos acumulados
+ * @param stats puntero a las estadisticas
+ * @param clk_hz frecuencia de reloj de la PIO en Hz
+ * @return frecuencia en Hz o 0 si no hay pulsos
+ */
+float capture_stats_frequency(const capture_stats_t *stats, uint32_t clk_hz) {
+    if (!stats->sum_period) { return 0.0f; }
+    return (float)((double)clk_hz * stats->count / stats->sum_period);
+}
+
+/**
+ * @brief Ciclo de actividad medio de los pulsos acumulados
+ * @param stats puntero a las estadisticas
+ * @return ciclo de actividad entre 0 y 1 o 0 si no hay pulsos
+ */
+float capture_stats_duty(const capture_stats_t *stats) {
+    if (!stats->sum_period) { return 0.0f; }
+    return (float)((double)stats->sum_high / stats->sum_period);
+}
@@ -0,0 +1,225 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "check.h"
+#include "capture_stats.h"
+
+#define MAX_PULSES      2000
+#define MAX_MARKS       (2 * MAX_PULSES + 16)
+
+/**
+ * @brief Señal de prueba: un tiempo en bajo inicial y despues pulsos, en ciclos
+ */
+typedef struct {
+    uint32_t idle;
+    uint32_t high[MAX_PULSES];
+    uint32_t low[MAX_PULSES];
+    int count;
+} signal_t;
+
+/**
+ * @brief Modelo de la maquina de estados de capture.pio, una instruccion por ciclo
+ */
+typedef struct {
+    uint32_t x_start;       // Valor de mov x, ~null; mas chico para probar el fin del contador
+    uint32_t marks[MAX_MARKS];
+    int count;
+} model_t;
+
+/**
+ * @brief Recorrido de la señal ciclo a ciclo, sin volver a sumar los pulsos anteriores
+ */
+typedef struct {
+    const signal_t *signal;
+    int pulse;              // Pulso en curso, -1 en el bajo inicial
+    bool high;              // Mitad del pulso en curso
+    uint64_t left;          // Ciclos que quedan de esa mitad
+} cursor_t;
+
+static bool cursor_next(cursor_t *cursor) {
+    while (!cursor->left) {
+        if (cursor->high) {
+            cursor->high = false;
+            cursor->left = cursor->signal->low[cursor->pulse];
+        } else if (cursor->pulse + 1 < cursor->signal->count) {
+            cursor->high = true;
+            cursor->left = cursor->signal->high[++cursor->pulse];
+        } else {
+            return false;       // Despues del ultimo pulso queda en bajo
+        }
+    }
+    cursor->left--;
+    return cursor->high;
+}
+
+/**
+ * @brief Ejecuta el programa durante toda la señal. Los numeros de instruccion y los
+ * saltos son los de capture.pio, el FIFO nunca se llena (lo vacia el DMA)
+ */
+static void model_run(model_t *model, const signal_t *signal) {
+    uint64_t total = signal->idle + 16;
+    for (int i = 0; i < signal->count; i++) { total += signal->high[i] + signal->low[i]; }
+
+    cursor_t cursor = { signal, -1, false, signal->idle };
+    uint32_t x = 0;
+    int pc = 0;
+    model->count = 0;
+    for (uint64_t cycle = 0; cycle < total && model->count < MAX_MARKS; cycle++) {
+        bool pin = cursor_next(&cursor);
+        switch (pc) {
+        case 0: x = model->x_start; pc = 1; break;                  // sync: mov x, ~null
+        case 1: if (!pin) { pc = 2; } break;                        // wait 0 pin 0
+        case 2: if (pin) { pc = 3; } break;                         // wait 1 pin 0
+        case 3: model->marks[model->count++] = x; pc = 4; break;    // rise: in x, 32
+        case 4: pc = pin ? 6 : 5; break;                            // high: jmp pin high_dec
+        case 5: pc = 9; break;                                      // jmp fall
+        case 6: pc = x ? 4 : 7; x--; break;                         // high_dec: jmp x-- high
+        case 7: model->marks[model->count++] = 0; pc = 8; break;    // in null, 32
+        case 8: pc = 0; break;                                      // jmp sync
+        case 9: model->marks[model->count++] = x; pc = 10; break;   // fall: in x, 32
+        case 10: pc = pin ? 3 : 11; break;                          // low: jmp pin rise
+        case 11: pc = x ? 10 : 0; x--; break;                       // jmp x-- low, .wrap
+        }
+    }
+}
+
+// Decodifica las marcas como capture_read: las posiciones pares son flancos ascendentes
+static int decode(const model_t *model, capture_pulse_t *pulses, int max) {
+    capture_decoder_t decoder;
+    int count = 0;
+
+    capture_decoder_reset(&decoder);
+    for (int i = 0; i < model->count && count < max; i++) {
+        if (capture_decoder_push(&decoder, model->marks[i], !(i & 1), &pulses[count])) { count++; }
+    }
+    return count;
+}
+
+// Generador congruencial, la señal es siempre la misma
+static uint32_t seed = 2024;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+static signal_t signal;
+static model_t model;
+static capture_pulse_t pulses[MAX_PULSES];
+
+// Cada pulso se mide con el error de la resolucion, 2 ciclos, y sin error acumulado
+static void test_random_pulses(void) {
+    signal.idle = 37;
+    signal.count = MAX_PULSES;
+    for (int i = 0; i < signal.count; i++) {
+        // Pulsos de 8 ciclos (53 ns) a 2000 ciclos
+        signal.high[i] = 8 + next_random() % 2000;
+        signal.low[i] = 8 + next_random() % 2000;
+    }
+    model.x_start = UINT32_MAX;
+    model_run(&model, &signal);
+
+    // El ultimo pulso no se completa hasta el flanco siguiente
+    int count = decode(&model, pulses, MAX_PULSES);
+    CHECK_EQ(count, MAX_PULSES - 1);
+
+    int32_t high_error = 0, low_error = 0, max_error = 0;
+    capture_stats_t stats;
+    capture_stats_reset(&stats);
+    uint64_t sum_high = 0, sum_period = 0;
+    for (int i = 0; i < count; i++) {
+        int32_t eh = (int32_t)pulses[i].high - (int32_t)signal.high[i];
+        int32_t el = (int32_t)pulses[i].low - (int32_t)signal.low[i];
+        if (eh < -max_error || eh > max_error) { max_error = eh < 0 ? -eh : eh; }
+        if (el < -max_error || el > max_error) { max_error = el < 0 ? -el : el; }
+        high_error += eh;
+        low_error += el;
+        capture_stats_add(&stats, &pulses[i]);
+        sum_high += signal.high[i];
+        sum_period += signal.high[i] + signal.low[i];
+    }
+    printf("error maximo por flanco %ld ciclos, acumulado alto %ld bajo %ld\n",
+           (long)max_error, (long)high_error, (long)low_error);
+    CHECK(max_error <= CAPTURE_CYCLES_PER_COUNT);
+    // Los errores de cada flanco se compensan, el periodo total no acumula
+    CHECK(high_error + low_error >= -CAPTURE_CYCLES_PER_COUNT && high_error + low_error <= CAPTURE_CYCLES_PER_COUNT);
+    CHECK(high_error >= -CAPTURE_CYCLES_PER_COUNT * count / 4 && high_error <= CAPTURE_CYCLES_PER_COUNT * count / 4);
+
+    // Las estadisticas contra la señal
+    CHECK_EQ(stats.count, count);
+    CHECK(stats.sum_period + 2 >= sum_period && stats.sum_period <= sum_period + 2);
+    float duty = capture_stats_duty(&stats);
+    float expected = (float)sum_high / (float)sum_period;
+    CHECK(duty > expected - 0.001f && duty < expected + 0.001f);
+    float freq = capture_stats_frequency(&stats, 150000000);
+    expected = 150e6f * count / (float)sum_period;
+    CHECK(freq > expected * 0.9999f && freq < expected * 1.0001f);
+}
+
+// Una señal fija da siempre el mismo pulso
+static void test_fixed(void) {
+    capture_stats_t stats;
+
+    // 100 kHz al 30% con el reloj de 150 MHz: 450 ciclos en alto y 1050 en bajo
+    signal.idle = 100;
+    signal.count = 50;
+    for (int i = 0; i < signal.count; i++) { signal.high[i] = 450; signal.low[i] = 1050; }
+    model.x_start = UINT32_MAX;
+    model_run(&model, &signal);
+
+    int count = decode(&model, pulses, MAX_PULSES);
+    CHECK_EQ(count, 49);
+    capture_stats_reset(&stats);
+    for (int i = 0; i < count; i++) { capture_stats_add(&stats, &pulses[i]); }
+    CHECK(stats.max_period - stats.min_period <= CAPTURE_CYCLES_PER_COUNT);
+    CHECK(stats.max_high - stats.min_high <= CAPTURE_CYCLES_PER_COUNT);
+    float freq = capture_stats_frequency(&stats, 150000000);
+    CHECK(freq > 99900.0f && freq < 100100.0f);
+    float duty = capture_stats_duty(&stats);
+    CHECK(duty > 0.299f && duty < 0.301f);
+}
+
+// Con el contador agotado en alto o en bajo no aparecen pulsos falsos, y despues
+// de resincronizar se sigue midiendo
+static void test_counter_end(void) {
+    // Contador de 1000 cuentas, 2000 ciclos
+    model.x_start = 1000;
+    signal.idle = 10;
+    signal.count = 0;
+    for (int i = 0; i < 5; i++, signal.count++) { signal.high[signal.count] = 300; signal.low[signal.count] = 300; }
+    // Alto mas largo que el contador
+    signal.high[signal.count] = 5000; signal.low[signal.count++] = 300;
+    for (int i = 0; i < 5; i++, signal.count++) { signal.high[signal.count] = 200; signal.low[signal.count] = 400; }
+    // Bajo mas largo que el contador
+    signal.high[signal.count] = 200; signal.low[signal.count++] = 7000;
+    for (int i = 0; i < 5; i++, signal.count++) { signal.high[signal.count] = 100; signal.low[signal.count] = 500; }
+    model_run(&model, &signal);
+
+    // El contador se reinicia en cada resincronizacion, pero dentro de los pulsos
+    // cortos llega a cero igual: solo se cuentan los pulsos bien medidos
+    int count = decode(&model, pulses, MAX_PULSES);
+    CHECK(count > 0);
+    for (int i = 0; i < count; i++) {
+        uint32_t period = pulses[i].high + pulses[i].low;
+        CHECK(period >= 600 - 2 * CAPTURE_CYCLES_PER_COUNT && period <= 600 + 2 * CAPTURE_CYCLES_PER_COUNT);
+        CHECK(pulses[i].high <= 300 + CAPTURE_CYCLES_PER_COUNT);
+    }
+
+    // La marca 0 del alto agotado tiene que estar en una posicion impar
+    bool zero = false;
+    for (int i = 0; i < model.count; i++) {
+        if (!model.marks[i]) {
+            zero = true;
+            CHECK(i & 1);
+        }
+    }
+    CHECK(zero);
+}
+
+int main(void) {
+    test_random_pulses();
+    test_fixed();
+    test_counter_end();
+    return check_result("capture");
+}
@@ -0,0 +1,49 @@
+#ifndef _RIPPLE_H_
+#define _RIPPLE_H_
+
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "ripple_fft.h"
+
+// Los tamaños de stack que genera stack_usage.py reemplazan a los de la biblioteca
+#if __has_include("task_stacks.h")
+#include "task_stacks.h"
+#endif
+
+#ifndef RIPPLE_TASK_STACK
+#define RIPPLE_TASK_STACK       (configMINIMAL_STACK_SIZE + 128)
+#endif
+
+// Frecuencia maxima de muestreo del ADC
+#define RIPPLE_FS_MAX_HZ        500000.0f
+
+/**
+ * @brief Configuracion del analizador
+ */
+typedef struct {
+    uint adc_input;             // Entrada del ADC (0 a 3, GP26 a GP29)
+    ripple_params_t params;     // Frecuencias y escala de la medicion
+    uint32_t budget_us;         // Tiempo de CPU por segundo que puede usar el analisis
+    uint32_t min_period_ms;     // Periodo minimo entre analisis
+    void (*report)(const ripple_result_t *result, void *context);   // Se llama desde la tarea con cada resultado
+    void *context;              // Argumento de report
+} ripple_config_t;
+
+/**
+ * @brief Tiempos del analizador
+ */
+typedef struct {
+    uint32_t runs;              // Bloques analizados
+    uint32_t last_us;           // Duracion del ultimo analisis
+    uint32_t max_us;            // Duracion maxima
+    uint32_t period_ms;         // Periodo que resulta del presupuesto
+} ripple_stats_t;
+
+// Prototipos de funciones
+bool ripple_start(const ripple_config_t *config, UBaseType_t priority);
+void ripple_get_stats(ripple_stats_t *stats);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef _RIPPLE_FFT_H_
+#define _RIPPLE_FFT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Largo de la FFT, potencia de 4 para la base 4: 4^5 = 1024 puntos
+#define RIPPLE_FFT_LOG4         5
+#define RIPPLE_FFT_SIZE         (1u << (2 * RIPPLE_FFT_LOG4))
+
+// Armonicos de la frecuencia del PWM que se informan
+#define RIPPLE_HARMONICS        4
+
+// Bins de cada lado del pico que suma la ventana de Hann
+#define RIPPLE_LOBE_BINS        2
+
+/**
+ * @brief Parametros de la medicion
+ */
+typedef struct {
+    float fs_hz;                // Frecuencia de muestreo del ADC
+    float pwm_hz;               // Frecuencia de conmutacion del convertidor
+    float mv_per_lsb;           // mV en la salida por cuenta del ADC, con el divisor
+} ripple_params_t;
+
+/**
+ * @brief Resultado del analisis de un bloque. Las amplitudes son de pico
+ */
+typedef struct {
+    float dc_mv;                            // Valor medio
+    float vpp_mv;                           // Rizado pico a pico
+    float rms_mv;                           // Valor eficaz sin la continua
+    float peak_hz;                          // Frecuencia de la componente dominante
+    float peak_mv;                          // Amplitud de la componente dominante
+    float harmonic_mv[RIPPLE_HARMONICS];    // Amplitud en 1, 2, ... veces la frecuencia del PWM, NAN si
+                                            // se refleja sobre un armonico anterior
+} ripple_result_t;
+
+// Prototipos de funciones
+void ripple_fft_init(void);
+void ripple_fft(int16_t *data);
+void ripple_analyze(const uint16_t *raw, int16_t *work, const ripple_params_t *params, ripple_result_t *result);
+void ripple_format_lcd(const ripple_result_t *result, const ripple_params_t *params, char *line1, char *line2, size_t len);
+
+#endif
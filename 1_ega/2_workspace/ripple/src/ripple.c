@@ -0,0 +1,98 @@
+#include "ripple.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+// Configuracion, canal de DMA y tiempos de la tarea
+static ripple_config_t ripple_config;
+static int ripple_dma;
+static ripple_stats_t ripple_stats;
+
+// Bloque que llena el DMA y espacio de trabajo de la FFT
+static uint16_t ripple_raw[RIPPLE_FFT_SIZE];
+static int16_t ripple_work[2 * RIPPLE_FFT_SIZE];
+
+/**
+ * @brief Captura un bloque con el DMA. La tarea duerme mientras el ADC
+ * convierte, la captura no cuenta en el presupuesto
+ */
+static void ripple_capture(void) {
+    adc_select_input(ripple_config.adc_input);
+    adc_fifo_drain();
+    dma_channel_set_write_addr(ripple_dma, ripple_raw, false);
+    dma_channel_set_trans_count(ripple_dma, RIPPLE_FFT_SIZE, true);
+    adc_run(true);
+    while (dma_channel_is_busy(ripple_dma)) { vTaskDelay(1); }
+    adc_run(false);
+}
+
+/**
+ * @brief Tarea del analizador: captura, analiza e informa, y despues espera lo
+ * necesario para no pasarse del presupuesto de CPU
+ */
+static void ripple_task(void *params) {
+    ripple_result_t result;
+
+    while (1) {
+        ripple_capture();
+
+        uint32_t start = time_us_32();
+        ripple_analyze(ripple_raw, ripple_work, &ripple_config.params, &result);
+        uint32_t elapsed = time_us_32() - start;
+
+        // Con elapsed us por analisis, el presupuesto alcanza para un analisis cada elapsed / budget segundos
+        uint32_t period_ms = (uint32_t)((uint64_t)elapsed * 1000 / ripple_config.budget_us) + 1;
+        if (period_ms < ripple_config.min_period_ms) { period_ms = ripple_config.min_period_ms; }
+        ripple_stats.runs++;
+        ripple_stats.last_us = elapsed;
+        if (elapsed > ripple_stats.max_us) { ripple_stats.max_us = elapsed; }
+        ripple_stats.period_ms = period_ms;
+
+        if (ripple_config.report) { ripple_config.report(&result, ripple_config.context); }
+        vTaskDelay(pdMS_TO_TICKS(period_ms));
+    }
+}
+
+/**
+ * @brief Configura el ADC y el DMA y crea la tarea del analizador
+ * @param config configuracion, se copia
+ * @param priority prioridad de la tarea, conviene que sea baja
+ * @return true si habia un canal de DMA libre y se pudo crear la tarea
+ */
+bool ripple_start(const ripple_config_t *config, UBaseType_t priority) {
+    if (config->adc_input > 3 || !config->budget_us) { return false; }
+    if (config->params.fs_hz <= 0.0f || config->params.fs_hz > RIPPLE_FS_MAX_HZ) { return false; }
+    ripple_dma = dma_claim_unused_channel(false);
+    if (ripple_dma < 0) { return false; }
+    ripple_config = *config;
+    ripple_fft_init();
+
+    // ADC en modo continuo, cada conversion va al FIFO y de ahi al DMA
+    adc_init();
+    adc_gpio_init(26 + config->adc_input);
+    adc_fifo_setup(true, true, 1, false, false);
+    // El ADC convierte una muestra cada 96 ciclos de su reloj de 48 MHz como minimo
+    adc_set_clkdiv(48000000.0f / config->params.fs_hz - 1.0f);
+
+    dma_channel_config c = dma_channel_get_default_config(ripple_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    dma_channel_configure(ripple_dma, &c, ripple_raw, &adc_hw->fifo, RIPPLE_FFT_SIZE, false);
+
+    if (xTaskCreate(ripple_task, "Ripple", RIPPLE_TASK_STACK, NULL, priority, NULL) != pdPASS) {
+        dma_channel_unclaim(ripple_dma);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Copia los tiempos del analizador
+ * @param stats destino de la copia
+ */
+void ripple_get_stats(ripple_stats_t *stats) {
+    taskENTER_CRITICAL();
+    *stats = ripple_stats;
+    taskEXIT_CRITICAL();
+}
@@ -0,0 +1,210 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "ripple_fft.h"
+
+// M_PI no esta definido en C11 estricto
+#define RIPPLE_PI   3.14159265358979323846f
+
+// Ventana de Hann y factores W^k = cos - j sen de la FFT, en Q15
+static int16_t window[RIPPLE_FFT_SIZE];
+static int16_t twiddle[2 * (3 * RIPPLE_FFT_SIZE / 4)];
+
+/**
+ * @brief Satura a 16 bits
+ */
+static inline int16_t ripple_sat16(int32_t v) {
+    return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (int16_t)v;
+}
+
+/**
+ * @brief Calcula la ventana y los factores de la FFT. Se llama una vez, antes
+ * del primer analisis
+ */
+void ripple_fft_init(void) {
+    for (uint32_t i = 0; i < RIPPLE_FFT_SIZE; i++) {
+        window[i] = ripple_sat16(lroundf(32768.0f * 0.5f * (1.0f - cosf(2.0f * RIPPLE_PI * i / RIPPLE_FFT_SIZE))));
+    }
+    for (uint32_t k = 0; k < 3 * RIPPLE_FFT_SIZE / 4; k++) {
+        float angle = 2.0f * RIPPLE_PI * k / RIPPLE_FFT_SIZE;
+        twiddle[2 * k] = ripple_sat16(lroundf(32768.0f * cosf(angle)));
+        twiddle[2 * k + 1] = ripple_sat16(lroundf(-32768.0f * sinf(angle)));
+    }
+}
+
+/**
+ * @brief FFT compleja en el lugar, base 4 con decimacion en frecuencia. Cada
+ * etapa divide por 4, el resultado queda dividido por RIPPLE_FFT_SIZE y el
+ * modulo nunca crece, asi que no puede desbordar
+ * @param data RIPPLE_FFT_SIZE pares real, imaginario en Q15, en orden natural
+ */
+void ripple_fft(int16_t *data) {
+    for (uint32_t span = RIPPLE_FFT_SIZE, stride = 1; span >= 4; span /= 4, stride *= 4) {
+        uint32_t quarter = span / 4;
+
+        for (uint32_t j = 0; j < quarter; j++) {
+            const int16_t *w1 = twiddle + 2 * (j * stride);
+            const int16_t *w2 = twiddle + 2 * (2 * j * stride);
+            const int16_t *w3 = twiddle + 2 * (3 * j * stride);
+
+            for (uint32_t base = j; base < RIPPLE_FFT_SIZE; base += span) {
+                int16_t *a = data + 2 * base;
+                int16_t *b = a + 2 * quarter;
+                int16_t *c = b + 2 * quarter;
+                int16_t *d = c + 2 * quarter;
+
+                // Mariposa: y0 = a + b + c + d, y1 = a - jb - c + jd, y2 = a - b + c - d, y3 = a + jb - c - jd
+                int32_t t0r = a[0] + c[0], t0i = a[1] + c[1];
+                int32_t t1r = a[0] - c[0], t1i = a[1] - c[1];
+                int32_t t2r = b[0] + d[0], t2i = b[1] + d[1];
+                int32_t t3r = b[0] - d[0], t3i = b[1] - d[1];
+                int32_t y1r = (t1r + t3i + 2) >> 2, y1i = (t1i - t3r + 2) >> 2;
+                int32_t y2r = (t0r - t2r + 2) >> 2, y2i = (t0i - t2i + 2) >> 2;
+                int32_t y3r = (t1r - t3i + 2) >> 2, y3i = (t1i + t3r + 2) >> 2;
+
+                a[0] = ripple_sat16((t0r + t2r + 2) >> 2);
+                a[1] = ripple_sat16((t0i + t2i + 2) >> 2);
+                // Las salidas 1 a 3 se rotan con W^(r j)
+                b[0] = ripple_sat16((y1r * w1[0] - y1i * w1[1] + (1 << 14)) >> 15);
+                b[1] = ripple_sat16((y1r * w1[1] + y1i * w1[0] + (1 << 14)) >> 15);
+                c[0] = ripple_sat16((y2r * w2[0] - y2i * w2[1] + (1 << 14)) >> 15);
+                c[1] = ripple_sat16((y2r * w2[1] + y2i * w2[0] + (1 << 14)) >> 15);
+                d[0] = ripple_sat16((y3r * w3[0] - y3i * w3[1] + (1 << 14)) >> 15);
+                d[1] = ripple_sat16((y3r * w3[1] + y3i * w3[0] + (1 << 14)) >> 15);
+            }
+        }
+    }
+
+    // Las salidas quedan con los digitos en base 4 invertidos
+    for (uint32_t i = 0; i < RIPPLE_FFT_SIZE; i++) {
+        uint32_t rev = 0;
+        for (uint32_t n = i, k = 0; k < RIPPLE_FFT_LOG4; k++, n >>= 2) { rev = (rev << 2) | (n & 3); }
+        if (rev > i) {
+            int16_t re = data[2 * i], im = data[2 * i + 1];
+            data[2 * i] = data[2 * rev];
+            data[2 * i + 1] = data[2 * rev + 1];
+            data[2 * rev] = re;
+            data[2 * rev + 1] = im;
+        }
+    }
+}
+
+/**
+ * @brief Potencia de un bin
+ */
+static inline uint32_t ripple_power(const int16_t *spectrum, uint32_t k) {
+    int32_t re = spectrum[2 * k], im = spectrum[2 * k + 1];
+    return (uint32_t)(re * re) + (uint32_t)(im * im);
+}
+
+/**
+ * @brief Energia del lobulo principal alrededor de un bin. Con la ventana de
+ * Hann, un tono de amplitud A deja A^2 3/32 en los 5 bins, sin importar donde
+ * cae entre dos bins
+ */
+static float ripple_lobe_energy(const int16_t *spectrum, uint32_t k) {
+    float energy = 0.0f;
+    for (uint32_t i = k - RIPPLE_LOBE_BINS; i <= k + RIPPLE_LOBE_BINS; i++) { energy += (float)ripple_power(spectrum, i); }
+    return energy;
+}
+
+/**
+ * @brief Bin mas alto en un rango, sin salir de la mitad positiva del espectro
+ */
+static uint32_t ripple_peak_bin(const int16_t *spectrum, int32_t from, int32_t to) {
+    const int32_t lo = RIPPLE_LOBE_BINS + 1, hi = RIPPLE_FFT_SIZE / 2 - RIPPLE_LOBE_BINS;
+    uint32_t best = from < lo ? lo : from, best_power = 0;
+
+    for (int32_t k = from < lo ? lo : from; k <= (to > hi ? hi : to); k++) {
+        uint32_t power = ripple_power(spectrum, k);
+        if (power > best_power) {
+            best_power = power;
+            best = k;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Analiza un bloque de muestras del ADC: valor medio, pico a pico y
+ * eficaz en el tiempo, componente dominante y armonicos del PWM en frecuencia
+ * @param raw RIPPLE_FFT_SIZE muestras de 12 bits como las deja el DMA
+ * @param work 2 * RIPPLE_FFT_SIZE valores de trabajo para la FFT
+ * @param params frecuencias y escala de la medicion
+ * @param result resultado del analisis
+ */
+void ripple_analyze(const uint16_t *raw, int16_t *work, const ripple_params_t *params, ripple_result_t *result) {
+    const float bin_hz = params->fs_hz / RIPPLE_FFT_SIZE;
+    int64_t sum = 0, sum_sq = 0;
+    int32_t min = 0x0FFF, max = 0;
+
+    // Estadisticas en el tiempo, exactas en enteros
+    for (uint32_t i = 0; i < RIPPLE_FFT_SIZE; i++) {
+        int32_t x = raw[i] & 0x0FFF;
+        sum += x;
+        sum_sq += x * x;
+        if (x < min) { min = x; }
+        if (x > max) { max = x; }
+    }
+    result->dc_mv = (float)sum / RIPPLE_FFT_SIZE * params->mv_per_lsb;
+    result->vpp_mv = (float)(max - min) * params->mv_per_lsb;
+    result->rms_mv = sqrtf((float)(sum_sq * RIPPLE_FFT_SIZE - sum * sum)) / RIPPLE_FFT_SIZE * params->mv_per_lsb;
+    result->peak_hz = 0.0f;
+    result->peak_mv = 0.0f;
+    for (int h = 0; h < RIPPLE_HARMONICS; h++) { result->harmonic_mv[h] = 0.0f; }
+    if (max == min) { return; }
+
+    // Sin la continua y escalado para usar todo el rango de la FFT, asi un rizado
+    // de pocas cuentas no se pierde en el redondeo de las etapas
+    int32_t mean = (int32_t)(sum / RIPPLE_FFT_SIZE);
+    int32_t deviation = max - mean > mean - min ? max - mean + 1 : mean - min + 1;
+    int shift = 0;
+    while ((deviation << (shift + 1)) < (1 << 14)) { shift++; }
+    int32_t offset = (int32_t)(((sum << shift) + RIPPLE_FFT_SIZE / 2) / RIPPLE_FFT_SIZE);
+    for (uint32_t i = 0; i < RIPPLE_FFT_SIZE; i++) {
+        int32_t x = ((raw[i] & 0x0FFF) << shift) - offset;
+        work[2 * i] = (int16_t)((x * window[i] + (1 << 14)) >> 15);
+        work[2 * i + 1] = 0;
+    }
+    ripple_fft(work);
+
+    // Amplitud de pico en cuentas del ADC a partir de la energia del lobulo
+    const float scale = sqrtf(32.0f / 3.0f) / (float)(1 << shift) * params->mv_per_lsb;
+
+    // Componente dominante, con la frecuencia en el centro de masa del lobulo
+    uint32_t k = ripple_peak_bin(work, 0, RIPPLE_FFT_SIZE / 2);
+    float energy = ripple_lobe_energy(work, k), moment = 0.0f;
+    for (uint32_t i = k - RIPPLE_LOBE_BINS; i <= k + RIPPLE_LOBE_BINS; i++) { moment += (float)i * ripple_power(work, i); }
+    result->peak_hz = moment / energy * bin_hz;
+    result->peak_mv = sqrtf(energy) * scale;
+
+    // Armonicos del PWM. Si estan por encima de Nyquist se buscan donde se reflejan,
+    // y si se reflejan sobre un armonico anterior no se pueden separar
+    int32_t centers[RIPPLE_HARMONICS];
+    for (int h = 0; h < RIPPLE_HARMONICS; h++) {
+        float f = fmodf((h + 1) * params->pwm_hz, params->fs_hz);
+        if (f > params->fs_hz / 2.0f) { f = params->fs_hz - f; }
+        centers[h] = lroundf(f / bin_hz);
+        result->harmonic_mv[h] = NAN;
+        for (int i = 0; i < h && centers[h] >= 0; i++) {
+            if (abs(centers[h] - centers[i]) <= 2 * RIPPLE_LOBE_BINS) { centers[h] = -1; }
+        }
+        if (centers[h] < 0) { continue; }
+        k = ripple_peak_bin(work, centers[h] - RIPPLE_LOBE_BINS, centers[h] + RIPPLE_LOBE_BINS);
+        result->harmonic_mv[h] = sqrtf(ripple_lobe_energy(work, k)) * scale;
+    }
+}
+
+/**
+ * @brief Arma las dos lineas del LCD: pico a pico y eficaz, y la componente
+ * dominante como multiplo de la frecuencia del PWM
+ * @param result resultado del analisis
+ * @param params parametros de la medicion
+ * @param line1 primera linea
+ * @param line2 segunda linea
+ * @param len tamaño de cada linea, con el terminador
+ */
+void ripple_format_lcd(const ripple_result_t *result, const ripple_params_t *params, char *line1, char *line2, size_t len) {
+    snprintf(line1, len, "%.1fmVpp %.1frms", result->vpp_mv, result->rms_mv);
+    snprintf(line2, len, "x%.2f %.1fmV", result->peak_hz / params->pwm_hz, result->peak_mv);
+}
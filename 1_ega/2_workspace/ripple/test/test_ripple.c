@@ -0,0 +1,204 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "check.h"
+#include "ripple_fft.h"
+
+// M_PI no esta definido en C11 estricto
+#define PI              3.14159265358979323846
+#define N               RIPPLE_FFT_SIZE
+
+// Error maximo de la FFT en cuentas Q15 contra la DFT, con la salida ya dividida por N
+#define FFT_MAX_ERROR   2.0
+// Error relativo maximo de las amplitudes de ripple_analyze
+#define AMPLITUDE_ERROR 0.03
+
+static int16_t data[2 * N];
+static int16_t work[2 * N];
+static uint16_t raw[N];
+static double ref[2 * N];
+
+// Generador congruencial, las senales son siempre las mismas
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+/**
+ * @brief DFT directa en doble precision, dividida por N como la FFT
+ */
+static void dft(const int16_t *x, double *out) {
+    for (uint32_t k = 0; k < N; k++) {
+        double re = 0.0, im = 0.0;
+        for (uint32_t n = 0; n < N; n++) {
+            double angle = 2.0 * PI * (double)((k * n) % N) / N;
+            re += x[2 * n] * cos(angle) + x[2 * n + 1] * sin(angle);
+            im += x[2 * n + 1] * cos(angle) - x[2 * n] * sin(angle);
+        }
+        out[2 * k] = re / N;
+        out[2 * k + 1] = im / N;
+    }
+}
+
+/**
+ * @brief Corre la FFT sobre data y devuelve el error maximo contra la DFT
+ */
+static double fft_error(void) {
+    double worst = 0.0;
+
+    dft(data, ref);
+    ripple_fft(data);
+    for (uint32_t i = 0; i < 2 * N; i++) {
+        double error = fabs(data[i] - ref[i]);
+        if (error > worst) { worst = error; }
+    }
+    return worst;
+}
+
+// La FFT contra la DFT con ruido a fondo de escala, un tono y un impulso
+static void test_fft(void) {
+    double error;
+
+    // Ruido complejo con modulo hasta casi fondo de escala, el peor caso para el redondeo
+    for (uint32_t i = 0; i < 2 * N; i++) { data[i] = (int16_t)(next_random() % 46001) - 23000; }
+    error = fft_error();
+    printf("fft contra dft: ruido %.2f cuentas", error);
+    CHECK(error <= FFT_MAX_ERROR);
+
+    // Tono real en el bin 37: la mitad de la amplitud en 37 y en N - 37
+    for (uint32_t n = 0; n < N; n++) {
+        data[2 * n] = (int16_t)lround(30000.0 * cos(2.0 * PI * 37 * n / N));
+        data[2 * n + 1] = 0;
+    }
+    error = fft_error();
+    printf(", tono %.2f", error);
+    CHECK(error <= FFT_MAX_ERROR);
+    CHECK(abs(data[2 * 37] - 15000) <= FFT_MAX_ERROR && abs(data[2 * (N - 37)] - 15000) <= FFT_MAX_ERROR);
+
+    // Impulso en 5: todos los bins con modulo 32767 / N
+    memset(data, 0, sizeof(data));
+    data[2 * 5] = 32767;
+    error = fft_error();
+    printf(", impulso %.2f\n", error);
+    CHECK(error <= FFT_MAX_ERROR);
+}
+
+/**
+ * @brief Bloque del ADC: continua mas un tono y sus armonicos, con un poco de
+ * ruido, redondeado a 12 bits
+ * @param amplitude amplitud en cuentas de cada armonico, el primero es el fundamental
+ */
+static void make_block(double dc, double f, double fs, const double *amplitude, int harmonics) {
+    for (uint32_t n = 0; n < N; n++) {
+        double v = dc + ((double)(next_random() % 1000) - 500.0) / 1000.0;
+        for (int h = 0; h < harmonics; h++) { v += amplitude[h] * sin(2.0 * PI * (h + 1) * f * n / fs + h); }
+        raw[n] = (uint16_t)lround(v);
+    }
+}
+
+static bool close_to(float value, double expected, double tolerance) {
+    return fabs(value - expected) <= tolerance * fabs(expected);
+}
+
+// Continua, pico a pico y eficaz exactos sobre las muestras
+static void test_time_stats(void) {
+    ripple_params_t params = { 500000.0f, 60000.0f, 1.0f };
+    ripple_result_t result;
+    double amplitude[1] = { 100.0 };
+    double sum = 0.0, sum_sq = 0.0;
+    int min = 4095, max = 0;
+
+    make_block(2000.0, 60000.0, 500000.0, amplitude, 1);
+    for (uint32_t n = 0; n < N; n++) {
+        sum += raw[n];
+        if (raw[n] < min) { min = raw[n]; }
+        if (raw[n] > max) { max = raw[n]; }
+    }
+    for (uint32_t n = 0; n < N; n++) { sum_sq += (raw[n] - sum / N) * (raw[n] - sum / N); }
+
+    ripple_analyze(raw, work, &params, &result);
+    CHECK(close_to(result.dc_mv, sum / N, 1e-6));
+    CHECK(result.vpp_mv == (float)(max - min));
+    CHECK(close_to(result.rms_mv, sqrt(sum_sq / N), 1e-4));
+
+    // Sin rizado todo lo demas queda en cero
+    for (uint32_t n = 0; n < N; n++) { raw[n] = 1234 | 0x8000; }
+    ripple_analyze(raw, work, &params, &result);
+    CHECK(result.dc_mv == 1234.0f && result.vpp_mv == 0.0f && result.rms_mv == 0.0f);
+    CHECK(result.peak_mv == 0.0f && result.harmonic_mv[0] == 0.0f);
+}
+
+/**
+ * @brief Amplitud y frecuencia de la componente dominante y de los armonicos,
+ * con el fundamental en distintas posiciones entre dos bins
+ */
+static void test_spectrum(void) {
+    ripple_params_t params = { 500000.0f, 0.0f, 0.5f };
+    ripple_result_t result;
+    double amplitude[RIPPLE_HARMONICS] = { 200.0, 60.0, 25.0, 10.0 };
+    double bin_hz = params.fs_hz / N, worst = 0.0, worst_hz = 0.0;
+
+    for (int step = 0; step < 8; step++) {
+        // De 100 a 101 bins en octavos: el tono cae en distintos lugares del lobulo
+        double f = (100.0 + step / 8.0) * bin_hz;
+        params.pwm_hz = (float)f;
+        make_block(2048.0, f, params.fs_hz, amplitude, RIPPLE_HARMONICS);
+        ripple_analyze(raw, work, &params, &result);
+
+        worst_hz = fmax(worst_hz, fabs(result.peak_hz - f));
+        for (int h = 0; h < RIPPLE_HARMONICS; h++) {
+            double expected = amplitude[h] * params.mv_per_lsb;
+            worst = fmax(worst, fabs(result.harmonic_mv[h] - expected) / expected);
+        }
+        CHECK(close_to(result.peak_mv, amplitude[0] * params.mv_per_lsb, AMPLITUDE_ERROR));
+    }
+    printf("espectro: error de amplitud %.2f %%, error de frecuencia %.1f Hz (bin de %.1f Hz)\n",
+           100.0 * worst, worst_hz, bin_hz);
+    CHECK(worst <= AMPLITUDE_ERROR);
+    CHECK(worst_hz <= bin_hz / 10.0);
+}
+
+// Armonicos por encima de Nyquist: se miden donde se reflejan, o NAN si chocan
+static void test_aliasing(void) {
+    ripple_params_t params = { 500000.0f, 150000.0f, 1.0f };
+    ripple_result_t result;
+    double amplitude[RIPPLE_HARMONICS] = { 200.0, 80.0, 40.0, 20.0 };
+
+    // 150, 300 -> 200, 450 -> 50 y 600 -> 100 kHz
+    make_block(2048.0, params.pwm_hz, params.fs_hz, amplitude, RIPPLE_HARMONICS);
+    ripple_analyze(raw, work, &params, &result);
+    for (int h = 0; h < RIPPLE_HARMONICS; h++) { CHECK(close_to(result.harmonic_mv[h], amplitude[h], AMPLITUDE_ERROR)); }
+
+    // 125, 250, 375 -> 125: el tercero cae sobre el primero
+    params.pwm_hz = 125000.0f;
+    make_block(2048.0, params.pwm_hz, params.fs_hz, amplitude, 1);
+    ripple_analyze(raw, work, &params, &result);
+    CHECK(close_to(result.harmonic_mv[0], amplitude[0], AMPLITUDE_ERROR));
+    CHECK(!isnan(result.harmonic_mv[1]));
+    CHECK(isnan(result.harmonic_mv[2]));
+}
+
+static void test_format(void) {
+    ripple_params_t params = { 500000.0f, 50000.0f, 1.0f };
+    ripple_result_t result = { .vpp_mv = 41.3f, .rms_mv = 9.5f, .peak_hz = 100000.0f, .peak_mv = 12.34f };
+    char line1[17], line2[17];
+
+    ripple_format_lcd(&result, &params, line1, line2, sizeof(line1));
+    CHECK(!strcmp(line1, "41.3mVpp 9.5rms"));
+    CHECK(!strcmp(line2, "x2.00 12.3mV"));
+}
+
+int main(void) {
+    ripple_fft_init();
+    test_fft();
+    test_time_stats();
+    test_spectrum();
+    test_aliasing();
+    test_format();
+    return check_result("ripple");
+}
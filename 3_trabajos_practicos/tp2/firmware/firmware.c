@@ -6,11 +6,13 @@
 #include "task.h"
 #include "queue.h"
 
+#include "adctemp.h"
+
 // Variable de la cola
 QueueHandle_t adcQueue;
 
-// ISR del ADC
-void __isr adc_irq_handler() {
+// ISR del ADC, desde RAM para no esperar a la cache XIP
+void __isr __not_in_flash_func(adc_irq_handler)() {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
     while (adc_fifo_get_level()) {
@@ -27,9 +29,8 @@ void temperature_task(void *params) {
     uint16_t adc_cola;
     while (1) {
         if (xQueueReceive(adcQueue, &adc_cola, portMAX_DELAY) == pdTRUE) {
-            float voltage = adc_cola * 3.3f / (1 << 12); // 12 bits
-            float temperature = 27 - (voltage - 0.706f) / 0.001721f;
-            printf("Temperatura: %.2f °C\n", temperature);
+            int32_t temperature = adctemp_centi(adc_cola); // Centesimas de grado, sale de la tabla
+            printf("Temperatura: %.2f °C\n", temperature / 100.0f);
         }
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
@@ -46,6 +47,9 @@ void adc_trigger_task(void *params) {
 int main() {
     stdio_init_all();
 
+    // Calibracion del sensor grabada en la flash, si la hay
+    adctemp_init();
+
     // Inicializar ADC
     adc_init();
     adc_set_temp_sensor_enabled(true);
@@ -18,17 +18,14 @@
 #define I2C_SDA_PIN 4
 #define I2C_SCL_PIN 5
 
-//Defino la funcion que genera PWM
-void pwm_user_init(uint32_t gpio, uint32_t freq);
-
 // Semáforo de conteo
 SemaphoreHandle_t xPulseSemaphore;
 
 // Variable de conteo (solo la tarea debe leerla)
 volatile uint32_t pulse_count = 0;
 
-// ISR GPIO Funcion de Interrupcion
-void gpio_callback(uint gpio, uint32_t events) {
+// ISR GPIO Funcion de Interrupcion, desde RAM para no esperar a la cache XIP
+void __not_in_flash_func(gpio_callback)(uint gpio, uint32_t events) {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     if (gpio == INPUT_GPIO && events & GPIO_IRQ_EDGE_RISE) {
         xSemaphoreGiveFromISR(xPulseSemaphore, &xHigherPriorityTaskWoken);
@@ -67,20 +64,6 @@ void LCDDisplayTask(void *params) {
         lcd_string(buffer);
     }
 }
- 
-// Funcion que genera PWM
-
- void pwm_user_init(uint32_t gpio, uint32_t freq) {
-    // Asigna función de PWM
-    gpio_set_function(gpio, GPIO_FUNC_PWM);
-    // Configura frecuencia de PWM e inicializa
-    uint32_t slice = pwm_gpio_to_slice_num(gpio);
-    pwm_set_clkdiv(slice, frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_SYS) / 1000.0);
-    pwm_set_wrap(slice, 1000000 / freq);
-    pwm_set_gpio_level(gpio, 500000 /freq);
-    pwm_set_enabled(slice, true); 
-   } 
-
 int main() {
 
     stdio_init_all();
@@ -101,8 +84,12 @@ int main() {
     gpio_pull_down(INPUT_GPIO);
     gpio_set_irq_enabled_with_callback(INPUT_GPIO, GPIO_IRQ_EDGE_RISE, true, &gpio_callback);
 
-    // Funcion que genera PWM
-    pwm_user_init(OUTPUT_GPIO, 9500);
+    // Funcion que genera PWM, sin la señal no hay nada que medir
+    if (!pwm_user_init(OUTPUT_GPIO, 9500)) {
+        lcd_clear();
+        lcd_string("Error de PWM");
+        panic("No se puede generar el PWM en el GP%d", OUTPUT_GPIO);
+    }
 
     // Crear semáforo counting (capacidad máxima 100000, inicial 0)
     xPulseSemaphore = xSemaphoreCreateCounting(100000, 0);
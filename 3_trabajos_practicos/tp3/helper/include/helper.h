@@ -5,7 +5,13 @@
 #include "hardware/pwm.h"
 #include "hardware/clocks.h"
 
-// Prototipo
-void pwm_user_init(uint32_t gpio, uint32_t freq);
+#include "pwm_synth.h"
 
-#endif
\ No newline at end of file
+// Prototipos
+bool pwm_user_init(uint32_t gpio, uint32_t freq);
+void pwm_synth_refresh_clock(void);
+bool pwm_synth_init(uint32_t gpio, uint32_t freq, pwm_synth_t *cfg);
+void pwm_synth_set_duty(uint32_t gpio, const pwm_synth_t *cfg, uint16_t duty_permil);
+bool pwm_synth_start_aligned(const uint32_t *gpios, const uint16_t *phase_permil, uint32_t count, uint32_t freq, pwm_synth_t *cfg);
+
+#endif
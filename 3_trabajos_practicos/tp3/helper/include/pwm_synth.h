@@ -0,0 +1,28 @@
+#ifndef _PWM_SYNTH_H_
+#define _PWM_SYNTH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Limites del divisor 8.4 y del contador de 16 bits del PWM
+#define PWM_SYNTH_DIV_MIN   16u         // 1.0 en formato 8.4
+#define PWM_SYNTH_DIV_MAX   4095u       // 255 + 15/16 en formato 8.4
+#define PWM_SYNTH_TOP_MIN   2u          // Al menos dos niveles de ancho de pulso
+#define PWM_SYNTH_TOP_MAX   65536u      // wrap de 16 bits mas uno
+
+/**
+ * @brief Configuracion calculada para una frecuencia de PWM
+ */
+typedef struct {
+    uint8_t div_int;    // Parte entera del divisor
+    uint8_t div_frac;   // Parte fraccionaria del divisor en dieciseisavos
+    uint16_t wrap;      // Valor de wrap, el periodo es wrap + 1 cuentas
+    uint32_t clk_hz;    // Frecuencia de reloj usada en el calculo
+    float freq;         // Frecuencia obtenida en Hz
+    float error_ppm;    // Error relativo a la frecuencia pedida en ppm
+} pwm_synth_t;
+
+// Prototipos de funciones
+bool pwm_synth_calc(uint32_t clk_hz, uint32_t freq, pwm_synth_t *cfg);
+
+#endif
@@ -1,17 +1,102 @@
 #include "helper.h"
 
+// Frecuencia del reloj de sistema, se lee una sola vez
+static uint32_t clk_sys_hz = 0;
+
 /**
- * @brief Inicializa un PWM en el pin solicitado
+ * @brief Devuelve la frecuencia del reloj de sistema guardada
+ * @return frecuencia en Hz
+ */
+static uint32_t helper_clk_hz(void) {
+    if (!clk_sys_hz) {
+        // clock_get_hz no mide, devuelve la frecuencia que configuro el SDK
+        clk_sys_hz = clock_get_hz(clk_sys);
+    }
+    return clk_sys_hz;
+}
+
+/**
+ * @brief Vuelve a leer la frecuencia del reloj de sistema, llamar si se
+ * cambio el reloj despues de configurar algun PWM
+ */
+void pwm_synth_refresh_clock(void) {
+    clk_sys_hz = clock_get_hz(clk_sys);
+}
+
+/**
+ * @brief Configura el slice de un pin con el divisor y wrap que mejor
+ * aproximan la frecuencia pedida. El PWM queda deshabilitado
  * @param gpio numero de GPIO
  * @param freq frecuencia deseada en Hz
+ * @param cfg puntero donde se guarda la configuracion obtenida, con la
+ * frecuencia real y su error
+ * @return false si la frecuencia no se puede generar
  */
-void pwm_user_init(uint32_t gpio, uint32_t freq) {
+bool pwm_synth_init(uint32_t gpio, uint32_t freq, pwm_synth_t *cfg) {
+    if (!pwm_synth_calc(helper_clk_hz(), freq, cfg)) { return false; }
+
     // Asigna función de PWM
     gpio_set_function(gpio, GPIO_FUNC_PWM);
-    // Configura frecuencia de PWM e inicializa
-    uint32_t slice = pwm_gpio_to_slice_num(gpio);
-    pwm_set_clkdiv(slice, frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_SYS) / 1000.0);
-    pwm_set_wrap(slice, 1000000 / freq);
-    pwm_set_gpio_level(gpio, 500000 / freq);
-    pwm_set_enabled(slice, true);
-}
\ No newline at end of file
+    // Configura divisor y wrap sin habilitar
+    pwm_config c = pwm_get_default_config();
+    pwm_config_set_clkdiv_int_frac(&c, cfg->div_int, cfg->div_frac);
+    pwm_config_set_wrap(&c, cfg->wrap);
+    pwm_init(pwm_gpio_to_slice_num(gpio), &c, false);
+    return true;
+}
+
+/**
+ * @brief Cambia el ancho de pulso de un pin configurado con pwm_synth_init
+ * @param gpio numero de GPIO
+ * @param cfg puntero a la configuracion del slice
+ * @param duty_permil ancho de pulso en por mil (0 a 1000)
+ */
+void pwm_synth_set_duty(uint32_t gpio, const pwm_synth_t *cfg, uint16_t duty_permil) {
+    if (duty_permil > 1000) { duty_permil = 1000; }
+    // El periodo es wrap + 1 cuentas, con 1000 queda siempre en alto
+    uint32_t level = ((uint32_t)cfg->wrap + 1) * duty_permil / 1000;
+    pwm_set_gpio_level(gpio, level);
+}
+
+/**
+ * @brief Configura varios slices con la misma frecuencia y los arranca en el
+ * mismo ciclo de reloj, con un desfasaje relativo entre ellos
+ * @param gpios arreglo de GPIOs, uno por slice
+ * @param phase_permil desfasaje de cada slice en por mil del periodo (NULL para 0)
+ * @param count cantidad de GPIOs
+ * @param freq frecuencia deseada en Hz
+ * @param cfg puntero donde se guarda la configuracion comun obtenida
+ * @return false si la frecuencia no se puede generar
+ */
+bool pwm_synth_start_aligned(const uint32_t *gpios, const uint16_t *phase_permil, uint32_t count, uint32_t freq, pwm_synth_t *cfg) {
+    uint32_t mask = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (!pwm_synth_init(gpios[i], freq, cfg)) { return false; }
+        uint slice = pwm_gpio_to_slice_num(gpios[i]);
+        // El desfasaje es el valor inicial del contador
+        uint32_t phase = phase_permil ? phase_permil[i] % 1000 : 0;
+        pwm_set_counter(slice, ((uint32_t)cfg->wrap + 1) * phase / 1000);
+        mask |= 1u << slice;
+    }
+
+    // Una sola escritura habilita todos los slices a la vez
+    hw_set_bits(&pwm_hw->en, mask);
+    return true;
+}
+
+/**
+ * @brief Inicializa un PWM en el pin solicitado
+ * @param gpio numero de GPIO
+ * @param freq frecuencia deseada en Hz
+ * @return false si la frecuencia no se puede generar, el pin queda sin tocar
+ */
+bool pwm_user_init(uint32_t gpio, uint32_t freq) {
+    pwm_synth_t cfg;
+
+    // Configura frecuencia de PWM al 50% e inicializa
+    if (!pwm_synth_init(gpio, freq, &cfg)) { return false; }
+    pwm_synth_set_duty(gpio, &cfg, 500);
+    pwm_set_enabled(pwm_gpio_to_slice_num(gpio), true);
+    return true;
+}
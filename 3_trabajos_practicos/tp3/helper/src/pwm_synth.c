@@ -0,0 +1,59 @@
+#include "pwm_synth.h"
+
+/**
+ * @brief Busca el divisor (entero + fraccionario) y el wrap que dan la menor
+ * diferencia con la frecuencia pedida. Entre soluciones con el mismo error se
+ * queda con la de mayor wrap, o sea la de mayor resolucion de ancho de pulso.
+ * Recorre todos los divisores con aritmetica entera, sin punto flotante
+ * @param clk_hz frecuencia de reloj del PWM en Hz
+ * @param freq frecuencia deseada en Hz
+ * @param cfg puntero donde se guarda el resultado
+ * @return false si la frecuencia no se puede generar con este reloj
+ */
+bool pwm_synth_calc(uint32_t clk_hz, uint32_t freq, pwm_synth_t *cfg) {
+    // El divisor esta en dieciseisavos, la frecuencia es clk * 16 / (div * top)
+    const uint64_t clk16 = (uint64_t)clk_hz * 16;
+    uint64_t best_err = 0, best_den = 0;
+    uint32_t best_div = 0, best_top = 0;
+
+    // Fuera del rango entre el menor divisor con el menor top y el mayor con el mayor
+    if (!freq || (uint64_t)freq * PWM_SYNTH_DIV_MIN * PWM_SYNTH_TOP_MIN > clk16 ||
+        (uint64_t)freq * PWM_SYNTH_DIV_MAX * PWM_SYNTH_TOP_MAX < clk16) { return false; }
+
+    for (uint32_t div = PWM_SYNTH_DIV_MIN; div <= PWM_SYNTH_DIV_MAX; div++) {
+        uint64_t step = (uint64_t)freq * div;
+        uint64_t top = clk16 / step;
+        // Ni redondeando hacia arriba llega al minimo: los divisores siguientes quedan mas lejos
+        if (top + 1 < PWM_SYNTH_TOP_MIN) { break; }
+
+        // Los candidatos son el top redondeado hacia arriba y hacia abajo, limitados al
+        // rango del contador. Pruebo primero el mayor para quedarme con el ante empates
+        uint64_t high = top + 1 > PWM_SYNTH_TOP_MAX ? PWM_SYNTH_TOP_MAX : top + 1;
+        uint64_t low = top < PWM_SYNTH_TOP_MIN ? PWM_SYNTH_TOP_MIN : (top > PWM_SYNTH_TOP_MAX ? PWM_SYNTH_TOP_MAX : top);
+        for (uint64_t t = high; t >= low; t--) {
+            // Error absoluto = |clk16 - freq * div * t| / (div * t), comparo fracciones en cruz
+            uint64_t produced = step * t;
+            uint64_t err = produced > clk16 ? produced - clk16 : clk16 - produced;
+            uint64_t den = (uint64_t)div * t;
+            if (!best_den || err * best_den < best_err * den) {
+                best_err = err;
+                best_den = den;
+                best_div = div;
+                best_top = (uint32_t)t;
+            }
+        }
+
+        // Un resultado exacto con el menor divisor ya tiene la mayor resolucion
+        if (best_den && !best_err) { break; }
+    }
+
+    if (!best_den) { return false; }
+
+    cfg->div_int = best_div >> 4;
+    cfg->div_frac = best_div & 0x0F;
+    cfg->wrap = best_top - 1;
+    cfg->clk_hz = clk_hz;
+    cfg->freq = (float)((double)clk16 / ((double)best_div * best_top));
+    cfg->error_ppm = (float)(((double)cfg->freq - freq) * 1e6 / freq);
+    return true;
+}
@@ -0,0 +1,145 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "check.h"
+#include "pwm_synth.h"
+
+// Relojes de sistema por defecto de RP2040 y RP2350
+static const uint32_t clocks[] = { 125000000, 150000000 };
+
+/**
+ * @brief Mejor par divisor y top: el de menor error y, ante empates, el de mayor
+ * top y despues el de menor divisor
+ */
+typedef struct {
+    uint64_t err, den;      // Error = err / den, en dieciseisavos de Hz
+    uint32_t div, top;
+} best_t;
+
+static void consider(best_t *best, uint64_t clk16, uint32_t freq, uint32_t div, uint32_t top) {
+    uint64_t produced = (uint64_t)freq * div * top;
+    uint64_t err = produced > clk16 ? produced - clk16 : clk16 - produced;
+    uint64_t den = (uint64_t)div * top;
+    if (!best->den || err * best->den < best->err * den ||
+        (err * best->den == best->err * den && (top > best->top || (top == best->top && div < best->div)))) {
+        best->err = err;
+        best->den = den;
+        best->div = div;
+        best->top = top;
+    }
+}
+
+// Todos los divisores con todos los tops: 267 millones de pares
+static best_t brute_force(uint32_t clk_hz, uint32_t freq) {
+    best_t best = { 0 };
+    uint64_t clk16 = (uint64_t)clk_hz * 16;
+    for (uint32_t div = PWM_SYNTH_DIV_MIN; div <= PWM_SYNTH_DIV_MAX; div++) {
+        for (uint32_t top = PWM_SYNTH_TOP_MIN; top <= PWM_SYNTH_TOP_MAX; top++) {
+            consider(&best, clk16, freq, div, top);
+        }
+    }
+    return best;
+}
+
+// Todos los tops con los dos divisores mas cercanos a la frecuencia: recorre el espacio
+// desde el otro lado que pwm_synth_calc, alcanza para barrer muchas frecuencias
+static best_t by_top(uint32_t clk_hz, uint32_t freq) {
+    best_t best = { 0 };
+    uint64_t clk16 = (uint64_t)clk_hz * 16;
+    for (uint32_t top = PWM_SYNTH_TOP_MIN; top <= PWM_SYNTH_TOP_MAX; top++) {
+        uint64_t div = clk16 / ((uint64_t)freq * top);
+        for (uint64_t d = div; d <= div + 1; d++) {
+            if (d >= PWM_SYNTH_DIV_MIN && d <= PWM_SYNTH_DIV_MAX) { consider(&best, clk16, freq, (uint32_t)d, top); }
+        }
+    }
+    return best;
+}
+
+// La frecuencia se puede generar si esta entre los extremos del divisor y del contador
+static bool in_range(uint32_t clk_hz, uint32_t freq) {
+    uint64_t clk16 = (uint64_t)clk_hz * 16;
+    return freq && (uint64_t)freq * PWM_SYNTH_DIV_MIN * PWM_SYNTH_TOP_MIN <= clk16 &&
+           (uint64_t)freq * PWM_SYNTH_DIV_MAX * PWM_SYNTH_TOP_MAX >= clk16;
+}
+
+// Compara la configuracion con la referencia: mismo error exacto y misma resolucion
+static bool same(uint32_t clk_hz, uint32_t freq, const pwm_synth_t *cfg, const best_t *ref) {
+    uint32_t div = cfg->div_int * 16u + cfg->div_frac;
+    uint32_t top = (uint32_t)cfg->wrap + 1;
+    best_t got = { 0 };
+    consider(&got, (uint64_t)clk_hz * 16, freq, div, top);
+
+    bool ok = got.err * ref->den == ref->err * got.den && top == ref->top && div == ref->div;
+    if (!ok) {
+        fprintf(stderr, "clk %lu f %lu: calc div %lu top %lu, referencia div %lu top %lu\n", (unsigned long)clk_hz,
+                (unsigned long)freq, (unsigned long)div, (unsigned long)top, (unsigned long)ref->div, (unsigned long)ref->top);
+    }
+    return ok;
+}
+
+// Fuerza bruta completa en frecuencias de los extremos y del uso normal
+static void test_brute_force(void) {
+    static const uint32_t freqs[] = { 9, 150, 1000, 9500, 33333, 1000003, 62500000 };
+    pwm_synth_t cfg;
+
+    for (size_t c = 0; c < sizeof(clocks) / sizeof(clocks[0]); c++) {
+        for (size_t f = 0; f < sizeof(freqs) / sizeof(freqs[0]); f++) {
+            best_t ref = brute_force(clocks[c], freqs[f]);
+            bool found = pwm_synth_calc(clocks[c], freqs[f], &cfg);
+            CHECK_EQ(found, in_range(clocks[c], freqs[f]));
+            if (found) { CHECK(same(clocks[c], freqs[f], &cfg, &ref)); }
+        }
+    }
+}
+
+// Barrido de frecuencias contra la busqueda por top
+static void test_sweep(void) {
+    pwm_synth_t cfg;
+    int checked = 0;
+
+    for (size_t c = 0; c < sizeof(clocks) / sizeof(clocks[0]); c++) {
+        // Todas las frecuencias hasta 2 kHz, donde el divisor fraccionario importa, y
+        // despues pasos crecientes hasta el maximo
+        for (uint32_t freq = 1; freq <= clocks[c] / PWM_SYNTH_TOP_MIN + 1; freq += freq < 2000 ? 1 : freq / 97) {
+            best_t ref = by_top(clocks[c], freq);
+            bool found = pwm_synth_calc(clocks[c], freq, &cfg);
+            CHECK_EQ(found, in_range(clocks[c], freq));
+            if (found) {
+                CHECK(same(clocks[c], freq, &cfg, &ref));
+                checked++;
+            }
+        }
+    }
+    printf("%d frecuencias comparadas\n", checked);
+}
+
+// Casos que no se pueden generar y datos de la configuracion
+static void test_limits(void) {
+    pwm_synth_t cfg;
+
+    CHECK(!pwm_synth_calc(150000000, 0, &cfg));
+    CHECK(!pwm_synth_calc(150000000, 75000001, &cfg));
+    CHECK(pwm_synth_calc(150000000, 75000000, &cfg));
+    CHECK_EQ(cfg.wrap, 1);
+    // Por debajo de clk / (255 + 15/16) / 65536 no alcanza el divisor
+    CHECK(!pwm_synth_calc(150000000, 8, &cfg));
+
+    // 9500 Hz del tp3 a 150 MHz: 15789,47 cuentas, error menor a 2 ppm
+    CHECK(pwm_synth_calc(150000000, 9500, &cfg));
+    CHECK(cfg.error_ppm > -2.0f && cfg.error_ppm < 2.0f);
+    CHECK_EQ(cfg.clk_hz, 150000000);
+    CHECK(cfg.freq > 9499.98f && cfg.freq < 9500.02f);
+
+    // Las exactas usan el menor divisor, o sea el mayor wrap
+    CHECK(pwm_synth_calc(125000000, 1000, &cfg));
+    CHECK_EQ(cfg.error_ppm, 0);
+    CHECK_EQ(cfg.div_int * 16 + cfg.div_frac, 32);
+    CHECK_EQ(cfg.wrap, 62499);
+}
+
+int main(void) {
+    test_limits();
+    test_brute_force();
+    test_sweep();
+    return check_result("pwm_synth");
+}
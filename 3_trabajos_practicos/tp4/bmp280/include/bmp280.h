@@ -5,14 +5,28 @@
 #include "pico/binary_info.h"
 #include "pico/stdlib.h"
 
-// Dirección del BMP280
-#define ADDR _u(0x76)
+// Direcciones posibles del BMP280/BME280 (pin SDO a GND o a VCC)
+#define BMP280_ADDR_PRIMARY _u(0x76)
+#define BMP280_ADDR_SECONDARY _u(0x77)
+
+// Identificadores de chip
+#define BMP280_CHIP_ID _u(0x58)
+#define BME280_CHIP_ID _u(0x60)
 
 // Registros de hardware
+#define REG_ID _u(0xD0)
 #define REG_CONFIG _u(0xF5)
 #define REG_CTRL_MEAS _u(0xF4)
+#define REG_STATUS _u(0xF3)
+#define REG_CTRL_HUM _u(0xF2)
 #define REG_RESET _u(0xE0)
 
+// Bit de conversion en curso del registro de estado
+#define STATUS_MEASURING _u(0x08)
+
+#define REG_HUM_LSB _u(0xFE)
+#define REG_HUM_MSB _u(0xFD)
+
 #define REG_TEMP_XLSB _u(0xFC)
 #define REG_TEMP_LSB _u(0xFB)
 #define REG_TEMP_MSB _u(0xFA)
@@ -47,8 +61,13 @@
 #define REG_DIG_P9_LSB _u(0x9E)
 #define REG_DIG_P9_MSB _u(0x9F)
 
+// Registros de calibración de humedad (solo BME280)
+#define REG_DIG_H1 _u(0xA1)
+#define REG_DIG_H2_LSB _u(0xE1)
+
 // Cantidad de registros de calibración para leer
 #define NUM_CALIB_PARAMS 24
+#define NUM_CALIB_HUM_PARAMS 7
 
 /**
  * @brief Parámetros de calibración internos
@@ -69,15 +88,61 @@ struct bmp280_calib_param {
     int16_t dig_p7;
     int16_t dig_p8;
     int16_t dig_p9;
+
+    // Parámetros de humedad (solo BME280)
+    uint8_t dig_h1;
+    int16_t dig_h2;
+    uint8_t dig_h3;
+    int16_t dig_h4;
+    int16_t dig_h5;
+    int8_t dig_h6;
 };
 
+/**
+ * @brief Estado de la lectura por fases
+ */
+typedef enum {
+    BMP280_IDLE,        // Sin conversion en curso
+    BMP280_CONVERTING,  // Conversion iniciada en modo forzado
+    BMP280_READY,       // Conversion terminada, falta leer los datos
+} bmp280_state_t;
+
+/**
+ * @brief Resultado de un paso de la lectura
+ */
+typedef enum {
+    BMP280_ERROR = -1,  // El dispositivo no respondio
+    BMP280_BUSY = 0,    // Todavia no hay datos, volver a llamar mas tarde
+    BMP280_DONE = 1,    // Hay datos nuevos en el handle
+} bmp280_result_t;
+
+/**
+ * @brief Handle de un BMP280/BME280 en un bus I2C
+ */
+typedef struct {
+    i2c_inst_t *i2c;                    // Bus I2C
+    uint8_t addr;                       // Direccion de 7 bits
+    uint8_t chip_id;                    // BMP280_CHIP_ID o BME280_CHIP_ID
+    bool has_humidity;                  // true si es un BME280
+    bmp280_state_t state;               // Fase de la lectura en curso
+    struct bmp280_calib_param calib;    // Calibracion de fabrica
+    int32_t raw_temp;                   // Ultima temperatura sin compensar
+    int32_t raw_pressure;               // Ultima presion sin compensar
+    int32_t raw_humidity;               // Ultima humedad sin compensar
+} bmp280_t;
+
 // Prototipos de funciones
 
-void bmp280_init(i2c_inst_t *i2c);
-void bmp280_reset();
-void bmp280_get_calib_params(struct bmp280_calib_param* params);
-void bmp280_read_raw(int32_t* raw_temp, int32_t* raw_pressure);
+bool bmp280_init(bmp280_t *dev, i2c_inst_t *i2c, uint8_t addr);
+bool bmp280_reset(bmp280_t *dev);
+uint32_t bmp280_measure_time_us(const bmp280_t *dev);
+bool bmp280_start(bmp280_t *dev);
+bmp280_result_t bmp280_poll(bmp280_t *dev);
+bmp280_result_t bmp280_fetch(bmp280_t *dev);
+bmp280_result_t bmp280_step(bmp280_t *dev);
+bmp280_result_t bmp280_read_raw(bmp280_t *dev);
 float bmp280_convert_temp(int32_t temp, struct bmp280_calib_param* params);
 int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_calib_param* params);
+float bme280_convert_humidity(int32_t humidity, int32_t temp, struct bmp280_calib_param* params);
 
 #endif
\ No newline at end of file
@@ -1,55 +1,62 @@
 #include "bmp280.h"
+#include "i2c_trace.h"
 
-// Puntero a I2C usado
-static i2c_inst_t *i2c_bmp;
+// Sobremuestreo usado: temperatura x1, presion x4, humedad x1
+#define OSRS_T 1
+#define OSRS_P 4
+#define OSRS_H 1
+
+// Modos de operacion del registro de control
+#define MODE_SLEEP  0x00
+#define MODE_FORCED 0x01
+#define MODE_MASK   0x03
+
+// Filtro x16, el tiempo de standby no se usa en modo forzado
+#define REG_CONFIG_VAL (((0x04 << 5) | (0x05 << 2)) & 0xFC)
+// osrs_t x1, osrs_p x4 y el modo que corresponda
+#define REG_CTRL_MEAS_VAL(mode) ((0x01 << 5) | (0x03 << 2) | (mode))
+// osrs_h x1
+#define REG_CTRL_HUM_VAL 0x01
 
 /**
- * @brief Inicialización del BMP280
- * @param i2c puntero a instancia de I2C
+ * @brief Escribe un registro del sensor
+ * @param dev puntero al handle
+ * @param reg direccion del registro
+ * @param val valor a escribir
+ * @return true si el sensor respondio
  */
-void bmp280_init(i2c_inst_t *i2c) {
-  // Guardo el I2C elegido
-  i2c_bmp = i2c;
-  uint8_t buf[2];
-
-  // 500ms de tiempo de sampling, x16 filter
-  const uint8_t reg_config_val = ((0x04 << 5) | (0x05 << 2)) & 0xFC;
-
-  // Registro y luego el valor a escribir
-  buf[0] = REG_CONFIG;
-  buf[1] = reg_config_val;
-  i2c_write_blocking(i2c_bmp, ADDR, buf, 2, false);
-
-  // osrs_t x1, osrs_p x4, normal mode operation
-  const uint8_t reg_ctrl_meas_val = (0x01 << 5) | (0x03 << 2) | (0x03);
-  buf[0] = REG_CTRL_MEAS;
-  buf[1] = reg_ctrl_meas_val;
-  i2c_write_blocking(i2c_bmp, ADDR, buf, 2, false);
+static bool bmp280_write_reg(bmp280_t *dev, uint8_t reg, uint8_t val) {
+    uint8_t buf[2] = { reg, val };
+    return i2c_trace_write_blocking(dev->i2c, dev->addr, buf, 2, false) == 2;
 }
 
 /**
- * @brief Software reset
+ * @brief Lee registros consecutivos del sensor, se autoincrementan
+ * @param dev puntero al handle
+ * @param reg direccion del primer registro
+ * @param buf buffer donde guardar los datos
+ * @param len cantidad de registros
+ * @return true si el sensor respondio
  */
-void bmp280_reset() {
-    // Resetear dispositivo
-    uint8_t buf[2] = { REG_RESET, 0xB6 };
-    i2c_write_blocking(i2c_bmp, ADDR, buf, 2, false);
+static bool bmp280_read_regs(bmp280_t *dev, uint8_t reg, uint8_t *buf, size_t len) {
+    // true para mantener el control del bus desde el master
+    if (i2c_trace_write_blocking(dev->i2c, dev->addr, &reg, 1, true) != 1) { return false; }
+    // false porque se terminó la transacción
+    return i2c_trace_read_blocking(dev->i2c, dev->addr, buf, len, false) == (int)len;
 }
 
 /**
- * @brief Obtiene los valores de calibración del BMP280
- * @param params puntero a estructura de parámetros de calibración
+ * @brief Obtiene los valores de calibración del sensor
+ * @param dev puntero al handle
+ * @return true si el sensor respondio
  */
-void bmp280_get_calib_params(struct bmp280_calib_param* params) {
+static bool bmp280_get_calib_params(bmp280_t *dev) {
+    struct bmp280_calib_param *params = &dev->calib;
     // Los parámetros de calibración son propios del proceso de fabricación del sensor
     // Hay 3 parámetros de temperatura y 9 de presión, todos con un registro LSB y MSB
     // Hay que leer 24 registros
     uint8_t buf[NUM_CALIB_PARAMS] = { 0 };
-    uint8_t reg = REG_DIG_T1_LSB;
-    // true para mantener control del bus en el master
-    i2c_write_blocking(i2c_bmp, ADDR, &reg, 1, true);
-    // Leer los 24 registros que se autoincrementan
-    i2c_read_blocking(i2c_bmp, ADDR, buf, NUM_CALIB_PARAMS, false);
+    if (!bmp280_read_regs(dev, REG_DIG_T1_LSB, buf, NUM_CALIB_PARAMS)) { return false; }
 
     // Guardar en la estructura
     params->dig_t1 = (uint16_t)(buf[1] << 8) | buf[0];
@@ -65,26 +72,161 @@ void bmp280_get_calib_params(struct bmp280_calib_param* params) {
     params->dig_p7 = (int16_t)(buf[19] << 8) | buf[18];
     params->dig_p8 = (int16_t)(buf[21] << 8) | buf[20];
     params->dig_p9 = (int16_t)(buf[23] << 8) | buf[22];
+
+    if (!dev->has_humidity) { return true; }
+
+    // El BME280 tiene H1 suelto y H2 a H6 empaquetados desde 0xE1 (sección 4.2.2 del datasheet)
+    uint8_t hum[NUM_CALIB_HUM_PARAMS] = { 0 };
+    if (!bmp280_read_regs(dev, REG_DIG_H1, &params->dig_h1, 1)) { return false; }
+    if (!bmp280_read_regs(dev, REG_DIG_H2_LSB, hum, NUM_CALIB_HUM_PARAMS)) { return false; }
+    params->dig_h2 = (int16_t)(hum[1] << 8) | hum[0];
+    params->dig_h3 = hum[2];
+    // 12 bits con signo: el byte alto con su signo por 16, desplazar un negativo es UB
+    params->dig_h4 = (int16_t)((int8_t)hum[3] * 16 | (hum[4] & 0x0F));
+    params->dig_h5 = (int16_t)((int8_t)hum[5] * 16 | (hum[4] >> 4));
+    params->dig_h6 = (int8_t)hum[6];
+    return true;
+}
+
+/**
+ * @brief Inicialización del BMP280/BME280. Detecta el tipo de sensor por
+ * el ID de chip, lee la calibracion y lo deja en modo sleep
+ * @param dev puntero al handle a inicializar
+ * @param i2c puntero a instancia de I2C
+ * @param addr direccion de 7 bits (BMP280_ADDR_PRIMARY o BMP280_ADDR_SECONDARY)
+ * @return true si se encontro un sensor compatible
+ */
+bool bmp280_init(bmp280_t *dev, i2c_inst_t *i2c, uint8_t addr) {
+    dev->i2c = i2c;
+    dev->addr = addr;
+    dev->state = BMP280_IDLE;
+    dev->raw_temp = 0;
+    dev->raw_pressure = 0;
+    dev->raw_humidity = 0;
+
+    // Identifico el chip, 0x56 y 0x57 son muestras de ingenieria del BMP280
+    if (!bmp280_read_regs(dev, REG_ID, &dev->chip_id, 1)) { return false; }
+    if (dev->chip_id == BME280_CHIP_ID) {
+        dev->has_humidity = true;
+    } else if (dev->chip_id >= 0x56 && dev->chip_id <= BMP280_CHIP_ID) {
+        dev->has_humidity = false;
+    } else {
+        return false;
+    }
+
+    if (!bmp280_get_calib_params(dev)) { return false; }
+
+    // En el BME280 el control de humedad se aplica al escribir ctrl_meas
+    if (dev->has_humidity && !bmp280_write_reg(dev, REG_CTRL_HUM, REG_CTRL_HUM_VAL)) { return false; }
+    if (!bmp280_write_reg(dev, REG_CONFIG, REG_CONFIG_VAL)) { return false; }
+    // Queda en sleep, cada lectura es una conversion en modo forzado
+    return bmp280_write_reg(dev, REG_CTRL_MEAS, REG_CTRL_MEAS_VAL(MODE_SLEEP));
+}
+
+/**
+ * @brief Software reset
+ * @param dev puntero al handle
+ * @return true si el sensor respondio
+ */
+bool bmp280_reset(bmp280_t *dev) {
+    // Resetear dispositivo
+    dev->state = BMP280_IDLE;
+    return bmp280_write_reg(dev, REG_RESET, 0xB6);
+}
+
+/**
+ * @brief Tiempo maximo de una conversion según la sección 9.1 del datasheet
+ * @param dev puntero al handle
+ * @return tiempo en microsegundos
+ */
+uint32_t bmp280_measure_time_us(const bmp280_t *dev) {
+    uint32_t t = 1250 + 2300 * OSRS_T + 2300 * OSRS_P + 575;
+    if (dev->has_humidity) { t += 2300 * OSRS_H + 575; }
+    return t;
 }
 
 /**
- * @brief Lee los valores de presión y temperatura sin compensar
- * @param raw_temp puntero donde guardar la temperatura
- * @param raw_pressure puntero donde guardar la presión
+ * @brief Primera fase: inicia una conversion en modo forzado. El sensor
+ * vuelve solo a sleep cuando termina, sin consumo entre lecturas
+ * @param dev puntero al handle
+ * @return true si el sensor respondio
  */
-void bmp280_read_raw(int32_t* raw_temp, int32_t* raw_pressure) {
+bool bmp280_start(bmp280_t *dev) {
+    if (!bmp280_write_reg(dev, REG_CTRL_MEAS, REG_CTRL_MEAS_VAL(MODE_FORCED))) { return false; }
+    dev->state = BMP280_CONVERTING;
+    return true;
+}
+
+/**
+ * @brief Segunda fase: consulta si termino la conversion. Es una transaccion
+ * corta, se puede llamar entre accesos de otros dispositivos del bus
+ * @param dev puntero al handle
+ * @return BMP280_DONE si ya se pueden leer los datos, BMP280_BUSY si sigue
+ * convirtiendo o BMP280_ERROR si el sensor no respondio
+ */
+bmp280_result_t bmp280_poll(bmp280_t *dev) {
+    // Leo estado y control juntos, al terminar el modo vuelve a sleep
+    uint8_t buf[2];
+    if (!bmp280_read_regs(dev, REG_STATUS, buf, 2)) { return BMP280_ERROR; }
+    if ((buf[0] & STATUS_MEASURING) || (buf[1] & MODE_MASK) != MODE_SLEEP) { return BMP280_BUSY; }
+    dev->state = BMP280_READY;
+    return BMP280_DONE;
+}
+
+/**
+ * @brief Tercera fase: lee en rafaga los datos sin compensar al handle
+ * @param dev puntero al handle
+ * @return BMP280_DONE o BMP280_ERROR si el sensor no respondio
+ */
+bmp280_result_t bmp280_fetch(bmp280_t *dev) {
     // Los registros dl BMP280 se autoincrementan
-    // Hay 3 de temperatura y 3 de presión, se arranca en 0xf7 y se leen 6 bytes hasta 0xfc
-    uint8_t buf[6];
-    uint8_t reg = REG_PRESSURE_MSB;
-    // true para mantener el control del bus desde el master
-    i2c_write_blocking(i2c_bmp, ADDR, &reg, 1, true);
-    // false porque se terminó la transacción
-    i2c_read_blocking(i2c_bmp, ADDR, buf, 6, false);
+    // Hay 3 de presión y 3 de temperatura desde 0xf7, el BME280 agrega 2 de humedad
+    uint8_t buf[8];
+    size_t len = dev->has_humidity ? 8 : 6;
+    dev->state = BMP280_IDLE;
+    if (!bmp280_read_regs(dev, REG_PRESSURE_MSB, buf, len)) { return BMP280_ERROR; }
 
     // Se arman los 20 bits de datos en variable con signo de 32 bits
-    *raw_pressure = (buf[0] << 12) | (buf[1] << 4) | (buf[2] >> 4);
-    *raw_temp = (buf[3] << 12) | (buf[4] << 4) | (buf[5] >> 4);
+    dev->raw_pressure = (buf[0] << 12) | (buf[1] << 4) | (buf[2] >> 4);
+    dev->raw_temp = (buf[3] << 12) | (buf[4] << 4) | (buf[5] >> 4);
+    // La humedad es de 16 bits
+    if (dev->has_humidity) { dev->raw_humidity = (buf[6] << 8) | buf[7]; }
+    return BMP280_DONE;
+}
+
+/**
+ * @brief Avanza un paso la lectura por fases sin esperar. Pensada para que
+ * un planificador de bus la llame entre transacciones de otros dispositivos
+ * @param dev puntero al handle
+ * @return BMP280_DONE cuando hay datos nuevos en el handle, BMP280_BUSY
+ * mientras la lectura esta en curso o BMP280_ERROR
+ */
+bmp280_result_t bmp280_step(bmp280_t *dev) {
+    switch (dev->state) {
+        case BMP280_IDLE:
+            return bmp280_start(dev) ? BMP280_BUSY : BMP280_ERROR;
+        case BMP280_CONVERTING: {
+            bmp280_result_t res = bmp280_poll(dev);
+            return res == BMP280_DONE ? bmp280_fetch(dev) : res;
+        }
+        case BMP280_READY:
+        default:
+            return bmp280_fetch(dev);
+    }
+}
+
+/**
+ * @brief Lectura completa bloqueante: convierte, espera y lee
+ * @param dev puntero al handle
+ * @return BMP280_DONE o BMP280_ERROR si el sensor no respondio
+ */
+bmp280_result_t bmp280_read_raw(bmp280_t *dev) {
+    if (!bmp280_start(dev)) { return BMP280_ERROR; }
+    sleep_us(bmp280_measure_time_us(dev));
+
+    bmp280_result_t res;
+    while ((res = bmp280_poll(dev)) == BMP280_BUSY) { sleep_us(500); }
+    return res == BMP280_DONE ? bmp280_fetch(dev) : res;
 }
 
 /**
@@ -128,8 +270,9 @@ int32_t bmp280_convert_pressure(int32_t raw_pressure, int32_t raw_temp, struct b
     uint32_t converted = 0.0;
     var1 = (((int32_t)t_fine) >> 1) - (int32_t)64000;
     var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ((int32_t)params->dig_p6);
-    var2 += ((var1 * ((int32_t)params->dig_p5)) << 1);
-    var2 = (var2 >> 2) + (((int32_t)params->dig_p4) << 16);
+    // Las formulas del datasheet desplazan a la izquierda valores con signo: van como productos
+    var2 += ((var1 * ((int32_t)params->dig_p5)) * 2);
+    var2 = (var2 >> 2) + (((int32_t)params->dig_p4) * 65536);
     var1 = (((params->dig_p3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((((int32_t)params->dig_p2) * var1) >> 1)) >> 18;
     var1 = ((((32768 + var1)) * ((int32_t)params->dig_p1)) >> 15);
     if (var1 == 0) {
@@ -145,4 +288,26 @@ int32_t bmp280_convert_pressure(int32_t raw_pressure, int32_t raw_temp, struct b
     var2 = (((int32_t)(converted >> 2)) * ((int32_t)params->dig_p8)) >> 13;
     converted = (uint32_t)((int32_t)converted + ((var1 + var2 + params->dig_p7) >> 4));
     return converted;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Obtiene el valor compensado de humedad según la sección 4.2.3 del datasheet del BME280
+ * @param raw_humidity valor de humedad sin compensar
+ * @param raw_temp valor de tempratura sin compensar
+ * @param params puntero a parámetros de calibración
+ * @return humedad relativa en %
+ */
+float bme280_convert_humidity(int32_t raw_humidity, int32_t raw_temp, struct bmp280_calib_param* params) {
+    // Compensa el valor de temperatura de los registros
+    int32_t t_fine = bmp280_convert(raw_temp, params);
+    // Compensa la humedad
+    int32_t v = t_fine - (int32_t)76800;
+    v = (((((raw_humidity << 14) - (((int32_t)params->dig_h4) * 1048576) - (((int32_t)params->dig_h5) * v)) + (int32_t)16384) >> 15) *
+         (((((((v * ((int32_t)params->dig_h6)) >> 10) * (((v * ((int32_t)params->dig_h3)) >> 11) + (int32_t)32768)) >> 10) +
+            (int32_t)2097152) * ((int32_t)params->dig_h2) + 8192) >> 14));
+    v = v - (((((v >> 15) * (v >> 15)) >> 7) * ((int32_t)params->dig_h1)) >> 4);
+    v = v < 0 ? 0 : v;
+    v = v > 419430400 ? 419430400 : v;
+    // El resultado esta en Q22.10
+    return (v >> 12) / 1024.0f;
+}
@@ -0,0 +1,354 @@
+#include <math.h>
+#include <string.h>
+
+#include "check.h"
+#include "bmp280.h"
+#include "i2c_trace.h"
+
+/**
+ * @brief Simulador de los registros de un BMP280/BME280 del otro lado del bus.
+ * Reemplaza a i2c_trace_write_blocking e i2c_trace_read_blocking
+ */
+typedef struct {
+    uint8_t addr;               // Direccion a la que responde
+    bool present;               // false para que no conteste (NACK)
+    uint8_t regs[256];          // Registros, 0x88 a 0xFE
+    uint8_t pointer;            // Registro de la proxima lectura
+    uint64_t done_us;           // Fin de la conversion en curso
+    bool converting;
+    uint8_t osrs_h;             // Sobremuestreo de humedad tomado al escribir ctrl_meas
+    int32_t adc_t, adc_p, adc_h;    // Valores que deja la proxima conversion
+    uint32_t conversions;
+    uint32_t bad_writes;        // Escrituras a registros que no existen o en mal momento
+    uint32_t transactions;
+} sim_t;
+
+static sim_t sim;
+
+// Calibracion del ejemplo de la seccion 3.12 del datasheet del BMP280
+static const struct bmp280_calib_param datasheet = {
+    .dig_t1 = 27504, .dig_t2 = 26435, .dig_t3 = -1000,
+    .dig_p1 = 36477, .dig_p2 = -10685, .dig_p3 = 3024, .dig_p4 = 2855, .dig_p5 = 140,
+    .dig_p6 = -7, .dig_p7 = 15500, .dig_p8 = -14600, .dig_p9 = 6000,
+    // Humedad de un BME280 de produccion, el datasheet no trae un ejemplo
+    .dig_h1 = 75, .dig_h2 = 362, .dig_h3 = 0, .dig_h4 = 313, .dig_h5 = 50, .dig_h6 = 30,
+};
+
+// Carga la calibracion en los registros con el empaquetado de la seccion 4.2.2 del BME280
+static void sim_calib(const struct bmp280_calib_param *c) {
+    const uint16_t words[12] = { c->dig_t1, (uint16_t)c->dig_t2, (uint16_t)c->dig_t3, c->dig_p1, (uint16_t)c->dig_p2,
+                                 (uint16_t)c->dig_p3, (uint16_t)c->dig_p4, (uint16_t)c->dig_p5, (uint16_t)c->dig_p6,
+                                 (uint16_t)c->dig_p7, (uint16_t)c->dig_p8, (uint16_t)c->dig_p9 };
+    for (int i = 0; i < 12; i++) {
+        sim.regs[REG_DIG_T1_LSB + 2 * i] = words[i] & 0xFF;
+        sim.regs[REG_DIG_T1_LSB + 2 * i + 1] = words[i] >> 8;
+    }
+    sim.regs[REG_DIG_H1] = c->dig_h1;
+    sim.regs[0xE1] = (uint16_t)c->dig_h2 & 0xFF;
+    sim.regs[0xE2] = (uint16_t)c->dig_h2 >> 8;
+    sim.regs[0xE3] = c->dig_h3;
+    sim.regs[0xE4] = ((uint16_t)c->dig_h4 >> 4) & 0xFF;
+    sim.regs[0xE5] = ((uint16_t)c->dig_h4 & 0x0F) | (((uint16_t)c->dig_h5 & 0x0F) << 4);
+    sim.regs[0xE6] = ((uint16_t)c->dig_h5 >> 4) & 0xFF;
+    sim.regs[0xE7] = (uint8_t)c->dig_h6;
+}
+
+static void sim_init(uint8_t chip_id, uint8_t addr) {
+    memset(&sim, 0, sizeof(sim));
+    sim.addr = addr;
+    sim.present = true;
+    sim.regs[REG_ID] = chip_id;
+    sim_calib(&datasheet);
+    sim.adc_t = 519888;
+    sim.adc_p = 415148;
+    sim.adc_h = 30000;
+}
+
+static bool sim_is_bme(void) {
+    return sim.regs[REG_ID] == BME280_CHIP_ID;
+}
+
+// Tiempo maximo de conversion de la seccion 9.1 con el sobremuestreo escrito (0 es salteado)
+static uint32_t sim_conversion_us(uint8_t ctrl_meas) {
+    static const uint8_t factor[8] = { 0, 1, 2, 4, 8, 16, 16, 16 };
+    uint8_t osrs_t = factor[ctrl_meas >> 5], osrs_p = factor[(ctrl_meas >> 2) & 0x07];
+    uint32_t t = 1250 + 2300 * osrs_t;
+    if (osrs_p) { t += 2300 * osrs_p + 575; }
+    if (sim_is_bme() && sim.osrs_h) { t += 2300 * factor[sim.osrs_h] + 575; }
+    return t;
+}
+
+// Si la conversion termino, vuelve a sleep y publica los datos
+static void sim_update(void) {
+    if (!sim.converting || host_time_us < sim.done_us) { return; }
+    sim.converting = false;
+    sim.conversions++;
+    sim.regs[REG_CTRL_MEAS] &= ~0x03;
+    sim.regs[REG_PRESSURE_MSB] = sim.adc_p >> 12;
+    sim.regs[REG_PRESSURE_LSB] = (sim.adc_p >> 4) & 0xFF;
+    sim.regs[REG_PRESSURE_XLSB] = (sim.adc_p & 0x0F) << 4;
+    sim.regs[REG_TEMP_MSB] = sim.adc_t >> 12;
+    sim.regs[REG_TEMP_LSB] = (sim.adc_t >> 4) & 0xFF;
+    sim.regs[REG_TEMP_XLSB] = (sim.adc_t & 0x0F) << 4;
+    if (sim_is_bme() && sim.osrs_h) {
+        sim.regs[REG_HUM_MSB] = sim.adc_h >> 8;
+        sim.regs[REG_HUM_LSB] = sim.adc_h & 0xFF;
+    }
+}
+
+int i2c_trace_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c;
+    (void)nostop;
+    sim.transactions++;
+    // Cada transaccion del bus lleva su tiempo, 100 kHz
+    host_time_us += (1 + len) * 90;
+    if (!sim.present || addr != sim.addr || !len) { return PICO_ERROR_GENERIC; }
+    sim_update();
+
+    sim.pointer = src[0];
+    // Pares registro y valor
+    for (size_t i = 0; i + 1 < len; i += 2) {
+        uint8_t reg = src[i], val = src[i + 1];
+        if (reg == REG_RESET) {
+            if (val == 0xB6) {
+                sim.regs[REG_CTRL_MEAS] = sim.regs[REG_CONFIG] = sim.regs[REG_CTRL_HUM] = 0;
+                sim.converting = false;
+            }
+        } else if (reg == REG_CTRL_HUM && sim_is_bme()) {
+            sim.regs[reg] = val & 0x07;
+        } else if (reg == REG_CONFIG) {
+            // En modo normal solo se puede escribir en sleep, el driver usa siempre forzado
+            if (sim.converting) { sim.bad_writes++; }
+            sim.regs[reg] = val;
+        } else if (reg == REG_CTRL_MEAS) {
+            if (sim.converting) { sim.bad_writes++; }
+            sim.regs[reg] = val;
+            // ctrl_hum recien se aplica al escribir ctrl_meas
+            sim.osrs_h = sim.regs[REG_CTRL_HUM];
+            if ((val & 0x03) == 0x01 || (val & 0x03) == 0x02) {
+                sim.converting = true;
+                sim.done_us = host_time_us + sim_conversion_us(val);
+            }
+        } else {
+            sim.bad_writes++;
+        }
+    }
+    return (int)len;
+}
+
+int i2c_trace_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    (void)i2c;
+    (void)nostop;
+    sim.transactions++;
+    host_time_us += (1 + len) * 90;
+    if (!sim.present || addr != sim.addr) { return PICO_ERROR_GENERIC; }
+    sim_update();
+
+    for (size_t i = 0; i < len; i++) {
+        uint8_t reg = sim.pointer++;
+        dst[i] = sim.regs[reg];
+        if (reg == REG_STATUS) { dst[i] = sim.converting ? STATUS_MEASURING : 0; }
+    }
+    return (int)len;
+}
+
+// Compensacion en punto flotante de la seccion 8.1 del datasheet del BMP280 y 4.2.3 del BME280
+static double reference_t_fine(int32_t adc_t, const struct bmp280_calib_param *c) {
+    double var1 = (adc_t / 16384.0 - c->dig_t1 / 1024.0) * c->dig_t2;
+    double var2 = (adc_t / 131072.0 - c->dig_t1 / 8192.0) * (adc_t / 131072.0 - c->dig_t1 / 8192.0) * c->dig_t3;
+    return var1 + var2;
+}
+
+static double reference_pressure(int32_t adc_p, int32_t adc_t, const struct bmp280_calib_param *c) {
+    double var1 = reference_t_fine(adc_t, c) / 2.0 - 64000.0;
+    double var2 = var1 * var1 * c->dig_p6 / 32768.0;
+    var2 = var2 + var1 * c->dig_p5 * 2.0;
+    var2 = var2 / 4.0 + c->dig_p4 * 65536.0;
+    var1 = (c->dig_p3 * var1 * var1 / 524288.0 + c->dig_p2 * var1) / 524288.0;
+    var1 = (1.0 + var1 / 32768.0) * c->dig_p1;
+    if (var1 == 0.0) { return 0; }
+    double p = 1048576.0 - adc_p;
+    p = (p - var2 / 4096.0) * 6250.0 / var1;
+    var1 = c->dig_p9 * p * p / 2147483648.0;
+    var2 = p * c->dig_p8 / 32768.0;
+    return p + (var1 + var2 + c->dig_p7) / 16.0;
+}
+
+static double reference_humidity(int32_t adc_h, int32_t adc_t, const struct bmp280_calib_param *c) {
+    double h = reference_t_fine(adc_t, c) - 76800.0;
+    h = (adc_h - (c->dig_h4 * 64.0 + c->dig_h5 / 16384.0 * h)) *
+        (c->dig_h2 / 65536.0 * (1.0 + c->dig_h6 / 67108864.0 * h * (1.0 + c->dig_h3 / 67108864.0 * h)));
+    h = h * (1.0 - c->dig_h1 * h / 524288.0);
+    return h > 100.0 ? 100.0 : (h < 0.0 ? 0.0 : h);
+}
+
+// Deteccion del chip por el ID y lectura de la calibracion
+static void test_detection(void) {
+    bmp280_t dev;
+
+    sim_init(BMP280_CHIP_ID, BMP280_ADDR_PRIMARY);
+    CHECK(bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY));
+    CHECK(!dev.has_humidity);
+    CHECK_EQ(dev.chip_id, BMP280_CHIP_ID);
+    CHECK(!memcmp(&dev.calib.dig_t1, &datasheet.dig_t1, offsetof(struct bmp280_calib_param, dig_h1)));
+    CHECK_EQ(sim.regs[REG_CTRL_MEAS] & 0x03, 0);     // Queda en sleep
+    CHECK_EQ(sim.bad_writes, 0);                     // No toca ctrl_hum, que no existe
+
+    // Muestras de ingenieria del BMP280
+    sim_init(0x56, BMP280_ADDR_PRIMARY);
+    CHECK(bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY) && !dev.has_humidity);
+    sim_init(0x57, BMP280_ADDR_PRIMARY);
+    CHECK(bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY) && !dev.has_humidity);
+
+    // BME280 en la direccion secundaria, con la calibracion de humedad
+    sim_init(BME280_CHIP_ID, BMP280_ADDR_SECONDARY);
+    CHECK(bmp280_init(&dev, i2c0, BMP280_ADDR_SECONDARY));
+    CHECK(dev.has_humidity);
+    CHECK_EQ(dev.calib.dig_h1, datasheet.dig_h1);
+    CHECK_EQ(dev.calib.dig_h2, datasheet.dig_h2);
+    CHECK_EQ(dev.calib.dig_h3, datasheet.dig_h3);
+    CHECK_EQ(dev.calib.dig_h4, datasheet.dig_h4);
+    CHECK_EQ(dev.calib.dig_h5, datasheet.dig_h5);
+    CHECK_EQ(dev.calib.dig_h6, datasheet.dig_h6);
+    CHECK_EQ(sim.regs[REG_CTRL_HUM], 0x01);
+    CHECK_EQ(sim.bad_writes, 0);
+
+    // H4 y H5 negativos y H6 negativo, por el empaquetado de 12 bits
+    struct bmp280_calib_param negative = datasheet;
+    negative.dig_h4 = -1234;
+    negative.dig_h5 = -2047;
+    negative.dig_h6 = -5;
+    sim_init(BME280_CHIP_ID, BMP280_ADDR_PRIMARY);
+    sim_calib(&negative);
+    CHECK(bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY));
+    CHECK_EQ(dev.calib.dig_h4, -1234);
+    CHECK_EQ(dev.calib.dig_h5, -2047);
+    CHECK_EQ(dev.calib.dig_h6, -5);
+
+    // Otros chips, otra direccion o nadie en el bus
+    sim_init(0x55, BMP280_ADDR_PRIMARY);
+    CHECK(!bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY));
+    sim_init(0x61, BMP280_ADDR_PRIMARY);
+    CHECK(!bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY));
+    sim_init(BMP280_CHIP_ID, BMP280_ADDR_SECONDARY);
+    CHECK(!bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY));
+    sim_init(BMP280_CHIP_ID, BMP280_ADDR_PRIMARY);
+    sim.present = false;
+    CHECK(!bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY));
+}
+
+// Lectura por fases: inicio, consultas mientras convierte y lectura de los datos
+static void test_phases(bool bme) {
+    bmp280_t dev;
+
+    sim_init(bme ? BME280_CHIP_ID : BMP280_CHIP_ID, BMP280_ADDR_PRIMARY);
+    CHECK(bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY));
+    sim.adc_t = 519888;
+    sim.adc_p = 415148;
+    sim.adc_h = 31234;
+
+    for (int reading = 0; reading < 3; reading++) {
+        CHECK_EQ(dev.state, BMP280_IDLE);
+        CHECK_EQ(bmp280_step(&dev), BMP280_BUSY);        // Inicia la conversion
+        CHECK_EQ(dev.state, BMP280_CONVERTING);
+        CHECK(sim.converting);
+        uint32_t conversion = (uint32_t)(sim.done_us - host_time_us);
+
+        // Las consultas antes de tiempo no leen datos
+        int polls = 0;
+        bmp280_result_t res;
+        while ((res = bmp280_step(&dev)) == BMP280_BUSY && polls < 100) {
+            polls++;
+            host_time_us += 500;
+        }
+        CHECK_EQ(res, BMP280_DONE);
+        CHECK(polls >= 1);
+        CHECK_EQ(dev.state, BMP280_IDLE);
+        CHECK_EQ(dev.raw_temp, sim.adc_t);
+        CHECK_EQ(dev.raw_pressure, sim.adc_p);
+        CHECK_EQ(dev.raw_humidity, bme ? sim.adc_h : 0);
+
+        // El tiempo maximo del driver cubre la conversion con el sobremuestreo configurado
+        CHECK(bmp280_measure_time_us(&dev) >= conversion);
+
+        sim.adc_t += 1000;
+        sim.adc_p -= 2000;
+        sim.adc_h += 500;
+    }
+    CHECK_EQ(sim.conversions, 3);
+    CHECK_EQ(sim.bad_writes, 0);
+
+    // Lectura bloqueante: espera el tiempo maximo y consulta una sola vez
+    uint32_t before = sim.transactions;
+    CHECK_EQ(bmp280_read_raw(&dev), BMP280_DONE);
+    CHECK_EQ(sim.transactions - before, 1 + 2 + 2);     // ctrl_meas, estado y datos
+    CHECK_EQ(dev.raw_temp, sim.adc_t);
+
+    // Sin respuesta en cualquier fase
+    CHECK_EQ(bmp280_step(&dev), BMP280_BUSY);
+    sim.present = false;
+    CHECK_EQ(bmp280_step(&dev), BMP280_ERROR);
+    sim.present = true;
+    host_time_us += 20000;
+    CHECK_EQ(bmp280_step(&dev), BMP280_DONE);
+    sim.present = false;
+    CHECK_EQ(bmp280_step(&dev), BMP280_ERROR);
+    CHECK_EQ(dev.state, BMP280_IDLE);
+
+    // El reset vuelve al principio de la lectura
+    sim.present = true;
+    CHECK_EQ(bmp280_step(&dev), BMP280_BUSY);
+    CHECK(bmp280_reset(&dev));
+    CHECK_EQ(dev.state, BMP280_IDLE);
+    CHECK(!sim.converting);
+}
+
+// Compensacion contra el ejemplo y las formulas en punto flotante del datasheet
+static void test_compensation(void) {
+    struct bmp280_calib_param c = datasheet;
+
+    // Ejemplo de la seccion 3.12: 25,08 C y 100653,27 Pa en punto flotante, 100656 Pa con la
+    // version de 32 bits que usa el driver
+    CHECK(fabs(bmp280_convert_temp(519888, &c) - 25.08) < 0.005);
+    CHECK(fabs(reference_t_fine(519888, &c) / 5120.0 - 25.08) < 0.005);
+    CHECK(fabs(reference_pressure(415148, 519888, &c) - 100653.27) < 0.01);
+    CHECK_EQ(bmp280_convert_pressure(415148, 519888, &c), 100656);
+
+    // Todo el rango de temperatura (-40 a 85 C) y de presion (300 a 1100 hPa)
+    double t_max = 0, p_max = 0, h_max = 0;
+    for (int32_t adc_t = 400000; adc_t <= 640000; adc_t += 997) {
+        double t = reference_t_fine(adc_t, &c) / 5120.0;
+        if (t < -40.0 || t > 85.0) { continue; }
+        double dt = fabs(bmp280_convert_temp(adc_t, &c) - t);
+        if (dt > t_max) { t_max = dt; }
+
+        for (int32_t adc_p = 200000; adc_p <= 650000; adc_p += 4999) {
+            double p = reference_pressure(adc_p, adc_t, &c);
+            if (p < 30000.0 || p > 110000.0) { continue; }
+            double dp = fabs(bmp280_convert_pressure(adc_p, adc_t, &c) - p);
+            if (dp > p_max) { p_max = dp; }
+        }
+        for (int32_t adc_h = 0; adc_h <= 65535; adc_h += 257) {
+            double dh = fabs(bme280_convert_humidity(adc_h, adc_t, &c) - reference_humidity(adc_h, adc_t, &c));
+            if (dh > h_max) { h_max = dh; }
+        }
+    }
+    printf("error maximo contra el datasheet: %.4f C, %.2f Pa, %.4f %%HR\n", t_max, p_max, h_max);
+    // Resolucion de las versiones enteras: 0,01 C y 1/1024 %HR. La presion de 32 bits
+    // trunca en cada paso y se aleja algunos Pa (3 en el ejemplo del datasheet)
+    CHECK(t_max <= 0.01);
+    CHECK(p_max <= 8.0);
+    CHECK(h_max <= 0.01);
+
+    // La humedad queda entre 0 y 100
+    CHECK(bme280_convert_humidity(0, 519888, &c) == 0.0f);
+    CHECK(bme280_convert_humidity(65535, 519888, &c) == 100.0f);
+}
+
+int main(void) {
+    test_detection();
+    test_phases(false);
+    test_phases(true);
+    test_compensation();
+    return check_result("bmp280");
+}
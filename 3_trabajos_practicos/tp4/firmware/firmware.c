@@ -1,17 +1,30 @@
 // Librerias propias del micro
 #include <stdio.h>
+#include <stddef.h>
+#include <string.h>
 #include <math.h>
 #include "pico/stdlib.h"
-#include "hardware/pwm.h"
 #include "hardware/irq.h"
 // Librerias de FreRtos
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
-#include "semphr.h"
-// Librerias del LCD y del sensor
+// Librerias del LCD, del sensor y de entradas
 #include "bmp280.h"
 #include "lcd.h"
+#include "input.h"
+#include "deferred.h"
+#include "stats.h"
+#include "flashlog.h"
+#include "tscomp.h"
+#include "telemetry.h"
+#include "shell.h"
+#include "i2c_trace.h"
+#include "mailbox.h"
+#include "ao.h"
+#include "ledfx.h"
+#include "i2csched.h"
+#include "task_stacks.h"
 
 // Defino los pines del I2C
 #define I2C_PORT       i2c0     // Puerto principal del I2C
@@ -23,128 +36,545 @@
 // Defino los pines GPIO del MICROSWITCH y el LED
 #define BUTTON_PIN     15      // GPIO entrada con interrupción
 #define LED_PWM_PIN    16      // GPIO salida PWM para LED
+#define DEBOUNCE_MS    20      // Tiempo de antirrebote del pulsador
 
-// Defino constantes de seteo para la temperatura
-#define SETPOINT       25.0f   // Setpoint fijo en °C
+// Valores por defecto de la configuracion, se cambian en vivo desde el shell
+#define SETPOINT       25.0f   // Setpoint en °C
 #define MAX_ERROR      50.0f   // Máximo error considerado para PWM
-
-// Defino el valor del PWM
-#define PWM_WRAP 1000          // PWM va de 0-1000
+#define PWM_WRAP       4095    // PWM de 12 bits, alcanza para los niveles bajos de la curva gamma
+#define SAMPLE_MS      1000    // Periodo entre lecturas del sensor
+
+// Prioridades y plazos de los clientes del bus
+#define BUS_SENSOR_PRIORITY    2
+#define BUS_SENSOR_DEADLINE_US 2000    // Una fase de la lectura, aunque el LCD este redibujando
+#define BUS_SHELL_PRIORITY     1
+#define BUS_SHELL_DEADLINE_US  20000
+#define BUS_LCD_PRIORITY       0
+#define BUS_LCD_DEADLINE_US    100000  // Un cuadro completo
+
+// Iteraciones del comando bench
+#define BENCH_ITERATIONS       1000
+
+// Ventanas de estadisticas, una muestra por periodo (un segundo por defecto)
+#define STATS_MIN_BUCKETS      6       // 1 minuto en baldes de 10 muestras
+#define STATS_MIN_SAMPLES      10
+#define STATS_HOUR_BUCKETS     60      // 1 hora en baldes de 60 muestras
+#define STATS_HOUR_SAMPLES     60
+
+// Historial comprimido en los ultimos sectores de la flash (256 KB, unas 180000 muestras)
+#define HISTORY_SECTORS        64
+
+// Canales de telemetria
+#define TLM_SENSOR     0       // Temperatura y presion de cada muestra
+#define TLM_TEMP_1M    1       // Estadisticas de temperatura del ultimo minuto
+#define TLM_PRES_1M    2       // Estadisticas de presion del ultimo minuto
+#define TLM_TEMP_1H    3       // Estadisticas de temperatura de la ultima hora
+#define TLM_TEMP_Q     4       // Cuantiles 5, 50 y 95 % de temperatura del ultimo minuto
+
+// Cantidad de pantallas del LCD
+#define SCREEN_COUNT   3
+
+// Eventos de cada objeto activo
+#define OBJECT_QUEUE   4
+
+// Señales de los objetos activos
+enum {
+    SIG_SAMPLE = AO_SIG_USER,  // Vencio la espera de la proxima fase de la lectura
+    SIG_PHASE,                 // La tarea del bus termino una fase, el resultado va en el argumento
+    SIG_SENSOR,                // Hay una medicion nueva en latest, se publica
+    SIG_BUTTON,                // Se presiono el pulsador
+    SIG_PAGE                   // Hay una pagina completa del historial para grabar
+};
 
 // Estructura de variables de presion y temperatura
 typedef struct {
     float temperature;         // Variable float de la temperatura
     float pressure;            // Variable float de la presión
+    float temp_min;            // Temperatura minima del ultimo minuto
+    float temp_max;            // Temperatura maxima del ultimo minuto
+    float temp_mean_hour;      // Temperatura media de la ultima hora
+    float pres_mean_hour;      // Presion media de la ultima hora
 } sensor_data_t;               // Tipo de datos para declarar variable de estructura
 
-// Variables de la cola y del semáforo
-QueueHandle_t queue_sensor_data;     // Variable de la cola
-SemaphoreHandle_t i2c_mutex;         // Variable del semaforo Mutex para el sensor
-SemaphoreHandle_t sem_button;        // Variable del semaforo binario para el microswitch 
-
-// Variable global de modo pantalla (0 o 1)
-volatile int screen_mode = 0;        // Variable para seleccion de pantallas
-
-// Variables globales para debounce 
-TickType_t last_button_time = 0;                            // Variable que cuenta el tiempo de la ultima vez que se presiono el boton
-const TickType_t debounce_delay = pdMS_TO_TICKS(200);       // Variable que se la carga el valor de 200 ticks para comparar tiempo antirrebote
+// Canales de las muestras del historial
+#define HISTORY_TEMP   0       // Temperatura en centesimas de °C
+#define HISTORY_PRES   1       // Presion en Pa
 
-// ISR del botón, o sea por interrupcion
-void button_isr(uint gpio, uint32_t events) {                          // Funcion de interrupcion para lectura del pulsador
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;                     // Variable asociada al semaforo
-    xSemaphoreGiveFromISR(sem_button, &xHigherPriorityTaskWoken);      // Se cede el semaforo para operar luego de apretar el boton
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);                      // Realiza el cambio de contexto freertos ya tiende la interuupcion
-}
+// Configuracion ajustable en vivo
+typedef struct {
+    float setpoint;            // Setpoint en °C
+    float max_error;           // Máximo error considerado para PWM
+    uint32_t pwm_wrap;         // Valor maximo del contador del PWM
+    uint32_t sample_ms;        // Periodo entre lecturas del sensor
+} control_config_t;
+
+// Handle del sensor de temperatura y presion
+bmp280_t sensor;
+
+// Historial de mediciones en flash
+flashlog_t history;
+
+// Planificador del bus I2C: el sensor va antes que el LCD, que se manda de a un comando
+i2csched_t bus;
+i2csched_client_t sensor_client, lcd_client, shell_client;
+i2csched_job_t sensor_job, lcd_job;
+lcd_frame_t frame;                   // Contenido del LCD, se redibuja entero con cada cambio
+int button_channel;                  // Canal del pulsador en el servicio de entradas
+
+// Sensor, LCD e historial son objetos activos. Sensor y LCD comparten la tarea y el stack del
+// ejecutor de control, el historial queda en uno de menor prioridad porque grabar la flash demora
+ao_executor_t control_executor, log_executor;
+ao_t sensor_ao, lcd_ao, log_ao;
+AO_QUEUE(sensor_queue, OBJECT_QUEUE);
+AO_QUEUE(lcd_queue, OBJECT_QUEUE);
+AO_QUEUE(log_queue, OBJECT_QUEUE);
+
+// LED con brillo proporcional al error, lo maneja el DMA entre mediciones
+ledfx_t led;
+
+// Cambios de contexto, los cuenta el kernel con traceTASK_SWITCHED_IN
+volatile unsigned long task_switches;
+
+// Configuracion, la escribe el shell y la leen las tareas sin bloquearse
+control_config_t config = { SETPOINT, MAX_ERROR, PWM_WRAP, SAMPLE_MS };
+seqlock_t config_lock;
+
+// Ultima medicion, para el comando stats y para redibujar al cambiar de pantalla
+static MAILBOX_BUFFER(latest_buf, sensor_data_t);
+mailbox_t latest;
+
+// Interprete de comandos por USB
+shell_t shell;
+
+// Parametros que se pueden cambiar desde el shell
+static const shell_param_t shell_params[] = {
+    { "setpoint", SHELL_PARAM_FLOAT, offsetof(control_config_t, setpoint), -40.0f, 85.0f },
+    { "max_error", SHELL_PARAM_FLOAT, offsetof(control_config_t, max_error), 0.1f, 100.0f },
+    { "pwm_wrap", SHELL_PARAM_UINT, offsetof(control_config_t, pwm_wrap), 10.0f, LEDFX_TOP_MAX },
+    { "sample_ms", SHELL_PARAM_UINT, offsetof(control_config_t, sample_ms), 100.0f, 60000.0f }
+};
 
 // Inicialización de PWM 
 void init_pwm() {
-    gpio_set_function(LED_PWM_PIN, GPIO_FUNC_PWM);            // Defino el pin como salida PWM
-    uint slice = pwm_gpio_to_slice_num(LED_PWM_PIN);          // Ciclo de actividad para el PWM
-    pwm_set_wrap(slice, PWM_WRAP);                            // Resolucion de PWM o valor maximo  
-    pwm_set_chan_level(slice, PWM_CHAN_A, 0);                 // Duty inicial, comienza apagado
-    pwm_set_enabled(slice, true);                             // Habilito PWM
+    if (!ledfx_init(&led, LED_PWM_PIN, PWM_WRAP)) {           // PWM del pin y dos canales DMA, comienza apagado
+        panic("ledfx: no hay canales DMA libres");
+    }
 }
 
-// Inicialización del botón con interrupción y pull-up 
+// Trabajo diferido del pulsador: la pantalla es estado del LCD, solo le avisa
+void button_pressed(void *context, uint32_t events) {
+    ao_post(&lcd_ao, SIG_BUTTON, 0);
+}
+
+// Inicialización del botón con interrupción y pull-up, el antirrebote lo hace el servicio de entradas
 void init_button() {
-    gpio_init(BUTTON_PIN);                    // Defino el pin del boton
-    gpio_set_dir(BUTTON_PIN, GPIO_IN);        // Defino el pin del boton como entrada
-    gpio_pull_up(BUTTON_PIN);                 // Usar resistencia interna de pull up
-    gpio_set_irq_enabled_with_callback(BUTTON_PIN, GPIO_IRQ_EDGE_FALL, true, &button_isr);  // Defino que es por interrupcion
-}
-
-// Tarea para el sensor BMP280
-void vTaskSensor(void *pvParameters) {
-    sensor_data_t data;                        // Variable del tipo estructura para los datos del senso
-    int32_t raw_temp = 0, raw_pres = 0;        // Variable de tipo entera para los datos en crudo del sensor
-    struct bmp280_calib_param calib;           // Variable de tipo estructura para la calibración del sensor
-
-    // Carga los parámetros de fábrica del sensor
-    bmp280_get_calib_params(&calib);
-
-    while (1) {
-        if (xSemaphoreTake(i2c_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {                           // Tomar Mutex con TimeOut_ticks de 100 ms
-            bmp280_read_raw(&raw_temp, &raw_pres);                                               // Lectura directa del sensor
-            data.temperature = bmp280_convert_temp(raw_temp, &calib);                            // Compensación temperatura
-            data.pressure = bmp280_convert_pressure(raw_pres, raw_temp, &calib) / 1000.0f;       // Compensación de presión
-            xSemaphoreGive(i2c_mutex);                                                           // Entrega el semáforo
-            xQueueSend(queue_sensor_data, &data, 0);                                             // Envia a la cola para el LCD
+    input_config_t config = {
+        .gpio = BUTTON_PIN,                   // Defino el pin del boton
+        .active_low = true,                   // Usar resistencia interna de pull up
+        .debounce_ms = DEBOUNCE_MS,           // Tiempo que debe estar estable para ser una pulsacion valida
+        .events = INPUT_EVENT_PRESS,          // Solo interesa el momento en que se presiona
+        .handler = button_pressed             // Se atiende como trabajo diferido, sin consultar desde el LCD
+    };
+    button_channel = input_register(&config); // Registro el pulsador
+    input_start(0);                           // Arranca el servicio con el periodo de muestreo por defecto
+}
+
+// Trabajo del sensor en el bus: una fase de la lectura, unas pocas transacciones cortas.
+// Avisa el resultado al objeto del sensor, que nunca espera el bus. La cola no se llena:
+// el objeto tiene pendiente una sola fase o una sola espera a la vez
+uint32_t sensor_step(i2csched_job_t *job) {
+    ao_post(&sensor_ao, SIG_PHASE, (uint32_t)bmp280_step(&sensor));
+    return I2CSCHED_DONE;
+}
+
+// Trabajo del LCD en el bus: un comando por paso, el sensor puede pasar entre dos comandos
+uint32_t lcd_step(i2csched_job_t *job) {
+    uint32_t busy_us = lcd_frame_send(&frame, job->chunk);
+    return job->chunk + 1 < LCD_FRAME_COMMANDS ? busy_us : I2CSCHED_DONE;
+}
+
+// Objeto del sensor BMP280: cada vencimiento pide una fase de la lectura al bus y el aviso de la fase la sigue
+void sensor_handler(ao_t *ao, const ao_event_t *event) {
+    static sensor_data_t data;                 // Variable del tipo estructura para los datos del senso
+    static uint8_t block[FLASHLOG_BLOCK_SIZE]; // Bloque comprimido en curso, ocupa una pagina de la flash
+    static tscomp_encoder_t encoder;           // Compresor del bloque
+    static TickType_t conversion;              // Tiempo de conversion del sensor
+    static ao_timer_t timer;                   // Espera entre fases y entre lecturas
+
+    // Ventanas de estadisticas de memoria fija, solo las usa este objeto
+    static stats_t temp_min_buckets[STATS_MIN_BUCKETS], temp_hour_buckets[STATS_HOUR_BUCKETS];
+    static stats_t pres_min_buckets[STATS_MIN_BUCKETS], pres_hour_buckets[STATS_HOUR_BUCKETS];
+    static stats_window_t temp_min, temp_hour, pres_min, pres_hour;
+    static uint32_t samples = 0;               // Muestras tomadas, para el reporte por USB
+    tscomp_sample_t sample;                    // Muestra para el historial en flash
+    bmp280_result_t res = BMP280_BUSY;         // Resultado de cada fase de la lectura
+    stats_t summary;                           // Resumen de una ventana
+    control_config_t cfg;                      // Copia de la configuracion
+    float values[3];                           // Valores para las tramas de telemetria
+
+    if (event->signal == AO_SIG_INIT) {
+        conversion = pdMS_TO_TICKS(bmp280_measure_time_us(&sensor) / 1000 + 1);
+        tscomp_encoder_init(&encoder, block, sizeof(block));
+        stats_window_init(&temp_min, temp_min_buckets, STATS_MIN_BUCKETS, STATS_MIN_SAMPLES);
+        stats_window_init(&temp_hour, temp_hour_buckets, STATS_HOUR_BUCKETS, STATS_HOUR_SAMPLES);
+        stats_window_init(&pres_min, pres_min_buckets, STATS_MIN_BUCKETS, STATS_MIN_SAMPLES);
+        stats_window_init(&pres_hour, pres_hour_buckets, STATS_HOUR_BUCKETS, STATS_HOUR_SAMPLES);
+        ao_timer_init(&timer, ao, SIG_SAMPLE);
+        ao_timer_arm(&timer, 0, 0);                                                              // Primera lectura enseguida
+        return;
+    }
+
+    // La lectura va por fases: inicia la conversion, consulta el estado y lee los datos
+    // Cada fase es un trabajo del bus, el bus queda libre mientras el sensor convierte
+    if (event->signal == SIG_SAMPLE) {
+        i2csched_submit(&bus, &sensor_job);                                                      // Avanza una fase antes que el LCD, sin bloquear el ejecutor
+        return;
+    }
+    if (event->signal != SIG_PHASE) { return; }
+
+    res = (bmp280_result_t)(int32_t)event->arg;                                                  // Resultado de la fase
+    if (res == BMP280_BUSY) {
+        ao_timer_arm(&timer, conversion, 0);                                                     // Espera la conversion sin ocupar el bus ni la tarea
+        return;
+    }
+
+    if (res == BMP280_DONE) {
+        data.temperature = bmp280_convert_temp(sensor.raw_temp, &sensor.calib);                                  // Compensación temperatura
+        data.pressure = bmp280_convert_pressure(sensor.raw_pressure, sensor.raw_temp, &sensor.calib) / 1000.0f;  // Compensación de presión
+
+        // Actualizo las estadisticas, costo constante por muestra
+        stats_window_add(&temp_min, data.temperature);
+        stats_window_add(&temp_hour, data.temperature);
+        stats_window_add(&pres_min, data.pressure);
+        stats_window_add(&pres_hour, data.pressure);
+        stats_window_get(&temp_min, &summary);
+        data.temp_min = summary.min;
+        data.temp_max = summary.max;
+        stats_window_get(&temp_hour, &summary);
+        data.temp_mean_hour = summary.mean;
+        stats_window_get(&pres_hour, &summary);
+        data.pres_mean_hour = summary.mean;
+
+        // Copia para el LCD, el shell y el pulsador, sin seccion critica
+        mailbox_write(&latest, &data);
+        ao_publish(SIG_SENSOR, 0);                                                               // Avisa a los suscriptos, el LCD
+
+        // Comprimo la muestra en el bloque, cuando no entra mas el bloque se pasa al historial
+        sample.time = xTaskGetTickCount() / configTICK_RATE_HZ;
+        sample.value[HISTORY_TEMP] = lroundf(data.temperature * 100.0f);
+        sample.value[HISTORY_PRES] = lroundf(data.pressure * 1000.0f);
+        if (!tscomp_encode(&encoder, &sample)) {
+            flashlog_append_block(&history, block);                                              // Solo copia a RAM
+            ao_post(&log_ao, SIG_PAGE, 0);                                                       // Hay una pagina completa para grabar
+            tscomp_encoder_init(&encoder, block, sizeof(block));
+            tscomp_encode(&encoder, &sample);
         }
 
-        vTaskDelay(pdMS_TO_TICKS(1000));                                                         // Esperar 1 segundo entre lecturas
+        // Cada muestra sale por telemetria binaria, no bloquea
+        values[0] = data.temperature;
+        values[1] = data.pressure;
+        telemetry_sample(TLM_SENSOR, values, 2);
+
+        // Una vez por minuto mando el resumen por USB
+        if (++samples % (STATS_MIN_BUCKETS * STATS_MIN_SAMPLES) == 0) {
+            stats_window_get(&temp_min, &summary);
+            telemetry_stats(TLM_TEMP_1M, summary.mean, stats_stddev(&summary), summary.min, summary.max);
+            values[0] = stats_window_quantile(&temp_min, STATS_Q05);
+            values[1] = stats_window_quantile(&temp_min, STATS_Q50);
+            values[2] = stats_window_quantile(&temp_min, STATS_Q95);
+            telemetry_sample(TLM_TEMP_Q, values, 3);
+            stats_window_get(&pres_min, &summary);
+            telemetry_stats(TLM_PRES_1M, summary.mean, stats_stddev(&summary), summary.min, summary.max);
+            stats_window_get(&temp_hour, &summary);
+            telemetry_stats(TLM_TEMP_1H, summary.mean, stats_stddev(&summary), summary.min, summary.max);
+        }
     }
+
+    shell_config_read(&shell, &cfg);                                                             // Leo la configuracion sin bloquear
+    ao_timer_arm(&timer, pdMS_TO_TICKS(cfg.sample_ms), 0);                                       // Esperar el periodo entre lecturas
 }
 
-// Tarea del LCD y control PWM
-void vTaskLCD(void *pvParameters) {
+// Objeto del LCD y control PWM: redibuja con cada medicion y con el pulsador
+void lcd_handler(ao_t *ao, const ao_event_t *event) {
+    static int screen_mode = 0;           // Pantalla elegida con el pulsador, solo la cambia este objeto
     sensor_data_t data;                   // Variable de tipo estructura de datos del sensor
     char line1[17], line2[17];            // Vectores o buffers para carga del display
     float error, error_abs;               // Variables de tipo float para los errores
-    uint slice = pwm_gpio_to_slice_num(LED_PWM_PIN);   // Funcion de porcion de PWM para encender el LED
-
-    while (1) {
-        if (xQueueReceive(queue_sensor_data, &data, portMAX_DELAY) == pdTRUE) {    // Cola que recibe el dato de lo que mide el sensor
-            error = SETPOINT - data.temperature;    // Compara el error con el valor seteado
-            error_abs = fabsf(error);               // Transforma el error en error absoluto
-
-            if (xSemaphoreTake(i2c_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {                       // Pregunta si el semaforo se tomo
-                if (screen_mode == 0) {                                                          // Variable para selecion de pantalla del display
-                    snprintf(line1, sizeof(line1), "Temp: %.1f %cC", data.temperature, '\xDF');  // Imprime la primer linea del display temperatura
-                    snprintf(line2, sizeof(line2), "Pres: %.1f kPa", data.pressure);             // Imprime la segunda linea del display presion
-                } else {                                                                         // Si se presiono el pulsador entra aca
-                    snprintf(line1, sizeof(line1), "Set: %.1f %cC", SETPOINT, '\xDF');           // Imprime en primer linea el valor del setpoint
-                    snprintf(line2, sizeof(line2), "Err: %.1f %cC", error, '\xDF');              // Imprime en la segunda linea el valor del error
-                }
-
-                lcd_set_cursor(0, 0);         // Posiciono el cursor en la primera linea
-                lcd_string(line1);            // Escribo en la primera linea
-                lcd_set_cursor(1, 0);         // Posiciono el cursor en la segunda linea
-                lcd_string(line2);            // Escribo en la segunda linea
-                xSemaphoreGive(i2c_mutex);
-            }
-
-            // PWM inverso proporcional al error absoluto
-            uint16_t duty = 0;                       // Variable del manejo del PWM
-
-            if (error_abs < 0.01f) {                 // Si el error absoluto es menor que cierto valor
-                duty = 0;                            // Apagar LED si el error es despreciable
-            } else if (error_abs < MAX_ERROR) {      // Si el erro absoluto es menor al maximo error
-                uint16_t duty = (uint16_t)((1.0f - (error_abs / MAX_ERROR)) * PWM_WRAP);  // Formula que me da el valor del PWM en base al error
-            } else {
-                duty = 0;                            // Apagar LED si el error es despreciable
-            }
-
-            pwm_set_chan_level(slice, PWM_CHAN_A, duty);     // Funcion que compara valores del PWM
+    control_config_t cfg;                 // Copia de la configuracion
+
+    if (event->signal == SIG_BUTTON) {
+        screen_mode = (screen_mode + 1) % SCREEN_COUNT;     // El pulsador es valido y pasa a la siguiente pantalla del LCD
+    }
+
+    if (event->signal != AO_SIG_INIT && mailbox_read(&latest, &data)) {        // Sin mediciones todavia no hay que dibujar
+        shell_config_read(&shell, &cfg);        // Copia consistente de la configuracion, no bloquea
+        error = cfg.setpoint - data.temperature;    // Compara el error con el valor seteado
+        error_abs = fabsf(error);               // Transforma el error en error absoluto
+
+        if (screen_mode == 0) {                                                          // Variable para selecion de pantalla del display
+            snprintf(line1, sizeof(line1), "Temp: %.1f %cC", data.temperature, '\xDF');  // Imprime la primer linea del display temperatura
+            snprintf(line2, sizeof(line2), "Pres: %.1f kPa", data.pressure);             // Imprime la segunda linea del display presion
+        } else if (screen_mode == 2) {                                                   // Pantalla de estadisticas
+            snprintf(line1, sizeof(line1), "m:%.1f M:%.1f", data.temp_min, data.temp_max);                  // Minima y maxima del ultimo minuto
+            snprintf(line2, sizeof(line2), "1h %.1f %.1fkPa", data.temp_mean_hour, data.pres_mean_hour);    // Medias de la ultima hora
+        } else {                                                                         // Si se presiono el pulsador entra aca
+            snprintf(line1, sizeof(line1), "Set: %.1f %cC", cfg.setpoint, '\xDF');      // Imprime en primer linea el valor del setpoint
+            snprintf(line2, sizeof(line2), "Err: %.1f %cC", error, '\xDF');              // Imprime en la segunda linea el valor del error
         }
 
-        // Verificar pulsador (modo de pantalla)
-        if (xSemaphoreTake(sem_button, 0) == pdTRUE) {          // Se fija si se apreto el pulsador, toma el semaforo
-            TickType_t now = xTaskGetTickCount();               // Hace un conteo de ticks para un antirrebote
-            if ((now - last_button_time) > debounce_delay) {    // Si la diferencia ente el conteo de ticks y el tiempo del pulsador es mas de 200 
-            screen_mode = !screen_mode;                         // Elpulsador es valido e invierte la pantalla del LCD
-            last_button_time = now;                             // Coloca el valor de cantidad de ticks leidos en la varaible del boton.
-            }
+        lcd_frame_line(&frame, 0, line1);   // Cargo la primera linea
+        lcd_frame_line(&frame, 1, line2);   // Cargo la segunda linea
+        i2csched_submit(&bus, &lcd_job);    // Lo manda la tarea del bus, si estaba redibujando empieza de nuevo
+
+        // Brillo percibido inverso proporcional al error absoluto
+        uint8_t level = 0;                       // Nivel de brillo de 0 a LEDFX_LEVEL_MAX
+
+        if (error_abs < 0.01f) {                 // Si el error absoluto es menor que cierto valor
+            level = 0;                           // Apagar LED si el error es despreciable
+        } else if (error_abs < cfg.max_error) {  // Si el erro absoluto es menor al maximo error
+            level = (uint8_t)((1.0f - (error_abs / cfg.max_error)) * LEDFX_LEVEL_MAX);  // Formula que me da el brillo en base al error
+        } else {
+            level = 0;                           // Apagar LED si el error es despreciable
         }
+
+        if (cfg.pwm_wrap != led.top) {                   // Si cambio la resolucion desde el shell
+            ledfx_set_top(&led, cfg.pwm_wrap);
+        }
+        ledfx_fade_to(&led, level, cfg.sample_ms);       // Transicion hasta la proxima medicion, la hace el DMA
+    }
+}
+
+// Salida del shell, las respuestas viajan como texto en la telemetria
+void shell_output(const char *text) {
+    telemetry_text(text);
+}
+
+// Comando stats: ultima medicion y estado de los buffers
+void cmd_stats(shell_t *sh, int argc, char *argv[]) {
+    sensor_data_t data;
+
+    if (mailbox_read(&latest, &data)) {        // Sin mediciones todavia los datos no estan cargados
+        shell_printf(sh, "T %.2f P %.3f", data.temperature, data.pressure);
+        shell_printf(sh, "1m min %.2f max %.2f", data.temp_min, data.temp_max);
+        shell_printf(sh, "1h T %.2f P %.3f", data.temp_mean_hour, data.pres_mean_hour);
+    } else {
+        shell_printf(sh, "sin mediciones");
+    }
+    shell_printf(sh, "flash %lu pag, descartados %lu", flashlog_count(&history), history.dropped);
+    shell_printf(sh, "telemetria descartadas %lu", telemetry_dropped());
+}
+
+// Comando bench: tiempo de las operaciones por muestra del sensor
+void cmd_bench(shell_t *sh, int argc, char *argv[]) {
+    static stats_t buckets[4];
+    static uint8_t block[FLASHLOG_BLOCK_SIZE];
+    stats_window_t window;
+    tscomp_encoder_t encoder;
+    tscomp_sample_t sample = { 0 };
+    uint32_t start;
+
+    // Corre en la tarea del shell, las tareas de control la interrumpen normalmente
+    stats_window_init(&window, buckets, 4, 16);
+    start = time_us_32();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) { stats_window_add(&window, 25.0f + (i & 7) * 0.01f); }
+    shell_printf(sh, "stats_window_add: %lu ns", (time_us_32() - start) * 1000 / BENCH_ITERATIONS);
+
+    tscomp_encoder_init(&encoder, block, sizeof(block));
+    start = time_us_32();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        sample.time = i;
+        sample.value[HISTORY_TEMP] = 2500 + (i & 3);
+        if (!tscomp_encode(&encoder, &sample)) { tscomp_encoder_init(&encoder, block, sizeof(block)); }
+    }
+    shell_printf(sh, "tscomp_encode: %lu ns", (time_us_32() - start) * 1000 / BENCH_ITERATIONS);
+
+    start = time_us_32();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) { bmp280_convert_temp(sensor.raw_temp + (i & 15), &sensor.calib); }
+    shell_printf(sh, "bmp280_convert_temp: %lu ns", (time_us_32() - start) * 1000 / BENCH_ITERATIONS);
+}
+
+// Funciones del registro del bus para i2csched_call, corren en la tarea del bus
+static void trace_record(void *arg) {
+    bool *recording = (bool *)arg;
+    *recording = i2c_trace_record(*recording);      // Devuelve el estado anterior en el mismo lugar
+}
+
+static void trace_reset(void *arg) {
+    i2c_trace_reset();
+}
+
+typedef struct {
+    i2c_trace_client_t clients[I2C_TRACE_MAX_CLIENTS];
+    size_t count;
+} trace_clients_t;
+
+static void trace_clients(void *arg) {
+    trace_clients_t *copy = (trace_clients_t *)arg;
+    const i2c_trace_client_t *src = i2c_trace_clients(&copy->count);
+    memcpy(copy->clients, src, copy->count * sizeof(copy->clients[0]));
+}
+
+// Comando i2c: uso del bus por direccion, o "dump", "reset" y "rec on|off" del registro
+void cmd_i2c(shell_t *sh, int argc, char *argv[]) {
+    if (argc > 1 && !strcmp(argv[1], "dump")) {
+        i2c_trace_entry_t entry;
+        // Pauso el registro para que el buffer no avance mientras se envia
+        bool recording = false;
+        i2csched_call(&bus, &shell_client, trace_record, &recording);
+
+        size_t count = i2c_trace_count();
+        for (size_t i = 0; i < count && i2c_trace_get(i, &entry); i++) {
+            size_t len = I2C_TRACE_HEADER_SIZE + (entry.len < I2C_TRACE_DATA_MAX ? entry.len : I2C_TRACE_DATA_MAX);
+            // Son mas tramas de las que entran en los buffers, espero que salgan
+            while (!telemetry_send(TELEMETRY_I2C, &entry, len)) { vTaskDelay(pdMS_TO_TICKS(TELEMETRY_FLUSH_MS)); }
+        }
+
+        i2csched_call(&bus, &shell_client, trace_record, &recording);
+        shell_printf(sh, "i2c: %u transacciones", (unsigned)count);
+        return;
+    }
+
+    if (argc > 1 && !strcmp(argv[1], "reset")) {
+        i2csched_call(&bus, &shell_client, trace_reset, NULL);
+        return;
+    }
+
+    if (argc > 2 && !strcmp(argv[1], "rec")) {
+        bool recording = !strcmp(argv[2], "on");
+        i2csched_call(&bus, &shell_client, trace_record, &recording);
+        return;
+    }
+
+    // Copia de las estadisticas en la tarea del bus, que las actualiza en cada transaccion
+    trace_clients_t copy;
+    i2csched_call(&bus, &shell_client, trace_clients, &copy);
+
+    for (size_t i = 0; i < copy.count; i++) {
+        shell_printf(sh, "%02x: %lu tr %lu B %lu us %lu err", copy.clients[i].addr, copy.clients[i].transactions,
+                     copy.clients[i].bytes, copy.clients[i].bus_us, copy.clients[i].errors);
+    }
+}
+
+// Comando bus: espera y latencia de cada cliente del planificador del bus, "bus reset" los pone en cero
+void cmd_bus(shell_t *sh, int argc, char *argv[]) {
+    static i2csched_client_t *const clients[] = { &sensor_client, &shell_client, &lcd_client };
+    i2csched_stats_t stats;
+
+    for (size_t i = 0; i < sizeof(clients) / sizeof(clients[0]); i++) {
+        i2csched_get_stats(clients[i], &stats);
+        shell_printf(sh, "%s: %lu trab %lu pasos, %lu fuera de plazo", clients[i]->name, stats.jobs, stats.chunks, stats.misses);
+        shell_printf(sh, "  espera max %lu us, latencia %lu us max %lu", stats.wait_max_us,
+                     stats.jobs ? (uint32_t)(stats.latency_sum_us / stats.jobs) : 0, stats.latency_max_us);
+        shell_printf(sh, "  paso max %lu us, bus %lu us", stats.chunk_max_us, stats.bus_us);
+        if (argc > 1 && !strcmp(argv[1], "reset")) { i2csched_reset_stats(clients[i]); }
+    }
+}
+
+// Comando irq: tiempo en las ISR y en el trabajo diferido por nivel
+void cmd_irq(shell_t *sh, int argc, char *argv[]) {
+    static const char *names[DEFERRED_LEVELS] = { "alto", "bajo" };
+    deferred_stats_t stats;
+
+    for (int i = 0; i < DEFERRED_LEVELS; i++) {
+        deferred_get_stats(i, &stats);
+        shell_printf(sh, "%s: %lu isr, %lu us max %lu", names[i], stats.isr_count,
+                     stats.isr_count ? (uint32_t)(stats.isr_us / stats.isr_count) : 0, stats.isr_max_us);
+        shell_printf(sh, "  %lu trab, %lu desc, espera %lu us max %lu", stats.executed, stats.dropped,
+                     stats.executed ? (uint32_t)(stats.latency_us / stats.executed) : 0, stats.latency_max_us);
+        shell_printf(sh, "  trabajo %lu us max %lu", stats.executed ? (uint32_t)(stats.run_us / stats.executed) : 0,
+                     stats.run_max_us);
+        if (argc > 1 && !strcmp(argv[1], "reset")) { deferred_reset_stats(i); }
+    }
+}
+
+// Comando stack: tamaño y minimo libre de cada tarea, en palabras, para stack_usage.py
+void cmd_stack(shell_t *sh, int argc, char *argv[]) {
+    static const struct {
+        const char *name;
+        uint32_t size;
+    } tasks[] = {
+        { "Control", STACK_CONTROL },
+        { "Log", STACK_LOG },
+        { "Telemetry", TELEMETRY_TASK_STACK },
+        { "Shell", SHELL_TASK_STACK },
+        { "Bus", STACK_BUS },
+        { "DeferHi", DEFERRED_STACK_SIZE },
+        { "DeferLo", DEFERRED_STACK_SIZE },
+        { "IDLE", configMINIMAL_STACK_SIZE },
+        { "Tmr Svc", configTIMER_TASK_STACK_DEPTH }
+    };
+
+    for (size_t i = 0; i < sizeof(tasks) / sizeof(tasks[0]); i++) {
+        TaskHandle_t handle = xTaskGetHandle(tasks[i].name);
+        if (!handle) { continue; }
+        shell_printf(sh, "stack %s %lu %lu", tasks[i].name, tasks[i].size, (uint32_t)uxTaskGetStackHighWaterMark(handle));
+    }
+}
+
+// Comando ao: actividad de los ejecutores y de cada objeto, y cambios de contexto desde la ultima consulta
+void cmd_ao(shell_t *sh, int argc, char *argv[]) {
+    static ao_executor_t *const executors[] = { &control_executor, &log_executor };
+    static ao_t *const objects[] = { &sensor_ao, &lcd_ao, &log_ao };
+    static unsigned long last_switches;
+    static uint32_t last_us;
+    ao_executor_stats_t executor_stats;
+    ao_stats_t stats;
+
+    for (size_t i = 0; i < sizeof(executors) / sizeof(executors[0]); i++) {
+        ao_executor_get_stats(executors[i], &executor_stats);
+        shell_printf(sh, "%s: %lu act %lu ev max %lu us", pcTaskGetName(executors[i]->task), executor_stats.activations,
+                     executor_stats.dispatched, executor_stats.run_max_us);
+    }
+    for (size_t i = 0; i < sizeof(objects) / sizeof(objects[0]); i++) {
+        ao_get_stats(objects[i], &stats);
+        shell_printf(sh, "  %s: %lu ev %lu desc cola %lu max %lu us", objects[i]->name, stats.dispatched, stats.dropped,
+                     stats.queue_max, stats.run_max_us);
+    }
+
+    // Tasa de cambios de contexto, incluye los de la tarea del shell que atiende el comando
+    unsigned long switches = task_switches;
+    uint32_t now = time_us_32();
+    if (last_us) {
+        shell_printf(sh, "cambios %lu, %lu/s", switches, (uint32_t)((uint64_t)(switches - last_switches) * 1000000 / (now - last_us)));
+    } else {
+        shell_printf(sh, "cambios %lu", switches);
+    }
+    last_switches = switches;
+    last_us = now;
+}
+
+// Comandos propios del firmware
+static const shell_command_t shell_commands[] = {
+    { "stats", "ultima medicion y buffers", cmd_stats },
+    { "bench", "tiempo de las operaciones por muestra", cmd_bench },
+    { "i2c", "uso del bus; dump, reset, rec on|off", cmd_i2c },
+    { "irq", "tiempo en ISR y diferido; reset", cmd_irq },
+    { "stack", "minimo libre de cada tarea", cmd_stack },
+    { "ao", "eventos por objeto y cambios de contexto", cmd_ao },
+    { "bus", "espera y latencia por cliente del bus; reset", cmd_bus }
+};
+
+// Objeto que graba el historial en flash, en el ejecutor de menor prioridad
+// Grabar detiene la ejecucion desde la flash, por eso queda fuera del ejecutor de medicion y control
+void log_handler(ao_t *ao, const ao_event_t *event) {
+    const uint8_t *block;                 // Ultimo bloque grabado
+    tscomp_decoder_t decoder;             // Descompresor del bloque
+    tscomp_sample_t sample;               // Muestra leida del historial
+    char text[TELEMETRY_MAX_PAYLOAD + 1]; // Mensaje de arranque
+
+    if (event->signal == SIG_PAGE) {
+        flashlog_service(&history);       // El sensor completo una pagina, graba las paginas completas
+        return;
+    }
+
+    // Al arrancar, informo lo que quedo grabado de la ejecucion anterior
+    block = flashlog_read_block(&history, 0);
+    if (block) {
+        uint16_t count = tscomp_decoder_init(&decoder, block, FLASHLOG_BLOCK_SIZE);
+        while (tscomp_decode(&decoder, &sample));                  // Cada bloque se lee desde el principio
+        snprintf(text, sizeof(text), "Historial: %lu pag, %u muestras, t=%lus T=%.2f P=%.3f", flashlog_count(&history), count,
+                 sample.time, sample.value[HISTORY_TEMP] / 100.0f, sample.value[HISTORY_PRES] / 1000.0f);
+        telemetry_text(text);
     }
 }
 
@@ -159,25 +589,61 @@ void init_hardware() {
     gpio_pull_up(I2C_SDA_PIN);                        // Habilito el pull up para datos
     gpio_pull_up(I2C_SCL_PIN);                        // Habilito el pull up para el clock
 
-    bmp280_init(I2C_PORT);                            // Inicializo el sensor puerto, la direccion esta en el .h
+    if (!bmp280_init(&sensor, I2C_PORT, BMP280_ADDR_PRIMARY)) {   // Inicializo el sensor con su puerto y direccion
+        panic("bmp280: no se encontro el sensor en 0x%02x", BMP280_ADDR_PRIMARY);
+    }
     lcd_init(I2C_PORT, LCD_ADDR);                     // Inicializo el LCD puerto y direccion
 
     init_pwm();               // Inicializo el PWM
-    init_button();            // Inicializo el pulsador por interrupcion
+
+    if (!flashlog_init_pico(&history, HISTORY_SECTORS * FLASHLOG_SECTOR_SIZE)) {   // Recupero el historial del final de la flash
+        panic("flashlog: la region del historial se superpone con el programa");
+    }
+}
+
+#if configCHECK_FOR_STACK_OVERFLOW
+// En debug, FreeRTOS llama a esta funcion si una tarea piso el final de su stack
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name) {
+    panic("Stack overflow en %s", name);
 }
+#endif
 
    //Función principal main
 int main() {
     init_hardware();          // Inicializo todo 
 
     // Creacion de recursos FREERTOS
-    i2c_mutex = xSemaphoreCreateMutex();                              // Variable para manejo del semaforo mutex
-    sem_button = xSemaphoreCreateBinary();                            // Variable para manejo del semaforo binario
-    queue_sensor_data = xQueueCreate(4, sizeof(sensor_data_t));       // Variable para manejo de la cola
+    mailbox_init(&latest, latest_buf, sizeof(sensor_data_t));          // Ultima medicion, sin version hasta la primera lectura
+
+    // Bus I2C: la tarea queda por debajo del ejecutor de control, asi el sensor puede encolar
+    // mientras se redibuja el LCD, y hereda la prioridad del sensor mientras lo atiende
+    i2csched_client_init(&sensor_client, "Sensor", BUS_SENSOR_PRIORITY, BUS_SENSOR_DEADLINE_US);
+    i2csched_client_init(&shell_client, "Shell", BUS_SHELL_PRIORITY, BUS_SHELL_DEADLINE_US);
+    i2csched_client_init(&lcd_client, "LCD", BUS_LCD_PRIORITY, BUS_LCD_DEADLINE_US);
+    i2csched_job_init(&sensor_job, &sensor_client, sensor_step, NULL);
+    i2csched_job_init(&lcd_job, &lcd_client, lcd_step, NULL);
+    i2csched_start(&bus, "Bus", 1, STACK_BUS);
+
+    // Ejecutores y objetos activos
+    // Los tamaños de stack salen de task_stacks.h, que regenera stack_usage.py
+    ao_executor_start(&control_executor, "Control", 2, STACK_CONTROL);   // Sensor y LCD, con lugar para las tramas de telemetria
+    ao_executor_start(&log_executor, "Log", 1, STACK_LOG);               // Historial, menor prioridad
+    ao_start(&sensor_ao, &control_executor, 1, "Sensor", sensor_handler, NULL, sensor_queue, OBJECT_QUEUE);
+    ao_start(&lcd_ao, &control_executor, 0, "LCD", lcd_handler, NULL, lcd_queue, OBJECT_QUEUE);
+    ao_start(&log_ao, &log_executor, 0, "Log", log_handler, NULL, log_queue, OBJECT_QUEUE);
+    ao_subscribe(&lcd_ao, SIG_SENSOR);                                // El LCD redibuja con cada medicion
+
+    telemetry_init();         // Tarea de transmision de la telemetria por USB
+    if (!deferred_init(3, 1)) {   // Trabajo diferido de las interrupciones: control por encima de las tareas, interfaz por debajo
+        panic("deferred: no se pudieron crear las tareas");
+    }
+
+    // Shell por USB con la menor prioridad, nunca demora a las tareas de control
+    shell_init(&shell, shell_commands, sizeof(shell_commands) / sizeof(shell_commands[0]), shell_output);
+    shell_set_params(&shell, shell_params, sizeof(shell_params) / sizeof(shell_params[0]), &config, sizeof(config), &config_lock);
+    shell_start(&shell, tskIDLE_PRIORITY + 1);
 
-    // Crear tareas
-    xTaskCreate(vTaskSensor, "Sensor", configMINIMAL_STACK_SIZE + 100, NULL, 2, NULL);    // Tarea para manejo del sensor
-    xTaskCreate(vTaskLCD, "LCD", configMINIMAL_STACK_SIZE + 200, NULL, 2, NULL);          // Tarea paramanejo del LCD
+    init_button();            // Inicializo el pulsador por interrupcion, lo atiende el trabajo diferido
 
     vTaskStartScheduler();   // Toma el control el scheduler
 
@@ -0,0 +1,15 @@
+// Generado por stack_usage.py, no editar a mano
+#ifndef _TASK_STACKS_H_
+#define _TASK_STACKS_H_
+
+// Tamaños de stack en palabras: peor caso entre el grafo de llamadas (mas 208 B de
+// contexto) y la marca de agua medida, con 20% de margen
+// Sin grafo de llamadas ni mediciones: todos son los tamaños por defecto
+#define STACK_CONTROL              428   // ao_executor_task: sin analizar, tamaño por defecto
+#define STACK_LOG                  428   // ao_executor_task: sin analizar, tamaño por defecto
+#define TELEMETRY_TASK_STACK       256   // telemetry_task: sin analizar, tamaño por defecto
+#define SHELL_TASK_STACK           384   // shell_task: sin analizar, tamaño por defecto
+#define DEFERRED_STACK_SIZE        256   // deferred_task: sin analizar, tamaño por defecto
+#define STACK_BUS                  256   // i2csched_task: sin analizar, tamaño por defecto
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef _FLASHLOG_H_
+#define _FLASHLOG_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Geometria de la flash: se programa por pagina y se borra por sector
+#define FLASHLOG_PAGE_SIZE      256u
+#define FLASHLOG_SECTOR_SIZE    4096u
+#define FLASHLOG_PAGES_PER_SECTOR (FLASHLOG_SECTOR_SIZE / FLASHLOG_PAGE_SIZE)
+
+// Tamaño fijo de cada registro
+#define FLASHLOG_RECORD_SIZE    8u
+// Paginas de RAM para acumular registros mientras se graba la anterior
+#define FLASHLOG_STAGE_PAGES    2u
+
+/**
+ * @brief Encabezado de cada pagina grabada
+ */
+typedef struct {
+    uint32_t seq;       // Numero de secuencia global de la pagina
+    uint8_t magic;      // FLASHLOG_MAGIC en paginas validas
+    uint8_t count;      // Registros en la pagina
+    uint16_t crc;       // CRC16 del encabezado y los registros
+} flashlog_header_t;
+
+// Registros que entran en una pagina
+#define FLASHLOG_RECORDS_PER_PAGE ((FLASHLOG_PAGE_SIZE - sizeof(flashlog_header_t)) / FLASHLOG_RECORD_SIZE)
+
+// Bytes de datos de una pagina, para grabar bloques propios en lugar de registros
+#define FLASHLOG_BLOCK_SIZE     (FLASHLOG_PAGE_SIZE - sizeof(flashlog_header_t))
+// Valor del campo count en las paginas que guardan un bloque
+#define FLASHLOG_COUNT_BLOCK    0xFF
+
+/**
+ * @brief Pagina tal como se graba en la flash
+ */
+typedef struct {
+    flashlog_header_t header;
+    uint8_t records[FLASHLOG_RECORDS_PER_PAGE][FLASHLOG_RECORD_SIZE];
+} flashlog_page_t;
+
+/**
+ * @brief Acceso a la memoria, permite usar la flash real o una simulada en RAM
+ */
+typedef struct {
+    const uint8_t *(*read)(uint32_t offset);                                // Puntero a la memoria en el offset
+    bool (*program)(uint32_t offset, const uint8_t *data, size_t len);      // Graba paginas borradas
+    bool (*erase)(uint32_t offset, size_t len);                             // Borra sectores completos
+} flashlog_ops_t;
+
+/**
+ * @brief Instancia del log sobre una region de la flash
+ */
+typedef struct {
+    const flashlog_ops_t *ops;          // Acceso a la memoria
+    uint32_t offset;                    // Comienzo de la region, alineado a sector
+    uint32_t pages;                     // Paginas de la region
+    uint32_t write_page;                // Proxima pagina a grabar
+    uint32_t next_seq;                  // Secuencia de la proxima pagina
+    uint32_t stored_pages;              // Paginas validas en la flash
+    flashlog_page_t stage[FLASHLOG_STAGE_PAGES];  // Paginas en RAM
+    uint32_t stage_fill;                // Registros en la pagina que se esta llenando
+    volatile uint32_t stage_head;       // Paginas completas (lo escribe append)
+    volatile uint32_t stage_tail;       // Paginas grabadas (lo escribe service)
+    uint32_t dropped;                   // Registros descartados por no tener lugar en RAM
+} flashlog_t;
+
+// Prototipos de funciones
+bool flashlog_init(flashlog_t *log, const flashlog_ops_t *ops, uint32_t offset, uint32_t size);
+bool flashlog_append(flashlog_t *log, const void *record);
+bool flashlog_flush(flashlog_t *log);
+bool flashlog_pending(const flashlog_t *log);
+uint32_t flashlog_service(flashlog_t *log);
+uint32_t flashlog_count(const flashlog_t *log);
+bool flashlog_read(const flashlog_t *log, uint32_t age, void *record);
+bool flashlog_append_block(flashlog_t *log, const void *block);
+const uint8_t *flashlog_read_block(const flashlog_t *log, uint32_t age);
+
+// Acceso a la flash interna de la Raspberry Pi Pico
+extern const flashlog_ops_t flashlog_pico_ops;
+bool flashlog_init_pico(flashlog_t *log, uint32_t size);
+
+#endif
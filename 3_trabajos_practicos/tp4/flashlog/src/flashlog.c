@@ -0,0 +1,324 @@
+#include <string.h>
+#include "flashlog.h"
+
+// Marca de las paginas validas, distinta del valor borrado 0xFF
+#define FLASHLOG_MAGIC  0xA5
+
+/**
+ * @brief CRC16-CCITT (polinomio 0x1021) sin tabla
+ * @param crc valor inicial
+ * @param data puntero a los datos
+ * @param len cantidad de bytes
+ * @return CRC actualizado
+ */
+static uint16_t flashlog_crc16(uint16_t crc, const uint8_t *data, size_t len) {
+    while (len--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief CRC de una pagina: encabezado sin el campo crc y los registros
+ * @param page puntero a la pagina
+ * @return CRC de la pagina
+ */
+static uint16_t flashlog_page_crc(const flashlog_page_t *page) {
+    uint16_t crc = flashlog_crc16(0xFFFF, (const uint8_t *)&page->header, offsetof(flashlog_header_t, crc));
+    return flashlog_crc16(crc, (const uint8_t *)page->records, sizeof(page->records));
+}
+
+/**
+ * @brief Devuelve una pagina de la region
+ * @param log puntero al log
+ * @param index numero de pagina dentro de la region
+ * @return puntero a la pagina en memoria
+ */
+static inline const flashlog_page_t *flashlog_page(const flashlog_t *log, uint32_t index) {
+    return (const flashlog_page_t *)log->ops->read(log->offset + index * FLASHLOG_PAGE_SIZE);
+}
+
+/**
+ * @brief Verifica una pagina grabada
+ * @param page puntero a la pagina
+ * @return true si tiene marca y CRC validos
+ */
+static bool flashlog_page_valid(const flashlog_page_t *page) {
+    return page->header.magic == FLASHLOG_MAGIC && page->header.count && page->header.crc == flashlog_page_crc(page);
+}
+
+/**
+ * @brief Verifica que una pagina este borrada
+ * @param page puntero a la pagina
+ * @return true si todos sus bytes valen 0xFF
+ */
+static bool flashlog_page_blank(const flashlog_page_t *page) {
+    const uint32_t *word = (const uint32_t *)page;
+    for (size_t i = 0; i < FLASHLOG_PAGE_SIZE / sizeof(uint32_t); i++) {
+        if (word[i] != UINT32_MAX) { return false; }
+    }
+    return true;
+}
+
+/**
+ * @brief Indica si un sector fue grabado en la pasada actual sobre la region.
+ * La primera pagina de cada sector se graba apenas se lo borra
+ * @param log puntero al log
+ * @param sector numero de sector
+ * @param first_seq secuencia de la pagina 0
+ * @return true si la primera pagina es valida y no es anterior a la pagina 0
+ */
+static bool flashlog_sector_current(const flashlog_t *log, uint32_t sector, uint32_t first_seq) {
+    const flashlog_page_t *page = flashlog_page(log, sector * FLASHLOG_PAGES_PER_SECTOR);
+    return flashlog_page_valid(page) && (int32_t)(page->header.seq - first_seq) >= 0;
+}
+
+/**
+ * @brief Busca la ultima pagina valida de un sector
+ * @param log puntero al log
+ * @param sector numero de sector
+ * @return numero de pagina o UINT32_MAX si el sector no tiene paginas validas
+ */
+static uint32_t flashlog_sector_last(const flashlog_t *log, uint32_t sector) {
+    uint32_t first = sector * FLASHLOG_PAGES_PER_SECTOR;
+    for (uint32_t i = first + FLASHLOG_PAGES_PER_SECTOR; i-- > first;) {
+        if (flashlog_page_valid(flashlog_page(log, i))) { return i; }
+    }
+    return UINT32_MAX;
+}
+
+/**
+ * @brief Inicializa el log y recupera la posicion de escritura. Las paginas
+ * se graban en orden con secuencia creciente, por lo que los sectores de la
+ * pasada actual forman un prefijo de la region: el ultimo se busca en forma
+ * binaria y dentro de el se recorren a lo sumo FLASHLOG_PAGES_PER_SECTOR paginas
+ * @param log puntero al log
+ * @param ops acceso a la memoria
+ * @param offset comienzo de la region, alineado a sector
+ * @param size tamaño de la region, multiplo de sector y de al menos dos sectores
+ * @return true si la region es valida
+ */
+bool flashlog_init(flashlog_t *log, const flashlog_ops_t *ops, uint32_t offset, uint32_t size) {
+    if (offset % FLASHLOG_SECTOR_SIZE || size % FLASHLOG_SECTOR_SIZE || size < 2 * FLASHLOG_SECTOR_SIZE) {
+        return false;
+    }
+
+    log->ops = ops;
+    log->offset = offset;
+    log->pages = size / FLASHLOG_PAGE_SIZE;
+    log->stage_fill = 0;
+    log->stage_head = 0;
+    log->stage_tail = 0;
+    log->dropped = 0;
+    log->write_page = 0;
+    log->next_seq = 0;
+
+    uint32_t sectors = size / FLASHLOG_SECTOR_SIZE;
+    uint32_t last = UINT32_MAX;
+    const flashlog_page_t *first = flashlog_page(log, 0);
+
+    if (flashlog_page_valid(first)) {
+        // Busco el primer sector que no pertenece a la pasada actual
+        uint32_t lo = 1, hi = sectors;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (flashlog_sector_current(log, mid, first->header.seq)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        last = flashlog_sector_last(log, lo - 1);
+    } else {
+        // Si se borro el primer sector al dar la vuelta, lo ultimo grabado esta al final
+        last = flashlog_sector_last(log, sectors - 1);
+    }
+
+    if (last != UINT32_MAX) {
+        log->write_page = (last + 1) % log->pages;
+        log->next_seq = flashlog_page(log, last)->header.seq + 1;
+    }
+
+    // Una pagina interrumpida a mitad de grabacion no se puede volver a grabar, se saltea
+    while (log->write_page % FLASHLOG_PAGES_PER_SECTOR && !flashlog_page_blank(flashlog_page(log, log->write_page))) {
+        log->write_page = (log->write_page + 1) % log->pages;
+        log->next_seq++;
+    }
+
+    // Paginas validas: todas menos las borradas del sector en curso
+    uint32_t in_sector = log->write_page % FLASHLOG_PAGES_PER_SECTOR;
+    if (in_sector || flashlog_page_blank(flashlog_page(log, log->write_page))) {
+        log->stored_pages = log->pages - FLASHLOG_PAGES_PER_SECTOR + in_sector;
+    } else {
+        log->stored_pages = log->pages;
+    }
+    if (log->next_seq < log->stored_pages) { log->stored_pages = log->next_seq; }
+    return true;
+}
+
+/**
+ * @brief Agrega un registro a la pagina en RAM. No accede a la flash, puede
+ * llamarse desde el lazo de control
+ * @param log puntero al log
+ * @param record puntero a FLASHLOG_RECORD_SIZE bytes
+ * @return false si todas las paginas en RAM esperan ser grabadas
+ */
+bool flashlog_append(flashlog_t *log, const void *record) {
+    uint32_t head = log->stage_head;
+    if (head - log->stage_tail >= FLASHLOG_STAGE_PAGES) {
+        log->dropped++;
+        return false;
+    }
+
+    flashlog_page_t *page = &log->stage[head % FLASHLOG_STAGE_PAGES];
+    memcpy(page->records[log->stage_fill], record, FLASHLOG_RECORD_SIZE);
+    if (++log->stage_fill == FLASHLOG_RECORDS_PER_PAGE) {
+        page->header.count = FLASHLOG_RECORDS_PER_PAGE;
+        log->stage_fill = 0;
+        // La pagina se publica despues de escribir sus registros
+        __atomic_store_n(&log->stage_head, head + 1, __ATOMIC_RELEASE);
+    }
+    return true;
+}
+
+/**
+ * @brief Cierra la pagina en RAM aunque no este completa, para que se grabe
+ * en el proximo flashlog_service (por ejemplo antes de apagar)
+ * @param log puntero al log
+ * @return false si no habia registros o no hay lugar en RAM
+ */
+bool flashlog_flush(flashlog_t *log) {
+    uint32_t head = log->stage_head;
+    if (!log->stage_fill || head - log->stage_tail >= FLASHLOG_STAGE_PAGES) { return false; }
+
+    flashlog_page_t *page = &log->stage[head % FLASHLOG_STAGE_PAGES];
+    page->header.count = log->stage_fill;
+    // Relleno con el valor borrado para que el CRC no dependa de datos viejos
+    memset(page->records[log->stage_fill], 0xFF, (FLASHLOG_RECORDS_PER_PAGE - log->stage_fill) * FLASHLOG_RECORD_SIZE);
+    log->stage_fill = 0;
+    __atomic_store_n(&log->stage_head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Indica si hay paginas completas esperando ser grabadas
+ * @param log puntero al log
+ * @return true si flashlog_service tiene trabajo
+ */
+bool flashlog_pending(const flashlog_t *log) {
+    return __atomic_load_n(&log->stage_head, __ATOMIC_ACQUIRE) != log->stage_tail;
+}
+
+/**
+ * @brief Graba en la flash las paginas completas. Borra cada sector al entrar
+ * en el, de modo que la escritura rota por toda la region y todos los sectores
+ * se gastan por igual. Debe llamarse desde una tarea de baja prioridad, ya que
+ * borrar y grabar detienen la ejecucion desde la flash
+ * @param log puntero al log
+ * @return cantidad de paginas grabadas. Si la flash no esta disponible, las
+ * paginas quedan en RAM para el proximo llamado
+ */
+uint32_t flashlog_service(flashlog_t *log) {
+    uint32_t written = 0;
+
+    while (flashlog_pending(log)) {
+        flashlog_page_t *page = &log->stage[log->stage_tail % FLASHLOG_STAGE_PAGES];
+        uint32_t offset = log->offset + log->write_page * FLASHLOG_PAGE_SIZE;
+
+        // Al entrar a un sector se borra, descartando las paginas mas viejas
+        if (log->write_page % FLASHLOG_PAGES_PER_SECTOR == 0) {
+            if (!log->ops->erase(offset, FLASHLOG_SECTOR_SIZE)) { break; }
+            if (log->stored_pages > log->pages - FLASHLOG_PAGES_PER_SECTOR) {
+                log->stored_pages = log->pages - FLASHLOG_PAGES_PER_SECTOR;
+            }
+        }
+
+        page->header.seq = log->next_seq;
+        page->header.magic = FLASHLOG_MAGIC;
+        page->header.crc = flashlog_page_crc(page);
+        if (!log->ops->program(offset, (const uint8_t *)page, FLASHLOG_PAGE_SIZE)) { break; }
+
+        log->next_seq++;
+        log->write_page = (log->write_page + 1) % log->pages;
+        if (log->stored_pages < log->pages) { log->stored_pages++; }
+        // Libero la pagina en RAM recien despues de grabarla
+        __atomic_store_n(&log->stage_tail, log->stage_tail + 1, __ATOMIC_RELEASE);
+        written++;
+    }
+    return written;
+}
+
+/**
+ * @brief Cantidad de paginas grabadas disponibles para leer
+ * @param log puntero al log
+ * @return paginas validas en la flash
+ */
+uint32_t flashlog_count(const flashlog_t *log) {
+    return log->stored_pages;
+}
+
+/**
+ * @brief Lee un registro grabado contando desde el mas nuevo
+ * @param log puntero al log
+ * @param age 0 para el ultimo registro grabado, 1 para el anterior, etc.
+ * @param record puntero donde se copian FLASHLOG_RECORD_SIZE bytes
+ * @return false si no hay tantos registros
+ */
+bool flashlog_read(const flashlog_t *log, uint32_t age, void *record) {
+    uint32_t index = log->write_page;
+
+    for (uint32_t i = 0; i < log->stored_pages; i++) {
+        index = index ? index - 1 : log->pages - 1;
+        const flashlog_page_t *page = flashlog_page(log, index);
+        // Las paginas interrumpidas a mitad de grabacion y las de bloques se saltean
+        if (!flashlog_page_valid(page) || page->header.count > FLASHLOG_RECORDS_PER_PAGE) { continue; }
+        if (age < page->header.count) {
+            memcpy(record, page->records[page->header.count - 1 - age], FLASHLOG_RECORD_SIZE);
+            return true;
+        }
+        age -= page->header.count;
+    }
+    return false;
+}
+
+/**
+ * @brief Agrega una pagina completa con un bloque propio (por ejemplo, muestras
+ * comprimidas). No accede a la flash, puede llamarse desde el lazo de control
+ * @param log puntero al log
+ * @param block puntero a FLASHLOG_BLOCK_SIZE bytes
+ * @return false si hay registros sueltos en la pagina en curso o no hay lugar en RAM
+ */
+bool flashlog_append_block(flashlog_t *log, const void *block) {
+    uint32_t head = log->stage_head;
+    if (log->stage_fill || head - log->stage_tail >= FLASHLOG_STAGE_PAGES) {
+        log->dropped++;
+        return false;
+    }
+
+    flashlog_page_t *page = &log->stage[head % FLASHLOG_STAGE_PAGES];
+    memcpy(page->records, block, FLASHLOG_BLOCK_SIZE);
+    page->header.count = FLASHLOG_COUNT_BLOCK;
+    __atomic_store_n(&log->stage_head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/**
+ * @brief Obtiene un bloque grabado contando desde el mas nuevo, sin copiarlo
+ * @param log puntero al log
+ * @param age 0 para el ultimo bloque grabado, 1 para el anterior, etc.
+ * @return puntero a FLASHLOG_BLOCK_SIZE bytes en la flash o NULL si no hay tantos bloques
+ */
+const uint8_t *flashlog_read_block(const flashlog_t *log, uint32_t age) {
+    uint32_t index = log->write_page;
+
+    for (uint32_t i = 0; i < log->stored_pages; i++) {
+        index = index ? index - 1 : log->pages - 1;
+        const flashlog_page_t *page = flashlog_page(log, index);
+        if (!flashlog_page_valid(page) || page->header.count != FLASHLOG_COUNT_BLOCK) { continue; }
+        if (!age--) { return (const uint8_t *)page->records; }
+    }
+    return NULL;
+}
@@ -0,0 +1,87 @@
+#include "flashlog.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+
+/**
+ * @brief Parametros de una operacion sobre la flash
+ */
+typedef struct {
+    uint32_t offset;
+    const uint8_t *data;
+    size_t len;
+} flashlog_flash_op_t;
+
+// Espera maxima para que el otro nucleo libere la flash
+#define FLASHLOG_FLASH_TIMEOUT_MS   100
+
+/**
+ * @brief Acceso a la region mapeada por XIP
+ * @param offset offset desde el comienzo de la flash
+ * @return puntero a la memoria
+ */
+static const uint8_t *flashlog_flash_read(uint32_t offset) {
+    return (const uint8_t *)(XIP_BASE + offset);
+}
+
+/**
+ * @brief Graba paginas, se ejecuta sin interrupciones ni acceso XIP
+ * @param param puntero a flashlog_flash_op_t
+ */
+static void flashlog_flash_do_program(void *param) {
+    const flashlog_flash_op_t *op = param;
+    flash_range_program(op->offset, op->data, op->len);
+}
+
+/**
+ * @brief Borra sectores, se ejecuta sin interrupciones ni acceso XIP
+ * @param param puntero a flashlog_flash_op_t
+ */
+static void flashlog_flash_do_erase(void *param) {
+    const flashlog_flash_op_t *op = param;
+    flash_range_erase(op->offset, op->len);
+}
+
+/**
+ * @brief Graba paginas borradas. flash_safe_execute detiene las interrupciones
+ * y, si corresponde, al otro nucleo mientras la flash no puede leerse
+ * @param offset offset desde el comienzo de la flash
+ * @param data datos a grabar
+ * @param len cantidad de bytes, multiplo de FLASH_PAGE_SIZE
+ * @return false si no se pudo tomar la flash a tiempo
+ */
+static bool flashlog_flash_program(uint32_t offset, const uint8_t *data, size_t len) {
+    flashlog_flash_op_t op = { offset, data, len };
+    return PICO_OK == flash_safe_execute(flashlog_flash_do_program, &op, FLASHLOG_FLASH_TIMEOUT_MS);
+}
+
+/**
+ * @brief Borra sectores completos
+ * @param offset offset desde el comienzo de la flash
+ * @param len cantidad de bytes, multiplo de FLASH_SECTOR_SIZE
+ * @return false si no se pudo tomar la flash a tiempo
+ */
+static bool flashlog_flash_erase(uint32_t offset, size_t len) {
+    flashlog_flash_op_t op = { offset, NULL, len };
+    return PICO_OK == flash_safe_execute(flashlog_flash_do_erase, &op, FLASHLOG_FLASH_TIMEOUT_MS);
+}
+
+// Acceso a la flash interna de la Raspberry Pi Pico
+const flashlog_ops_t flashlog_pico_ops = {
+    .read = flashlog_flash_read,
+    .program = flashlog_flash_program,
+    .erase = flashlog_flash_erase
+};
+
+/**
+ * @brief Inicializa un log al final de la flash interna
+ * @param log puntero al log
+ * @param size tamaño de la region, multiplo de FLASHLOG_SECTOR_SIZE
+ * @return false si la region se superpone con el programa
+ */
+bool flashlog_init_pico(flashlog_t *log, uint32_t size) {
+    extern char __flash_binary_end;
+    uint32_t offset = PICO_FLASH_SIZE_BYTES - size;
+
+    if (size > PICO_FLASH_SIZE_BYTES || (uintptr_t)&__flash_binary_end - XIP_BASE > offset) { return false; }
+    return flashlog_init(log, &flashlog_pico_ops, offset, size);
+}
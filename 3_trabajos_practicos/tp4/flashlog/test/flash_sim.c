@@ -0,0 +1,80 @@
+#include <string.h>
+#include "flash_sim.h"
+
+flash_sim_t flash_sim;
+
+/**
+ * @brief Flash borrada y sin cortes programados
+ */
+void flash_sim_init(void) {
+    memset(&flash_sim, 0, sizeof(flash_sim));
+    memset(flash_sim.mem, 0xFF, sizeof(flash_sim.mem));
+    flash_sim.cut_ops = -1;
+}
+
+/**
+ * @brief Vuelve la energia: la flash conserva lo que tenia
+ */
+void flash_sim_reboot(void) {
+    flash_sim.dead = false;
+    flash_sim.cut_ops = -1;
+}
+
+/**
+ * @brief Cuenta las operaciones y decide si el corte llega en esta
+ * @param len bytes de la operacion
+ * @return bytes que se llegan a escribir
+ */
+static size_t flash_sim_budget(size_t len) {
+    if (flash_sim.cut_ops < 0) { return len; }
+    if (flash_sim.cut_ops > 0) {
+        flash_sim.cut_ops--;
+        return len;
+    }
+    flash_sim.cut_ops = -1;
+    flash_sim.dead = true;
+    return flash_sim.cut_bytes % len;
+}
+
+static const uint8_t *flash_sim_read(uint32_t offset) {
+    flash_sim.reads++;
+    return &flash_sim.mem[offset];
+}
+
+static bool flash_sim_program(uint32_t offset, const uint8_t *data, size_t len) {
+    if (flash_sim.dead) { return false; }
+    if (offset % FLASHLOG_PAGE_SIZE || len % FLASHLOG_PAGE_SIZE || offset + len > FLASH_SIM_SIZE) {
+        flash_sim.violations++;
+        return false;
+    }
+    size_t done = flash_sim_budget(len);
+    for (size_t i = 0; i < done; i++) {
+        // En una NOR grabar solo baja bits, un 0 no vuelve a 1 sin borrar
+        if (flash_sim.mem[offset + i] != 0xFF) { flash_sim.violations++; }
+        flash_sim.mem[offset + i] &= data[i];
+    }
+    // Si lo que falto grabar eran bytes borrados, la pagina quedo completa igual
+    while (done < len && data[done] == 0xFF) { done++; }
+    if (done < len) { return false; }
+    flash_sim.programs += len / FLASHLOG_PAGE_SIZE;
+    return true;
+}
+
+static bool flash_sim_erase(uint32_t offset, size_t len) {
+    if (flash_sim.dead) { return false; }
+    if (offset % FLASHLOG_SECTOR_SIZE || len % FLASHLOG_SECTOR_SIZE || offset + len > FLASH_SIM_SIZE) {
+        flash_sim.violations++;
+        return false;
+    }
+    // Un borrado cortado deja el comienzo del sector borrado y el resto como estaba
+    size_t done = flash_sim_budget(len);
+    memset(&flash_sim.mem[offset], 0xFF, done);
+    for (size_t s = 0; s < len / FLASHLOG_SECTOR_SIZE; s++) { flash_sim.erases[offset / FLASHLOG_SECTOR_SIZE + s]++; }
+    return !flash_sim.dead;
+}
+
+const flashlog_ops_t flash_sim_ops = {
+    .read = flash_sim_read,
+    .program = flash_sim_program,
+    .erase = flash_sim_erase,
+};
@@ -0,0 +1,30 @@
+#ifndef _FLASH_SIM_H_
+#define _FLASH_SIM_H_
+
+#include "flashlog.h"
+
+// Tamaño de la flash simulada
+#define FLASH_SIM_SIZE  (16 * FLASHLOG_SECTOR_SIZE)
+
+/**
+ * @brief Flash NOR simulada en RAM. Grabar solo puede bajar bits a 0, borrar
+ * los vuelve a 1 por sector, y un corte de energia deja la operacion a medias
+ */
+typedef struct {
+    uint8_t mem[FLASH_SIM_SIZE];
+    uint32_t erases[FLASH_SIM_SIZE / FLASHLOG_SECTOR_SIZE];   // Borrados por sector
+    uint32_t reads;             // Llamados a read, para contar los accesos de la busqueda
+    uint32_t programs;          // Paginas grabadas
+    uint32_t violations;        // Grabaciones sobre bytes no borrados o desalineadas
+    int32_t cut_ops;            // Operaciones completas antes del corte, -1 sin corte
+    uint32_t cut_bytes;         // Bytes que llega a escribir la operacion cortada, modulo su largo
+    bool dead;                  // Hubo un corte, nada mas se escribe hasta reiniciar
+} flash_sim_t;
+
+extern flash_sim_t flash_sim;
+extern const flashlog_ops_t flash_sim_ops;
+
+void flash_sim_init(void);
+void flash_sim_reboot(void);
+
+#endif
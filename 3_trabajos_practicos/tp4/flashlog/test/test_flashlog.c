@@ -0,0 +1,367 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "check.h"
+#include "flash_sim.h"
+
+// Region de 8 sectores en el medio de la flash simulada, con sectores de guarda alrededor
+#define REGION_OFFSET   (2 * FLASHLOG_SECTOR_SIZE)
+#define REGION_SECTORS  8u
+#define REGION_SIZE     (REGION_SECTORS * FLASHLOG_SECTOR_SIZE)
+#define REGION_PAGES    (REGION_SIZE / FLASHLOG_PAGE_SIZE)
+
+#define MAX_RECORDS     200000
+
+// Generador congruencial, los cortes son siempre los mismos
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+/**
+ * @brief Registro de prueba: numero de orden y su complemento
+ */
+typedef struct {
+    uint32_t index;
+    uint32_t check;
+} record_t;
+
+/**
+ * @brief Modelo de lo que deberia haber en la flash
+ */
+typedef struct {
+    uint32_t durable[MAX_RECORDS];  // Registros en paginas grabadas completas, en orden
+    uint32_t durable_count;
+    uint32_t staged[FLASHLOG_STAGE_PAGES + 1][2];   // Paginas en RAM: primer registro y cantidad
+    uint32_t staged_count;
+    uint32_t fill_first;            // Primer registro de la pagina que se esta llenando
+    uint32_t next;                  // Proximo registro a agregar
+} model_t;
+
+static model_t model;
+
+static void model_reset(void) {
+    model.staged_count = 0;
+    model.fill_first = model.next;
+}
+
+// Agrega un registro al log y al modelo
+static bool append(flashlog_t *log) {
+    record_t rec = { model.next, ~model.next };
+    if (!flashlog_append(log, &rec)) { return false; }
+    model.next++;
+    if (model.next - model.fill_first == FLASHLOG_RECORDS_PER_PAGE) {
+        model.staged[model.staged_count][0] = model.fill_first;
+        model.staged[model.staged_count][1] = FLASHLOG_RECORDS_PER_PAGE;
+        model.staged_count++;
+        model.fill_first = model.next;
+    }
+    return true;
+}
+
+static bool flush(flashlog_t *log) {
+    if (!flashlog_flush(log)) { return false; }
+    model.staged[model.staged_count][0] = model.fill_first;
+    model.staged[model.staged_count][1] = model.next - model.fill_first;
+    model.staged_count++;
+    model.fill_first = model.next;
+    return true;
+}
+
+// Graba las paginas en RAM y pasa al modelo las que se grabaron completas
+static uint32_t service(flashlog_t *log) {
+    uint32_t written = flashlog_service(log);
+    CHECK(written <= model.staged_count);
+    for (uint32_t i = 0; i < written; i++) {
+        for (uint32_t r = 0; r < model.staged[i][1]; r++) { model.durable[model.durable_count++] = model.staged[i][0] + r; }
+    }
+    memmove(model.staged, model.staged[written], (model.staged_count - written) * sizeof(model.staged[0]));
+    model.staged_count -= written;
+    return written;
+}
+
+// Lee un registro y verifica que sea el del modelo
+static bool read_checked(const flashlog_t *log, uint32_t age) {
+    record_t rec;
+    if (!flashlog_read(log, age, &rec)) { return false; }
+    CHECK_EQ(rec.check, ~rec.index);
+    if (age < model.durable_count) { CHECK_EQ(rec.index, model.durable[model.durable_count - 1 - age]); }
+    return true;
+}
+
+/**
+ * @brief Verifica que lo que se lee sea la cola de los registros grabados,
+ * sin huecos ni registros de mas
+ * @param full true para leer todos; si no, los extremos y algunos al azar
+ * @return cantidad de registros que se pueden leer
+ */
+static uint32_t verify(const flashlog_t *log, bool full) {
+    // Cantidad de registros legibles: el primer age que falla
+    uint32_t lo = 0, hi = model.durable_count + 1;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (read_checked(log, mid)) { lo = mid + 1; } else { hi = mid; }
+    }
+    uint32_t readable = lo;
+    CHECK(readable <= model.durable_count);
+
+    if (full) {
+        for (uint32_t age = 0; age < readable; age++) { CHECK(read_checked(log, age)); }
+    } else {
+        for (uint32_t age = 0; age < readable && age < 2 * FLASHLOG_RECORDS_PER_PAGE; age++) {
+            CHECK(read_checked(log, age));
+        }
+        for (uint32_t age = readable > 5 ? readable - 5 : 0; age < readable; age++) { CHECK(read_checked(log, age)); }
+        for (int i = 0; i < 5 && readable; i++) { CHECK(read_checked(log, next_random() % readable)); }
+    }
+    CHECK(!read_checked(log, readable));
+    return readable;
+}
+
+// CRC16-CCITT de la pagina, para revisar la region sin pasar por la biblioteca
+static uint16_t page_crc(const flashlog_page_t *page) {
+    const uint8_t *data = (const uint8_t *)page;
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < FLASHLOG_PAGE_SIZE; i++) {
+        if (i == offsetof(flashlog_header_t, crc)) { i += sizeof(page->header.crc) - 1; continue; }
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) { crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1; }
+    }
+    return crc;
+}
+
+/**
+ * @brief Registros de las paginas validas que estan dentro de la ventana del
+ * log (las ultimas flashlog_count secuencias), recorriendo toda la region
+ */
+static uint32_t visible_records(const flashlog_t *log) {
+    uint32_t records = 0;
+    for (uint32_t i = 0; i < REGION_PAGES; i++) {
+        const flashlog_page_t *page = (const flashlog_page_t *)&flash_sim.mem[REGION_OFFSET + i * FLASHLOG_PAGE_SIZE];
+        if (page->header.magic != 0xA5 || !page->header.count || page->header.count > FLASHLOG_RECORDS_PER_PAGE ||
+            page->header.crc != page_crc(page)) {
+            continue;
+        }
+        if (log->next_seq - 1 - page->header.seq < flashlog_count(log)) { records += page->header.count; }
+    }
+    return records;
+}
+
+// Los sectores fuera de la region no se tocan
+static void check_guard(void) {
+    for (uint32_t s = 0; s < FLASH_SIM_SIZE / FLASHLOG_SECTOR_SIZE; s++) {
+        if (s >= REGION_OFFSET / FLASHLOG_SECTOR_SIZE && s < REGION_OFFSET / FLASHLOG_SECTOR_SIZE + REGION_SECTORS) {
+            continue;
+        }
+        CHECK_EQ(flash_sim.erases[s], 0);
+        bool blank = true;
+        for (uint32_t i = 0; i < FLASHLOG_SECTOR_SIZE; i++) { blank &= flash_sim.mem[s * FLASHLOG_SECTOR_SIZE + i] == 0xFF; }
+        CHECK(blank);
+    }
+}
+
+// Region vacia, registros sueltos, flush y reinicio
+static void test_basic(void) {
+    flashlog_t log, boot;
+    flash_sim_init();
+    memset(&model, 0, sizeof(model));
+
+    // Regiones invalidas
+    CHECK(!flashlog_init(&log, &flash_sim_ops, REGION_OFFSET + FLASHLOG_PAGE_SIZE, REGION_SIZE));
+    CHECK(!flashlog_init(&log, &flash_sim_ops, REGION_OFFSET, REGION_SIZE + FLASHLOG_PAGE_SIZE));
+    CHECK(!flashlog_init(&log, &flash_sim_ops, REGION_OFFSET, FLASHLOG_SECTOR_SIZE));
+
+    CHECK(flashlog_init(&log, &flash_sim_ops, REGION_OFFSET, REGION_SIZE));
+    CHECK_EQ(flashlog_count(&log), 0);
+    CHECK(!flashlog_pending(&log));
+    CHECK(!read_checked(&log, 0));
+    CHECK(flashlog_read_block(&log, 0) == NULL);
+    CHECK(!flashlog_flush(&log));                   // Sin registros no hay nada que cerrar
+
+    // Una pagina completa y una a medias
+    for (int i = 0; i < 40; i++) { CHECK(append(&log)); }
+    CHECK(flashlog_pending(&log));
+    CHECK_EQ(service(&log), 1);
+    CHECK(flush(&log));
+    CHECK_EQ(service(&log), 1);
+    CHECK_EQ(flashlog_count(&log), 2);
+    CHECK_EQ(verify(&log, true), 40);
+
+    // Al reiniciar se recupera lo mismo y se sigue en la pagina siguiente
+    CHECK(flashlog_init(&boot, &flash_sim_ops, REGION_OFFSET, REGION_SIZE));
+    CHECK_EQ(boot.write_page, 2);
+    CHECK_EQ(boot.next_seq, 2);
+    CHECK_EQ(flashlog_count(&boot), 2);
+    CHECK_EQ(verify(&boot, true), 40);
+
+    // Sin grabar, append llena las paginas en RAM y despues descarta
+    model_reset();
+    int accepted = 0;
+    for (int i = 0; i < 100; i++) { accepted += append(&boot); }
+    CHECK_EQ(accepted, FLASHLOG_STAGE_PAGES * FLASHLOG_RECORDS_PER_PAGE);
+    CHECK_EQ(boot.dropped, 100 - accepted);
+    CHECK(!flush(&boot));
+    CHECK_EQ(service(&boot), FLASHLOG_STAGE_PAGES);
+    CHECK_EQ(verify(&boot, true), 40 + accepted);
+    CHECK_EQ(flash_sim.violations, 0);
+    check_guard();
+}
+
+/**
+ * @brief Varias vueltas por la region. Despues de cada pagina se reinicia otra
+ * instancia sobre la misma flash y tiene que recuperar la misma posicion
+ * leyendo pocas paginas
+ */
+static void test_wraparound(void) {
+    flashlog_t log, boot;
+    flash_sim_init();
+    memset(&model, 0, sizeof(model));
+    CHECK(flashlog_init(&log, &flash_sim_ops, REGION_OFFSET, REGION_SIZE));
+
+    uint32_t max_reads = 0;
+    for (uint32_t page = 0; page < 6 * REGION_PAGES + 5; page++) {
+        // Algunas paginas se cierran a medias
+        if (next_random() % 8) {
+            for (uint32_t i = 0; i < FLASHLOG_RECORDS_PER_PAGE; i++) { CHECK(append(&log)); }
+        } else {
+            for (uint32_t i = 1 + next_random() % (FLASHLOG_RECORDS_PER_PAGE - 1); i; i--) { CHECK(append(&log)); }
+            CHECK(flush(&log));
+        }
+        CHECK_EQ(service(&log), 1);
+
+        flash_sim.reads = 0;
+        CHECK(flashlog_init(&boot, &flash_sim_ops, REGION_OFFSET, REGION_SIZE));
+        if (flash_sim.reads > max_reads) { max_reads = flash_sim.reads; }
+        CHECK_EQ(boot.write_page, log.write_page);
+        CHECK_EQ(boot.next_seq, log.next_seq);
+        CHECK_EQ(flashlog_count(&boot), flashlog_count(&log));
+
+        // Antes de la primera vuelta estan todas; despues, todas menos lo que se borro del
+        // sector en curso, y todas justo antes de entrar a un sector nuevo
+        uint32_t written = page + 1, in_sector = written % FLASHLOG_PAGES_PER_SECTOR;
+        uint32_t expected = written;
+        if (written >= REGION_PAGES) { expected = in_sector ? REGION_PAGES - FLASHLOG_PAGES_PER_SECTOR + in_sector : REGION_PAGES; }
+        CHECK_EQ(flashlog_count(&boot), expected);
+        if (page % 61 == 0) { verify(&boot, page == 5 * 61); }
+    }
+    // Busqueda binaria sobre los 8 sectores, el ultimo sector y las paginas en blanco
+    printf("paginas leidas al iniciar: %u como maximo\n", max_reads);
+    CHECK(max_reads <= 2 * 3 + 2 * FLASHLOG_PAGES_PER_SECTOR + 4);
+
+    // Todos los sectores se borraron la misma cantidad de veces, a uno de diferencia
+    uint32_t lo = UINT32_MAX, hi = 0;
+    for (uint32_t s = 0; s < REGION_SECTORS; s++) {
+        uint32_t n = flash_sim.erases[REGION_OFFSET / FLASHLOG_SECTOR_SIZE + s];
+        if (n < lo) { lo = n; }
+        if (n > hi) { hi = n; }
+    }
+    CHECK(lo >= 6 && hi - lo <= 1);
+    CHECK_EQ(flash_sim.violations, 0);
+    check_guard();
+}
+
+/**
+ * @brief Cortes de energia en cualquier byte de una grabacion o un borrado.
+ * Despues de cada corte se reinicia y se sigue escribiendo: lo que se lee
+ * tiene que ser siempre la cola de lo grabado completo
+ */
+static void test_power_loss(void) {
+    flashlog_t log;
+    flash_sim_init();
+    memset(&model, 0, sizeof(model));
+    CHECK(flashlog_init(&log, &flash_sim_ops, REGION_OFFSET, REGION_SIZE));
+
+    uint32_t cuts = 0, torn_erases = 0;
+    while (flash_sim.programs < 6 * REGION_PAGES) {
+        // El corte llega dentro de las proximas 8 operaciones, en cualquier byte
+        flash_sim.cut_ops = (int32_t)(next_random() % 8);
+        flash_sim.cut_bytes = next_random() % FLASHLOG_SECTOR_SIZE;
+        while (!flash_sim.dead) {
+            if (next_random() % 16) {
+                append(&log);
+            } else {
+                flush(&log);
+            }
+            if (flashlog_pending(&log)) {
+                bool erasing = log.write_page % FLASHLOG_PAGES_PER_SECTOR == 0;
+                int32_t before = flash_sim.cut_ops;
+                service(&log);
+                // Se corto el borrado si el corte estaba pendiente como primera operacion
+                torn_erases += erasing && flash_sim.dead && before == 0;
+            }
+        }
+        cuts++;
+
+        // Reinicio: lo que estaba en RAM se pierde
+        flash_sim_reboot();
+        model_reset();
+        CHECK(flashlog_init(&log, &flash_sim_ops, REGION_OFFSET, REGION_SIZE));
+        uint32_t readable = verify(&log, cuts == 150);
+
+        // Se lee todo lo que quedo en la ventana, y la ventana cubre toda la region menos
+        // el sector que se borra: las paginas cortadas ocupan su lugar pero no ocultan otras
+        CHECK_EQ(readable, visible_records(&log));
+        if (log.next_seq >= REGION_PAGES) { CHECK(flashlog_count(&log) >= REGION_PAGES - FLASHLOG_PAGES_PER_SECTOR); }
+
+        // La proxima pagina a grabar esta borrada o empieza un sector que se va a borrar
+        const uint8_t *next = &flash_sim.mem[REGION_OFFSET + log.write_page * FLASHLOG_PAGE_SIZE];
+        bool blank = true;
+        for (uint32_t i = 0; i < FLASHLOG_PAGE_SIZE; i++) { blank &= next[i] == 0xFF; }
+        CHECK(blank || log.write_page % FLASHLOG_PAGES_PER_SECTOR == 0);
+    }
+    printf("cortes: %u, borrados cortados: %u\n", cuts, torn_erases);
+    CHECK(cuts > 200);
+    CHECK(torn_erases > 10);
+    CHECK_EQ(flash_sim.violations, 0);
+    check_guard();
+}
+
+// Bloques y registros en la misma region: cada lectura saltea las paginas del otro tipo
+static void test_blocks(void) {
+    flashlog_t log, boot;
+    uint8_t block[FLASHLOG_BLOCK_SIZE];
+    flash_sim_init();
+    memset(&model, 0, sizeof(model));
+    CHECK(flashlog_init(&log, &flash_sim_ops, REGION_OFFSET, REGION_SIZE));
+
+    for (uint32_t i = 0; i < 3 * REGION_PAGES; i++) {
+        if (i % 3 == 0) {
+            memset(block, (int)(i / 3) & 0xFF, sizeof(block));
+            CHECK(flashlog_append_block(&log, block));
+        } else {
+            for (uint32_t r = 0; r < 5; r++) { CHECK(append(&log)); }
+            // Con registros sueltos en la pagina en curso no se puede agregar un bloque
+            CHECK(!flashlog_append_block(&log, block));
+            CHECK(flush(&log));
+        }
+        flashlog_service(&log);
+        // El modelo no sabe de bloques: paso a grabados los registros de la pagina
+        if (model.staged_count) {
+            for (uint32_t r = 0; r < model.staged[0][1]; r++) { model.durable[model.durable_count++] = model.staged[0][0] + r; }
+            model.staged_count = 0;
+        }
+    }
+
+    CHECK(flashlog_init(&boot, &flash_sim_ops, REGION_OFFSET, REGION_SIZE));
+    verify(&boot, true);
+    uint32_t blocks = 0;
+    for (const uint8_t *b; (b = flashlog_read_block(&boot, blocks)) != NULL; blocks++) {
+        // El ultimo bloque es el de i = 3 * REGION_PAGES - 3
+        CHECK_EQ(b[0], (REGION_PAGES - 1 - blocks) & 0xFF);
+        CHECK_EQ(b[FLASHLOG_BLOCK_SIZE - 1], b[0]);
+    }
+    // Un tercio de las paginas legibles
+    CHECK(blocks >= (REGION_PAGES - FLASHLOG_PAGES_PER_SECTOR) / 3);
+    CHECK(blocks <= REGION_PAGES / 3 + 1);
+    CHECK_EQ(flash_sim.violations, 0);
+}
+
+int main(void) {
+    test_basic();
+    test_wraparound();
+    test_power_loss();
+    test_blocks();
+    return check_result("flashlog");
+}
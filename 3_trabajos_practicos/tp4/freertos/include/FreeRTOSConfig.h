@@ -46,7 +46,12 @@
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK                     0
 #define configUSE_TICK_HOOK                     0
+/* En debug se verifica el patron del final de cada stack en cada cambio de contexto */
+#ifdef NDEBUG
 #define configCHECK_FOR_STACK_OVERFLOW          0
+#else
+#define configCHECK_FOR_STACK_OVERFLOW          2
+#endif
 #define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
@@ -78,15 +83,21 @@
 #define INCLUDE_vTaskDelay                     1
 #define INCLUDE_xTaskGetSchedulerState         1
 #define INCLUDE_xTaskGetCurrentTaskHandle      1
-#define INCLUDE_uxTaskGetStackHighWaterMark    0
+#define INCLUDE_uxTaskGetStackHighWaterMark    1
 #define INCLUDE_xTaskGetIdleTaskHandle         0
 #define INCLUDE_eTaskGetState                  0
 #define INCLUDE_xEventGroupSetBitFromISR       1
 #define INCLUDE_xTimerPendFunctionCall         1
 #define INCLUDE_xTaskAbortDelay                0
-#define INCLUDE_xTaskGetHandle                 0
+#define INCLUDE_xTaskGetHandle                 1
 #define INCLUDE_xTaskResumeFromISR             1
 
 /* A header file that defines trace macro can be included here. */
 
+/* Cambios de contexto, el comando ao del shell muestra la tasa */
+#ifndef __ASSEMBLER__
+extern volatile unsigned long task_switches;
+#endif
+#define traceTASK_SWITCHED_IN()                task_switches++
+
 #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
@@ -0,0 +1,71 @@
+#ifndef _I2C_TRACE_H_
+#define _I2C_TRACE_H_
+
+#include <stddef.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+// Transacciones que guarda el buffer circular
+#define I2C_TRACE_RING_SIZE     128
+// Bytes de datos guardados por transaccion (alcanza para la calibracion del BMP280)
+#define I2C_TRACE_DATA_MAX      26
+// Direcciones distintas con estadisticas propias
+#define I2C_TRACE_MAX_CLIENTS   8
+// Diferencia admitida al reproducir entre la pausa antes de cada transaccion y la grabada.
+// Una traza de la placa incluye el tiempo de CPU y los desalojos entre transacciones
+#ifndef I2C_TRACE_GAP_TOLERANCE_US
+#define I2C_TRACE_GAP_TOLERANCE_US  100
+#endif
+
+// Banderas de cada transaccion
+#define I2C_TRACE_READ          0x01    // Lectura (si no, escritura)
+#define I2C_TRACE_NOSTOP        0x02    // Sin condicion de stop al final
+
+/**
+ * @brief Una transaccion del bus
+ */
+typedef struct {
+    uint32_t time_us;                   // Inicio de la transaccion
+    uint16_t duration_us;               // Tiempo ocupando el bus
+    uint8_t addr;                       // Direccion de 7 bits
+    uint8_t flags;                      // I2C_TRACE_READ e I2C_TRACE_NOSTOP
+    int16_t result;                     // Bytes transferidos o codigo de error del SDK
+    uint8_t len;                        // Bytes pedidos
+    uint8_t data[I2C_TRACE_DATA_MAX];   // Primeros bytes escritos o leidos
+} i2c_trace_entry_t;
+
+// Bytes de la transaccion antes de los datos
+#define I2C_TRACE_HEADER_SIZE   offsetof(i2c_trace_entry_t, data)
+
+/**
+ * @brief Estadisticas de una direccion (un driver)
+ */
+typedef struct {
+    uint8_t addr;                       // Direccion de 7 bits
+    uint32_t transactions;              // Transacciones
+    uint32_t bytes;                     // Bytes transferidos
+    uint32_t bus_us;                    // Tiempo total ocupando el bus
+    uint32_t errors;                    // Transacciones fallidas
+} i2c_trace_client_t;
+
+// Reemplazos de las funciones del SDK, con los mismos argumentos
+int i2c_trace_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_trace_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+// Registro y reporte
+bool i2c_trace_record(bool enable);
+void i2c_trace_reset(void);
+size_t i2c_trace_count(void);
+bool i2c_trace_get(size_t index, i2c_trace_entry_t *entry);
+const i2c_trace_client_t *i2c_trace_clients(size_t *count);
+
+// Formato de texto de una transaccion, para guardar y reproducir trazas
+int i2c_trace_format(const i2c_trace_entry_t *entry, char *buf, size_t size);
+bool i2c_trace_parse(const char *line, i2c_trace_entry_t *entry);
+
+// Reproduccion de una traza, solo en la plataforma host del SDK
+void i2c_trace_replay(const i2c_trace_entry_t *entries, size_t count);
+uint32_t i2c_trace_replay_mismatches(void);
+uint32_t i2c_trace_replay_truncated(void);
+
+#endif
@@ -0,0 +1,342 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "i2c_trace.h"
+
+// Buffer circular de transacciones
+static i2c_trace_entry_t ring[I2C_TRACE_RING_SIZE];
+static uint32_t ring_head = 0;
+static bool recording = true;
+// Estadisticas por direccion
+static i2c_trace_client_t clients[I2C_TRACE_MAX_CLIENTS];
+static size_t client_count = 0;
+
+/**
+ * @brief Acumula una transaccion en las estadisticas y en el buffer circular
+ * @param entry puntero a la transaccion
+ */
+static void i2c_trace_add(const i2c_trace_entry_t *entry) {
+    i2c_trace_client_t *client = NULL;
+
+    for (size_t i = 0; i < client_count; i++) {
+        if (clients[i].addr == entry->addr) { client = &clients[i]; }
+    }
+    if (!client && client_count < I2C_TRACE_MAX_CLIENTS) {
+        client = &clients[client_count++];
+        memset(client, 0, sizeof(*client));
+        client->addr = entry->addr;
+    }
+    if (client) {
+        client->transactions++;
+        client->bus_us += entry->duration_us;
+        if (entry->result < 0) {
+            client->errors++;
+        } else {
+            client->bytes += entry->result;
+        }
+    }
+
+    if (recording) { ring[ring_head++ % I2C_TRACE_RING_SIZE] = *entry; }
+}
+
+/**
+ * @brief Prepara el registro de una transaccion
+ * @param entry puntero a la transaccion
+ * @param addr direccion de 7 bits
+ * @param len bytes pedidos
+ * @param flags I2C_TRACE_READ e I2C_TRACE_NOSTOP
+ */
+static void i2c_trace_begin(i2c_trace_entry_t *entry, uint8_t addr, size_t len, uint8_t flags) {
+    entry->time_us = 0;
+    entry->duration_us = 0;
+    entry->addr = addr;
+    entry->flags = flags;
+    entry->result = 0;
+    entry->len = len > UINT8_MAX ? UINT8_MAX : len;
+    memset(entry->data, 0, sizeof(entry->data));
+}
+
+#if PICO_ON_DEVICE
+
+/**
+ * @brief Escribe en el bus y registra la transaccion. Mismos argumentos que
+ * i2c_write_blocking; se llama con el bus tomado, como la funcion original
+ * @return bytes escritos o PICO_ERROR_GENERIC
+ */
+int i2c_trace_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    i2c_trace_entry_t entry;
+    i2c_trace_begin(&entry, addr, len, nostop ? I2C_TRACE_NOSTOP : 0);
+    memcpy(entry.data, src, len < I2C_TRACE_DATA_MAX ? len : I2C_TRACE_DATA_MAX);
+
+    entry.time_us = time_us_32();
+    int result = i2c_write_blocking(i2c, addr, src, len, nostop);
+    uint32_t duration = time_us_32() - entry.time_us;
+    entry.duration_us = duration > UINT16_MAX ? UINT16_MAX : duration;
+    entry.result = result;
+
+    i2c_trace_add(&entry);
+    return result;
+}
+
+/**
+ * @brief Lee del bus y registra la transaccion. Mismos argumentos que
+ * i2c_read_blocking; se llama con el bus tomado, como la funcion original
+ * @return bytes leidos o PICO_ERROR_GENERIC
+ */
+int i2c_trace_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    i2c_trace_entry_t entry;
+    i2c_trace_begin(&entry, addr, len, I2C_TRACE_READ | (nostop ? I2C_TRACE_NOSTOP : 0));
+
+    entry.time_us = time_us_32();
+    int result = i2c_read_blocking(i2c, addr, dst, len, nostop);
+    uint32_t duration = time_us_32() - entry.time_us;
+    entry.duration_us = duration > UINT16_MAX ? UINT16_MAX : duration;
+    entry.result = result;
+    if (result > 0) { memcpy(entry.data, dst, result < I2C_TRACE_DATA_MAX ? result : I2C_TRACE_DATA_MAX); }
+
+    i2c_trace_add(&entry);
+    return result;
+}
+
+// En la placa no hay reproduccion, las transacciones van siempre al bus
+void i2c_trace_replay(const i2c_trace_entry_t *entries, size_t count) {
+    (void)entries;
+    (void)count;
+}
+
+uint32_t i2c_trace_replay_mismatches(void) {
+    return 0;
+}
+
+uint32_t i2c_trace_replay_truncated(void) {
+    return 0;
+}
+
+#else
+
+// Traza que se reproduce, avance y diferencias encontradas
+static const i2c_trace_entry_t *replay_entries = NULL;
+static size_t replay_count = 0;
+static size_t replay_index = 0;
+static uint32_t replay_mismatches = 0;
+static uint32_t replay_truncated = 0;
+// Fin de la transaccion anterior en el reloj del SDK, que avanza con la duracion grabada
+static uint32_t replay_end = 0;
+
+/**
+ * @brief Toma la proxima transaccion de la traza y la compara con la pedida: los
+ * datos y la pausa desde la anterior, con las esperas del driver
+ * @param entry transaccion pedida por el driver
+ * @return transaccion grabada o NULL si la traza termino
+ */
+static const i2c_trace_entry_t *i2c_trace_next(i2c_trace_entry_t *entry) {
+    if (replay_index >= replay_count) {
+        replay_mismatches++;
+        fprintf(stderr, "i2c_trace: traza terminada, %02x %s de %u bytes\n", entry->addr,
+                entry->flags & I2C_TRACE_READ ? "lee" : "escribe", entry->len);
+        return NULL;
+    }
+
+    const i2c_trace_entry_t *recorded = &replay_entries[replay_index++];
+    size_t n = entry->len < I2C_TRACE_DATA_MAX ? entry->len : I2C_TRACE_DATA_MAX;
+    bool same = recorded->addr == entry->addr && recorded->flags == entry->flags && recorded->len == entry->len &&
+                (entry->flags & I2C_TRACE_READ || !memcmp(recorded->data, entry->data, n));
+    if (!same) {
+        replay_mismatches++;
+        char expected[128], actual[128];
+        i2c_trace_format(recorded, expected, sizeof(expected));
+        i2c_trace_format(entry, actual, sizeof(actual));
+        fprintf(stderr, "i2c_trace: transaccion %zu distinta\n  grabada: %s\n  pedida:  %s\n", replay_index - 1, expected, actual);
+    }
+    // Solo se guardan los primeros bytes: el resto de una escritura no se compara y el de una lectura vuelve en cero
+    if (entry->len > I2C_TRACE_DATA_MAX) {
+        replay_truncated++;
+        fprintf(stderr, "i2c_trace: transaccion %zu de %u bytes, solo se %s los primeros %d\n", replay_index - 1,
+                entry->len, entry->flags & I2C_TRACE_READ ? "devuelven" : "comparan", I2C_TRACE_DATA_MAX);
+    }
+
+    // Pausa desde el fin de la anterior: las esperas del driver, contra la grabada
+    uint32_t now = time_us_32();
+    if (replay_index > 1) {
+        const i2c_trace_entry_t *previous = recorded - 1;
+        uint32_t gap = now - replay_end;
+        uint32_t recorded_gap = recorded->time_us - (previous->time_us + previous->duration_us);
+        uint32_t diff = gap > recorded_gap ? gap - recorded_gap : recorded_gap - gap;
+        if (diff > I2C_TRACE_GAP_TOLERANCE_US) {
+            replay_mismatches++;
+            fprintf(stderr, "i2c_trace: transaccion %zu despues de %lu us, grabada despues de %lu us\n",
+                    replay_index - 1, (unsigned long)gap, (unsigned long)recorded_gap);
+        }
+    }
+
+    // La transaccion ocupa el bus lo mismo que al grabarla
+    entry->time_us = now;
+    entry->duration_us = recorded->duration_us;
+    entry->result = recorded->result;
+    sleep_us(recorded->duration_us);
+    replay_end = time_us_32();
+    return recorded;
+}
+
+/**
+ * @brief Reproduce una escritura de la traza y verifica los datos
+ * @return resultado grabado
+ */
+int i2c_trace_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    i2c_trace_entry_t entry;
+    (void)i2c;
+    i2c_trace_begin(&entry, addr, len, nostop ? I2C_TRACE_NOSTOP : 0);
+    memcpy(entry.data, src, len < I2C_TRACE_DATA_MAX ? len : I2C_TRACE_DATA_MAX);
+
+    if (!i2c_trace_next(&entry)) { return PICO_ERROR_GENERIC; }
+    i2c_trace_add(&entry);
+    return entry.result;
+}
+
+/**
+ * @brief Reproduce una lectura de la traza, devolviendo los datos grabados
+ * @return resultado grabado
+ */
+int i2c_trace_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    i2c_trace_entry_t entry;
+    (void)i2c;
+    i2c_trace_begin(&entry, addr, len, I2C_TRACE_READ | (nostop ? I2C_TRACE_NOSTOP : 0));
+
+    const i2c_trace_entry_t *recorded = i2c_trace_next(&entry);
+    if (!recorded) { return PICO_ERROR_GENERIC; }
+    memset(dst, 0, len);
+    memcpy(dst, recorded->data, len < I2C_TRACE_DATA_MAX ? len : I2C_TRACE_DATA_MAX);
+    memcpy(entry.data, recorded->data, sizeof(entry.data));
+    i2c_trace_add(&entry);
+    return entry.result;
+}
+
+/**
+ * @brief Carga una traza para reproducir. Las funciones de lectura y escritura
+ * la recorren en orden y cuentan las transacciones distintas a las grabadas
+ * @param entries transacciones grabadas
+ * @param count cantidad de transacciones
+ */
+void i2c_trace_replay(const i2c_trace_entry_t *entries, size_t count) {
+    replay_entries = entries;
+    replay_count = count;
+    replay_index = 0;
+    replay_mismatches = 0;
+    replay_truncated = 0;
+}
+
+/**
+ * @brief Transacciones que no coincidieron con la traza, en los datos o en la pausa
+ * @return cantidad de diferencias
+ */
+uint32_t i2c_trace_replay_mismatches(void) {
+    return replay_mismatches;
+}
+
+/**
+ * @brief Transacciones de mas de I2C_TRACE_DATA_MAX bytes, que se reprodujeron
+ * con los primeros bytes: escrituras comparadas en parte y lecturas completadas con ceros
+ * @return cantidad de transacciones
+ */
+uint32_t i2c_trace_replay_truncated(void) {
+    return replay_truncated;
+}
+
+#endif
+
+/**
+ * @brief Habilita o deshabilita el buffer circular. Las estadisticas siguen
+ * @param enable true para registrar cada transaccion
+ * @return estado anterior
+ */
+bool i2c_trace_record(bool enable) {
+    bool previous = recording;
+    recording = enable;
+    return previous;
+}
+
+/**
+ * @brief Borra el buffer circular y las estadisticas
+ */
+void i2c_trace_reset(void) {
+    ring_head = 0;
+    client_count = 0;
+}
+
+/**
+ * @brief Transacciones disponibles en el buffer circular
+ * @return cantidad de transacciones
+ */
+size_t i2c_trace_count(void) {
+    return ring_head < I2C_TRACE_RING_SIZE ? ring_head : I2C_TRACE_RING_SIZE;
+}
+
+/**
+ * @brief Copia una transaccion del buffer circular
+ * @param index 0 para la mas vieja disponible
+ * @param entry puntero donde se copia
+ * @return false si no hay tantas transacciones
+ */
+bool i2c_trace_get(size_t index, i2c_trace_entry_t *entry) {
+    size_t count = i2c_trace_count();
+    if (index >= count) { return false; }
+    *entry = ring[(ring_head - count + index) % I2C_TRACE_RING_SIZE];
+    return true;
+}
+
+/**
+ * @brief Estadisticas por direccion
+ * @param count puntero donde se guarda la cantidad de direcciones
+ * @return arreglo de estadisticas
+ */
+const i2c_trace_client_t *i2c_trace_clients(size_t *count) {
+    *count = client_count;
+    return clients;
+}
+
+/**
+ * @brief Escribe una transaccion como texto:
+ * "tiempo duracion direccion R|W S|N resultado largo datos" (datos en hexa)
+ * @param entry puntero a la transaccion
+ * @param buf destino
+ * @param size tamaño del destino
+ * @return caracteres escritos, como snprintf
+ */
+int i2c_trace_format(const i2c_trace_entry_t *entry, char *buf, size_t size) {
+    int n = snprintf(buf, size, "%lu %u %02x %c %c %d %u ", (unsigned long)entry->time_us, entry->duration_us, entry->addr,
+                     entry->flags & I2C_TRACE_READ ? 'R' : 'W', entry->flags & I2C_TRACE_NOSTOP ? 'N' : 'S',
+                     entry->result, entry->len);
+    size_t bytes = entry->len < I2C_TRACE_DATA_MAX ? entry->len : I2C_TRACE_DATA_MAX;
+    for (size_t i = 0; i < bytes && n > 0 && (size_t)n < size; i++) {
+        n += snprintf(buf + n, size - n, "%02x", entry->data[i]);
+    }
+    return n;
+}
+
+/**
+ * @brief Lee una transaccion escrita con i2c_trace_format
+ * @param line linea de texto
+ * @param entry puntero donde se guarda la transaccion
+ * @return false si la linea no tiene el formato esperado
+ */
+bool i2c_trace_parse(const char *line, i2c_trace_entry_t *entry) {
+    unsigned long time_us;
+    unsigned duration, addr, len;
+    int result, used;
+    char rw, stop;
+
+    if (sscanf(line, "%lu %u %x %c %c %d %u %n", &time_us, &duration, &addr, &rw, &stop, &result, &len, &used) != 7) {
+        return false;
+    }
+    i2c_trace_begin(entry, addr, len, (rw == 'R' ? I2C_TRACE_READ : 0) | (stop == 'N' ? I2C_TRACE_NOSTOP : 0));
+    entry->time_us = time_us;
+    entry->duration_us = duration;
+    entry->result = result;
+
+    const char *hex = line + used;
+    for (size_t i = 0; i < I2C_TRACE_DATA_MAX && i < len && hex[0] && hex[1]; i++, hex += 2) {
+        char byte[3] = { hex[0], hex[1], '\0' };
+        entry->data[i] = strtoul(byte, NULL, 16);
+    }
+    return true;
+}
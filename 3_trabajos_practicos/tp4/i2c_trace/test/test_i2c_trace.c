@@ -0,0 +1,252 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "check.h"
+#include "bmp280.h"
+#include "i2c_trace.h"
+#include "lcd.h"
+
+// Transacciones que entran en la traza cargada
+#define TRACE_MAX       512
+// Direccion del adaptador del LCD en tp4
+#define LCD_ADDR        0x27
+
+static i2c_trace_entry_t trace[TRACE_MAX];
+static size_t trace_count;
+// Lineas de transacciones del archivo, para comparar el formato
+static char trace_lines[TRACE_MAX][128];
+
+/**
+ * @brief Carga una traza de texto, salteando las lineas que no son transacciones
+ * @return false si no se pudo abrir
+ */
+static bool load(const char *path) {
+    FILE *file = fopen(path, "r");
+    char line[128];
+
+    if (!file) { return false; }
+    while (trace_count < TRACE_MAX && fgets(line, sizeof(line), file)) {
+        if (i2c_trace_parse(line, &trace[trace_count])) {
+            line[strcspn(line, "\r\n")] = '\0';
+            strcpy(trace_lines[trace_count++], line);
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief La secuencia del firmware de tp4: inicializa el sensor y el LCD, mide
+ * y muestra un cuadro
+ * @return false si algun driver informo error
+ */
+static bool run_drivers(bmp280_t *dev, const char *line0, const char *line1) {
+    lcd_frame_t frame;
+    bool ok = bmp280_init(dev, i2c0, BMP280_ADDR_PRIMARY);
+
+    lcd_init(i2c0, LCD_ADDR);
+    ok = ok && bmp280_read_raw(dev) == BMP280_DONE;
+    lcd_frame_line(&frame, 0, line0);
+    lcd_frame_line(&frame, 1, line1);
+    for (uint32_t i = 0; i < LCD_FRAME_COMMANDS; i++) { lcd_frame_send(&frame, i); }
+    return ok;
+}
+
+// Cada linea vuelve a escribirse igual despues de leerla
+static void test_format(void) {
+    char text[128];
+    i2c_trace_entry_t entry;
+
+    for (size_t i = 0; i < trace_count; i++) {
+        i2c_trace_format(&trace[i], text, sizeof(text));
+        CHECK(!strcmp(text, trace_lines[i]));
+    }
+
+    CHECK(!i2c_trace_parse("# comentario", &entry));
+    CHECK(!i2c_trace_parse("", &entry));
+    CHECK(!i2c_trace_parse("10 20 76 R", &entry));
+
+    // Un error del SDK se guarda con su codigo y sin datos
+    CHECK(i2c_trace_parse("5 90 76 R S -1 2", &entry));
+    CHECK_EQ(entry.result, PICO_ERROR_GENERIC);
+    CHECK_EQ(entry.flags, I2C_TRACE_READ);
+    CHECK_EQ(entry.data[0], 0);
+}
+
+// Los drivers sin modificar reproducen la traza completa y leen los datos grabados
+static void test_replay(void) {
+    bmp280_t dev;
+    size_t count;
+
+    i2c_trace_reset();
+    i2c_trace_replay(trace, trace_count);
+    CHECK(run_drivers(&dev, "T 25.08 C", "P 1006.56 hPa"));
+    CHECK_EQ(i2c_trace_replay_mismatches(), 0);
+
+    CHECK_EQ(dev.chip_id, BMP280_CHIP_ID);
+    CHECK_EQ(dev.calib.dig_t1, 27504);
+    CHECK_EQ(dev.calib.dig_p9, 6000);
+    CHECK(bmp280_convert_temp(dev.raw_temp, &dev.calib) == 25.08f);
+    CHECK_EQ(bmp280_convert_pressure(dev.raw_pressure, dev.raw_temp, &dev.calib), 100656);
+
+    // Estadisticas por dispositivo con las duraciones grabadas
+    uint32_t bus_us[2] = { 0, 0 }, transactions[2] = { 0, 0 };
+    for (size_t i = 0; i < trace_count; i++) {
+        transactions[trace[i].addr == LCD_ADDR] += 1;
+        bus_us[trace[i].addr == LCD_ADDR] += trace[i].duration_us;
+    }
+    const i2c_trace_client_t *clients = i2c_trace_clients(&count);
+    CHECK_EQ(count, 2);
+    for (size_t i = 0; i < count; i++) {
+        int lcd = clients[i].addr == LCD_ADDR;
+        CHECK_EQ(clients[i].transactions, transactions[lcd]);
+        CHECK_EQ(clients[i].bus_us, bus_us[lcd]);
+        CHECK_EQ(clients[i].errors, 0);
+    }
+    printf("reproduccion: %zu transacciones, bmp280 %lu us y lcd %lu us de bus\n",
+           trace_count, (unsigned long)bus_us[0], (unsigned long)bus_us[1]);
+
+    // La traza termino: la proxima transaccion falla y cuenta como diferencia
+    CHECK_EQ(bmp280_read_raw(&dev), BMP280_ERROR);
+    CHECK_EQ(i2c_trace_replay_mismatches(), 1);
+}
+
+// Un cambio en lo que escribe un driver aparece como diferencia
+static void test_mismatch(void) {
+    bmp280_t dev;
+
+    i2c_trace_replay(trace, trace_count);
+    CHECK(run_drivers(&dev, "T 25.09 C", "P 1006.56 hPa"));
+    CHECK_EQ(i2c_trace_replay_mismatches(), 1);                 // Un solo caracter distinto
+
+    // Una transaccion de menos desfasa todo lo que sigue
+    i2c_trace_replay(trace, trace_count);
+    bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY);
+    bmp280_read_raw(&dev);
+    CHECK(i2c_trace_replay_mismatches() > 0);
+}
+
+/**
+ * @brief Las pausas entre transacciones: las esperas del driver contra las
+ * grabadas, con I2C_TRACE_GAP_TOLERANCE_US de diferencia
+ */
+static void test_gaps(void) {
+    // Una escritura, 500 us de espera y dos escrituras seguidas
+    static const i2c_trace_entry_t gaps[] = {
+        { .time_us = 1000, .duration_us = 100, .addr = 0x10, .result = 1, .len = 1, .data = { 0x01 } },
+        { .time_us = 1600, .duration_us = 100, .addr = 0x10, .result = 1, .len = 1, .data = { 0x02 } },
+        { .time_us = 1700, .duration_us = 100, .addr = 0x10, .result = 1, .len = 1, .data = { 0x03 } },
+    };
+    const uint32_t waits[] = { 500, 0, 500 + I2C_TRACE_GAP_TOLERANCE_US, 500 + I2C_TRACE_GAP_TOLERANCE_US + 1 };
+    const uint32_t expected[] = { 0, 1, 0, 1 };
+    uint8_t byte;
+
+    for (size_t i = 0; i < sizeof(waits) / sizeof(waits[0]); i++) {
+        uint32_t start = time_us_32();
+        i2c_trace_replay(gaps, 3);
+        for (uint8_t j = 0; j < 3; j++) {
+            byte = j + 1;
+            CHECK_EQ(i2c_trace_write_blocking(i2c0, 0x10, &byte, 1, false), 1);
+            if (j == 0) { sleep_us(waits[i]); }
+        }
+        CHECK_EQ(i2c_trace_replay_mismatches(), expected[i]);
+        // Cada transaccion ocupa el bus lo que duro al grabarla
+        CHECK_EQ(time_us_32() - start, 3 * 100 + waits[i]);
+    }
+
+    // La traza de ejemplo tiene las esperas del LCD y de la conversion: sin ellas no coincide
+    bmp280_t dev;
+    i2c_trace_replay(trace, trace_count);
+    bmp280_init(&dev, i2c0, BMP280_ADDR_PRIMARY);
+    lcd_init(i2c0, LCD_ADDR);
+    CHECK_EQ(i2c_trace_replay_mismatches(), 0);
+    // Consulta el estado sin esperar la conversion
+    CHECK(bmp280_start(&dev));
+    bmp280_poll(&dev);
+    CHECK(i2c_trace_replay_mismatches() > 0);
+}
+
+// Las transacciones de mas de I2C_TRACE_DATA_MAX bytes se informan aparte
+static void test_truncated(void) {
+    uint8_t data[I2C_TRACE_DATA_MAX + 4];
+    i2c_trace_entry_t long_trace[3];
+
+    for (size_t i = 0; i < sizeof(data); i++) { data[i] = i; }
+    memset(long_trace, 0, sizeof(long_trace));
+    for (size_t i = 0; i < 3; i++) {
+        long_trace[i].addr = 0x10;
+        long_trace[i].len = i < 2 ? sizeof(data) : 1;
+        long_trace[i].result = long_trace[i].len;
+        memcpy(long_trace[i].data, data, I2C_TRACE_DATA_MAX);
+    }
+    long_trace[1].flags = I2C_TRACE_READ;
+
+    // La escritura difiere despues de los bytes guardados: coincide, pero se informa
+    data[sizeof(data) - 1] ^= 0xFF;
+    i2c_trace_replay(long_trace, 3);
+    CHECK_EQ(i2c_trace_write_blocking(i2c0, 0x10, data, sizeof(data), false), sizeof(data));
+    CHECK_EQ(i2c_trace_replay_truncated(), 1);
+    // La lectura devuelve los bytes guardados y el resto en cero
+    memset(data, 0xFF, sizeof(data));
+    CHECK_EQ(i2c_trace_read_blocking(i2c0, 0x10, data, sizeof(data), false), sizeof(data));
+    CHECK_EQ(data[I2C_TRACE_DATA_MAX - 1], I2C_TRACE_DATA_MAX - 1);
+    CHECK_EQ(data[I2C_TRACE_DATA_MAX], 0);
+    CHECK_EQ(i2c_trace_replay_truncated(), 2);
+    // Una transaccion corta no cuenta
+    CHECK_EQ(i2c_trace_write_blocking(i2c0, 0x10, data, 1, false), 1);
+    CHECK_EQ(i2c_trace_replay_truncated(), 2);
+    CHECK_EQ(i2c_trace_replay_mismatches(), 0);
+
+    i2c_trace_replay(long_trace, 3);
+    CHECK_EQ(i2c_trace_replay_truncated(), 0);
+}
+
+// El buffer circular guarda las ultimas I2C_TRACE_RING_SIZE transacciones
+static void test_ring(void) {
+    bmp280_t dev;
+    i2c_trace_entry_t entry;
+
+    i2c_trace_reset();
+    CHECK_EQ(i2c_trace_count(), 0);
+    for (int i = 0; i < 2; i++) {
+        i2c_trace_replay(trace, trace_count);
+        run_drivers(&dev, "T 25.08 C", "P 1006.56 hPa");
+    }
+    CHECK(2 * trace_count > I2C_TRACE_RING_SIZE);
+    CHECK_EQ(i2c_trace_count(), I2C_TRACE_RING_SIZE);
+
+    // La mas vieja disponible y la ultima
+    size_t oldest = (2 * trace_count - I2C_TRACE_RING_SIZE) % trace_count;
+    CHECK(i2c_trace_get(0, &entry));
+    CHECK_EQ(entry.addr, trace[oldest].addr);
+    CHECK(!memcmp(entry.data, trace[oldest].data, sizeof(entry.data)));
+    CHECK(i2c_trace_get(I2C_TRACE_RING_SIZE - 1, &entry));
+    CHECK(!memcmp(entry.data, trace[trace_count - 1].data, sizeof(entry.data)));
+    CHECK(!i2c_trace_get(I2C_TRACE_RING_SIZE, &entry));
+
+    // Pausado no guarda transacciones pero sigue contando
+    i2c_trace_reset();
+    CHECK(i2c_trace_record(false));
+    i2c_trace_replay(trace, trace_count);
+    run_drivers(&dev, "T 25.08 C", "P 1006.56 hPa");
+    CHECK_EQ(i2c_trace_count(), 0);
+    size_t count;
+    const i2c_trace_client_t *clients = i2c_trace_clients(&count);
+    CHECK_EQ(clients[0].transactions + clients[1].transactions, trace_count);
+    CHECK(!i2c_trace_record(true));
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || !load(argv[1])) {
+        fprintf(stderr, "uso: test_i2c_trace <traza>\n");
+        return EXIT_FAILURE;
+    }
+    CHECK(trace_count > 0);
+    test_format();
+    test_replay();
+    test_mismatch();
+    test_gaps();
+    test_truncated();
+    test_ring();
+    return check_result("i2c_trace");
+}
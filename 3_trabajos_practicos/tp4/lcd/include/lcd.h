@@ -47,11 +47,28 @@
 #define MAX_LINES      2
 #define MAX_CHARS      16
 
+// Tiempo de ejecucion de borrar y volver al inicio, los demas comandos terminan
+// antes de que llegue el siguiente por I2C
+#define LCD_SLOW_US    2000
+
+// Comandos de un cuadro completo: la posicion y los caracteres de cada linea
+#define LCD_FRAME_COMMANDS (MAX_LINES * (MAX_CHARS + 1))
+
+/**
+ * @brief Contenido de la pantalla, para mandarlo de a un comando
+ */
+typedef struct {
+    char text[MAX_LINES][MAX_CHARS];
+} lcd_frame_t;
+
 // Prototipos de funciones
 void lcd_clear(void);
 void lcd_set_cursor(int line, int position);
 void lcd_char(char val);
 void lcd_string(const char *s);
 void lcd_init(i2c_inst_t *i2c, uint8_t address);
+uint32_t lcd_command(uint8_t val, int mode);
+void lcd_frame_line(lcd_frame_t *frame, int line, const char *s);
+uint32_t lcd_frame_send(const lcd_frame_t *frame, uint32_t index);
 
 #endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "lcd.h"
+#include "i2c_trace.h"
 
 // Puntero a I2C usado
 static i2c_inst_t *lcd_i2c;
@@ -10,7 +11,7 @@ static uint8_t addr;
  * @param val es el byte a mandar
 */
 static void i2c_write_byte(uint8_t val) {
-    i2c_write_blocking(lcd_i2c, addr, &val, 1, false);
+    i2c_trace_write_blocking(lcd_i2c, addr, &val, 1, false);
 }
 
 /**
@@ -80,6 +81,54 @@ void lcd_string(const char *s) {
     }
 }
 
+/**
+ * @brief Manda un byte en una sola transaccion: cada nibble con su pulso de
+ * enable. El pulso dura un byte del I2C, mas que los 450 ns que pide el
+ * HD44780. No espera la ejecucion del comando
+ * @param val es el byte a enviar
+ * @param mode LCD_COMMAND o LCD_CHARACTER
+ * @return microsegundos que el display queda ocupado despues de la
+ * transaccion, 0 salvo en borrar y volver al inicio
+*/
+uint32_t lcd_command(uint8_t val, int mode) {
+    uint8_t high = mode | (val & 0xF0) | LCD_BACKLIGHT;
+    uint8_t low = mode | ((val << 4) & 0xF0) | LCD_BACKLIGHT;
+    uint8_t seq[6] = { high, high | LCD_ENABLE_BIT, high, low, low | LCD_ENABLE_BIT, low };
+
+    i2c_trace_write_blocking(lcd_i2c, addr, seq, sizeof(seq), false);
+    return mode == LCD_COMMAND && val < LCD_ENTRYMODESET ? LCD_SLOW_US : 0;
+}
+
+/**
+ * @brief Copia una linea en el cuadro, completa con espacios
+ * @param frame cuadro
+ * @param line es el numero de linea (0 o 1)
+ * @param s es la cadena, se corta en MAX_CHARS caracteres
+*/
+void lcd_frame_line(lcd_frame_t *frame, int line, const char *s) {
+    for (int i = 0; i < MAX_CHARS; i++) {
+        frame->text[line][i] = *s ? *s++ : ' ';
+    }
+}
+
+/**
+ * @brief Manda un comando del cuadro: la posicion al principio de cada linea y
+ * despues sus caracteres. Cada comando es una transaccion corta, entre dos
+ * comandos el bus puede atender a otros dispositivos
+ * @param frame cuadro
+ * @param index comando, de 0 a LCD_FRAME_COMMANDS - 1
+ * @return microsegundos que el display queda ocupado (ver lcd_command)
+*/
+uint32_t lcd_frame_send(const lcd_frame_t *frame, uint32_t index) {
+    int line = index / (MAX_CHARS + 1);
+    int position = index % (MAX_CHARS + 1);
+
+    if (position == 0) {
+        return lcd_command(LCD_SETDDRAMADDR + (line ? 0x40 : 0x00), LCD_COMMAND);
+    }
+    return lcd_command(frame->text[line][position - 1], LCD_CHARACTER);
+}
+
 /**
  * @brief Inicializa el display
  * @param i2c puntero a I2C usado (i2c0 o i2c1)
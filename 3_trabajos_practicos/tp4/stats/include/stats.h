@@ -0,0 +1,65 @@
+#ifndef _STATS_H_
+#define _STATS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Cuantiles que estima cada ventana
+#define STATS_QUANTILE_COUNT 3
+#define STATS_Q05 0
+#define STATS_Q50 1
+#define STATS_Q95 2
+
+/**
+ * @brief Resumen de una serie de muestras (Welford)
+ */
+typedef struct {
+    uint32_t count;     // Cantidad de muestras
+    float mean;         // Media
+    float m2;           // Suma de cuadrados de las diferencias a la media
+    float min;          // Valor minimo
+    float max;          // Valor maximo
+} stats_t;
+
+/**
+ * @brief Estimador de un cuantil por el algoritmo P² (5 marcadores)
+ */
+typedef struct {
+    float p;            // Cuantil a estimar (0 a 1)
+    float q[5];         // Altura de los marcadores
+    int32_t n[5];       // Posicion real de los marcadores
+    float np[5];        // Posicion deseada de los marcadores
+    uint32_t count;     // Muestras procesadas
+} stats_p2_t;
+
+/**
+ * @brief Ventana deslizante formada por baldes de muestras consecutivas
+ */
+typedef struct {
+    stats_t *buckets;               // Baldes de la ventana, el de head es el actual
+    uint16_t bucket_count;          // Cantidad de baldes
+    uint16_t bucket_samples;        // Muestras por balde
+    uint16_t head;                  // Balde que recibe las muestras
+    stats_t closed;                 // Union de los baldes completos
+    stats_p2_t p2[STATS_QUANTILE_COUNT];    // Cuantiles del periodo en curso
+    float quantiles[STATS_QUANTILE_COUNT];  // Cuantiles del ultimo periodo completo
+    uint32_t period_samples;        // Muestras del periodo en curso
+} stats_window_t;
+
+// Prototipos de funciones
+void stats_reset(stats_t *s);
+void stats_add(stats_t *s, float x);
+void stats_merge(stats_t *dst, const stats_t *src);
+float stats_variance(const stats_t *s);
+float stats_stddev(const stats_t *s);
+
+void stats_p2_init(stats_p2_t *e, float p);
+void stats_p2_add(stats_p2_t *e, float x);
+float stats_p2_get(const stats_p2_t *e);
+
+void stats_window_init(stats_window_t *w, stats_t *buckets, uint16_t bucket_count, uint16_t bucket_samples);
+void stats_window_add(stats_window_t *w, float x);
+void stats_window_get(const stats_window_t *w, stats_t *out);
+float stats_window_quantile(const stats_window_t *w, int index);
+
+#endif
@@ -0,0 +1,232 @@
+#include <math.h>
+#include "stats.h"
+
+// Cuantiles estimados por cada ventana
+static const float stats_quantile_p[STATS_QUANTILE_COUNT] = { 0.05f, 0.5f, 0.95f };
+
+/**
+ * @brief Reinicia un resumen
+ * @param s puntero al resumen
+ */
+void stats_reset(stats_t *s) {
+    s->count = 0;
+    s->mean = 0.0f;
+    s->m2 = 0.0f;
+    s->min = INFINITY;
+    s->max = -INFINITY;
+}
+
+/**
+ * @brief Agrega una muestra con el algoritmo de Welford, costo constante
+ * @param s puntero al resumen
+ * @param x muestra
+ */
+void stats_add(stats_t *s, float x) {
+    s->count++;
+    float delta = x - s->mean;
+    s->mean += delta / s->count;
+    s->m2 += delta * (x - s->mean);
+    if (x < s->min) { s->min = x; }
+    if (x > s->max) { s->max = x; }
+}
+
+/**
+ * @brief Une dos resumenes (formula de Chan para la varianza)
+ * @param dst resumen que acumula el resultado
+ * @param src resumen a agregar
+ */
+void stats_merge(stats_t *dst, const stats_t *src) {
+    if (!src->count) { return; }
+    if (!dst->count) {
+        *dst = *src;
+        return;
+    }
+    uint32_t count = dst->count + src->count;
+    float delta = src->mean - dst->mean;
+    dst->mean += delta * src->count / count;
+    dst->m2 += src->m2 + delta * delta * ((float)dst->count * src->count / count);
+    dst->count = count;
+    if (src->min < dst->min) { dst->min = src->min; }
+    if (src->max > dst->max) { dst->max = src->max; }
+}
+
+/**
+ * @brief Varianza muestral
+ * @param s puntero al resumen
+ * @return varianza o 0 si hay menos de dos muestras
+ */
+float stats_variance(const stats_t *s) {
+    return s->count > 1 ? s->m2 / (s->count - 1) : 0.0f;
+}
+
+/**
+ * @brief Desvio estandar muestral
+ * @param s puntero al resumen
+ * @return desvio estandar o 0 si hay menos de dos muestras
+ */
+float stats_stddev(const stats_t *s) {
+    return sqrtf(stats_variance(s));
+}
+
+/**
+ * @brief Inicializa el estimador P² de un cuantil
+ * @param e puntero al estimador
+ * @param p cuantil a estimar (0.5 para la mediana)
+ */
+void stats_p2_init(stats_p2_t *e, float p) {
+    e->p = p;
+    e->count = 0;
+    for (int i = 0; i < 5; i++) {
+        e->q[i] = 0.0f;
+        e->n[i] = i;
+    }
+    // Posiciones deseadas iniciales de los marcadores
+    e->np[0] = 0.0f;
+    e->np[1] = 2.0f * p;
+    e->np[2] = 4.0f * p;
+    e->np[3] = 2.0f + 2.0f * p;
+    e->np[4] = 4.0f;
+}
+
+/**
+ * @brief Agrega una muestra al estimador P², costo constante
+ * @param e puntero al estimador
+ * @param x muestra
+ */
+void stats_p2_add(stats_p2_t *e, float x) {
+    // Las primeras cinco muestras se guardan ordenadas
+    if (e->count < 5) {
+        int i = e->count++;
+        while (i > 0 && e->q[i - 1] > x) {
+            e->q[i] = e->q[i - 1];
+            i--;
+        }
+        e->q[i] = x;
+        return;
+    }
+    e->count++;
+
+    // Busco la celda de la muestra y ajusto los extremos
+    int k;
+    if (x < e->q[0]) {
+        e->q[0] = x;
+        k = 0;
+    } else if (x >= e->q[4]) {
+        e->q[4] = x;
+        k = 3;
+    } else {
+        for (k = 0; k < 3 && x >= e->q[k + 1]; k++);
+    }
+
+    // Corro los marcadores por encima de la celda y las posiciones deseadas
+    for (int i = k + 1; i < 5; i++) { e->n[i]++; }
+    const float dn[5] = { 0.0f, e->p / 2.0f, e->p, (1.0f + e->p) / 2.0f, 1.0f };
+    for (int i = 0; i < 5; i++) { e->np[i] += dn[i]; }
+
+    // Ajusto los marcadores centrales que se alejaron de su posicion deseada
+    for (int i = 1; i < 4; i++) {
+        float d = e->np[i] - e->n[i];
+        if ((d >= 1.0f && e->n[i + 1] - e->n[i] > 1) || (d <= -1.0f && e->n[i - 1] - e->n[i] < -1)) {
+            int ds = d > 0 ? 1 : -1;
+            // Prediccion parabolica
+            float qp = e->q[i] + (float)ds / (e->n[i + 1] - e->n[i - 1]) *
+                       ((e->n[i] - e->n[i - 1] + ds) * (e->q[i + 1] - e->q[i]) / (e->n[i + 1] - e->n[i]) +
+                        (e->n[i + 1] - e->n[i] - ds) * (e->q[i] - e->q[i - 1]) / (e->n[i] - e->n[i - 1]));
+            if (e->q[i - 1] < qp && qp < e->q[i + 1]) {
+                e->q[i] = qp;
+            } else {
+                // Si la parabola no es monotona, uso prediccion lineal
+                e->q[i] += ds * (e->q[i + ds] - e->q[i]) / (e->n[i + ds] - e->n[i]);
+            }
+            e->n[i] += ds;
+        }
+    }
+}
+
+/**
+ * @brief Devuelve el cuantil estimado
+ * @param e puntero al estimador
+ * @return valor estimado del cuantil o 0 si no hay muestras
+ */
+float stats_p2_get(const stats_p2_t *e) {
+    if (!e->count) { return 0.0f; }
+    // Con menos de cinco muestras, el cuantil exacto de las guardadas
+    if (e->count < 5) {
+        return e->q[(int)(e->p * (e->count - 1) + 0.5f)];
+    }
+    return e->q[2];
+}
+
+/**
+ * @brief Inicializa una ventana deslizante. La ventana cubre entre
+ * (bucket_count - 1) y bucket_count baldes completos y avanza de a un balde
+ * @param w puntero a la ventana
+ * @param buckets arreglo de baldes provisto por el usuario
+ * @param bucket_count cantidad de baldes del arreglo (al menos 2)
+ * @param bucket_samples muestras por balde
+ */
+void stats_window_init(stats_window_t *w, stats_t *buckets, uint16_t bucket_count, uint16_t bucket_samples) {
+    w->buckets = buckets;
+    w->bucket_count = bucket_count;
+    w->bucket_samples = bucket_samples ? bucket_samples : 1;
+    w->head = 0;
+    w->period_samples = 0;
+    stats_reset(&w->closed);
+    for (uint16_t i = 0; i < bucket_count; i++) { stats_reset(&buckets[i]); }
+    for (int i = 0; i < STATS_QUANTILE_COUNT; i++) {
+        stats_p2_init(&w->p2[i], stats_quantile_p[i]);
+        w->quantiles[i] = NAN;
+    }
+}
+
+/**
+ * @brief Agrega una muestra a la ventana. Costo constante por muestra mas
+ * la union de los baldes una vez por balde completo
+ * @param w puntero a la ventana
+ * @param x muestra
+ */
+void stats_window_add(stats_window_t *w, float x) {
+    stats_add(&w->buckets[w->head], x);
+    for (int i = 0; i < STATS_QUANTILE_COUNT; i++) { stats_p2_add(&w->p2[i], x); }
+
+    // Los cuantiles no se pueden deslizar, se calculan por periodos de una ventana completa
+    if (++w->period_samples >= (uint32_t)w->bucket_count * w->bucket_samples) {
+        for (int i = 0; i < STATS_QUANTILE_COUNT; i++) {
+            w->quantiles[i] = stats_p2_get(&w->p2[i]);
+            stats_p2_init(&w->p2[i], stats_quantile_p[i]);
+        }
+        w->period_samples = 0;
+    }
+
+    if (w->buckets[w->head].count < w->bucket_samples) { return; }
+
+    // Balde completo, el mas viejo pasa a ser el actual y se vuelven a unir los completos
+    w->head = (w->head + 1) % w->bucket_count;
+    stats_reset(&w->buckets[w->head]);
+    stats_reset(&w->closed);
+    for (uint16_t i = 0; i < w->bucket_count; i++) {
+        if (i != w->head) { stats_merge(&w->closed, &w->buckets[i]); }
+    }
+}
+
+/**
+ * @brief Obtiene el resumen de la ventana, incluido el balde en curso
+ * @param w puntero a la ventana
+ * @param out puntero donde se guarda el resumen
+ */
+void stats_window_get(const stats_window_t *w, stats_t *out) {
+    *out = w->closed;
+    stats_merge(out, &w->buckets[w->head]);
+}
+
+/**
+ * @brief Obtiene un cuantil del ultimo periodo completo de la ventana, o
+ * del periodo en curso si todavia no se completo ninguno
+ * @param w puntero a la ventana
+ * @param index STATS_Q05, STATS_Q50 o STATS_Q95
+ * @return valor estimado del cuantil
+ */
+float stats_window_quantile(const stats_window_t *w, int index) {
+    if (isnan(w->quantiles[index])) { return stats_p2_get(&w->p2[index]); }
+    return w->quantiles[index];
+}
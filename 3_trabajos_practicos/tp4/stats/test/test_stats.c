@@ -0,0 +1,299 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "check.h"
+#include "stats.h"
+
+#define SAMPLES 20000
+
+// M_PI no esta definido en C11 estricto
+#define PI 3.14159265358979323846
+
+// Generador congruencial, las series son siempre las mismas
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+// Uniforme en (0, 1)
+static double uniform(void) {
+    return (next_random() + 0.5) / 65536.0;
+}
+
+// Normal por Box-Muller
+static double normal(double mean, double sigma) {
+    return mean + sigma * sqrt(-2.0 * log(uniform())) * cos(2.0 * PI * uniform());
+}
+
+typedef enum { SERIES_SENSOR, SERIES_OFFSET, SERIES_UNIFORM, SERIES_SKEWED, SERIES_STEP, SERIES_COUNT } series_t;
+
+static const char *series_name[SERIES_COUNT] = { "sensor", "offset", "uniforme", "asimetrica", "escalon" };
+
+// Series como las de los canales de sensores
+static void generate(series_t type, float *x, int n) {
+    for (int i = 0; i < n; i++) {
+        switch (type) {
+        case SERIES_SENSOR:  x[i] = (float)normal(25.0, 0.5); break;              // Temperatura
+        case SERIES_OFFSET:  x[i] = (float)normal(101325.0, 3.0); break;          // Presion en Pa
+        case SERIES_UNIFORM: x[i] = (float)(uniform() * 100.0); break;
+        case SERIES_SKEWED:  x[i] = (float)(-10.0 * log(uniform())); break;       // Exponencial
+        case SERIES_STEP:    x[i] = (float)(i < n / 2 ? normal(20.0, 0.2) : normal(30.0, 0.2)); break;
+        default: break;
+        }
+    }
+}
+
+/**
+ * @brief Media y varianza muestral exactas, en doble precision y en dos pasadas
+ */
+static void exact(const float *x, int n, double *mean, double *variance) {
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) { sum += x[i]; }
+    *mean = sum / n;
+    double m2 = 0.0;
+    for (int i = 0; i < n; i++) { m2 += (x[i] - *mean) * (x[i] - *mean); }
+    *variance = n > 1 ? m2 / (n - 1) : 0.0;
+}
+
+static int compare(const void *a, const void *b) {
+    float fa = *(const float *)a, fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+/**
+ * @brief Error de rango de un cuantil estimado: distancia entre p y la fraccion
+ * de muestras menores o iguales al estimado
+ */
+static double rank_error(const float *sorted, int n, float estimate, double p) {
+    int below = 0;
+    while (below < n && sorted[below] <= estimate) { below++; }
+    return fabs((double)below / n - p);
+}
+
+// Error relativo de la media y la varianza de Welford, muestra a muestra y con una sola union
+static void test_welford(void) {
+    static float x[SAMPLES];
+
+    for (series_t type = 0; type < SERIES_COUNT; type++) {
+        generate(type, x, SAMPLES);
+        stats_t s;
+        stats_reset(&s);
+        double mean_err = 0, var_err = 0;
+        for (int i = 0; i < SAMPLES; i++) {
+            stats_add(&s, x[i]);
+            // Se compara en varios puntos de la serie, no solo al final
+            if ((i + 1) % 997 == 0 || i == SAMPLES - 1) {
+                double mean, variance;
+                exact(x, i + 1, &mean, &variance);
+                double e = fabs(s.mean - mean) / sqrt(variance);
+                if (e > mean_err) { mean_err = e; }
+                e = fabs(stats_variance(&s) - variance) / variance;
+                if (e > var_err) { var_err = e; }
+            }
+        }
+        printf("welford %-10s media %.2e desvios, varianza %.2e relativo\n", series_name[type], mean_err, var_err);
+        // La media queda a menos de una milesima del desvio y la varianza a 0,01 %. Con un
+        // offset 30000 veces mayor que el desvio, delta / count cae por debajo de la
+        // resolucion del float y la media deja de moverse: en 20000 muestras se aleja hasta
+        // un decimo del desvio. Por eso las ventanas resumen baldes chicos
+        CHECK(mean_err < (type == SERIES_OFFSET ? 1e-1 : 1e-3));
+        CHECK(var_err < (type == SERIES_OFFSET ? 1e-2 : 1e-4));
+        CHECK_EQ(s.count, SAMPLES);
+
+        float lo = x[0], hi = x[0];
+        for (int i = 1; i < SAMPLES; i++) {
+            if (x[i] < lo) { lo = x[i]; }
+            if (x[i] > hi) { hi = x[i]; }
+        }
+        CHECK(s.min == lo && s.max == hi);
+    }
+
+    // Casos borde
+    stats_t s;
+    stats_reset(&s);
+    CHECK(stats_variance(&s) == 0.0f);
+    stats_add(&s, 3.0f);
+    CHECK(s.mean == 3.0f && stats_variance(&s) == 0.0f && s.min == 3.0f && s.max == 3.0f);
+    stats_add(&s, 5.0f);
+    CHECK(s.mean == 4.0f && stats_variance(&s) == 2.0f);
+}
+
+// Union de Chan: la serie partida en pedazos al azar y unida da lo mismo que la serie entera
+static void test_chan(void) {
+    static float x[SAMPLES];
+
+    for (series_t type = 0; type < SERIES_COUNT; type++) {
+        generate(type, x, SAMPLES);
+        double mean, variance;
+        exact(x, SAMPLES, &mean, &variance);
+
+        double mean_err = 0, var_err = 0;
+        for (int trial = 0; trial < 50; trial++) {
+            stats_t total, part;
+            stats_reset(&total);
+            int i = 0;
+            while (i < SAMPLES) {
+                // Pedazos de 0 a 2000 muestras, incluidos los vacios
+                int len = next_random() % 2001;
+                stats_reset(&part);
+                for (int j = 0; j < len && i < SAMPLES; j++) { stats_add(&part, x[i++]); }
+                stats_merge(&total, &part);
+            }
+            CHECK_EQ(total.count, SAMPLES);
+            double e = fabs(total.mean - mean) / sqrt(variance);
+            if (e > mean_err) { mean_err = e; }
+            e = fabs(stats_variance(&total) - variance) / variance;
+            if (e > var_err) { var_err = e; }
+        }
+        printf("chan    %-10s media %.2e desvios, varianza %.2e relativo\n", series_name[type], mean_err, var_err);
+        // Los pedazos chicos mejoran al offset, que sigue limitado por el float
+        CHECK(mean_err < (type == SERIES_OFFSET ? 2e-2 : 1e-4));
+        CHECK(var_err < (type == SERIES_OFFSET ? 2e-3 : 1e-5));
+    }
+
+    // Unir un resumen vacio no cambia nada, y unir en un vacio copia
+    stats_t a, b;
+    stats_reset(&a);
+    stats_reset(&b);
+    stats_add(&a, 1.0f);
+    stats_add(&a, 2.0f);
+    stats_merge(&a, &b);
+    CHECK(a.count == 2 && a.mean == 1.5f);
+    stats_merge(&b, &a);
+    CHECK(b.count == 2 && b.mean == 1.5f && b.min == 1.0f && b.max == 2.0f);
+}
+
+// Ventana deslizante contra el calculo exacto de las muestras que cubre
+static void check_window(series_t type, float scale, uint16_t bucket_count, uint16_t bucket_samples, int n) {
+    static float x[SAMPLES];
+    static stats_t buckets[60];
+    stats_window_t w;
+
+    generate(type, x, n);
+    for (int i = 0; i < n; i++) { x[i] *= scale; }
+    stats_window_init(&w, buckets, bucket_count, bucket_samples);
+    double mean_err = 0, var_err = 0;
+    for (int i = 0; i < n; i++) {
+        stats_window_add(&w, x[i]);
+
+        // Cubre los baldes completos menos uno mas las muestras del balde en curso
+        int count = i + 1;
+        int full = (bucket_count - 1) * bucket_samples + count % bucket_samples;
+        int covered = count < full ? count : full;
+        const float *first = &x[count - covered];
+
+        stats_t s;
+        stats_window_get(&w, &s);
+        CHECK_EQ(s.count, (uint32_t)covered);
+        float lo = first[0], hi = first[0];
+        for (int j = 1; j < covered; j++) {
+            if (first[j] < lo) { lo = first[j]; }
+            if (first[j] > hi) { hi = first[j]; }
+        }
+        CHECK(s.min == lo && s.max == hi);
+        if (covered < 2 || i % 7) { continue; }
+
+        double mean, variance;
+        exact(first, covered, &mean, &variance);
+        double e = fabs(s.mean - mean) / sqrt(variance);
+        if (e > mean_err) { mean_err = e; }
+        e = fabs(stats_variance(&s) - variance) / variance;
+        if (e > var_err) { var_err = e; }
+    }
+    printf("ventana %-10s %2ux%-2u media %.2e desvios, varianza %.2e relativo\n", series_name[type], bucket_count,
+           bucket_samples, mean_err, var_err);
+    // La presion en kPa tiene una resolucion de 7,6e-6 en float, 2,5e-3 desvios: el error
+    // queda en unas pocas unidades de esa resolucion, centesimas de Pa
+    CHECK(mean_err < (type == SERIES_OFFSET ? 2e-2 : 1e-4));
+    CHECK(var_err < (type == SERIES_OFFSET ? 3e-3 : 1e-4));
+}
+
+static void test_window(void) {
+    // Las ventanas del firmware: temperatura en C y presion en kPa, de un minuto y de una hora
+    check_window(SERIES_SENSOR, 1.0f, 6, 10, 2000);
+    check_window(SERIES_OFFSET, 0.001f, 6, 10, 2000);
+    check_window(SERIES_SENSOR, 1.0f, 60, 60, SAMPLES);
+    check_window(SERIES_OFFSET, 0.001f, 60, 60, SAMPLES);
+    check_window(SERIES_STEP, 1.0f, 6, 10, 2000);
+}
+
+// P² contra el cuantil exacto de la serie ordenada
+static void test_p2(void) {
+    static float x[SAMPLES], sorted[SAMPLES];
+    const float p[] = { 0.05f, 0.5f, 0.95f };
+
+    for (series_t type = 0; type < SERIES_COUNT; type++) {
+        for (int trial = 0; trial < 10; trial++) {
+            generate(type, x, SAMPLES);
+            for (size_t q = 0; q < sizeof(p) / sizeof(p[0]); q++) {
+                stats_p2_t e;
+                stats_p2_init(&e, p[q]);
+                for (int i = 0; i < SAMPLES; i++) { stats_p2_add(&e, x[i]); }
+                for (int i = 0; i < SAMPLES; i++) { sorted[i] = x[i]; }
+                qsort(sorted, SAMPLES, sizeof(float), compare);
+
+                double err = rank_error(sorted, SAMPLES, stats_p2_get(&e), p[q]);
+                if (!trial) {
+                    printf("p2 %-10s p%02d estimado %10.3f exacto %10.3f error de rango %.4f\n", series_name[type],
+                           (int)(p[q] * 100 + 0.5f), stats_p2_get(&e), sorted[(int)(p[q] * (SAMPLES - 1))], err);
+                }
+                // En series estacionarias el estimado cae a menos de medio punto del cuantil
+                // pedido. Con el offset los marcadores tienen la resolucion del float, un
+                // vigesimo del desvio, y en el escalon la distribucion cambia a mitad de camino
+                CHECK(err < (type == SERIES_STEP || type == SERIES_OFFSET ? 0.03 : 0.005));
+            }
+        }
+    }
+
+    // Con menos de cinco muestras el cuantil es exacto
+    stats_p2_t e;
+    stats_p2_init(&e, 0.5f);
+    CHECK(stats_p2_get(&e) == 0.0f);
+    stats_p2_add(&e, 7.0f);
+    stats_p2_add(&e, 1.0f);
+    stats_p2_add(&e, 4.0f);
+    CHECK(stats_p2_get(&e) == 4.0f);
+    stats_p2_init(&e, 0.95f);
+    for (int i = 4; i > 0; i--) { stats_p2_add(&e, (float)i); }
+    CHECK(stats_p2_get(&e) == 4.0f);
+
+    // Muestras constantes
+    stats_p2_init(&e, 0.5f);
+    for (int i = 0; i < 1000; i++) { stats_p2_add(&e, 2.5f); }
+    CHECK(stats_p2_get(&e) == 2.5f);
+}
+
+// Los cuantiles de la ventana son los del ultimo periodo completo
+static void test_window_quantiles(void) {
+    static float x[SAMPLES], sorted[600];
+    stats_t buckets[6];
+    stats_window_t w;
+
+    generate(SERIES_SENSOR, x, SAMPLES);
+    stats_window_init(&w, buckets, 6, 100);
+    for (int i = 0; i < 1800; i++) {
+        stats_window_add(&w, x[i]);
+        if ((i + 1) % 600) { continue; }
+
+        // Periodo completo: comparo con los cuantiles exactos de sus 600 muestras
+        for (int j = 0; j < 600; j++) { sorted[j] = x[i + 1 - 600 + j]; }
+        qsort(sorted, 600, sizeof(float), compare);
+        CHECK(rank_error(sorted, 600, stats_window_quantile(&w, STATS_Q05), 0.05) < 0.02);
+        CHECK(rank_error(sorted, 600, stats_window_quantile(&w, STATS_Q50), 0.50) < 0.02);
+        CHECK(rank_error(sorted, 600, stats_window_quantile(&w, STATS_Q95), 0.95) < 0.02);
+        CHECK(stats_window_quantile(&w, STATS_Q05) < stats_window_quantile(&w, STATS_Q50));
+        CHECK(stats_window_quantile(&w, STATS_Q50) < stats_window_quantile(&w, STATS_Q95));
+    }
+}
+
+int main(void) {
+    test_welford();
+    test_chan();
+    test_window();
+    test_p2();
+    test_window_quantiles();
+    return check_result("stats");
+}
@@ -0,0 +1,54 @@
+#ifndef _TSCOMP_H_
+#define _TSCOMP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Canales de cada muestra (temperatura y presion)
+#define TSCOMP_CHANNELS     2
+
+// Bytes del encabezado de cada bloque (cantidad de muestras)
+#define TSCOMP_HEADER_SIZE  2
+
+/**
+ * @brief Muestra con marca de tiempo y valores enteros (punto fijo)
+ */
+typedef struct {
+    uint32_t time;                      // Marca de tiempo
+    int32_t value[TSCOMP_CHANNELS];     // Valores de cada canal
+} tscomp_sample_t;
+
+/**
+ * @brief Compresor de un bloque. Cada bloque se decodifica en forma independiente
+ */
+typedef struct {
+    uint8_t *buf;               // Bloque de salida
+    size_t size;                // Tamaño del bloque en bytes
+    size_t bits;                // Bits escritos
+    uint16_t count;             // Muestras en el bloque
+    tscomp_sample_t last;       // Ultima muestra
+    int32_t last_delta;         // Ultima diferencia de tiempo
+} tscomp_encoder_t;
+
+/**
+ * @brief Descompresor de un bloque
+ */
+typedef struct {
+    const uint8_t *buf;         // Bloque de entrada
+    size_t size;                // Tamaño del bloque en bytes
+    size_t bits;                // Bits leidos
+    uint16_t count;             // Muestras en el bloque
+    uint16_t index;             // Muestras leidas
+    tscomp_sample_t last;       // Ultima muestra
+    int32_t last_delta;         // Ultima diferencia de tiempo
+} tscomp_decoder_t;
+
+// Prototipos de funciones
+void tscomp_encoder_init(tscomp_encoder_t *enc, uint8_t *buf, size_t size);
+bool tscomp_encode(tscomp_encoder_t *enc, const tscomp_sample_t *sample);
+size_t tscomp_encoder_finish(tscomp_encoder_t *enc);
+uint16_t tscomp_decoder_init(tscomp_decoder_t *dec, const uint8_t *buf, size_t size);
+bool tscomp_decode(tscomp_decoder_t *dec, tscomp_sample_t *sample);
+
+#endif
@@ -0,0 +1,225 @@
+#include <string.h>
+#include "tscomp.h"
+
+// Bits de una muestra sin comprimir (la primera del bloque)
+#define TSCOMP_RAW_BITS     (32 * (1 + TSCOMP_CHANNELS))
+
+/**
+ * @brief Codifica un entero con signo para que los valores chicos, positivos
+ * o negativos, queden chicos (0, -1, 1, -2... -> 0, 1, 2, 3...)
+ * @param v valor con signo
+ * @return valor sin signo
+ */
+static inline uint32_t tscomp_zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+/**
+ * @brief Operacion inversa de tscomp_zigzag
+ * @param z valor sin signo
+ * @return valor con signo
+ */
+static inline int32_t tscomp_unzigzag(uint32_t z) {
+    return (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+}
+
+/**
+ * @brief Largo del codigo de un valor. Prefijo de hasta 4 bits que indica el
+ * tamaño del campo: '0' (valor 0), '10' + 4, '110' + 8, '1110' + 12, '1111' + 32
+ * @param z valor en zigzag
+ * @return cantidad de bits
+ */
+static inline size_t tscomp_code_bits(uint32_t z) {
+    if (!z) { return 1; }
+    if (z < (1u << 4)) { return 2 + 4; }
+    if (z < (1u << 8)) { return 3 + 8; }
+    if (z < (1u << 12)) { return 4 + 12; }
+    return 4 + 32;
+}
+
+/**
+ * @brief Escribe bits en el bloque, el mas significativo primero. El bloque
+ * debe estar en cero
+ * @param enc puntero al compresor
+ * @param value bits a escribir alineados a la derecha
+ * @param n cantidad de bits (hasta 32)
+ */
+static void tscomp_put(tscomp_encoder_t *enc, uint32_t value, int n) {
+    while (n > 0) {
+        int room = 8 - (enc->bits & 7);
+        int take = n < room ? n : room;
+        uint32_t chunk = (value >> (n - take)) & ((1u << take) - 1);
+        enc->buf[TSCOMP_HEADER_SIZE + (enc->bits >> 3)] |= (uint8_t)(chunk << (room - take));
+        enc->bits += take;
+        n -= take;
+    }
+}
+
+/**
+ * @brief Lee bits del bloque, el mas significativo primero. Fuera del bloque
+ * lee ceros, el llamador verifica la posicion al terminar la muestra
+ * @param dec puntero al descompresor
+ * @param n cantidad de bits (hasta 32)
+ * @return bits leidos alineados a la derecha
+ */
+static uint32_t tscomp_get(tscomp_decoder_t *dec, int n) {
+    uint32_t value = 0;
+    while (n > 0) {
+        int room = 8 - (dec->bits & 7);
+        int take = n < room ? n : room;
+        size_t pos = TSCOMP_HEADER_SIZE + (dec->bits >> 3);
+        uint8_t byte = pos < dec->size ? dec->buf[pos] : 0;
+        value = (value << take) | ((byte >> (room - take)) & ((1u << take) - 1));
+        dec->bits += take;
+        n -= take;
+    }
+    return value;
+}
+
+/**
+ * @brief Escribe un valor con el codigo de prefijo
+ * @param enc puntero al compresor
+ * @param z valor en zigzag
+ */
+static void tscomp_put_code(tscomp_encoder_t *enc, uint32_t z) {
+    if (!z) {
+        tscomp_put(enc, 0x0, 1);
+    } else if (z < (1u << 4)) {
+        tscomp_put(enc, 0x2, 2);
+        tscomp_put(enc, z, 4);
+    } else if (z < (1u << 8)) {
+        tscomp_put(enc, 0x6, 3);
+        tscomp_put(enc, z, 8);
+    } else if (z < (1u << 12)) {
+        tscomp_put(enc, 0xE, 4);
+        tscomp_put(enc, z, 12);
+    } else {
+        tscomp_put(enc, 0xF, 4);
+        tscomp_put(enc, z, 32);
+    }
+}
+
+/**
+ * @brief Lee un valor con el codigo de prefijo
+ * @param dec puntero al descompresor
+ * @return valor en zigzag
+ */
+static uint32_t tscomp_get_code(tscomp_decoder_t *dec) {
+    static const uint8_t width[] = { 0, 4, 8, 12, 32 };
+    int ones = 0;
+    while (ones < 4 && tscomp_get(dec, 1)) { ones++; }
+    return ones ? tscomp_get(dec, width[ones]) : 0;
+}
+
+/**
+ * @brief Inicializa el compresor sobre un bloque vacio
+ * @param enc puntero al compresor
+ * @param buf bloque de salida
+ * @param size tamaño del bloque, al menos TSCOMP_HEADER_SIZE mas una muestra sin comprimir
+ */
+void tscomp_encoder_init(tscomp_encoder_t *enc, uint8_t *buf, size_t size) {
+    enc->buf = buf;
+    enc->size = size;
+    enc->bits = 0;
+    enc->count = 0;
+    enc->last_delta = 0;
+    memset(buf, 0, size);
+}
+
+/**
+ * @brief Agrega una muestra al bloque. La primera va completa; en las demas
+ * el tiempo se guarda como diferencia de diferencias (0 si el periodo es
+ * constante) y cada valor como diferencia con el anterior
+ * @param enc puntero al compresor
+ * @param sample puntero a la muestra
+ * @return false si la muestra no entra y hay que empezar otro bloque
+ */
+bool tscomp_encode(tscomp_encoder_t *enc, const tscomp_sample_t *sample) {
+    size_t room = (enc->size - TSCOMP_HEADER_SIZE) * 8 - enc->bits;
+
+    if (enc->count == UINT16_MAX) { return false; }
+
+    if (!enc->count) {
+        if (room < TSCOMP_RAW_BITS) { return false; }
+        tscomp_put(enc, sample->time, 32);
+        for (int i = 0; i < TSCOMP_CHANNELS; i++) { tscomp_put(enc, (uint32_t)sample->value[i], 32); }
+    } else {
+        // Calculo los codigos y verifico que entren antes de escribir
+        int32_t delta = (int32_t)(sample->time - enc->last.time);
+        uint32_t z[1 + TSCOMP_CHANNELS];
+        z[0] = tscomp_zigzag((int32_t)((uint32_t)delta - (uint32_t)enc->last_delta));
+        size_t bits = tscomp_code_bits(z[0]);
+        for (int i = 0; i < TSCOMP_CHANNELS; i++) {
+            z[1 + i] = tscomp_zigzag((int32_t)((uint32_t)sample->value[i] - (uint32_t)enc->last.value[i]));
+            bits += tscomp_code_bits(z[1 + i]);
+        }
+        if (bits > room) { return false; }
+
+        for (int i = 0; i < 1 + TSCOMP_CHANNELS; i++) { tscomp_put_code(enc, z[i]); }
+        enc->last_delta = delta;
+    }
+
+    enc->last = *sample;
+    enc->count++;
+    // El encabezado siempre esta al dia, el bloque se puede leer en cualquier momento
+    enc->buf[0] = enc->count & 0xFF;
+    enc->buf[1] = enc->count >> 8;
+    return true;
+}
+
+/**
+ * @brief Devuelve los bytes usados del bloque
+ * @param enc puntero al compresor
+ * @return bytes del bloque con datos, incluido el encabezado
+ */
+size_t tscomp_encoder_finish(tscomp_encoder_t *enc) {
+    return TSCOMP_HEADER_SIZE + (enc->bits + 7) / 8;
+}
+
+/**
+ * @brief Inicializa el descompresor sobre un bloque
+ * @param dec puntero al descompresor
+ * @param buf bloque de entrada
+ * @param size tamaño del bloque
+ * @return cantidad de muestras del bloque
+ */
+uint16_t tscomp_decoder_init(tscomp_decoder_t *dec, const uint8_t *buf, size_t size) {
+    dec->buf = buf;
+    dec->size = size;
+    dec->bits = 0;
+    dec->index = 0;
+    dec->last_delta = 0;
+    dec->count = size < TSCOMP_HEADER_SIZE ? 0 : buf[0] | (uint16_t)buf[1] << 8;
+    return dec->count;
+}
+
+/**
+ * @brief Lee la proxima muestra del bloque
+ * @param dec puntero al descompresor
+ * @param sample puntero donde se guarda la muestra
+ * @return false si no quedan muestras o el bloque esta corrupto
+ */
+bool tscomp_decode(tscomp_decoder_t *dec, tscomp_sample_t *sample) {
+    if (dec->index >= dec->count) { return false; }
+
+    if (!dec->index) {
+        dec->last.time = tscomp_get(dec, 32);
+        for (int i = 0; i < TSCOMP_CHANNELS; i++) { dec->last.value[i] = (int32_t)tscomp_get(dec, 32); }
+    } else {
+        dec->last_delta = (int32_t)((uint32_t)dec->last_delta + (uint32_t)tscomp_unzigzag(tscomp_get_code(dec)));
+        dec->last.time += dec->last_delta;
+        for (int i = 0; i < TSCOMP_CHANNELS; i++) {
+            dec->last.value[i] = (int32_t)((uint32_t)dec->last.value[i] + (uint32_t)tscomp_unzigzag(tscomp_get_code(dec)));
+        }
+    }
+
+    // Si se leyo fuera del bloque, el encabezado no coincide con los datos
+    if (dec->bits > (dec->size - TSCOMP_HEADER_SIZE) * 8) {
+        dec->count = dec->index;
+        return false;
+    }
+
+    dec->index++;
+    *sample = dec->last;
+    return true;
+}
@@ -0,0 +1,149 @@
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "check.h"
+#include "tscomp.h"
+
+// Bloque del tamaño de los datos de una pagina de flashlog
+#define BLOCK_SIZE  248
+#define SAMPLES     100000
+#define BLOCKS      (SAMPLES / 8)
+// Repeticiones para medir el tiempo
+#define REPEAT      20
+
+// Generador congruencial, las series son siempre las mismas
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+// Ruido uniforme entre -n y n
+static int32_t noise(int32_t n) {
+    return (int32_t)(next_random() % (2 * n + 1)) - n;
+}
+
+typedef enum { SERIES_CONSTANT, SERIES_1S, SERIES_10S, SERIES_NOISE, SERIES_COUNT } series_t;
+
+static const char *series_name[SERIES_COUNT] = {
+    "constante", "BMP280 cada 1 s", "BMP280 cada 10 s", "ruido de 16 bits",
+};
+
+/**
+ * @brief Series de temperatura en centesimas de C y presion en Pa
+ */
+static void generate(series_t type, tscomp_sample_t *s, uint32_t n) {
+    uint32_t time = 1700000000u;
+    double temp = 2500, pres = 101325;
+    for (uint32_t i = 0; i < n; i++) {
+        switch (type) {
+        case SERIES_CONSTANT:
+            time += 1;
+            break;
+        case SERIES_1S:
+            // Deriva lenta mas el ruido del sensor (0,01 C y unos 3 Pa)
+            time += 1;
+            temp += noise(100) / 2000.0;
+            pres += noise(100) / 200.0;
+            break;
+        case SERIES_10S:
+            // Periodo con jitter de la tarea y mas deriva entre muestras
+            time += 10 + (next_random() % 20 ? 0 : noise(1));
+            temp += noise(100) / 500.0;
+            pres += noise(100) / 50.0;
+            break;
+        case SERIES_NOISE:
+            time += 1 + next_random() % 4;
+            temp = 2500 + noise(32767);
+            pres = 101325 + noise(32767);
+            break;
+        default:
+            break;
+        }
+        s[i].time = time;
+        s[i].value[0] = (int32_t)lround(temp) + (type == SERIES_1S || type == SERIES_10S ? noise(1) : 0);
+        s[i].value[1] = (int32_t)lround(pres) + (type == SERIES_1S || type == SERIES_10S ? noise(3) : 0);
+    }
+}
+
+static uint8_t blocks[BLOCKS][BLOCK_SIZE];
+
+/**
+ * @brief Comprime toda la serie en bloques
+ * @return cantidad de bloques; en used, los bytes con datos
+ */
+static uint32_t compress(const tscomp_sample_t *s, uint32_t n, size_t *used) {
+    tscomp_encoder_t enc;
+    uint32_t count = 0;
+    *used = 0;
+    tscomp_encoder_init(&enc, blocks[0], BLOCK_SIZE);
+    for (uint32_t i = 0; i < n; i++) {
+        if (!tscomp_encode(&enc, &s[i])) {
+            *used += tscomp_encoder_finish(&enc);
+            tscomp_encoder_init(&enc, blocks[++count], BLOCK_SIZE);
+            tscomp_encode(&enc, &s[i]);
+        }
+    }
+    *used += tscomp_encoder_finish(&enc);
+    return count + 1;
+}
+
+static uint32_t decompress(uint32_t count, tscomp_sample_t *out) {
+    tscomp_decoder_t dec;
+    uint32_t n = 0;
+    for (uint32_t b = 0; b < count; b++) {
+        tscomp_decoder_init(&dec, blocks[b], BLOCK_SIZE);
+        while (tscomp_decode(&dec, &out[n])) { n++; }
+    }
+    return n;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(void) {
+    static tscomp_sample_t samples[SAMPLES], decoded[SAMPLES];
+
+    printf("%-18s %8s %9s %10s %9s %12s %12s\n", "serie", "bits", "muestras", "relacion", "paginas",
+           "comprimir", "descomprimir");
+    printf("%-18s %8s %9s %10s %9s %12s %12s\n", "", "/muestra", "/bloque", "", "/1000 m", "ns/muestra", "ns/muestra");
+    for (series_t type = 0; type < SERIES_COUNT; type++) {
+        generate(type, samples, SAMPLES);
+
+        size_t used = 0;
+        uint32_t count = 0;
+        double start = now_ns();
+        for (int r = 0; r < REPEAT; r++) { count = compress(samples, SAMPLES, &used); }
+        double encode_ns = (now_ns() - start) / REPEAT / SAMPLES;
+
+        uint32_t n = 0;
+        start = now_ns();
+        for (int r = 0; r < REPEAT; r++) { n = decompress(count, decoded); }
+        double decode_ns = (now_ns() - start) / REPEAT / SAMPLES;
+
+        // Ida y vuelta sin perdidas
+        CHECK_EQ(n, SAMPLES);
+        uint32_t errors = 0;
+        for (uint32_t i = 0; i < SAMPLES; i++) {
+            errors += decoded[i].time != samples[i].time || decoded[i].value[0] != samples[i].value[0] ||
+                      decoded[i].value[1] != samples[i].value[1];
+        }
+        CHECK_EQ(errors, 0);
+
+        // Relacion contra las muestras sin comprimir de 12 bytes, con los bloques completos como
+        // se guardan en la flash
+        double raw = (double)SAMPLES * sizeof(tscomp_sample_t);
+        double ratio = raw / ((double)count * BLOCK_SIZE);
+        printf("%-18s %8.1f %9.0f %9.1fx %9.2f %12.1f %12.1f\n", series_name[type], used * 8.0 / SAMPLES,
+               (double)SAMPLES / count, ratio, 1000.0 * count / SAMPLES, encode_ns, decode_ns);
+
+        if (type == SERIES_1S) { CHECK(ratio > 5.0); }
+        if (type == SERIES_CONSTANT) { CHECK(ratio > 25.0); }
+    }
+    return check_result("tscomp_bench");
+}
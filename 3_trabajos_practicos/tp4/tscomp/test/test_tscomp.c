@@ -0,0 +1,154 @@
+#include <string.h>
+
+#include "check.h"
+#include "tscomp.h"
+
+// Bloque del tamaño de los datos de una pagina de flashlog
+#define BLOCK_SIZE  248
+
+// Generador congruencial, las series son siempre las mismas
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+static uint32_t random32(void) {
+    return next_random() << 16 ^ next_random();
+}
+
+/**
+ * @brief Comprime una serie en bloques consecutivos, los descomprime y compara
+ * @return cantidad de bloques usados
+ */
+static uint32_t round_trip(const tscomp_sample_t *samples, uint32_t n) {
+    static uint8_t block[BLOCK_SIZE];
+    tscomp_encoder_t enc;
+    tscomp_decoder_t dec;
+    uint32_t blocks = 0, next = 0;
+
+    while (next < n) {
+        tscomp_encoder_init(&enc, block, sizeof(block));
+        uint32_t first = next;
+        while (next < n && tscomp_encode(&enc, &samples[next])) { next++; }
+        // Siempre entra al menos la primera muestra, sin comprimir
+        CHECK(next > first);
+        CHECK(tscomp_encoder_finish(&enc) <= sizeof(block));
+        blocks++;
+
+        CHECK_EQ(tscomp_decoder_init(&dec, block, sizeof(block)), next - first);
+        tscomp_sample_t s;
+        for (uint32_t i = first; i < next; i++) {
+            CHECK(tscomp_decode(&dec, &s));
+            CHECK_EQ(s.time, samples[i].time);
+            for (int c = 0; c < TSCOMP_CHANNELS; c++) { CHECK_EQ(s.value[c], samples[i].value[c]); }
+        }
+        CHECK(!tscomp_decode(&dec, &s));
+
+        // Con el tamaño justo tambien se lee todo
+        CHECK_EQ(tscomp_decoder_init(&dec, block, tscomp_encoder_finish(&enc)), next - first);
+        uint32_t decoded = 0;
+        while (tscomp_decode(&dec, &s)) { decoded++; }
+        CHECK_EQ(decoded, next - first);
+    }
+    return blocks;
+}
+
+// Mediciones cada un segundo con algo de ruido y algun salto en el periodo
+static void test_sensor(void) {
+    static tscomp_sample_t samples[20000];
+    uint32_t time = 1700000000u;
+    for (uint32_t i = 0; i < 20000; i++) {
+        time += next_random() % 50 ? 1 : 1 + next_random() % 10;
+        samples[i].time = time;
+        samples[i].value[0] = 2500 + (int32_t)(i / 200) % 100 + (int32_t)(next_random() % 5) - 2;
+        samples[i].value[1] = 101325 + (int32_t)(next_random() % 9) - 4;
+    }
+    CHECK(round_trip(samples, 20000) > 1);
+}
+
+// Diferencias en cada rango de los codigos y en los extremos de 32 bits
+static void test_extremes(void) {
+    static tscomp_sample_t samples[5000];
+    const uint32_t edges[] = { 0, 1, 15, 16, 255, 256, 4095, 4096, INT32_MAX, (uint32_t)INT32_MAX + 1, UINT32_MAX };
+    const int n_edges = sizeof(edges) / sizeof(edges[0]);
+
+    for (int i = 0; i < 5000; i++) {
+        // Saltos de tiempo que cambian de signo: la diferencia de diferencias da la vuelta
+        samples[i].time = (i & 1) ? edges[(i / 2) % n_edges] : edges[(i * 7) % n_edges];
+        for (int c = 0; c < TSCOMP_CHANNELS; c++) {
+            samples[i].value[c] = (int32_t)(edges[(i * (3 + c)) % n_edges] ^ (i & 2 ? 0 : UINT32_MAX));
+        }
+    }
+    round_trip(samples, 5000);
+
+    // Periodo que pasa de INT32_MAX a INT32_MIN de una muestra a otra
+    tscomp_sample_t wrap[4] = {
+        { .time = 0 }, { .time = INT32_MAX }, { .time = (uint32_t)INT32_MAX + (uint32_t)INT32_MAX + 1 }, { .time = 5 },
+    };
+    wrap[1].value[0] = INT32_MAX;
+    wrap[2].value[0] = INT32_MIN;
+    wrap[3].value[1] = INT32_MIN;
+    round_trip(wrap, 4);
+}
+
+// Muestras al azar: valores de todos los largos
+static void test_random(void) {
+    static tscomp_sample_t samples[20000];
+    for (int i = 0; i < 20000; i++) {
+        int bits = next_random() % 33;
+        uint32_t mask = bits == 32 ? UINT32_MAX : (1u << bits) - 1;
+        samples[i].time = random32() & mask;
+        for (int c = 0; c < TSCOMP_CHANNELS; c++) { samples[i].value[c] = (int32_t)(random32() & mask); }
+    }
+    round_trip(samples, 20000);
+}
+
+// Bloques chicos, llenos y corruptos
+static void test_blocks(void) {
+    uint8_t block[BLOCK_SIZE];
+    tscomp_encoder_t enc;
+    tscomp_decoder_t dec;
+    tscomp_sample_t s = { .time = 100, .value = { 1, 2 } }, out;
+
+    // La primera muestra ocupa 12 bytes mas el encabezado
+    tscomp_encoder_init(&enc, block, TSCOMP_HEADER_SIZE + 11);
+    CHECK(!tscomp_encode(&enc, &s));
+    tscomp_encoder_init(&enc, block, TSCOMP_HEADER_SIZE + 12);
+    CHECK(tscomp_encode(&enc, &s));
+    CHECK_EQ(tscomp_encoder_finish(&enc), TSCOMP_HEADER_SIZE + 12);
+    // Con periodo y valores iguales la siguiente ocupa 3 bits, que ya no entran
+    s.time++;
+    CHECK(!tscomp_encode(&enc, &s));
+
+    // Un bloque lleno se puede leer en cualquier momento
+    tscomp_encoder_init(&enc, block, sizeof(block));
+    for (int i = 0; i < 50; i++) {
+        s.time += 10;
+        CHECK(tscomp_encode(&enc, &s));
+        CHECK_EQ(tscomp_decoder_init(&dec, block, sizeof(block)), i + 1);
+    }
+
+    // Un encabezado con mas muestras que datos corta la lectura en el borde del bloque
+    size_t used = tscomp_encoder_finish(&enc);
+    block[0] = 0xFF;
+    block[1] = 0xFF;
+    uint32_t decoded = 0;
+    tscomp_decoder_init(&dec, block, used);
+    while (tscomp_decode(&dec, &out)) { decoded++; }
+    CHECK(decoded >= 50 && decoded < 0xFFFF);
+    CHECK(!tscomp_decode(&dec, &out));
+
+    // Menos que el encabezado: ninguna muestra
+    CHECK_EQ(tscomp_decoder_init(&dec, block, 1), 0);
+    CHECK(!tscomp_decode(&dec, &out));
+}
+
+int main(void) {
+    test_sensor();
+    test_extremes();
+    test_random();
+    test_blocks();
+    return check_result("tscomp");
+}
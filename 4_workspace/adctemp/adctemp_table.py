@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+"""Genera la tabla de cuentas del ADC a centesimas de grado del sensor interno.
+
+Uso:
+    adctemp_table.py src/adctemp_table.c
+    adctemp_table.py src/adctemp_table.c --vref 3.3 --v27 0.706 --slope 0.001721
+"""
+
+import argparse
+import math
+import sys
+
+CODES = 4096
+
+
+def centi(code, vref, v27, slope):
+    """Temperatura en centesimas de grado, redondeada lejos del cero como lroundf."""
+    temperature = 27.0 - (code * vref / CODES - v27) / slope
+    value = temperature * 100.0
+    return int(math.copysign(math.floor(abs(value) + 0.5), value))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("output", help="archivo C a generar")
+    parser.add_argument("--vref", type=float, default=3.3, help="tension de referencia del ADC en V")
+    parser.add_argument("--v27", type=float, default=0.706, help="tension del sensor a 27 grados en V")
+    parser.add_argument("--slope", type=float, default=0.001721, help="pendiente del sensor en V por grado")
+    args = parser.parse_args()
+
+    values = [centi(code, args.vref, args.v27, args.slope) for code in range(CODES)]
+    lines = []
+    for start in range(0, CODES, 8):
+        lines.append("    " + ", ".join("%7d" % v for v in values[start:start + 8]) + ",")
+
+    with open(args.output, "w") as out:
+        out.write("// Generado por adctemp_table.py, no editar\n")
+        out.write("// T = 27 - (cuentas * %g / %d - %g) / %g, en centesimas de grado\n\n" %
+                  (args.vref, CODES, args.v27, args.slope))
+        out.write('#include "adctemp.h"\n\n')
+        out.write("const int32_t adctemp_table[ADCTEMP_CODES] = {\n")
+        out.write("\n".join(lines) + "\n")
+        out.write("};\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
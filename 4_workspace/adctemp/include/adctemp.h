@@ -0,0 +1,44 @@
+#ifndef _ADCTEMP_H_
+#define _ADCTEMP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Cuentas del ADC de 12 bits
+#define ADCTEMP_CODES           4096
+// Ganancia unitaria de la calibracion, la ganancia va en Q14
+#define ADCTEMP_GAIN_ONE        (1 << 14)
+// Marca de una calibracion grabada, "ADCT"
+#define ADCTEMP_CAL_MAGIC       0x54434441u
+
+/**
+ * @brief Calibracion del sensor de cada placa: T = T_tabla * gain + offset
+ */
+typedef struct {
+    uint32_t magic;             // ADCTEMP_CAL_MAGIC
+    int32_t offset;             // Desplazamiento en centesimas de grado
+    int32_t gain;               // Ganancia en Q14
+    uint32_t check;             // ~(magic ^ offset ^ gain)
+} adctemp_cal_t;
+
+// Tabla de cuentas a centesimas de grado, la genera adctemp_table.py
+extern const int32_t adctemp_table[ADCTEMP_CODES];
+// Calibracion en uso, la carga adctemp_init
+extern adctemp_cal_t adctemp_cal;
+
+/**
+ * @brief Convierte una lectura del ADC a temperatura con la tabla y la calibracion
+ * @param raw cuentas del ADC, el bit de error se ignora
+ * @return temperatura en centesimas de grado
+ */
+static inline int32_t adctemp_centi(uint32_t raw) {
+    int64_t t = adctemp_table[raw & (ADCTEMP_CODES - 1)];
+    return (int32_t)((t * adctemp_cal.gain + (ADCTEMP_GAIN_ONE >> 1)) >> 14) + adctemp_cal.offset;
+}
+
+// Prototipos de funciones
+void adctemp_init(void);
+int32_t adctemp_centi_interp(uint32_t code, uint32_t bits);
+bool adctemp_cal_save(int32_t offset, int32_t gain);
+
+#endif
@@ -0,0 +1,98 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "hardware/interp.h"
+#include "hardware/sync.h"
+
+#include "adctemp.h"
+
+// Sector de la flash con la calibracion, por defecto el ultimo
+#ifndef ADCTEMP_CAL_OFFSET
+#define ADCTEMP_CAL_OFFSET      (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#endif
+// Espera maxima para tomar la flash al grabar
+#define ADCTEMP_CAL_TIMEOUT_MS  100
+
+// Sin calibracion grabada la tabla se usa tal cual
+adctemp_cal_t adctemp_cal = {
+    ADCTEMP_CAL_MAGIC, 0, ADCTEMP_GAIN_ONE, ~(ADCTEMP_CAL_MAGIC ^ 0u ^ (uint32_t)ADCTEMP_GAIN_ONE)
+};
+
+// Configuracion del interpolador: carril 0 en modo mezcla, carril 1 con signo
+static interp_config adctemp_lane0, adctemp_lane1;
+
+/**
+ * @brief Verifica una calibracion
+ */
+static bool adctemp_cal_valid(const adctemp_cal_t *cal) {
+    return cal->magic == ADCTEMP_CAL_MAGIC && cal->check == ~(cal->magic ^ (uint32_t)cal->offset ^ (uint32_t)cal->gain);
+}
+
+/**
+ * @brief Carga la calibracion de la flash, si hay una grabada, y prepara la
+ * configuracion del interpolador
+ */
+void adctemp_init(void) {
+    const adctemp_cal_t *stored = (const adctemp_cal_t *)(XIP_BASE + ADCTEMP_CAL_OFFSET);
+    if (adctemp_cal_valid(stored)) { adctemp_cal = *stored; }
+
+    adctemp_lane0 = interp_default_config();
+    interp_config_set_blend(&adctemp_lane0, true);
+    adctemp_lane1 = interp_default_config();
+    interp_config_set_signed(&adctemp_lane1, true);
+}
+
+/**
+ * @brief Convierte un promedio con bits fraccionarios interpolando entre dos
+ * valores de la tabla con el interpolador 0 del nucleo en modo mezcla, el unico
+ * que lo tiene:
+ * T = T[i] + (T[i + 1] - T[i]) * frac / 256
+ * @param code cuentas del ADC con bits fraccionarios, por ejemplo la suma de 4 lecturas con bits = 2
+ * @param bits cantidad de bits fraccionarios, hasta 8
+ * @return temperatura en centesimas de grado
+ */
+int32_t adctemp_centi_interp(uint32_t code, uint32_t bits) {
+    uint32_t index = code >> bits;
+    uint32_t frac = (code << (8 - bits)) & 0xFF;
+    if (index >= ADCTEMP_CODES - 1) { return adctemp_centi(ADCTEMP_CODES - 1); }
+
+    // El interpolador no se guarda en los cambios de contexto, se usa con las interrupciones deshabilitadas
+    uint32_t irq = save_and_disable_interrupts();
+    interp_set_config(interp0, 0, &adctemp_lane0);
+    interp_set_config(interp0, 1, &adctemp_lane1);
+    interp0->accum[1] = frac;
+    // Con los valores por 256 la mezcla no trunca, se redondea una sola vez al final
+    interp0->base[0] = (uint32_t)(adctemp_table[index] * 256);
+    interp0->base[1] = (uint32_t)(adctemp_table[index + 1] * 256);
+    int64_t t = (int32_t)interp0->peek[1];
+    restore_interrupts(irq);
+
+    return (int32_t)((t * adctemp_cal.gain + (ADCTEMP_GAIN_ONE << 7)) >> 22) + adctemp_cal.offset;
+}
+
+/**
+ * @brief Borra el sector y graba la pagina, sin interrupciones ni acceso XIP
+ * @param param pagina a grabar
+ */
+static void adctemp_program(void *param) {
+    flash_range_erase(ADCTEMP_CAL_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(ADCTEMP_CAL_OFFSET, param, FLASH_PAGE_SIZE);
+}
+
+/**
+ * @brief Graba la calibracion de la placa en la flash y la aplica
+ * @param offset desplazamiento en centesimas de grado
+ * @param gain ganancia en Q14, ADCTEMP_GAIN_ONE es 1
+ * @return true si se pudo grabar
+ */
+bool adctemp_cal_save(int32_t offset, int32_t gain) {
+    static uint8_t page[FLASH_PAGE_SIZE];
+    adctemp_cal_t cal = { ADCTEMP_CAL_MAGIC, offset, gain, ~(ADCTEMP_CAL_MAGIC ^ (uint32_t)offset ^ (uint32_t)gain) };
+
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page, &cal, sizeof(cal));
+    if (flash_safe_execute(adctemp_program, page, ADCTEMP_CAL_TIMEOUT_MS) != PICO_OK) { return false; }
+    adctemp_cal = cal;
+    return true;
+}
@@ -0,0 +1,519 @@
+// Generado por adctemp_table.py, no editar
+// T = 27 - (cuentas * 3.3 / 4096 - 0.706) / 0.001721, en centesimas de grado
+
+#include "adctemp.h"
+
+const int32_t adctemp_table[ADCTEMP_CODES] = {
+      43723,   43676,   43629,   43582,   43535,   43489,   43442,   43395,
+      43348,   43301,   43255,   43208,   43161,   43114,   43067,   43020,
+      42974,   42927,   42880,   42833,   42786,   42740,   42693,   42646,
+      42599,   42552,   42506,   42459,   42412,   42365,   42318,   42271,
+      42225,   42178,   42131,   42084,   42037,   41991,   41944,   41897,
+      41850,   41803,   41756,   41710,   41663,   41616,   41569,   41522,
+      41476,   41429,   41382,   41335,   41288,   41242,   41195,   41148,
+      41101,   41054,   41007,   40961,   40914,   40867,   40820,   40773,
+      40727,   40680,   40633,   40586,   40539,   40493,   40446,   40399,
+      40352,   40305,   40258,   40212,   40165,   40118,   40071,   40024,
+      39978,   39931,   39884,   39837,   39790,   39743,   39697,   39650,
+      39603,   39556,   39509,   39463,   39416,   39369,   39322,   39275,
+      39229,   39182,   39135,   39088,   39041,   38994,   38948,   38901,
+      38854,   38807,   38760,   38714,   38667,   38620,   38573,   38526,
+      38480,   38433,   38386,   38339,   38292,   38245,   38199,   38152,
+      38105,   38058,   38011,   37965,   37918,   37871,   37824,   37777,
+      37731,   37684,   37637,   37590,   37543,   37496,   37450,   37403,
+      37356,   37309,   37262,   37216,   37169,   37122,   37075,   37028,
+      36981,   36935,   36888,   36841,   36794,   36747,   36701,   36654,
+      36607,   36560,   36513,   36467,   36420,   36373,   36326,   36279,
+      36232,   36186,   36139,   36092,   36045,   35998,   35952,   35905,
+      35858,   35811,   35764,   35718,   35671,   35624,   35577,   35530,
+      35483,   35437,   35390,   35343,   35296,   35249,   35203,   35156,
+      35109,   35062,   35015,   34968,   34922,   34875,   34828,   34781,
+      34734,   34688,   34641,   34594,   34547,   34500,   34454,   34407,
+      34360,   34313,   34266,   34219,   34173,   34126,   34079,   34032,
+      33985,   33939,   33892,   33845,   33798,   33751,   33705,   33658,
+      33611,   33564,   33517,   33470,   33424,   33377,   33330,   33283,
+      33236,   33190,   33143,   33096,   33049,   33002,   32956,   32909,
+      32862,   32815,   32768,   32721,   32675,   32628,   32581,   32534,
+      32487,   32441,   32394,   32347,   32300,   32253,   32206,   32160,
+      32113,   32066,   32019,   31972,   31926,   31879,   31832,   31785,
+      31738,   31692,   31645,   31598,   31551,   31504,   31457,   31411,
+      31364,   31317,   31270,   31223,   31177,   31130,   31083,   31036,
+      30989,   30943,   30896,   30849,   30802,   30755,   30708,   30662,
+      30615,   30568,   30521,   30474,   30428,   30381,   30334,   30287,
+      30240,   30193,   30147,   30100,   30053,   30006,   29959,   29913,
+      29866,   29819,   29772,   29725,   29679,   29632,   29585,   29538,
+      29491,   29444,   29398,   29351,   29304,   29257,   29210,   29164,
+      29117,   29070,   29023,   28976,   28930,   28883,   28836,   28789,
+      28742,   28695,   28649,   28602,   28555,   28508,   28461,   28415,
+      28368,   28321,   28274,   28227,   28181,   28134,   28087,   28040,
+      27993,   27946,   27900,   27853,   27806,   27759,   27712,   27666,
+      27619,   27572,   27525,   27478,   27431,   27385,   27338,   27291,
+      27244,   27197,   27151,   27104,   27057,   27010,   26963,   26917,
+      26870,   26823,   26776,   26729,   26682,   26636,   26589,   26542,
+      26495,   26448,   26402,   26355,   26308,   26261,   26214,   26168,
+      26121,   26074,   26027,   25980,   25933,   25887,   25840,   25793,
+      25746,   25699,   25653,   25606,   25559,   25512,   25465,   25418,
+      25372,   25325,   25278,   25231,   25184,   25138,   25091,   25044,
+      24997,   24950,   24904,   24857,   24810,   24763,   24716,   24669,
+      24623,   24576,   24529,   24482,   24435,   24389,   24342,   24295,
+      24248,   24201,   24155,   24108,   24061,   24014,   23967,   23920,
+      23874,   23827,   23780,   23733,   23686,   23640,   23593,   23546,
+      23499,   23452,   23406,   23359,   23312,   23265,   23218,   23171,
+      23125,   23078,   23031,   22984,   22937,   22891,   22844,   22797,
+      22750,   22703,   22656,   22610,   22563,   22516,   22469,   22422,
+      22376,   22329,   22282,   22235,   22188,   22142,   22095,   22048,
+      22001,   21954,   21907,   21861,   21814,   21767,   21720,   21673,
+      21627,   21580,   21533,   21486,   21439,   21393,   21346,   21299,
+      21252,   21205,   21158,   21112,   21065,   21018,   20971,   20924,
+      20878,   20831,   20784,   20737,   20690,   20643,   20597,   20550,
+      20503,   20456,   20409,   20363,   20316,   20269,   20222,   20175,
+      20129,   20082,   20035,   19988,   19941,   19894,   19848,   19801,
+      19754,   19707,   19660,   19614,   19567,   19520,   19473,   19426,
+      19380,   19333,   19286,   19239,   19192,   19145,   19099,   19052,
+      19005,   18958,   18911,   18865,   18818,   18771,   18724,   18677,
+      18631,   18584,   18537,   18490,   18443,   18396,   18350,   18303,
+      18256,   18209,   18162,   18116,   18069,   18022,   17975,   17928,
+      17881,   17835,   17788,   17741,   17694,   17647,   17601,   17554,
+      17507,   17460,   17413,   17367,   17320,   17273,   17226,   17179,
+      17132,   17086,   17039,   16992,   16945,   16898,   16852,   16805,
+      16758,   16711,   16664,   16618,   16571,   16524,   16477,   16430,
+      16383,   16337,   16290,   16243,   16196,   16149,   16103,   16056,
+      16009,   15962,   15915,   15868,   15822,   15775,   15728,   15681,
+      15634,   15588,   15541,   15494,   15447,   15400,   15354,   15307,
+      15260,   15213,   15166,   15119,   15073,   15026,   14979,   14932,
+      14885,   14839,   14792,   14745,   14698,   14651,   14605,   14558,
+      14511,   14464,   14417,   14370,   14324,   14277,   14230,   14183,
+      14136,   14090,   14043,   13996,   13949,   13902,   13856,   13809,
+      13762,   13715,   13668,   13621,   13575,   13528,   13481,   13434,
+      13387,   13341,   13294,   13247,   13200,   13153,   13106,   13060,
+      13013,   12966,   12919,   12872,   12826,   12779,   12732,   12685,
+      12638,   12592,   12545,   12498,   12451,   12404,   12357,   12311,
+      12264,   12217,   12170,   12123,   12077,   12030,   11983,   11936,
+      11889,   11843,   11796,   11749,   11702,   11655,   11608,   11562,
+      11515,   11468,   11421,   11374,   11328,   11281,   11234,   11187,
+      11140,   11094,   11047,   11000,   10953,   10906,   10859,   10813,
+      10766,   10719,   10672,   10625,   10579,   10532,   10485,   10438,
+      10391,   10344,   10298,   10251,   10204,   10157,   10110,   10064,
+      10017,    9970,    9923,    9876,    9830,    9783,    9736,    9689,
+       9642,    9595,    9549,    9502,    9455,    9408,    9361,    9315,
+       9268,    9221,    9174,    9127,    9081,    9034,    8987,    8940,
+       8893,    8846,    8800,    8753,    8706,    8659,    8612,    8566,
+       8519,    8472,    8425,    8378,    8331,    8285,    8238,    8191,
+       8144,    8097,    8051,    8004,    7957,    7910,    7863,    7817,
+       7770,    7723,    7676,    7629,    7582,    7536,    7489,    7442,
+       7395,    7348,    7302,    7255,    7208,    7161,    7114,    7068,
+       7021,    6974,    6927,    6880,    6833,    6787,    6740,    6693,
+       6646,    6599,    6553,    6506,    6459,    6412,    6365,    6319,
+       6272,    6225,    6178,    6131,    6084,    6038,    5991,    5944,
+       5897,    5850,    5804,    5757,    5710,    5663,    5616,    5569,
+       5523,    5476,    5429,    5382,    5335,    5289,    5242,    5195,
+       5148,    5101,    5055,    5008,    4961,    4914,    4867,    4820,
+       4774,    4727,    4680,    4633,    4586,    4540,    4493,    4446,
+       4399,    4352,    4306,    4259,    4212,    4165,    4118,    4071,
+       4025,    3978,    3931,    3884,    3837,    3791,    3744,    3697,
+       3650,    3603,    3556,    3510,    3463,    3416,    3369,    3322,
+       3276,    3229,    3182,    3135,    3088,    3042,    2995,    2948,
+       2901,    2854,    2807,    2761,    2714,    2667,    2620,    2573,
+       2527,    2480,    2433,    2386,    2339,    2293,    2246,    2199,
+       2152,    2105,    2058,    2012,    1965,    1918,    1871,    1824,
+       1778,    1731,    1684,    1637,    1590,    1544,    1497,    1450,
+       1403,    1356,    1309,    1263,    1216,    1169,    1122,    1075,
+       1029,     982,     935,     888,     841,     794,     748,     701,
+        654,     607,     560,     514,     467,     420,     373,     326,
+        280,     233,     186,     139,      92,      45,      -1,     -48,
+        -95,    -142,    -189,    -235,    -282,    -329,    -376,    -423,
+       -469,    -516,    -563,    -610,    -657,    -704,    -750,    -797,
+       -844,    -891,    -938,    -984,   -1031,   -1078,   -1125,   -1172,
+      -1219,   -1265,   -1312,   -1359,   -1406,   -1453,   -1499,   -1546,
+      -1593,   -1640,   -1687,   -1733,   -1780,   -1827,   -1874,   -1921,
+      -1968,   -2014,   -2061,   -2108,   -2155,   -2202,   -2248,   -2295,
+      -2342,   -2389,   -2436,   -2482,   -2529,   -2576,   -2623,   -2670,
+      -2717,   -2763,   -2810,   -2857,   -2904,   -2951,   -2997,   -3044,
+      -3091,   -3138,   -3185,   -3231,   -3278,   -3325,   -3372,   -3419,
+      -3466,   -3512,   -3559,   -3606,   -3653,   -3700,   -3746,   -3793,
+      -3840,   -3887,   -3934,   -3981,   -4027,   -4074,   -4121,   -4168,
+      -4215,   -4261,   -4308,   -4355,   -4402,   -4449,   -4495,   -4542,
+      -4589,   -4636,   -4683,   -4730,   -4776,   -4823,   -4870,   -4917,
+      -4964,   -5010,   -5057,   -5104,   -5151,   -5198,   -5244,   -5291,
+      -5338,   -5385,   -5432,   -5479,   -5525,   -5572,   -5619,   -5666,
+      -5713,   -5759,   -5806,   -5853,   -5900,   -5947,   -5994,   -6040,
+      -6087,   -6134,   -6181,   -6228,   -6274,   -6321,   -6368,   -6415,
+      -6462,   -6508,   -6555,   -6602,   -6649,   -6696,   -6743,   -6789,
+      -6836,   -6883,   -6930,   -6977,   -7023,   -7070,   -7117,   -7164,
+      -7211,   -7257,   -7304,   -7351,   -7398,   -7445,   -7492,   -7538,
+      -7585,   -7632,   -7679,   -7726,   -7772,   -7819,   -7866,   -7913,
+      -7960,   -8006,   -8053,   -8100,   -8147,   -8194,   -8241,   -8287,
+      -8334,   -8381,   -8428,   -8475,   -8521,   -8568,   -8615,   -8662,
+      -8709,   -8756,   -8802,   -8849,   -8896,   -8943,   -8990,   -9036,
+      -9083,   -9130,   -9177,   -9224,   -9270,   -9317,   -9364,   -9411,
+      -9458,   -9505,   -9551,   -9598,   -9645,   -9692,   -9739,   -9785,
+      -9832,   -9879,   -9926,   -9973,  -10019,  -10066,  -10113,  -10160,
+     -10207,  -10254,  -10300,  -10347,  -10394,  -10441,  -10488,  -10534,
+     -10581,  -10628,  -10675,  -10722,  -10769,  -10815,  -10862,  -10909,
+     -10956,  -11003,  -11049,  -11096,  -11143,  -11190,  -11237,  -11283,
+     -11330,  -11377,  -11424,  -11471,  -11518,  -11564,  -11611,  -11658,
+     -11705,  -11752,  -11798,  -11845,  -11892,  -11939,  -11986,  -12032,
+     -12079,  -12126,  -12173,  -12220,  -12267,  -12313,  -12360,  -12407,
+     -12454,  -12501,  -12547,  -12594,  -12641,  -12688,  -12735,  -12781,
+     -12828,  -12875,  -12922,  -12969,  -13016,  -13062,  -13109,  -13156,
+     -13203,  -13250,  -13296,  -13343,  -13390,  -13437,  -13484,  -13531,
+     -13577,  -13624,  -13671,  -13718,  -13765,  -13811,  -13858,  -13905,
+     -13952,  -13999,  -14045,  -14092,  -14139,  -14186,  -14233,  -14280,
+     -14326,  -14373,  -14420,  -14467,  -14514,  -14560,  -14607,  -14654,
+     -14701,  -14748,  -14794,  -14841,  -14888,  -14935,  -14982,  -15029,
+     -15075,  -15122,  -15169,  -15216,  -15263,  -15309,  -15356,  -15403,
+     -15450,  -15497,  -15544,  -15590,  -15637,  -15684,  -15731,  -15778,
+     -15824,  -15871,  -15918,  -15965,  -16012,  -16058,  -16105,  -16152,
+     -16199,  -16246,  -16293,  -16339,  -16386,  -16433,  -16480,  -16527,
+     -16573,  -16620,  -16667,  -16714,  -16761,  -16807,  -16854,  -16901,
+     -16948,  -16995,  -17042,  -17088,  -17135,  -17182,  -17229,  -17276,
+     -17322,  -17369,  -17416,  -17463,  -17510,  -17556,  -17603,  -17650,
+     -17697,  -17744,  -17791,  -17837,  -17884,  -17931,  -17978,  -18025,
+     -18071,  -18118,  -18165,  -18212,  -18259,  -18306,  -18352,  -18399,
+     -18446,  -18493,  -18540,  -18586,  -18633,  -18680,  -18727,  -18774,
+     -18820,  -18867,  -18914,  -18961,  -19008,  -19055,  -19101,  -19148,
+     -19195,  -19242,  -19289,  -19335,  -19382,  -19429,  -19476,  -19523,
+     -19569,  -19616,  -19663,  -19710,  -19757,  -19804,  -19850,  -19897,
+     -19944,  -19991,  -20038,  -20084,  -20131,  -20178,  -20225,  -20272,
+     -20319,  -20365,  -20412,  -20459,  -20506,  -20553,  -20599,  -20646,
+     -20693,  -20740,  -20787,  -20833,  -20880,  -20927,  -20974,  -21021,
+     -21068,  -21114,  -21161,  -21208,  -21255,  -21302,  -21348,  -21395,
+     -21442,  -21489,  -21536,  -21582,  -21629,  -21676,  -21723,  -21770,
+     -21817,  -21863,  -21910,  -21957,  -22004,  -22051,  -22097,  -22144,
+     -22191,  -22238,  -22285,  -22331,  -22378,  -22425,  -22472,  -22519,
+     -22566,  -22612,  -22659,  -22706,  -22753,  -22800,  -22846,  -22893,
+     -22940,  -22987,  -23034,  -23081,  -23127,  -23174,  -23221,  -23268,
+     -23315,  -23361,  -23408,  -23455,  -23502,  -23549,  -23595,  -23642,
+     -23689,  -23736,  -23783,  -23830,  -23876,  -23923,  -23970,  -24017,
+     -24064,  -24110,  -24157,  -24204,  -24251,  -24298,  -24344,  -24391,
+     -24438,  -24485,  -24532,  -24579,  -24625,  -24672,  -24719,  -24766,
+     -24813,  -24859,  -24906,  -24953,  -25000,  -25047,  -25094,  -25140,
+     -25187,  -25234,  -25281,  -25328,  -25374,  -25421,  -25468,  -25515,
+     -25562,  -25608,  -25655,  -25702,  -25749,  -25796,  -25843,  -25889,
+     -25936,  -25983,  -26030,  -26077,  -26123,  -26170,  -26217,  -26264,
+     -26311,  -26357,  -26404,  -26451,  -26498,  -26545,  -26592,  -26638,
+     -26685,  -26732,  -26779,  -26826,  -26872,  -26919,  -26966,  -27013,
+     -27060,  -27106,  -27153,  -27200,  -27247,  -27294,  -27341,  -27387,
+     -27434,  -27481,  -27528,  -27575,  -27621,  -27668,  -27715,  -27762,
+     -27809,  -27856,  -27902,  -27949,  -27996,  -28043,  -28090,  -28136,
+     -28183,  -28230,  -28277,  -28324,  -28370,  -28417,  -28464,  -28511,
+     -28558,  -28605,  -28651,  -28698,  -28745,  -28792,  -28839,  -28885,
+     -28932,  -28979,  -29026,  -29073,  -29119,  -29166,  -29213,  -29260,
+     -29307,  -29354,  -29400,  -29447,  -29494,  -29541,  -29588,  -29634,
+     -29681,  -29728,  -29775,  -29822,  -29869,  -29915,  -29962,  -30009,
+     -30056,  -30103,  -30149,  -30196,  -30243,  -30290,  -30337,  -30383,
+     -30430,  -30477,  -30524,  -30571,  -30618,  -30664,  -30711,  -30758,
+     -30805,  -30852,  -30898,  -30945,  -30992,  -31039,  -31086,  -31132,
+     -31179,  -31226,  -31273,  -31320,  -31367,  -31413,  -31460,  -31507,
+     -31554,  -31601,  -31647,  -31694,  -31741,  -31788,  -31835,  -31881,
+     -31928,  -31975,  -32022,  -32069,  -32116,  -32162,  -32209,  -32256,
+     -32303,  -32350,  -32396,  -32443,  -32490,  -32537,  -32584,  -32631,
+     -32677,  -32724,  -32771,  -32818,  -32865,  -32911,  -32958,  -33005,
+     -33052,  -33099,  -33145,  -33192,  -33239,  -33286,  -33333,  -33380,
+     -33426,  -33473,  -33520,  -33567,  -33614,  -33660,  -33707,  -33754,
+     -33801,  -33848,  -33894,  -33941,  -33988,  -34035,  -34082,  -34129,
+     -34175,  -34222,  -34269,  -34316,  -34363,  -34409,  -34456,  -34503,
+     -34550,  -34597,  -34644,  -34690,  -34737,  -34784,  -34831,  -34878,
+     -34924,  -34971,  -35018,  -35065,  -35112,  -35158,  -35205,  -35252,
+     -35299,  -35346,  -35393,  -35439,  -35486,  -35533,  -35580,  -35627,
+     -35673,  -35720,  -35767,  -35814,  -35861,  -35907,  -35954,  -36001,
+     -36048,  -36095,  -36142,  -36188,  -36235,  -36282,  -36329,  -36376,
+     -36422,  -36469,  -36516,  -36563,  -36610,  -36656,  -36703,  -36750,
+     -36797,  -36844,  -36891,  -36937,  -36984,  -37031,  -37078,  -37125,
+     -37171,  -37218,  -37265,  -37312,  -37359,  -37406,  -37452,  -37499,
+     -37546,  -37593,  -37640,  -37686,  -37733,  -37780,  -37827,  -37874,
+     -37920,  -37967,  -38014,  -38061,  -38108,  -38155,  -38201,  -38248,
+     -38295,  -38342,  -38389,  -38435,  -38482,  -38529,  -38576,  -38623,
+     -38669,  -38716,  -38763,  -38810,  -38857,  -38904,  -38950,  -38997,
+     -39044,  -39091,  -39138,  -39184,  -39231,  -39278,  -39325,  -39372,
+     -39418,  -39465,  -39512,  -39559,  -39606,  -39653,  -39699,  -39746,
+     -39793,  -39840,  -39887,  -39933,  -39980,  -40027,  -40074,  -40121,
+     -40168,  -40214,  -40261,  -40308,  -40355,  -40402,  -40448,  -40495,
+     -40542,  -40589,  -40636,  -40682,  -40729,  -40776,  -40823,  -40870,
+     -40917,  -40963,  -41010,  -41057,  -41104,  -41151,  -41197,  -41244,
+     -41291,  -41338,  -41385,  -41431,  -41478,  -41525,  -41572,  -41619,
+     -41666,  -41712,  -41759,  -41806,  -41853,  -41900,  -41946,  -41993,
+     -42040,  -42087,  -42134,  -42181,  -42227,  -42274,  -42321,  -42368,
+     -42415,  -42461,  -42508,  -42555,  -42602,  -42649,  -42695,  -42742,
+     -42789,  -42836,  -42883,  -42930,  -42976,  -43023,  -43070,  -43117,
+     -43164,  -43210,  -43257,  -43304,  -43351,  -43398,  -43444,  -43491,
+     -43538,  -43585,  -43632,  -43679,  -43725,  -43772,  -43819,  -43866,
+     -43913,  -43959,  -44006,  -44053,  -44100,  -44147,  -44193,  -44240,
+     -44287,  -44334,  -44381,  -44428,  -44474,  -44521,  -44568,  -44615,
+     -44662,  -44708,  -44755,  -44802,  -44849,  -44896,  -44943,  -44989,
+     -45036,  -45083,  -45130,  -45177,  -45223,  -45270,  -45317,  -45364,
+     -45411,  -45457,  -45504,  -45551,  -45598,  -45645,  -45692,  -45738,
+     -45785,  -45832,  -45879,  -45926,  -45972,  -46019,  -46066,  -46113,
+     -46160,  -46206,  -46253,  -46300,  -46347,  -46394,  -46441,  -46487,
+     -46534,  -46581,  -46628,  -46675,  -46721,  -46768,  -46815,  -46862,
+     -46909,  -46956,  -47002,  -47049,  -47096,  -47143,  -47190,  -47236,
+     -47283,  -47330,  -47377,  -47424,  -47470,  -47517,  -47564,  -47611,
+     -47658,  -47705,  -47751,  -47798,  -47845,  -47892,  -47939,  -47985,
+     -48032,  -48079,  -48126,  -48173,  -48219,  -48266,  -48313,  -48360,
+     -48407,  -48454,  -48500,  -48547,  -48594,  -48641,  -48688,  -48734,
+     -48781,  -48828,  -48875,  -48922,  -48968,  -49015,  -49062,  -49109,
+     -49156,  -49203,  -49249,  -49296,  -49343,  -49390,  -49437,  -49483,
+     -49530,  -49577,  -49624,  -49671,  -49718,  -49764,  -49811,  -49858,
+     -49905,  -49952,  -49998,  -50045,  -50092,  -50139,  -50186,  -50232,
+     -50279,  -50326,  -50373,  -50420,  -50467,  -50513,  -50560,  -50607,
+     -50654,  -50701,  -50747,  -50794,  -50841,  -50888,  -50935,  -50981,
+     -51028,  -51075,  -51122,  -51169,  -51216,  -51262,  -51309,  -51356,
+     -51403,  -51450,  -51496,  -51543,  -51590,  -51637,  -51684,  -51731,
+     -51777,  -51824,  -51871,  -51918,  -51965,  -52011,  -52058,  -52105,
+     -52152,  -52199,  -52245,  -52292,  -52339,  -52386,  -52433,  -52480,
+     -52526,  -52573,  -52620,  -52667,  -52714,  -52760,  -52807,  -52854,
+     -52901,  -52948,  -52994,  -53041,  -53088,  -53135,  -53182,  -53229,
+     -53275,  -53322,  -53369,  -53416,  -53463,  -53509,  -53556,  -53603,
+     -53650,  -53697,  -53743,  -53790,  -53837,  -53884,  -53931,  -53978,
+     -54024,  -54071,  -54118,  -54165,  -54212,  -54258,  -54305,  -54352,
+     -54399,  -54446,  -54493,  -54539,  -54586,  -54633,  -54680,  -54727,
+     -54773,  -54820,  -54867,  -54914,  -54961,  -55007,  -55054,  -55101,
+     -55148,  -55195,  -55242,  -55288,  -55335,  -55382,  -55429,  -55476,
+     -55522,  -55569,  -55616,  -55663,  -55710,  -55756,  -55803,  -55850,
+     -55897,  -55944,  -55991,  -56037,  -56084,  -56131,  -56178,  -56225,
+     -56271,  -56318,  -56365,  -56412,  -56459,  -56506,  -56552,  -56599,
+     -56646,  -56693,  -56740,  -56786,  -56833,  -56880,  -56927,  -56974,
+     -57020,  -57067,  -57114,  -57161,  -57208,  -57255,  -57301,  -57348,
+     -57395,  -57442,  -57489,  -57535,  -57582,  -57629,  -57676,  -57723,
+     -57769,  -57816,  -57863,  -57910,  -57957,  -58004,  -58050,  -58097,
+     -58144,  -58191,  -58238,  -58284,  -58331,  -58378,  -58425,  -58472,
+     -58518,  -58565,  -58612,  -58659,  -58706,  -58753,  -58799,  -58846,
+     -58893,  -58940,  -58987,  -59033,  -59080,  -59127,  -59174,  -59221,
+     -59268,  -59314,  -59361,  -59408,  -59455,  -59502,  -59548,  -59595,
+     -59642,  -59689,  -59736,  -59782,  -59829,  -59876,  -59923,  -59970,
+     -60017,  -60063,  -60110,  -60157,  -60204,  -60251,  -60297,  -60344,
+     -60391,  -60438,  -60485,  -60531,  -60578,  -60625,  -60672,  -60719,
+     -60766,  -60812,  -60859,  -60906,  -60953,  -61000,  -61046,  -61093,
+     -61140,  -61187,  -61234,  -61281,  -61327,  -61374,  -61421,  -61468,
+     -61515,  -61561,  -61608,  -61655,  -61702,  -61749,  -61795,  -61842,
+     -61889,  -61936,  -61983,  -62030,  -62076,  -62123,  -62170,  -62217,
+     -62264,  -62310,  -62357,  -62404,  -62451,  -62498,  -62544,  -62591,
+     -62638,  -62685,  -62732,  -62779,  -62825,  -62872,  -62919,  -62966,
+     -63013,  -63059,  -63106,  -63153,  -63200,  -63247,  -63293,  -63340,
+     -63387,  -63434,  -63481,  -63528,  -63574,  -63621,  -63668,  -63715,
+     -63762,  -63808,  -63855,  -63902,  -63949,  -63996,  -64043,  -64089,
+     -64136,  -64183,  -64230,  -64277,  -64323,  -64370,  -64417,  -64464,
+     -64511,  -64557,  -64604,  -64651,  -64698,  -64745,  -64792,  -64838,
+     -64885,  -64932,  -64979,  -65026,  -65072,  -65119,  -65166,  -65213,
+     -65260,  -65306,  -65353,  -65400,  -65447,  -65494,  -65541,  -65587,
+     -65634,  -65681,  -65728,  -65775,  -65821,  -65868,  -65915,  -65962,
+     -66009,  -66056,  -66102,  -66149,  -66196,  -66243,  -66290,  -66336,
+     -66383,  -66430,  -66477,  -66524,  -66570,  -66617,  -66664,  -66711,
+     -66758,  -66805,  -66851,  -66898,  -66945,  -66992,  -67039,  -67085,
+     -67132,  -67179,  -67226,  -67273,  -67319,  -67366,  -67413,  -67460,
+     -67507,  -67554,  -67600,  -67647,  -67694,  -67741,  -67788,  -67834,
+     -67881,  -67928,  -67975,  -68022,  -68068,  -68115,  -68162,  -68209,
+     -68256,  -68303,  -68349,  -68396,  -68443,  -68490,  -68537,  -68583,
+     -68630,  -68677,  -68724,  -68771,  -68818,  -68864,  -68911,  -68958,
+     -69005,  -69052,  -69098,  -69145,  -69192,  -69239,  -69286,  -69332,
+     -69379,  -69426,  -69473,  -69520,  -69567,  -69613,  -69660,  -69707,
+     -69754,  -69801,  -69847,  -69894,  -69941,  -69988,  -70035,  -70081,
+     -70128,  -70175,  -70222,  -70269,  -70316,  -70362,  -70409,  -70456,
+     -70503,  -70550,  -70596,  -70643,  -70690,  -70737,  -70784,  -70831,
+     -70877,  -70924,  -70971,  -71018,  -71065,  -71111,  -71158,  -71205,
+     -71252,  -71299,  -71345,  -71392,  -71439,  -71486,  -71533,  -71580,
+     -71626,  -71673,  -71720,  -71767,  -71814,  -71860,  -71907,  -71954,
+     -72001,  -72048,  -72094,  -72141,  -72188,  -72235,  -72282,  -72329,
+     -72375,  -72422,  -72469,  -72516,  -72563,  -72609,  -72656,  -72703,
+     -72750,  -72797,  -72843,  -72890,  -72937,  -72984,  -73031,  -73078,
+     -73124,  -73171,  -73218,  -73265,  -73312,  -73358,  -73405,  -73452,
+     -73499,  -73546,  -73593,  -73639,  -73686,  -73733,  -73780,  -73827,
+     -73873,  -73920,  -73967,  -74014,  -74061,  -74107,  -74154,  -74201,
+     -74248,  -74295,  -74342,  -74388,  -74435,  -74482,  -74529,  -74576,
+     -74622,  -74669,  -74716,  -74763,  -74810,  -74856,  -74903,  -74950,
+     -74997,  -75044,  -75091,  -75137,  -75184,  -75231,  -75278,  -75325,
+     -75371,  -75418,  -75465,  -75512,  -75559,  -75606,  -75652,  -75699,
+     -75746,  -75793,  -75840,  -75886,  -75933,  -75980,  -76027,  -76074,
+     -76120,  -76167,  -76214,  -76261,  -76308,  -76355,  -76401,  -76448,
+     -76495,  -76542,  -76589,  -76635,  -76682,  -76729,  -76776,  -76823,
+     -76869,  -76916,  -76963,  -77010,  -77057,  -77104,  -77150,  -77197,
+     -77244,  -77291,  -77338,  -77384,  -77431,  -77478,  -77525,  -77572,
+     -77618,  -77665,  -77712,  -77759,  -77806,  -77853,  -77899,  -77946,
+     -77993,  -78040,  -78087,  -78133,  -78180,  -78227,  -78274,  -78321,
+     -78368,  -78414,  -78461,  -78508,  -78555,  -78602,  -78648,  -78695,
+     -78742,  -78789,  -78836,  -78882,  -78929,  -78976,  -79023,  -79070,
+     -79117,  -79163,  -79210,  -79257,  -79304,  -79351,  -79397,  -79444,
+     -79491,  -79538,  -79585,  -79631,  -79678,  -79725,  -79772,  -79819,
+     -79866,  -79912,  -79959,  -80006,  -80053,  -80100,  -80146,  -80193,
+     -80240,  -80287,  -80334,  -80381,  -80427,  -80474,  -80521,  -80568,
+     -80615,  -80661,  -80708,  -80755,  -80802,  -80849,  -80895,  -80942,
+     -80989,  -81036,  -81083,  -81130,  -81176,  -81223,  -81270,  -81317,
+     -81364,  -81410,  -81457,  -81504,  -81551,  -81598,  -81644,  -81691,
+     -81738,  -81785,  -81832,  -81879,  -81925,  -81972,  -82019,  -82066,
+     -82113,  -82159,  -82206,  -82253,  -82300,  -82347,  -82393,  -82440,
+     -82487,  -82534,  -82581,  -82628,  -82674,  -82721,  -82768,  -82815,
+     -82862,  -82908,  -82955,  -83002,  -83049,  -83096,  -83143,  -83189,
+     -83236,  -83283,  -83330,  -83377,  -83423,  -83470,  -83517,  -83564,
+     -83611,  -83657,  -83704,  -83751,  -83798,  -83845,  -83892,  -83938,
+     -83985,  -84032,  -84079,  -84126,  -84172,  -84219,  -84266,  -84313,
+     -84360,  -84406,  -84453,  -84500,  -84547,  -84594,  -84641,  -84687,
+     -84734,  -84781,  -84828,  -84875,  -84921,  -84968,  -85015,  -85062,
+     -85109,  -85156,  -85202,  -85249,  -85296,  -85343,  -85390,  -85436,
+     -85483,  -85530,  -85577,  -85624,  -85670,  -85717,  -85764,  -85811,
+     -85858,  -85905,  -85951,  -85998,  -86045,  -86092,  -86139,  -86185,
+     -86232,  -86279,  -86326,  -86373,  -86419,  -86466,  -86513,  -86560,
+     -86607,  -86654,  -86700,  -86747,  -86794,  -86841,  -86888,  -86934,
+     -86981,  -87028,  -87075,  -87122,  -87168,  -87215,  -87262,  -87309,
+     -87356,  -87403,  -87449,  -87496,  -87543,  -87590,  -87637,  -87683,
+     -87730,  -87777,  -87824,  -87871,  -87918,  -87964,  -88011,  -88058,
+     -88105,  -88152,  -88198,  -88245,  -88292,  -88339,  -88386,  -88432,
+     -88479,  -88526,  -88573,  -88620,  -88667,  -88713,  -88760,  -88807,
+     -88854,  -88901,  -88947,  -88994,  -89041,  -89088,  -89135,  -89181,
+     -89228,  -89275,  -89322,  -89369,  -89416,  -89462,  -89509,  -89556,
+     -89603,  -89650,  -89696,  -89743,  -89790,  -89837,  -89884,  -89930,
+     -89977,  -90024,  -90071,  -90118,  -90165,  -90211,  -90258,  -90305,
+     -90352,  -90399,  -90445,  -90492,  -90539,  -90586,  -90633,  -90680,
+     -90726,  -90773,  -90820,  -90867,  -90914,  -90960,  -91007,  -91054,
+     -91101,  -91148,  -91194,  -91241,  -91288,  -91335,  -91382,  -91429,
+     -91475,  -91522,  -91569,  -91616,  -91663,  -91709,  -91756,  -91803,
+     -91850,  -91897,  -91943,  -91990,  -92037,  -92084,  -92131,  -92178,
+     -92224,  -92271,  -92318,  -92365,  -92412,  -92458,  -92505,  -92552,
+     -92599,  -92646,  -92693,  -92739,  -92786,  -92833,  -92880,  -92927,
+     -92973,  -93020,  -93067,  -93114,  -93161,  -93207,  -93254,  -93301,
+     -93348,  -93395,  -93442,  -93488,  -93535,  -93582,  -93629,  -93676,
+     -93722,  -93769,  -93816,  -93863,  -93910,  -93956,  -94003,  -94050,
+     -94097,  -94144,  -94191,  -94237,  -94284,  -94331,  -94378,  -94425,
+     -94471,  -94518,  -94565,  -94612,  -94659,  -94705,  -94752,  -94799,
+     -94846,  -94893,  -94940,  -94986,  -95033,  -95080,  -95127,  -95174,
+     -95220,  -95267,  -95314,  -95361,  -95408,  -95455,  -95501,  -95548,
+     -95595,  -95642,  -95689,  -95735,  -95782,  -95829,  -95876,  -95923,
+     -95969,  -96016,  -96063,  -96110,  -96157,  -96204,  -96250,  -96297,
+     -96344,  -96391,  -96438,  -96484,  -96531,  -96578,  -96625,  -96672,
+     -96718,  -96765,  -96812,  -96859,  -96906,  -96953,  -96999,  -97046,
+     -97093,  -97140,  -97187,  -97233,  -97280,  -97327,  -97374,  -97421,
+     -97468,  -97514,  -97561,  -97608,  -97655,  -97702,  -97748,  -97795,
+     -97842,  -97889,  -97936,  -97982,  -98029,  -98076,  -98123,  -98170,
+     -98217,  -98263,  -98310,  -98357,  -98404,  -98451,  -98497,  -98544,
+     -98591,  -98638,  -98685,  -98731,  -98778,  -98825,  -98872,  -98919,
+     -98966,  -99012,  -99059,  -99106,  -99153,  -99200,  -99246,  -99293,
+     -99340,  -99387,  -99434,  -99480,  -99527,  -99574,  -99621,  -99668,
+     -99715,  -99761,  -99808,  -99855,  -99902,  -99949,  -99995, -100042,
+    -100089, -100136, -100183, -100230, -100276, -100323, -100370, -100417,
+    -100464, -100510, -100557, -100604, -100651, -100698, -100744, -100791,
+    -100838, -100885, -100932, -100979, -101025, -101072, -101119, -101166,
+    -101213, -101259, -101306, -101353, -101400, -101447, -101493, -101540,
+    -101587, -101634, -101681, -101728, -101774, -101821, -101868, -101915,
+    -101962, -102008, -102055, -102102, -102149, -102196, -102243, -102289,
+    -102336, -102383, -102430, -102477, -102523, -102570, -102617, -102664,
+    -102711, -102757, -102804, -102851, -102898, -102945, -102992, -103038,
+    -103085, -103132, -103179, -103226, -103272, -103319, -103366, -103413,
+    -103460, -103506, -103553, -103600, -103647, -103694, -103741, -103787,
+    -103834, -103881, -103928, -103975, -104021, -104068, -104115, -104162,
+    -104209, -104255, -104302, -104349, -104396, -104443, -104490, -104536,
+    -104583, -104630, -104677, -104724, -104770, -104817, -104864, -104911,
+    -104958, -105005, -105051, -105098, -105145, -105192, -105239, -105285,
+    -105332, -105379, -105426, -105473, -105519, -105566, -105613, -105660,
+    -105707, -105754, -105800, -105847, -105894, -105941, -105988, -106034,
+    -106081, -106128, -106175, -106222, -106268, -106315, -106362, -106409,
+    -106456, -106503, -106549, -106596, -106643, -106690, -106737, -106783,
+    -106830, -106877, -106924, -106971, -107018, -107064, -107111, -107158,
+    -107205, -107252, -107298, -107345, -107392, -107439, -107486, -107532,
+    -107579, -107626, -107673, -107720, -107767, -107813, -107860, -107907,
+    -107954, -108001, -108047, -108094, -108141, -108188, -108235, -108281,
+    -108328, -108375, -108422, -108469, -108516, -108562, -108609, -108656,
+    -108703, -108750, -108796, -108843, -108890, -108937, -108984, -109030,
+    -109077, -109124, -109171, -109218, -109265, -109311, -109358, -109405,
+    -109452, -109499, -109545, -109592, -109639, -109686, -109733, -109780,
+    -109826, -109873, -109920, -109967, -110014, -110060, -110107, -110154,
+    -110201, -110248, -110294, -110341, -110388, -110435, -110482, -110529,
+    -110575, -110622, -110669, -110716, -110763, -110809, -110856, -110903,
+    -110950, -110997, -111043, -111090, -111137, -111184, -111231, -111278,
+    -111324, -111371, -111418, -111465, -111512, -111558, -111605, -111652,
+    -111699, -111746, -111793, -111839, -111886, -111933, -111980, -112027,
+    -112073, -112120, -112167, -112214, -112261, -112307, -112354, -112401,
+    -112448, -112495, -112542, -112588, -112635, -112682, -112729, -112776,
+    -112822, -112869, -112916, -112963, -113010, -113056, -113103, -113150,
+    -113197, -113244, -113291, -113337, -113384, -113431, -113478, -113525,
+    -113571, -113618, -113665, -113712, -113759, -113805, -113852, -113899,
+    -113946, -113993, -114040, -114086, -114133, -114180, -114227, -114274,
+    -114320, -114367, -114414, -114461, -114508, -114555, -114601, -114648,
+    -114695, -114742, -114789, -114835, -114882, -114929, -114976, -115023,
+    -115069, -115116, -115163, -115210, -115257, -115304, -115350, -115397,
+    -115444, -115491, -115538, -115584, -115631, -115678, -115725, -115772,
+    -115818, -115865, -115912, -115959, -116006, -116053, -116099, -116146,
+    -116193, -116240, -116287, -116333, -116380, -116427, -116474, -116521,
+    -116568, -116614, -116661, -116708, -116755, -116802, -116848, -116895,
+    -116942, -116989, -117036, -117082, -117129, -117176, -117223, -117270,
+    -117317, -117363, -117410, -117457, -117504, -117551, -117597, -117644,
+    -117691, -117738, -117785, -117831, -117878, -117925, -117972, -118019,
+    -118066, -118112, -118159, -118206, -118253, -118300, -118346, -118393,
+    -118440, -118487, -118534, -118580, -118627, -118674, -118721, -118768,
+    -118815, -118861, -118908, -118955, -119002, -119049, -119095, -119142,
+    -119189, -119236, -119283, -119330, -119376, -119423, -119470, -119517,
+    -119564, -119610, -119657, -119704, -119751, -119798, -119844, -119891,
+    -119938, -119985, -120032, -120079, -120125, -120172, -120219, -120266,
+    -120313, -120359, -120406, -120453, -120500, -120547, -120593, -120640,
+    -120687, -120734, -120781, -120828, -120874, -120921, -120968, -121015,
+    -121062, -121108, -121155, -121202, -121249, -121296, -121343, -121389,
+    -121436, -121483, -121530, -121577, -121623, -121670, -121717, -121764,
+    -121811, -121857, -121904, -121951, -121998, -122045, -122092, -122138,
+    -122185, -122232, -122279, -122326, -122372, -122419, -122466, -122513,
+    -122560, -122606, -122653, -122700, -122747, -122794, -122841, -122887,
+    -122934, -122981, -123028, -123075, -123121, -123168, -123215, -123262,
+    -123309, -123355, -123402, -123449, -123496, -123543, -123590, -123636,
+    -123683, -123730, -123777, -123824, -123870, -123917, -123964, -124011,
+    -124058, -124105, -124151, -124198, -124245, -124292, -124339, -124385,
+    -124432, -124479, -124526, -124573, -124619, -124666, -124713, -124760,
+    -124807, -124854, -124900, -124947, -124994, -125041, -125088, -125134,
+    -125181, -125228, -125275, -125322, -125368, -125415, -125462, -125509,
+    -125556, -125603, -125649, -125696, -125743, -125790, -125837, -125883,
+    -125930, -125977, -126024, -126071, -126118, -126164, -126211, -126258,
+    -126305, -126352, -126398, -126445, -126492, -126539, -126586, -126632,
+    -126679, -126726, -126773, -126820, -126867, -126913, -126960, -127007,
+    -127054, -127101, -127147, -127194, -127241, -127288, -127335, -127381,
+    -127428, -127475, -127522, -127569, -127616, -127662, -127709, -127756,
+    -127803, -127850, -127896, -127943, -127990, -128037, -128084, -128130,
+    -128177, -128224, -128271, -128318, -128365, -128411, -128458, -128505,
+    -128552, -128599, -128645, -128692, -128739, -128786, -128833, -128880,
+    -128926, -128973, -129020, -129067, -129114, -129160, -129207, -129254,
+    -129301, -129348, -129394, -129441, -129488, -129535, -129582, -129629,
+    -129675, -129722, -129769, -129816, -129863, -129909, -129956, -130003,
+    -130050, -130097, -130143, -130190, -130237, -130284, -130331, -130378,
+    -130424, -130471, -130518, -130565, -130612, -130658, -130705, -130752,
+    -130799, -130846, -130893, -130939, -130986, -131033, -131080, -131127,
+    -131173, -131220, -131267, -131314, -131361, -131407, -131454, -131501,
+    -131548, -131595, -131642, -131688, -131735, -131782, -131829, -131876,
+    -131922, -131969, -132016, -132063, -132110, -132156, -132203, -132250,
+    -132297, -132344, -132391, -132437, -132484, -132531, -132578, -132625,
+    -132671, -132718, -132765, -132812, -132859, -132905, -132952, -132999,
+    -133046, -133093, -133140, -133186, -133233, -133280, -133327, -133374,
+    -133420, -133467, -133514, -133561, -133608, -133655, -133701, -133748,
+    -133795, -133842, -133889, -133935, -133982, -134029, -134076, -134123,
+    -134169, -134216, -134263, -134310, -134357, -134404, -134450, -134497,
+    -134544, -134591, -134638, -134684, -134731, -134778, -134825, -134872,
+    -134918, -134965, -135012, -135059, -135106, -135153, -135199, -135246,
+    -135293, -135340, -135387, -135433, -135480, -135527, -135574, -135621,
+    -135668, -135714, -135761, -135808, -135855, -135902, -135948, -135995,
+    -136042, -136089, -136136, -136182, -136229, -136276, -136323, -136370,
+    -136417, -136463, -136510, -136557, -136604, -136651, -136697, -136744,
+    -136791, -136838, -136885, -136931, -136978, -137025, -137072, -137119,
+    -137166, -137212, -137259, -137306, -137353, -137400, -137446, -137493,
+    -137540, -137587, -137634, -137680, -137727, -137774, -137821, -137868,
+    -137915, -137961, -138008, -138055, -138102, -138149, -138195, -138242,
+    -138289, -138336, -138383, -138430, -138476, -138523, -138570, -138617,
+    -138664, -138710, -138757, -138804, -138851, -138898, -138944, -138991,
+    -139038, -139085, -139132, -139179, -139225, -139272, -139319, -139366,
+    -139413, -139459, -139506, -139553, -139600, -139647, -139693, -139740,
+    -139787, -139834, -139881, -139928, -139974, -140021, -140068, -140115,
+    -140162, -140208, -140255, -140302, -140349, -140396, -140442, -140489,
+    -140536, -140583, -140630, -140677, -140723, -140770, -140817, -140864,
+    -140911, -140957, -141004, -141051, -141098, -141145, -141192, -141238,
+    -141285, -141332, -141379, -141426, -141472, -141519, -141566, -141613,
+    -141660, -141706, -141753, -141800, -141847, -141894, -141941, -141987,
+    -142034, -142081, -142128, -142175, -142221, -142268, -142315, -142362,
+    -142409, -142455, -142502, -142549, -142596, -142643, -142690, -142736,
+    -142783, -142830, -142877, -142924, -142970, -143017, -143064, -143111,
+    -143158, -143205, -143251, -143298, -143345, -143392, -143439, -143485,
+    -143532, -143579, -143626, -143673, -143719, -143766, -143813, -143860,
+    -143907, -143954, -144000, -144047, -144094, -144141, -144188, -144234,
+    -144281, -144328, -144375, -144422, -144468, -144515, -144562, -144609,
+    -144656, -144703, -144749, -144796, -144843, -144890, -144937, -144983,
+    -145030, -145077, -145124, -145171, -145217, -145264, -145311, -145358,
+    -145405, -145452, -145498, -145545, -145592, -145639, -145686, -145732,
+    -145779, -145826, -145873, -145920, -145967, -146013, -146060, -146107,
+    -146154, -146201, -146247, -146294, -146341, -146388, -146435, -146481,
+    -146528, -146575, -146622, -146669, -146716, -146762, -146809, -146856,
+    -146903, -146950, -146996, -147043, -147090, -147137, -147184, -147230,
+    -147277, -147324, -147371, -147418, -147465, -147511, -147558, -147605,
+    -147652, -147699, -147745, -147792, -147839, -147886, -147933, -147980,
+};
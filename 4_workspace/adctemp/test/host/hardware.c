@@ -0,0 +1,70 @@
+#include <string.h>
+
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "hardware/interp.h"
+#include "hardware/sync.h"
+
+uint32_t host_interp_invalid = 0;
+int host_irq_disabled = 0;
+uint8_t host_flash[PICO_FLASH_SIZE_BYTES];
+uint32_t host_flash_errors = 0;
+bool host_flash_busy = false;
+
+static interp_hw_t interps[2];
+
+/**
+ * @brief Recalcula el resultado del carril 1. En modo mezcla es
+ * base0 + (base1 - base0) * alpha / 256, con alpha los 8 bits bajos del
+ * acumulador 1 y el producto desplazado como en el hardware
+ */
+static void interp_update(interp_hw_t *interp) {
+    uint32_t alpha = interp->accum[1] & 0xFF;
+
+    if (!(interp->ctrl[0] & SIO_INTERP0_CTRL_LANE0_BLEND_BITS)) {
+        interp->peek[1] = interp->accum[1] + interp->base[1];
+    } else if (interp->ctrl[1] & SIO_INTERP0_CTRL_LANE0_SIGNED_BITS) {
+        int64_t delta = (int64_t)(int32_t)interp->base[1] - (int32_t)interp->base[0];
+        interp->peek[1] = (uint32_t)((int32_t)interp->base[0] + (int32_t)((delta * alpha) >> 8));
+    } else {
+        int64_t delta = (int64_t)interp->base[1] - interp->base[0];
+        interp->peek[1] = interp->base[0] + (uint32_t)((delta * alpha) >> 8);
+    }
+}
+
+interp_hw_t *host_interp(uint num) {
+    interp_update(&interps[num]);
+    return &interps[num];
+}
+
+void interp_set_config(interp_hw_t *interp, uint lane, interp_config *config) {
+    // Como el SDK: el modo mezcla existe solo en el carril 0 del interpolador 0
+    if (lane > 1 || ((config->ctrl & SIO_INTERP0_CTRL_LANE0_BLEND_BITS) && (interp != &interps[0] || lane))) {
+        host_interp_invalid++;
+        return;
+    }
+    interp->ctrl[lane] = config->ctrl;
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    if (flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES) {
+        host_flash_errors++;
+        return;
+    }
+    memset(host_flash + flash_offs, 0xFF, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    if (flash_offs % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES) {
+        host_flash_errors++;
+        return;
+    }
+    for (size_t i = 0; i < count; i++) { host_flash[flash_offs + i] &= data[i]; }
+}
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms) {
+    (void)enter_exit_timeout_ms;
+    if (host_flash_busy) { return PICO_ERROR_TIMEOUT; }
+    func(param);
+    return PICO_OK;
+}
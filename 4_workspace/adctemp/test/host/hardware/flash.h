@@ -0,0 +1,21 @@
+#ifndef _HARDWARE_FLASH_H
+#define _HARDWARE_FLASH_H
+
+// Flash del modelo: un arreglo que se lee directo por XIP_BASE, se borra en
+// sectores a 0xFF y se graba en paginas que solo pueden bajar bits
+#include "pico/stdlib.h"
+
+#define FLASH_SECTOR_SIZE       (1u << 12)
+#define FLASH_PAGE_SIZE         (1u << 8)
+#define PICO_FLASH_SIZE_BYTES   (16 * FLASH_SECTOR_SIZE)
+
+extern uint8_t host_flash[PICO_FLASH_SIZE_BYTES];
+// Borrados y grabaciones desalineados o fuera de la flash, tiene que dar cero
+extern uint32_t host_flash_errors;
+
+#define XIP_BASE                ((uintptr_t)host_flash)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef _HARDWARE_INTERP_H
+#define _HARDWARE_INTERP_H
+
+// Modelo de los dos interpoladores de un nucleo, solo con la mascara y el
+// desplazamiento por defecto. Los resultados se calculan en cada acceso
+#include "pico/stdlib.h"
+
+#define SIO_INTERP0_CTRL_LANE0_BLEND_BITS   _u(0x00200000)
+#define SIO_INTERP0_CTRL_LANE0_SIGNED_BITS  _u(0x00008000)
+
+typedef struct {
+    uint32_t ctrl;
+} interp_config;
+
+typedef struct {
+    uint32_t accum[2];
+    uint32_t base[3];
+    uint32_t peek[3];
+    uint32_t ctrl[2];
+} interp_hw_t;
+
+// Configuraciones que el SDK rechaza con invalid_params_if, tiene que dar cero
+extern uint32_t host_interp_invalid;
+
+interp_hw_t *host_interp(uint num);
+
+// Cada uso de interp0 o interp1 recalcula peek con lo escrito hasta ahi
+#define interp0 (host_interp(0))
+#define interp1 (host_interp(1))
+
+static inline interp_config interp_default_config(void) {
+    interp_config config = { 0 };
+    return config;
+}
+
+static inline void interp_config_set_blend(interp_config *config, bool blend) {
+    config->ctrl = blend ? config->ctrl | SIO_INTERP0_CTRL_LANE0_BLEND_BITS
+                         : config->ctrl & ~SIO_INTERP0_CTRL_LANE0_BLEND_BITS;
+}
+
+static inline void interp_config_set_signed(interp_config *config, bool is_signed) {
+    config->ctrl = is_signed ? config->ctrl | SIO_INTERP0_CTRL_LANE0_SIGNED_BITS
+                             : config->ctrl & ~SIO_INTERP0_CTRL_LANE0_SIGNED_BITS;
+}
+
+void interp_set_config(interp_hw_t *interp, uint lane, interp_config *config);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef _HARDWARE_SYNC_H
+#define _HARDWARE_SYNC_H
+
+// Interrupciones del modelo: solo cuenta las secciones abiertas
+#include "pico/stdlib.h"
+
+// Secciones con las interrupciones deshabilitadas sin cerrar, tiene que dar cero
+extern int host_irq_disabled;
+
+static inline uint32_t save_and_disable_interrupts(void) {
+    host_irq_disabled++;
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+    (void)status;
+    host_irq_disabled--;
+}
+
+#endif
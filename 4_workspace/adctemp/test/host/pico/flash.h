@@ -0,0 +1,12 @@
+#ifndef _PICO_FLASH_H
+#define _PICO_FLASH_H
+
+// flash_safe_execute del modelo: corre la funcion, o falla si la prueba lo pide
+#include "pico/stdlib.h"
+
+// Con true flash_safe_execute no consigue la flash y vuelve con timeout
+extern bool host_flash_busy;
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+
+#endif
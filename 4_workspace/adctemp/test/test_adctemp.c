@@ -0,0 +1,156 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "check.h"
+#include "adctemp.h"
+#include "hardware/flash.h"
+#include "hardware/interp.h"
+#include "hardware/sync.h"
+#include "pico/flash.h"
+
+// Constantes por defecto de adctemp_table.py
+#define VREF            3.3
+#define V27             0.706
+#define SLOPE           0.001721
+
+// Errores maximos en centesimas de grado contra la formula, los del README
+#define TABLE_ERROR     0.5
+#define INTERP_ERROR    1.0
+
+/**
+ * @brief La formula del script en doble precision, en centesimas de grado
+ * @param code cuentas del ADC, con fraccion para la interpolacion
+ */
+static double formula(double code) {
+    return (27.0 - (code * VREF / ADCTEMP_CODES - V27) / SLOPE) * 100.0;
+}
+
+// La misma formula en float, como la calcularia el firmware sin la tabla
+static float formula_float(uint32_t code) {
+    float voltage = (float)code * 3.3f / ADCTEMP_CODES;
+    return (27.0f - (voltage - 0.706f) / 0.001721f) * 100.0f;
+}
+
+/**
+ * @brief Las 4096 cuentas contra la formula: cada valor es la formula redondeada
+ * lejos del cero, como lo genera el script
+ */
+static void test_table(void) {
+    double worst = 0.0;
+    float worst_float = 0.0f;
+
+    for (uint32_t code = 0; code < ADCTEMP_CODES; code++) {
+        double exact = formula(code);
+        double rounded = copysign(floor(fabs(exact) + 0.5), exact);
+        CHECK_EQ(adctemp_table[code], (int32_t)rounded);
+        worst = fmax(worst, fabs(adctemp_table[code] - exact));
+        worst_float = fmaxf(worst_float, fabsf((float)adctemp_table[code] - formula_float(code)));
+    }
+    printf("tabla: 4096 cuentas, error maximo %.4f centesimas contra double, %.4f contra float\n", worst, worst_float);
+    CHECK(worst <= TABLE_ERROR);
+    // Decreciente y sin saltos: cada cuenta son unas 47 centesimas
+    for (uint32_t code = 1; code < ADCTEMP_CODES; code++) {
+        int32_t step = adctemp_table[code - 1] - adctemp_table[code];
+        CHECK(step >= 46 && step <= 48);
+    }
+}
+
+/**
+ * @brief adctemp_centi sin calibracion es la tabla, ignorando el bit de error, y
+ * con calibracion es T * gain + offset redondeado
+ */
+static void test_centi(void) {
+    static const int32_t cals[][2] = { { 0, ADCTEMP_GAIN_ONE }, { -80, ADCTEMP_GAIN_ONE }, { 150, 16220 },
+                                       { -37, 16549 } };
+    adctemp_cal_t saved = adctemp_cal;
+
+    for (uint32_t code = 0; code < ADCTEMP_CODES; code++) {
+        CHECK_EQ(adctemp_centi(code), adctemp_table[code]);
+        CHECK_EQ(adctemp_centi(code | 0x8000), adctemp_table[code]);
+    }
+    for (size_t c = 0; c < sizeof(cals) / sizeof(cals[0]); c++) {
+        double worst = 0.0;
+        adctemp_cal.offset = cals[c][0];
+        adctemp_cal.gain = cals[c][1];
+        for (uint32_t code = 0; code < ADCTEMP_CODES; code++) {
+            double exact = adctemp_table[code] * (double)cals[c][1] / ADCTEMP_GAIN_ONE + cals[c][0];
+            worst = fmax(worst, fabs(adctemp_centi(code) - exact));
+        }
+        CHECK(worst <= 0.5);
+    }
+    adctemp_cal = saved;
+}
+
+/**
+ * @brief Interpolacion de promedios de 1 a 256 lecturas en todas las cuentas
+ * contra la formula en el punto fraccionario
+ */
+static void test_interp(void) {
+    double worst = 0.0;
+
+    for (uint32_t bits = 0; bits <= 8; bits++) {
+        for (uint32_t code = 0; code < (ADCTEMP_CODES - 1u) << bits; code++) {
+            int32_t t = adctemp_centi_interp(code, bits);
+            worst = fmax(worst, fabs(t - formula((double)code / (1u << bits))));
+            // Sin fraccion es la tabla
+            if (!(code & ((1u << bits) - 1))) { CHECK_EQ(t, adctemp_table[code >> bits]); }
+        }
+        // Desde la ultima cuenta no hay con que interpolar
+        CHECK_EQ(adctemp_centi_interp((ADCTEMP_CODES - 1u) << bits, bits), adctemp_table[ADCTEMP_CODES - 1]);
+    }
+    printf("interpolacion: de 0 a 8 bits fraccionarios, error maximo %.4f centesimas\n", worst);
+    CHECK(worst <= INTERP_ERROR);
+    CHECK_EQ(host_interp_invalid, 0);
+    CHECK_EQ(host_irq_disabled, 0);
+}
+
+/**
+ * @brief Grabacion y carga de la calibracion en la flash del modelo
+ */
+static void test_flash(void) {
+    adctemp_cal_t saved = adctemp_cal;
+    const adctemp_cal_t *stored = (const adctemp_cal_t *)(XIP_BASE + PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE);
+
+    CHECK_EQ(adctemp_cal.offset, 0);
+    CHECK_EQ(adctemp_cal.gain, ADCTEMP_GAIN_ONE);
+
+    // Se graba en el ultimo sector y se aplica en el momento
+    CHECK(adctemp_cal_save(-80, 16300));
+    CHECK_EQ(adctemp_cal.offset, -80);
+    CHECK_EQ(adctemp_cal.gain, 16300);
+    CHECK(!memcmp(stored, &adctemp_cal, sizeof(adctemp_cal)));
+    // Una segunda grabacion borra la anterior, los bits no quedan mezclados
+    CHECK(adctemp_cal_save(25, ADCTEMP_GAIN_ONE));
+    CHECK(!memcmp(stored, &adctemp_cal, sizeof(adctemp_cal)));
+    CHECK_EQ(host_flash_errors, 0);
+
+    // Al arrancar se carga la grabada
+    adctemp_cal = saved;
+    adctemp_init();
+    CHECK_EQ(adctemp_cal.offset, 25);
+    CHECK_EQ(adctemp_centi(2048), adctemp_table[2048] + 25);
+
+    // Sin la flash disponible no se graba ni se aplica
+    host_flash_busy = true;
+    CHECK(!adctemp_cal_save(0, ADCTEMP_GAIN_ONE));
+    CHECK_EQ(adctemp_cal.offset, 25);
+    host_flash_busy = false;
+
+    // Con la verificacion rota se ignora
+    host_flash[PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE + 4] ^= 1;
+    adctemp_cal = saved;
+    adctemp_init();
+    CHECK(!memcmp(&adctemp_cal, &saved, sizeof(saved)));
+}
+
+int main(void) {
+    // Flash borrada: adctemp_init deja la calibracion por defecto y arma el interpolador
+    memset(host_flash, 0xFF, sizeof(host_flash));
+    adctemp_init();
+    test_table();
+    test_centi();
+    test_interp();
+    test_flash();
+    return check_result("adctemp");
+}
@@ -0,0 +1,116 @@
+#ifndef _AO_H_
+#define _AO_H_
+
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Objetos por ejecutor, uno por prioridad, y objetos en total
+#define AO_PRIORITIES           32
+#define AO_MAX_OBJECTS          32
+// Señales que se pueden publicar, las demas solo se envian a un objeto
+#define AO_MAX_SIGNALS          32
+
+// Señal que recibe cada objeto al arrancar, ya en su ejecutor
+#define AO_SIG_INIT             0
+// Primera señal libre para la aplicacion
+#define AO_SIG_USER             1
+
+/**
+ * @brief Evento: una señal y un argumento, se copia en la cola del objeto
+ */
+typedef struct {
+    uint16_t signal;
+    uint32_t arg;
+} ao_event_t;
+
+typedef struct ao ao_t;
+typedef struct ao_executor ao_executor_t;
+
+/**
+ * @brief Handler de un objeto. Corre hasta terminar, sin bloquearse, en la
+ * tarea del ejecutor
+ */
+typedef void (*ao_handler_t)(ao_t *ao, const ao_event_t *event);
+
+/**
+ * @brief Contadores de un objeto
+ */
+typedef struct {
+    uint32_t dispatched;        // Eventos atendidos
+    uint32_t dropped;           // Eventos descartados con la cola llena
+    uint32_t queue_max;         // Mayor ocupacion de la cola
+    uint32_t run_max_us;        // Handler mas largo
+} ao_stats_t;
+
+/**
+ * @brief Objeto activo: un handler con su cola privada de eventos
+ */
+struct ao {
+    const char *name;
+    ao_handler_t handler;
+    void *context;              // Datos propios del objeto
+    ao_executor_t *executor;
+    ao_event_t *queue;          // queue_size eventos, potencia de dos
+    uint32_t queue_size;
+    uint32_t head;              // Proximo lugar a escribir, solo con la seccion critica
+    uint32_t tail;              // Proximo lugar a leer, solo con la seccion critica
+    uint8_t priority;           // Dentro del ejecutor, mayor numero se atiende primero
+    uint8_t id;                 // Lugar en la tabla de suscripciones
+    ao_stats_t stats;
+};
+
+/**
+ * @brief Evento de tiempo de un objeto, lo vigila el ejecutor
+ */
+typedef struct ao_timer {
+    struct ao_timer *next;
+    ao_t *ao;                   // Objeto que recibe el evento
+    uint16_t signal;            // Señal del evento
+    bool armed;
+    TickType_t deadline;        // Tick del proximo vencimiento
+    TickType_t period;          // 0 para un solo vencimiento
+} ao_timer_t;
+
+/**
+ * @brief Contadores de un ejecutor
+ */
+typedef struct {
+    uint32_t activations;       // Veces que la tarea se desperto
+    uint32_t dispatched;        // Eventos atendidos
+    uint64_t run_us;            // Tiempo total en los handlers, con 32 bits da la vuelta a los 71 minutos
+    uint32_t run_max_us;        // Handler mas largo
+} ao_executor_stats_t;
+
+/**
+ * @brief Ejecutor: una tarea que atiende a varios objetos, de a un evento, el
+ * de mayor prioridad primero
+ */
+struct ao_executor {
+    TaskHandle_t task;
+    uint32_t ready;             // Un bit por prioridad con eventos pendientes
+    ao_t *objects[AO_PRIORITIES];
+    ao_timer_t *timers;         // Eventos de tiempo, solo los toca la tarea del ejecutor
+    ao_executor_stats_t stats;
+};
+
+// Declara la cola de eventos de un objeto, size potencia de dos
+#define AO_QUEUE(name, size)    static ao_event_t name[size]
+
+// Prototipos de funciones
+bool ao_executor_start(ao_executor_t *executor, const char *name, UBaseType_t priority, configSTACK_DEPTH_TYPE stack);
+bool ao_start(ao_t *ao, ao_executor_t *executor, uint8_t priority, const char *name, ao_handler_t handler, void *context,
+              ao_event_t *queue, uint32_t queue_size);
+bool ao_post(ao_t *ao, uint16_t signal, uint32_t arg);
+bool ao_post_from_isr(ao_t *ao, uint16_t signal, uint32_t arg, BaseType_t *to_higher_priority_task);
+void ao_subscribe(ao_t *ao, uint16_t signal);
+void ao_publish(uint16_t signal, uint32_t arg);
+void ao_publish_from_isr(uint16_t signal, uint32_t arg, BaseType_t *to_higher_priority_task);
+void ao_timer_init(ao_timer_t *timer, ao_t *ao, uint16_t signal);
+void ao_timer_arm(ao_timer_t *timer, TickType_t delay, TickType_t period);
+void ao_timer_disarm(ao_timer_t *timer);
+void ao_get_stats(const ao_t *ao, ao_stats_t *stats);
+void ao_executor_get_stats(const ao_executor_t *executor, ao_executor_stats_t *stats);
+
+#endif
@@ -0,0 +1,316 @@
+#include <string.h>
+#include "ao.h"
+
+// Objetos registrados y, por cada señal, un bit por objeto suscripto
+static ao_t *ao_registry[AO_MAX_OBJECTS];
+static uint32_t ao_count;
+static uint32_t ao_subscribers[AO_MAX_SIGNALS];
+
+/**
+ * @brief Copia un evento en la cola del objeto y lo marca listo en su
+ * ejecutor. Se llama con la seccion critica tomada
+ * @param ao objeto destino
+ * @param signal señal del evento
+ * @param arg argumento del evento
+ * @param wake se pone en true si el ejecutor no tenia nada pendiente
+ * @return false si la cola estaba llena y el evento se descarto
+ */
+static inline bool ao_push(ao_t *ao, uint16_t signal, uint32_t arg, bool *wake) {
+    uint32_t used = ao->head - ao->tail;
+    if (used >= ao->queue_size) {
+        ao->stats.dropped++;
+        return false;
+    }
+    ao_event_t *event = &ao->queue[ao->head++ & (ao->queue_size - 1)];
+    event->signal = signal;
+    event->arg = arg;
+    if (used + 1 > ao->stats.queue_max) { ao->stats.queue_max = used + 1; }
+
+    *wake = !ao->executor->ready;
+    ao->executor->ready |= 1u << ao->priority;
+    return true;
+}
+
+/**
+ * @brief Ticks hasta el proximo evento de tiempo
+ * @param executor puntero al ejecutor
+ * @return 0 si alguno ya vencio, portMAX_DELAY si no hay ninguno armado
+ */
+static TickType_t ao_timers_wait(const ao_executor_t *executor) {
+    TickType_t now = xTaskGetTickCount();
+    TickType_t wait = portMAX_DELAY;
+
+    for (const ao_timer_t *timer = executor->timers; timer; timer = timer->next) {
+        int32_t left = (int32_t)(timer->deadline - now);
+        if (left <= 0) { return 0; }
+        if ((TickType_t)left < wait) { wait = left; }
+    }
+    return wait;
+}
+
+/**
+ * @brief Encola los eventos de tiempo vencidos. Los periodicos se rearman y los
+ * de un solo vencimiento salen de la lista
+ * @param executor puntero al ejecutor
+ */
+static void ao_timers_fire(ao_executor_t *executor) {
+    TickType_t now = xTaskGetTickCount();
+    ao_timer_t **link = &executor->timers;
+    bool wake;
+
+    while (*link) {
+        ao_timer_t *timer = *link;
+        if ((int32_t)(timer->deadline - now) > 0) {
+            link = &timer->next;
+            continue;
+        }
+        if (timer->period) {
+            // Si el ejecutor estuvo ocupado mas de un periodo, no se acumulan vencimientos
+            timer->deadline += timer->period;
+            if ((int32_t)(timer->deadline - now) <= 0) { timer->deadline = now + timer->period; }
+            link = &timer->next;
+        } else {
+            *link = timer->next;
+            timer->armed = false;
+        }
+        // La tarea del ejecutor ya esta despierta, no hace falta notificarla
+        taskENTER_CRITICAL();
+        ao_push(timer->ao, timer->signal, 0, &wake);
+        taskEXIT_CRITICAL();
+    }
+}
+
+/**
+ * @brief Tarea de un ejecutor: atiende los eventos de a uno, siempre el del
+ * objeto de mayor prioridad, y duerme hasta el proximo evento o vencimiento
+ * @param params puntero al ejecutor
+ */
+static void ao_executor_task(void *params) {
+    ao_executor_t *executor = params;
+    ao_event_t event;
+    ao_t *ao;
+
+    while (1) {
+        ao_timers_fire(executor);
+
+        while (1) {
+            taskENTER_CRITICAL();
+            uint32_t ready = executor->ready;
+            if (ready) {
+                ao = executor->objects[31 - __builtin_clz(ready)];
+                event = ao->queue[ao->tail++ & (ao->queue_size - 1)];
+                if (ao->tail == ao->head) { executor->ready &= ~(1u << ao->priority); }
+            }
+            taskEXIT_CRITICAL();
+            if (!ready) { break; }
+
+            uint32_t start = time_us_32();
+            ao->handler(ao, &event);
+            uint32_t run = time_us_32() - start;
+
+            // Solo esta tarea escribe estos campos
+            ao->stats.dispatched++;
+            if (run > ao->stats.run_max_us) { ao->stats.run_max_us = run; }
+            executor->stats.dispatched++;
+            executor->stats.run_us += run;
+            if (run > executor->stats.run_max_us) { executor->stats.run_max_us = run; }
+
+            // Un handler largo puede dejar vencido un evento de tiempo
+            ao_timers_fire(executor);
+        }
+
+        ulTaskNotifyTake(pdTRUE, ao_timers_wait(executor));
+        executor->stats.activations++;
+    }
+}
+
+/**
+ * @brief Crea la tarea de un ejecutor. Llamar antes de vTaskStartScheduler
+ * @param executor puntero al ejecutor
+ * @param name nombre de la tarea
+ * @param priority prioridad de la tarea
+ * @param stack stack de la tarea, el del handler mas profundo de sus objetos
+ * @return true si se pudo crear la tarea
+ */
+bool ao_executor_start(ao_executor_t *executor, const char *name, UBaseType_t priority, configSTACK_DEPTH_TYPE stack) {
+    memset(executor, 0, sizeof(*executor));
+    return xTaskCreate(ao_executor_task, name, stack, executor, priority, &executor->task) == pdPASS;
+}
+
+/**
+ * @brief Registra un objeto en un ejecutor y le envia AO_SIG_INIT
+ * @param ao puntero al objeto
+ * @param executor ejecutor que lo atiende
+ * @param priority prioridad dentro del ejecutor, una por objeto (0 a AO_PRIORITIES - 1)
+ * @param name nombre para los informes
+ * @param handler funcion que atiende los eventos
+ * @param context datos propios del objeto
+ * @param queue cola declarada con AO_QUEUE
+ * @param queue_size cantidad de eventos de la cola, potencia de dos
+ * @return false si la prioridad esta ocupada, no hay lugar o la cola no es potencia de dos
+ */
+bool ao_start(ao_t *ao, ao_executor_t *executor, uint8_t priority, const char *name, ao_handler_t handler, void *context,
+              ao_event_t *queue, uint32_t queue_size) {
+    if (priority >= AO_PRIORITIES || executor->objects[priority]) { return false; }
+    if (!queue_size || (queue_size & (queue_size - 1)) || ao_count >= AO_MAX_OBJECTS) { return false; }
+
+    memset(ao, 0, sizeof(*ao));
+    ao->name = name;
+    ao->handler = handler;
+    ao->context = context;
+    ao->executor = executor;
+    ao->queue = queue;
+    ao->queue_size = queue_size;
+    ao->priority = priority;
+
+    taskENTER_CRITICAL();
+    ao->id = ao_count;
+    ao_registry[ao_count++] = ao;
+    executor->objects[priority] = ao;
+    taskEXIT_CRITICAL();
+
+    return ao_post(ao, AO_SIG_INIT, 0);
+}
+
+/**
+ * @brief Envia un evento a un objeto desde una tarea. El ejecutor se notifica
+ * solo si no tenia nada pendiente
+ * @param ao objeto destino
+ * @param signal señal del evento
+ * @param arg argumento del evento
+ * @return false si la cola estaba llena y el evento se descarto
+ */
+bool ao_post(ao_t *ao, uint16_t signal, uint32_t arg) {
+    bool wake = false;
+
+    taskENTER_CRITICAL();
+    bool ok = ao_push(ao, signal, arg, &wake);
+    taskEXIT_CRITICAL();
+
+    // Desde un handler del mismo ejecutor el evento se atiende sin volver a despertarlo
+    if (wake && xTaskGetCurrentTaskHandle() != ao->executor->task) { xTaskNotifyGive(ao->executor->task); }
+    return ok;
+}
+
+/**
+ * @brief Envia un evento a un objeto desde una ISR
+ * @param ao objeto destino
+ * @param signal señal del evento
+ * @param arg argumento del evento
+ * @param to_higher_priority_task se pone en pdTRUE si hay que cambiar de tarea
+ * @return false si la cola estaba llena y el evento se descarto
+ */
+bool ao_post_from_isr(ao_t *ao, uint16_t signal, uint32_t arg, BaseType_t *to_higher_priority_task) {
+    bool wake = false;
+
+    UBaseType_t state = taskENTER_CRITICAL_FROM_ISR();
+    bool ok = ao_push(ao, signal, arg, &wake);
+    taskEXIT_CRITICAL_FROM_ISR(state);
+
+    if (wake) { vTaskNotifyGiveFromISR(ao->executor->task, to_higher_priority_task); }
+    return ok;
+}
+
+/**
+ * @brief Suscribe un objeto a una señal publicada
+ * @param ao objeto que recibe los eventos
+ * @param signal señal, menor que AO_MAX_SIGNALS
+ */
+void ao_subscribe(ao_t *ao, uint16_t signal) {
+    if (signal >= AO_MAX_SIGNALS) { return; }
+    taskENTER_CRITICAL();
+    ao_subscribers[signal] |= 1u << ao->id;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Envia un evento a todos los objetos suscriptos a la señal
+ * @param signal señal, menor que AO_MAX_SIGNALS
+ * @param arg argumento del evento
+ */
+void ao_publish(uint16_t signal, uint32_t arg) {
+    if (signal >= AO_MAX_SIGNALS) { return; }
+    for (uint32_t mask = ao_subscribers[signal]; mask; mask &= mask - 1) {
+        ao_post(ao_registry[__builtin_ctz(mask)], signal, arg);
+    }
+}
+
+/**
+ * @brief Publica un evento desde una ISR
+ * @param signal señal, menor que AO_MAX_SIGNALS
+ * @param arg argumento del evento
+ * @param to_higher_priority_task se pone en pdTRUE si hay que cambiar de tarea
+ */
+void ao_publish_from_isr(uint16_t signal, uint32_t arg, BaseType_t *to_higher_priority_task) {
+    if (signal >= AO_MAX_SIGNALS) { return; }
+    for (uint32_t mask = ao_subscribers[signal]; mask; mask &= mask - 1) {
+        ao_post_from_isr(ao_registry[__builtin_ctz(mask)], signal, arg, to_higher_priority_task);
+    }
+}
+
+/**
+ * @brief Inicializa un evento de tiempo desarmado
+ * @param timer puntero al evento de tiempo
+ * @param ao objeto que lo recibe
+ * @param signal señal del evento
+ */
+void ao_timer_init(ao_timer_t *timer, ao_t *ao, uint16_t signal) {
+    memset(timer, 0, sizeof(*timer));
+    timer->ao = ao;
+    timer->signal = signal;
+}
+
+/**
+ * @brief Arma un evento de tiempo. Solo desde los handlers del ejecutor del
+ * objeto, o antes de arrancar el scheduler: la lista no tiene seccion critica
+ * @param timer puntero al evento de tiempo
+ * @param delay ticks hasta el primer vencimiento
+ * @param period ticks entre vencimientos, 0 para uno solo
+ */
+void ao_timer_arm(ao_timer_t *timer, TickType_t delay, TickType_t period) {
+    ao_executor_t *executor = timer->ao->executor;
+
+    if (timer->armed) { ao_timer_disarm(timer); }
+    timer->deadline = xTaskGetTickCount() + delay;
+    timer->period = period;
+    timer->armed = true;
+    timer->next = executor->timers;
+    executor->timers = timer;
+}
+
+/**
+ * @brief Desarma un evento de tiempo, con las mismas reglas que ao_timer_arm.
+ * Un vencimiento que ya esta en la cola del objeto igual se atiende
+ * @param timer puntero al evento de tiempo
+ */
+void ao_timer_disarm(ao_timer_t *timer) {
+    for (ao_timer_t **link = &timer->ao->executor->timers; *link; link = &(*link)->next) {
+        if (*link == timer) {
+            *link = timer->next;
+            break;
+        }
+    }
+    timer->armed = false;
+}
+
+/**
+ * @brief Copia los contadores de un objeto
+ * @param ao puntero al objeto
+ * @param stats puntero donde se copian
+ */
+void ao_get_stats(const ao_t *ao, ao_stats_t *stats) {
+    taskENTER_CRITICAL();
+    *stats = ao->stats;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Copia los contadores de un ejecutor
+ * @param executor puntero al ejecutor
+ * @param stats puntero donde se copian
+ */
+void ao_executor_get_stats(const ao_executor_t *executor, ao_executor_stats_t *stats) {
+    taskENTER_CRITICAL();
+    *stats = executor->stats;
+    taskEXIT_CRITICAL();
+}
@@ -0,0 +1,299 @@
+#include <string.h>
+
+#include "check.h"
+#include "ao.h"
+
+// Eventos atendidos, en orden
+#define LOG_MAX         64
+#define QUEUE_SIZE      8
+
+// Cada prueba usa sus propias señales: las suscripciones no se borran
+enum {
+    SIG_EVENT = AO_SIG_USER,
+    SIG_FORWARD,
+    SIG_TICK,
+    SIG_ONCE,
+    SIG_BUSY,
+    SIG_DATA,
+    SIG_ALARM,
+    SIG_RELAY,
+};
+
+typedef struct {
+    ao_t *ao;
+    uint16_t signal;
+    uint32_t arg;
+    uint64_t time_us;
+} entry_t;
+
+static entry_t event_log[LOG_MAX];
+static int event_count;
+
+static ao_executor_t high_executor, low_executor;
+static ao_t objects[6];
+static ao_event_t queues[6][QUEUE_SIZE];
+static ao_timer_t tick_timer, once_timer;
+
+/**
+ * @brief Handler de prueba: anota el evento. Con SIG_FORWARD reenvia el
+ * argumento al objeto que indica el contexto, con SIG_BUSY ocupa arg
+ * microsegundos y con SIG_RELAY publica SIG_DATA
+ */
+static void handler(ao_t *ao, const ao_event_t *event) {
+    if (event_count < LOG_MAX) { event_log[event_count] = (entry_t){ ao, event->signal, event->arg, host_time_us }; }
+    event_count++;
+
+    if (event->signal == SIG_FORWARD) { ao_post(ao->context, SIG_EVENT, event->arg); }
+    if (event->signal == SIG_BUSY) { host_time_us += event->arg; }
+    if (event->signal == SIG_RELAY) { ao_publish(SIG_DATA, event->arg); }
+}
+
+/**
+ * @brief Arranca los dos ejecutores y los objetos del arreglo con las
+ * prioridades dadas, todos en el ejecutor alto
+ */
+static void setup(const uint8_t *priorities, int count) {
+    host_task_reset();
+    host_time_us = 0;
+    event_count = 0;
+    CHECK(ao_executor_start(&high_executor, "High", 3, 512));
+    CHECK(ao_executor_start(&low_executor, "Low", 2, 512));
+    for (int i = 0; i < count; i++) {
+        CHECK(ao_start(&objects[i], &high_executor, priorities[i], "Object", handler, NULL, queues[i], QUEUE_SIZE));
+    }
+}
+
+// Corre la tarea de un ejecutor hasta que se bloquea
+static void run(ao_executor_t *executor) {
+    CHECK(host_task_run(executor->task));
+    CHECK_EQ(host_critical_nesting, 0);
+}
+
+/**
+ * @brief Siempre se atiende el objeto de mayor prioridad, en orden de llegada
+ * dentro de cada objeto, y un evento enviado desde un handler a un objeto mas
+ * prioritario se atiende antes que lo que ya estaba pendiente
+ */
+static void test_priority(void) {
+    static const uint8_t priorities[4] = { 0, 5, 17, 31 };
+    static const int order[] = { 3, 2, 1, 0 };
+
+    setup(priorities, 4);
+    // Las prioridades ocupadas y las colas que no son potencia de dos se rechazan
+    CHECK(!ao_start(&objects[4], &high_executor, 5, "Object", handler, NULL, queues[4], QUEUE_SIZE));
+    CHECK(!ao_start(&objects[4], &high_executor, 6, "Object", handler, NULL, queues[4], 6));
+    CHECK(!ao_start(&objects[4], &high_executor, AO_PRIORITIES, "Object", handler, NULL, queues[4], QUEUE_SIZE));
+
+    // Los AO_SIG_INIT de ao_start: una sola notificacion para todos
+    CHECK_EQ(host_task_notified(high_executor.task, 0), 1);
+    run(&high_executor);
+    CHECK_EQ(event_count, 4);
+    for (int i = 0; i < 4; i++) {
+        CHECK(event_log[i].ao == &objects[order[i]]);
+        CHECK_EQ(event_log[i].signal, AO_SIG_INIT);
+    }
+
+    // Eventos mezclados desde afuera del ejecutor
+    event_count = 0;
+    for (uint32_t i = 0; i < 12; i++) { CHECK(ao_post(&objects[i % 4], SIG_EVENT, i)); }
+    CHECK_EQ(host_task_notified(high_executor.task, 0), 1);
+    run(&high_executor);
+    CHECK_EQ(event_count, 12);
+    for (int i = 0; i < 12; i++) {
+        int object = order[i / 3];
+        CHECK(event_log[i].ao == &objects[object]);
+        CHECK_EQ(event_log[i].arg, (uint32_t)(object + 4 * (i % 3)));
+    }
+
+    // El objeto 5 reenvia al 31 mientras el 5 y el 0 tienen mas eventos pendientes
+    event_count = 0;
+    objects[1].context = &objects[3];
+    CHECK(ao_post(&objects[0], SIG_EVENT, 100));
+    CHECK(ao_post(&objects[1], SIG_FORWARD, 200));
+    CHECK(ao_post(&objects[1], SIG_EVENT, 201));
+    run(&high_executor);
+    CHECK_EQ(event_count, 4);
+    CHECK(event_log[0].ao == &objects[1] && event_log[0].arg == 200);
+    CHECK(event_log[1].ao == &objects[3] && event_log[1].arg == 200);
+    CHECK(event_log[2].ao == &objects[1] && event_log[2].arg == 201);
+    CHECK(event_log[3].ao == &objects[0] && event_log[3].arg == 100);
+
+
+    // Un vencimiento despierta al ejecutor sin notificacion y el reenvio encuentra el
+    // ejecutor sin nada pendiente: tampoco lo notifica. En el modelo una tarea que se
+    // bloquea vuelve a empezar sin contar la activacion, un aviso a si mismo la contaria
+    high_executor.stats.activations = 0;
+    ao_timer_init(&once_timer, &objects[1], SIG_FORWARD);
+    ao_timer_arm(&once_timer, 1, 0);
+    host_time_us = 1000;
+    run(&high_executor);
+    CHECK_EQ(event_count, 6);
+    CHECK(event_log[5].ao == &objects[3] && event_log[5].signal == SIG_EVENT);
+    CHECK_EQ(high_executor.stats.activations, 0);
+
+    // Con la cola llena se descarta sin bloquear
+    for (uint32_t i = 0; i < QUEUE_SIZE; i++) { CHECK(ao_post(&objects[0], SIG_EVENT, i)); }
+    CHECK(!ao_post(&objects[0], SIG_EVENT, QUEUE_SIZE));
+    run(&high_executor);
+    ao_stats_t stats;
+    ao_get_stats(&objects[0], &stats);
+    CHECK_EQ(stats.dropped, 1);
+    CHECK_EQ(stats.queue_max, QUEUE_SIZE);
+    CHECK_EQ(stats.dispatched, 1 + 3 + 1 + QUEUE_SIZE);
+    ao_get_stats(&objects[1], &stats);
+    CHECK_EQ(stats.dispatched, 1 + 3 + 3);
+}
+
+/**
+ * @brief Eventos de tiempo: el ejecutor duerme justo hasta el vencimiento, un
+ * periodico atrasado no acumula vencimientos y un handler largo deja vencido
+ * uno que se atiende en la misma activacion
+ */
+static void test_timers(void) {
+    static const uint8_t priorities[2] = { 1, 2 };
+
+    setup(priorities, 2);
+    run(&high_executor);
+    CHECK_EQ(host_task_timeout(high_executor.task), portMAX_DELAY);
+
+    event_count = 0;
+    ao_timer_init(&tick_timer, &objects[0], SIG_TICK);
+    ao_timer_init(&once_timer, &objects[1], SIG_ONCE);
+    ao_timer_arm(&tick_timer, pdMS_TO_TICKS(10), pdMS_TO_TICKS(10));
+    ao_timer_arm(&once_timer, pdMS_TO_TICKS(25), 0);
+    // Rearmar uno armado no lo duplica en la lista
+    ao_timer_arm(&tick_timer, pdMS_TO_TICKS(10), pdMS_TO_TICKS(10));
+    run(&high_executor);
+    CHECK_EQ(event_count, 0);
+    CHECK_EQ(host_task_timeout(high_executor.task), pdMS_TO_TICKS(10));
+
+    // El primero se atiende 2 ms tarde y el proximo igual vence a los 20: el periodo no se corre
+    host_time_us = 12000;
+    run(&high_executor);
+    CHECK_EQ(host_task_timeout(high_executor.task), pdMS_TO_TICKS(8));
+    // Los demas a tiempo en 20 y 30 ms, el de un solo vencimiento en 25
+    for (int ms = 15; ms <= 30; ms += 5) {
+        host_time_us = (uint64_t)ms * 1000;
+        run(&high_executor);
+    }
+    CHECK_EQ(event_count, 4);
+    CHECK(event_log[0].signal == SIG_TICK && event_log[0].time_us == 12000);
+    CHECK(event_log[1].signal == SIG_TICK && event_log[1].time_us == 20000);
+    CHECK(event_log[2].signal == SIG_ONCE && event_log[2].time_us == 25000);
+    CHECK(event_log[3].signal == SIG_TICK && event_log[3].time_us == 30000);
+    CHECK(!once_timer.armed);
+    CHECK_EQ(host_task_timeout(high_executor.task), pdMS_TO_TICKS(10));
+
+    // El ejecutor no corrio por 35 ms: un solo vencimiento, y el proximo un periodo despues
+    event_count = 0;
+    host_time_us = 65000;
+    run(&high_executor);
+    CHECK_EQ(event_count, 1);
+    CHECK_EQ(host_task_timeout(high_executor.task), pdMS_TO_TICKS(10));
+    host_time_us = 74000;
+    run(&high_executor);
+    CHECK_EQ(event_count, 1);
+    host_time_us = 75000;
+    run(&high_executor);
+    CHECK_EQ(event_count, 2);
+
+    // Un handler de 12 ms deja vencidos los dos de los 85 ms: se encolan antes de seguir, y el
+    // del objeto 2 pasa adelante del evento que el objeto 1 ya tenia pendiente
+    event_count = 0;
+    host_time_us = 80000;
+    ao_timer_arm(&once_timer, pdMS_TO_TICKS(5), 0);
+    CHECK(ao_post(&objects[1], SIG_BUSY, 12000));
+    CHECK(ao_post(&objects[0], SIG_EVENT, 0));
+    run(&high_executor);
+    CHECK_EQ(event_count, 4);
+    CHECK(event_log[0].signal == SIG_BUSY && event_log[1].signal == SIG_ONCE);
+    CHECK(event_log[2].signal == SIG_EVENT && event_log[3].signal == SIG_TICK);
+    CHECK_EQ(event_log[1].time_us, 92000);
+
+    // Desarmado no vence mas
+    event_count = 0;
+    ao_timer_disarm(&tick_timer);
+    host_time_us = 200000;
+    run(&high_executor);
+    CHECK_EQ(event_count, 0);
+    CHECK_EQ(host_task_timeout(high_executor.task), portMAX_DELAY);
+}
+
+/**
+ * @brief Una publicacion llega una vez a cada suscripto, en los dos
+ * ejecutores, y a nadie mas
+ */
+static void test_publish(void) {
+    static const uint8_t priorities[3] = { 4, 7, 9 };
+    BaseType_t woken = pdFALSE;
+
+    setup(priorities, 3);
+    CHECK(ao_start(&objects[3], &low_executor, 4, "Object", handler, NULL, queues[3], QUEUE_SIZE));
+    CHECK(ao_start(&objects[4], &low_executor, 1, "Object", handler, NULL, queues[4], QUEUE_SIZE));
+    run(&high_executor);
+    run(&low_executor);
+
+    // 0 y 2 en el ejecutor alto y 3 en el bajo reciben SIG_DATA; 1 y 4 no
+    ao_subscribe(&objects[0], SIG_DATA);
+    ao_subscribe(&objects[2], SIG_DATA);
+    ao_subscribe(&objects[3], SIG_DATA);
+    ao_subscribe(&objects[4], SIG_ALARM);
+    ao_subscribe(&objects[4], AO_MAX_SIGNALS);
+
+    event_count = 0;
+    ao_publish(SIG_DATA, 7);
+    ao_publish(AO_MAX_SIGNALS, 8);
+    CHECK_EQ(host_task_notified(high_executor.task, 0), 1);
+    CHECK_EQ(host_task_notified(low_executor.task, 0), 1);
+    run(&high_executor);
+    run(&low_executor);
+    CHECK_EQ(event_count, 3);
+    CHECK(event_log[0].ao == &objects[2] && event_log[1].ao == &objects[0] && event_log[2].ao == &objects[3]);
+    for (int i = 0; i < 3; i++) { CHECK(event_log[i].signal == SIG_DATA && event_log[i].arg == 7); }
+
+    // Desde una ISR
+    event_count = 0;
+    ao_publish_from_isr(SIG_ALARM, 9, &woken);
+    CHECK(woken);
+    run(&low_executor);
+    CHECK_EQ(event_count, 1);
+    CHECK(event_log[0].ao == &objects[4] && event_log[0].arg == 9);
+
+    // Desde un handler del ejecutor alto: solo se notifica al bajo
+    event_count = 0;
+    CHECK(ao_post(&objects[1], SIG_RELAY, 11));
+    CHECK_EQ(host_task_notified(high_executor.task, 0), 1);
+    run(&high_executor);
+    CHECK_EQ(host_task_notified(high_executor.task, 0), 0);
+    CHECK_EQ(host_task_notified(low_executor.task, 0), 1);
+    run(&low_executor);
+    CHECK_EQ(event_count, 4);
+    CHECK(event_log[0].ao == &objects[1] && event_log[1].ao == &objects[2] && event_log[2].ao == &objects[0]);
+    CHECK(event_log[3].ao == &objects[3] && event_log[3].arg == 11);
+}
+
+// El total de los handlers no da la vuelta despues de 2^32 us (71 minutos)
+static void test_wrap(void) {
+    static const uint8_t priorities[1] = { 0 };
+    ao_executor_stats_t stats;
+
+    setup(priorities, 1);
+    run(&high_executor);
+    CHECK(ao_post(&objects[0], SIG_BUSY, 3000000000u));
+    CHECK(ao_post(&objects[0], SIG_BUSY, 3000000000u));
+    run(&high_executor);
+
+    ao_executor_get_stats(&high_executor, &stats);
+    CHECK_EQ(stats.dispatched, 3);
+    CHECK_EQ(stats.run_us, 6000000000ull);
+    CHECK_EQ(stats.run_max_us, 3000000000u);
+    CHECK(stats.run_us > UINT32_MAX);
+}
+
+int main(void) {
+    test_priority();
+    test_timers();
+    test_publish();
+    test_wrap();
+    return check_result("ao");
+}
@@ -0,0 +1,340 @@
+#ifndef _CO_HPP_
+#define _CO_HPP_
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Corrutinas sin stack sobre una tarea de FreeRTOS. Esta cabecera solo usa la API
+// del kernel, compila igual con el port de la placa y con el port POSIX
+namespace co {
+
+class scheduler;
+
+/**
+ * @brief Lugar de una corrutina suspendida en una lista. Vive dentro del marco
+ * de la corrutina, esperar no pide memoria
+ */
+struct waiter {
+    waiter *next = nullptr;
+    std::coroutine_handle<> handle;     // Corrutina a continuar
+    scheduler *sched = nullptr;         // Planificador que la continua
+    TickType_t wake = 0;                // Tick de vencimiento en las esperas de tiempo
+};
+
+/**
+ * @brief Memoria de los marcos de corrutina
+ */
+struct frame_stats_t {
+    uint32_t frames;            // Marcos vivos
+    uint32_t bytes;             // Bytes en marcos vivos
+    uint32_t bytes_max;         // Mayor cantidad de bytes en marcos
+    uint32_t failed;            // Marcos que no se pudieron crear
+};
+
+/**
+ * @brief Parte comun de las promesas de co::task
+ */
+struct promise_base {
+    scheduler *sched = nullptr;             // Planificador, lo hereda de la corrutina que la espera
+    std::coroutine_handle<> continuation;   // Corrutina que la espera, vacia en las raices
+    bool detached = false;                  // Raiz lanzada con spawn, libera su marco al terminar
+    waiter start;                           // Lugar en la cola de listas, para arrancar las raices
+
+    // Los marcos salen del heap de FreeRTOS, sin excepciones
+    static void *operator new(std::size_t size) noexcept;
+    static void operator delete(void *ptr, std::size_t size) noexcept;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    void unhandled_exception() noexcept { configASSERT(0); }
+
+    /**
+     * @brief Al terminar sigue con la corrutina que la esperaba, sin pasar por el planificador
+     */
+    struct final_awaiter {
+        bool await_ready() noexcept { return false; }
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+            promise_base &p = h.promise();
+            std::coroutine_handle<> next = p.continuation;
+            if (p.detached) { h.destroy(); }
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+    final_awaiter final_suspend() noexcept { return {}; }
+};
+
+/**
+ * @brief Valor que devuelve la corrutina con co_return
+ */
+template <typename T>
+struct promise_value : promise_base {
+    T value{};
+    void return_value(T v) noexcept { value = std::move(v); }
+    T result() noexcept { return std::move(value); }
+};
+
+template <>
+struct promise_value<void> : promise_base {
+    void return_void() noexcept {}
+    void result() noexcept {}
+};
+
+/**
+ * @brief Corrutina. Arranca suspendida: se lanza con scheduler::spawn o se
+ * espera con co_await desde otra corrutina, que la continua al terminar
+ */
+template <typename T = void>
+class task {
+public:
+    struct promise_type : promise_value<T> {
+        task get_return_object() noexcept { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        static task get_return_object_on_allocation_failure() noexcept { return task(); }
+    };
+
+    task() noexcept = default;
+    task(task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    task &operator=(task &&other) noexcept {
+        if (this != &other) {
+            if (handle_) { handle_.destroy(); }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    task(const task &) = delete;
+    task &operator=(const task &) = delete;
+    ~task() { if (handle_) { handle_.destroy(); } }
+
+    // Sin marco (no hubo memoria) no hay nada que esperar
+    bool valid() const noexcept { return bool(handle_); }
+    bool await_ready() const noexcept { return !handle_; }
+
+    template <typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> caller) noexcept {
+        handle_.promise().sched = caller.promise().sched;
+        handle_.promise().continuation = caller;
+        return handle_;
+    }
+
+    T await_resume() noexcept {
+        if constexpr (std::is_void_v<T>) {
+            if (handle_) { handle_.promise().result(); }
+        } else {
+            return handle_ ? handle_.promise().result() : T{};
+        }
+    }
+
+    // La toma el planificador para las raices
+    std::coroutine_handle<promise_type> release() noexcept { return std::exchange(handle_, {}); }
+
+private:
+    explicit task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @brief Contadores de un planificador
+ */
+typedef struct {
+    uint32_t activations;       // Veces que la tarea se desperto
+    uint32_t resumed;           // Corrutinas continuadas
+    uint32_t spawned;           // Raices lanzadas
+} scheduler_stats_t;
+
+/**
+ * @brief Planificador: una tarea que continua las corrutinas listas y las que
+ * vencieron su espera de tiempo
+ */
+class scheduler {
+public:
+    bool start(const char *name, UBaseType_t priority, configSTACK_DEPTH_TYPE stack);
+
+    /**
+     * @brief Lanza una corrutina raiz en este planificador. Sirve antes de start
+     * @param t corrutina, el planificador se queda con su marco
+     * @return false si la corrutina no tiene marco
+     */
+    template <typename T>
+    bool spawn(task<T> &&t) {
+        auto handle = t.release();
+        if (!handle) { return false; }
+        promise_base &p = handle.promise();
+        p.sched = this;
+        p.detached = true;
+        p.start.handle = handle;
+        p.start.sched = this;
+        stats_.spawned++;
+        post(&p.start);
+        return true;
+    }
+
+    void post(waiter *w);
+    void post_from_isr(waiter *w, BaseType_t *to_higher_priority_task);
+    void sleep(waiter *w, TickType_t ticks);
+    TaskHandle_t handle() const noexcept { return task_; }
+    void get_stats(scheduler_stats_t *stats) const;
+
+private:
+    static void run(void *param);
+    waiter *pop();
+    TickType_t expire();
+
+    TaskHandle_t task_ = nullptr;
+    waiter *ready_head_ = nullptr;      // Listas para continuar, con la seccion critica
+    waiter *ready_tail_ = nullptr;
+    waiter *delayed_ = nullptr;         // Esperas de tiempo por vencimiento, solo las toca la tarea
+    scheduler_stats_t stats_ = {};
+};
+
+/**
+ * @brief Ata el lugar de espera a la corrutina que se suspende
+ */
+template <typename P>
+inline void bind(waiter &w, std::coroutine_handle<P> h) noexcept {
+    w.handle = h;
+    w.sched = h.promise().sched;
+}
+
+/**
+ * @brief Espera en ticks del kernel: co_await co::delay(pdMS_TO_TICKS(10)).
+ * Con 0 cede el lugar a las otras corrutinas listas
+ */
+class delay {
+public:
+    explicit delay(TickType_t ticks) noexcept : ticks_(ticks) {}
+    bool await_ready() const noexcept { return false; }
+    template <typename P>
+    void await_suspend(std::coroutine_handle<P> h) noexcept {
+        bind(node_, h);
+        if (ticks_) { node_.sched->sleep(&node_, ticks_); } else { node_.sched->post(&node_); }
+    }
+    void await_resume() const noexcept {}
+
+private:
+    TickType_t ticks_;
+    waiter node_;
+};
+
+/**
+ * @brief Aviso para una corrutina, como una notificacion de tarea: set desde
+ * tareas, corrutinas o interrupciones y co_await en una sola corrutina. Si el
+ * aviso llega antes de esperar, la espera no suspende
+ */
+class event {
+public:
+    class awaiter {
+    public:
+        explicit awaiter(event &ev) noexcept : ev_(ev) {}
+        bool await_ready() const noexcept { return false; }
+        template <typename P>
+        bool await_suspend(std::coroutine_handle<P> h) noexcept {
+            bind(node_, h);
+            return ev_.wait(&node_);
+        }
+        void await_resume() const noexcept {}
+
+    private:
+        event &ev_;
+        waiter node_;
+    };
+
+    awaiter operator co_await() noexcept { return awaiter(*this); }
+    void set();
+    void set_from_isr(BaseType_t *to_higher_priority_task);
+
+private:
+    bool wait(waiter *w);
+    waiter *waiting_ = nullptr;
+    bool set_ = false;
+};
+
+/**
+ * @brief Cola de N elementos para una corrutina: send desde tareas, corrutinas o
+ * interrupciones sin bloquear, co_await receive() en una sola corrutina
+ */
+template <typename T, std::size_t N>
+class channel {
+public:
+    class awaiter {
+    public:
+        explicit awaiter(channel &ch) noexcept : ch_(ch) {}
+        bool await_ready() const noexcept { return false; }
+        template <typename P>
+        bool await_suspend(std::coroutine_handle<P> h) noexcept {
+            bind(node_, h);
+            bool suspend;
+            taskENTER_CRITICAL();
+            suspend = ch_.head_ == ch_.tail_;
+            if (suspend) { ch_.waiting_ = &node_; }
+            taskEXIT_CRITICAL();
+            return suspend;
+        }
+        T await_resume() noexcept {
+            taskENTER_CRITICAL();
+            T item = std::move(ch_.items_[ch_.tail_++ % N]);
+            taskEXIT_CRITICAL();
+            return item;
+        }
+
+    private:
+        channel &ch_;
+        waiter node_;
+    };
+
+    awaiter receive() noexcept { return awaiter(*this); }
+
+    /**
+     * @brief Agrega un elemento y continua a la corrutina que espera
+     * @return false si la cola estaba llena y el elemento se descarto
+     */
+    bool send(const T &item) {
+        waiter *w;
+        taskENTER_CRITICAL();
+        bool ok = push(item, &w);
+        taskEXIT_CRITICAL();
+        if (w) { w->sched->post(w); }
+        return ok;
+    }
+
+    bool send_from_isr(const T &item, BaseType_t *to_higher_priority_task) {
+        waiter *w;
+        UBaseType_t irq = taskENTER_CRITICAL_FROM_ISR();
+        bool ok = push(item, &w);
+        taskEXIT_CRITICAL_FROM_ISR(irq);
+        if (w) { w->sched->post_from_isr(w, to_higher_priority_task); }
+        return ok;
+    }
+
+    uint32_t dropped() const noexcept { return dropped_; }
+
+private:
+    // Se llama con la seccion critica tomada
+    bool push(const T &item, waiter **w) {
+        *w = nullptr;
+        if (head_ - tail_ >= N) {
+            dropped_++;
+            return false;
+        }
+        items_[head_++ % N] = item;
+        *w = std::exchange(waiting_, nullptr);
+        return true;
+    }
+
+    T items_[N];
+    uint32_t head_ = 0;
+    uint32_t tail_ = 0;
+    waiter *waiting_ = nullptr;
+    uint32_t dropped_ = 0;
+};
+
+void get_frame_stats(frame_stats_t *stats);
+
+}
+
+#endif
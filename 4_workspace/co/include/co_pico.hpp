@@ -0,0 +1,88 @@
+#ifndef _CO_PICO_HPP_
+#define _CO_PICO_HPP_
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#include "co.hpp"
+
+// Esperas que completa el hardware del Pico: alarmas del timer y transferencias I2C por interrupcion
+namespace co {
+
+/**
+ * @brief Espera en microsegundos con una alarma del timer, para las demoras
+ * menores a un tick: co_await co::sleep_us(600)
+ */
+class sleep_us {
+public:
+    explicit sleep_us(uint32_t us) noexcept : us_(us) {}
+    bool await_ready() const noexcept { return !us_; }
+    template <typename P>
+    bool await_suspend(std::coroutine_handle<P> h) noexcept {
+        bind(node_, h);
+        return arm();
+    }
+    void await_resume() const noexcept {}
+
+private:
+    bool arm();
+    static int64_t alarm(alarm_id_t id, void *data);
+    uint32_t us_;
+    waiter node_;
+};
+
+/**
+ * @brief Transferencia I2C por interrupcion: escribe tx_len bytes y, si rx_len
+ * no es 0, repite el arranque y lee rx_len bytes. Termina siempre con STOP.
+ * Las transferencias de un bus se encolan y salen de a una
+ */
+class i2c_transfer {
+public:
+    i2c_transfer(i2c_inst_t *i2c, uint8_t addr, const uint8_t *tx, size_t tx_len, uint8_t *rx, size_t rx_len) noexcept
+        : i2c_(i2c), addr_(addr), tx_(tx), rx_(rx), tx_len_(tx_len), rx_len_(rx_len) {}
+    bool await_ready() const noexcept { return !tx_len_ && !rx_len_; }
+    template <typename P>
+    void await_suspend(std::coroutine_handle<P> h) noexcept {
+        bind(node_, h);
+        submit();
+    }
+    // Bytes transferidos o PICO_ERROR_GENERIC si el dispositivo no respondio
+    int await_resume() const noexcept { return result_; }
+
+private:
+    friend struct i2c_bus;
+    void submit();
+
+    i2c_transfer *next_ = nullptr;      // Siguiente en la cola del bus
+    i2c_inst_t *i2c_;
+    uint8_t addr_;
+    const uint8_t *tx_;
+    uint8_t *rx_;
+    size_t tx_len_;
+    size_t rx_len_;
+    size_t queued_ = 0;                 // Palabras escritas en la FIFO de comandos
+    size_t received_ = 0;               // Bytes leidos
+    bool abort_ = false;
+    int result_ = PICO_ERROR_GENERIC;
+    waiter node_;
+};
+
+/**
+ * @brief Escritura I2C que espera suspendida: co_await co::i2c_write(i2c0, 0x27, buf, 3)
+ */
+inline i2c_transfer i2c_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len) {
+    return i2c_transfer(i2c, addr, src, len, nullptr, 0);
+}
+
+/**
+ * @brief Escritura de un registro y lectura de los datos en la misma transferencia
+ */
+inline i2c_transfer i2c_write_read(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_len) {
+    return i2c_transfer(i2c, addr, src, src_len, dst, dst_len);
+}
+
+void i2c_async_init(i2c_inst_t *i2c);
+
+}
+
+#endif
@@ -0,0 +1,221 @@
+#include "co.hpp"
+
+namespace co {
+
+// Memoria de los marcos, la actualizan todas las corrutinas
+static frame_stats_t frame_stats;
+
+/**
+ * @brief Marco de una corrutina, del heap de FreeRTOS
+ * @param size bytes del marco, los calcula el compilador
+ * @return nullptr si no hay memoria, la corrutina devuelve una co::task vacia
+ */
+void *promise_base::operator new(std::size_t size) noexcept {
+    void *ptr = pvPortMalloc(size);
+    taskENTER_CRITICAL();
+    if (ptr) {
+        frame_stats.frames++;
+        frame_stats.bytes += size;
+        if (frame_stats.bytes > frame_stats.bytes_max) { frame_stats.bytes_max = frame_stats.bytes; }
+    } else {
+        frame_stats.failed++;
+    }
+    taskEXIT_CRITICAL();
+    return ptr;
+}
+
+/**
+ * @brief Libera el marco de una corrutina
+ * @param ptr marco
+ * @param size bytes del marco
+ */
+void promise_base::operator delete(void *ptr, std::size_t size) noexcept {
+    taskENTER_CRITICAL();
+    frame_stats.frames--;
+    frame_stats.bytes -= size;
+    taskEXIT_CRITICAL();
+    vPortFree(ptr);
+}
+
+/**
+ * @brief Copia de los contadores de memoria de los marcos
+ * @param stats destino de la copia
+ */
+void get_frame_stats(frame_stats_t *stats) {
+    taskENTER_CRITICAL();
+    *stats = frame_stats;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Crea la tarea del planificador
+ * @param name nombre de la tarea
+ * @param priority prioridad de la tarea
+ * @param stack stack en palabras, el de la corrutina mas profunda entre dos esperas
+ * @return false si no se pudo crear la tarea
+ */
+bool scheduler::start(const char *name, UBaseType_t priority, configSTACK_DEPTH_TYPE stack) {
+    return xTaskCreate(run, name, stack, this, priority, &task_) == pdPASS;
+}
+
+/**
+ * @brief Pone una corrutina en la cola de listas. Desde tareas y corrutinas
+ * @param w lugar de espera de la corrutina
+ */
+void scheduler::post(waiter *w) {
+    bool wake;
+    w->next = nullptr;
+    taskENTER_CRITICAL();
+    wake = !ready_head_;
+    if (ready_tail_) { ready_tail_->next = w; } else { ready_head_ = w; }
+    ready_tail_ = w;
+    taskEXIT_CRITICAL();
+
+    // Desde sus propias corrutinas la tarea ya esta despierta
+    if (wake && task_ && xTaskGetCurrentTaskHandle() != task_) { xTaskNotifyGive(task_); }
+}
+
+/**
+ * @brief Pone una corrutina en la cola de listas desde una interrupcion
+ * @param w lugar de espera de la corrutina
+ * @param to_higher_priority_task se pone en pdTRUE si hay que cambiar de tarea
+ */
+void scheduler::post_from_isr(waiter *w, BaseType_t *to_higher_priority_task) {
+    bool wake;
+    w->next = nullptr;
+    UBaseType_t irq = taskENTER_CRITICAL_FROM_ISR();
+    wake = !ready_head_;
+    if (ready_tail_) { ready_tail_->next = w; } else { ready_head_ = w; }
+    ready_tail_ = w;
+    taskEXIT_CRITICAL_FROM_ISR(irq);
+
+    if (wake && task_) { vTaskNotifyGiveFromISR(task_, to_higher_priority_task); }
+}
+
+/**
+ * @brief Ticks hasta el vencimiento de una espera
+ * @param w lugar de espera
+ * @param now tick actual
+ * @return 0 si ya vencio. Mas de medio rango hacia adelante es un vencimiento que ya paso
+ */
+static inline TickType_t remaining(const waiter *w, TickType_t now) {
+    TickType_t left = w->wake - now;
+    return left < portMAX_DELAY / 2 ? left : 0;
+}
+
+/**
+ * @brief Agrega una espera de tiempo, ordenada por vencimiento. Solo desde las
+ * corrutinas de este planificador
+ * @param w lugar de espera de la corrutina
+ * @param ticks ticks hasta el vencimiento
+ */
+void scheduler::sleep(waiter *w, TickType_t ticks) {
+    TickType_t now = xTaskGetTickCount();
+    waiter **link = &delayed_;
+
+    w->wake = now + ticks;
+    while (*link && remaining(*link, now) <= ticks) { link = &(*link)->next; }
+    w->next = *link;
+    *link = w;
+}
+
+/**
+ * @brief Saca la primera corrutina de la cola de listas
+ * @return nullptr si no hay ninguna
+ */
+waiter *scheduler::pop() {
+    taskENTER_CRITICAL();
+    waiter *w = ready_head_;
+    if (w) {
+        ready_head_ = w->next;
+        if (!ready_head_) { ready_tail_ = nullptr; }
+    }
+    taskEXIT_CRITICAL();
+    return w;
+}
+
+/**
+ * @brief Continua las esperas de tiempo vencidas
+ * @return ticks hasta el proximo vencimiento, portMAX_DELAY si no hay esperas
+ */
+TickType_t scheduler::expire() {
+    while (delayed_) {
+        TickType_t left = remaining(delayed_, xTaskGetTickCount());
+        if (left) { return left; }
+        waiter *w = delayed_;
+        delayed_ = w->next;
+        stats_.resumed++;
+        w->handle.resume();
+    }
+    return portMAX_DELAY;
+}
+
+/**
+ * @brief Tarea del planificador: continua las listas en orden de llegada, despues
+ * las esperas vencidas, y duerme hasta el proximo aviso o vencimiento
+ * @param param puntero al planificador
+ */
+void scheduler::run(void *param) {
+    scheduler *self = static_cast<scheduler *>(param);
+
+    while (1) {
+        waiter *w;
+        while ((w = self->pop())) {
+            self->stats_.resumed++;
+            w->handle.resume();
+        }
+        TickType_t wait = self->expire();
+        // Lo que continuaron las esperas vencidas pudo dejar corrutinas listas
+        if (self->ready_head_) { continue; }
+        ulTaskNotifyTake(pdTRUE, wait);
+        self->stats_.activations++;
+    }
+}
+
+/**
+ * @brief Copia de los contadores del planificador
+ * @param stats destino de la copia
+ */
+void scheduler::get_stats(scheduler_stats_t *stats) const {
+    taskENTER_CRITICAL();
+    *stats = stats_;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Continua a la corrutina que espera o deja el aviso pendiente
+ */
+void event::set() {
+    taskENTER_CRITICAL();
+    waiter *w = std::exchange(waiting_, nullptr);
+    if (!w) { set_ = true; }
+    taskEXIT_CRITICAL();
+    if (w) { w->sched->post(w); }
+}
+
+/**
+ * @brief Igual que set, desde una interrupcion
+ * @param to_higher_priority_task se pone en pdTRUE si hay que cambiar de tarea
+ */
+void event::set_from_isr(BaseType_t *to_higher_priority_task) {
+    UBaseType_t irq = taskENTER_CRITICAL_FROM_ISR();
+    waiter *w = std::exchange(waiting_, nullptr);
+    if (!w) { set_ = true; }
+    taskEXIT_CRITICAL_FROM_ISR(irq);
+    if (w) { w->sched->post_from_isr(w, to_higher_priority_task); }
+}
+
+/**
+ * @brief Consume el aviso pendiente o anota a la corrutina que espera
+ * @param w lugar de espera de la corrutina
+ * @return true si la corrutina tiene que suspenderse
+ */
+bool event::wait(waiter *w) {
+    taskENTER_CRITICAL();
+    bool suspend = !set_;
+    if (suspend) { waiting_ = w; } else { set_ = false; }
+    taskEXIT_CRITICAL();
+    return suspend;
+}
+
+}
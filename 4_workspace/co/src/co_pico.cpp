@@ -0,0 +1,180 @@
+#include "hardware/irq.h"
+
+#include "co_pico.hpp"
+
+// Profundidad de las FIFO del controlador I2C
+#define CO_I2C_FIFO     16
+
+namespace co {
+
+/**
+ * @brief Arma la alarma de la espera
+ * @return false si no hace falta suspender: el tiempo ya paso, o no quedaban
+ * alarmas libres y se espero activamente
+ */
+bool sleep_us::arm() {
+    alarm_id_t id = add_alarm_in_us(us_, alarm, this, false);
+    if (id > 0) { return true; }
+    if (id < 0) { busy_wait_us_32(us_); }
+    return false;
+}
+
+/**
+ * @brief Callback de la alarma, corre en la interrupcion del timer
+ * @param id alarma que vencio
+ * @param data la espera
+ * @return 0 para no repetir la alarma
+ */
+int64_t sleep_us::alarm(alarm_id_t id, void *data) {
+    BaseType_t to_higher_priority_task = pdFALSE;
+    sleep_us *self = static_cast<sleep_us *>(data);
+    self->node_.sched->post_from_isr(&self->node_, &to_higher_priority_task);
+    portYIELD_FROM_ISR(to_higher_priority_task);
+    return 0;
+}
+
+/**
+ * @brief Estado de un bus: la transferencia en curso y las que esperan
+ */
+struct i2c_bus {
+    i2c_transfer *current;
+    i2c_transfer *pending;
+    i2c_transfer *pending_tail;
+
+    void begin(i2c_hw_t *hw);
+    void feed(i2c_hw_t *hw);
+    void irq(i2c_hw_t *hw);
+};
+
+static i2c_bus buses[NUM_I2CS];
+
+/**
+ * @brief Arranca la transferencia en curso, el resto lo hace la interrupcion
+ * @param hw registros del controlador
+ */
+void i2c_bus::begin(i2c_hw_t *hw) {
+    hw->enable = 0;
+    hw->tar = current->addr_;
+    hw->enable = 1;
+    (void)hw->clr_intr;
+    hw->rx_tl = 0;          // RX_FULL con el primer byte
+    hw->tx_tl = 0;          // TX_EMPTY con la FIFO vacia
+    current->i2c_->restart_on_next = false;
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS | I2C_IC_INTR_MASK_M_TX_EMPTY_BITS |
+                    (current->rx_len_ ? I2C_IC_INTR_MASK_M_RX_FULL_BITS : 0);
+}
+
+/**
+ * @brief Escribe en la FIFO los datos y los pedidos de lectura que entran. Los
+ * pedidos de lectura pendientes no superan la FIFO de recepcion
+ * @param hw registros del controlador
+ */
+void i2c_bus::feed(i2c_hw_t *hw) {
+    i2c_transfer *t = current;
+    size_t total = t->tx_len_ + t->rx_len_;
+    bool blocked = false;
+
+    while (!t->abort_ && t->queued_ < total && hw->txflr < CO_I2C_FIFO) {
+        uint32_t cmd;
+        if (t->queued_ < t->tx_len_) {
+            cmd = t->tx_[t->queued_];
+        } else {
+            if (t->queued_ - t->tx_len_ - t->received_ >= CO_I2C_FIFO) {
+                blocked = true;
+                break;
+            }
+            cmd = I2C_IC_DATA_CMD_CMD_BITS;
+            if (t->queued_ == t->tx_len_ && t->tx_len_) { cmd |= I2C_IC_DATA_CMD_RESTART_BITS; }
+        }
+        if (t->queued_ == total - 1) { cmd |= I2C_IC_DATA_CMD_STOP_BITS; }
+        hw->data_cmd = cmd;
+        t->queued_++;
+    }
+
+    // Sin nada para escribir, TX_EMPTY quedaria activa; vuelve con RX_FULL si estaba frenada
+    if (t->abort_ || t->queued_ == total || blocked) {
+        hw_clear_bits(&hw->intr_mask, I2C_IC_INTR_MASK_M_TX_EMPTY_BITS);
+    } else {
+        hw_set_bits(&hw->intr_mask, I2C_IC_INTR_MASK_M_TX_EMPTY_BITS);
+    }
+}
+
+/**
+ * @brief Atiende la interrupcion del controlador
+ * @param hw registros del controlador
+ */
+void i2c_bus::irq(i2c_hw_t *hw) {
+    i2c_transfer *t = current;
+    uint32_t stat = hw->intr_stat;
+
+    if (!t) {
+        hw->intr_mask = 0;
+        return;
+    }
+
+    while (t->received_ < t->rx_len_ && hw->rxflr) { t->rx_[t->received_++] = (uint8_t)hw->data_cmd; }
+
+    if (stat & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        // Sin ACK: el controlador vacia la FIFO y manda STOP, se termina con STOP_DET
+        (void)hw->clr_tx_abrt;
+        t->abort_ = true;
+    }
+
+    if (!(stat & I2C_IC_INTR_STAT_R_STOP_DET_BITS)) {
+        feed(hw);
+        return;
+    }
+
+    (void)hw->clr_stop_det;
+    hw->intr_mask = 0;
+    t->result_ = t->abort_ || t->received_ < t->rx_len_ ? PICO_ERROR_GENERIC : (int)(t->tx_len_ + t->rx_len_);
+
+    // Arranca la siguiente del bus antes de avisar
+    current = pending;
+    if (current) {
+        pending = current->next_;
+        if (!pending) { pending_tail = nullptr; }
+        begin(hw);
+    }
+
+    BaseType_t to_higher_priority_task = pdFALSE;
+    t->node_.sched->post_from_isr(&t->node_, &to_higher_priority_task);
+    portYIELD_FROM_ISR(to_higher_priority_task);
+}
+
+static void i2c0_irq(void) { buses[0].irq(i2c_get_hw(i2c0)); }
+static void i2c1_irq(void) { buses[1].irq(i2c_get_hw(i2c1)); }
+
+/**
+ * @brief Encola la transferencia, o la arranca si el bus esta libre
+ */
+void i2c_transfer::submit() {
+    i2c_bus &bus = buses[i2c_get_index(i2c_)];
+    next_ = nullptr;
+    taskENTER_CRITICAL();
+    if (!bus.current) {
+        bus.current = this;
+        bus.begin(i2c_get_hw(i2c_));
+    } else if (bus.pending_tail) {
+        bus.pending_tail->next_ = this;
+        bus.pending_tail = this;
+    } else {
+        bus.pending = bus.pending_tail = this;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Instala la interrupcion del bus. Va despues de i2c_init y antes de la
+ * primera transferencia. Las funciones bloqueantes del SDK no se pueden mezclar
+ * con transferencias en curso en el mismo bus
+ * @param i2c bus (i2c0 o i2c1)
+ */
+void i2c_async_init(i2c_inst_t *i2c) {
+    uint num = I2C0_IRQ + i2c_get_index(i2c);
+    i2c_get_hw(i2c)->intr_mask = 0;
+    irq_set_exclusive_handler(num, i2c_get_index(i2c) ? i2c1_irq : i2c0_irq);
+    irq_set_enabled(num, true);
+}
+
+}
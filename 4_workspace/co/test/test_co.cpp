@@ -0,0 +1,228 @@
+#include <cstdio>
+
+#include "check.h"
+#include "co.hpp"
+
+// Prioridades: la tarea de la prueba pasa adelante del planificador
+#define TEST_PRIORITY   3
+#define CO_PRIORITY     2
+// Corrutinas a la vez en la prueba de memoria
+#define MANY            1000
+// Elementos que manda la interrupcion simulada, uno por tick
+#define ISR_ITEMS       20
+
+static co::scheduler sched;
+
+// Orden en que corren las corrutinas
+static int trace[16];
+static int trace_count;
+
+static int sum_result;
+static TickType_t wakes[3];
+static int wake_count;
+static int finished;
+
+static co::event isr_event;
+static co::channel<uint32_t, 4> isr_channel;
+static co::channel<uint32_t, 4> task_channel;
+// Tick en el que la interrupcion simulada da el aviso y desde el que manda elementos
+static TickType_t isr_event_tick = portMAX_DELAY;
+static TickType_t isr_send_tick = portMAX_DELAY;
+static TickType_t isr_wake_tick;
+static uint32_t isr_received[ISR_ITEMS];
+static int isr_count;
+
+static void mark(int value) {
+    if (trace_count < 16) { trace[trace_count] = value; }
+    trace_count++;
+}
+
+// Interrupcion simulada en cada tick: un aviso y una rafaga de elementos
+static void isr(void) {
+    BaseType_t woken = pdFALSE;
+    TickType_t now = xTaskGetTickCountFromISR();
+
+    if (now == isr_event_tick) { isr_event.set_from_isr(&woken); }
+    if (now >= isr_send_tick && now - isr_send_tick < ISR_ITEMS) { isr_channel.send_from_isr(now - isr_send_tick, &woken); }
+    portYIELD_FROM_ISR(woken);
+}
+
+co::task<int> square(int x) {
+    co_await co::delay(0);
+    co_return x * x;
+}
+
+co::task<int> sum_squares(int n) {
+    int sum = 0;
+    for (int i = 1; i <= n; i++) { sum += co_await square(i); }
+    co_return sum;
+}
+
+co::task<> sum_root(void) {
+    sum_result = co_await sum_squares(10);
+}
+
+co::task<> sleeper(TickType_t ticks) {
+    co_await co::delay(ticks);
+    // Cede el lugar desde una espera vencida: tiene que seguir en el mismo tick
+    co_await co::delay(0);
+    wakes[wake_count++] = ticks;
+    // El tick en que desperto, relativo a la prueba, va en la parte alta
+    wakes[wake_count - 1] |= xTaskGetTickCount() << 8;
+}
+
+co::task<> self_event(void) {
+    static co::event ev;
+    ev.set();
+    co_await ev;
+    mark(1);
+}
+
+co::task<> marker(int value) {
+    mark(value);
+    co_return;
+}
+
+co::task<> isr_waiter(void) {
+    co_await isr_event;
+    isr_wake_tick = xTaskGetTickCount();
+}
+
+co::task<> isr_reader(void) {
+    while (isr_count < ISR_ITEMS) { isr_received[isr_count++] = co_await isr_channel.receive(); }
+}
+
+co::task<> task_reader(void) {
+    for (int i = 0; i < 4; i++) { mark(100 + (int)co_await task_channel.receive()); }
+}
+
+co::task<> many(TickType_t ticks) {
+    co_await co::delay(ticks);
+    finished++;
+}
+
+/**
+ * @brief Corrutinas anidadas con valor de vuelta: cada co_await de square cede
+ * el lugar con delay(0) y sigue en el mismo planificador
+ */
+static void test_nested(void) {
+    CHECK(sched.spawn(sum_root()));
+    vTaskDelay(pdMS_TO_TICKS(10));
+    CHECK_EQ(sum_result, 385);
+}
+
+/**
+ * @brief Esperas de tiempo exactas con el tick virtual, en orden de vencimiento
+ * y no de llegada
+ */
+static void test_delays(void) {
+    TickType_t start = xTaskGetTickCount();
+
+    sched.spawn(sleeper(30));
+    sched.spawn(sleeper(10));
+    sched.spawn(sleeper(20));
+    vTaskDelay(pdMS_TO_TICKS(50));
+    CHECK_EQ(wake_count, 3);
+    for (int i = 0; i < 3; i++) {
+        TickType_t ticks = 10 * (i + 1);
+        CHECK_EQ(wakes[i] & 0xFF, ticks);
+        CHECK_EQ(wakes[i] >> 8, start + ticks);
+    }
+}
+
+/**
+ * @brief Un aviso dado antes de esperar no suspende: la corrutina sigue antes
+ * que la lanzada despues
+ */
+static void test_event(void) {
+    trace_count = 0;
+    sched.spawn(self_event());
+    sched.spawn(marker(2));
+    vTaskDelay(pdMS_TO_TICKS(10));
+    CHECK_EQ(trace_count, 2);
+    CHECK_EQ(trace[0], 1);
+    CHECK_EQ(trace[1], 2);
+}
+
+/**
+ * @brief Aviso y elementos desde la interrupcion simulada: la corrutina sigue en
+ * el mismo tick y no se pierde ningun elemento
+ */
+static void test_isr(void) {
+    TickType_t start = xTaskGetTickCount();
+
+    sched.spawn(isr_waiter());
+    sched.spawn(isr_reader());
+    isr_event_tick = start + 5;
+    isr_send_tick = start + 10;
+    vTaskDelay(pdMS_TO_TICKS(50));
+    CHECK_EQ(isr_wake_tick, start + 5);
+    CHECK_EQ(isr_count, ISR_ITEMS);
+    for (uint32_t i = 0; i < ISR_ITEMS; i++) { CHECK_EQ(isr_received[i], i); }
+    CHECK_EQ(isr_channel.dropped(), 0);
+}
+
+/**
+ * @brief Cola llena desde una tarea mas prioritaria: se descarta lo que no
+ * entra, sin bloquear, y la corrutina recibe el resto en orden
+ */
+static void test_channel(void) {
+    trace_count = 0;
+    sched.spawn(task_reader());
+    vTaskDelay(pdMS_TO_TICKS(1));
+    for (uint32_t i = 0; i < 6; i++) { CHECK_EQ(task_channel.send(i), i < 4); }
+    CHECK_EQ(task_channel.dropped(), 2);
+    vTaskDelay(pdMS_TO_TICKS(1));
+    CHECK_EQ(trace_count, 4);
+    for (int i = 0; i < 4; i++) { CHECK_EQ(trace[i], 100 + i); }
+}
+
+/**
+ * @brief Muchas corrutinas en una sola tarea: memoria por corrutina, marcos
+ * liberados al terminar y pocas activaciones de la tarea
+ */
+static void test_many(void) {
+    co::frame_stats_t before, during, after;
+    co::scheduler_stats_t stats_before, stats_after;
+
+    co::get_frame_stats(&before);
+    sched.get_stats(&stats_before);
+    for (int i = 0; i < MANY; i++) { CHECK(sched.spawn(many(1 + i % 10))); }
+    vTaskDelay(pdMS_TO_TICKS(1));
+    co::get_frame_stats(&during);
+    vTaskDelay(pdMS_TO_TICKS(20));
+    co::get_frame_stats(&after);
+    sched.get_stats(&stats_after);
+
+    printf("%d corrutinas: %u bytes de marcos, %u por corrutina, %u activaciones de la tarea\n", MANY,
+           (unsigned)(during.bytes - before.bytes), (unsigned)((during.bytes - before.bytes) / MANY),
+           (unsigned)(stats_after.activations - stats_before.activations));
+    CHECK_EQ(finished, MANY);
+    CHECK_EQ(during.frames - before.frames, MANY);
+    CHECK_EQ(after.frames, before.frames);
+    CHECK_EQ(after.bytes, before.bytes);
+    CHECK_EQ(after.failed, 0);
+    // Una activacion para la rafaga de spawn y una por cada tick con vencimientos
+    CHECK(stats_after.activations - stats_before.activations <= 11);
+}
+
+static void test_task(void *params) {
+    (void)params;
+    test_nested();
+    test_delays();
+    test_event();
+    test_isr();
+    test_channel();
+    test_many();
+    vTaskEndScheduler();
+}
+
+int main(void) {
+    host_port_isr = isr;
+    host_port_tick_limit = 10000;
+    CHECK(sched.start("Co", CO_PRIORITY, 512));
+    CHECK(xTaskCreate(test_task, "Test", 512, NULL, TEST_PRIORITY, NULL) == pdPASS);
+    vTaskStartScheduler();
+    CHECK(!host_port_timed_out);
+    return check_result("co");
+}
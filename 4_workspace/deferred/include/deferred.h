@@ -0,0 +1,66 @@
+#ifndef _DEFERRED_H_
+#define _DEFERRED_H_
+
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+// Los tamaños de stack que genera stack_usage.py reemplazan a los de la biblioteca
+#if __has_include("task_stacks.h")
+#include "task_stacks.h"
+#endif
+
+// Trabajos pendientes por nivel, potencia de dos
+#define DEFERRED_QUEUE_SIZE     16
+
+// Stack de cada tarea de trabajo
+#ifndef DEFERRED_STACK_SIZE
+#define DEFERRED_STACK_SIZE     (2 * configMINIMAL_STACK_SIZE)
+#endif
+
+/**
+ * @brief Niveles de trabajo diferido, cada uno con su cola y su tarea
+ */
+typedef enum {
+    DEFERRED_HIGH,              // Control: corre antes que cualquier tarea de la aplicacion
+    DEFERRED_LOW,               // Interfaz y registro: puede esperar a las tareas de medicion
+    DEFERRED_LEVELS
+} deferred_level_t;
+
+/**
+ * @brief Tiempos de un nivel. Los de ISR los carga deferred_isr_exit. Los
+ * totales son de 64 bits: con 32 bits daban la vuelta a los 71 minutos
+ */
+typedef struct {
+    uint32_t posted;            // Trabajos encolados
+    uint32_t dropped;           // Trabajos descartados con la cola llena
+    uint32_t isr_count;         // ISR medidas
+    uint64_t isr_us;            // Tiempo total dentro de las ISR
+    uint32_t isr_max_us;        // ISR mas larga
+    uint32_t executed;          // Trabajos ejecutados
+    uint64_t latency_us;        // Tiempo total entre encolar y empezar a ejecutar
+    uint32_t latency_max_us;    // Mayor espera
+    uint64_t run_us;            // Tiempo total ejecutando trabajos
+    uint32_t run_max_us;        // Trabajo mas largo
+} deferred_stats_t;
+
+/**
+ * @brief Marca el inicio de una ISR para medir su duracion
+ * @return marca de tiempo a pasar a deferred_isr_exit
+ */
+static inline uint32_t deferred_isr_enter(void) {
+    return time_us_32();
+}
+
+// Prototipos de funciones
+bool deferred_init(UBaseType_t high_priority, UBaseType_t low_priority);
+bool deferred_post_from_isr(deferred_level_t level, PendedFunction_t function, void *context, uint32_t arg,
+                            BaseType_t *to_higher_priority_task);
+bool deferred_post(deferred_level_t level, PendedFunction_t function, void *context, uint32_t arg);
+void deferred_isr_exit(deferred_level_t level, uint32_t start);
+void deferred_get_stats(deferred_level_t level, deferred_stats_t *stats);
+void deferred_reset_stats(deferred_level_t level);
+
+#endif
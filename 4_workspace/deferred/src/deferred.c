@@ -0,0 +1,182 @@
+#include <string.h>
+#include "deferred.h"
+
+/**
+ * @brief Un trabajo pendiente
+ */
+typedef struct {
+    PendedFunction_t function;
+    void *context;
+    uint32_t arg;
+    uint32_t posted_us;         // Momento en que se encolo
+} deferred_item_t;
+
+/**
+ * @brief Cola y tarea de un nivel
+ */
+typedef struct {
+    deferred_item_t items[DEFERRED_QUEUE_SIZE];
+    uint32_t head;              // Proximo lugar a escribir, solo con la seccion critica
+    uint32_t tail;              // Proximo lugar a leer, solo con la seccion critica
+    TaskHandle_t worker;
+    deferred_stats_t stats;
+} deferred_queue_t;
+
+static deferred_queue_t queues[DEFERRED_LEVELS];
+
+/**
+ * @brief Agrega un trabajo a la cola. Se llama con la seccion critica tomada
+ * @param queue puntero a la cola
+ * @param function funcion a ejecutar
+ * @param context primer argumento de la funcion
+ * @param arg segundo argumento de la funcion
+ * @return false si la cola esta llena
+ */
+static inline bool deferred_push(deferred_queue_t *queue, PendedFunction_t function, void *context, uint32_t arg) {
+    if (queue->head - queue->tail >= DEFERRED_QUEUE_SIZE) {
+        queue->stats.dropped++;
+        return false;
+    }
+    deferred_item_t *item = &queue->items[queue->head++ % DEFERRED_QUEUE_SIZE];
+    item->function = function;
+    item->context = context;
+    item->arg = arg;
+    item->posted_us = time_us_32();
+    queue->stats.posted++;
+    return true;
+}
+
+/**
+ * @brief Tarea de un nivel: ejecuta los trabajos en orden hasta vaciar la cola
+ * @param params puntero a la cola del nivel
+ */
+static void __not_in_flash_func(deferred_task)(void *params) {
+    deferred_queue_t *queue = params;
+    deferred_item_t item;
+
+    while (1) {
+        // Una notificacion por rafaga, la da el primer trabajo con la cola vacia
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (1) {
+            taskENTER_CRITICAL();
+            bool empty = queue->head == queue->tail;
+            if (!empty) { item = queue->items[queue->tail++ % DEFERRED_QUEUE_SIZE]; }
+            taskEXIT_CRITICAL();
+            if (empty) { break; }
+
+            uint32_t start = time_us_32();
+            item.function(item.context, item.arg);
+            uint32_t end = time_us_32();
+
+            // Solo esta tarea escribe estos campos
+            deferred_stats_t *stats = &queue->stats;
+            uint32_t latency = start - item.posted_us;
+            uint32_t run = end - start;
+            stats->executed++;
+            stats->latency_us += latency;
+            stats->run_us += run;
+            if (latency > stats->latency_max_us) { stats->latency_max_us = latency; }
+            if (run > stats->run_max_us) { stats->run_max_us = run; }
+        }
+    }
+}
+
+/**
+ * @brief Crea las tareas de trabajo diferido. Llamar antes de vTaskStartScheduler
+ * @param high_priority prioridad de la tarea de DEFERRED_HIGH
+ * @param low_priority prioridad de la tarea de DEFERRED_LOW
+ * @return true si se pudieron crear las tareas
+ */
+bool deferred_init(UBaseType_t high_priority, UBaseType_t low_priority) {
+    static const char *names[DEFERRED_LEVELS] = { "DeferHi", "DeferLo" };
+    const UBaseType_t priorities[DEFERRED_LEVELS] = { high_priority, low_priority };
+
+    for (int i = 0; i < DEFERRED_LEVELS; i++) {
+        memset(&queues[i], 0, sizeof(queues[i]));
+        if (xTaskCreate(deferred_task, names[i], DEFERRED_STACK_SIZE, &queues[i], priorities[i], &queues[i].worker) != pdPASS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Encola un trabajo desde una ISR. La tarea del nivel se notifica solo
+ * si la cola estaba vacia, una rafaga toca el kernel una sola vez
+ * @param level nivel del trabajo
+ * @param function funcion a ejecutar en la tarea, con la firma de xTimerPendFunctionCall
+ * @param context primer argumento de la funcion
+ * @param arg segundo argumento de la funcion
+ * @param to_higher_priority_task se pone en pdTRUE si hay que cambiar de tarea
+ * @return false si la cola estaba llena y el trabajo se descarto
+ */
+bool __not_in_flash_func(deferred_post_from_isr)(deferred_level_t level, PendedFunction_t function, void *context,
+                                                 uint32_t arg, BaseType_t *to_higher_priority_task) {
+    deferred_queue_t *queue = &queues[level];
+
+    UBaseType_t state = taskENTER_CRITICAL_FROM_ISR();
+    bool wake = queue->head == queue->tail;
+    bool ok = deferred_push(queue, function, context, arg);
+    taskEXIT_CRITICAL_FROM_ISR(state);
+
+    if (ok && wake) { vTaskNotifyGiveFromISR(queue->worker, to_higher_priority_task); }
+    return ok;
+}
+
+/**
+ * @brief Encola un trabajo desde una tarea
+ * @param level nivel del trabajo
+ * @param function funcion a ejecutar en la tarea del nivel
+ * @param context primer argumento de la funcion
+ * @param arg segundo argumento de la funcion
+ * @return false si la cola estaba llena y el trabajo se descarto
+ */
+bool deferred_post(deferred_level_t level, PendedFunction_t function, void *context, uint32_t arg) {
+    deferred_queue_t *queue = &queues[level];
+
+    taskENTER_CRITICAL();
+    bool wake = queue->head == queue->tail;
+    bool ok = deferred_push(queue, function, context, arg);
+    taskEXIT_CRITICAL();
+
+    if (ok && wake) { xTaskNotifyGive(queue->worker); }
+    return ok;
+}
+
+/**
+ * @brief Marca el final de una ISR y acumula su duracion en el nivel
+ * @param level nivel al que se atribuye la ISR
+ * @param start valor devuelto por deferred_isr_enter
+ */
+void __not_in_flash_func(deferred_isr_exit)(deferred_level_t level, uint32_t start) {
+    deferred_stats_t *stats = &queues[level].stats;
+    uint32_t elapsed = time_us_32() - start;
+
+    UBaseType_t state = taskENTER_CRITICAL_FROM_ISR();
+    stats->isr_count++;
+    stats->isr_us += elapsed;
+    if (elapsed > stats->isr_max_us) { stats->isr_max_us = elapsed; }
+    taskEXIT_CRITICAL_FROM_ISR(state);
+}
+
+/**
+ * @brief Copia los tiempos de un nivel
+ * @param level nivel
+ * @param stats puntero donde se copian
+ */
+void deferred_get_stats(deferred_level_t level, deferred_stats_t *stats) {
+    taskENTER_CRITICAL();
+    *stats = queues[level].stats;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Reinicia los tiempos de un nivel
+ * @param level nivel
+ */
+void deferred_reset_stats(deferred_level_t level) {
+    taskENTER_CRITICAL();
+    memset(&queues[level].stats, 0, sizeof(queues[level].stats));
+    taskEXIT_CRITICAL();
+}
@@ -0,0 +1,59 @@
+// clock_gettime con -std=c11
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <time.h>
+
+#include "check.h"
+#include "deferred.h"
+
+// Rafagas por medicion
+#define ROUNDS      200000
+
+static uint32_t executed;
+
+static void job(void *context, uint32_t arg) {
+    (void)context;
+    executed += arg;
+}
+
+static double now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+/**
+ * @brief Costo de la biblioteca por trabajo: encolar desde la ISR, notificar,
+ * sacar de la cola, ejecutar y medir. No incluye el cambio de contexto de FreeRTOS
+ * @param burst trabajos por rafaga
+ * @return nanosegundos por trabajo
+ */
+static double measure(int burst) {
+    TaskHandle_t worker = host_task_find("DeferHi");
+    BaseType_t woken;
+    double start = now_ns();
+
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < burst; i++) { deferred_post_from_isr(DEFERRED_HIGH, job, NULL, 1, &woken); }
+        host_task_run(worker);
+    }
+    return (now_ns() - start) / ((double)ROUNDS * burst);
+}
+
+int main(void) {
+    static const int bursts[] = { 1, 4, 16 };
+    uint32_t expected = 0;
+
+    deferred_init(configMAX_PRIORITIES - 1, 1);
+    host_task_run(host_task_find("DeferHi"));
+
+    printf("%-8s %14s\n", "rafaga", "por trabajo");
+    for (size_t i = 0; i < sizeof(bursts) / sizeof(bursts[0]); i++) {
+        double cost = measure(bursts[i]);
+        expected += ROUNDS * bursts[i];
+        printf("%-8d %11.1f ns\n", bursts[i], cost);
+    }
+    CHECK_EQ(executed, expected);
+    return check_result("deferred_bench");
+}
@@ -0,0 +1,164 @@
+#include <string.h>
+
+#include "check.h"
+#include "deferred.h"
+
+// Trabajos ejecutados, en orden
+#define LOG_MAX     64
+
+typedef struct {
+    void *context;
+    uint32_t arg;
+    uint64_t start_us;
+} job_t;
+
+static job_t job_log[LOG_MAX];
+static int job_count;
+
+static TaskHandle_t high, low;
+
+/**
+ * @brief Trabajo de prueba: se anota y ocupa arg microsegundos
+ */
+static void job(void *context, uint32_t arg) {
+    if (job_count < LOG_MAX) { job_log[job_count] = (job_t){ context, arg, host_time_us }; }
+    job_count++;
+    host_time_us += arg;
+}
+
+static void setup(void) {
+    host_task_reset();
+    host_time_us = 1000;
+    job_count = 0;
+    CHECK(deferred_init(configMAX_PRIORITIES - 1, 1));
+    high = host_task_find("DeferHi");
+    low = host_task_find("DeferLo");
+    CHECK(high && low && uxTaskPriorityGet(high) > uxTaskPriorityGet(low));
+    // Las tareas arrancan y se bloquean esperando trabajo
+    CHECK(host_task_run(high) && host_task_run(low));
+}
+
+// Una rafaga notifica una sola vez y los trabajos corren en orden con sus argumentos
+static void test_burst(void) {
+    deferred_stats_t stats;
+    BaseType_t woken = pdFALSE;
+    int context[3];
+
+    setup();
+    for (uint32_t i = 0; i < 3; i++) {
+        CHECK(deferred_post_from_isr(DEFERRED_HIGH, job, &context[i], 10 + i, &woken));
+    }
+    CHECK(woken);
+    CHECK_EQ(host_task_notified(high, 0), 1);
+    CHECK_EQ(job_count, 0);
+
+    CHECK(host_task_run(high));
+    CHECK_EQ(job_count, 3);
+    for (int i = 0; i < 3; i++) {
+        CHECK(job_log[i].context == &context[i]);
+        CHECK_EQ(job_log[i].arg, 10 + i);
+    }
+    CHECK_EQ(host_task_notified(high, 0), 0);
+
+    // La cola quedo vacia: el proximo trabajo vuelve a notificar
+    CHECK(deferred_post(DEFERRED_HIGH, job, NULL, 0));
+    CHECK_EQ(host_task_notified(high, 0), 1);
+    deferred_get_stats(DEFERRED_HIGH, &stats);
+    CHECK_EQ(stats.posted, 4);
+    CHECK_EQ(stats.executed, 3);
+    CHECK_EQ(host_critical_nesting, 0);
+}
+
+// Espera y duracion de cada trabajo, exactas con el reloj simulado
+static void test_times(void) {
+    deferred_stats_t stats;
+
+    setup();
+    deferred_post(DEFERRED_HIGH, job, NULL, 40);        // Encolado en 1000
+    host_time_us += 100;
+    deferred_post(DEFERRED_HIGH, job, NULL, 70);        // Encolado en 1100
+    host_time_us += 150;
+    host_task_run(high);                                // Empiezan en 1250 y 1290
+
+    deferred_get_stats(DEFERRED_HIGH, &stats);
+    CHECK_EQ(stats.executed, 2);
+    CHECK_EQ(stats.latency_us, 250 + 190);
+    CHECK_EQ(stats.latency_max_us, 250);
+    CHECK_EQ(stats.run_us, 40 + 70);
+    CHECK_EQ(stats.run_max_us, 70);
+
+    // Tiempo en las ISR
+    for (uint32_t us = 1; us <= 4; us++) {
+        uint32_t start = deferred_isr_enter();
+        host_time_us += us;
+        deferred_isr_exit(DEFERRED_LOW, start);
+    }
+    deferred_get_stats(DEFERRED_LOW, &stats);
+    CHECK_EQ(stats.isr_count, 4);
+    CHECK_EQ(stats.isr_us, 1 + 2 + 3 + 4);
+    CHECK_EQ(stats.isr_max_us, 4);
+
+    deferred_reset_stats(DEFERRED_HIGH);
+    deferred_get_stats(DEFERRED_HIGH, &stats);
+    CHECK_EQ(stats.executed + stats.posted + stats.run_us + stats.latency_us, 0);
+    CHECK_EQ(host_critical_nesting, 0);
+}
+
+// Con la cola llena el trabajo se descarta y se cuenta; los niveles no se mezclan
+static void test_full(void) {
+    deferred_stats_t stats;
+    BaseType_t woken = pdFALSE;
+
+    setup();
+    for (int i = 0; i < DEFERRED_QUEUE_SIZE; i++) {
+        CHECK(deferred_post_from_isr(DEFERRED_LOW, job, NULL, i, &woken));
+    }
+    CHECK(!deferred_post_from_isr(DEFERRED_LOW, job, NULL, 99, &woken));
+    CHECK(deferred_post_from_isr(DEFERRED_HIGH, job, NULL, 100, &woken));
+
+    host_task_run(high);
+    CHECK_EQ(job_count, 1);
+    CHECK_EQ(job_log[0].arg, 100);
+
+    host_task_run(low);
+    CHECK_EQ(job_count, 1 + DEFERRED_QUEUE_SIZE);
+    CHECK_EQ(job_log[DEFERRED_QUEUE_SIZE].arg, DEFERRED_QUEUE_SIZE - 1);
+    deferred_get_stats(DEFERRED_LOW, &stats);
+    CHECK_EQ(stats.posted, DEFERRED_QUEUE_SIZE);
+    CHECK_EQ(stats.dropped, 1);
+    CHECK_EQ(stats.executed, DEFERRED_QUEUE_SIZE);
+
+    // Muchas vueltas a la cola, de a rafagas de distinto largo
+    uint32_t posted = 0;
+    for (int round = 0; round < 1000; round++) {
+        for (int i = 0; i <= round % DEFERRED_QUEUE_SIZE; i++, posted++) {
+            CHECK(deferred_post(DEFERRED_LOW, job, NULL, 0));
+        }
+        host_task_run(low);
+    }
+    CHECK_EQ(job_count, 1 + DEFERRED_QUEUE_SIZE + posted);
+}
+
+// Los totales no dan la vuelta despues de 2^32 us (71 minutos)
+static void test_wrap(void) {
+    deferred_stats_t stats;
+
+    setup();
+    deferred_post(DEFERRED_LOW, job, NULL, 3000000000u);
+    deferred_post(DEFERRED_LOW, job, NULL, 3000000000u);
+    host_task_run(low);
+
+    deferred_get_stats(DEFERRED_LOW, &stats);
+    CHECK_EQ(stats.run_us, 6000000000ull);
+    CHECK_EQ(stats.run_max_us, 3000000000u);
+    CHECK_EQ(stats.latency_us, 3000000000ull);
+    CHECK(stats.run_us > UINT32_MAX);
+}
+
+int main(void) {
+    test_burst();
+    test_times();
+    test_full();
+    test_wrap();
+    return check_result("deferred");
+}
@@ -0,0 +1,80 @@
+#ifndef _DSP_H_
+#define _DSP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Coeficientes por etapa de un biquad Q15: b0, 0, b1, b2, a1, a2. El cero deja
+// los pares alineados a palabra para las instrucciones SIMD
+#define DSP_BIQUAD_Q15_COEFFS   6
+// Coeficientes por etapa de un biquad Q31: b0, b1, b2, a1, a2
+#define DSP_BIQUAD_Q31_COEFFS   5
+// Estado por etapa de un biquad: x[n-1], x[n-2], y[n-1], y[n-2]
+#define DSP_BIQUAD_STATE        4
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+/**
+ * @brief Cascada de biquads en forma directa I con valores Q15. Los
+ * coeficientes van escalados por 2^-post_shift, asi entran valores entre -2 y 2,
+ * y a1 y a2 van con el signo cambiado: y = b0 x0 + b1 x1 + b2 x2 + a1 y1 + a2 y2
+ */
+typedef struct {
+    const q15_t *coeffs;        // DSP_BIQUAD_Q15_COEFFS por etapa, alineados a palabra
+    q15_t *state;               // DSP_BIQUAD_STATE por etapa
+    uint8_t stages;
+    uint8_t post_shift;
+} dsp_biquad_q15_t;
+
+/**
+ * @brief Cascada de biquads en forma directa I con valores Q31, mismo formato
+ * de coeficientes que la Q15 sin el cero de relleno
+ */
+typedef struct {
+    const q31_t *coeffs;        // DSP_BIQUAD_Q31_COEFFS por etapa
+    q31_t *state;               // DSP_BIQUAD_STATE por etapa
+    uint8_t stages;
+    uint8_t post_shift;
+} dsp_biquad_q31_t;
+
+/**
+ * @brief FIR Q15 con decimacion: calcula una salida cada decimation entradas.
+ * La linea de demora esta escrita dos veces, asi la ventana siempre es contigua
+ */
+typedef struct {
+    const q15_t *coeffs;        // h[0] a h[taps - 1], alineados a palabra
+    q15_t *delay;               // 2 * taps valores
+    uint16_t taps;
+    uint16_t pos;               // Lugar del valor mas nuevo
+    uint16_t decimation;
+    uint16_t phase;             // Entradas que faltan para la proxima salida
+} dsp_fir_q15_t;
+
+/**
+ * @brief Promedio movil Q15 de 2^bits muestras, con la suma acumulada
+ */
+typedef struct {
+    q15_t *buf;                 // Ultimas 2^bits muestras
+    int32_t sum;
+    uint16_t pos;
+    uint8_t bits;
+} dsp_average_q15_t;
+
+// Prototipos de funciones
+void dsp_adc_to_q15(const uint16_t *src, q15_t *dst, size_t count);
+
+void dsp_biquad_lowpass(float fc, float fs, float q, float coeffs[5]);
+void dsp_biquad_coeffs_q15(const float coeffs[5], uint8_t post_shift, q15_t *out);
+void dsp_biquad_coeffs_q31(const float coeffs[5], uint8_t post_shift, q31_t *out);
+void dsp_biquad_q15_init(dsp_biquad_q15_t *f, const q15_t *coeffs, q15_t *state, uint8_t stages, uint8_t post_shift);
+void dsp_biquad_q15_process(dsp_biquad_q15_t *f, const q15_t *src, q15_t *dst, size_t count);
+void dsp_biquad_q31_init(dsp_biquad_q31_t *f, const q31_t *coeffs, q31_t *state, uint8_t stages, uint8_t post_shift);
+void dsp_biquad_q31_process(dsp_biquad_q31_t *f, const q31_t *src, q31_t *dst, size_t count);
+
+void dsp_fir_q15_init(dsp_fir_q15_t *f, const q15_t *coeffs, q15_t *delay, uint16_t taps, uint16_t decimation);
+size_t dsp_fir_q15_process(dsp_fir_q15_t *f, const q15_t *src, q15_t *dst, size_t count);
+void dsp_average_q15_init(dsp_average_q15_t *m, q15_t *buf, uint8_t bits);
+void dsp_average_q15_process(dsp_average_q15_t *m, const q15_t *src, q15_t *dst, size_t count);
+
+#endif
@@ -0,0 +1,175 @@
+#include <math.h>
+#include "dsp_simd.h"
+
+// M_PI no esta definido en C11 estricto
+#define DSP_PI      3.14159265358979323846f
+
+/**
+ * @brief Diseña un pasabajos de segundo orden (Audio EQ Cookbook de R. Bristow-Johnson)
+ * @param fc frecuencia de corte en Hz
+ * @param fs frecuencia de muestreo en Hz
+ * @param q factor de calidad, 0,7071 para Butterworth
+ * @param coeffs b0, b1, b2, a1 y a2 normalizados por a0, con a1 y a2 con el signo cambiado
+ */
+void dsp_biquad_lowpass(float fc, float fs, float q, float coeffs[5]) {
+    float w0 = 2.0f * DSP_PI * fc / fs;
+    float cw = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float a0 = 1.0f + alpha;
+
+    coeffs[0] = (1.0f - cw) / 2.0f / a0;
+    coeffs[1] = (1.0f - cw) / a0;
+    coeffs[2] = coeffs[0];
+    coeffs[3] = 2.0f * cw / a0;
+    coeffs[4] = -(1.0f - alpha) / a0;
+}
+
+/**
+ * @brief Pasa los coeficientes de una etapa a Q15
+ * @param coeffs b0, b1, b2, a1 y a2 (ver dsp_biquad_lowpass)
+ * @param post_shift escala de los coeficientes, 1 para valores entre -2 y 2
+ * @param out DSP_BIQUAD_Q15_COEFFS coeficientes
+ */
+void dsp_biquad_coeffs_q15(const float coeffs[5], uint8_t post_shift, q15_t *out) {
+    float scale = (float)(1 << (15 - post_shift));
+    out[0] = dsp_sat15(lroundf(coeffs[0] * scale));
+    out[1] = 0;
+    for (int i = 1; i < 5; i++) { out[i + 1] = dsp_sat15(lroundf(coeffs[i] * scale)); }
+}
+
+/**
+ * @brief Pasa los coeficientes de una etapa a Q31
+ * @param coeffs b0, b1, b2, a1 y a2 (ver dsp_biquad_lowpass)
+ * @param post_shift escala de los coeficientes, 1 para valores entre -2 y 2
+ * @param out DSP_BIQUAD_Q31_COEFFS coeficientes
+ */
+void dsp_biquad_coeffs_q31(const float coeffs[5], uint8_t post_shift, q31_t *out) {
+    double scale = (double)(1u << (31 - post_shift));
+    for (int i = 0; i < 5; i++) { out[i] = dsp_sat31(llround(coeffs[i] * scale)); }
+}
+
+/**
+ * @brief Inicializa una cascada Q15 con el estado en cero
+ * @param f puntero al filtro
+ * @param coeffs DSP_BIQUAD_Q15_COEFFS coeficientes por etapa
+ * @param state DSP_BIQUAD_STATE valores por etapa
+ * @param stages cantidad de etapas
+ * @param post_shift escala de los coeficientes
+ */
+void dsp_biquad_q15_init(dsp_biquad_q15_t *f, const q15_t *coeffs, q15_t *state, uint8_t stages, uint8_t post_shift) {
+    f->coeffs = coeffs;
+    f->state = state;
+    f->stages = stages;
+    f->post_shift = post_shift;
+    memset(state, 0, stages * DSP_BIQUAD_STATE * sizeof(q15_t));
+}
+
+/**
+ * @brief Filtra un bloque. Cada etapa recorre el bloque completo, asi los
+ * coeficientes y el estado quedan en registros
+ * @param f puntero al filtro
+ * @param src muestras de entrada
+ * @param dst muestras filtradas, puede ser el mismo arreglo que src
+ * @param count cantidad de muestras
+ */
+void dsp_biquad_q15_process(dsp_biquad_q15_t *f, const q15_t *src, q15_t *dst, size_t count) {
+    const q15_t *c = f->coeffs;
+    q15_t *s = f->state;
+    int shift = 15 - f->post_shift;
+    int64_t round = (int64_t)1 << (shift - 1);
+
+    for (int stage = 0; stage < f->stages; stage++, c += DSP_BIQUAD_Q15_COEFFS, s += DSP_BIQUAD_STATE) {
+#if DSP_SIMD
+        // Pares (b1, b2) y (a1, a2) contra (x1, x2) y (y1, y2): un SMLALD cada uno
+        int32_t b0 = c[0];
+        uint32_t b12 = dsp_load2(c + 2);
+        uint32_t a12 = dsp_load2(c + 4);
+        uint32_t x = dsp_load2(s);
+        uint32_t y = dsp_load2(s + 2);
+
+        for (size_t i = 0; i < count; i++) {
+            q15_t x0 = src[i];
+            int64_t acc = dsp_smlald(b12, x, round + b0 * x0);
+            q15_t y0 = dsp_sat15(dsp_smlald(a12, y, acc) >> shift);
+            // El valor nuevo entra en la mitad baja y el mas viejo se descarta
+            x = (uint16_t)x0 | (x << 16);
+            y = (uint16_t)y0 | (y << 16);
+            dst[i] = y0;
+        }
+        memcpy(s, &x, sizeof(x));
+        memcpy(s + 2, &y, sizeof(y));
+#else
+        q15_t x1 = s[0], x2 = s[1], y1 = s[2], y2 = s[3];
+
+        for (size_t i = 0; i < count; i++) {
+            q15_t x0 = src[i];
+            int64_t acc = round + (int32_t)c[0] * x0 + (int32_t)c[2] * x1 + (int32_t)c[3] * x2 +
+                          (int32_t)c[4] * y1 + (int32_t)c[5] * y2;
+            q15_t y0 = dsp_sat15(acc >> shift);
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            dst[i] = y0;
+        }
+        s[0] = x1;
+        s[1] = x2;
+        s[2] = y1;
+        s[3] = y2;
+#endif
+        // Las etapas siguientes filtran la salida de la anterior
+        src = dst;
+    }
+}
+
+/**
+ * @brief Inicializa una cascada Q31 con el estado en cero
+ * @param f puntero al filtro
+ * @param coeffs DSP_BIQUAD_Q31_COEFFS coeficientes por etapa
+ * @param state DSP_BIQUAD_STATE valores por etapa
+ * @param stages cantidad de etapas
+ * @param post_shift escala de los coeficientes
+ */
+void dsp_biquad_q31_init(dsp_biquad_q31_t *f, const q31_t *coeffs, q31_t *state, uint8_t stages, uint8_t post_shift) {
+    f->coeffs = coeffs;
+    f->state = state;
+    f->stages = stages;
+    f->post_shift = post_shift;
+    memset(state, 0, stages * DSP_BIQUAD_STATE * sizeof(q31_t));
+}
+
+/**
+ * @brief Filtra un bloque Q31. Los productos de 32x32 bits no tienen version
+ * SIMD, el mismo codigo sirve para los dos nucleos
+ * @param f puntero al filtro
+ * @param src muestras de entrada
+ * @param dst muestras filtradas, puede ser el mismo arreglo que src
+ * @param count cantidad de muestras
+ */
+void dsp_biquad_q31_process(dsp_biquad_q31_t *f, const q31_t *src, q31_t *dst, size_t count) {
+    const q31_t *c = f->coeffs;
+    q31_t *s = f->state;
+    int shift = 31 - f->post_shift;
+    int64_t round = (int64_t)1 << (shift - 1);
+
+    for (int stage = 0; stage < f->stages; stage++, c += DSP_BIQUAD_Q31_COEFFS, s += DSP_BIQUAD_STATE) {
+        q31_t x1 = s[0], x2 = s[1], y1 = s[2], y2 = s[3];
+
+        for (size_t i = 0; i < count; i++) {
+            q31_t x0 = src[i];
+            int64_t acc = round + (int64_t)c[0] * x0 + (int64_t)c[1] * x1 + (int64_t)c[2] * x2 +
+                          (int64_t)c[3] * y1 + (int64_t)c[4] * y2;
+            q31_t y0 = dsp_sat31(acc >> shift);
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            dst[i] = y0;
+        }
+        s[0] = x1;
+        s[1] = x2;
+        s[2] = y1;
+        s[3] = y2;
+        src = dst;
+    }
+}
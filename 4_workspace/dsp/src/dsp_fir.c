@@ -0,0 +1,99 @@
+#include "dsp_simd.h"
+
+/**
+ * @brief Pasa muestras del ADC de 12 bits, como las deja el DMA, a Q15 centrado
+ * en media escala. Puede convertir el buffer en el lugar
+ * @param src muestras del ADC, el bit de error se ignora
+ * @param dst muestras Q15, puede ser el mismo buffer que src
+ * @param count cantidad de muestras
+ */
+void dsp_adc_to_q15(const uint16_t *src, q15_t *dst, size_t count) {
+    for (size_t i = 0; i < count; i++) { dst[i] = (q15_t)(((src[i] & 0x0FFF) << 4) - 0x8000); }
+}
+
+/**
+ * @brief Inicializa un FIR con la linea de demora en cero
+ * @param f puntero al filtro
+ * @param coeffs taps coeficientes Q15, alineados a palabra
+ * @param delay buffer de 2 * taps valores
+ * @param taps cantidad de coeficientes
+ * @param decimation entradas por cada salida, 1 sin decimacion
+ */
+void dsp_fir_q15_init(dsp_fir_q15_t *f, const q15_t *coeffs, q15_t *delay, uint16_t taps, uint16_t decimation) {
+    f->coeffs = coeffs;
+    f->delay = delay;
+    f->taps = taps;
+    f->pos = 0;
+    f->decimation = decimation;
+    f->phase = decimation;
+    memset(delay, 0, 2 * taps * sizeof(q15_t));
+}
+
+/**
+ * @brief Filtra y decima un bloque. Solo se calcula la convolucion en las
+ * entradas que generan una salida
+ * @param f puntero al filtro
+ * @param src muestras de entrada
+ * @param dst muestras de salida, puede ser el mismo arreglo que src
+ * @param count cantidad de muestras de entrada
+ * @return cantidad de muestras de salida
+ */
+size_t dsp_fir_q15_process(dsp_fir_q15_t *f, const q15_t *src, q15_t *dst, size_t count) {
+    const q15_t *h = f->coeffs;
+    uint16_t taps = f->taps;
+    size_t out = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        // La muestra nueva se escribe en las dos mitades, la ventana empieza por ella
+        f->pos = f->pos ? f->pos - 1 : taps - 1;
+        f->delay[f->pos] = f->delay[f->pos + taps] = src[i];
+        if (--f->phase) { continue; }
+        f->phase = f->decimation;
+
+        const q15_t *w = f->delay + f->pos;
+        int64_t acc = 1 << 14;
+        uint16_t k = 0;
+#if DSP_SIMD
+        // Dos coeficientes por SMLALD
+        for (; k + 1 < taps; k += 2) { acc = dsp_smlald(dsp_load2(h + k), dsp_load2(w + k), acc); }
+#endif
+        for (; k < taps; k++) { acc += (int32_t)h[k] * w[k]; }
+        dst[out++] = dsp_sat15(acc >> 15);
+    }
+    return out;
+}
+
+/**
+ * @brief Inicializa un promedio movil con la ventana en cero
+ * @param m puntero al promedio
+ * @param buf buffer de 2^bits muestras
+ * @param bits logaritmo en base 2 del largo de la ventana
+ */
+void dsp_average_q15_init(dsp_average_q15_t *m, q15_t *buf, uint8_t bits) {
+    m->buf = buf;
+    m->sum = 0;
+    m->pos = 0;
+    m->bits = bits;
+    memset(buf, 0, (1u << bits) * sizeof(q15_t));
+}
+
+/**
+ * @brief Promedia un bloque: suma la muestra nueva y resta la que sale de la
+ * ventana, el costo no depende del largo
+ * @param m puntero al promedio
+ * @param src muestras de entrada
+ * @param dst promedios, puede ser el mismo arreglo que src
+ * @param count cantidad de muestras
+ */
+void dsp_average_q15_process(dsp_average_q15_t *m, const q15_t *src, q15_t *dst, size_t count) {
+    uint16_t mask = (1u << m->bits) - 1;
+    int32_t half = (1 << m->bits) >> 1;
+
+    for (size_t i = 0; i < count; i++) {
+        q15_t x = src[i];
+        m->sum += x - m->buf[m->pos];
+        m->buf[m->pos] = x;
+        m->pos = (m->pos + 1) & mask;
+        dst[i] = (q15_t)((m->sum + half) >> m->bits);
+    }
+}
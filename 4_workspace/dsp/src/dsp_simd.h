@@ -0,0 +1,56 @@
+#ifndef _DSP_SIMD_H_
+#define _DSP_SIMD_H_
+
+#include <stdint.h>
+#include <string.h>
+#include "dsp.h"
+
+// En el Cortex-M33 del RP2350 se usan las instrucciones SIMD de 16 bits de la
+// extension DSP. En el RP2040 y en la PC el camino es escalar. En la PC se
+// puede compilar el camino empaquetado con -DDSP_SIMD=1, con las instrucciones
+// emuladas en C, para compararlo con el escalar
+#if defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+#include <arm_acle.h>
+#define DSP_SIMD    1
+
+/**
+ * @brief SMLALD: suma al acumulador de 64 bits los productos de las mitades
+ * bajas y de las mitades altas de dos pares de Q15
+ */
+static inline int64_t dsp_smlald(uint32_t a, uint32_t b, int64_t acc) {
+    return __smlald((int32_t)a, (int32_t)b, acc);
+}
+#else
+#ifndef DSP_SIMD
+#define DSP_SIMD    0
+#endif
+
+static inline int64_t dsp_smlald(uint32_t a, uint32_t b, int64_t acc) {
+    return acc + (int32_t)(int16_t)a * (int16_t)b + (int32_t)(int16_t)(a >> 16) * (int16_t)(b >> 16);
+}
+#endif
+
+/**
+ * @brief Lee dos Q15 consecutivos como un par, el primero en la mitad baja
+ */
+static inline uint32_t dsp_load2(const q15_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief Satura a Q15
+ */
+static inline q15_t dsp_sat15(int64_t v) {
+    return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (q15_t)v;
+}
+
+/**
+ * @brief Satura a Q31
+ */
+static inline q31_t dsp_sat31(int64_t v) {
+    return v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : (q31_t)v;
+}
+
+#endif
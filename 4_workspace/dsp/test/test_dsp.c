@@ -0,0 +1,256 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "check.h"
+#include "dsp.h"
+#include "dsp_simd.h"
+
+// M_PI no esta definido en C11 estricto
+#define PI              3.14159265358979323846
+
+// Muestras por prueba, en bloques de largo variable para cruzar los bordes
+#define SAMPLES         20000
+#define BLOCK_MAX       67
+#define STAGES          3
+#define AVERAGE_BITS    4
+
+static q15_t input[SAMPLES], output[SAMPLES], expected[SAMPLES];
+static q31_t input31[SAMPLES], output31[SAMPLES], expected31[SAMPLES];
+// Estado de las referencias del biquad por etapa: x[n-1], x[n-2], y[n-1], y[n-2]
+static q15_t ref_state[STAGES][4];
+static q31_t ref_state31[STAGES][4];
+
+// Generador congruencial, las senales son siempre las mismas
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+/**
+ * @brief Senal de prueba: senoidal con ruido, con tramos a fondo de escala para
+ * que los filtros saturen
+ */
+static void make_input(void) {
+    for (int i = 0; i < SAMPLES; i++) {
+        double v = 12000.0 * sin(2.0 * PI * i / 37.0) + (double)(next_random() % 8192) - 4096.0;
+        if ((i / 1000) % 5 == 4) { v = (i / 250) % 2 ? 32767.0 : -32768.0; }
+        input[i] = (q15_t)v;
+        input31[i] = (q31_t)input[i] * 65536 + (q31_t)(next_random() & 0xFFFF);
+    }
+}
+
+static q15_t sat15(int64_t v) {
+    return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (q15_t)v;
+}
+
+static q31_t sat31(int64_t v) {
+    return v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : (q31_t)v;
+}
+
+/**
+ * @brief Referencia del biquad Q15: la ecuacion en diferencias tal cual, una
+ * muestra por vez y todas las etapas juntas
+ */
+static void ref_biquad_q15(const q15_t *c, int post_shift, const q15_t *src, q15_t *dst, size_t count) {
+    q15_t (*s)[4] = ref_state;
+    int shift = 15 - post_shift;
+
+    for (size_t i = 0; i < count; i++) {
+        q15_t x = src[i];
+        for (int stage = 0; stage < STAGES; stage++) {
+            const q15_t *k = c + stage * DSP_BIQUAD_Q15_COEFFS;
+            int64_t acc = ((int64_t)1 << (shift - 1)) + (int64_t)k[0] * x + (int64_t)k[2] * s[stage][0] +
+                          (int64_t)k[3] * s[stage][1] + (int64_t)k[4] * s[stage][2] + (int64_t)k[5] * s[stage][3];
+            q15_t y = sat15(acc >> shift);
+            s[stage][1] = s[stage][0];
+            s[stage][0] = x;
+            s[stage][3] = s[stage][2];
+            s[stage][2] = y;
+            x = y;
+        }
+        dst[i] = x;
+    }
+}
+
+static void ref_biquad_q31(const q31_t *c, int post_shift, const q31_t *src, q31_t *dst, size_t count) {
+    q31_t (*s)[4] = ref_state31;
+    int shift = 31 - post_shift;
+
+    for (size_t i = 0; i < count; i++) {
+        q31_t x = src[i];
+        for (int stage = 0; stage < STAGES; stage++) {
+            const q31_t *k = c + stage * DSP_BIQUAD_Q31_COEFFS;
+            int64_t acc = ((int64_t)1 << (shift - 1)) + (int64_t)k[0] * x + (int64_t)k[1] * s[stage][0] +
+                          (int64_t)k[2] * s[stage][1] + (int64_t)k[3] * s[stage][2] + (int64_t)k[4] * s[stage][3];
+            q31_t y = sat31(acc >> shift);
+            s[stage][1] = s[stage][0];
+            s[stage][0] = x;
+            s[stage][3] = s[stage][2];
+            s[stage][2] = y;
+            x = y;
+        }
+        dst[i] = x;
+    }
+}
+
+/**
+ * @brief Referencia del FIR: convolucion directa sobre toda la senal
+ * @return cantidad de salidas
+ */
+static size_t ref_fir(const q15_t *h, int taps, int decimation, const q15_t *src, q15_t *dst, size_t count) {
+    size_t out = 0;
+    for (size_t n = decimation - 1; n < count; n += decimation) {
+        int64_t acc = 1 << 14;
+        for (int k = 0; k < taps && (size_t)k <= n; k++) { acc += (int32_t)h[k] * src[n - k]; }
+        dst[out++] = sat15(acc >> 15);
+    }
+    return out;
+}
+
+/**
+ * @brief Respuesta en modulo de una etapa en punto flotante
+ */
+static double gain(const float c[5], double f, double fs) {
+    double w = 2.0 * PI * f / fs;
+    double nr = c[0] + c[1] * cos(w) + c[2] * cos(2 * w), ni = -c[1] * sin(w) - c[2] * sin(2 * w);
+    double dr = 1.0 - c[3] * cos(w) - c[4] * cos(2 * w), di = c[3] * sin(w) + c[4] * sin(2 * w);
+    return sqrt((nr * nr + ni * ni) / (dr * dr + di * di));
+}
+
+// Conversion del ADC: media escala en cero y el bit de error ignorado
+static void test_adc(void) {
+    uint16_t adc[5] = { 0, 2048, 4095, 0x8000 | 2048, 1 };
+    q15_t q[5];
+
+    dsp_adc_to_q15(adc, q, 5);
+    CHECK_EQ(q[0], -32768);
+    CHECK_EQ(q[1], 0);
+    CHECK_EQ(q[2], 32752);
+    CHECK_EQ(q[3], 0);
+    CHECK_EQ(q[4], -32752);
+    // En el lugar
+    dsp_adc_to_q15(adc, (q15_t *)adc, 5);
+    CHECK(!memcmp(adc, q, sizeof(q)));
+}
+
+// El diseño del pasabajos: ganancia 1 en continua y -3 dB en la frecuencia de corte
+static void test_lowpass(void) {
+    float c[5];
+
+    dsp_biquad_lowpass(1000.0f, 50000.0f, 0.7071f, c);
+    printf("pasabajos 1 kHz a 50 kHz: |H(0)| = %.6f, |H(fc)| = %.6f, |H(10 fc)| = %.6f\n",
+           gain(c, 0, 50000), gain(c, 1000, 50000), gain(c, 10000, 50000));
+    CHECK(fabs(gain(c, 0, 50000) - 1.0) < 1e-4);
+    CHECK(fabs(gain(c, 1000, 50000) - sqrt(0.5)) < 1e-3);
+    // Segundo orden: -40 dB por decada
+    CHECK(gain(c, 10000, 50000) < 0.012);
+}
+
+/**
+ * @brief Filtra la senal en bloques de largo al azar, en el lugar en los bloques
+ * pares, y compara con la referencia bit a bit
+ */
+static void test_biquad(void) {
+    static const float designs[STAGES][3] = { { 1000.0f, 50000.0f, 0.7071f }, { 5000.0f, 50000.0f, 2.0f },
+                                              { 200.0f, 50000.0f, 0.5f } };
+    q15_t coeffs[STAGES * DSP_BIQUAD_Q15_COEFFS] __attribute__((aligned(4)));
+    q31_t coeffs31[STAGES * DSP_BIQUAD_Q31_COEFFS];
+    q15_t state[STAGES * DSP_BIQUAD_STATE];
+    q31_t state31[STAGES * DSP_BIQUAD_STATE];
+    dsp_biquad_q15_t f;
+    dsp_biquad_q31_t f31;
+
+    for (int post_shift = 1; post_shift <= 2; post_shift++) {
+        for (int s = 0; s < STAGES; s++) {
+            float c[5];
+            dsp_biquad_lowpass(designs[s][0], designs[s][1], designs[s][2], c);
+            dsp_biquad_coeffs_q15(c, post_shift, coeffs + s * DSP_BIQUAD_Q15_COEFFS);
+            dsp_biquad_coeffs_q31(c, post_shift, coeffs31 + s * DSP_BIQUAD_Q31_COEFFS);
+        }
+        dsp_biquad_q15_init(&f, coeffs, state, STAGES, post_shift);
+        dsp_biquad_q31_init(&f31, coeffs31, state31, STAGES, post_shift);
+        memset(ref_state, 0, sizeof(ref_state));
+        memset(ref_state31, 0, sizeof(ref_state31));
+
+        size_t block = 0;
+        for (size_t done = 0; done < SAMPLES; done += block, block = 0) {
+            block = 1 + next_random() % BLOCK_MAX;
+            if (block > SAMPLES - done) { block = SAMPLES - done; }
+            if (block % 2) {
+                dsp_biquad_q15_process(&f, input + done, output + done, block);
+            } else {
+                memcpy(output + done, input + done, block * sizeof(q15_t));
+                dsp_biquad_q15_process(&f, output + done, output + done, block);
+            }
+            dsp_biquad_q31_process(&f31, input31 + done, output31 + done, block);
+        }
+        ref_biquad_q15(coeffs, post_shift, input, expected, SAMPLES);
+        ref_biquad_q31(coeffs31, post_shift, input31, expected31, SAMPLES);
+
+        int saturated = 0;
+        for (int i = 0; i < SAMPLES; i++) { saturated += expected[i] == INT16_MAX || expected[i] == INT16_MIN; }
+        printf("biquad x%d, post_shift %d: %d muestras, %d saturadas\n", STAGES, post_shift, SAMPLES, saturated);
+        CHECK(!memcmp(output, expected, sizeof(output)));
+        CHECK(!memcmp(output31, expected31, sizeof(output31)));
+        // Con post_shift 2 los coeficientes son mas gruesos y la ganancia no llega a saturar
+        CHECK(post_shift > 1 || saturated > 0);
+    }
+}
+
+/**
+ * @brief FIR con cantidad de taps par e impar (el camino SIMD hace el ultimo solo)
+ * y con y sin decimacion, contra la convolucion directa
+ */
+static void test_fir(void) {
+    static const int configs[][2] = { { 32, 8 }, { 31, 8 }, { 7, 1 }, { 64, 3 }, { 1, 2 } };
+    q15_t h[64] __attribute__((aligned(4)));
+    q15_t delay[2 * 64] __attribute__((aligned(4)));
+    dsp_fir_q15_t f;
+
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        int taps = configs[c][0], decimation = configs[c][1];
+        // Coeficientes al azar que suman mas de 1, para saturar
+        for (int k = 0; k < taps; k++) { h[k] = (q15_t)(next_random() % 24000) - 8000; }
+        dsp_fir_q15_init(&f, h, delay, taps, decimation);
+
+        size_t out = 0, block;
+        for (size_t done = 0; done < SAMPLES; done += block) {
+            block = 1 + next_random() % BLOCK_MAX;
+            if (block > SAMPLES - done) { block = SAMPLES - done; }
+            out += dsp_fir_q15_process(&f, input + done, output + out, block);
+        }
+        size_t n = ref_fir(h, taps, decimation, input, expected, SAMPLES);
+        CHECK_EQ(out, n);
+        CHECK(!memcmp(output, expected, n * sizeof(q15_t)));
+    }
+}
+
+// Promedio movil contra la suma directa de la ventana
+static void test_average(void) {
+    q15_t buf[1 << AVERAGE_BITS];
+    dsp_average_q15_t m;
+
+    dsp_average_q15_init(&m, buf, AVERAGE_BITS);
+    memcpy(output, input, sizeof(output));
+    dsp_average_q15_process(&m, output, output, SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) {
+        int32_t sum = 0;
+        for (int k = 0; k < (1 << AVERAGE_BITS) && k <= i; k++) { sum += input[i - k]; }
+        expected[i] = (q15_t)((sum + (1 << (AVERAGE_BITS - 1))) >> AVERAGE_BITS);
+    }
+    CHECK(!memcmp(output, expected, sizeof(output)));
+}
+
+int main(void) {
+    printf("camino %s\n", DSP_SIMD ? "SIMD emulado" : "escalar");
+    make_input();
+    test_adc();
+    test_lowpass();
+    test_biquad();
+    test_fir();
+    test_average();
+    return check_result(DSP_SIMD ? "dsp_simd" : "dsp");
+}
@@ -7,7 +7,13 @@
 #define xPortSysTickHandler     isr_systick
 
 #define configUSE_PREEMPTION                    1
+/* Perfiles de compilacion del kernel, los define FREERTOS_PROFILE en CMakeLists.txt.
+ * La seleccion de tareas con CLZ solo existe en el Cortex-M33 */
+#ifdef FREERTOS_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#else
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#endif
 #define configUSE_TICKLESS_IDLE                 0
 #define configCPU_CLOCK_HZ                      150000
 #define configTICK_RATE_HZ                      1000
@@ -39,15 +45,21 @@
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY    16
 
 /* Memory allocation related definitions. */
-#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configKERNEL_PROVIDED_STATIC_MEMORY     1
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
 #define configAPPLICATION_ALLOCATED_HEAP        1
 
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK                     0
 #define configUSE_TICK_HOOK                     0
+#ifdef FREERTOS_PROFILE_CHECKED
+#define configCHECK_FOR_STACK_OVERFLOW          2
+#define configUSE_MALLOC_FAILED_HOOK            1
+#else
 #define configCHECK_FOR_STACK_OVERFLOW          0
 #define configUSE_MALLOC_FAILED_HOOK            0
+#endif
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
@@ -66,7 +78,14 @@
 #define configTIMER_TASK_STACK_DEPTH            configMINIMAL_STACK_SIZE
 
 /* Define to trap errors during development. */
+#ifdef FREERTOS_PROFILE_CHECKED
+#ifndef __ASSEMBLER__
+void vAssertCalled( const char * file, int line );
+#endif
+#define configASSERT( x )    if( ( x ) == 0 ) { vAssertCalled( __FILE__, __LINE__ ); }
+#else
 #define configASSERT( x )
+#endif
 
 /* Optional functions - most linkers will remove unused functions anyway. */
 #define INCLUDE_vTaskPrioritySet               1
@@ -78,7 +97,11 @@
 #define INCLUDE_vTaskDelay                     1
 #define INCLUDE_xTaskGetSchedulerState         1
 #define INCLUDE_xTaskGetCurrentTaskHandle      1
+#ifdef FREERTOS_PROFILE_CHECKED
+#define INCLUDE_uxTaskGetStackHighWaterMark    1
+#else
 #define INCLUDE_uxTaskGetStackHighWaterMark    0
+#endif
 #define INCLUDE_xTaskGetIdleTaskHandle         0
 #define INCLUDE_eTaskGetState                  0
 #define INCLUDE_xEventGroupSetBitFromISR       1
@@ -0,0 +1,35 @@
+/*
+ * Perfil "checked": destinos de configASSERT y de los hooks de error del
+ * kernel. Son weak para que la aplicacion pueda reemplazarlos por los suyos.
+ */
+
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Falla de un configASSERT, detiene el programa con el lugar de la falla
+ * @param file archivo del assert
+ * @param line linea del assert
+ */
+__attribute__((weak)) void vAssertCalled(const char *file, int line) {
+    panic("configASSERT en %s:%d", file, line);
+}
+
+/**
+ * @brief Una tarea piso el final de su stack
+ * @param task tarea que desbordo
+ * @param name nombre de la tarea
+ */
+__attribute__((weak)) void vApplicationStackOverflowHook(TaskHandle_t task, char *name) {
+    (void)task;
+    panic("Stack overflow en %s", name);
+}
+
+/**
+ * @brief No hay memoria para crear un objeto del kernel
+ */
+__attribute__((weak)) void vApplicationMallocFailedHook(void) {
+    panic("Sin memoria en el heap de FreeRTOS");
+}
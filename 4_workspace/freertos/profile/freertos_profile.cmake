@@ -0,0 +1,50 @@
+# Perfil de compilacion del kernel:
+#   default: las opciones de la aplicacion, igual que antes
+#   fast:    -O2, LTO, seleccion de tareas con CLZ y el camino critico del scheduler en RAM
+#   small:   -Os, LTO y seleccion de tareas con CLZ
+#   checked: configASSERT, verificacion de stack y hook de falta de memoria
+#
+# Lo usan el CMakeLists.txt del kernel y las pruebas en la PC, que compilan los
+# mismos archivos del kernel sobre otro port
+
+# Rutas absolutas: las propiedades de los archivos se buscan por ruta completa
+get_filename_component(FREERTOS_KERNEL_DIR ${CMAKE_CURRENT_LIST_DIR}/.. ABSOLUTE)
+
+# target: biblioteca con los archivos del kernel
+# core:   port del kernel, la seleccion con CLZ solo existe en RP2350_ARM_NTZ
+# profile: default, fast, small o checked
+function(freertos_profile target core profile)
+    # Las definiciones son PUBLIC: la aplicacion tiene que ver la misma configuracion que el kernel
+    target_compile_definitions(${target} PUBLIC FREERTOS_PROFILE_NAME="${profile}")
+
+    if(profile STREQUAL "fast" OR profile STREQUAL "small")
+        if(core STREQUAL "RP2350_ARM_NTZ")
+            target_compile_definitions(${target} PUBLIC FREERTOS_OPTIMISED_TASK_SELECTION=1)
+        endif()
+
+        # El port llama a vTaskSwitchContext y usa pxCurrentTCB desde assembler, que LTO no ve
+        set(FREERTOS_LTO_SOURCES event_groups.c list.c queue.c stream_buffer.c tasks.c timers.c)
+        list(TRANSFORM FREERTOS_LTO_SOURCES PREPEND ${FREERTOS_KERNEL_DIR}/)
+        set_source_files_properties(${FREERTOS_LTO_SOURCES} PROPERTIES COMPILE_OPTIONS "-flto;-ffat-lto-objects")
+        target_link_options(${target} INTERFACE -flto)
+    endif()
+
+    if(profile STREQUAL "fast")
+        target_compile_options(${target} PRIVATE -O2)
+        target_compile_definitions(${target} PUBLIC FREERTOS_PROFILE_FAST=1)
+
+        # Cada archivo del kernel vuelve a declarar sus funciones criticas en .time_critical
+        get_target_property(FREERTOS_SOURCES ${target} SOURCES)
+        list(FILTER FREERTOS_SOURCES EXCLUDE REGEX "heap_[0-9]\\.c$")
+        set_property(SOURCE ${FREERTOS_SOURCES} APPEND PROPERTY COMPILE_OPTIONS
+            -include${FREERTOS_KERNEL_DIR}/profile/freertos_ram.h)
+    elseif(profile STREQUAL "small")
+        target_compile_options(${target} PRIVATE -Os)
+        target_compile_definitions(${target} PUBLIC FREERTOS_PROFILE_SMALL=1)
+    elseif(profile STREQUAL "checked")
+        target_compile_definitions(${target} PUBLIC FREERTOS_PROFILE_CHECKED=1)
+        target_sources(${target} PRIVATE ${FREERTOS_KERNEL_DIR}/profile/freertos_checked.c)
+    elseif(NOT profile STREQUAL "default")
+        message(FATAL_ERROR "FREERTOS_PROFILE desconocido: ${profile} (default, fast, small o checked)")
+    endif()
+endfunction()
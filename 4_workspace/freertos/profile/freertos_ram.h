@@ -0,0 +1,92 @@
+#ifndef FREERTOS_RAM_H
+#define FREERTOS_RAM_H
+
+/*
+ * Perfil "fast": se incluye antes de cada archivo del kernel (-include) y
+ * vuelve a declarar las funciones del camino critico del scheduler con
+ * __not_in_flash_func. GCC toma la seccion de la primera declaracion, asi
+ * que la definicion queda en .time_critical y el SDK la copia a RAM al
+ * arrancar. Un fallo de la cache XIP en un cambio de contexto cuesta mas
+ * que toda la funcion ejecutada desde RAM.
+ *
+ * Las funciones static que llaman se inlinean con -O2 y quedan en RAM con
+ * ellas. Los prototipos tienen que coincidir con los de task.h, queue.h y
+ * list.h; si no, el compilador da error al compilar el kernel.
+ */
+
+#include "pico.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "list.h"
+
+/* Cambio de contexto, tick y listas */
+void __not_in_flash_func( vTaskSwitchContext )( void );
+BaseType_t __not_in_flash_func( xTaskIncrementTick )( void );
+BaseType_t __not_in_flash_func( xTaskRemoveFromEventList )( const List_t * const pxEventList );
+void __not_in_flash_func( vTaskPlaceOnEventList )( List_t * const pxEventList,
+                                                   const TickType_t xTicksToWait );
+void __not_in_flash_func( vTaskSuspendAll )( void );
+BaseType_t __not_in_flash_func( xTaskResumeAll )( void );
+TickType_t __not_in_flash_func( xTaskGetTickCount )( void );
+void __not_in_flash_func( vTaskInternalSetTimeOutState )( TimeOut_t * const pxTimeOut );
+BaseType_t __not_in_flash_func( xTaskCheckForTimeOut )( TimeOut_t * const pxTimeOut,
+                                                        TickType_t * const pxTicksToWait );
+void __not_in_flash_func( vListInsertEnd )( List_t * const pxList,
+                                            ListItem_t * const pxNewListItem );
+void __not_in_flash_func( vListInsert )( List_t * const pxList,
+                                         ListItem_t * const pxNewListItem );
+UBaseType_t __not_in_flash_func( uxListRemove )( ListItem_t * const pxItemToRemove );
+
+/* Notificaciones, el mecanismo mas usado desde las interrupciones */
+BaseType_t __not_in_flash_func( xTaskGenericNotify )( TaskHandle_t xTaskToNotify,
+                                                      UBaseType_t uxIndexToNotify,
+                                                      uint32_t ulValue,
+                                                      eNotifyAction eAction,
+                                                      uint32_t * pulPreviousNotificationValue );
+BaseType_t __not_in_flash_func( xTaskGenericNotifyFromISR )( TaskHandle_t xTaskToNotify,
+                                                             UBaseType_t uxIndexToNotify,
+                                                             uint32_t ulValue,
+                                                             eNotifyAction eAction,
+                                                             uint32_t * pulPreviousNotificationValue,
+                                                             BaseType_t * pxHigherPriorityTaskWoken );
+void __not_in_flash_func( vTaskGenericNotifyGiveFromISR )( TaskHandle_t xTaskToNotify,
+                                                           UBaseType_t uxIndexToNotify,
+                                                           BaseType_t * pxHigherPriorityTaskWoken );
+uint32_t __not_in_flash_func( ulTaskGenericNotifyTake )( UBaseType_t uxIndexToWaitOn,
+                                                         BaseType_t xClearCountOnExit,
+                                                         TickType_t xTicksToWait );
+
+/* Colas y semaforos */
+BaseType_t __not_in_flash_func( xQueueGenericSend )( QueueHandle_t xQueue,
+                                                     const void * const pvItemToQueue,
+                                                     TickType_t xTicksToWait,
+                                                     const BaseType_t xCopyPosition );
+BaseType_t __not_in_flash_func( xQueueGenericSendFromISR )( QueueHandle_t xQueue,
+                                                            const void * const pvItemToQueue,
+                                                            BaseType_t * const pxHigherPriorityTaskWoken,
+                                                            const BaseType_t xCopyPosition );
+BaseType_t __not_in_flash_func( xQueueGiveFromISR )( QueueHandle_t xQueue,
+                                                     BaseType_t * const pxHigherPriorityTaskWoken );
+BaseType_t __not_in_flash_func( xQueueReceive )( QueueHandle_t xQueue,
+                                                 void * const pvBuffer,
+                                                 TickType_t xTicksToWait );
+BaseType_t __not_in_flash_func( xQueueReceiveFromISR )( QueueHandle_t xQueue,
+                                                        void * const pvBuffer,
+                                                        BaseType_t * const pxHigherPriorityTaskWoken );
+BaseType_t __not_in_flash_func( xQueueSemaphoreTake )( QueueHandle_t xQueue,
+                                                       TickType_t xTicksToWait );
+
+/* Port: interrupcion del tick y secciones criticas */
+#if PICO_RP2040
+void __not_in_flash_func( xPortSysTickHandler )( void );
+void __not_in_flash_func( xPortPendSVHandler )( void );
+#else
+void __not_in_flash_func( SysTick_Handler )( void );
+void __not_in_flash_func( PendSV_Handler )( void );
+void __not_in_flash_func( vPortEnterCritical )( void );
+void __not_in_flash_func( vPortExitCritical )( void );
+#endif
+
+#endif /* FREERTOS_RAM_H */
@@ -0,0 +1,141 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "check.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+// Prioridades: la prueba por debajo de la tarea que estropea su stack
+#define TEST_PRIORITY   2
+#define VICTIM_PRIORITY 3
+// Elementos que van y vuelven entre la prueba y el eco
+#define ROUNDS          100
+
+#ifdef FREERTOS_PROFILE_CHECKED
+#define CHECKED true
+#else
+#define CHECKED false
+#endif
+
+static QueueHandle_t requests, replies;
+static StaticTask_t victim_tcb;
+static StackType_t victim_stack[configMINIMAL_STACK_SIZE];
+static TaskHandle_t victim;
+
+// Con true la proxima reserva falla, como con el heap lleno
+static bool fail_malloc;
+// Llamadas a panic y el ultimo mensaje
+static unsigned panics;
+static char panic_message[128];
+
+void *__real_malloc(size_t size);
+
+void *__wrap_malloc(size_t size) {
+    if (fail_malloc) {
+        fail_malloc = false;
+        return NULL;
+    }
+    return __real_malloc(size);
+}
+
+// Los hooks del perfil checked terminan en panic: guarda el mensaje y vuelve
+void __wrap_panic(const char *fmt, ...) {
+    va_list args;
+
+    va_start(args, fmt);
+    vsnprintf(panic_message, sizeof(panic_message), fmt, args);
+    va_end(args);
+    panics++;
+}
+
+// Devuelve cada elemento sumandole uno
+static void task_echo(void *params) {
+    uint32_t value;
+    (void)params;
+
+    while (1) {
+        xQueueReceive(requests, &value, portMAX_DELAY);
+        value++;
+        xQueueSend(replies, &value, portMAX_DELAY);
+    }
+}
+
+// Espera avisos, al bloquearse el kernel revisa el final de su stack
+static void task_victim(void *params) {
+    (void)params;
+    while (1) { ulTaskNotifyTake(pdTRUE, portMAX_DELAY); }
+}
+
+// El mismo kernel con cualquier perfil: colas entre dos tareas y esperas con vencimiento
+static void test_scheduler(void) {
+    uint32_t value;
+
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        CHECK(xQueueSend(requests, &i, 0) == pdPASS);
+        CHECK(xQueueReceive(replies, &value, 10) == pdPASS);
+        CHECK_EQ(value, i + 1);
+    }
+    TickType_t start = xTaskGetTickCount();
+    CHECK(xQueueReceive(replies, &value, 5) == pdFAIL);
+    CHECK_EQ(xTaskGetTickCount() - start, 5);
+}
+
+/**
+ * @brief Los destinos de freertos_checked.c: un configASSERT, una reserva que
+ * falla y una tarea que piso el final de su stack. En los otros perfiles no
+ * hay ninguna verificacion y nadie llama a panic
+ */
+static void test_hooks(void) {
+    static uint8_t storage[sizeof(uint32_t)];
+
+    // Sin el control de la cola: configASSERT y devuelve NULL igual
+    panics = 0;
+    CHECK(xQueueCreateStatic(1, sizeof(uint32_t), storage, NULL) == NULL);
+    printf("assert: %u llamadas, \"%s\"\n", panics, panic_message);
+    CHECK_EQ(panics > 0, CHECKED);
+    CHECK_EQ(strncmp(panic_message, "configASSERT en ", 16) == 0, CHECKED);
+
+    // Heap lleno
+    panics = 0;
+    memset(panic_message, 0, sizeof(panic_message));
+    fail_malloc = true;
+    CHECK(xQueueCreate(4, sizeof(uint32_t)) == NULL);
+    printf("sin memoria: %u llamadas, \"%s\"\n", panics, panic_message);
+    CHECK_EQ(panics, CHECKED ? 1 : 0);
+    CHECK_EQ(strcmp(panic_message, "Sin memoria en el heap de FreeRTOS") == 0, CHECKED);
+
+    // Una escritura por debajo del stack, como la de un desborde
+    panics = 0;
+    memset(panic_message, 0, sizeof(panic_message));
+    victim = xTaskCreateStatic(task_victim, "Victim", configMINIMAL_STACK_SIZE, NULL, VICTIM_PRIORITY, victim_stack,
+                               &victim_tcb);
+    CHECK_EQ(panics, 0);
+    victim_stack[0] = 0;
+    xTaskNotifyGive(victim);
+    printf("stack: %u llamadas, \"%s\"\n", panics, panic_message);
+    CHECK_EQ(panics, CHECKED ? 1 : 0);
+    CHECK_EQ(strcmp(panic_message, "Stack overflow en Victim") == 0, CHECKED);
+}
+
+static void task_test(void *params) {
+    (void)params;
+    test_scheduler();
+    test_hooks();
+    vTaskEndScheduler();
+}
+
+int main(void) {
+    host_port_tick_limit = 1000;
+    requests = xQueueCreate(1, sizeof(uint32_t));
+    replies = xQueueCreate(1, sizeof(uint32_t));
+    CHECK(requests && replies);
+    CHECK(xTaskCreate(task_echo, "Echo", configMINIMAL_STACK_SIZE, NULL, TEST_PRIORITY + 1, NULL) == pdPASS);
+    CHECK(xTaskCreate(task_test, "Test", configMINIMAL_STACK_SIZE, NULL, TEST_PRIORITY, NULL) == pdPASS);
+    printf("perfil %s\n", FREERTOS_PROFILE_NAME);
+    vTaskStartScheduler();
+    CHECK(!host_port_timed_out);
+    return check_result("freertos_" FREERTOS_PROFILE_NAME);
+}
@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+// Repeticiones de cada prueba
+#define ITERATIONS  10000
+
+// Limites de la imagen, los define el linker script del SDK
+extern char __flash_binary_start, __flash_binary_end;
+extern char __data_start__, __data_end__, __bss_start__, __bss_end__;
+
+// Tarea que mide y tareas que le responden, con mas prioridad
+TaskHandle_t bench_handle;
+TaskHandle_t notify_handle;
+TaskHandle_t isr_handle;
+
+// Colas de ida y vuelta, semaforo y mutex de las pruebas sin cambio de tarea
+QueueHandle_t request;
+QueueHandle_t reply;
+QueueHandle_t local;
+SemaphoreHandle_t semaphore;
+SemaphoreHandle_t mutex;
+
+// Interrupcion de software de la prueba de latencia
+static uint bench_irq;
+
+/**
+ * @brief Prueba del kernel
+ */
+typedef struct {
+    const char *name;           // Nombre en la tabla
+    uint32_t ops;               // Operaciones por iteracion, para el tiempo por operacion
+    void (*run)(void);          // Una iteracion
+} bench_t;
+
+/**
+ * @brief Tarea que devuelve cada notificacion
+ */
+void task_notify_peer(void *params) {
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xTaskNotifyGive(bench_handle);
+    }
+}
+
+/**
+ * @brief Tarea que devuelve cada elemento de la cola
+ */
+void task_queue_peer(void *params) {
+    uint32_t value;
+    while (1) {
+        xQueueReceive(request, &value, portMAX_DELAY);
+        xQueueSend(reply, &value, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief Tarea que despierta la interrupcion, avisa a la tarea que mide
+ */
+void task_isr_peer(void *params) {
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xTaskNotifyGive(bench_handle);
+    }
+}
+
+/**
+ * @brief Handler de la interrupcion de software
+ */
+void bench_irq_handler(void) {
+    // Variable para verificar la necesidad de un cambio tarea
+    BaseType_t to_higher_priority_task = pdFALSE;
+    vTaskNotifyGiveFromISR(isr_handle, &to_higher_priority_task);
+    // Reviso si es necesario el cambio a otra tarea
+    portYIELD_FROM_ISR(to_higher_priority_task);
+}
+
+// Ida y vuelta de una notificacion: dos cambios de tarea
+static void run_notify(void) {
+    xTaskNotifyGive(notify_handle);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+// Ida y vuelta por dos colas: dos cambios de tarea
+static void run_queue_pingpong(void) {
+    uint32_t value = 0;
+    xQueueSend(request, &value, portMAX_DELAY);
+    xQueueReceive(reply, &value, portMAX_DELAY);
+}
+
+// Envio y recepcion en la misma tarea, sin cambio de contexto
+static void run_queue_local(void) {
+    uint32_t value = 0;
+    xQueueSend(local, &value, 0);
+    xQueueReceive(local, &value, 0);
+}
+
+// Semaforo binario en la misma tarea
+static void run_semaphore(void) {
+    xSemaphoreGive(semaphore);
+    xSemaphoreTake(semaphore, 0);
+}
+
+// Mutex sin contencion
+static void run_mutex(void) {
+    xSemaphoreTake(mutex, 0);
+    xSemaphoreGive(mutex);
+}
+
+// Interrupcion que despierta a una tarea, que despierta a la que mide
+static void run_isr(void) {
+    irq_set_pending(bench_irq);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+// Seccion critica del kernel
+static void run_critical(void) {
+    taskENTER_CRITICAL();
+    taskEXIT_CRITICAL();
+}
+
+// Suspension del scheduler
+static void run_suspend(void) {
+    vTaskSuspendAll();
+    xTaskResumeAll();
+}
+
+static const bench_t benches[] = {
+    { "notificacion ida y vuelta", 2, run_notify },
+    { "cola ida y vuelta", 2, run_queue_pingpong },
+    { "cola send+receive", 1, run_queue_local },
+    { "semaforo give+take", 1, run_semaphore },
+    { "mutex take+give", 1, run_mutex },
+    { "ISR a tarea a tarea", 1, run_isr },
+    { "seccion critica", 1, run_critical },
+    { "suspend+resume all", 1, run_suspend },
+};
+
+/**
+ * @brief Tarea que corre las pruebas y muestra el informe
+ */
+void task_bench(void *params) {
+    while (1) {
+        printf("perfil %s\n", FREERTOS_PROFILE_NAME);
+        printf("flash %u B, RAM datos y funciones %u B, bss %u B\n",
+               (unsigned)(&__flash_binary_end - &__flash_binary_start),
+               (unsigned)(&__data_end__ - &__data_start__),
+               (unsigned)(&__bss_end__ - &__bss_start__));
+
+        for (size_t b = 0; b < sizeof(benches) / sizeof(benches[0]); b++) {
+            uint32_t start = time_us_32();
+            for (int i = 0; i < ITERATIONS; i++) { benches[b].run(); }
+            uint32_t elapsed = time_us_32() - start;
+            // Tiempo por operacion en ns, incluye el lazo
+            printf("%-26s %6lu ns\n", benches[b].name, elapsed * 1000 / (ITERATIONS * benches[b].ops));
+        }
+        printf("\n");
+        vTaskDelay(pdMS_TO_TICKS(5000));
+    }
+}
+
+/**
+ * @brief Programa principal
+ */
+int main(void) {
+    stdio_init_all();
+
+    // Creo los objetos del kernel
+    request = xQueueCreate(1, sizeof(uint32_t));
+    reply = xQueueCreate(1, sizeof(uint32_t));
+    local = xQueueCreate(1, sizeof(uint32_t));
+    semaphore = xSemaphoreCreateBinary();
+    mutex = xSemaphoreCreateMutex();
+
+    // Interrupcion libre del SDK, se dispara por software
+    bench_irq = user_irq_claim_unused(true);
+    irq_set_exclusive_handler(bench_irq, bench_irq_handler);
+    irq_set_enabled(bench_irq, true);
+
+    // Las tareas que responden tienen mas prioridad, cada envio es un cambio de tarea
+    xTaskCreate(task_notify_peer, "Notify", configMINIMAL_STACK_SIZE, NULL, 3, &notify_handle);
+    xTaskCreate(task_queue_peer, "Queue", configMINIMAL_STACK_SIZE, NULL, 3, NULL);
+    xTaskCreate(task_isr_peer, "Isr", configMINIMAL_STACK_SIZE, NULL, 3, &isr_handle);
+    xTaskCreate(task_bench, "Bench", 2 * configMINIMAL_STACK_SIZE, NULL, 2, &bench_handle);
+
+    // Arranca el sistema operativo
+    vTaskStartScheduler();
+    while(1);
+}
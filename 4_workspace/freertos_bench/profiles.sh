@@ -0,0 +1,21 @@
+#!/bin/sh
+# Compila el ejemplo con cada perfil de FreeRTOS y muestra el tamaño del kernel
+# y de la imagen. Los tiempos se leen de la consola de cada .uf2 en la placa.
+#
+# Uso: ./profiles.sh [perfiles...]    (por defecto: default fast small checked)
+
+set -e
+cd "$(dirname "$0")"
+PROFILES=${*:-"default fast small checked"}
+SIZE=${SIZE:-arm-none-eabi-size}
+
+printf "%-8s %10s %10s %10s %10s %10s\n" perfil "kernel" "text" "data" "bss" "uf2"
+for profile in $PROFILES; do
+    cmake -S . -B "build-$profile" -DFREERTOS_PROFILE="$profile" -DCMAKE_BUILD_TYPE=Release > /dev/null
+    cmake --build "build-$profile" -j > /dev/null
+    # Tamaño del codigo del kernel en la biblioteca, antes de que LTO y el linker descarten funciones
+    kernel=$($SIZE -t "build-$profile/freertos/libfreertos.a" | awk 'END { print $1 }')
+    set -- $($SIZE "build-$profile/freertos_bench.elf" | awk 'NR == 2 { print $1, $2, $3 }')
+    uf2=$(wc -c < "build-$profile/freertos_bench.uf2")
+    printf "%-8s %10s %10s %10s %10s %10s\n" "$profile" "$kernel" "$1" "$2" "$3" "$uf2"
+done
@@ -0,0 +1,238 @@
+#include <cstdio>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/gpio.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "co.hpp"
+#include "co_pico.hpp"
+
+// Bus y dispositivos, las mismas conexiones que el tp4
+#define I2C_PORT        i2c0
+#define I2C_SDA_PIN     4
+#define I2C_SCL_PIN     5
+#define I2C_FREQ        100000
+#define LCD_ADDR        0x27
+#define BMP280_ADDR     0x76
+#define BUTTON_PIN      15
+#define LED_PIN         PICO_DEFAULT_LED_PIN
+
+// Bits del adaptador PCF8574 del LCD
+#define LCD_BACKLIGHT   0x08
+#define LCD_ENABLE_BIT  0x04
+#define LCD_CHARACTER   1
+#define LCD_COMMAND     0
+// Tiempo de ejecucion de un comando del LCD. Los comandos menores a 4 (borrado,
+// inicio y los de arranque en 4 bits) tardan mas
+#define LCD_DELAY_US    50
+#define LCD_SLOW_US     4500
+
+// Registros del BMP280
+#define REG_DIG_T1      0x88
+#define REG_CTRL_MEAS   0xF4
+#define REG_TEMP_MSB    0xFA
+// Temperatura x1, sin presion, modo forzado
+#define CTRL_MEAS_TEMP  0x21
+// Periodo de lectura y tiempo de conversion con x1
+#define SENSOR_MS       500
+#define CONVERSION_MS   7
+
+// Periodos del LED y del reporte
+#define BLINK_MS        250
+#define REPORT_MS       5000
+
+// Stack de la unica tarea, el de la corrutina mas profunda entre dos esperas
+#define CO_STACK        256
+
+/**
+ * @brief Mensaje para la corrutina del display
+ */
+typedef struct {
+    bool page;                  // true si es el pulsador, false si es una medicion
+    float temperature;          // Temperatura en °C
+} display_msg_t;
+
+// Todas las corrutinas del ejemplo en una sola tarea
+static co::scheduler sched;
+// Mediciones y pulsador hacia el display
+static co::channel<display_msg_t, 4> display_channel;
+// Aviso del pulsador, lo da la interrupcion
+static co::event button;
+
+/**
+ * @brief Manda un byte al LCD en dos nibbles. Cada nibble es una transferencia
+ * con el pulso de enable, la corrutina queda suspendida mientras sale por el bus
+ * @param val byte a enviar
+ * @param mode LCD_COMMAND o LCD_CHARACTER
+ */
+co::task<> lcd_send_byte(uint8_t val, int mode) {
+    uint8_t high = mode | (val & 0xF0) | LCD_BACKLIGHT;
+    uint8_t low = mode | ((val << 4) & 0xF0) | LCD_BACKLIGHT;
+    uint8_t seq[6] = { high, (uint8_t)(high | LCD_ENABLE_BIT), high, low, (uint8_t)(low | LCD_ENABLE_BIT), low };
+
+    co_await co::i2c_write(I2C_PORT, LCD_ADDR, seq, 3);
+    co_await co::i2c_write(I2C_PORT, LCD_ADDR, seq + 3, 3);
+    co_await co::sleep_us(val < 0x04 && mode == LCD_COMMAND ? LCD_SLOW_US : LCD_DELAY_US);
+}
+
+/**
+ * @brief Escribe una linea completa del LCD
+ * @param line linea (0 o 1)
+ * @param text texto, se completa con espacios hasta 16 caracteres
+ */
+co::task<> lcd_line(int line, const char *text) {
+    co_await lcd_send_byte(0x80 + (line ? 0x40 : 0x00), LCD_COMMAND);
+    for (int i = 0; i < 16; i++) {
+        co_await lcd_send_byte(*text ? *text++ : ' ', LCD_CHARACTER);
+    }
+}
+
+/**
+ * @brief Display: inicializa el LCD y muestra la temperatura o los contadores
+ */
+co::task<> display(void) {
+    static const uint8_t init[] = { 0x03, 0x03, 0x03, 0x02, 0x06, 0x28, 0x0C, 0x01 };
+    char text[17];
+    float temperature = 0;
+    bool stats = false;
+
+    // Secuencia de 4 bits, la misma que lcd_init
+    for (uint8_t cmd : init) { co_await lcd_send_byte(cmd, LCD_COMMAND); }
+
+    while (1) {
+        display_msg_t msg = co_await display_channel.receive();
+        if (msg.page) {
+            stats = !stats;
+        } else {
+            temperature = msg.temperature;
+        }
+
+        if (stats) {
+            co::frame_stats_t frames;
+            co::get_frame_stats(&frames);
+            snprintf(text, sizeof(text), "%lu marcos %lu B", frames.frames, frames.bytes);
+            co_await lcd_line(0, text);
+            snprintf(text, sizeof(text), "max %lu B", frames.bytes_max);
+            co_await lcd_line(1, text);
+        } else {
+            snprintf(text, sizeof(text), "Temp: %.1f %cC", temperature, '\xDF');
+            co_await lcd_line(0, text);
+            co_await lcd_line(1, "corrutinas");
+        }
+    }
+}
+
+/**
+ * @brief Sensor: lee la calibracion y mide en modo forzado. El bus queda libre
+ * y la tarea atiende a las otras corrutinas durante la conversion
+ */
+co::task<> sensor(void) {
+    uint8_t reg = REG_DIG_T1;
+    uint8_t buf[6];
+    const uint8_t ctrl[2] = { REG_CTRL_MEAS, CTRL_MEAS_TEMP };
+
+    if (co_await co::i2c_write_read(I2C_PORT, BMP280_ADDR, &reg, 1, buf, 6) < 0) {
+        printf("BMP280 no responde\n");
+        co_return;
+    }
+    uint16_t t1 = buf[0] | buf[1] << 8;
+    int16_t t2 = buf[2] | buf[3] << 8;
+    int16_t t3 = buf[4] | buf[5] << 8;
+
+    while (1) {
+        co_await co::i2c_write(I2C_PORT, BMP280_ADDR, ctrl, 2);
+        co_await co::delay(pdMS_TO_TICKS(CONVERSION_MS));
+        reg = REG_TEMP_MSB;
+        if (co_await co::i2c_write_read(I2C_PORT, BMP280_ADDR, &reg, 1, buf, 3) == 4) {
+            // Compensacion de la seccion 8.2 del datasheet
+            int32_t raw = buf[0] << 12 | buf[1] << 4 | buf[2] >> 4;
+            int32_t var1 = ((((raw >> 3) - ((int32_t)t1 << 1))) * t2) >> 11;
+            int32_t var2 = (((((raw >> 4) - (int32_t)t1) * ((raw >> 4) - (int32_t)t1)) >> 12) * t3) >> 14;
+            display_channel.send({ false, (((var1 + var2) * 5 + 128) >> 8) / 100.0f });
+        }
+        co_await co::delay(pdMS_TO_TICKS(SENSOR_MS));
+    }
+}
+
+/**
+ * @brief Pulsador: espera el aviso de la interrupcion y cambia la pantalla
+ */
+co::task<> buttons(void) {
+    while (1) {
+        co_await button;
+        display_channel.send({ true, 0 });
+        co_await co::delay(pdMS_TO_TICKS(200));     // Antirrebote
+    }
+}
+
+/**
+ * @brief LED: parpadeo con esperas del kernel
+ */
+co::task<> blink(void) {
+    while (1) {
+        gpio_xor_mask(1u << LED_PIN);
+        co_await co::delay(pdMS_TO_TICKS(BLINK_MS));
+    }
+}
+
+/**
+ * @brief Reporte por USB de la memoria de los marcos y del planificador
+ */
+co::task<> report(void) {
+    co::frame_stats_t frames;
+    co::scheduler_stats_t stats;
+
+    while (1) {
+        co_await co::delay(pdMS_TO_TICKS(REPORT_MS));
+        co::get_frame_stats(&frames);
+        sched.get_stats(&stats);
+        printf("marcos %lu, %lu B (max %lu), %lu continuaciones, %lu activaciones, descartados %lu\n", frames.frames,
+               frames.bytes, frames.bytes_max, stats.resumed, stats.activations, display_channel.dropped());
+#if INCLUDE_uxTaskGetStackHighWaterMark
+        printf("stack %u palabras, minimo libre %lu\n", CO_STACK, (uint32_t)uxTaskGetStackHighWaterMark(sched.handle()));
+#endif
+    }
+}
+
+/**
+ * @brief Interrupcion del pulsador
+ */
+void button_isr(uint gpio, uint32_t events) {
+    BaseType_t to_higher_priority_task = pdFALSE;
+    button.set_from_isr(&to_higher_priority_task);
+    portYIELD_FROM_ISR(to_higher_priority_task);
+}
+
+/**
+ * @brief Programa principal
+ */
+int main(void) {
+    stdio_init_all();
+
+    i2c_init(I2C_PORT, I2C_FREQ);
+    gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA_PIN);
+    gpio_pull_up(I2C_SCL_PIN);
+    co::i2c_async_init(I2C_PORT);
+
+    gpio_init(LED_PIN);
+    gpio_set_dir(LED_PIN, GPIO_OUT);
+    gpio_init(BUTTON_PIN);
+    gpio_pull_up(BUTTON_PIN);
+    gpio_set_irq_enabled_with_callback(BUTTON_PIN, GPIO_IRQ_EDGE_FALL, true, button_isr);
+
+    // Cinco actividades y una sola tarea
+    sched.spawn(display());
+    sched.spawn(sensor());
+    sched.spawn(buttons());
+    sched.spawn(blink());
+    sched.spawn(report());
+    sched.start("Co", 2, CO_STACK);
+
+    // Arranca el sistema operativo
+    vTaskStartScheduler();
+    while(1);
+}
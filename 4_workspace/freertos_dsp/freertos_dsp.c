@@ -0,0 +1,212 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "dsp.h"
+
+// Entrada en el GP26 (ADC0), muestreo continuo a 48 MHz / 960 = 50 kHz
+#define ADC_GPIO        26
+#define ADC_INPUT       0
+#define ADC_DIV         960
+#define FS              50000.0f
+// Muestras por bloque del DMA
+#define BLOCK           256
+// Etapas del pasabajos y taps del FIR decimador
+#define STAGES          2
+#define TAPS            32
+#define DECIMATION      8
+// Ventana del promedio movil, 2^4 muestras
+#define AVERAGE_BITS    4
+// Repeticiones de cada medicion
+#define ROUNDS          50
+
+// Camino que compila la biblioteca en este nucleo
+#if defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+#define DSP_PATH        "SIMD"
+#else
+#define DSP_PATH        "escalar"
+#endif
+
+// Bloque que llena el DMA, se convierte a Q15 en el lugar
+static uint16_t capture[BLOCK] __attribute__((aligned(4)));
+static q15_t input[BLOCK] __attribute__((aligned(4)));
+static q15_t output[BLOCK], expected[BLOCK];
+
+// Filtros de la biblioteca
+static q15_t biquad_coeffs[STAGES * DSP_BIQUAD_Q15_COEFFS] __attribute__((aligned(4)));
+static q15_t biquad_state[STAGES * DSP_BIQUAD_STATE];
+static q15_t fir_coeffs[TAPS] __attribute__((aligned(4)));
+static q15_t fir_delay[2 * TAPS] __attribute__((aligned(4)));
+static q15_t average_buf[1 << AVERAGE_BITS];
+static dsp_biquad_q15_t biquad;
+static dsp_fir_q15_t fir;
+static dsp_average_q15_t average;
+
+// Estado de las referencias, una muestra por vez y sin instrucciones SIMD
+static q15_t ref_biquad_state[STAGES * DSP_BIQUAD_STATE];
+static q15_t ref_fir_delay[TAPS];
+static uint32_t ref_fir_phase;
+
+static int dma_channel;
+
+/**
+ * @brief Satura a Q15
+ */
+static q15_t sat15(int64_t v) {
+    return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (q15_t)v;
+}
+
+/**
+ * @brief Referencia del biquad: la ecuacion en diferencias tal cual
+ */
+static void ref_biquad(const q15_t *src, q15_t *dst, size_t count) {
+    memcpy(dst, src, count * sizeof(q15_t));
+    for (int stage = 0; stage < STAGES; stage++) {
+        const q15_t *c = biquad_coeffs + stage * DSP_BIQUAD_Q15_COEFFS;
+        q15_t *s = ref_biquad_state + stage * DSP_BIQUAD_STATE;
+        for (size_t i = 0; i < count; i++) {
+            int64_t acc = (1 << 13) + (int64_t)c[0] * dst[i] + (int64_t)c[2] * s[0] + (int64_t)c[3] * s[1] +
+                          (int64_t)c[4] * s[2] + (int64_t)c[5] * s[3];
+            q15_t y = sat15(acc >> 14);
+            s[1] = s[0];
+            s[0] = dst[i];
+            s[3] = s[2];
+            s[2] = y;
+            dst[i] = y;
+        }
+    }
+}
+
+/**
+ * @brief Referencia del FIR: corre la linea de demora en cada muestra
+ * @return cantidad de salidas
+ */
+static size_t ref_fir(const q15_t *src, q15_t *dst, size_t count) {
+    size_t out = 0;
+    for (size_t i = 0; i < count; i++) {
+        memmove(ref_fir_delay + 1, ref_fir_delay, (TAPS - 1) * sizeof(q15_t));
+        ref_fir_delay[0] = src[i];
+        if (++ref_fir_phase < DECIMATION) { continue; }
+        ref_fir_phase = 0;
+        int64_t acc = 1 << 14;
+        for (int k = 0; k < TAPS; k++) { acc += (int32_t)fir_coeffs[k] * ref_fir_delay[k]; }
+        dst[out++] = sat15(acc >> 15);
+    }
+    return out;
+}
+
+/**
+ * @brief Captura un bloque del ADC con el DMA
+ */
+static void capture_block(void) {
+    adc_fifo_drain();
+    dma_channel_set_write_addr(dma_channel, capture, false);
+    dma_channel_set_trans_count(dma_channel, BLOCK, true);
+    adc_run(true);
+    dma_channel_wait_for_finish_blocking(dma_channel);
+    adc_run(false);
+}
+
+/**
+ * @brief Muestra los ciclos por muestra de una funcion y de su referencia
+ */
+static void report(const char *name, uint32_t lib_us, uint32_t ref_us, bool equal) {
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+    printf("%-16s %6lu %6lu  %s\n", name, lib_us * mhz / (ROUNDS * BLOCK), ref_us * mhz / (ROUNDS * BLOCK),
+           equal ? "iguales" : "DISTINTOS");
+}
+
+/**
+ * @brief Tarea que captura, filtra con la biblioteca y con la referencia, y compara
+ */
+void task_dsp(void *params) {
+    uint32_t start, lib_us, ref_us;
+    bool equal;
+
+    while (1) {
+        capture_block();
+        dsp_adc_to_q15(capture, input, BLOCK);
+        printf("camino %s, ciclos por muestra\n%-16s %6s %6s\n", DSP_PATH, "filtro", "lib", "ref");
+
+        // Cascada de biquads, cada vuelta parte del mismo estado
+        equal = true;
+        lib_us = ref_us = 0;
+        for (int r = 0; r < ROUNDS; r++) {
+            memset(biquad_state, 0, sizeof(biquad_state));
+            memset(ref_biquad_state, 0, sizeof(ref_biquad_state));
+            start = time_us_32();
+            dsp_biquad_q15_process(&biquad, input, output, BLOCK);
+            lib_us += time_us_32() - start;
+            start = time_us_32();
+            ref_biquad(input, expected, BLOCK);
+            ref_us += time_us_32() - start;
+            equal &= !memcmp(output, expected, sizeof(output));
+        }
+        report("biquad x2", lib_us, ref_us, equal);
+
+        // FIR decimador, sigue con el estado de la vuelta anterior
+        equal = true;
+        lib_us = ref_us = 0;
+        for (int r = 0; r < ROUNDS; r++) {
+            start = time_us_32();
+            size_t n = dsp_fir_q15_process(&fir, input, output, BLOCK);
+            lib_us += time_us_32() - start;
+            start = time_us_32();
+            size_t m = ref_fir(input, expected, BLOCK);
+            ref_us += time_us_32() - start;
+            equal &= n == m && !memcmp(output, expected, n * sizeof(q15_t));
+        }
+        report("fir 32 /8", lib_us, ref_us, equal);
+
+        // Promedio movil, sin referencia: el costo no depende de la ventana
+        start = time_us_32();
+        for (int r = 0; r < ROUNDS; r++) { dsp_average_q15_process(&average, input, output, BLOCK); }
+        report("promedio 16", time_us_32() - start, 0, true);
+
+        vTaskDelay(pdMS_TO_TICKS(5000));
+    }
+}
+
+/**
+ * @brief Programa principal
+ */
+int main(void) {
+    float c[5];
+
+    stdio_init_all();
+
+    // Pasabajos Butterworth de 1 kHz en dos etapas iguales
+    dsp_biquad_lowpass(1000.0f, FS, 0.7071f, c);
+    for (int s = 0; s < STAGES; s++) { dsp_biquad_coeffs_q15(c, 1, biquad_coeffs + s * DSP_BIQUAD_Q15_COEFFS); }
+    dsp_biquad_q15_init(&biquad, biquad_coeffs, biquad_state, STAGES, 1);
+    // FIR de promedio ponderado triangular, suma 1
+    for (int k = 0; k < TAPS; k++) { fir_coeffs[k] = (k < TAPS / 2 ? k + 1 : TAPS - k) * 32767 / (TAPS * TAPS / 4 + TAPS / 2); }
+    dsp_fir_q15_init(&fir, fir_coeffs, fir_delay, TAPS, DECIMATION);
+    dsp_average_q15_init(&average, average_buf, AVERAGE_BITS);
+
+    // ADC en modo continuo, cada muestra va al FIFO y de ahi al DMA
+    adc_init();
+    adc_gpio_init(ADC_GPIO);
+    adc_select_input(ADC_INPUT);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(ADC_DIV - 1);
+    dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    dma_channel_configure(dma_channel, &config, capture, &adc_hw->fifo, BLOCK, false);
+
+    xTaskCreate(task_dsp, "DSP", 2 * configMINIMAL_STACK_SIZE, NULL, 1, NULL);
+
+    // Arranca el sistema operativo
+    vTaskStartScheduler();
+    while(1);
+}
@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/adc.h"
+#include "hardware/pwm.h"
+#include "hardware/irq.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "intercore.h"
+
+// Entrada del lazo en el GP26 (ADC0)
+#define CONTROL_ADC_GPIO    26
+#define CONTROL_ADC_INPUT   0
+// Salida del lazo en el GP16
+#define CONTROL_PWM_GPIO    16
+// Muestreo continuo a 48 MHz / 960 = 50 kHz
+#define CONTROL_ADC_DIV     960
+// Tope del PWM, 150 MHz / 1500 = 100 kHz
+#define CONTROL_PWM_TOP     1500
+// Muestras por cada elemento de telemetria, 10 ms a 50 kHz
+#define CONTROL_DECIMATION  500
+// Ganancias del PI en Q16
+#define CONTROL_KP          3277        // 0,05
+#define CONTROL_KI          131         // 0,002
+// Prioridad del ADC y del FIFO en core1, la misma para que no se interrumpan entre si
+#define CONTROL_IRQ_PRIORITY    0
+
+// Idas y vueltas por medicion de latencia
+#define BENCH_ROUNDS        10000
+
+/**
+ * @brief Consigna de core0 a core1
+ */
+typedef struct {
+    uint16_t target;            // Valor buscado en cuentas del ADC
+    uint16_t ping;              // Distinto de cero: core1 responde enseguida con el mismo valor
+} setpoint_t;
+
+/**
+ * @brief Tipos de telemetria
+ */
+typedef enum {
+    TELEMETRY_CONTROL,          // Promedio del lazo cada CONTROL_DECIMATION muestras
+    TELEMETRY_ECHO,             // Respuesta a una consigna con ping
+} telemetry_type_t;
+
+/**
+ * @brief Telemetria de core1 a core0
+ */
+typedef struct {
+    uint16_t type;              // telemetry_type_t
+    uint16_t ping;              // Valor de la consigna respondida
+    uint16_t adc;               // Promedio del ADC
+    uint16_t duty;              // Ultimo nivel del PWM
+    uint32_t late;              // Periodos en que el lazo se atraso, acumulado
+} telemetry_t;
+
+// Canal entre nucleos y sus rings
+static SPSC_BUFFER(setpoint_buf, setpoint_t, 4);
+static SPSC_BUFFER(telemetry_buf, telemetry_t, 6);
+static intercore_t ic;
+
+// Estado del lazo, solo lo usa core1
+static volatile uint16_t target;
+static int32_t integral;
+static uint32_t adc_sum;
+static uint32_t adc_count;
+static uint32_t late;
+
+/**
+ * @brief Interrupcion del ADC en core1: un periodo del lazo de control
+ */
+static void __not_in_flash_func(control_adc_irq)(void) {
+    // Con mas de una muestra en el FIFO, el lazo se atraso un periodo
+    if (adc_fifo_get_level() > 1) { late++; }
+    uint16_t sample = adc_fifo_get();
+    while (!adc_fifo_is_empty()) { sample = adc_fifo_get(); }
+
+    // PI con anti-windup por saturacion del integrador
+    int32_t error = (int32_t)target - sample;
+    integral += CONTROL_KI * error;
+    if (integral < 0) { integral = 0; }
+    if (integral > (CONTROL_PWM_TOP << 16)) { integral = CONTROL_PWM_TOP << 16; }
+    int32_t duty = (CONTROL_KP * error + integral) >> 16;
+    if (duty < 0) { duty = 0; }
+    if (duty > CONTROL_PWM_TOP) { duty = CONTROL_PWM_TOP; }
+    pwm_set_gpio_level(CONTROL_PWM_GPIO, duty);
+
+    adc_sum += sample;
+    if (++adc_count == CONTROL_DECIMATION) {
+        telemetry_t t = { TELEMETRY_CONTROL, 0, adc_sum / adc_count, duty, late };
+        intercore_telemetry_push(&ic, &t, 1);
+        adc_sum = adc_count = 0;
+    }
+}
+
+/**
+ * @brief Llegaron consignas: se aplica la ultima y se responden los ping
+ * @param context sin uso
+ */
+static void __not_in_flash_func(control_on_setpoint)(void *context) {
+    setpoint_t sp;
+
+    while (intercore_setpoint_pop(&ic, &sp, 1)) {
+        target = sp.target;
+        if (sp.ping) {
+            telemetry_t echo = { TELEMETRY_ECHO, sp.ping };
+            intercore_telemetry_push(&ic, &echo, 1);
+        }
+    }
+}
+
+/**
+ * @brief Programa de core1: sin sistema operativo ni tick, todo ocurre en las
+ * interrupciones del ADC y del FIFO
+ */
+static void __not_in_flash_func(core1_main)(void) {
+    intercore_core1_init(&ic, control_on_setpoint, NULL);
+    irq_set_priority(SIO_FIFO_IRQ_NUM(1), CONTROL_IRQ_PRIORITY);
+
+    // PWM de salida
+    gpio_set_function(CONTROL_PWM_GPIO, GPIO_FUNC_PWM);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_wrap(&config, CONTROL_PWM_TOP - 1);
+    pwm_init(pwm_gpio_to_slice_num(CONTROL_PWM_GPIO), &config, true);
+
+    // ADC en modo continuo, interrumpe con cada muestra
+    adc_init();
+    adc_gpio_init(CONTROL_ADC_GPIO);
+    adc_select_input(CONTROL_ADC_INPUT);
+    adc_fifo_setup(true, false, 1, false, false);
+    adc_set_clkdiv(CONTROL_ADC_DIV - 1);
+    irq_set_exclusive_handler(ADC_IRQ_FIFO, control_adc_irq);
+    irq_set_priority(ADC_IRQ_FIFO, CONTROL_IRQ_PRIORITY);
+    irq_set_enabled(ADC_IRQ_FIFO, true);
+    adc_irq_set_enabled(true);
+    adc_run(true);
+
+    // Entre interrupciones el nucleo duerme
+    while (1) { __wfi(); }
+}
+
+/**
+ * @brief Mide la ida y vuelta core0 -> core1 -> tarea de core0
+ * @param value consigna que se envia en cada vuelta
+ */
+static void bench_round_trip(uint16_t value) {
+    uint32_t max_us = 0;
+    uint32_t lost = 0;
+    telemetry_t t;
+
+    uint32_t start = time_us_32();
+    for (uint32_t i = 1; i <= BENCH_ROUNDS; i++) {
+        setpoint_t sp = { value, (uint16_t)i };
+        uint32_t sent = time_us_32();
+        intercore_setpoint_push(&ic, &sp, 1);
+        // La telemetria del lazo que llega en el medio se descarta
+        do {
+            if (!intercore_telemetry_wait(&ic, &t, 1, pdMS_TO_TICKS(10))) { lost++; break; }
+        } while (t.type != TELEMETRY_ECHO || t.ping != sp.ping);
+        uint32_t elapsed = time_us_32() - sent;
+        if (elapsed > max_us) { max_us = elapsed; }
+    }
+    uint32_t elapsed = time_us_32() - start;
+
+    // Tiempo por vuelta en ns, incluye el lazo
+    printf("ida y vuelta %lu ns, maximo %lu us, perdidas %lu\n",
+           elapsed * 1000 / BENCH_ROUNDS, max_us, lost);
+}
+
+/**
+ * @brief Tarea de core0: mide la latencia, cambia la consigna y muestra la telemetria
+ */
+void task_host(void *params) {
+    static const uint16_t targets[] = { 1000, 3000 };
+    telemetry_t batch[8];
+
+    for (uint32_t n = 0; ; n++) {
+        uint16_t value = targets[n % 2];
+        bench_round_trip(value);
+
+        // Un segundo de telemetria con la consigna nueva
+        TickType_t until = xTaskGetTickCount() + pdMS_TO_TICKS(1000);
+        while (xTaskGetTickCount() < until) {
+            uint32_t count = intercore_telemetry_wait(&ic, batch, 8, pdMS_TO_TICKS(100));
+            for (uint32_t i = 0; i < count; i++) {
+                if (batch[i].type != TELEMETRY_CONTROL) { continue; }
+                printf("consigna %u adc %u pwm %u atrasos %lu\n", value, batch[i].adc, batch[i].duty, batch[i].late);
+            }
+        }
+        printf("avisos %lu/%lu, FIFO lleno %lu/%lu, descartados %lu/%lu\n\n",
+               ic.doorbells[0], ic.doorbells[1], ic.fifo_full[0], ic.fifo_full[1], ic.dropped[0], ic.dropped[1]);
+    }
+}
+
+/**
+ * @brief Programa principal
+ */
+int main(void) {
+    TaskHandle_t host;
+
+    stdio_init_all();
+    intercore_init(&ic, setpoint_buf, sizeof(setpoint_t), 16, telemetry_buf, sizeof(telemetry_t), 64);
+
+    // La tarea se crea antes, es la que consume la telemetria
+    xTaskCreate(task_host, "Host", 2 * configMINIMAL_STACK_SIZE, NULL, 2, &host);
+    intercore_start(&ic, core1_main, host);
+
+    // Arranca el sistema operativo
+    vTaskStartScheduler();
+    while(1);
+}
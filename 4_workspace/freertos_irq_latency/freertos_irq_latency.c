@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/pwm.h"
+#include "hardware/irq.h"
+#include "hardware/flash.h"
+#include "hardware/clocks.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Slice del PWM que genera la interrupcion periodica, sin pin asignado
+#define LATENCY_SLICE       0
+// Periodo del PWM en ciclos de reloj, el contador se lee en la ISR
+#define LATENCY_PERIOD      65536
+// Ancho y cantidad de baldes del histograma, en ciclos
+#define HIST_WIDTH          8
+#define HIST_BUCKETS        256
+// Duracion de cada escenario
+#define SCENARIO_MS         2000
+
+// Bytes de flash que recorre la carga de lectura, mas que la cache XIP
+#define XIP_LOAD_BYTES      (256 * 1024)
+// Sector reservado al final de la flash para la carga de grabacion
+#define PROGRAM_OFFSET      (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+// Espera maxima para tomar la flash
+#define PROGRAM_TIMEOUT_MS  100
+
+/**
+ * @brief Carga que compite con la interrupcion
+ */
+typedef enum {
+    LOAD_NONE,          // Sin carga, el handler queda en la cache
+    LOAD_XIP,           // Lecturas de flash que desalojan la cache XIP
+    LOAD_PROGRAM,       // Borrado y grabacion de un sector, vacian la cache
+    LOAD_COUNT
+} load_t;
+
+static const char *load_names[LOAD_COUNT] = { "ninguna", "lectura", "grabacion" };
+
+// Latencias medidas, las escribe la ISR
+static volatile uint32_t hist[HIST_BUCKETS];
+static volatile uint32_t samples;
+static volatile uint32_t max_cycles;
+static volatile uint32_t missed;
+static volatile uint32_t last_us;
+// Periodo del PWM en microsegundos, para contar los desbordes perdidos
+static uint32_t period_us;
+
+// Carga en curso, la cambia la tarea de medicion
+static volatile load_t load;
+
+// Pagina que se graba en el sector reservado
+static uint8_t page[FLASH_PAGE_SIZE];
+
+/**
+ * @brief Registra una muestra. Se inlinea en los dos handlers, asi cada uno
+ * corre completo desde donde esta ubicado
+ * @param cycles ciclos desde el desborde del PWM hasta la lectura del contador
+ */
+static __force_inline void latency_record(uint32_t cycles) {
+    uint32_t now = time_us_32();
+    uint32_t bucket = cycles / HIST_WIDTH;
+
+    hist[bucket < HIST_BUCKETS ? bucket : HIST_BUCKETS - 1]++;
+    if (cycles > max_cycles) { max_cycles = cycles; }
+    // Si la interrupcion estuvo bloqueada mas de un periodo, se perdieron desbordes
+    if (samples && now - last_us > period_us + period_us / 2) {
+        missed += (now - last_us + period_us / 2) / period_us - 1;
+    }
+    last_us = now;
+    samples++;
+}
+
+/**
+ * @brief Handler desde flash, lo primero es leer el contador del PWM
+ */
+void latency_isr_flash(void) {
+    uint32_t cycles = pwm_hw->slice[LATENCY_SLICE].ctr;
+    pwm_hw->intr = 1u << LATENCY_SLICE;
+    latency_record(cycles);
+}
+
+/**
+ * @brief El mismo handler desde SRAM
+ */
+void __not_in_flash_func(latency_isr_ram)(void) {
+    uint32_t cycles = pwm_hw->slice[LATENCY_SLICE].ctr;
+    pwm_hw->intr = 1u << LATENCY_SLICE;
+    latency_record(cycles);
+}
+
+/**
+ * @brief Cambia el handler de la interrupcion
+ * @param handler handler a instalar
+ */
+void latency_set_handler(irq_handler_t handler) {
+    irq_set_enabled(PWM_DEFAULT_IRQ_NUM(), false);
+    irq_handler_t current = irq_get_exclusive_handler(PWM_DEFAULT_IRQ_NUM());
+    if (current) { irq_remove_handler(PWM_DEFAULT_IRQ_NUM(), current); }
+    irq_set_exclusive_handler(PWM_DEFAULT_IRQ_NUM(), handler);
+    irq_set_enabled(PWM_DEFAULT_IRQ_NUM(), true);
+}
+
+/**
+ * @brief Reinicia las mediciones
+ */
+void latency_reset(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    for (int i = 0; i < HIST_BUCKETS; i++) { hist[i] = 0; }
+    samples = 0;
+    max_cycles = 0;
+    missed = 0;
+    restore_interrupts(irq);
+}
+
+/**
+ * @brief Percentil del histograma
+ * @param p percentil en milesimos (500 para la mediana)
+ * @return limite superior del balde, en ciclos. El ultimo balde junta todo lo
+ * que no entra en el histograma y no tiene limite, ahi se devuelve el maximo
+ */
+uint32_t latency_percentile(uint32_t p) {
+    uint32_t target = (uint64_t)samples * p / 1000;
+    uint32_t sum = 0;
+    for (int i = 0; i < HIST_BUCKETS - 1; i++) {
+        sum += hist[i];
+        if (sum > target) { return (i + 1) * HIST_WIDTH; }
+    }
+    return max_cycles;
+}
+
+/**
+ * @brief Graba el sector reservado, se ejecuta sin interrupciones ni acceso XIP
+ * @param param sin uso
+ */
+static void program_sector(void *param) {
+    flash_range_erase(PROGRAM_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(PROGRAM_OFFSET, page, FLASH_PAGE_SIZE);
+}
+
+/**
+ * @brief Tarea de menor prioridad que genera la carga elegida
+ */
+void task_load(void *params) {
+    volatile const uint32_t *flash = (const uint32_t *)XIP_BASE;
+    uint32_t sum = 0;
+
+    while (1) {
+        switch (load) {
+            case LOAD_XIP:
+                // Una lectura por linea de cache, cada una desaloja a otra
+                for (uint32_t i = 0; i < XIP_LOAD_BYTES / 4; i += 2) { sum += flash[i]; }
+                break;
+            case LOAD_PROGRAM:
+                page[0] = (uint8_t)sum++;
+                flash_safe_execute(program_sector, NULL, PROGRAM_TIMEOUT_MS);
+                vTaskDelay(1);
+                break;
+            default:
+                vTaskDelay(1);
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Tarea que recorre los escenarios y muestra la distribucion
+ */
+void task_bench(void *params) {
+    static const struct {
+        const char *name;
+        irq_handler_t handler;
+    } handlers[] = {
+        { "flash", latency_isr_flash },
+        { "RAM", latency_isr_ram },
+    };
+
+    while (1) {
+        printf("%-6s %-10s %8s %6s %6s %6s %6s %8s\n", "isr", "carga", "n", "p50", "p99", "p99.9", "max", "perdidas");
+        for (size_t h = 0; h < sizeof(handlers) / sizeof(handlers[0]); h++) {
+            latency_set_handler(handlers[h].handler);
+            for (load_t l = 0; l < LOAD_COUNT; l++) {
+                load = l;
+                vTaskDelay(pdMS_TO_TICKS(100));     // Que la carga arranque antes de medir
+                latency_reset();
+                vTaskDelay(pdMS_TO_TICKS(SCENARIO_MS));
+                load = LOAD_NONE;
+
+                // Ciclos del reloj del sistema
+                printf("%-6s %-10s %8lu %6lu %6lu %6lu %6lu %8lu\n", handlers[h].name, load_names[l], samples,
+                       latency_percentile(500), latency_percentile(990), latency_percentile(999), max_cycles, missed);
+            }
+        }
+        printf("\n");
+        vTaskDelay(pdMS_TO_TICKS(5000));
+    }
+}
+
+/**
+ * @brief Programa principal
+ */
+int main(void) {
+    stdio_init_all();
+    memset(page, 0xA5, sizeof(page));
+
+    // PWM a la frecuencia del sistema, interrumpe en cada desborde
+    period_us = (uint64_t)LATENCY_PERIOD * 1000000 / clock_get_hz(clk_sys);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_clkdiv_int(&config, 1);
+    pwm_config_set_wrap(&config, LATENCY_PERIOD - 1);
+    pwm_init(LATENCY_SLICE, &config, false);
+    pwm_clear_irq(LATENCY_SLICE);
+    pwm_set_irq_enabled(LATENCY_SLICE, true);
+    // Maxima prioridad. En el RP2350 las secciones criticas del kernel enmascaran con BASEPRI
+    // desde configMAX_SYSCALL_INTERRUPT_PRIORITY y esta queda por encima. En el RP2040 el
+    // Cortex-M0+ no tiene BASEPRI, el kernel enmascara con PRIMASK y la demora tambien a esta
+    irq_set_priority(PWM_DEFAULT_IRQ_NUM(), 0);
+    latency_set_handler(latency_isr_flash);
+    pwm_set_enabled(LATENCY_SLICE, true);
+
+    // Creacion de tareas, la carga por debajo de la medicion
+    xTaskCreate(task_load, "Load", configMINIMAL_STACK_SIZE, NULL, 1, NULL);
+    xTaskCreate(task_bench, "Bench", 2 * configMINIMAL_STACK_SIZE, NULL, 2, NULL);
+
+    // Arranca el sistema operativo
+    vTaskStartScheduler();
+    while(1);
+}
@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "ledfx.h"
+
+// PWM de 12 bits, 36,6 kHz con el reloj de 150 MHz
+#define LED_TOP         4095
+// Duracion de cada efecto
+#define EFFECT_MS       10000
+// Periodo de la medicion simulada y maximo error, como el tp4
+#define SAMPLE_MS       500
+#define MAX_ERROR       50.0f
+
+static ledfx_t led;
+
+/**
+ * @brief Tarea que cambia de efecto cada 10 segundos. Entre cambios queda
+ * bloqueada y el LED lo maneja el DMA
+ */
+void task_effects(void *params) {
+    while (1) {
+        // El tp1 en una llamada
+        printf("parpadeo 1000/1500 ms\n");
+        ledfx_blink(&led, LEDFX_LEVEL_MAX, 1000, 1500);
+        vTaskDelay(pdMS_TO_TICKS(EFFECT_MS));
+
+        printf("respiracion de 3 s\n");
+        ledfx_breathe(&led, 0, LEDFX_LEVEL_MAX, 3000);
+        vTaskDelay(pdMS_TO_TICKS(EFFECT_MS));
+
+        // El brillo del tp4 con un error que baja hasta cero: mas brillo con menos error
+        printf("brillo proporcional al error\n");
+        for (int i = 0; i <= EFFECT_MS / SAMPLE_MS; i++) {
+            float error = MAX_ERROR * (EFFECT_MS / SAMPLE_MS - i) / (EFFECT_MS / SAMPLE_MS);
+            uint8_t level = error < 0.01f ? 0 : (uint8_t)(LEDFX_LEVEL_MAX * (1.0f - error / MAX_ERROR));
+            ledfx_fade_to(&led, level, SAMPLE_MS);
+            vTaskDelay(pdMS_TO_TICKS(SAMPLE_MS));
+        }
+    }
+}
+
+/**
+ * @brief Programa principal
+ */
+int main(void) {
+    stdio_init_all();
+
+    if (!ledfx_init(&led, PICO_DEFAULT_LED_PIN, LED_TOP)) {
+        panic("No hay canales DMA libres");
+    }
+
+    // Creacion de tareas
+    xTaskCreate(task_effects, "Effects", 2 * configMINIMAL_STACK_SIZE, NULL, 1, NULL);
+
+    // Arranca el sistema operativo
+    vTaskStartScheduler();
+    while (1);
+}
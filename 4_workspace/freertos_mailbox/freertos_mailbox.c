@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "mailbox.h"
+
+// Repeticiones de cada prueba
+#define ITERATIONS  10000
+
+/**
+ * @brief Valor de prueba, del tamaño de una medicion con marca de tiempo
+ */
+typedef struct {
+    uint32_t time;
+    uint16_t raw;
+    float voltage;
+    float temperature;
+} sample_t;
+
+/**
+ * @brief Prueba de un metodo
+ */
+typedef struct {
+    const char *name;           // Nombre en la tabla
+    void (*run)(void);          // Una iteracion
+} bench_t;
+
+// El idioma de la cola de un lugar y el mailbox que lo reemplaza
+QueueHandle_t queue;
+static MAILBOX_BUFFER(mailbox_buf, sample_t);
+mailbox_t mailbox;
+
+// Valor que se escribe y se lee en cada iteracion
+static sample_t sample;
+
+// Tarea suscripta, solo recibe las notificaciones de mailbox_post
+void task_waiter(void *params) {
+    uint32_t version = 0;
+    sample_t value;
+    while (1) { version = mailbox_wait(&mailbox, &value, version, portMAX_DELAY); }
+}
+
+// Escritura con la cola: seccion critica y copia
+static void run_queue_overwrite(void) {
+    sample.time++;
+    xQueueOverwrite(queue, &sample);
+}
+
+// Lectura con la cola, sin esperar
+static void run_queue_peek(void) {
+    xQueuePeek(queue, &sample, 0);
+}
+
+// Escritura con el mailbox, sin notificar
+static void run_mailbox_write(void) {
+    sample.time++;
+    mailbox_write(&mailbox, &sample);
+}
+
+// Lectura con el mailbox
+static void run_mailbox_read(void) {
+    mailbox_read(&mailbox, &sample);
+}
+
+// Escritura con el mailbox que notifica a una tarea de menor prioridad
+static void run_mailbox_post(void) {
+    sample.time++;
+    mailbox_post(&mailbox, &sample);
+}
+
+static const bench_t benches[] = {
+    { "xQueueOverwrite", run_queue_overwrite },
+    { "xQueuePeek", run_queue_peek },
+    { "mailbox_write", run_mailbox_write },
+    { "mailbox_read", run_mailbox_read },
+    { "mailbox_post 1 tarea", run_mailbox_post },
+};
+
+/**
+ * @brief Tarea que corre las pruebas y muestra los ciclos por operacion
+ */
+void task_bench(void *params) {
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+
+    while (1) {
+        for (size_t b = 0; b < sizeof(benches) / sizeof(benches[0]); b++) {
+            uint32_t start = time_us_32();
+            for (int i = 0; i < ITERATIONS; i++) { benches[b].run(); }
+            uint32_t elapsed = time_us_32() - start;
+            // Ciclos del reloj del sistema por operacion, incluye el lazo
+            printf("%-22s %5lu ciclos\n", benches[b].name, elapsed * mhz / ITERATIONS);
+        }
+        printf("\n");
+        vTaskDelay(pdMS_TO_TICKS(5000));
+    }
+}
+
+/**
+ * @brief Programa principal
+ */
+int main(void) {
+    TaskHandle_t waiter;
+
+    stdio_init_all();
+
+    queue = xQueueCreate(1, sizeof(sample_t));
+    mailbox_init(&mailbox, mailbox_buf, sizeof(sample_t));
+
+    // La tarea suscripta tiene menos prioridad, cada notificacion no cambia de tarea
+    xTaskCreate(task_waiter, "Waiter", configMINIMAL_STACK_SIZE, NULL, 1, &waiter);
+    mailbox_subscribe(&mailbox, waiter);
+    xTaskCreate(task_bench, "Bench", 2 * configMINIMAL_STACK_SIZE, NULL, 2, NULL);
+
+    // Arranca el sistema operativo
+    vTaskStartScheduler();
+    while(1);
+}
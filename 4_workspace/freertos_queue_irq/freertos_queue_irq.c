@@ -7,8 +7,12 @@
 #include "task.h"
 #include "queue.h"
 
-// Cantidad de lecturas
-#define SAMPLES 4
+#include "deferred.h"
+#include "adctemp.h"
+
+// Cantidad de lecturas, potencia de 2: la suma es el promedio con SAMPLE_BITS bits fraccionarios
+#define SAMPLE_BITS 2
+#define SAMPLES     (1 << SAMPLE_BITS)
 
 /**
  * @brief Estructura para pasar los datos del sensor
@@ -23,26 +27,39 @@ typedef struct {
 QueueHandle_t queue_sensor;
 
 /**
- * @brief Handler para la interrupcion del ADC
+ * @brief Trabajo diferido de la interrupcion del ADC, corre en una tarea
+ * @param context sin uso
+ * @param sum suma de las lecturas
  */
-void adc_irq_handler(void) {
+void adc_process(void *context, uint32_t sum) {
+    // Datos para la cola
+    sensor_data_t data = { .raw = (uint16_t) (sum >> SAMPLE_BITS) };
+    data.voltage = data.raw * 3.3f / (1 << 12);
+    // Temperatura de la tabla, interpolada con los bits fraccionarios del promedio
+    data.temperature = adctemp_centi_interp(sum, SAMPLE_BITS) / 100.0f;
+    // Envio por cola
+    xQueueOverwrite(queue_sensor, &data);
+}
+
+/**
+ * @brief Handler para la interrupcion del ADC. Solo vacia el FIFO, las
+ * cuentas en punto flotante quedan para el trabajo diferido
+ */
+void __not_in_flash_func(adc_irq_handler)(void) {
+    uint32_t start = deferred_isr_enter();
     // Variable para verificar la necesidad de un cambio tarea
     BaseType_t to_higher_priority_task = false;
     // Deshabilito la interrupcion y detengo el ADC
     adc_irq_set_enabled(false);
     adc_run(false);
-    // Variable para calcular el promedio de muestras
-    uint32_t raw = 0;
-    for(uint8_t i = 0; i < SAMPLES; i++) { raw += adc_fifo_get(); }
+    // Suma de las muestras, el promedio lo saca el trabajo diferido
+    uint32_t sum = 0;
+    for(uint8_t i = 0; i < SAMPLES; i++) { sum += adc_fifo_get(); }
     // Limpio el FIFO
     adc_fifo_drain();
-    // Datos para la cola
-    sensor_data_t data = { .raw = (uint16_t) (raw / SAMPLES) };
-    data.voltage = data.raw * 3.3 / (1 << 12);
-    // El calculo de temperatura sale de la documentacion del SDK
-    data.temperature = 27 - (data.voltage - 0.706) / 0.001721;
-    // Envio por cola
-    xQueueOverwriteFromISR(queue_sensor, &data, &to_higher_priority_task);
+    // Encolo el procesamiento
+    deferred_post_from_isr(DEFERRED_HIGH, adc_process, NULL, sum, &to_higher_priority_task);
+    deferred_isr_exit(DEFERRED_HIGH, start);
     // Reviso si es necesario el cambio a otra tarea
     portYIELD_FROM_ISR(to_higher_priority_task);
 }
@@ -80,7 +97,15 @@ void task_print(void *params) {
         // Escribo los datos
         printf("ADC raw: 0x%03x\n", data.raw);
         printf("ADC voltage: %.2f V\n", data.voltage);
-        printf("Temperature: %.2f C\n\n", data.temperature);
+        printf("Temperature: %.2f C\n", data.temperature);
+        // Tiempo en la ISR y en el trabajo diferido
+        deferred_stats_t stats;
+        deferred_get_stats(DEFERRED_HIGH, &stats);
+        if (stats.isr_count && stats.executed) {
+            printf("ISR: %lu us (max %lu), espera: %lu us (max %lu), trabajo: %lu us (max %lu)\n\n",
+                   (uint32_t)(stats.isr_us / stats.isr_count), stats.isr_max_us, (uint32_t)(stats.latency_us / stats.executed),
+                   stats.latency_max_us, (uint32_t)(stats.run_us / stats.executed), stats.run_max_us);
+        }
         // Bloqueo para no saturar la consola
         vTaskDelay(pdMS_TO_TICKS(500));
     }
@@ -106,7 +131,11 @@ void task_adc(void *params) {
 int main(void) {
 
     stdio_init_all();
+    // Calibracion del sensor grabada en la flash, si la hay
+    adctemp_init();
 
+    // Tareas de trabajo diferido, la de alta prioridad por encima de las de la aplicacion
+    deferred_init(configMAX_PRIORITIES - 1, 1);
     // Creacion de tareas
     xTaskCreate(task_init, "Init", configMINIMAL_STACK_SIZE, NULL, 3, NULL);
     xTaskCreate(task_print, "Print", 2 * configMINIMAL_STACK_SIZE, NULL, 2, NULL);
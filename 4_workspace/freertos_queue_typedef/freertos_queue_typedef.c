@@ -4,7 +4,9 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "queue.h"
+
+#include "mailbox.h"
+#include "adctemp.h"
 
 /**
  * @brief Estructura para pasar los datos del sensor
@@ -15,8 +17,9 @@ typedef struct {
     float temperature;
 } sensor_data_t;
 
-// Cola para datos del sensor
-QueueHandle_t queue_sensor;
+// Ultimo dato del sensor, reemplaza a la cola de un lugar
+static MAILBOX_BUFFER(sensor_buf, sensor_data_t);
+mailbox_t mailbox_sensor;
 
 /**
  * @brief Tarea de inicializacion
@@ -26,8 +29,6 @@ void task_init(void *params) {
     adc_init();
     adc_set_temp_sensor_enabled(true);
     adc_select_input(ADC_TEMPERATURE_CHANNEL_NUM);
-    // Inicializacion de cola para estructura
-    queue_sensor = xQueueCreate(1, sizeof(sensor_data_t));
     // Elimino tarea para liberar recursos
     vTaskDelete(NULL);
 }
@@ -36,12 +37,13 @@ void task_init(void *params) {
  * @brief Tarea que escribe por consola
  */
 void task_print(void *params) {
-    // Estructura para la cola
+    // Ultimo dato y su version
     sensor_data_t data = {0};
+    uint32_t version = 0;
 
     while(1) {
-        // Leo el ultimo valor que haya en la cola
-        xQueuePeek(queue_sensor, &data, portMAX_DELAY);
+        // Espero un valor mas nuevo que el ultimo mostrado
+        version = mailbox_wait(&mailbox_sensor, &data, version, portMAX_DELAY);
         // Escribo los datos
         printf("ADC raw: 0x%03x\n", data.raw);
         printf("ADC voltage: %.2f V\n", data.voltage);
@@ -55,17 +57,17 @@ void task_print(void *params) {
  * @brief Tarea que lee el ADC
  */
 void task_adc(void *params) {
-    // Estructura para la cola
+    // Estructura para el mailbox
     sensor_data_t data = {0};
 
     while(1) {
-        // Leo el sensor y preparo los datos para la cola
+        // Leo el sensor y preparo los datos
         data.raw = adc_read();
-        data.voltage = data.raw * 3.3 / (1 << 12);
-        // El calculo de temperatura sale de la documentacion del SDK
-        data.temperature = 27 - (data.voltage - 0.706) / 0.001721;
-        // Escribo la cola con siempre el ultimo valor
-        xQueueOverwrite(queue_sensor, &data);
+        data.voltage = data.raw * 3.3f / (1 << 12);
+        // Temperatura de la tabla, en centesimas de grado
+        data.temperature = adctemp_centi(data.raw) / 100.0f;
+        // Reemplazo el ultimo valor, sin seccion critica
+        mailbox_post(&mailbox_sensor, &data);
     }
 }
 
@@ -73,12 +75,17 @@ void task_adc(void *params) {
  * @brief Programa principal
  */
 int main(void) {
+    TaskHandle_t print_handle;
 
     stdio_init_all();
+    adctemp_init();
+    mailbox_init(&mailbox_sensor, sensor_buf, sizeof(sensor_data_t));
 
     // Creacion de tareas
     xTaskCreate(task_init, "Init", configMINIMAL_STACK_SIZE, NULL, 3, NULL);
-    xTaskCreate(task_print, "Print", 2 * configMINIMAL_STACK_SIZE, NULL, 2, NULL);
+    xTaskCreate(task_print, "Print", 2 * configMINIMAL_STACK_SIZE, NULL, 2, &print_handle);
+    // La tarea que imprime espera cada valor nuevo
+    mailbox_subscribe(&mailbox_sensor, print_handle);
     xTaskCreate(task_adc, "ADC", configMINIMAL_STACK_SIZE, NULL, 1, NULL);
     // Arranca el sistema operativo
     vTaskStartScheduler();
@@ -4,20 +4,34 @@
 #include "FreeRTOS.h"
 #include "semphr.h"
 
+#include "input.h"
+
 // GPIO de boton
 #define SEMPHR_BTN  20
 
+// Tiempo de antirrebote del boton
+#define DEBOUNCE_MS 20
+
 // Semaforo para desbloquear tarea
 SemaphoreHandle_t semphr;
 
+// Handle de la tarea que entrega el semaforo
+TaskHandle_t semphr_handle;
+
 /**
  * @brief Tarea de inicializacion
  */
 void task_init(void *params) {
-    // Inicializacion de GPIO para pulsador
-    gpio_init(SEMPHR_BTN);
-    gpio_set_dir(SEMPHR_BTN, false);
-    gpio_pull_up(SEMPHR_BTN);
+    // Registro el pulsador en el servicio de entradas, notifica a la tarea del semaforo
+    input_config_t btn = {
+        .gpio = SEMPHR_BTN,
+        .active_low = true,
+        .debounce_ms = DEBOUNCE_MS,
+        .events = INPUT_EVENT_PRESS,
+        .subscriber = semphr_handle
+    };
+    input_register(&btn);
+    input_start(0);
     // Inicializacion de GPIO para LED
     gpio_init(PICO_DEFAULT_LED_PIN);
     gpio_set_dir(PICO_DEFAULT_LED_PIN, true);
@@ -34,12 +48,10 @@ void task_init(void *params) {
 void task_semphr(void *params) {
 
     while(1) {
+        // Bloqueo hasta que haya una pulsacion sin rebotes, sin consultar el boton
+        input_wait(portMAX_DELAY);
         // Entrega el semaforo al apretar el boton
-        if(!gpio_get(SEMPHR_BTN)) {
-            xSemaphoreGive(semphr);
-        }
-        // Bloqueo para dar lugar a otra tarea
-        vTaskDelay(pdMS_TO_TICKS(100));
+        xSemaphoreGive(semphr);
     }
 }
 
@@ -64,7 +76,7 @@ int main(void) {
 
     // Creacion de tareas
     xTaskCreate(task_init, "Init", configMINIMAL_STACK_SIZE, NULL, 3, NULL);
-    xTaskCreate(task_semphr, "Semphr", configMINIMAL_STACK_SIZE, NULL, 2, NULL);
+    xTaskCreate(task_semphr, "Semphr", configMINIMAL_STACK_SIZE, NULL, 2, &semphr_handle);
     xTaskCreate(task_led, "LED", configMINIMAL_STACK_SIZE, NULL, 1, NULL);
 
     // Inicia el sistema operativo
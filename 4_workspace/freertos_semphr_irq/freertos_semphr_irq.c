@@ -2,41 +2,36 @@
 #include "pico/stdlib.h"
 
 #include "FreeRTOS.h"
-#include "semphr.h"
+#include "task.h"
+
+#include "input.h"
 
 // GPIO de boton
 #define SEMPHR_BTN  20
 
-// Semaforo para desbloquear tarea
-SemaphoreHandle_t semphr;
+// Tiempo de antirrebote del boton
+#define DEBOUNCE_MS 20
 
-/**
- * @brief Callback para interrupcion de GPIO
- */
-void irq_callback(uint gpio, uint32_t event_mask) {
-    // Doy el semaforo para desbloquar
-    BaseType_t to_higher_priority_task = false;
-    xSemaphoreGiveFromISR(semphr, &to_higher_priority_task);
-    // Reviso si es necesario el cambio a otra tarea
-    portYIELD_FROM_ISR(to_higher_priority_task);
-}
+// Handle de la tarea que se desbloquea con el boton
+TaskHandle_t led_handle;
 
 /**
  * @brief Tarea de inicializacion
  */
 void task_init(void *params) {
-    // Inicializacion de GPIO para pulsador
-    gpio_init(SEMPHR_BTN);
-    gpio_set_dir(SEMPHR_BTN, false);
-    gpio_pull_up(SEMPHR_BTN);
-    // Inicializo interrupcion para GPIO por flanco descendente
-    gpio_set_irq_enabled_with_callback(SEMPHR_BTN, GPIO_IRQ_EDGE_FALL, true, irq_callback);
+    // Registro el pulsador en el servicio de entradas, notifica a la tarea del LED
+    input_config_t btn = {
+        .gpio = SEMPHR_BTN,
+        .active_low = true,
+        .debounce_ms = DEBOUNCE_MS,
+        .events = INPUT_EVENT_PRESS,
+        .subscriber = led_handle
+    };
+    input_register(&btn);
+    input_start(0);
     // Inicializacion de GPIO para LED
     gpio_init(PICO_DEFAULT_LED_PIN);
     gpio_set_dir(PICO_DEFAULT_LED_PIN, true);
-    // Inicializacion de semaforo, tomo para bloquar
-    vSemaphoreCreateBinary(semphr);
-    xSemaphoreTake(semphr, portMAX_DELAY);
     // Elimino tarea para liberar recursos
     vTaskDelete(NULL);
 }
@@ -47,8 +42,8 @@ void task_init(void *params) {
 void task_led(void *params) {
 
     while(1) {
-        // Intenta tomar el semaforo, se bloquea si no esta disponible
-        xSemaphoreTake(semphr, portMAX_DELAY);
+        // Se bloquea hasta que la interrupcion notifique una pulsacion sin rebotes
+        input_wait(portMAX_DELAY);
         // Conmuta el LED
         gpio_put(PICO_DEFAULT_LED_PIN, !gpio_get(PICO_DEFAULT_LED_PIN));
     }
@@ -62,7 +57,7 @@ int main(void) {
 
     // Creacion de tareas
     xTaskCreate(task_init, "Init", configMINIMAL_STACK_SIZE, NULL, 2, NULL);
-    xTaskCreate(task_led, "LED", configMINIMAL_STACK_SIZE, NULL, 1, NULL);
+    xTaskCreate(task_led, "LED", configMINIMAL_STACK_SIZE, NULL, 1, &led_handle);
 
     // Inicia el sistema operativo
     vTaskStartScheduler();
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+#include "spsc.h"
+
+// Elementos que agrega cada interrupcion
+#define BURST   8
+// Interrupciones por metodo
+#define ROUNDS  10000
+// Elementos por metodo
+#define ITEMS   (BURST * ROUNDS)
+
+/**
+ * @brief Metodos a comparar
+ */
+typedef enum {
+    BENCH_QUEUE,        // xQueueSendFromISR, un elemento por llamada
+    BENCH_STREAM,       // xStreamBufferSendFromISR, la rafaga en una llamada
+    BENCH_SPSC,         // spsc_push_from_isr, la rafaga en una llamada
+    BENCH_COUNT
+} bench_mode_t;
+
+static const char *bench_names[BENCH_COUNT] = { "xQueueSendFromISR", "xStreamBufferSendFromISR", "spsc_push_from_isr" };
+
+// Metodo en uso, lo cambia la tarea de medicion
+static volatile bench_mode_t mode;
+// Interrupcion de software que hace de productor
+static uint bench_irq;
+// Proximo valor a enviar y proximo valor esperado
+static uint16_t next_value;
+static volatile uint16_t expected_value;
+static volatile uint32_t received;
+static volatile uint32_t errors;
+
+// Canales a comparar
+QueueHandle_t queue;
+StreamBufferHandle_t stream;
+static SPSC_BUFFER(ring_buf, uint16_t, 6);
+spsc_t ring;
+
+// Tarea que mide, se notifica al recibir todos los elementos
+TaskHandle_t bench_handle;
+
+/**
+ * @brief Handler de la interrupcion de software, agrega una rafaga de elementos
+ */
+void bench_irq_handler(void) {
+    // Variable para verificar la necesidad de un cambio tarea
+    BaseType_t to_higher_priority_task = false;
+    uint16_t values[BURST];
+    for (int i = 0; i < BURST; i++) { values[i] = next_value++; }
+
+    switch (mode) {
+        case BENCH_QUEUE:
+            // La cola toma la seccion critica por cada elemento
+            for (int i = 0; i < BURST; i++) { xQueueSendFromISR(queue, &values[i], &to_higher_priority_task); }
+            break;
+        case BENCH_STREAM:
+            xStreamBufferSendFromISR(stream, values, sizeof(values), &to_higher_priority_task);
+            break;
+        default:
+            // Solo toca el kernel si el consumidor habia vaciado el ring
+            spsc_push_from_isr(&ring, values, BURST, &to_higher_priority_task);
+            break;
+    }
+    // Reviso si es necesario el cambio a otra tarea
+    portYIELD_FROM_ISR(to_higher_priority_task);
+}
+
+/**
+ * @brief Verifica los elementos recibidos y avisa al terminar
+ */
+void check_values(const uint16_t *values, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (values[i] != expected_value) { errors++; }
+        expected_value = values[i] + 1;
+    }
+    received += count;
+    if (received == ITEMS) { xTaskNotifyGive(bench_handle); }
+}
+
+/**
+ * @brief Consumidor de la cola
+ */
+void task_queue(void *params) {
+    uint16_t value;
+    while (1) {
+        if (xQueueReceive(queue, &value, portMAX_DELAY) == pdTRUE) { check_values(&value, 1); }
+    }
+}
+
+/**
+ * @brief Consumidor del stream buffer
+ */
+void task_stream(void *params) {
+    uint16_t values[BURST];
+    while (1) {
+        size_t bytes = xStreamBufferReceive(stream, values, sizeof(values), portMAX_DELAY);
+        check_values(values, bytes / sizeof(uint16_t));
+    }
+}
+
+/**
+ * @brief Consumidor del ring SPSC
+ */
+void task_spsc(void *params) {
+    uint16_t values[BURST];
+    while (1) {
+        uint32_t count = spsc_pop_wait(&ring, values, BURST, portMAX_DELAY);
+        check_values(values, count);
+    }
+}
+
+/**
+ * @brief Tarea que dispara las interrupciones y mide cada metodo
+ */
+void task_bench(void *params) {
+    while (1) {
+        for (bench_mode_t m = 0; m < BENCH_COUNT; m++) {
+            mode = m;
+            received = 0;
+            errors = 0;
+            expected_value = next_value;
+
+            uint32_t start = time_us_32();
+            // Cada interrupcion despierta al consumidor, que tiene mas prioridad
+            for (int i = 0; i < ROUNDS; i++) { irq_set_pending(bench_irq); }
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            uint32_t elapsed = time_us_32() - start;
+
+            printf("%-26s %5lu ns por elemento, %lu errores\n", bench_names[m], elapsed * 1000 / ITEMS, errors);
+        }
+        printf("\n");
+        vTaskDelay(pdMS_TO_TICKS(5000));
+    }
+}
+
+/**
+ * @brief Programa principal
+ */
+int main(void) {
+    stdio_init_all();
+
+    // Creo los canales
+    queue = xQueueCreate(64, sizeof(uint16_t));
+    stream = xStreamBufferCreate(128, sizeof(uint16_t));
+    spsc_init(&ring, ring_buf, sizeof(uint16_t), 64);
+
+    // Interrupcion libre del SDK, se dispara por software
+    bench_irq = user_irq_claim_unused(true);
+    irq_set_exclusive_handler(bench_irq, bench_irq_handler);
+    irq_set_enabled(bench_irq, true);
+
+    // Creacion de tareas, los consumidores con mas prioridad que la medicion
+    TaskHandle_t spsc_handle;
+    xTaskCreate(task_queue, "Queue", configMINIMAL_STACK_SIZE, NULL, 3, NULL);
+    xTaskCreate(task_stream, "Stream", configMINIMAL_STACK_SIZE, NULL, 3, NULL);
+    xTaskCreate(task_spsc, "Spsc", configMINIMAL_STACK_SIZE, NULL, 3, &spsc_handle);
+    xTaskCreate(task_bench, "Bench", 2 * configMINIMAL_STACK_SIZE, NULL, 2, &bench_handle);
+    spsc_set_consumer(&ring, spsc_handle);
+
+    // Arranca el sistema operativo
+    vTaskStartScheduler();
+    while(1);
+}
@@ -0,0 +1,112 @@
+#include <cstdio>
+#include <malloc.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "rtos.hpp"
+
+extern "C" {
+#include "adctemp.h"
+}
+
+// Periodo de lectura del ADC
+#define SAMPLE_MS   100
+
+/**
+ * @brief Estructura para pasar los datos del sensor
+ */
+typedef struct {
+    uint16_t raw;
+    float voltage;
+    float temperature;
+} sensor_data_t;
+
+// Todos los objetos del kernel con su memoria reservada al compilar
+static rtos::Queue<sensor_data_t, 4> queue_sensor;      // Cada lectura hacia la tarea que imprime
+static rtos::Mailbox<sensor_data_t> latest;             // Ultima lectura, para el reporte
+static rtos::Semaphore<> tick;                          // Lo da la interrupcion del timer en cada periodo
+static rtos::Mutex console;                             // Consola compartida por dos tareas
+static rtos::Task<configMINIMAL_STACK_SIZE> adc_task;
+static rtos::Task<2 * configMINIMAL_STACK_SIZE> print_task;
+static rtos::Task<2 * configMINIMAL_STACK_SIZE> report_task;
+
+/**
+ * @brief Callback del timer, marca el periodo de lectura
+ */
+bool sample_timer(repeating_timer_t *timer) {
+    BaseType_t to_higher_priority_task = pdFALSE;
+    tick.give_from_isr(&to_higher_priority_task);
+    portYIELD_FROM_ISR(to_higher_priority_task);
+    return true;
+}
+
+/**
+ * @brief Tarea que lee el ADC en cada periodo
+ */
+void task_adc(void *params) {
+    sensor_data_t data = {};
+
+    while (1) {
+        tick.take();
+        data.raw = adc_read();
+        data.voltage = data.raw * 3.3f / (1 << 12);
+        data.temperature = adctemp_centi(data.raw) / 100.0f;
+        latest.write(data);
+        // Si la consola se atrasa se descarta la lectura, no se bloquea
+        queue_sensor.send(data, 0);
+    }
+}
+
+/**
+ * @brief Tarea que escribe cada lectura por consola
+ */
+void task_print(void *params) {
+    sensor_data_t data;
+
+    while (1) {
+        queue_sensor.receive(data);
+        rtos::Mutex::Guard guard(console);
+        printf("ADC raw: 0x%03x, %.2f V, %.2f C\n", data.raw, data.voltage, data.temperature);
+    }
+}
+
+/**
+ * @brief Tarea que muestra la ocupacion de la cola y el heap cada 5 segundos
+ */
+void task_report(void *params) {
+    sensor_data_t data;
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(5000));
+        latest.read(data);
+        rtos::Mutex::Guard guard(console);
+        // Lo que muestra mallinfo es del SDK y de newlib, el kernel no pide memoria
+        printf("\ncola %lu/4, ultima %.2f C, heap %u B\n\n", queue_sensor.waiting(), data.temperature, mallinfo().uordblks);
+    }
+}
+
+/**
+ * @brief Programa principal
+ */
+int main(void) {
+    static repeating_timer_t timer;
+
+    stdio_init_all();
+    adctemp_init();
+    adc_init();
+    adc_set_temp_sensor_enabled(true);
+    adc_select_input(ADC_TEMPERATURE_CHANNEL_NUM);
+
+    // Creacion de tareas, no pueden fallar por falta de memoria
+    adc_task.start(task_adc, "ADC", 3);
+    print_task.start(task_print, "Print", 2);
+    report_task.start(task_report, "Report", 1);
+    add_repeating_timer_ms(SAMPLE_MS, sample_timer, NULL, &timer);
+
+    // Arranca el sistema operativo
+    vTaskStartScheduler();
+    while (true);
+}
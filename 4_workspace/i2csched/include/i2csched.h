@@ -0,0 +1,39 @@
+#ifndef _I2CSCHED_H_
+#define _I2CSCHED_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "i2csched_queue.h"
+
+// Indice de notificacion de la tarea del bus y de las tareas que esperan un
+// trabajo. Se puede compartir con mailbox y spsc: la espera vuelve a mirar el
+// trabajo, una notificacion ajena solo causa una vuelta extra
+#ifndef I2CSCHED_NOTIFY_INDEX
+#define I2CSCHED_NOTIFY_INDEX   2
+#endif
+
+/**
+ * @brief Planificador de un bus: una tarea que ejecuta los pasos de los
+ * trabajos de a uno, el de mayor prioridad y menor plazo primero
+ */
+typedef struct {
+    TaskHandle_t task;
+    UBaseType_t priority;       // Prioridad propia de la tarea, sin herencia
+    i2csched_queue_t queue;
+} i2csched_t;
+
+// Prototipos de funciones
+bool i2csched_start(i2csched_t *sched, const char *name, UBaseType_t priority, configSTACK_DEPTH_TYPE stack);
+void i2csched_client_init(i2csched_client_t *client, const char *name, uint8_t priority, uint32_t deadline_us);
+void i2csched_job_init(i2csched_job_t *job, i2csched_client_t *client, i2csched_step_t step, void *context);
+bool i2csched_submit(i2csched_t *sched, i2csched_job_t *job);
+bool i2csched_run(i2csched_t *sched, i2csched_job_t *job);
+void i2csched_call(i2csched_t *sched, i2csched_client_t *client, void (*function)(void *arg), void *arg);
+void i2csched_get_stats(const i2csched_client_t *client, i2csched_stats_t *stats);
+void i2csched_reset_stats(i2csched_client_t *client);
+
+#endif
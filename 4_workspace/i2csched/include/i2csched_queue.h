@@ -0,0 +1,80 @@
+#ifndef _I2CSCHED_QUEUE_H_
+#define _I2CSCHED_QUEUE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Lo devuelve el paso de un trabajo cuando no queda nada por hacer
+#define I2CSCHED_DONE           UINT32_MAX
+
+typedef struct i2csched_job i2csched_job_t;
+
+/**
+ * @brief Paso de un trabajo: ocupa el bus con una o pocas transacciones y
+ * vuelve. Corre en la tarea del bus, job->chunk cuenta los pasos anteriores
+ * @return I2CSCHED_DONE, o los microsegundos que el trabajo no necesita el bus
+ * antes del proximo paso (0 si puede seguir enseguida). Entre dos pasos el bus
+ * atiende a los trabajos de mayor prioridad
+ */
+typedef uint32_t (*i2csched_step_t)(i2csched_job_t *job);
+
+/**
+ * @brief Contadores de un cliente, en microsegundos
+ */
+typedef struct {
+    uint32_t jobs;              // Trabajos terminados
+    uint32_t chunks;            // Pasos ejecutados
+    uint32_t misses;            // Trabajos que terminaron despues del plazo
+    uint32_t wait_max_us;       // Mayor espera desde que se encola hasta el primer paso
+    uint32_t latency_max_us;    // Mayor tiempo desde que se encola hasta que termina
+    uint64_t latency_sum_us;    // Suma de los tiempos, para el promedio
+    uint32_t chunk_max_us;      // Paso mas largo
+    uint32_t bus_us;            // Tiempo total ocupando el bus
+} i2csched_stats_t;
+
+/**
+ * @brief Cliente del bus, un driver: prioridad y plazo de sus trabajos
+ */
+typedef struct {
+    const char *name;
+    uint8_t priority;           // Mayor numero se atiende primero
+    uint32_t deadline_us;       // Plazo de cada trabajo desde que se encola
+    i2csched_stats_t stats;     // Solo los escribe la tarea del bus
+} i2csched_client_t;
+
+/**
+ * @brief Trabajo de un cliente. Vive mientras este encolado, normalmente es
+ * static junto al driver
+ */
+struct i2csched_job {
+    i2csched_job_t *next;
+    i2csched_client_t *client;
+    i2csched_step_t step;
+    void *context;              // Datos propios del paso
+    uint32_t chunk;             // Pasos ya ejecutados, 0 en el primero
+    uint32_t submitted_us;      // Cuando se encolo
+    uint32_t deadline_us;       // Plazo absoluto
+    uint32_t ready_us;          // El proximo paso no va antes de este tiempo
+    uint32_t order;             // Orden de llegada, desempata a igual plazo
+    bool started;
+    volatile bool busy;         // Encolado o en curso
+    bool again;                 // Se volvio a pedir mientras estaba en curso
+    void *waiter;               // Tarea que espera el final (TaskHandle_t) o NULL
+    uint32_t waiter_priority;
+};
+
+/**
+ * @brief Cola de trabajos de un bus, sin el kernel ni el hardware
+ */
+typedef struct {
+    i2csched_job_t *pending;    // Trabajos encolados, solo con la seccion critica
+    uint32_t order;
+} i2csched_queue_t;
+
+// Cola de trabajos con el tiempo como argumento. Van con la seccion critica
+void i2csched_queue_push(i2csched_queue_t *queue, i2csched_job_t *job, uint32_t now);
+i2csched_job_t *i2csched_queue_pick(i2csched_queue_t *queue, uint32_t now, uint32_t *wait_us);
+bool i2csched_queue_account(i2csched_queue_t *queue, i2csched_job_t *job, uint32_t start, uint32_t end, uint32_t result);
+uint32_t i2csched_queue_boost(const i2csched_queue_t *queue);
+
+#endif
@@ -0,0 +1,204 @@
+#include <string.h>
+#include "pico/stdlib.h"
+
+#include "i2csched.h"
+
+/**
+ * @brief Tarea del bus: ejecuta un paso por vuelta y vuelve a elegir, asi un
+ * trabajo urgente espera como mucho el paso en curso
+ * @param params planificador
+ */
+static void i2csched_task(void *params) {
+    i2csched_t *sched = (i2csched_t *)params;
+    uint32_t wait_us;
+
+    while (1) {
+        taskENTER_CRITICAL();
+        i2csched_job_t *job = i2csched_queue_pick(&sched->queue, time_us_32(), &wait_us);
+        taskEXIT_CRITICAL();
+
+        if (!job) {
+            // Nada listo: espera un trabajo nuevo o al primero que deja el bus libre un rato
+            TickType_t ticks = wait_us == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS((wait_us + 999) / 1000) + 1;
+            ulTaskNotifyTakeIndexed(I2CSCHED_NOTIFY_INDEX, pdTRUE, ticks);
+            continue;
+        }
+
+        uint32_t start = time_us_32();
+        uint32_t result = job->step(job);
+        uint32_t end = time_us_32();
+
+        taskENTER_CRITICAL();
+        TaskHandle_t waiter = (TaskHandle_t)job->waiter;
+        bool done = i2csched_queue_account(&sched->queue, job, start, end, result);
+        // Herencia de prioridad: la tarea corre con la mayor de las que esperan.
+        // Se cambia dentro de la seccion critica, si no una tarea que encola
+        // entre el calculo y el cambio sube la prioridad y aca se la vuelve a bajar
+        UBaseType_t priority = i2csched_queue_boost(&sched->queue);
+        if (priority < sched->priority) { priority = sched->priority; }
+        if (priority != uxTaskPriorityGet(NULL)) { vTaskPrioritySet(NULL, priority); }
+        taskEXIT_CRITICAL();
+
+        if (done && waiter) { xTaskNotifyGiveIndexed(waiter, I2CSCHED_NOTIFY_INDEX); }
+    }
+}
+
+/**
+ * @brief Crea la tarea del bus. Llamar antes de vTaskStartScheduler, despues de
+ * inicializar los dispositivos con las funciones bloqueantes
+ * @param sched planificador
+ * @param name nombre de la tarea
+ * @param priority prioridad de la tarea, menor que la de los clientes urgentes
+ * para que puedan encolar mientras corre un trabajo largo
+ * @param stack stack de la tarea, el del paso mas profundo
+ * @return true si se pudo crear la tarea
+ */
+bool i2csched_start(i2csched_t *sched, const char *name, UBaseType_t priority, configSTACK_DEPTH_TYPE stack) {
+    memset(sched, 0, sizeof(*sched));
+    sched->priority = priority;
+    return xTaskCreate(i2csched_task, name, stack, sched, priority, &sched->task) == pdPASS;
+}
+
+/**
+ * @brief Inicializa un cliente
+ * @param client cliente
+ * @param name nombre para el reporte
+ * @param priority prioridad de sus trabajos, mayor numero primero
+ * @param deadline_us plazo de cada trabajo desde que se encola
+ */
+void i2csched_client_init(i2csched_client_t *client, const char *name, uint8_t priority, uint32_t deadline_us) {
+    memset(client, 0, sizeof(*client));
+    client->name = name;
+    client->priority = priority;
+    client->deadline_us = deadline_us;
+}
+
+/**
+ * @brief Inicializa un trabajo
+ * @param job trabajo
+ * @param client cliente al que pertenece
+ * @param step paso del trabajo
+ * @param context datos propios del paso
+ */
+void i2csched_job_init(i2csched_job_t *job, i2csched_client_t *client, i2csched_step_t step, void *context) {
+    memset(job, 0, sizeof(*job));
+    job->client = client;
+    job->step = step;
+    job->context = context;
+}
+
+/**
+ * @brief Encola un trabajo sin esperar. Si ya estaba en curso, al terminar
+ * arranca otra vez desde el primer paso: un display redibuja con el ultimo
+ * contenido sin encolar un cuadro por cada cambio
+ * @param sched planificador
+ * @param job trabajo
+ * @return true si se encolo, false si quedo pedido para despues del actual
+ */
+bool i2csched_submit(i2csched_t *sched, i2csched_job_t *job) {
+    bool queued = false;
+
+    taskENTER_CRITICAL();
+    if (job->busy) {
+        job->again = true;
+    } else {
+        job->waiter = NULL;
+        job->waiter_priority = 0;
+        i2csched_queue_push(&sched->queue, job, time_us_32());
+        queued = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if (queued) { xTaskNotifyGiveIndexed(sched->task, I2CSCHED_NOTIFY_INDEX); }
+    return queued;
+}
+
+/**
+ * @brief Encola un trabajo y espera que termine. La tarea del bus hereda la
+ * prioridad de la que espera hasta terminarlo. Si el trabajo ya estaba
+ * encolado o en curso por i2csched_submit queda pedido otra vez, como en
+ * i2csched_submit, y se espera el final de esa vuelta
+ * @param sched planificador
+ * @param job trabajo
+ * @return true al terminar, false sin hacer nada si otra tarea ya lo espera
+ */
+bool i2csched_run(i2csched_t *sched, i2csched_job_t *job) {
+    UBaseType_t priority = uxTaskPriorityGet(NULL);
+
+    taskENTER_CRITICAL();
+    if (job->busy && job->waiter) {
+        // Un solo aviso por trabajo: encolarlo de nuevo cerraria la lista sobre si misma
+        taskEXIT_CRITICAL();
+        return false;
+    }
+    if (job->busy) {
+        job->again = true;
+    } else {
+        i2csched_queue_push(&sched->queue, job, time_us_32());
+    }
+    job->waiter = xTaskGetCurrentTaskHandle();
+    job->waiter_priority = priority;
+    // Junto con el encolado: fuera de la seccion critica el trabajo ya pudo terminar
+    if (priority > uxTaskPriorityGet(sched->task)) { vTaskPrioritySet(sched->task, priority); }
+    taskEXIT_CRITICAL();
+
+    xTaskNotifyGiveIndexed(sched->task, I2CSCHED_NOTIFY_INDEX);
+
+    while (job->busy) { ulTaskNotifyTakeIndexed(I2CSCHED_NOTIFY_INDEX, pdTRUE, portMAX_DELAY); }
+    return true;
+}
+
+/**
+ * @brief Funcion y argumento de i2csched_call
+ */
+typedef struct {
+    void (*function)(void *arg);
+    void *arg;
+} call_t;
+
+/**
+ * @brief Paso de i2csched_call: un solo llamado
+ */
+static uint32_t call_step(i2csched_job_t *job) {
+    call_t *call = (call_t *)job->context;
+    call->function(call->arg);
+    return I2CSCHED_DONE;
+}
+
+/**
+ * @brief Ejecuta una funcion en la tarea del bus y espera que termine. Sirve
+ * para leer o cambiar el estado que comparten los drivers, como el registro
+ * de i2c_trace, sin un mutex aparte
+ * @param sched planificador
+ * @param client cliente que hace el pedido
+ * @param function funcion a ejecutar con el bus tomado
+ * @param arg argumento de la funcion
+ */
+void i2csched_call(i2csched_t *sched, i2csched_client_t *client, void (*function)(void *arg), void *arg) {
+    call_t call = { function, arg };
+    i2csched_job_t job;
+
+    i2csched_job_init(&job, client, call_step, &call);
+    i2csched_run(sched, &job);
+}
+
+/**
+ * @brief Copia consistente de los contadores de un cliente
+ * @param client cliente
+ * @param stats copia
+ */
+void i2csched_get_stats(const i2csched_client_t *client, i2csched_stats_t *stats) {
+    taskENTER_CRITICAL();
+    *stats = client->stats;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Pone en cero los contadores de un cliente
+ * @param client cliente
+ */
+void i2csched_reset_stats(i2csched_client_t *client) {
+    taskENTER_CRITICAL();
+    memset(&client->stats, 0, sizeof(client->stats));
+    taskEXIT_CRITICAL();
+}
@@ -0,0 +1,124 @@
+#include <stddef.h>
+
+#include "i2csched_queue.h"
+
+/**
+ * @brief Encola un trabajo nuevo, desde su primer paso
+ * @param queue cola del planificador
+ * @param job trabajo, no tiene que estar encolado
+ * @param now tiempo actual en microsegundos
+ */
+void i2csched_queue_push(i2csched_queue_t *queue, i2csched_job_t *job, uint32_t now) {
+    job->chunk = 0;
+    job->started = false;
+    job->again = false;
+    job->busy = true;
+    job->submitted_us = now;
+    job->deadline_us = now + job->client->deadline_us;
+    job->ready_us = now;
+    job->order = queue->order++;
+    job->next = queue->pending;
+    queue->pending = job;
+}
+
+/**
+ * @brief Decide si a va antes que b: mayor prioridad, despues menor plazo y
+ * despues el que llego primero
+ */
+static bool before(const i2csched_job_t *a, const i2csched_job_t *b) {
+    if (a->client->priority != b->client->priority) { return a->client->priority > b->client->priority; }
+    if (a->deadline_us != b->deadline_us) { return (int32_t)(a->deadline_us - b->deadline_us) < 0; }
+    return (int32_t)(a->order - b->order) < 0;
+}
+
+/**
+ * @brief Saca de la cola el trabajo que sigue
+ * @param queue cola del planificador
+ * @param now tiempo actual en microsegundos
+ * @param wait_us si no hay ninguno listo, tiempo hasta el primero que espera,
+ * o UINT32_MAX si la cola esta vacia
+ * @return el trabajo o NULL
+ */
+i2csched_job_t *i2csched_queue_pick(i2csched_queue_t *queue, uint32_t now, uint32_t *wait_us) {
+    i2csched_job_t **best = NULL;
+    uint32_t wait = UINT32_MAX;
+
+    for (i2csched_job_t **link = &queue->pending; *link; link = &(*link)->next) {
+        i2csched_job_t *job = *link;
+        int32_t left = (int32_t)(job->ready_us - now);
+        if (left > 0) {
+            if ((uint32_t)left < wait) { wait = left; }
+        } else if (!best || before(job, *best)) {
+            best = link;
+        }
+    }
+
+    *wait_us = best ? 0 : wait;
+    if (!best) { return NULL; }
+    i2csched_job_t *job = *best;
+    *best = job->next;
+    return job;
+}
+
+/**
+ * @brief Registra un paso. Si el trabajo sigue vuelve a la cola, y si se volvio
+ * a pedir mientras estaba en curso arranca de nuevo
+ * @param queue cola del planificador
+ * @param job trabajo que ejecuto el paso
+ * @param start inicio del paso en microsegundos
+ * @param end final del paso en microsegundos
+ * @param result lo que devolvio el paso
+ * @return true si el trabajo termino y ya no esta ocupado
+ */
+bool i2csched_queue_account(i2csched_queue_t *queue, i2csched_job_t *job, uint32_t start, uint32_t end, uint32_t result) {
+    i2csched_stats_t *stats = &job->client->stats;
+    uint32_t run = end - start;
+
+    stats->chunks++;
+    stats->bus_us += run;
+    if (run > stats->chunk_max_us) { stats->chunk_max_us = run; }
+    if (!job->started) {
+        uint32_t wait = start - job->submitted_us;
+        if (wait > stats->wait_max_us) { stats->wait_max_us = wait; }
+        job->started = true;
+    }
+    job->chunk++;
+
+    if (result != I2CSCHED_DONE) {
+        job->ready_us = end + result;
+        job->next = queue->pending;
+        queue->pending = job;
+        return false;
+    }
+
+    uint32_t latency = end - job->submitted_us;
+    stats->jobs++;
+    stats->latency_sum_us += latency;
+    if (latency > stats->latency_max_us) { stats->latency_max_us = latency; }
+    if ((int32_t)(end - job->deadline_us) > 0) { stats->misses++; }
+
+    if (job->again) {
+        void *waiter = job->waiter;
+        uint32_t waiter_priority = job->waiter_priority;
+        i2csched_queue_push(queue, job, end);
+        job->waiter = waiter;
+        job->waiter_priority = waiter_priority;
+        return false;
+    }
+    job->busy = false;
+    return true;
+}
+
+/**
+ * @brief Mayor prioridad de las tareas que esperan un trabajo encolado
+ * @param queue cola del planificador
+ * @return la prioridad, 0 si nadie espera
+ */
+uint32_t i2csched_queue_boost(const i2csched_queue_t *queue) {
+    uint32_t boost = 0;
+
+    for (const i2csched_job_t *job = queue->pending; job; job = job->next) {
+        if (job->waiter && job->waiter_priority > boost) { boost = job->waiter_priority; }
+    }
+    return boost;
+}
@@ -0,0 +1,163 @@
+#include <stdio.h>
+
+#include "check.h"
+#include "pico/stdlib.h"
+#include "i2csched.h"
+
+// Prioridades: la tarea del bus por debajo de las que esperan
+#define BUS_PRIORITY    1
+#define SECOND_PRIORITY 2
+#define FIRST_PRIORITY  3
+// Pasos de un trabajo del LCD, cada uno deja el dispositivo ocupado
+#define LCD_STEPS       4
+#define LCD_BUSY_US     3000
+
+static i2csched_t bus;
+static i2csched_client_t lcd_client;
+static i2csched_job_t lcd_job;
+
+// Pasos del LCD ejecutados y el tick en que termino cada i2csched_run
+static uint32_t lcd_steps;
+static bool first_result, second_result;
+static TickType_t first_done, second_done;
+static TaskHandle_t first, second;
+
+// Trabajos de la tarea que cambia de prioridad mientras espera
+static i2csched_client_t sensor_client;
+static i2csched_job_t hold_job, next_job;
+static TaskHandle_t waiter;
+// Prioridad de la tarea del bus en el paso de next_job
+static UBaseType_t next_priority;
+
+// Interrupcion simulada en cada tick: el reloj de microsegundos avanza con el tick
+static void isr(void) {
+    host_time_us += 1000000 / configTICK_RATE_HZ;
+}
+
+static uint32_t lcd_step(i2csched_job_t *job) {
+    lcd_steps++;
+    return job->chunk + 1 < LCD_STEPS ? LCD_BUSY_US : I2CSCHED_DONE;
+}
+
+// Espera el trabajo del LCD desde el principio
+static void task_first(void *params) {
+    (void)params;
+    first_result = i2csched_run(&bus, &lcd_job);
+    first_done = xTaskGetTickCount();
+    vTaskSuspend(NULL);
+}
+
+// Pide el mismo trabajo mientras la primera lo espera
+static void task_second(void *params) {
+    (void)params;
+    vTaskDelay(2);
+    second_result = i2csched_run(&bus, &lcd_job);
+    second_done = xTaskGetTickCount();
+    vTaskSuspend(NULL);
+}
+
+/**
+ * @brief Dos tareas esperan el mismo trabajo: la segunda vuelve enseguida sin
+ * encolarlo otra vez, y el trabajo corre una sola vez
+ */
+static void test_two_waiters(void) {
+    lcd_steps = 0;
+    xTaskCreate(task_first, "First", configMINIMAL_STACK_SIZE, NULL, FIRST_PRIORITY, &first);
+    xTaskCreate(task_second, "Second", configMINIMAL_STACK_SIZE, NULL, SECOND_PRIORITY, &second);
+    vTaskDelay(50);
+
+    printf("dos esperas: la primera termina en el tick %u, la segunda vuelve en el %u, %u pasos\n",
+           (unsigned)first_done, (unsigned)second_done, lcd_steps);
+    CHECK(first_result);
+    CHECK(!second_result);
+    CHECK_EQ(second_done, 2);
+    CHECK(first_done > second_done);
+    CHECK_EQ(lcd_steps, LCD_STEPS);
+    CHECK_EQ(lcd_client.stats.jobs, 1);
+    CHECK(!lcd_job.busy);
+}
+
+/**
+ * @brief i2csched_run sobre un trabajo que ya mando i2csched_submit: queda
+ * pedido otra vez y vuelve con el final de la segunda vuelta
+ */
+static void test_run_submitted(void) {
+    lcd_steps = 0;
+    i2csched_reset_stats(&lcd_client);
+    CHECK(i2csched_submit(&bus, &lcd_job));
+    vTaskDelay(1);
+    CHECK(lcd_job.busy);
+    CHECK(i2csched_run(&bus, &lcd_job));
+    CHECK(!lcd_job.busy);
+    CHECK_EQ(lcd_steps, 2 * LCD_STEPS);
+    CHECK_EQ(lcd_client.stats.jobs, 2);
+
+    // Sin nada encolado corre una vez
+    lcd_steps = 0;
+    CHECK(i2csched_run(&bus, &lcd_job));
+    CHECK_EQ(lcd_steps, LCD_STEPS);
+}
+
+// Deja el dispositivo ocupado un paso, la tarea del bus duerme con el trabajo en curso
+static uint32_t hold_step(i2csched_job_t *job) {
+    return job->chunk == 0 ? LCD_BUSY_US : I2CSCHED_DONE;
+}
+
+static uint32_t next_step(i2csched_job_t *job) {
+    (void)job;
+    next_priority = uxTaskPriorityGet(NULL);
+    return I2CSCHED_DONE;
+}
+
+// Espera un trabajo y, apenas la despiertan, encola el siguiente
+static void task_waiter(void *params) {
+    (void)params;
+    i2csched_run(&bus, &hold_job);
+    i2csched_run(&bus, &next_job);
+    vTaskSuspend(NULL);
+}
+
+/**
+ * @brief La tarea que espera sube de prioridad durante el trabajo, asi que el
+ * aviso del final desaloja a la tarea del bus justo despues de calcular la
+ * herencia. La tarea despierta encola otro trabajo y sube la del bus: el paso
+ * siguiente tiene que correr con esa prioridad y no con la calculada antes
+ */
+static void test_boost_race(void) {
+    next_priority = 0;
+    i2csched_client_init(&sensor_client, "Sensor", 1, 10000);
+    i2csched_job_init(&hold_job, &sensor_client, hold_step, NULL);
+    i2csched_job_init(&next_job, &sensor_client, next_step, NULL);
+    xTaskCreate(task_waiter, "Waiter", configMINIMAL_STACK_SIZE, NULL, SECOND_PRIORITY, &waiter);
+    vTaskDelay(1);
+    CHECK(hold_job.busy);
+    CHECK_EQ(uxTaskPriorityGet(bus.task), SECOND_PRIORITY);
+    vTaskPrioritySet(waiter, FIRST_PRIORITY);
+    vTaskDelay(20);
+
+    printf("prioridad de la tarea del bus en el trabajo encolado al despertar: %u\n", (unsigned)next_priority);
+    CHECK_EQ(next_priority, FIRST_PRIORITY);
+    CHECK(!next_job.busy);
+    CHECK_EQ(sensor_client.stats.jobs, 2);
+    CHECK_EQ(uxTaskPriorityGet(bus.task), BUS_PRIORITY);
+}
+
+static void task_test(void *params) {
+    (void)params;
+    test_two_waiters();
+    test_run_submitted();
+    test_boost_race();
+    vTaskEndScheduler();
+}
+
+int main(void) {
+    host_port_isr = isr;
+    host_port_tick_limit = 1000;
+    i2csched_client_init(&lcd_client, "LCD", 0, 100000);
+    i2csched_job_init(&lcd_job, &lcd_client, lcd_step, NULL);
+    CHECK(i2csched_start(&bus, "Bus", BUS_PRIORITY, configMINIMAL_STACK_SIZE));
+    CHECK(xTaskCreate(task_test, "Test", configMINIMAL_STACK_SIZE, NULL, FIRST_PRIORITY + 1, NULL) == pdPASS);
+    vTaskStartScheduler();
+    CHECK(!host_port_timed_out);
+    return check_result("i2csched");
+}
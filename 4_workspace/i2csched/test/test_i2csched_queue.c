@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "check.h"
+#include "i2csched_queue.h"
+
+// Comandos de un cuadro del LCD de dos lineas, como LCD_FRAME_COMMANDS
+#define FRAME_COMMANDS  (2 * (16 + 1))
+// Tiempo simulado de la prueba del bus
+#define SIM_US          (60u * 1000000u)
+// Plazo del sensor, el que pide el tp4
+#define SENSOR_DEADLINE 2000u
+
+/**
+ * @brief Resultado de una simulacion del bus
+ */
+typedef struct {
+    i2csched_stats_t sensor;
+    i2csched_stats_t lcd;
+    uint32_t redraws;
+    uint32_t restarts;
+} sim_result_t;
+
+// Reloj del bus simulado en microsegundos
+static uint32_t now;
+// Con true el cuadro va en un solo paso, como con el mutex alrededor del cuadro entero
+static bool whole_frame;
+
+// Generador congruencial, las llegadas son siempre las mismas
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+/**
+ * @brief Una escritura de len bytes mas la direccion a 100 kHz, 9 bits por byte
+ */
+static uint32_t cost(uint32_t len) {
+    return (1 + len) * 9 * 10;
+}
+
+static uint32_t sensor_step(i2csched_job_t *job) {
+    (void)job;
+    // Registro a leer, los seis bytes de datos y el cambio de direccion
+    now += cost(1) + cost(6) + 20;
+    return I2CSCHED_DONE;
+}
+
+// Un comando del cuadro por paso, o el cuadro entero
+static uint32_t lcd_step(i2csched_job_t *job) {
+    if (whole_frame) {
+        now += FRAME_COMMANDS * cost(6);
+        return I2CSCHED_DONE;
+    }
+    now += cost(6);
+    return job->chunk + 1 < FRAME_COMMANDS ? 0 : I2CSCHED_DONE;
+}
+
+/**
+ * @brief Simula la tarea del bus durante SIM_US: una lectura del sensor cada 5 a
+ * 25 ms con i2csched_run y un cuadro del LCD cada 20 a 50 ms con
+ * i2csched_submit. Las tareas que encolan desalojan a la del bus, asi que un
+ * pedido entra a la cola en el momento en que llega
+ */
+static void simulate(bool whole, sim_result_t *result) {
+    i2csched_queue_t queue = { 0 };
+    i2csched_client_t sensor = { "Sensor", 2, SENSOR_DEADLINE, { 0 } };
+    i2csched_client_t lcd = { "LCD", 0, 100000, { 0 } };
+    i2csched_job_t sensor_job = { 0 }, lcd_job = { 0 };
+    uint32_t next_sensor = 300, next_lcd = 0, wait;
+
+    memset(result, 0, sizeof(*result));
+    whole_frame = whole;
+    now = 0;
+    seed = 12345;
+    sensor_job.client = &sensor;
+    sensor_job.step = sensor_step;
+    lcd_job.client = &lcd;
+    lcd_job.step = lcd_step;
+
+    while (now < SIM_US) {
+        if ((int32_t)(now - next_lcd) >= 0) {
+            // i2csched_submit: si esta redibujando vuelve a empezar con el contenido nuevo
+            if (lcd_job.busy) {
+                lcd_job.again = true;
+                result->restarts++;
+            } else {
+                i2csched_queue_push(&queue, &lcd_job, next_lcd);
+            }
+            next_lcd += 20000 + next_random() % 30000;
+            result->redraws++;
+        }
+        if ((int32_t)(now - next_sensor) >= 0 && !sensor_job.busy) {
+            // i2csched_run: la tarea del sensor espera con su prioridad
+            i2csched_queue_push(&queue, &sensor_job, next_sensor);
+            sensor_job.waiter = &sensor;
+            sensor_job.waiter_priority = 2;
+            next_sensor += 5000 + next_random() % 20000;
+        }
+
+        i2csched_job_t *job = i2csched_queue_pick(&queue, now, &wait);
+        if (!job) {
+            // La tarea del bus duerme hasta el proximo pedido
+            now = (int32_t)(next_sensor - next_lcd) < 0 ? next_sensor : next_lcd;
+            continue;
+        }
+        uint32_t start = now, step = job->step(job);
+        i2csched_queue_account(&queue, job, start, now, step);
+    }
+    result->sensor = sensor.stats;
+    result->lcd = lcd.stats;
+}
+
+static void print_result(const char *name, const sim_result_t *result) {
+    printf("%s: sensor espera max %.2f ms, latencia max %.2f ms, promedio %.2f ms, %u de %u fuera de plazo; "
+           "LCD max %.2f ms\n",
+           name, result->sensor.wait_max_us / 1000.0, result->sensor.latency_max_us / 1000.0,
+           (double)result->sensor.latency_sum_us / result->sensor.jobs / 1000.0, result->sensor.misses,
+           result->sensor.jobs, result->lcd.latency_max_us / 1000.0);
+}
+
+/**
+ * @brief El bus simulado con el cuadro por comandos y con el cuadro entero: el
+ * sensor tiene que terminar siempre antes de SENSOR_DEADLINE
+ */
+static void test_bus(void) {
+    sim_result_t sched, mutex;
+
+    simulate(false, &sched);
+    simulate(true, &mutex);
+    printf("bus simulado %u s: %u lecturas del sensor, %u cuadros (%u pedidos otra vez)\n", SIM_US / 1000000,
+           sched.sensor.jobs, sched.lcd.jobs, sched.restarts);
+    print_result("cuadro entero", &mutex);
+    print_result("por comandos", &sched);
+
+    CHECK(sched.sensor.jobs > 1000);
+    CHECK(sched.sensor.latency_max_us < SENSOR_DEADLINE);
+    CHECK_EQ(sched.sensor.misses, 0);
+    // Espera como mucho un comando del LCD
+    CHECK(sched.sensor.wait_max_us <= cost(6));
+    CHECK_EQ(sched.lcd.chunk_max_us, cost(6));
+    CHECK_EQ(sched.lcd.misses, 0);
+    // Con el cuadro entero el sensor pierde plazos
+    CHECK(mutex.sensor.latency_max_us > SENSOR_DEADLINE);
+    CHECK(mutex.sensor.misses > 0);
+}
+
+static uint32_t hold_step(i2csched_job_t *job) {
+    // El dispositivo queda ocupado 2 ms sin usar el bus, como el borrado del HD44780
+    return job->chunk == 0 ? 2000 : I2CSCHED_DONE;
+}
+
+static uint32_t one_step(i2csched_job_t *job) {
+    (void)job;
+    return I2CSCHED_DONE;
+}
+
+// Orden de la cola: prioridad, plazo, llegada, y los plazos con la vuelta del contador
+static void test_order(void) {
+    i2csched_queue_t queue = { 0 };
+    i2csched_client_t high = { "High", 2, 2000, { 0 } }, low = { "Low", 0, 100, { 0 } };
+    i2csched_client_t early = { "Early", 0, 50, { 0 } };
+    i2csched_job_t jobs[4] = { 0 };
+    uint32_t wait;
+
+    CHECK(!i2csched_queue_pick(&queue, 0, &wait));
+    CHECK_EQ(wait, UINT32_MAX);
+
+    jobs[0].client = &low;
+    jobs[1].client = &low;
+    jobs[2].client = &early;
+    jobs[3].client = &high;
+    for (int i = 0; i < 4; i++) { i2csched_queue_push(&queue, &jobs[i], 10); }
+    // La mayor prioridad aunque su plazo sea el mas lejano
+    CHECK(i2csched_queue_pick(&queue, 10, &wait) == &jobs[3]);
+    CHECK_EQ(wait, 0);
+    // A igual prioridad el plazo mas cercano, y a igual plazo el que llego primero
+    CHECK(i2csched_queue_pick(&queue, 10, &wait) == &jobs[2]);
+    CHECK(i2csched_queue_pick(&queue, 10, &wait) == &jobs[0]);
+    CHECK(i2csched_queue_pick(&queue, 10, &wait) == &jobs[1]);
+    CHECK(!i2csched_queue_pick(&queue, 10, &wait));
+
+    // El plazo de antes de la vuelta del contador va primero, aunque llego despues
+    i2csched_queue_push(&queue, &jobs[1], 20);
+    i2csched_queue_push(&queue, &jobs[0], UINT32_MAX - 110);
+    CHECK(i2csched_queue_pick(&queue, 30, &wait) == &jobs[0]);
+    CHECK(i2csched_queue_pick(&queue, 30, &wait) == &jobs[1]);
+}
+
+/**
+ * @brief Un trabajo que deja el dispositivo ocupado: el bus atiende a otro
+ * mientras tanto, la herencia de prioridad, el pedido otra vez y los contadores
+ */
+static void test_hold(void) {
+    i2csched_queue_t queue = { 0 };
+    i2csched_client_t lcd = { "LCD", 0, 100, { 0 } }, sensor = { "Sensor", 2, 2000, { 0 } };
+    i2csched_job_t lcd_job = { 0 }, sensor_job = { 0 };
+    uint32_t wait;
+    int waiter;
+
+    lcd_job.client = &lcd;
+    lcd_job.step = hold_step;
+    sensor_job.client = &sensor;
+    sensor_job.step = one_step;
+
+    i2csched_queue_push(&queue, &lcd_job, 0);
+    CHECK(i2csched_queue_pick(&queue, 0, &wait) == &lcd_job);
+    CHECK(!i2csched_queue_account(&queue, &lcd_job, 0, 10, hold_step(&lcd_job)));
+    CHECK(lcd_job.busy);
+    // Ocupado pero sin el bus: la tarea duerme hasta que el dispositivo termina
+    CHECK(!i2csched_queue_pick(&queue, 10, &wait));
+    CHECK_EQ(wait, 2000);
+
+    // El sensor pasa durante la espera, con la prioridad de la tarea que lo espera
+    i2csched_queue_push(&queue, &sensor_job, 100);
+    sensor_job.waiter = &waiter;
+    sensor_job.waiter_priority = 3;
+    CHECK_EQ(i2csched_queue_boost(&queue), 3);
+    CHECK(i2csched_queue_pick(&queue, 100, &wait) == &sensor_job);
+    CHECK(i2csched_queue_account(&queue, &sensor_job, 100, 200, I2CSCHED_DONE));
+    CHECK(!sensor_job.busy);
+    CHECK_EQ(i2csched_queue_boost(&queue), 0);
+
+    // Pedido otra vez en curso: vuelve a empezar desde el primer paso y conserva quien espera
+    lcd_job.again = true;
+    lcd_job.waiter = &waiter;
+    lcd_job.waiter_priority = 1;
+    CHECK(i2csched_queue_pick(&queue, 2010, &wait) == &lcd_job);
+    CHECK(!i2csched_queue_account(&queue, &lcd_job, 2010, 2020, hold_step(&lcd_job)));
+    CHECK(lcd_job.busy && lcd_job.chunk == 0 && !lcd_job.again);
+    CHECK(lcd_job.waiter == &waiter);
+    CHECK_EQ(i2csched_queue_boost(&queue), 1);
+
+    CHECK_EQ(lcd.stats.jobs, 1);
+    CHECK_EQ(lcd.stats.chunks, 2);
+    CHECK_EQ(lcd.stats.misses, 1);
+    CHECK_EQ(lcd.stats.latency_max_us, 2020);
+    CHECK_EQ(sensor.stats.jobs, 1);
+    CHECK_EQ(sensor.stats.misses, 0);
+    CHECK_EQ(sensor.stats.wait_max_us, 0);
+    CHECK_EQ(sensor.stats.latency_max_us, 100);
+}
+
+int main(void) {
+    test_order();
+    test_hold();
+    test_bus();
+    return check_result("i2csched_queue");
+}
@@ -0,0 +1,47 @@
+#ifndef _INPUT_H_
+#define _INPUT_H_
+
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "deferred.h"
+#include "input_filter.h"
+
+// Cantidad maxima de entradas registradas (4 bits de notificacion por entrada)
+#define INPUT_MAX_CHANNELS      8
+
+// Indice del arreglo de notificaciones usado por el servicio
+#define INPUT_NOTIFY_INDEX      1
+
+// Nivel de trabajo diferido de los handlers de las entradas
+#define INPUT_DEFERRED_LEVEL    DEFERRED_LOW
+
+// Periodo de muestreo por defecto del filtro en microsegundos
+#define INPUT_SAMPLE_PERIOD_US  1000
+
+// Bits de notificacion de un evento de una entrada
+#define INPUT_EVENT_BITS(channel, event)    ((uint32_t)(event) << (4 * (channel)))
+
+/**
+ * @brief Configuracion de una entrada
+ */
+typedef struct {
+    uint gpio;                  // GPIO de la entrada
+    bool active_low;            // true si la entrada es activa en bajo (pull-up)
+    uint32_t debounce_ms;       // Tiempo que debe estar estable para validar un cambio
+    uint32_t long_press_ms;     // Tiempo para pulsacion larga (0 la deshabilita)
+    uint8_t events;             // Eventos INPUT_EVENT_x que se notifican
+    TaskHandle_t subscriber;    // Tarea que recibe las notificaciones
+    PendedFunction_t handler;   // Trabajo diferido que recibe los eventos (context, eventos), en lugar de subscriber
+    void *context;              // Primer argumento del handler
+} input_config_t;
+
+// Prototipos de funciones
+int input_register(const input_config_t *config);
+bool input_start(uint32_t sample_period_us);
+bool input_is_pressed(int channel);
+uint32_t input_wait(TickType_t timeout);
+
+#endif
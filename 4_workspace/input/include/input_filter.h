@@ -0,0 +1,29 @@
+#ifndef _INPUT_FILTER_H_
+#define _INPUT_FILTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Eventos que puede generar el filtro
+#define INPUT_EVENT_PRESS       0x01
+#define INPUT_EVENT_RELEASE     0x02
+#define INPUT_EVENT_LONG_PRESS  0x04
+
+/**
+ * @brief Estado del filtro integrador de una entrada
+ */
+typedef struct {
+    uint8_t integrator;     // Cuenta del integrador (0 a threshold)
+    uint8_t threshold;      // Muestras consecutivas para validar un cambio
+    bool pressed;           // Estado filtrado de la entrada
+    bool long_sent;         // Ya se notifico la pulsacion larga
+    uint16_t held;          // Muestras que lleva presionado
+    uint16_t long_samples;  // Muestras para pulsacion larga (0 deshabilita)
+} input_filter_t;
+
+// Prototipos de funciones
+void input_filter_init(input_filter_t *filter, uint8_t threshold, uint16_t long_samples);
+uint8_t input_filter_update(input_filter_t *filter, bool active);
+bool input_filter_idle(const input_filter_t *filter);
+
+#endif
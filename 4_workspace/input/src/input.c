@@ -0,0 +1,181 @@
+#include "input.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+// Flancos que despiertan al servicio
+#define INPUT_EDGES (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE)
+
+/**
+ * @brief Estado interno de cada entrada registrada
+ */
+typedef struct {
+    input_config_t config;
+    input_filter_t filter;
+} input_channel_t;
+
+// Entradas registradas
+static input_channel_t channels[INPUT_MAX_CHANNELS];
+static uint8_t channel_count = 0;
+// Mascara de entradas que estan siendo filtradas por el timer
+static volatile uint32_t active_mask = 0;
+// Periodo de muestreo del timer compartido
+static uint32_t sample_period_us = INPUT_SAMPLE_PERIOD_US;
+// Timer compartido del alarm pool y su estado
+static repeating_timer_t timer;
+static volatile bool timer_running = false;
+
+/**
+ * @brief Lee el nivel de una entrada considerando su polaridad
+ * @param channel puntero a la entrada
+ * @return true si la entrada esta en su nivel activo
+ */
+static inline bool input_read(const input_channel_t *channel) {
+    return gpio_get(channel->config.gpio) != channel->config.active_low;
+}
+
+/**
+ * @brief Callback del timer compartido, muestrea solo las entradas activas
+ * @param rt puntero al timer
+ * @return true mientras quede alguna entrada sin estabilizar
+ */
+static bool __not_in_flash_func(input_timer_callback)(repeating_timer_t *rt) {
+    uint32_t start = deferred_isr_enter();
+    BaseType_t to_higher_priority_task = pdFALSE;
+    uint32_t mask = active_mask;
+
+    for (uint8_t i = 0; i < channel_count; i++) {
+        if (!(mask & (1u << i))) { continue; }
+        input_channel_t *channel = &channels[i];
+
+        // Paso la muestra por el integrador y notifico los eventos limpios
+        uint8_t events = input_filter_update(&channel->filter, input_read(channel)) & channel->config.events;
+        if (events && channel->config.handler) {
+            // El handler corre en la tarea de trabajo diferido, fuera de la ISR
+            deferred_post_from_isr(INPUT_DEFERRED_LEVEL, channel->config.handler, channel->config.context,
+                                   events, &to_higher_priority_task);
+        } else if (events && channel->config.subscriber) {
+            xTaskNotifyIndexedFromISR(channel->config.subscriber, INPUT_NOTIFY_INDEX,
+                                      INPUT_EVENT_BITS(i, events), eSetBits, &to_higher_priority_task);
+        }
+
+        // Cuando se estabiliza, vuelve a esperar un flanco por interrupcion
+        if (input_filter_idle(&channel->filter)) {
+            gpio_acknowledge_irq(channel->config.gpio, INPUT_EDGES);
+            gpio_set_irq_enabled(channel->config.gpio, INPUT_EDGES, true);
+            // Si cambio el nivel antes de habilitar el flanco, sigo filtrando
+            if (input_read(channel) != channel->filter.pressed) {
+                gpio_set_irq_enabled(channel->config.gpio, INPUT_EDGES, false);
+            } else {
+                mask &= ~(1u << i);
+            }
+        }
+    }
+
+    // El timer se detiene solo cuando no queda ninguna entrada activa
+    active_mask = mask;
+    timer_running = mask != 0;
+    deferred_isr_exit(INPUT_DEFERRED_LEVEL, start);
+    portYIELD_FROM_ISR(to_higher_priority_task);
+    return timer_running;
+}
+
+/**
+ * @brief Arranca el timer compartido si no esta corriendo
+ */
+static void input_timer_start(void) {
+    if (!timer_running) {
+        // Periodo negativo para que sea entre inicios de callback
+        timer_running = alarm_pool_add_repeating_timer_us(alarm_pool_get_default(), -(int64_t)sample_period_us,
+                                                          input_timer_callback, NULL, &timer);
+    }
+}
+
+/**
+ * @brief Handler de interrupcion de GPIO para las entradas registradas.
+ * Atiende un unico flanco por pulsacion: deshabilita el flanco y deja
+ * el resto del trabajo al timer compartido
+ */
+static void __not_in_flash_func(input_gpio_handler)(void) {
+    for (uint8_t i = 0; i < channel_count; i++) {
+        uint gpio = channels[i].config.gpio;
+        if (gpio_get_irq_event_mask(gpio) & INPUT_EDGES) {
+            gpio_acknowledge_irq(gpio, INPUT_EDGES);
+            gpio_set_irq_enabled(gpio, INPUT_EDGES, false);
+            active_mask |= 1u << i;
+        }
+    }
+    // El handler de GPIO y el del timer tienen la misma prioridad, no se interrumpen entre si
+    input_timer_start();
+}
+
+/**
+ * @brief Registra una entrada en el servicio. Debe llamarse antes de input_start
+ * @param config puntero a la configuracion de la entrada
+ * @return numero de canal asignado o -1 si no hay lugar
+ */
+int input_register(const input_config_t *config) {
+    if (channel_count >= INPUT_MAX_CHANNELS) { return -1; }
+
+    channels[channel_count].config = *config;
+
+    // Inicializacion de GPIO con el pull que corresponda a la polaridad
+    gpio_init(config->gpio);
+    gpio_set_dir(config->gpio, GPIO_IN);
+    if (config->active_low) {
+        gpio_pull_up(config->gpio);
+    } else {
+        gpio_pull_down(config->gpio);
+    }
+
+    return channel_count++;
+}
+
+/**
+ * @brief Instala la interrupcion de las entradas registradas y arranca el filtrado
+ * @param period_us periodo de muestreo del filtro en us (0 usa INPUT_SAMPLE_PERIOD_US)
+ * @return true si se pudo reservar el timer compartido
+ */
+bool input_start(uint32_t period_us) {
+    uint32_t gpio_mask = 0;
+
+    if (period_us) { sample_period_us = period_us; }
+
+    // Paso los tiempos en ms a cantidad de muestras del timer
+    for (uint8_t i = 0; i < channel_count; i++) {
+        input_channel_t *channel = &channels[i];
+        uint32_t threshold = channel->config.debounce_ms * 1000 / sample_period_us;
+        uint32_t long_samples = channel->config.long_press_ms * 1000 / sample_period_us;
+        input_filter_init(&channel->filter, threshold > UINT8_MAX ? UINT8_MAX : threshold,
+                          long_samples > UINT16_MAX ? UINT16_MAX : long_samples);
+        gpio_mask |= 1u << channel->config.gpio;
+    }
+
+    // Un unico handler para todas las entradas, sin pisar el callback de GPIO del usuario
+    gpio_add_raw_irq_handler_masked(gpio_mask, input_gpio_handler);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
+    // Todas arrancan activas para que el filtro tome el estado inicial
+    active_mask = (1u << channel_count) - 1;
+    input_timer_start();
+    return timer_running;
+}
+
+/**
+ * @brief Devuelve el estado filtrado de una entrada
+ * @param channel numero de canal devuelto por input_register
+ * @return true si la entrada esta presionada
+ */
+bool input_is_pressed(int channel) {
+    return channels[channel].filter.pressed;
+}
+
+/**
+ * @brief Bloquea la tarea llamadora hasta recibir eventos de alguna entrada
+ * @param timeout ticks maximos de espera
+ * @return bits de eventos recibidos (ver INPUT_EVENT_BITS) o 0 si vencio el timeout
+ */
+uint32_t input_wait(TickType_t timeout) {
+    uint32_t events = 0;
+    xTaskNotifyWaitIndexed(INPUT_NOTIFY_INDEX, 0, UINT32_MAX, &events, timeout);
+    return events;
+}
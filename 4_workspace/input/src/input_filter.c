@@ -0,0 +1,68 @@
+#include "input_filter.h"
+
+/**
+ * @brief Inicializa el filtro integrador en estado liberado
+ * @param filter puntero al filtro
+ * @param threshold cantidad de muestras iguales para validar un cambio
+ * @param long_samples muestras presionado para la pulsacion larga (0 la deshabilita)
+ */
+void input_filter_init(input_filter_t *filter, uint8_t threshold, uint16_t long_samples) {
+    filter->integrator = 0;
+    // Al menos una muestra para que el filtro pueda cambiar de estado
+    filter->threshold = threshold ? threshold : 1;
+    filter->pressed = false;
+    filter->long_sent = false;
+    filter->held = 0;
+    filter->long_samples = long_samples;
+}
+
+/**
+ * @brief Procesa una muestra de la entrada
+ * @param filter puntero al filtro
+ * @param active true si la entrada esta en su nivel activo
+ * @return mascara de eventos INPUT_EVENT_x generados por esta muestra
+ */
+uint8_t input_filter_update(input_filter_t *filter, bool active) {
+    uint8_t events = 0;
+
+    // El integrador sube con la entrada activa y baja con la inactiva, saturando en los extremos
+    if (active) {
+        if (filter->integrator < filter->threshold) { filter->integrator++; }
+    } else {
+        if (filter->integrator > 0) { filter->integrator--; }
+    }
+
+    // Solo hay cambio de estado cuando el integrador llega a un extremo
+    if (!filter->pressed && filter->integrator == filter->threshold) {
+        filter->pressed = true;
+        filter->long_sent = false;
+        filter->held = 0;
+        events |= INPUT_EVENT_PRESS;
+    } else if (filter->pressed && filter->integrator == 0) {
+        filter->pressed = false;
+        events |= INPUT_EVENT_RELEASE;
+    }
+
+    // Cuento el tiempo presionado para la pulsacion larga, desde la muestra que sigue a la pulsacion
+    if (filter->pressed && !(events & INPUT_EVENT_PRESS) && filter->long_samples && !filter->long_sent) {
+        if (++filter->held >= filter->long_samples) {
+            filter->long_sent = true;
+            events |= INPUT_EVENT_LONG_PRESS;
+        }
+    }
+
+    return events;
+}
+
+/**
+ * @brief Indica si el filtro esta estable y no necesita mas muestras
+ * @param filter puntero al filtro
+ * @return true si el integrador esta en el extremo de su estado y no hay
+ * una pulsacion larga pendiente
+ */
+bool input_filter_idle(const input_filter_t *filter) {
+    if (!filter->pressed) {
+        return filter->integrator == 0;
+    }
+    return filter->integrator == filter->threshold && (!filter->long_samples || filter->long_sent);
+}
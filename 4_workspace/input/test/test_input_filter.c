@@ -0,0 +1,172 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "check.h"
+#include "input_filter.h"
+
+// 20 ms de antirrebote y 1 s de pulsacion larga con el muestreo de 1 ms por defecto
+#define THRESHOLD       20
+#define LONG_SAMPLES    1000
+
+// Generador congruencial, la secuencia de rebotes es siempre la misma
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+/**
+ * @brief Pasa varias muestras iguales por el filtro
+ * @return eventos acumulados; en first, la muestra (desde 1) del primer evento o 0
+ */
+static uint8_t feed(input_filter_t *filter, bool active, int samples, int *first) {
+    uint8_t events = 0;
+    if (first) { *first = 0; }
+    for (int i = 1; i <= samples; i++) {
+        uint8_t e = input_filter_update(filter, active);
+        if (e && first && !*first) { *first = i; }
+        events |= e;
+    }
+    return events;
+}
+
+// El cambio se valida con THRESHOLD muestras estables, ni una antes
+static void test_thresholds(void) {
+    input_filter_t filter;
+    int first;
+
+    input_filter_init(&filter, THRESHOLD, 0);
+    CHECK(input_filter_idle(&filter));
+    CHECK_EQ(feed(&filter, true, THRESHOLD - 1, NULL), 0);
+    CHECK(!input_filter_idle(&filter));
+    CHECK_EQ(input_filter_update(&filter, true), INPUT_EVENT_PRESS);
+    CHECK(filter.pressed && input_filter_idle(&filter));
+
+    // Presionado estable no genera mas eventos
+    CHECK_EQ(feed(&filter, true, 5000, NULL), 0);
+
+    CHECK_EQ(feed(&filter, false, THRESHOLD, &first), INPUT_EVENT_RELEASE);
+    CHECK_EQ(first, THRESHOLD);
+    CHECK(!filter.pressed && input_filter_idle(&filter));
+
+    // Con umbral 0 alcanza una muestra para cambiar
+    input_filter_init(&filter, 0, 0);
+    CHECK_EQ(input_filter_update(&filter, true), INPUT_EVENT_PRESS);
+    CHECK_EQ(input_filter_update(&filter, false), INPUT_EVENT_RELEASE);
+}
+
+// Pulsos mas cortos que el umbral, aislados, nunca cambian el estado
+static void test_glitches(void) {
+    input_filter_t filter;
+    uint8_t events = 0;
+
+    input_filter_init(&filter, THRESHOLD, 0);
+    for (int i = 0; i < 100; i++) {
+        events |= feed(&filter, true, THRESHOLD - 1, NULL);
+        events |= feed(&filter, false, THRESHOLD, NULL);
+    }
+    CHECK_EQ(events, 0);
+
+    feed(&filter, true, THRESHOLD, NULL);
+    for (int i = 0; i < 100; i++) {
+        events |= feed(&filter, false, THRESHOLD - 1, NULL);
+        events |= feed(&filter, true, THRESHOLD, NULL);
+    }
+    CHECK(filter.pressed);
+    CHECK_EQ(events, 0);
+}
+
+/**
+ * @brief Rebotes de un contacto: cambios al azar durante bounce muestras y despues
+ * el nivel final estable durante stable muestras
+ * @return eventos; en at, la muestra del primer evento contada desde el final de los rebotes
+ */
+static uint8_t bounce(input_filter_t *filter, bool level, int bounces, int stable, int *at) {
+    uint8_t events = 0;
+    int count = 0;
+
+    *at = 0;
+    for (int i = 0; i < bounces; i++) {
+        // Mitad de las muestras en cada nivel, con rachas de 1 a 4 muestras
+        bool active = next_random() & 1;
+        int run = 1 + next_random() % 4;
+        for (int j = 0; j < run; j++) {
+            uint8_t e = input_filter_update(filter, active);
+            events |= e;
+            if (e) { *at = -1; }
+        }
+    }
+    for (int i = 1; i <= stable; i++) {
+        uint8_t e = input_filter_update(filter, level);
+        if (e && !count++ && *at == 0) { *at = i; }
+        events |= e;
+    }
+    return events;
+}
+
+// Cada pulsacion con rebotes da un solo evento de cada tipo, a lo sumo THRESHOLD
+// muestras despues del ultimo rebote
+static void test_bounces(void) {
+    input_filter_t filter;
+    int presses = 0, releases = 0, at;
+
+    input_filter_init(&filter, THRESHOLD, 0);
+    for (int i = 0; i < 1000; i++) {
+        // Rebotes de hasta unos 10 ms, mas cortos que el antirrebote
+        uint8_t events = bounce(&filter, true, 1 + next_random() % 4, 200, &at);
+        presses += (events & INPUT_EVENT_PRESS) != 0;
+        CHECK_EQ(events, INPUT_EVENT_PRESS);
+        CHECK(at == -1 || (at >= 1 && at <= THRESHOLD));
+
+        events = bounce(&filter, false, 1 + next_random() % 4, 200, &at);
+        releases += (events & INPUT_EVENT_RELEASE) != 0;
+        CHECK_EQ(events, INPUT_EVENT_RELEASE);
+        CHECK(at == -1 || (at >= 1 && at <= THRESHOLD));
+        CHECK(input_filter_idle(&filter));
+    }
+    CHECK_EQ(presses, 1000);
+    CHECK_EQ(releases, 1000);
+}
+
+// La pulsacion larga llega LONG_SAMPLES muestras despues de validar la pulsacion, una sola vez
+static void test_long_press(void) {
+    input_filter_t filter;
+    int first;
+
+    input_filter_init(&filter, THRESHOLD, LONG_SAMPLES);
+    feed(&filter, true, THRESHOLD, NULL);
+    CHECK(filter.pressed);
+    CHECK(!input_filter_idle(&filter));                 // Espera la pulsacion larga
+
+    CHECK_EQ(feed(&filter, true, LONG_SAMPLES, &first), INPUT_EVENT_LONG_PRESS);
+    CHECK_EQ(first, LONG_SAMPLES);
+    CHECK(input_filter_idle(&filter));
+    CHECK_EQ(feed(&filter, true, 3 * LONG_SAMPLES, NULL), 0);
+    CHECK_EQ(feed(&filter, false, THRESHOLD, NULL), INPUT_EVENT_RELEASE);
+
+    // Una pulsacion mas corta no la genera, y la siguiente cuenta desde cero. El estado
+    // filtrado sigue presionado mientras se valida la liberacion, esas muestras tambien cuentan
+    feed(&filter, true, THRESHOLD, NULL);
+    CHECK_EQ(feed(&filter, true, LONG_SAMPLES - THRESHOLD, NULL), 0);
+    CHECK_EQ(feed(&filter, false, THRESHOLD, NULL), INPUT_EVENT_RELEASE);
+    feed(&filter, true, THRESHOLD, NULL);
+    CHECK_EQ(feed(&filter, true, LONG_SAMPLES, &first), INPUT_EVENT_LONG_PRESS);
+    CHECK_EQ(first, LONG_SAMPLES);
+
+    // Los rebotes de la liberacion no cortan el tiempo mientras no llegan al umbral
+    input_filter_init(&filter, THRESHOLD, LONG_SAMPLES);
+    feed(&filter, true, THRESHOLD, NULL);
+    feed(&filter, true, LONG_SAMPLES / 2, NULL);
+    feed(&filter, false, THRESHOLD - 1, NULL);
+    CHECK_EQ(feed(&filter, true, LONG_SAMPLES / 2 - THRESHOLD + 1, &first), INPUT_EVENT_LONG_PRESS);
+    CHECK_EQ(first, LONG_SAMPLES / 2 - THRESHOLD + 1);
+}
+
+int main(void) {
+    test_thresholds();
+    test_glitches();
+    test_bounces();
+    test_long_press();
+    return check_result("input_filter");
+}
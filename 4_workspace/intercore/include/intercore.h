@@ -0,0 +1,63 @@
+#ifndef _INTERCORE_H_
+#define _INTERCORE_H_
+
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc.h"
+
+// Palabra que se escribe en el FIFO. El valor no se usa, solo despierta al otro nucleo
+#define INTERCORE_DOORBELL      0x1C0DE
+
+/**
+ * @brief Canal entre core0, con FreeRTOS, y core1, sin sistema operativo. Las
+ * consignas van de core0 a core1 y la telemetria de core1 a core0, cada una en
+ * su ring. El FIFO del SIO solo avisa que un ring dejo de estar vacio
+ */
+typedef struct {
+    spsc_t setpoints;           // De core0 a core1, lo escribe una sola tarea
+    spsc_t telemetry;           // De core1 a core0, lo lee una sola tarea
+    void (*handler)(void *);    // Se llama en core1 cuando llegan consignas, o NULL
+    void *context;              // Argumento del handler
+    // Contadores, cada nucleo escribe solo los de su indice
+    uint32_t doorbells[2];      // Avisos enviados
+    uint32_t fifo_full[2];      // Avisos no enviados, el otro nucleo ya tenia avisos pendientes
+    uint32_t received[2];       // Interrupciones del FIFO atendidas
+    uint32_t dropped[2];        // Elementos descartados con el ring lleno
+} intercore_t;
+
+/**
+ * @brief Saca consignas, solo desde core1. Se puede llamar en cada periodo
+ * del lazo de control, sin esperar el aviso
+ * @param ic puntero al canal
+ * @param dst arreglo donde se copian
+ * @param count cantidad maxima de consignas
+ * @return consignas copiadas
+ */
+static inline uint32_t intercore_setpoint_pop(intercore_t *ic, void *dst, uint32_t count) {
+    return spsc_pop(&ic->setpoints, dst, count);
+}
+
+/**
+ * @brief Saca telemetria, solo desde la tarea consumidora en core0. Si no hay,
+ * bloquea la tarea hasta el aviso de core1 o el timeout
+ * @param ic puntero al canal
+ * @param dst arreglo donde se copian
+ * @param count cantidad maxima de elementos
+ * @param timeout ticks de espera maxima
+ * @return elementos copiados, 0 si paso el timeout
+ */
+static inline uint32_t intercore_telemetry_wait(intercore_t *ic, void *dst, uint32_t count, TickType_t timeout) {
+    return spsc_pop_wait(&ic->telemetry, dst, count, timeout);
+}
+
+// Prototipos de funciones
+bool intercore_init(intercore_t *ic, void *setpoint_buf, size_t setpoint_size, uint32_t setpoint_capacity,
+                    void *telemetry_buf, size_t telemetry_size, uint32_t telemetry_capacity);
+void intercore_start(intercore_t *ic, void (*core1_entry)(void), TaskHandle_t consumer);
+void intercore_core1_init(intercore_t *ic, void (*handler)(void *), void *context);
+uint32_t intercore_setpoint_push(intercore_t *ic, const void *src, uint32_t count);
+uint32_t intercore_telemetry_push(intercore_t *ic, const void *src, uint32_t count);
+
+#endif
@@ -0,0 +1,167 @@
+#include <string.h>
+#include "pico/multicore.h"
+#include "hardware/irq.h"
+#include "intercore.h"
+
+// En el RP2040 el port de FreeRTOS usa la interrupcion del FIFO para avisar
+// entre nucleos (prvFIFOInterruptHandler) y la instala como exclusiva al arrancar
+// el scheduler, despues de intercore_start: falla el assert del SDK o el port se
+// queda con los timbres. En el RP2350 el port usa los doorbells y el FIFO queda libre
+#if PICO_RP2040 && ((LIB_PICO_MULTICORE && configSUPPORT_PICO_SYNC_INTEROP) || configNUMBER_OF_CORES > 1)
+#error "intercore en RP2040 necesita configSUPPORT_PICO_SYNC_INTEROP 0 y un solo nucleo en FreeRTOS"
+#endif
+
+// Canal que atienden las interrupciones, el FIFO es uno solo
+static intercore_t *channel;
+
+/**
+ * @brief Avisa al otro nucleo si el ring estaba vacio antes del push. Nunca
+ * espera: con el FIFO lleno el otro nucleo ya tiene avisos sin atender
+ * @param ic puntero al canal
+ * @param r ring donde se agrego
+ * @param head indice del productor antes del push
+ */
+static void __not_in_flash_func(intercore_doorbell)(intercore_t *ic, spsc_t *r, uint32_t head) {
+    uint core = get_core_num();
+
+    // Barrera completa, pareja de la de spsc_pop (ver spsc_push_from_isr)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&r->tail, __ATOMIC_RELAXED) != head) { return; }
+
+    if (multicore_fifo_wready()) {
+        sio_hw->fifo_wr = INTERCORE_DOORBELL;
+        __sev();
+        ic->doorbells[core]++;
+    } else {
+        ic->fifo_full[core]++;
+    }
+}
+
+/**
+ * @brief Agrega elementos a un ring y avisa al otro nucleo
+ * @param ic puntero al canal
+ * @param r ring del sentido que corresponde al nucleo
+ * @param src elementos a agregar
+ * @param count cantidad de elementos
+ * @return elementos agregados
+ */
+static uint32_t __not_in_flash_func(intercore_push)(intercore_t *ic, spsc_t *r, const void *src, uint32_t count) {
+    uint32_t head = r->head;
+    uint32_t pushed = spsc_push(r, src, count);
+
+    ic->dropped[get_core_num()] += count - pushed;
+    if (pushed) { intercore_doorbell(ic, r, head); }
+    return pushed;
+}
+
+/**
+ * @brief Interrupcion del FIFO. En el RP2350 los dos nucleos tienen el mismo
+ * numero de interrupcion y comparten la tabla de vectores, asi que un solo
+ * handler atiende a los dos. En core0 despierta a la tarea consumidora y en
+ * core1 llama al handler de consignas
+ */
+static void __not_in_flash_func(intercore_irq)(void) {
+    uint core = get_core_num();
+
+    // Vaciar el FIFO baja la interrupcion, los avisos no llevan datos
+    multicore_fifo_drain();
+    multicore_fifo_clear_irq();
+    channel->received[core]++;
+
+    if (core) {
+        if (channel->handler) { channel->handler(channel->context); }
+    } else if (channel->telemetry.consumer) {
+        // Variable para verificar la necesidad de un cambio tarea
+        BaseType_t to_higher_priority_task = pdFALSE;
+        vTaskNotifyGiveIndexedFromISR(channel->telemetry.consumer, SPSC_NOTIFY_INDEX, &to_higher_priority_task);
+        // Reviso si es necesario el cambio a otra tarea
+        portYIELD_FROM_ISR(to_higher_priority_task);
+    }
+}
+
+/**
+ * @brief Habilita la interrupcion del FIFO en el nucleo que llama. Si el otro
+ * nucleo ya agrego algo, el ring no esta vacio y no va a volver a avisar
+ */
+static void intercore_enable_irq(void) {
+    uint irq = SIO_FIFO_IRQ_NUM(get_core_num());
+
+    multicore_fifo_drain();
+    multicore_fifo_clear_irq();
+    irq_set_exclusive_handler(irq, intercore_irq);
+    irq_set_enabled(irq, true);
+    // Un aviso que llego antes de instalar el handler se perdio con el drain,
+    // se atiende una vez por las dudas
+    irq_set_pending(irq);
+}
+
+/**
+ * @brief Inicializa el canal con los dos rings vacios
+ * @param ic puntero al canal
+ * @param setpoint_buf buffer de las consignas (ver SPSC_BUFFER)
+ * @param setpoint_size bytes por consigna
+ * @param setpoint_capacity cantidad de consignas, potencia de dos
+ * @param telemetry_buf buffer de la telemetria
+ * @param telemetry_size bytes por elemento de telemetria
+ * @param telemetry_capacity cantidad de elementos, potencia de dos
+ * @return false si alguna capacidad no es potencia de dos
+ */
+bool intercore_init(intercore_t *ic, void *setpoint_buf, size_t setpoint_size, uint32_t setpoint_capacity,
+                    void *telemetry_buf, size_t telemetry_size, uint32_t telemetry_capacity) {
+    memset(ic, 0, sizeof(*ic));
+    return spsc_init(&ic->setpoints, setpoint_buf, setpoint_size, setpoint_capacity) &&
+           spsc_init(&ic->telemetry, telemetry_buf, telemetry_size, telemetry_capacity);
+}
+
+/**
+ * @brief Arranca core1 y habilita los avisos en core0. Se llama desde core0,
+ * antes de vTaskStartScheduler
+ * @param ic puntero al canal
+ * @param core1_entry programa de core1, tiene que llamar a intercore_core1_init
+ * @param consumer tarea de core0 que lee la telemetria
+ */
+void intercore_start(intercore_t *ic, void (*core1_entry)(void), TaskHandle_t consumer) {
+    channel = ic;
+    spsc_set_consumer(&ic->telemetry, consumer);
+
+    // El arranque de core1 usa el FIFO, la interrupcion se instala despues
+    multicore_launch_core1(core1_entry);
+    intercore_enable_irq();
+}
+
+/**
+ * @brief Habilita los avisos en core1. Se llama al principio del programa de core1
+ * @param ic puntero al canal
+ * @param handler funcion que se llama cuando llegan consignas, o NULL si el
+ * lazo de control las lee en cada periodo
+ * @param context argumento del handler
+ */
+void intercore_core1_init(intercore_t *ic, void (*handler)(void *), void *context) {
+    ic->handler = handler;
+    ic->context = context;
+    intercore_enable_irq();
+}
+
+/**
+ * @brief Agrega consignas, solo desde una tarea de core0. Si no entran todas,
+ * agrega las que entran
+ * @param ic puntero al canal
+ * @param src consignas a agregar
+ * @param count cantidad de consignas
+ * @return consignas agregadas
+ */
+uint32_t intercore_setpoint_push(intercore_t *ic, const void *src, uint32_t count) {
+    return intercore_push(ic, &ic->setpoints, src, count);
+}
+
+/**
+ * @brief Agrega telemetria, solo desde core1 (lazo de control o su ISR). Si no
+ * entra toda, agrega la que entra
+ * @param ic puntero al canal
+ * @param src elementos a agregar
+ * @param count cantidad de elementos
+ * @return elementos agregados
+ */
+uint32_t __not_in_flash_func(intercore_telemetry_push)(intercore_t *ic, const void *src, uint32_t count) {
+    return intercore_push(ic, &ic->telemetry, src, count);
+}
@@ -0,0 +1,14 @@
+#ifndef _HARDWARE_IRQ_H
+#define _HARDWARE_IRQ_H
+
+// Interrupciones del modelo de dos nucleos (ver pico/multicore.h). Cada nucleo
+// tiene su propio estado, como el NVIC de cada core
+#include "pico/stdlib.h"
+
+typedef void (*irq_handler_t)(void);
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+void irq_set_pending(uint num);
+
+#endif
@@ -0,0 +1,268 @@
+// pthread y clock_gettime con -std=c11
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#include "pico/multicore.h"
+#include "hardware/irq.h"
+
+// Tareas de core0 que puede crear una prueba
+#define HOST_MAX_TASKS      4
+
+/**
+ * @brief Estado de un nucleo. La interrupcion del FIFO es de nivel: esta
+ * activa mientras el FIFO de entrada tenga palabras, o si se la pendio a mano
+ */
+typedef struct {
+    uint32_t fifo_count;        // Palabras en el FIFO de entrada, los avisos no llevan datos
+    irq_handler_t handler;
+    bool enabled;
+    bool pending;
+} host_core_t;
+
+/**
+ * @brief Una tarea de core0 en su propio hilo. Todas comparten el nucleo 0
+ */
+struct host_task {
+    TaskFunction_t code;
+    void *params;
+    const char *name;
+    UBaseType_t priority;
+    uint32_t notify[configTASK_NOTIFICATION_ARRAY_ENTRIES];
+    pthread_t thread;
+};
+
+_Thread_local uint host_core = 0;
+sio_hw_t host_sio[2];
+// Con true irq_set_pending no hace nada, para ver que aviso se pierde sin el
+bool host_ignore_pend = false;
+
+// Un solo lock para todo el modelo, y una condicion que se avisa en cada cambio
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t changed = PTHREAD_COND_INITIALIZER;
+
+static host_core_t cores[2];
+static bool stopping;
+static uint32_t overflows;
+// [0] atiende las interrupciones de core0, [1] es core1
+static pthread_t core_threads[2];
+static bool core1_launched;
+static void (*core1_entry)(void);
+
+static struct host_task tasks[HOST_MAX_TASKS];
+static size_t task_count;
+static _Thread_local struct host_task *current;
+
+bool multicore_fifo_wready(void) {
+    pthread_mutex_lock(&lock);
+    bool ready = cores[!host_core].fifo_count < HOST_FIFO_DEPTH;
+    pthread_mutex_unlock(&lock);
+    return ready;
+}
+
+void multicore_fifo_drain(void) {
+    pthread_mutex_lock(&lock);
+    cores[host_core].fifo_count = 0;
+    pthread_mutex_unlock(&lock);
+}
+
+// Solo borra los errores de lectura y escritura, que el modelo no tiene
+void multicore_fifo_clear_irq(void) {
+}
+
+/**
+ * @brief Entrega la palabra escrita en fifo_wr al FIFO del otro nucleo
+ */
+void __sev(void) {
+    pthread_mutex_lock(&lock);
+    if (cores[!host_core].fifo_count < HOST_FIFO_DEPTH) {
+        cores[!host_core].fifo_count++;
+    } else {
+        // Se escribio sin mirar multicore_fifo_wready
+        overflows++;
+    }
+    pthread_cond_broadcast(&changed);
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * @brief Espera una interrupcion del nucleo que llama y la atiende con el lock
+ * liberado, como un handler que interrumpe al lazo. Vuelve sin atender nada
+ * cuando la prueba detiene el modelo
+ */
+void __wfi(void) {
+    host_core_t *core = &cores[host_core];
+
+    pthread_mutex_lock(&lock);
+    while (!stopping && !(core->enabled && (core->pending || core->fifo_count))) {
+        pthread_cond_wait(&changed, &lock);
+    }
+    irq_handler_t handler = stopping ? NULL : core->handler;
+    core->pending = false;
+    pthread_mutex_unlock(&lock);
+    if (handler) { handler(); }
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    (void)num;
+    pthread_mutex_lock(&lock);
+    cores[host_core].handler = handler;
+    pthread_mutex_unlock(&lock);
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    (void)num;
+    pthread_mutex_lock(&lock);
+    cores[host_core].enabled = enabled;
+    pthread_cond_broadcast(&changed);
+    pthread_mutex_unlock(&lock);
+}
+
+void irq_set_pending(uint num) {
+    (void)num;
+    pthread_mutex_lock(&lock);
+    if (!host_ignore_pend) { cores[host_core].pending = true; }
+    pthread_cond_broadcast(&changed);
+    pthread_mutex_unlock(&lock);
+}
+
+static void *core0_irq_thread(void *arg) {
+    (void)arg;
+    host_core = 0;
+    while (host_multicore_running()) { __wfi(); }
+    return NULL;
+}
+
+static void *core1_thread(void *arg) {
+    (void)arg;
+    host_core = 1;
+    core1_entry();
+    return NULL;
+}
+
+/**
+ * @brief Arranca core1 en su hilo. El programa tiene que volver cuando
+ * host_multicore_running devuelve false
+ */
+void multicore_launch_core1(void (*entry)(void)) {
+    core1_entry = entry;
+    core1_launched = true;
+    pthread_create(&core_threads[1], NULL, core1_thread, NULL);
+}
+
+/**
+ * @brief Vacia los FIFO, borra las interrupciones y las tareas, y arranca el
+ * hilo que atiende las interrupciones de core0
+ */
+void host_multicore_reset(void) {
+    memset(cores, 0, sizeof(cores));
+    memset(host_sio, 0, sizeof(host_sio));
+    stopping = false;
+    overflows = 0;
+    core1_launched = false;
+    host_ignore_pend = false;
+    task_count = 0;
+    pthread_create(&core_threads[0], NULL, core0_irq_thread, NULL);
+}
+
+/**
+ * @brief Detiene core1 y las interrupciones de core0 y espera a que terminen
+ */
+void host_multicore_stop(void) {
+    pthread_mutex_lock(&lock);
+    stopping = true;
+    pthread_cond_broadcast(&changed);
+    pthread_mutex_unlock(&lock);
+    pthread_join(core_threads[0], NULL);
+    if (core1_launched) { pthread_join(core_threads[1], NULL); }
+}
+
+bool host_multicore_running(void) {
+    pthread_mutex_lock(&lock);
+    bool running = !stopping;
+    pthread_mutex_unlock(&lock);
+    return running;
+}
+
+/**
+ * @brief Palabras escritas con el FIFO lleno, tiene que dar cero
+ */
+uint32_t host_fifo_overflows(void) {
+    pthread_mutex_lock(&lock);
+    uint32_t count = overflows;
+    pthread_mutex_unlock(&lock);
+    return count;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint32_t stack, void *params, UBaseType_t priority,
+                       TaskHandle_t *handle) {
+    (void)stack;
+    if (task_count == HOST_MAX_TASKS) { return pdFAIL; }
+    struct host_task *task = &tasks[task_count++];
+    memset(task, 0, sizeof(*task));
+    task->code = code;
+    task->params = params;
+    task->name = name;
+    task->priority = priority;
+    if (handle) { *handle = task; }
+    return pdPASS;
+}
+
+static void *task_thread(void *arg) {
+    current = arg;
+    host_core = 0;
+    current->code(current->params);
+    return NULL;
+}
+
+/**
+ * @brief Corre una tarea en su hilo, la funcion tiene que terminar sola
+ */
+void host_task_start(TaskHandle_t task) {
+    pthread_create(&task->thread, NULL, task_thread, task);
+}
+
+void host_task_join(TaskHandle_t task) {
+    pthread_join(task->thread, NULL);
+}
+
+/**
+ * @brief Toma una notificacion, bloqueando el hilo de la tarea hasta que
+ * llegue o pase el timeout en milisegundos
+ */
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear, TickType_t timeout) {
+    struct timespec deadline;
+    uint32_t *notify = &current->notify[index];
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout / configTICK_RATE_HZ;
+    deadline.tv_nsec += (long)(timeout % configTICK_RATE_HZ) * (1000000000 / configTICK_RATE_HZ);
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&lock);
+    while (!*notify && timeout) {
+        if (timeout == portMAX_DELAY) {
+            pthread_cond_wait(&changed, &lock);
+        } else if (pthread_cond_timedwait(&changed, &lock, &deadline)) {
+            break;
+        }
+    }
+    uint32_t value = *notify;
+    if (value) { *notify = clear ? 0 : value - 1; }
+    pthread_mutex_unlock(&lock);
+    return value;
+}
+
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t *to_higher_priority_task) {
+    pthread_mutex_lock(&lock);
+    task->notify[index]++;
+    pthread_cond_broadcast(&changed);
+    pthread_mutex_unlock(&lock);
+    // Las interrupciones de core0 no corren en el hilo de ninguna tarea
+    if (to_higher_priority_task) { *to_higher_priority_task = pdTRUE; }
+}
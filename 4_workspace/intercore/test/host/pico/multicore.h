@@ -0,0 +1,50 @@
+#ifndef _PICO_MULTICORE_H
+#define _PICO_MULTICORE_H
+
+// Modelo de los dos nucleos del RP2350 con hilos, no es el SDK. Cada nucleo es
+// un hilo y cada uno tiene su FIFO de entrada y su interrupcion del FIFO
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Palabras que entran en cada FIFO del SIO del RP2350
+#define HOST_FIFO_DEPTH         4
+
+// SIO_IRQ_FIFO: en el RP2350 es el mismo numero en los dos nucleos
+#define SIO_FIFO_IRQ_NUM(core)  25
+
+// Nucleo del hilo que llama
+extern _Thread_local uint host_core;
+
+static inline uint get_core_num(void) { return host_core; }
+
+/**
+ * @brief Registro de escritura del FIFO, uno por nucleo. En el modelo la palabra
+ * se entrega con __sev, que intercore llama siempre despues de escribirla
+ */
+typedef struct {
+    uint32_t fifo_wr;
+} sio_hw_t;
+
+extern sio_hw_t host_sio[2];
+
+#define sio_hw                  (&host_sio[get_core_num()])
+
+bool multicore_fifo_wready(void);
+void multicore_fifo_drain(void);
+void multicore_fifo_clear_irq(void);
+void multicore_launch_core1(void (*entry)(void));
+void __sev(void);
+void __wfi(void);
+
+// Control del modelo desde la prueba
+extern bool host_ignore_pend;
+
+void host_multicore_reset(void);
+void host_multicore_stop(void);
+bool host_multicore_running(void);
+uint32_t host_fifo_overflows(void);
+void host_task_start(TaskHandle_t task);
+void host_task_join(TaskHandle_t task);
+
+#endif
@@ -0,0 +1,206 @@
+// sched_yield con -std=c11
+#define _POSIX_C_SOURCE 200809L
+
+#include <sched.h>
+#include <stdio.h>
+
+#include "check.h"
+#include "intercore.h"
+#include "pico/multicore.h"
+
+// Consignas que van y vuelven en la prueba de carga
+#define ROUND_TRIPS     200000u
+// Rafagas de hasta BATCH_MAX consignas
+#define BATCH_MAX       7
+// core1 responde cada consigna con 1 a 3 elementos de telemetria, en una sola rafaga
+#define PARTS(seq)      (1 + (seq) % 3)
+// Consignas sin respuesta: entran en los dos rings, asi nada se descarta
+#define WINDOW          16
+
+typedef struct {
+    uint32_t seq;
+} setpoint_t;
+
+typedef struct {
+    uint32_t seq;
+    uint32_t part;
+} sample_t;
+
+static SPSC_BUFFER(setpoint_buf, setpoint_t, 4);
+static SPSC_BUFFER(telemetry_buf, sample_t, 6);
+static intercore_t ic;
+static TaskHandle_t host, consumer;
+
+// Consignas con toda su respuesta recibida, lo escribe la tarea consumidora
+static uint32_t acked;
+// Resultados de la tarea consumidora, se leen despues del join
+static uint32_t bad_samples;
+static uint32_t stalls;
+static uint32_t received;
+// Habilita a core1 en la prueba del arranque
+static bool go;
+
+// Generador congruencial, las rafagas son siempre las mismas
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 16;
+}
+
+/**
+ * @brief Handler de consignas en core1: vacia el ring y responde cada consigna
+ */
+static void on_setpoint(void *context) {
+    setpoint_t batch[4];
+    uint32_t count;
+    (void)context;
+
+    while ((count = intercore_setpoint_pop(&ic, batch, 4))) {
+        for (uint32_t i = 0; i < count; i++) {
+            sample_t reply[3];
+            for (uint32_t part = 0; part < PARTS(batch[i].seq); part++) { reply[part] = (sample_t){ batch[i].seq, part }; }
+            intercore_telemetry_push(&ic, reply, PARTS(batch[i].seq));
+        }
+    }
+}
+
+// Programa de core1: atiende interrupciones hasta que la prueba detiene el modelo
+static void core1_main(void) {
+    intercore_core1_init(&ic, on_setpoint, NULL);
+    while (host_multicore_running()) { __wfi(); }
+}
+
+// Programa de core1 que habilita sus avisos despues de que core0 ya agrego consignas
+static void core1_late(void) {
+    while (!__atomic_load_n(&go, __ATOMIC_ACQUIRE)) { sched_yield(); }
+    core1_main();
+}
+
+// Tarea de core0 que manda las consignas en rafagas, sin pasarse de la ventana
+static void task_host(void *params) {
+    uint32_t seed = 12345, seq = 0;
+    setpoint_t batch[BATCH_MAX];
+    (void)params;
+
+    while (seq < ROUND_TRIPS) {
+        uint32_t count = 1 + next_random(&seed) % BATCH_MAX;
+        if (count > ROUND_TRIPS - seq) { count = ROUND_TRIPS - seq; }
+        while (seq + count - __atomic_load_n(&acked, __ATOMIC_ACQUIRE) > WINDOW) {
+            // La consumidora se rindio, las respuestas ya no van a llegar
+            if (__atomic_load_n(&stalls, __ATOMIC_ACQUIRE)) { return; }
+            sched_yield();
+        }
+
+        for (uint32_t i = 0; i < count; i++) { batch[i].seq = seq + i; }
+        seq += intercore_setpoint_push(&ic, batch, count);
+    }
+}
+
+// Tarea de core0 que lee la telemetria y verifica el orden
+static void task_telemetry(void *params) {
+    sample_t batch[8];
+    uint32_t seq = 0, part = 0;
+    (void)params;
+
+    while (seq < ROUND_TRIPS) {
+        uint32_t count = intercore_telemetry_wait(&ic, batch, 8, pdMS_TO_TICKS(2000));
+        // En la placa la tarea quedaria bloqueada para siempre con datos en el ring
+        if (!count) {
+            __atomic_store_n(&stalls, 1, __ATOMIC_RELEASE);
+            break;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            if (batch[i].seq != seq || batch[i].part != part) {
+                bad_samples++;
+                seq = batch[i].seq;
+                part = batch[i].part;
+            }
+            if (++part == PARTS(seq)) {
+                part = 0;
+                __atomic_store_n(&acked, ++seq, __ATOMIC_RELEASE);
+            }
+        }
+        received += count;
+    }
+}
+
+// Tarea de core0 que espera una sola respuesta
+static void task_wait_one(void *params) {
+    sample_t sample;
+    (void)params;
+
+    received = intercore_telemetry_wait(&ic, &sample, 1, pdMS_TO_TICKS(200));
+}
+
+/**
+ * @brief Arma el canal y las tareas de core0 y arranca core1
+ */
+static void setup(TaskFunction_t consumer_code, void (*core1_entry)(void)) {
+    host_multicore_reset();
+    acked = bad_samples = stalls = received = 0;
+    go = false;
+    CHECK(intercore_init(&ic, setpoint_buf, sizeof(setpoint_t), 16, telemetry_buf, sizeof(sample_t), 64));
+    xTaskCreate(task_host, "Host", 256, NULL, 2, &host);
+    xTaskCreate(consumer_code, "Telemetry", 256, NULL, 3, &consumer);
+    intercore_start(&ic, core1_entry, consumer);
+}
+
+// Muchas idas y vueltas en rafagas: orden, sin perdidas y sin despertares perdidos
+static void test_round_trips(void) {
+    setup(task_telemetry, core1_main);
+    host_task_start(consumer);
+    host_task_start(host);
+    host_task_join(host);
+    host_task_join(consumer);
+    host_multicore_stop();
+
+    printf("ida y vuelta: %u consignas, %u de telemetria, %u fuera de orden, %u bloqueos\n",
+           acked, received, bad_samples, stalls);
+    printf("avisos core0 -> core1: %u enviados, %u con el FIFO lleno, %u atendidos\n",
+           ic.doorbells[0], ic.fifo_full[0], ic.received[1]);
+    printf("avisos core1 -> core0: %u enviados, %u con el FIFO lleno, %u atendidos\n",
+           ic.doorbells[1], ic.fifo_full[1], ic.received[0]);
+    CHECK_EQ(acked, ROUND_TRIPS);
+    CHECK_EQ(bad_samples, 0);
+    CHECK_EQ(stalls, 0);
+    CHECK_EQ(ic.dropped[0] + ic.dropped[1], 0);
+    CHECK_EQ(spsc_count(&ic.setpoints) + spsc_count(&ic.telemetry), 0);
+    CHECK_EQ(host_fifo_overflows(), 0);
+    // Cada interrupcion vacia todo el FIFO, mas la pendida en el arranque
+    CHECK(ic.received[1] >= 1 && ic.received[1] <= ic.doorbells[0] + 1);
+    CHECK(ic.received[0] >= 1 && ic.received[0] <= ic.doorbells[1] + 1);
+}
+
+/**
+ * @brief Una consigna agregada antes de que core1 habilite sus avisos: el drain
+ * de core1 borra el aviso y el ring ya no esta vacio, asi que no vuelve a avisar
+ * @param pend false para ver que se pierde sin el irq_set_pending del arranque
+ */
+static void test_startup(bool pend) {
+    setpoint_t setpoint = { 0 };
+
+    setup(task_wait_one, core1_late);
+    host_ignore_pend = !pend;
+    CHECK_EQ(intercore_setpoint_push(&ic, &setpoint, 1), 1);
+    CHECK_EQ(ic.doorbells[0], 1);
+    __atomic_store_n(&go, true, __ATOMIC_RELEASE);
+
+    host_task_start(consumer);
+    host_task_join(consumer);
+    host_multicore_stop();
+
+    if (pend) {
+        CHECK_EQ(received, 1);
+        CHECK_EQ(spsc_count(&ic.setpoints), 0);
+    } else {
+        CHECK_EQ(received, 0);
+        CHECK_EQ(ic.received[1], 0);
+        CHECK_EQ(spsc_count(&ic.setpoints), 1);
+    }
+}
+
+int main(void) {
+    test_startup(true);
+    test_startup(false);
+    test_round_trips();
+    return check_result("intercore");
+}
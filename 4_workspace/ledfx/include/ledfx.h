@@ -0,0 +1,21 @@
+#ifndef _LEDFX_H_
+#define _LEDFX_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pico/stdlib.h"
+
+#include "ledfx_wave.h"
+
+// Prototipos de funciones
+bool ledfx_init(ledfx_t *fx, uint pin, uint32_t top);
+void ledfx_set_top(ledfx_t *fx, uint32_t top);
+void ledfx_set(ledfx_t *fx, uint8_t level);
+void ledfx_fade_to(ledfx_t *fx, uint8_t level, uint32_t ms);
+void ledfx_breathe(ledfx_t *fx, uint8_t low, uint8_t high, uint32_t period_ms);
+void ledfx_blink(ledfx_t *fx, uint8_t level, uint32_t on_ms, uint32_t off_ms);
+void ledfx_stop(ledfx_t *fx);
+uint8_t ledfx_level(const ledfx_t *fx);
+
+#endif
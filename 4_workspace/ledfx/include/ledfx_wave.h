@@ -0,0 +1,65 @@
+#ifndef _LEDFX_WAVE_H_
+#define _LEDFX_WAVE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Niveles de brillo percibido, 0 apagado y LEDFX_LEVEL_MAX el maximo
+#define LEDFX_LEVELS            256
+#define LEDFX_LEVEL_MAX         (LEDFX_LEVELS - 1)
+// Mayor tope del contador del PWM: el nivel maximo carga tope + 1 en el comparador
+#define LEDFX_TOP_MAX           65534
+// Escalones de cada rampa, cada uno es un bloque de la lista
+#define LEDFX_STEPS             64
+// Dos rampas y el bloque que vuelve al principio o termina la lista
+#define LEDFX_BLOCKS            (2 * LEDFX_STEPS + 1)
+// Mayor cantidad de periodos de un bloque, el contador de transferencias del RP2350 tiene 28 bits
+#define LEDFX_COUNT_MAX         0x0FFFFFFFu
+
+/**
+ * @brief Bloque de control: los cuatro registros del canal de datos en el
+ * orden del alias 0. El ultimo escribe CTRL_TRIG y arranca el canal
+ */
+typedef struct {
+    const volatile void *read;
+    volatile void *write;
+    uint32_t count;
+    uint32_t ctrl;
+} ledfx_block_t;
+
+/**
+ * @brief Salida de un LED por PWM. El canal de datos escribe un nivel en el
+ * comparador en cada vuelta del contador, y el canal de control le carga el
+ * siguiente bloque de la lista al terminar
+ */
+typedef struct {
+    uint32_t slice;                     // Porcion del PWM del pin, el LED la usa entera
+    uint32_t data_chan;                 // Canal DMA que escribe el comparador
+    uint32_t ctrl_chan;                 // Canal DMA que carga los bloques
+    uint32_t top;                       // Tope del contador del PWM
+    uint32_t sys_hz;                    // Reloj del PWM, sin divisor
+    volatile void *cc;                  // Comparador de la porcion
+    volatile void *restart;             // READ_ADDR del canal de control
+    uint32_t level_ctrl;                // CTRL de los bloques de nivel
+    uint32_t restart_ctrl;              // CTRL del bloque que vuelve al principio
+    const ledfx_block_t *list;          // Principio de la lista, lo copia el bloque de vuelta
+    uint32_t len;                       // Bloques en la lista
+    uint16_t level[LEDFX_LEVELS];       // Tabla gamma escalada al tope, en RAM
+    ledfx_block_t blocks[LEDFX_BLOCKS];
+} ledfx_t;
+
+// Tabla gamma en Q16, la genera ledfx_gamma.py
+extern const uint16_t ledfx_gamma[LEDFX_LEVELS];
+
+// Armado de la lista de bloques, sin acceso al hardware
+void ledfx_scale(ledfx_t *fx, uint32_t top);
+uint32_t ledfx_periods(const ledfx_t *fx, uint32_t ms);
+uint8_t ledfx_index(const ledfx_t *fx, uint32_t duty);
+void ledfx_wave_begin(ledfx_t *fx);
+void ledfx_wave_hold(ledfx_t *fx, uint8_t level, uint32_t periods);
+void ledfx_wave_ramp(ledfx_t *fx, uint8_t from, uint8_t to, uint32_t periods);
+void ledfx_wave_restart(ledfx_t *fx);
+void ledfx_wave_end(ledfx_t *fx);
+
+#endif
@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+"""Genera la tabla de correccion gamma de los niveles de brillo del LED.
+
+Uso:
+    ledfx_gamma.py src/ledfx_gamma.c
+    ledfx_gamma.py src/ledfx_gamma.c --gamma 2.8
+"""
+
+import argparse
+import sys
+
+LEVELS = 256
+FULL = 65535
+
+
+def duty(level, gamma):
+    """Ciclo de actividad del nivel en Q16, 65535 es el LED siempre encendido."""
+    return int((level / (LEVELS - 1)) ** gamma * FULL + 0.5)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("output", help="archivo C a generar")
+    parser.add_argument("--gamma", type=float, default=2.2, help="exponente de la curva de brillo percibido")
+    args = parser.parse_args()
+
+    values = [duty(level, args.gamma) for level in range(LEVELS)]
+    lines = []
+    for start in range(0, LEVELS, 8):
+        lines.append("    " + ", ".join("%5d" % v for v in values[start:start + 8]) + ",")
+
+    with open(args.output, "w") as out:
+        out.write("// Generado por ledfx_gamma.py, no editar\n")
+        out.write("// duty = (nivel / %d) ^ %g, en Q16\n\n" % (LEVELS - 1, args.gamma))
+        out.write('#include "ledfx_wave.h"\n\n')
+        out.write("const uint16_t ledfx_gamma[LEDFX_LEVELS] = {\n")
+        out.write("\n".join(lines) + "\n")
+        out.write("};\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,173 @@
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/pwm.h"
+
+#include "ledfx.h"
+
+/**
+ * @brief Deja el tope en el rango que admite la tabla
+ */
+static uint32_t clamp_top(uint32_t top) {
+    if (top < 1) { return 1; }
+    if (top > LEDFX_TOP_MAX) { return LEDFX_TOP_MAX; }
+    return top;
+}
+
+/**
+ * @brief Arranca la lista de bloques: el canal de control copia cuatro palabras
+ * en el alias 0 del canal de datos y espera la cadena del siguiente bloque
+ * @param fx LED con la lista armada
+ */
+static void run(ledfx_t *fx) {
+    dma_channel_config c = dma_channel_get_default_config(fx->ctrl_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, 4);           // Vuelve al principio del alias cada 16 bytes
+    dma_channel_configure(fx->ctrl_chan, &c, &dma_hw->ch[fx->data_chan].read_addr, fx->blocks, 4, true);
+}
+
+/**
+ * @brief Configura el PWM del pin y reserva los dos canales DMA
+ * @param fx LED
+ * @param pin GPIO del LED, su porcion del PWM queda para el LED
+ * @param top tope del contador, como mucho LEDFX_TOP_MAX. Define la resolucion
+ * y la frecuencia del PWM, que es tambien la de los bloques
+ * @return false si no quedaban canales DMA libres
+ */
+bool ledfx_init(ledfx_t *fx, uint pin, uint32_t top) {
+    int data_chan = dma_claim_unused_channel(false);
+    int ctrl_chan = dma_claim_unused_channel(false);
+
+    if (data_chan < 0 || ctrl_chan < 0) {
+        if (data_chan >= 0) { dma_channel_unclaim(data_chan); }
+        return false;
+    }
+    fx->data_chan = data_chan;
+    fx->ctrl_chan = ctrl_chan;
+    fx->slice = pwm_gpio_to_slice_num(pin);
+    fx->sys_hz = clock_get_hz(clk_sys);
+    fx->cc = &pwm_hw->slice[fx->slice].cc;
+    fx->restart = &dma_hw->ch[ctrl_chan].read_addr;
+    fx->len = 0;
+    ledfx_scale(fx, clamp_top(top));
+
+    // Niveles: 16 bits con la vuelta del contador. El puente del bus repite la
+    // escritura en las dos mitades del comparador, los dos canales de la porcion
+    // llevan el mismo nivel. El PWM toma el valor recien en la vuelta siguiente
+    dma_channel_config c = dma_channel_get_default_config(data_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pwm_get_dreq(fx->slice));
+    channel_config_set_chain_to(&c, ctrl_chan);
+    fx->level_ctrl = channel_config_get_ctrl_value(&c);
+
+    // Vuelta al principio: una palabra sin esperar al PWM
+    c = dma_channel_get_default_config(data_chan);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_chain_to(&c, ctrl_chan);
+    fx->restart_ctrl = channel_config_get_ctrl_value(&c);
+
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_wrap(&config, fx->top);
+    pwm_init(fx->slice, &config, true);
+    pwm_set_both_levels(fx->slice, 0, 0);
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    return true;
+}
+
+/**
+ * @brief Detiene el efecto en curso. El LED queda en el ultimo nivel
+ * @param fx LED
+ */
+void ledfx_stop(ledfx_t *fx) {
+    // Sin EN la cadena no arranca ningun canal, despues se cancela lo pendiente
+    hw_clear_bits(&dma_hw->ch[fx->ctrl_chan].al1_ctrl, DMA_CH0_CTRL_TRIG_EN_BITS);
+    hw_clear_bits(&dma_hw->ch[fx->data_chan].al1_ctrl, DMA_CH0_CTRL_TRIG_EN_BITS);
+    dma_channel_abort(fx->data_chan);
+    dma_channel_abort(fx->ctrl_chan);
+}
+
+/**
+ * @brief Nivel de brillo actual, leido del comparador
+ * @param fx LED
+ * @return nivel de brillo
+ */
+uint8_t ledfx_level(const ledfx_t *fx) {
+    return ledfx_index(fx, pwm_hw->slice[fx->slice].cc & 0xFFFF);
+}
+
+/**
+ * @brief Cambia el tope del contador y reescala la tabla. Detiene el efecto en
+ * curso y conserva el nivel
+ * @param fx LED
+ * @param top tope del contador, como mucho LEDFX_TOP_MAX
+ */
+void ledfx_set_top(ledfx_t *fx, uint32_t top) {
+    ledfx_stop(fx);
+    uint8_t level = ledfx_level(fx);
+    ledfx_scale(fx, clamp_top(top));
+    pwm_set_wrap(fx->slice, fx->top);
+    pwm_set_both_levels(fx->slice, fx->level[level], fx->level[level]);
+}
+
+/**
+ * @brief Fija un nivel de brillo sin transicion
+ * @param fx LED
+ * @param level nivel de brillo
+ */
+void ledfx_set(ledfx_t *fx, uint8_t level) {
+    ledfx_stop(fx);
+    pwm_set_both_levels(fx->slice, fx->level[level], fx->level[level]);
+}
+
+/**
+ * @brief Transicion desde el nivel actual. Al terminar los canales se detienen
+ * y el LED queda en el nivel pedido
+ * @param fx LED
+ * @param level nivel final
+ * @param ms duracion de la transicion
+ */
+void ledfx_fade_to(ledfx_t *fx, uint8_t level, uint32_t ms) {
+    ledfx_stop(fx);
+    ledfx_wave_begin(fx);
+    ledfx_wave_ramp(fx, ledfx_level(fx), level, ledfx_periods(fx, ms));
+    ledfx_wave_end(fx);
+    run(fx);
+}
+
+/**
+ * @brief Respiracion: sube de low a high y vuelve, sin fin
+ * @param fx LED
+ * @param low nivel minimo
+ * @param high nivel maximo
+ * @param period_ms duracion de una subida y una bajada
+ */
+void ledfx_breathe(ledfx_t *fx, uint8_t low, uint8_t high, uint32_t period_ms) {
+    uint32_t periods = ledfx_periods(fx, period_ms);
+
+    ledfx_stop(fx);
+    ledfx_wave_begin(fx);
+    ledfx_wave_ramp(fx, low, high, periods / 2);
+    ledfx_wave_ramp(fx, high, low, periods - periods / 2);
+    ledfx_wave_restart(fx);
+    run(fx);
+}
+
+/**
+ * @brief Parpadeo sin fin
+ * @param fx LED
+ * @param level nivel encendido
+ * @param on_ms tiempo encendido
+ * @param off_ms tiempo apagado
+ */
+void ledfx_blink(ledfx_t *fx, uint8_t level, uint32_t on_ms, uint32_t off_ms) {
+    ledfx_stop(fx);
+    ledfx_wave_begin(fx);
+    ledfx_wave_hold(fx, level, ledfx_periods(fx, on_ms));
+    ledfx_wave_hold(fx, 0, ledfx_periods(fx, off_ms));
+    ledfx_wave_restart(fx);
+    run(fx);
+}
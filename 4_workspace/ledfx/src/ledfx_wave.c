@@ -0,0 +1,127 @@
+#include "ledfx_wave.h"
+
+/**
+ * @brief Escala la tabla gamma al tope del contador. El nivel maximo queda en
+ * tope + 1, que deja la salida siempre en alto
+ * @param fx LED
+ * @param top tope del contador del PWM
+ */
+void ledfx_scale(ledfx_t *fx, uint32_t top) {
+    fx->top = top;
+    for (int i = 0; i < LEDFX_LEVELS; i++) {
+        fx->level[i] = (uint16_t)(((uint32_t)ledfx_gamma[i] * (top + 1) + 32767) / 65535);
+    }
+}
+
+/**
+ * @brief Convierte un tiempo a vueltas del contador del PWM
+ * @param fx LED
+ * @param ms tiempo en milisegundos
+ * @return periodos del PWM, al menos 1 y como mucho LEDFX_COUNT_MAX
+ */
+uint32_t ledfx_periods(const ledfx_t *fx, uint32_t ms) {
+    uint64_t periods = (uint64_t)ms * fx->sys_hz / ((uint64_t)(fx->top + 1) * 1000);
+    if (periods < 1) { return 1; }
+    if (periods > LEDFX_COUNT_MAX) { return LEDFX_COUNT_MAX; }
+    return (uint32_t)periods;
+}
+
+/**
+ * @brief Busca el nivel de un valor del comparador
+ * @param fx LED
+ * @param duty valor del comparador
+ * @return el menor nivel que llega a duty, o el maximo si lo supera
+ */
+uint8_t ledfx_index(const ledfx_t *fx, uint32_t duty) {
+    uint32_t low = 0, high = LEDFX_LEVEL_MAX;
+
+    // La tabla es creciente: busqueda binaria
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+        if (fx->level[mid] < duty) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return (uint8_t)low;
+}
+
+/**
+ * @brief Agrega un bloque al final de la lista
+ */
+static void push(ledfx_t *fx, const volatile void *read, volatile void *write, uint32_t count, uint32_t ctrl) {
+    if (fx->len >= LEDFX_BLOCKS) { return; }
+    ledfx_block_t *block = &fx->blocks[fx->len++];
+    block->read = read;
+    block->write = write;
+    block->count = count;
+    block->ctrl = ctrl;
+}
+
+/**
+ * @brief Vacia la lista. Va con los canales detenidos
+ * @param fx LED
+ */
+void ledfx_wave_begin(ledfx_t *fx) {
+    fx->len = 0;
+}
+
+/**
+ * @brief Mantiene un nivel
+ * @param fx LED
+ * @param level nivel de brillo
+ * @param periods vueltas del contador
+ */
+void ledfx_wave_hold(ledfx_t *fx, uint8_t level, uint32_t periods) {
+    if (periods < 1) { periods = 1; }
+    if (periods > LEDFX_COUNT_MAX) { periods = LEDFX_COUNT_MAX; }
+    push(fx, &fx->level[level], fx->cc, periods, fx->level_ctrl);
+}
+
+/**
+ * @brief Rampa lineal en brillo percibido, de a un nivel por escalon como
+ * minimo. El primer escalon ya se aparta de from y el ultimo es to, asi dos
+ * rampas seguidas no repiten el extremo
+ * @param fx LED
+ * @param from nivel de partida
+ * @param to nivel final
+ * @param periods vueltas del contador de toda la rampa
+ */
+void ledfx_wave_ramp(ledfx_t *fx, uint8_t from, uint8_t to, uint32_t periods) {
+    int32_t delta = (int32_t)to - from;
+    uint32_t steps = delta < 0 ? (uint32_t)-delta : (uint32_t)delta;
+
+    if (steps > LEDFX_STEPS) { steps = LEDFX_STEPS; }
+    if (steps > periods) { steps = periods; }
+    if (steps < 1) {
+        ledfx_wave_hold(fx, to, periods);
+        return;
+    }
+
+    // Los periodos que sobran de la division se reparten entre los escalones
+    for (uint32_t i = 0; i < steps; i++) {
+        uint32_t count = (uint32_t)(((uint64_t)periods * (i + 1)) / steps - ((uint64_t)periods * i) / steps);
+        int32_t level = from + delta * (int32_t)(i + 1) / (int32_t)steps;
+        ledfx_wave_hold(fx, (uint8_t)level, count);
+    }
+}
+
+/**
+ * @brief Cierra la lista con la vuelta al primer bloque: el canal de datos
+ * copia el principio de la lista en el canal de control y lo dispara
+ * @param fx LED
+ */
+void ledfx_wave_restart(ledfx_t *fx) {
+    fx->list = fx->blocks;
+    push(fx, &fx->list, fx->restart, 1, fx->restart_ctrl);
+}
+
+/**
+ * @brief Cierra la lista con un disparo nulo. El comparador conserva el
+ * ultimo nivel
+ * @param fx LED
+ */
+void ledfx_wave_end(ledfx_t *fx) {
+    push(fx, NULL, NULL, 0, 0);
+}
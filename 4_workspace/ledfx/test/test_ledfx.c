@@ -0,0 +1,265 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "check.h"
+#include "ledfx_wave.h"
+
+// Configuracion de los canales, la prueba solo mira que cada bloque lleve la suya
+#define LEVEL_CTRL      0x00001234u
+#define RESTART_CTRL    0x00005678u
+// Reloj del PWM de la placa
+#define SYS_HZ          150000000u
+
+/**
+ * @brief Un bloque de nivel de la lista, como lo ve el PWM
+ */
+typedef struct {
+    uint8_t level;
+    uint32_t periods;
+} step_t;
+
+static ledfx_t fx;
+static volatile uint32_t cc;
+static const volatile void *ctrl_read_addr;
+static step_t steps[LEDFX_BLOCKS];
+
+/**
+ * @brief LED con el PWM simulado: el comparador y el READ_ADDR del canal de
+ * control son variables
+ */
+static void setup(uint32_t top) {
+    memset(&fx, 0, sizeof(fx));
+    fx.cc = &cc;
+    fx.restart = &ctrl_read_addr;
+    fx.level_ctrl = LEVEL_CTRL;
+    fx.restart_ctrl = RESTART_CTRL;
+    fx.sys_hz = SYS_HZ;
+    ledfx_scale(&fx, top);
+}
+
+/**
+ * @brief Recorre la lista como el canal de control: cada bloque de nivel lee de
+ * la tabla y escribe el comparador, y el ultimo vuelve al principio o termina
+ * @param restart true si la lista tiene que terminar con la vuelta al principio
+ * @return bloques de nivel, o -1 si algun bloque esta mal armado
+ */
+static int play(bool restart) {
+    int count = 0;
+
+    for (uint32_t i = 0; i < fx.len; i++) {
+        const ledfx_block_t *block = &fx.blocks[i];
+        bool last = i == fx.len - 1;
+
+        if (block->ctrl == LEVEL_CTRL && !last) {
+            const volatile uint16_t *read = block->read;
+            if (read < fx.level || read > &fx.level[LEDFX_LEVEL_MAX]) { return -1; }
+            if (block->write != fx.cc || block->count < 1 || block->count > LEDFX_COUNT_MAX) { return -1; }
+            steps[count++] = (step_t){ (uint8_t)(read - fx.level), block->count };
+        } else if (!last) {
+            return -1;
+        } else if (restart) {
+            // El canal de datos copia el principio de la lista en el canal de control
+            if (block->read != &fx.list || fx.list != fx.blocks || block->write != fx.restart) { return -1; }
+            if (block->count != 1 || block->ctrl != RESTART_CTRL) { return -1; }
+        } else {
+            // Disparo nulo: el canal de control escribe CTRL_TRIG en cero
+            if (block->read || block->write || block->count || block->ctrl) { return -1; }
+        }
+    }
+    return count;
+}
+
+static uint32_t total_periods(int count) {
+    uint32_t total = 0;
+    for (int i = 0; i < count; i++) { total += steps[i].periods; }
+    return total;
+}
+
+// La tabla generada contra la curva, con los extremos exactos
+static void test_gamma(void) {
+    int plateaus = 0;
+
+    for (int i = 0; i < LEDFX_LEVELS; i++) {
+        uint16_t expected = (uint16_t)(pow(i / 255.0, 2.2) * 65535 + 0.5);
+        CHECK_EQ(ledfx_gamma[i], expected);
+        if (i > 0) {
+            CHECK(ledfx_gamma[i] >= ledfx_gamma[i - 1]);
+            plateaus += ledfx_gamma[i] == ledfx_gamma[i - 1];
+        }
+    }
+    CHECK_EQ(ledfx_gamma[0], 0);
+    CHECK_EQ(ledfx_gamma[LEDFX_LEVEL_MAX], 65535);
+    // Solo los dos primeros niveles dan el mismo ciclo en Q16
+    CHECK_EQ(plateaus, 1);
+}
+
+/**
+ * @brief La tabla escalada a distintos topes: redondeo de medio conteo, el
+ * nivel maximo en tope + 1 y la busqueda inversa de ledfx_index
+ */
+static void test_scale(void) {
+    static const uint32_t tops[] = { 1, 255, 1023, 4095, LEDFX_TOP_MAX };
+
+    for (size_t t = 0; t < sizeof(tops) / sizeof(tops[0]); t++) {
+        uint32_t top = tops[t];
+        double worst = 0.0;
+        int distinct = 1;
+
+        setup(top);
+        CHECK_EQ(fx.top, top);
+        CHECK_EQ(fx.level[0], 0);
+        CHECK_EQ(fx.level[LEDFX_LEVEL_MAX], top + 1);
+        for (int i = 0; i < LEDFX_LEVELS; i++) {
+            double ideal = ledfx_gamma[i] * (top + 1.0) / 65535.0;
+            worst = fmax(worst, fabs(fx.level[i] - ideal));
+            if (i > 0) {
+                CHECK(fx.level[i] >= fx.level[i - 1]);
+                distinct += fx.level[i] != fx.level[i - 1];
+            }
+        }
+        CHECK(worst <= 0.5);
+
+        // ledfx_index devuelve el menor nivel que llega al comparador
+        for (uint32_t duty = 0; duty <= top + 1; duty++) {
+            uint8_t index = ledfx_index(&fx, duty);
+            CHECK(fx.level[index] >= duty);
+            CHECK(index == 0 || fx.level[index - 1] < duty);
+        }
+        CHECK_EQ(ledfx_index(&fx, top + 2), LEDFX_LEVEL_MAX);
+        printf("tope %5u: %3d niveles distintos, error de redondeo %.3f cuentas\n", top, distinct, worst);
+    }
+}
+
+// Tiempos a vueltas del contador, con los limites del contador del DMA
+static void test_periods(void) {
+    setup(4095);
+    CHECK_EQ(ledfx_periods(&fx, 1000), SYS_HZ / 4096);
+    CHECK_EQ(ledfx_periods(&fx, 0), 1);
+    CHECK_EQ(ledfx_periods(&fx, 1), 36);
+    setup(1);
+    CHECK_EQ(ledfx_periods(&fx, 0xFFFFFFFFu), LEDFX_COUNT_MAX);
+
+    setup(4095);
+    ledfx_wave_begin(&fx);
+    ledfx_wave_hold(&fx, 7, 0);
+    ledfx_wave_hold(&fx, 8, LEDFX_COUNT_MAX + 1);
+    ledfx_wave_end(&fx);
+    CHECK_EQ(play(false), 2);
+    CHECK(steps[0].level == 7 && steps[0].periods == 1);
+    CHECK(steps[1].level == 8 && steps[1].periods == LEDFX_COUNT_MAX);
+}
+
+/**
+ * @brief Verifica una rampa: todos los periodos, escalones que avanzan hacia to
+ * de a lo sumo el salto justo, el primero ya fuera de from y el ultimo en to,
+ * y los periodos repartidos con diferencia de a lo sumo uno
+ */
+static void check_ramp(const step_t *ramp, int count, uint8_t from, uint8_t to, uint32_t periods) {
+    int32_t delta = (int32_t)to - from, distance = delta < 0 ? -delta : delta;
+    int32_t max_jump = (distance + count - 1) / count;
+    uint32_t shortest = UINT32_MAX, longest = 0, total = 0;
+    int32_t previous = from;
+
+    for (int i = 0; i < count; i++) {
+        int32_t jump = delta < 0 ? previous - ramp[i].level : ramp[i].level - previous;
+        CHECK(jump >= 1 && jump <= max_jump);
+        previous = ramp[i].level;
+        shortest = ramp[i].periods < shortest ? ramp[i].periods : shortest;
+        longest = ramp[i].periods > longest ? ramp[i].periods : longest;
+        total += ramp[i].periods;
+    }
+    CHECK_EQ(ramp[count - 1].level, to);
+    CHECK_EQ(total, periods);
+    CHECK(longest - shortest <= 1);
+}
+
+// Transiciones: escalones segun la distancia y los periodos, y la lista que termina
+static void test_fade(void) {
+    setup(4095);
+
+    // Mas niveles que escalones: LEDFX_STEPS escalones
+    ledfx_wave_begin(&fx);
+    ledfx_wave_ramp(&fx, 10, 200, 1000);
+    ledfx_wave_end(&fx);
+    CHECK_EQ(play(false), LEDFX_STEPS);
+    check_ramp(steps, LEDFX_STEPS, 10, 200, 1000);
+
+    // Bajando, con pocos niveles: uno por escalon
+    ledfx_wave_begin(&fx);
+    ledfx_wave_ramp(&fx, 8, 5, 1000);
+    ledfx_wave_end(&fx);
+    CHECK_EQ(play(false), 3);
+    check_ramp(steps, 3, 8, 5, 1000);
+    CHECK(steps[0].level == 7 && steps[1].level == 6);
+
+    // Menos periodos que niveles: un periodo por escalon
+    ledfx_wave_begin(&fx);
+    ledfx_wave_ramp(&fx, 0, LEDFX_LEVEL_MAX, 10);
+    ledfx_wave_end(&fx);
+    CHECK_EQ(play(false), 10);
+    check_ramp(steps, 10, 0, LEDFX_LEVEL_MAX, 10);
+
+    // Sin distancia: se mantiene el nivel
+    ledfx_wave_begin(&fx);
+    ledfx_wave_ramp(&fx, 42, 42, 500);
+    ledfx_wave_end(&fx);
+    CHECK_EQ(play(false), 1);
+    CHECK(steps[0].level == 42 && steps[0].periods == 500);
+}
+
+/**
+ * @brief Respiracion como la arma ledfx_breathe: dos rampas que llenan la lista
+ * y la vuelta al principio. En el ciclo ningun nivel se repite en dos bloques
+ * seguidos, tampoco al volver
+ */
+static void test_breathe(void) {
+    uint32_t periods;
+    int count, repeats = 0;
+
+    setup(4095);
+    periods = ledfx_periods(&fx, 3000);
+    ledfx_wave_begin(&fx);
+    ledfx_wave_ramp(&fx, 0, LEDFX_LEVEL_MAX, periods / 2);
+    ledfx_wave_ramp(&fx, LEDFX_LEVEL_MAX, 0, periods - periods / 2);
+    ledfx_wave_restart(&fx);
+    CHECK_EQ(fx.len, LEDFX_BLOCKS);
+    count = play(true);
+    CHECK_EQ(count, 2 * LEDFX_STEPS);
+    check_ramp(steps, LEDFX_STEPS, 0, LEDFX_LEVEL_MAX, periods / 2);
+    check_ramp(steps + LEDFX_STEPS, LEDFX_STEPS, LEDFX_LEVEL_MAX, 0, periods - periods / 2);
+    CHECK_EQ(total_periods(count), periods);
+    for (int i = 0; i < count; i++) { repeats += steps[i].level == steps[(i + 1) % count].level; }
+    CHECK_EQ(repeats, 0);
+    printf("respiracion de 3 s: %d bloques, %u periodos de %u a %u vueltas\n", count, periods,
+           steps[0].periods, steps[LEDFX_STEPS - 1].periods);
+
+    // Un bloque de mas no pisa la lista llena
+    ledfx_wave_hold(&fx, 1, 1);
+    CHECK_EQ(fx.len, LEDFX_BLOCKS);
+    CHECK_EQ(play(true), 2 * LEDFX_STEPS);
+}
+
+// Parpadeo del tp1: encendido, apagado y la vuelta al principio
+static void test_blink(void) {
+    setup(4095);
+    ledfx_wave_begin(&fx);
+    ledfx_wave_hold(&fx, LEDFX_LEVEL_MAX, ledfx_periods(&fx, 1000));
+    ledfx_wave_hold(&fx, 0, ledfx_periods(&fx, 1500));
+    ledfx_wave_restart(&fx);
+    CHECK_EQ(play(true), 2);
+    CHECK(steps[0].level == LEDFX_LEVEL_MAX && steps[0].periods == SYS_HZ / 4096);
+    CHECK(steps[1].level == 0 && steps[1].periods == (uint32_t)(1500ull * SYS_HZ / 4096 / 1000));
+    // El nivel maximo deja la salida siempre en alto
+    CHECK_EQ(fx.level[steps[0].level], 4096);
+}
+
+int main(void) {
+    test_gamma();
+    test_scale();
+    test_periods();
+    test_fade();
+    test_breathe();
+    test_blink();
+    return check_result("ledfx");
+}
@@ -0,0 +1,165 @@
+#ifndef _MAILBOX_H_
+#define _MAILBOX_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Tareas que se pueden suscribir a un mailbox para esperar versiones nuevas
+#ifndef MAILBOX_WAITERS
+#define MAILBOX_WAITERS     4
+#endif
+
+// Indice de notificacion que usa mailbox_wait. Se puede compartir con
+// spsc_pop_wait: las dos leen antes de esperar, una notificacion ajena solo
+// causa una vuelta extra
+#ifndef MAILBOX_NOTIFY_INDEX
+#define MAILBOX_NOTIFY_INDEX    2
+#endif
+
+// Declara el buffer de un mailbox del tipo indicado, dos copias del valor
+#define MAILBOX_BUFFER(name, type)  type name[2]
+
+/**
+ * @brief Registro del ultimo valor con un escritor (tarea o ISR) y varios
+ * lectores. El escritor alterna entre dos copias y el lector lee la que no se
+ * esta escribiendo, asi que ninguno espera al otro ni deshabilita interrupciones.
+ * La secuencia vale el doble de la version, mas uno mientras se escribe
+ */
+typedef struct {
+    volatile uint32_t seq;              // Solo la escribe el escritor
+    uint8_t *buf;                       // Dos copias del valor
+    size_t size;                        // Bytes del valor
+    void *waiters[MAILBOX_WAITERS];     // Tareas a notificar (TaskHandle_t) o NULL
+} mailbox_t;
+
+/**
+ * @brief Inicializa un mailbox sin valor (version 0)
+ * @param mb puntero al mailbox
+ * @param buf buffer de dos valores (ver MAILBOX_BUFFER)
+ * @param size bytes del valor
+ */
+static inline void mailbox_init(mailbox_t *mb, void *buf, size_t size) {
+    memset(mb, 0, sizeof(*mb));
+    memset(buf, 0, 2 * size);
+    mb->buf = (uint8_t *)buf;
+    mb->size = size;
+}
+
+/**
+ * @brief Escribe un valor nuevo, solo desde el escritor
+ * @param mb puntero al mailbox
+ * @param src valor a copiar
+ * @return version del valor escrito
+ */
+static inline uint32_t mailbox_write(mailbox_t *mb, const void *src) {
+    uint32_t seq = mb->seq;
+    uint32_t version = (seq >> 1) + 1;
+
+    // Impar antes de tocar la copia: un lector que la estaba leyendo reintenta
+    __atomic_store_n(&mb->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(mb->buf + (version & 1) * mb->size, src, mb->size);
+    __atomic_store_n(&mb->seq, seq + 2, __ATOMIC_RELEASE);
+    return version;
+}
+
+/**
+ * @brief Copia el ultimo valor. Reintenta solo si el escritor empezo a pisar
+ * la copia que se estaba leyendo, lo que requiere dos escrituras en el medio
+ * @param mb puntero al mailbox
+ * @param dst donde se copia el valor
+ * @return version leida, 0 si todavia no se escribio nada
+ */
+static inline uint32_t mailbox_read(const mailbox_t *mb, void *dst) {
+    uint32_t seq, now;
+
+    do {
+        // Con la secuencia impar se lee la copia anterior, que esta completa
+        seq = __atomic_load_n(&mb->seq, __ATOMIC_ACQUIRE);
+        memcpy(dst, mb->buf + ((seq >> 1) & 1) * mb->size, mb->size);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        now = __atomic_load_n(&mb->seq, __ATOMIC_RELAXED);
+        // La copia leida se vuelve a escribir cuando la secuencia pasa de la par + 2
+    } while (now - (seq & ~1u) > 2);
+    return seq >> 1;
+}
+
+/**
+ * @brief Version del ultimo valor escrito, sin copiarlo
+ * @param mb puntero al mailbox
+ * @return version, 0 si todavia no se escribio nada
+ */
+static inline uint32_t mailbox_version(const mailbox_t *mb) {
+    return __atomic_load_n(&mb->seq, __ATOMIC_ACQUIRE) >> 1;
+}
+
+#ifdef INC_FREERTOS_H
+#include "task.h"
+
+/**
+ * @brief Suscribe una tarea para que mailbox_wait la despierte con cada valor
+ * nuevo. Se llama antes de que el escritor empiece
+ * @param mb puntero al mailbox
+ * @param task tarea que espera
+ * @return false si no hay lugar para otra tarea
+ */
+static inline bool mailbox_subscribe(mailbox_t *mb, TaskHandle_t task) {
+    for (int i = 0; i < MAILBOX_WAITERS; i++) {
+        if (!mb->waiters[i]) {
+            mb->waiters[i] = task;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Escribe un valor nuevo desde una tarea y notifica a las suscriptas
+ * @param mb puntero al mailbox
+ * @param src valor a copiar
+ * @return version del valor escrito
+ */
+static inline uint32_t mailbox_post(mailbox_t *mb, const void *src) {
+    uint32_t version = mailbox_write(mb, src);
+    for (int i = 0; i < MAILBOX_WAITERS && mb->waiters[i]; i++) {
+        xTaskNotifyGiveIndexed((TaskHandle_t)mb->waiters[i], MAILBOX_NOTIFY_INDEX);
+    }
+    return version;
+}
+
+/**
+ * @brief Escribe un valor nuevo desde una ISR y notifica a las suscriptas
+ * @param mb puntero al mailbox
+ * @param src valor a copiar
+ * @param to_higher_priority_task se pone en pdTRUE si hay que cambiar de tarea
+ * @return version del valor escrito
+ */
+static inline uint32_t mailbox_post_from_isr(mailbox_t *mb, const void *src, BaseType_t *to_higher_priority_task) {
+    uint32_t version = mailbox_write(mb, src);
+    for (int i = 0; i < MAILBOX_WAITERS && mb->waiters[i]; i++) {
+        vTaskNotifyGiveIndexedFromISR((TaskHandle_t)mb->waiters[i], MAILBOX_NOTIFY_INDEX, to_higher_priority_task);
+    }
+    return version;
+}
+
+/**
+ * @brief Copia el ultimo valor si es mas nuevo que la version indicada. Si no,
+ * bloquea la tarea, que tiene que estar suscripta, hasta el proximo valor
+ * @param mb puntero al mailbox
+ * @param dst donde se copia el valor
+ * @param version ultima version que tiene la tarea, 0 al empezar
+ * @param timeout ticks de espera maxima
+ * @return version leida, 0 si paso el timeout sin un valor nuevo
+ */
+static inline uint32_t mailbox_wait(const mailbox_t *mb, void *dst, uint32_t version, TickType_t timeout) {
+    // Una notificacion vieja solo causa una vuelta extra
+    while (mailbox_version(mb) == version) {
+        if (!ulTaskNotifyTakeIndexed(MAILBOX_NOTIFY_INDEX, pdTRUE, timeout)) { return 0; }
+    }
+    return mailbox_read(mb, dst);
+}
+#endif
+
+#endif
@@ -0,0 +1,199 @@
+// pthread y clock_gettime con -std=c11
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "check.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mailbox.h"
+
+// Valores que escribe el escritor en la prueba de varios hilos
+#define WRITES          20000000u
+// Palabras del valor, 64 bytes con la version
+#define WORDS           15
+
+typedef struct {
+    uint32_t version;
+    uint32_t words[WORDS];
+} value_t;
+
+/**
+ * @brief Tarea en un hilo, solo con las notificaciones que usa mailbox_wait
+ */
+struct host_task {
+    uint32_t notify[configTASK_NOTIFICATION_ARRAY_ENTRIES];
+    pthread_t thread;
+    // Resultados del lector, se leen despues del join
+    uint32_t reads;
+    uint32_t last;
+    uint32_t torn;
+    uint32_t regressions;
+    uint32_t stalls;
+};
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t notified = PTHREAD_COND_INITIALIZER;
+static _Thread_local struct host_task *current;
+
+static MAILBOX_BUFFER(value_buf, value_t);
+static mailbox_t mb;
+
+// Notificaciones con un lock y una condicion, las tareas se bloquean de verdad
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear, TickType_t timeout) {
+    struct timespec deadline;
+    uint32_t *notify = &current->notify[index];
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout / configTICK_RATE_HZ;
+    deadline.tv_nsec += (long)(timeout % configTICK_RATE_HZ) * (1000000000 / configTICK_RATE_HZ);
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&lock);
+    while (!*notify && timeout && !pthread_cond_timedwait(&notified, &lock, &deadline)) {}
+    uint32_t value = *notify;
+    if (value) { *notify = clear ? 0 : value - 1; }
+    pthread_mutex_unlock(&lock);
+    return value;
+}
+
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index) {
+    pthread_mutex_lock(&lock);
+    task->notify[index]++;
+    pthread_cond_broadcast(&notified);
+    pthread_mutex_unlock(&lock);
+    return pdPASS;
+}
+
+static uint32_t word(uint32_t version, uint32_t i) {
+    return (version + i) * 2654435761u ^ 0xA5A5A5A5u;
+}
+
+static void fill(value_t *value, uint32_t version) {
+    value->version = version;
+    for (uint32_t i = 0; i < WORDS; i++) { value->words[i] = word(version, i); }
+}
+
+/**
+ * @brief Un valor completo: todas las palabras son de la version que dice
+ */
+static bool whole(const value_t *value, uint32_t version) {
+    if (value->version != version) { return false; }
+    for (uint32_t i = 0; i < WORDS; i++) {
+        if (value->words[i] != word(version, i)) { return false; }
+    }
+    return true;
+}
+
+/**
+ * @brief Registra una lectura: completa y nunca mas vieja que la anterior
+ */
+static void check_read(struct host_task *reader, const value_t *value, uint32_t version) {
+    if (!whole(value, version)) { reader->torn++; }
+    if (version < reader->last) { reader->regressions++; }
+    reader->last = version;
+    reader->reads++;
+}
+
+// Valores sin version y una escritura que quedo a la mitad
+static void test_single(void) {
+    value_t value, other;
+
+    mailbox_init(&mb, value_buf, sizeof(value_t));
+    CHECK_EQ(mailbox_read(&mb, &value), 0);
+    CHECK_EQ(value.version + value.words[0], 0);
+
+    for (uint32_t version = 1; version <= 5; version++) {
+        fill(&value, version);
+        CHECK_EQ(mailbox_write(&mb, &value), version);
+        CHECK_EQ(mailbox_read(&mb, &other), version);
+        CHECK(whole(&other, version));
+    }
+
+    // Escritor interrumpido con la secuencia impar: se lee la copia anterior sin esperar
+    mb.seq++;
+    memset(value_buf[(mailbox_version(&mb) + 1) & 1].words, 0xFF, sizeof(value.words));
+    CHECK_EQ(mailbox_read(&mb, &other), 5);
+    CHECK(whole(&other, 5));
+    mb.seq--;
+}
+
+// Lector que consulta sin bloquear hasta ver el ultimo valor
+static void *poll_reader(void *arg) {
+    struct host_task *reader = arg;
+    value_t value;
+    uint32_t version = 0;
+
+    current = reader;
+    while (version < WRITES) {
+        version = mailbox_read(&mb, &value);
+        if (version) { check_read(reader, &value, version); }
+    }
+    return NULL;
+}
+
+// Lector suscripto que espera cada valor nuevo
+static void *wait_reader(void *arg) {
+    struct host_task *reader = arg;
+    value_t value;
+    uint32_t version = 0;
+
+    current = reader;
+    while (version < WRITES) {
+        uint32_t read = mailbox_wait(&mb, &value, version, pdMS_TO_TICKS(2000));
+        // En la placa la tarea quedaria bloqueada con un valor nuevo disponible
+        if (!read) {
+            reader->stalls++;
+            break;
+        }
+        if (read <= version) { reader->regressions++; }
+        check_read(reader, &value, read);
+        version = read;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Un escritor y cuatro lectores: dos consultan sin bloquear y dos esperan
+ * con mailbox_wait. Ninguna lectura puede mezclar dos valores ni volver atras
+ */
+static void test_threads(void) {
+    static struct host_task readers[4];
+    static void *(*const code[4])(void *) = { poll_reader, poll_reader, wait_reader, wait_reader };
+    value_t value;
+
+    mailbox_init(&mb, value_buf, sizeof(value_t));
+    for (int i = 0; i < 4; i++) {
+        memset(&readers[i], 0, sizeof(readers[i]));
+        if (code[i] == wait_reader) { CHECK(mailbox_subscribe(&mb, &readers[i])); }
+    }
+    for (int i = 0; i < 4; i++) { CHECK(!pthread_create(&readers[i].thread, NULL, code[i], &readers[i])); }
+
+    for (uint32_t version = 1; version <= WRITES; version++) {
+        fill(&value, version);
+        mailbox_post(&mb, &value);
+    }
+    for (int i = 0; i < 4; i++) { pthread_join(readers[i].thread, NULL); }
+
+    for (int i = 0; i < 4; i++) {
+        printf("lector %d (%s): %u lecturas, ultima %u, %u mezcladas, %u hacia atras, %u bloqueos\n", i,
+               code[i] == wait_reader ? "mailbox_wait" : "mailbox_read", readers[i].reads, readers[i].last,
+               readers[i].torn, readers[i].regressions, readers[i].stalls);
+        CHECK_EQ(readers[i].last, WRITES);
+        CHECK_EQ(readers[i].torn, 0);
+        CHECK_EQ(readers[i].regressions, 0);
+        CHECK_EQ(readers[i].stalls, 0);
+    }
+    CHECK_EQ(mailbox_version(&mb), WRITES);
+}
+
+int main(void) {
+    test_single();
+    test_threads();
+    return check_result("mailbox");
+}
@@ -0,0 +1,28 @@
+# Informe de las funciones que corren desde SRAM
+#
+# Las funciones se ubican en RAM con __not_in_flash_func(nombre) del SDK: van
+# a la seccion .time_critical.<nombre>, que el linker script del SDK pone
+# junto a .data y crt0 copia a RAM al arrancar.
+
+set(RAMFUNC_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+# ramfunc_report(<target> [STRICT] HOT <funcion>...)
+# Despues de cada link muestra las funciones en RAM, las llamadas que vuelven
+# a flash y las funciones de HOT que quedaron en flash (error con STRICT)
+function(ramfunc_report target)
+    cmake_parse_arguments(ARG "STRICT" "" "HOT" ${ARGN})
+    find_package(Python3 COMPONENTS Interpreter REQUIRED)
+
+    set(args $<TARGET_FILE:${target}> --nm ${CMAKE_NM} --objdump ${CMAKE_OBJDUMP})
+    if(ARG_HOT)
+        list(APPEND args --hot ${ARG_HOT})
+    endif()
+    if(ARG_STRICT)
+        list(APPEND args --strict)
+    endif()
+
+    add_custom_command(TARGET ${target} POST_BUILD
+        COMMAND ${Python3_EXECUTABLE} ${RAMFUNC_DIR}/ramfunc_report.py ${args}
+        VERBATIM
+    )
+endfunction()
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Informe de las funciones que corren desde SRAM.
+
+Lista las funciones del ELF que quedaron en RAM (las marcadas con
+__not_in_flash_func o __time_critical_func, que el linker script del SDK
+copia a RAM al arrancar), las llamadas desde esas funciones a codigo en
+flash, que vuelven a pasar por la cache XIP, y las funciones criticas
+pedidas que quedaron en flash.
+
+Uso:
+    ramfunc_report.py firmware.elf --hot isr_pendsv isr_systick adc_irq_handler
+    ramfunc_report.py firmware.elf --hot ... --strict      # falla si alguna quedo en flash
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+# Mapa de memoria del RP2040 y del RP2350
+FLASH = (0x10000000, 0x20000000)
+SRAM = (0x20000000, 0x30000000)
+
+FUNCTION = re.compile(r"^([0-9a-f]+) <([^>]+)>:$")
+BRANCH = re.compile(r"^\s*[0-9a-f]+:\s+(bl|blx|b|b\.w|b\.n|call|callq|jmp|jmpq)\s+[0-9a-f]+ <([^>+]+)>")
+VENEER = re.compile(r"^__(.+)_veneer$")
+
+
+def in_region(address, region):
+    return region[0] <= address < region[1]
+
+
+def load_symbols(nm, elf):
+    """Funciones definidas: nombre -> (direccion, tamaño)."""
+    out = subprocess.run([nm, "-S", "--defined-only", elf], capture_output=True, text=True, check=True).stdout
+    symbols = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) == 4 and parts[2] in "TtWw":
+            symbols[parts[3]] = (int(parts[0], 16), int(parts[1], 16))
+    return symbols
+
+
+def load_calls(objdump, elf):
+    """Llamadas directas desde las funciones en RAM: funcion -> funciones llamadas."""
+    out = subprocess.run([objdump, "-d", "--no-show-raw-insn", "--start-address=0x%x" % SRAM[0],
+                          "--stop-address=0x%x" % SRAM[1], elf], capture_output=True, text=True, check=True).stdout
+    calls = {}
+    current = None
+    for line in out.splitlines():
+        match = FUNCTION.match(line)
+        if match:
+            current = match.group(2)
+            calls.setdefault(current, set())
+            continue
+        match = BRANCH.match(line.split("@")[0].split("#")[0])
+        if match and current:
+            target = match.group(2)
+            veneer = VENEER.match(target)
+            target = veneer.group(1) if veneer else target
+            if target != current:
+                calls[current].add(target)
+    return calls
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="ELF del firmware")
+    parser.add_argument("--hot", nargs="*", default=[], metavar="FUNCION", help="funciones que tienen que estar en RAM")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--objdump", default="arm-none-eabi-objdump")
+    parser.add_argument("--strict", action="store_true", help="error si una funcion critica quedo en flash")
+    args = parser.parse_args()
+
+    symbols = load_symbols(args.nm, args.elf)
+    calls = load_calls(args.objdump, args.elf)
+    hot = set(args.hot)
+
+    ram = sorted((address, size, name) for name, (address, size) in symbols.items() if in_region(address, SRAM))
+    ram = [(address, size, name) for address, size, name in ram if not VENEER.match(name)]
+    print("Funciones en RAM: %d, %d B" % (len(ram), sum(size for _, size, _ in ram)))
+    for address, size, name in ram:
+        print("  %08x %6d  %s%s" % (address, size, name, "  *" if name in hot else ""))
+
+    # Cada llamada a flash desde RAM puede fallar en la cache XIP
+    to_flash = []
+    for _, _, name in ram:
+        for callee in sorted(calls.get(name, ())):
+            if callee in symbols and in_region(symbols[callee][0], FLASH):
+                to_flash.append((name, callee))
+    if to_flash:
+        print("\nLlamadas de RAM a flash:")
+        for name, callee in to_flash:
+            print("  %s -> %s" % (name, callee))
+
+    missing = sorted(name for name in hot if name not in symbols)
+    in_flash = sorted(name for name in hot if name in symbols and not in_region(symbols[name][0], SRAM))
+    if missing:
+        print("\nFunciones criticas que no estan en el ELF (inlineadas o descartadas): %s" % ", ".join(missing))
+    if in_flash:
+        print("\nFunciones criticas en flash: %s" % ", ".join(in_flash))
+        if args.strict:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
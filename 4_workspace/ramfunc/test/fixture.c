@@ -0,0 +1,40 @@
+// ELF de prueba para ramfunc_report.py, armado con el mapa de memoria del RP2040 y
+// el RP2350: el codigo en flash desde 0x10000000 y las secciones .time_critical en
+// SRAM desde 0x20000000, como las ubica el linker script del SDK. No se ejecuta
+
+// Misma marca que el SDK
+#define __not_in_flash_func(f) __attribute__((noinline, section(".time_critical." #f))) f
+
+volatile int sink;
+
+__attribute__((noinline)) void slow_helper(int x) {
+    sink = x * 3;
+}
+
+// Critica pero sin la marca: queda en flash
+__attribute__((noinline)) void flash_isr(void) {
+    sink = 1;
+}
+
+// En RAM, pero llama a una funcion en flash
+void __not_in_flash_func(fast_isr)(void) {
+    sink = 2;
+    slow_helper(4);
+}
+
+void __not_in_flash_func(fast_leaf)(void) {
+    sink = 5;
+}
+
+// Se inlinea en quien la llama, no queda en el ELF
+static inline void inlined_hot(void) {
+    sink = 6;
+}
+
+void _start(void) {
+    fast_isr();
+    fast_leaf();
+    flash_isr();
+    inlined_hot();
+    for (;;);
+}
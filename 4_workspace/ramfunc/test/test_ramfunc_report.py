@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+"""Prueba de ramfunc_report.py sobre el ELF de fixture.c con las herramientas de la PC.
+
+Uso:
+    test_ramfunc_report.py fixture.elf
+"""
+
+import os
+import subprocess
+import sys
+
+REPORT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "ramfunc_report.py")
+failures = 0
+
+
+def check(condition, message):
+    global failures
+    if not condition:
+        print("falla: %s" % message, file=sys.stderr)
+        failures += 1
+
+
+def report(elf, *args):
+    result = subprocess.run([sys.executable, REPORT, elf, "--nm", "nm", "--objdump", "objdump"] + list(args),
+                            capture_output=True, text=True)
+    return result.returncode, result.stdout
+
+
+def main():
+    elf = sys.argv[1]
+
+    code, out = report(elf, "--hot", "fast_isr", "flash_isr", "inlined_hot")
+    print(out)
+    lines = out.splitlines()
+    check(code == 0, "sin --strict no falla")
+    check(lines[0].startswith("Funciones en RAM: 2,"), "dos funciones en RAM")
+    check(any(l.split()[-2:] == ["fast_isr", "*"] for l in lines), "fast_isr en RAM y marcada como critica")
+    check(any(l.split()[-1] == "fast_leaf" for l in lines), "fast_leaf en RAM")
+    check(not any(l.split()[-1:] == ["slow_helper"] and l.startswith("  2") for l in lines), "slow_helper no esta en RAM")
+    check("  fast_isr -> slow_helper" in lines, "llamada de RAM a flash")
+    check(not any("fast_leaf ->" in l for l in lines), "fast_leaf no llama a nadie")
+    check(any("inlineadas" in l and l.endswith("inlined_hot") for l in lines), "inlined_hot inlineada")
+    check("Funciones criticas en flash: flash_isr" in lines, "flash_isr en flash")
+
+    code, _ = report(elf, "--hot", "fast_isr", "flash_isr", "--strict")
+    check(code == 1, "con --strict falla si una critica quedo en flash")
+    code, out = report(elf, "--hot", "fast_isr", "fast_leaf", "--strict")
+    check(code == 0 and "en flash" not in out, "con --strict no falla si todas estan en RAM")
+
+    print("ramfunc_report: %s (%d fallas)" % ("FALLA" if failures else "ok", failures))
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
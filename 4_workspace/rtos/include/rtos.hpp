@@ -0,0 +1,231 @@
+#ifndef _RTOS_HPP_
+#define _RTOS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "mailbox.h"
+
+#if !configSUPPORT_STATIC_ALLOCATION
+#error "rtos.hpp necesita configSUPPORT_STATIC_ALLOCATION en 1"
+#endif
+
+// Mayor elemento que se copia desde una ISR, la copia se hace con las interrupciones enmascaradas
+#ifndef RTOS_ISR_ITEM_MAX
+#define RTOS_ISR_ITEM_MAX   32
+#endif
+
+// Objetos del kernel con la memoria reservada en tiempo de compilacion. Se crean
+// en el constructor con las funciones Static del kernel, que no pueden fallar
+// por falta de memoria. Todos van como variables globales o static
+namespace rtos {
+
+/**
+ * @brief Tipo del parametro de las copias: los valores chicos van por valor, en
+ * registros, y los demas por referencia. El kernel copia los bytes con memcpy,
+ * nunca construye ni mueve el elemento
+ */
+template <typename T>
+using item_param_t = std::conditional_t<(sizeof(T) <= sizeof(uint32_t)), T, const T &>;
+
+/**
+ * @brief Cola de N elementos del tipo T
+ */
+template <typename T, UBaseType_t N>
+class Queue {
+    static_assert(std::is_trivially_copyable_v<T>, "la cola copia los bytes del elemento");
+    static_assert(N > 0, "la cola necesita al menos un lugar");
+
+public:
+    using param_t = item_param_t<T>;
+
+    Queue() noexcept : handle_(xQueueCreateStatic(N, sizeof(T), storage_, &control_)) {}
+    Queue(const Queue &) = delete;
+    Queue &operator=(const Queue &) = delete;
+
+    bool send(param_t item, TickType_t ticks = portMAX_DELAY) noexcept {
+        return xQueueSend(handle_, &item, ticks) == pdTRUE;
+    }
+    bool send_to_front(param_t item, TickType_t ticks = portMAX_DELAY) noexcept {
+        return xQueueSendToFront(handle_, &item, ticks) == pdTRUE;
+    }
+    bool receive(T &item, TickType_t ticks = portMAX_DELAY) noexcept {
+        return xQueueReceive(handle_, &item, ticks) == pdTRUE;
+    }
+    bool peek(T &item, TickType_t ticks = 0) noexcept {
+        return xQueuePeek(handle_, &item, ticks) == pdTRUE;
+    }
+
+    // Solo en las colas de un lugar, el ultimo valor reemplaza al anterior
+    void overwrite(param_t item) noexcept {
+        static_assert(N == 1, "overwrite solo en colas de un lugar");
+        xQueueOverwrite(handle_, &item);
+    }
+
+    bool send_from_isr(param_t item, BaseType_t *to_higher_priority_task) noexcept {
+        static_assert(sizeof(T) <= RTOS_ISR_ITEM_MAX, "elemento grande para copiar desde una ISR");
+        return xQueueSendFromISR(handle_, &item, to_higher_priority_task) == pdTRUE;
+    }
+    bool receive_from_isr(T &item, BaseType_t *to_higher_priority_task) noexcept {
+        static_assert(sizeof(T) <= RTOS_ISR_ITEM_MAX, "elemento grande para copiar desde una ISR");
+        return xQueueReceiveFromISR(handle_, &item, to_higher_priority_task) == pdTRUE;
+    }
+    void overwrite_from_isr(param_t item, BaseType_t *to_higher_priority_task) noexcept {
+        static_assert(N == 1, "overwrite solo en colas de un lugar");
+        static_assert(sizeof(T) <= RTOS_ISR_ITEM_MAX, "elemento grande para copiar desde una ISR");
+        xQueueOverwriteFromISR(handle_, &item, to_higher_priority_task);
+    }
+
+    UBaseType_t waiting() const noexcept { return uxQueueMessagesWaiting(handle_); }
+    UBaseType_t spaces() const noexcept { return uxQueueSpacesAvailable(handle_); }
+    void reset() noexcept { xQueueReset(handle_); }
+    QueueHandle_t handle() const noexcept { return handle_; }
+    static constexpr size_t storage_bytes = N * sizeof(T);
+
+private:
+    StaticQueue_t control_;
+    alignas(T) uint8_t storage_[storage_bytes];
+    QueueHandle_t handle_;
+};
+
+/**
+ * @brief Semaforo binario (Max 1) o contador
+ */
+template <UBaseType_t Max = 1, UBaseType_t Initial = 0>
+class Semaphore {
+    static_assert(Max > 0 && Initial <= Max, "cuenta inicial fuera de rango");
+
+public:
+    Semaphore() noexcept : handle_(create()) {}
+    Semaphore(const Semaphore &) = delete;
+    Semaphore &operator=(const Semaphore &) = delete;
+
+    bool take(TickType_t ticks = portMAX_DELAY) noexcept { return xSemaphoreTake(handle_, ticks) == pdTRUE; }
+    bool give() noexcept { return xSemaphoreGive(handle_) == pdTRUE; }
+    bool give_from_isr(BaseType_t *to_higher_priority_task) noexcept {
+        return xSemaphoreGiveFromISR(handle_, to_higher_priority_task) == pdTRUE;
+    }
+    bool take_from_isr(BaseType_t *to_higher_priority_task) noexcept {
+        return xSemaphoreTakeFromISR(handle_, to_higher_priority_task) == pdTRUE;
+    }
+    UBaseType_t count() const noexcept { return uxSemaphoreGetCount(handle_); }
+    SemaphoreHandle_t handle() const noexcept { return handle_; }
+
+private:
+    SemaphoreHandle_t create() noexcept {
+        if constexpr (Max == 1) {
+            SemaphoreHandle_t handle = xSemaphoreCreateBinaryStatic(&control_);
+            if (Initial) { xSemaphoreGive(handle); }
+            return handle;
+        } else {
+            return xSemaphoreCreateCountingStatic(Max, Initial, &control_);
+        }
+    }
+
+    StaticSemaphore_t control_;
+    SemaphoreHandle_t handle_;
+};
+
+/**
+ * @brief Mutex con herencia de prioridad. No tiene variantes para ISR: una ISR
+ * no puede ser duenia de un mutex
+ */
+class Mutex {
+public:
+    Mutex() noexcept : handle_(xSemaphoreCreateMutexStatic(&control_)) {}
+    Mutex(const Mutex &) = delete;
+    Mutex &operator=(const Mutex &) = delete;
+
+    bool lock(TickType_t ticks = portMAX_DELAY) noexcept { return xSemaphoreTake(handle_, ticks) == pdTRUE; }
+    void unlock() noexcept { xSemaphoreGive(handle_); }
+    SemaphoreHandle_t handle() const noexcept { return handle_; }
+
+    /**
+     * @brief Toma el mutex en el bloque y lo devuelve al salir
+     */
+    class Guard {
+    public:
+        explicit Guard(Mutex &mutex) noexcept : mutex_(mutex) { mutex_.lock(); }
+        ~Guard() { mutex_.unlock(); }
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+    private:
+        Mutex &mutex_;
+    };
+
+private:
+    StaticSemaphore_t control_;
+    SemaphoreHandle_t handle_;
+};
+
+/**
+ * @brief Tarea con su stack de StackWords palabras. Se crea con start, en main
+ * o desde otra tarea
+ */
+template <configSTACK_DEPTH_TYPE StackWords>
+class Task {
+    static_assert(StackWords >= configMINIMAL_STACK_SIZE, "stack menor que configMINIMAL_STACK_SIZE");
+
+public:
+    Task() noexcept = default;
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    TaskHandle_t start(TaskFunction_t function, const char *name, UBaseType_t priority, void *params = nullptr) noexcept {
+        handle_ = xTaskCreateStatic(function, name, StackWords, params, priority, stack_, &control_);
+        return handle_;
+    }
+    void notify() noexcept { xTaskNotifyGive(handle_); }
+    void notify_from_isr(BaseType_t *to_higher_priority_task) noexcept { vTaskNotifyGiveFromISR(handle_, to_higher_priority_task); }
+    TaskHandle_t handle() const noexcept { return handle_; }
+    static constexpr configSTACK_DEPTH_TYPE stack_words = StackWords;
+
+private:
+    StaticTask_t control_;
+    StackType_t stack_[StackWords];
+    TaskHandle_t handle_ = nullptr;
+};
+
+/**
+ * @brief Ultimo valor del tipo T sobre el mailbox del workspace: un escritor,
+ * varios lectores, sin entrar al kernel
+ */
+template <typename T>
+class Mailbox {
+    static_assert(std::is_trivially_copyable_v<T>, "el mailbox copia los bytes del valor");
+
+public:
+    using param_t = item_param_t<T>;
+
+    Mailbox() noexcept { mailbox_init(&mb_, buf_, sizeof(T)); }
+    Mailbox(const Mailbox &) = delete;
+    Mailbox &operator=(const Mailbox &) = delete;
+
+    uint32_t write(param_t value) noexcept { return mailbox_write(&mb_, &value); }
+    uint32_t post(param_t value) noexcept { return mailbox_post(&mb_, &value); }
+    uint32_t post_from_isr(param_t value, BaseType_t *to_higher_priority_task) noexcept {
+        static_assert(sizeof(T) <= RTOS_ISR_ITEM_MAX, "valor grande para copiar desde una ISR");
+        return mailbox_post_from_isr(&mb_, &value, to_higher_priority_task);
+    }
+    uint32_t read(T &value) const noexcept { return mailbox_read(&mb_, &value); }
+    uint32_t wait(T &value, uint32_t version, TickType_t ticks = portMAX_DELAY) const noexcept {
+        return mailbox_wait(&mb_, &value, version, ticks);
+    }
+    uint32_t version() const noexcept { return mailbox_version(&mb_); }
+    bool subscribe(TaskHandle_t task) noexcept { return mailbox_subscribe(&mb_, task); }
+
+private:
+    mailbox_t mb_;
+    MAILBOX_BUFFER(buf_, T);
+};
+
+}
+
+#endif
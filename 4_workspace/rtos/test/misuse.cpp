@@ -0,0 +1,45 @@
+#include "rtos.hpp"
+
+// Usos que rtos.hpp rechaza al compilar, uno por cada MISUSE_*. Sin ninguno
+// definido compila, para ver que los errores son de los static_assert
+
+typedef struct {
+    uint32_t words[16];
+} big_t;
+
+struct owner {
+    owner(const owner &other);
+    uint32_t *data;
+};
+
+void misuse(void) {
+    BaseType_t woken = pdFALSE;
+    (void)woken;
+#if defined(MISUSE_NOT_COPYABLE)
+    static rtos::Queue<owner, 2> queue;
+#elif defined(MISUSE_EMPTY)
+    static rtos::Queue<uint32_t, 0> queue;
+#elif defined(MISUSE_OVERWRITE)
+    static rtos::Queue<uint32_t, 2> queue;
+    queue.overwrite(1);
+#elif defined(MISUSE_ISR_BIG)
+    static rtos::Queue<big_t, 2> queue;
+    queue.send_from_isr(big_t{}, &woken);
+#elif defined(MISUSE_MAILBOX_ISR_BIG)
+    static rtos::Mailbox<big_t> mailbox;
+    mailbox.post_from_isr(big_t{}, &woken);
+#elif defined(MISUSE_SEMAPHORE)
+    static rtos::Semaphore<2, 3> semaphore;
+#elif defined(MISUSE_SMALL_STACK)
+    static rtos::Task<configMINIMAL_STACK_SIZE / 2> task;
+#else
+    static rtos::Queue<big_t, 2> queue;
+    static rtos::Queue<uint32_t, 1> latest;
+    static rtos::Mailbox<uint32_t> mailbox;
+    static rtos::Semaphore<2, 2> semaphore;
+    static rtos::Task<configMINIMAL_STACK_SIZE> task;
+    queue.send(big_t{});
+    latest.overwrite_from_isr(1, &woken);
+    mailbox.post_from_isr(1, &woken);
+#endif
+}
@@ -0,0 +1,268 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "check.h"
+#include "rtos.hpp"
+
+// Prioridades: la tarea de la prueba por encima de las otras dos
+#define TEST_PRIORITY   3
+#define READER_PRIORITY 2
+#define LOW_PRIORITY    1
+// Ticks que espera la prueba con la cola llena y con el mutex tomado
+#define TIMEOUT         5
+// Elementos que manda la interrupcion simulada, uno por tick
+#define ISR_ITEMS       8
+// Valores que publica la prueba en el mailbox
+#define POSTS           3
+
+typedef struct {
+    uint16_t raw;
+    float voltage;
+    float temperature;
+} reading_t;
+
+// Mas grande que RTOS_ISR_ITEM_MAX, solo se copia desde tareas
+typedef struct {
+    uint32_t version;
+    uint32_t words[15];
+} big_t;
+
+// Tamanios: el parametro de las copias y la memoria que reserva cada objeto
+static_assert(std::is_same_v<rtos::item_param_t<uint8_t>, uint8_t>);
+static_assert(std::is_same_v<rtos::item_param_t<uint32_t>, uint32_t>);
+static_assert(std::is_same_v<rtos::item_param_t<reading_t>, const reading_t &>);
+static_assert(rtos::Queue<reading_t, 4>::storage_bytes == 4 * sizeof(reading_t));
+static_assert(rtos::Task<256>::stack_words == 256);
+// Sin nada mas que el control del kernel, la memoria y el handle, con a lo sumo el relleno de un puntero
+static_assert(sizeof(rtos::Queue<reading_t, 4>) >= sizeof(StaticQueue_t) + 4 * sizeof(reading_t) + sizeof(QueueHandle_t));
+static_assert(sizeof(rtos::Queue<reading_t, 4>) < sizeof(StaticQueue_t) + 4 * sizeof(reading_t) + 2 * sizeof(QueueHandle_t));
+static_assert(sizeof(rtos::Queue<uint8_t, 3>) < sizeof(StaticQueue_t) + 3 + 2 * sizeof(QueueHandle_t));
+static_assert(sizeof(rtos::Semaphore<>) == sizeof(StaticSemaphore_t) + sizeof(SemaphoreHandle_t));
+static_assert(sizeof(rtos::Semaphore<3, 2>) == sizeof(StaticSemaphore_t) + sizeof(SemaphoreHandle_t));
+static_assert(sizeof(rtos::Mutex) == sizeof(StaticSemaphore_t) + sizeof(SemaphoreHandle_t));
+static_assert(sizeof(rtos::Task<256>) >= sizeof(StaticTask_t) + 256 * sizeof(StackType_t) + sizeof(TaskHandle_t));
+static_assert(sizeof(rtos::Task<256>) < sizeof(StaticTask_t) + 256 * sizeof(StackType_t) + 2 * sizeof(TaskHandle_t));
+static_assert(sizeof(rtos::Mailbox<big_t>) >= sizeof(mailbox_t) + 2 * sizeof(big_t));
+static_assert(sizeof(rtos::Mailbox<big_t>) < sizeof(mailbox_t) + 2 * sizeof(big_t) + sizeof(void *));
+
+static rtos::Queue<reading_t, 4> queue;
+static rtos::Queue<uint32_t, 1> latest;
+static rtos::Queue<uint32_t, ISR_ITEMS> isr_queue;
+static rtos::Semaphore<> isr_semaphore;
+static rtos::Semaphore<3, 2> counting;
+static rtos::Semaphore<> held;
+static rtos::Semaphore<> release;
+static rtos::Mutex mutex;
+static rtos::Mailbox<big_t> mailbox;
+static rtos::Task<2 * configMINIMAL_STACK_SIZE> test_task;
+static rtos::Task<2 * configMINIMAL_STACK_SIZE> reader_task;
+static rtos::Task<configMINIMAL_STACK_SIZE> low_task;
+
+// Reservas en el heap del kernel, tiene que dar cero
+static unsigned mallocs;
+
+// Tick en el que la interrupcion simulada da el semaforo y desde el que manda elementos
+static TickType_t isr_give_tick = portMAX_DELAY;
+static TickType_t isr_send_tick = portMAX_DELAY;
+// Mayor prioridad que tuvo la tarea baja mientras tenia el mutex
+static UBaseType_t low_max_priority;
+static bool low_done;
+
+static uint32_t reader_versions[POSTS];
+static int reader_count;
+static int reader_torn;
+
+extern "C" {
+void *__real_pvPortMalloc(size_t size);
+
+void *__wrap_pvPortMalloc(size_t size) {
+    mallocs++;
+    return __real_pvPortMalloc(size);
+}
+}
+
+// Interrupcion simulada en cada tick: el semaforo, una rafaga a la cola y la prioridad de la tarea baja
+static void isr(void) {
+    BaseType_t woken = pdFALSE;
+    TickType_t now = xTaskGetTickCountFromISR();
+
+    if (now == isr_give_tick) { isr_semaphore.give_from_isr(&woken); }
+    if (now >= isr_send_tick && now - isr_send_tick < ISR_ITEMS) { isr_queue.send_from_isr(now - isr_send_tick, &woken); }
+    if (low_task.handle()) {
+        UBaseType_t priority = uxTaskPriorityGetFromISR(low_task.handle());
+        if (priority > low_max_priority) { low_max_priority = priority; }
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+static bool same(const reading_t &a, const reading_t &b) {
+    return !memcmp(&a, &b, sizeof(a));
+}
+
+// Orden de la cola, llena sin esperar, al frente, peek y la espera con la cola llena
+static void test_queue(void) {
+    reading_t item, readings[5];
+
+    for (int i = 0; i < 5; i++) { readings[i] = { (uint16_t)(100 + i), 0.1f * i, 20.0f + i }; }
+    for (int i = 0; i < 4; i++) { CHECK(queue.send(readings[i], 0)); }
+    CHECK(!queue.send(readings[4], 0));
+    CHECK(!queue.send_to_front(readings[4], 0));
+    CHECK_EQ(queue.waiting(), 4);
+    CHECK_EQ(queue.spaces(), 0);
+
+    // La espera con la cola llena vence a los TIMEOUT ticks justos
+    TickType_t start = xTaskGetTickCount();
+    CHECK(!queue.send(readings[4], TIMEOUT));
+    CHECK_EQ(xTaskGetTickCount() - start, TIMEOUT);
+
+    CHECK(queue.peek(item) && same(item, readings[0]));
+    for (int i = 0; i < 4; i++) { CHECK(queue.receive(item, 0) && same(item, readings[i])); }
+    CHECK(!queue.receive(item, 0));
+
+    CHECK(queue.send(readings[1], 0));
+    CHECK(queue.send_to_front(readings[2], 0));
+    CHECK(queue.receive(item, 0) && same(item, readings[2]));
+    queue.reset();
+    CHECK_EQ(queue.waiting(), 0);
+
+    // La cola de un lugar solo guarda el ultimo valor
+    latest.overwrite(1);
+    latest.overwrite(2);
+    uint32_t value = 0;
+    CHECK_EQ(latest.waiting(), 1);
+    CHECK(latest.receive(value, 0));
+    CHECK_EQ(value, 2);
+}
+
+// Binario y contador: cuenta inicial, tope y las tomas sin esperar
+static void test_semaphore(void) {
+    CHECK_EQ(counting.count(), 2);
+    CHECK(counting.take(0));
+    CHECK(counting.take(0));
+    CHECK(!counting.take(0));
+    for (int i = 0; i < 3; i++) { CHECK(counting.give()); }
+    CHECK(!counting.give());
+    CHECK_EQ(counting.count(), 3);
+
+    CHECK_EQ(isr_semaphore.count(), 0);
+    CHECK(isr_semaphore.give());
+    CHECK(!isr_semaphore.give());
+    CHECK(isr_semaphore.take(0));
+    CHECK(!isr_semaphore.take(0));
+}
+
+// Semaforo y cola desde la interrupcion: la tarea despierta en el tick del aviso
+static void test_isr(void) {
+    uint32_t value;
+
+    isr_give_tick = xTaskGetTickCount() + 3;
+    CHECK(isr_semaphore.take(10));
+    CHECK_EQ(xTaskGetTickCount(), isr_give_tick);
+
+    isr_send_tick = xTaskGetTickCount() + 1;
+    for (uint32_t i = 0; i < ISR_ITEMS; i++) {
+        CHECK(isr_queue.receive(value, 2 * ISR_ITEMS));
+        CHECK_EQ(value, i);
+        CHECK_EQ(xTaskGetTickCount(), isr_send_tick + i);
+    }
+    CHECK(!isr_queue.receive(value, 2));
+}
+
+// Tarea baja: toma el mutex con un Guard y lo tiene hasta que la prueba la libera
+static void task_low(void *params) {
+    (void)params;
+    {
+        rtos::Mutex::Guard guard(mutex);
+        held.give();
+        release.take();
+    }
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    low_done = true;
+    vTaskSuspend(NULL);
+}
+
+/**
+ * @brief Herencia de prioridad: mientras la prueba espera el mutex la tarea baja
+ * corre con la prioridad de la prueba, y la pierde al vencer la espera
+ */
+static void test_mutex(void) {
+    low_task.start(task_low, "Low", LOW_PRIORITY);
+    CHECK(held.take(10));
+
+    low_max_priority = 0;
+    TickType_t start = xTaskGetTickCount();
+    CHECK(!mutex.lock(TIMEOUT));
+    CHECK_EQ(xTaskGetTickCount() - start, TIMEOUT);
+    printf("mutex: prioridad de la tarea baja %u mientras la prueba espera, %u despues\n",
+           (unsigned)low_max_priority, (unsigned)uxTaskPriorityGet(low_task.handle()));
+    CHECK_EQ(low_max_priority, TEST_PRIORITY);
+    CHECK_EQ(uxTaskPriorityGet(low_task.handle()), LOW_PRIORITY);
+
+    // El Guard devuelve el mutex al salir del bloque
+    release.give();
+    CHECK(mutex.lock(TIMEOUT));
+    mutex.unlock();
+
+    low_task.notify();
+    vTaskDelay(1);
+    CHECK(low_done);
+}
+
+// Lector suscripto al mailbox que espera cada valor nuevo
+static void task_reader(void *params) {
+    uint32_t version = 0;
+    big_t value;
+    (void)params;
+
+    while (reader_count < POSTS) {
+        uint32_t read = mailbox.wait(value, version, 10);
+        if (!read) { break; }
+        bool whole = value.version == read;
+        for (uint32_t i = 0; i < 15; i++) { whole = whole && value.words[i] == read * 1000 + i; }
+        if (!whole) { reader_torn++; }
+        reader_versions[reader_count++] = read;
+        version = read;
+    }
+    vTaskSuspend(NULL);
+}
+
+// Mailbox: la tarea suscripta ve cada valor publicado, completo
+static void test_mailbox(void) {
+    big_t value;
+
+    CHECK(mailbox.subscribe(reader_task.start(task_reader, "Reader", READER_PRIORITY)));
+    CHECK_EQ(mailbox.read(value), 0);
+    for (uint32_t version = 1; version <= POSTS; version++) {
+        value.version = version;
+        for (uint32_t i = 0; i < 15; i++) { value.words[i] = version * 1000 + i; }
+        CHECK_EQ(mailbox.post(value), version);
+        vTaskDelay(1);
+    }
+    CHECK_EQ(reader_count, POSTS);
+    for (int i = 0; i < POSTS; i++) { CHECK_EQ(reader_versions[i], (uint32_t)i + 1); }
+    CHECK_EQ(reader_torn, 0);
+    CHECK_EQ(mailbox.version(), POSTS);
+}
+
+static void task_test(void *params) {
+    (void)params;
+    test_queue();
+    test_semaphore();
+    test_isr();
+    test_mutex();
+    test_mailbox();
+    vTaskEndScheduler();
+}
+
+int main(void) {
+    host_port_isr = isr;
+    host_port_tick_limit = 1000;
+    CHECK(test_task.start(task_test, "Test", TEST_PRIORITY) != nullptr);
+    vTaskStartScheduler();
+    CHECK(!host_port_timed_out);
+    // Los objetos, las tareas, la ociosa y la de los timers tienen su memoria reservada al compilar
+    printf("reservas en el heap del kernel: %u\n", mallocs);
+    CHECK_EQ(mallocs, 0);
+    return check_result("rtos");
+}
@@ -0,0 +1,57 @@
+#ifndef _SEQLOCK_H_
+#define _SEQLOCK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Contador de secuencia para datos con un unico escritor. El escritor
+ * lo deja impar mientras modifica los datos; el lector copia los datos y
+ * reintenta si el contador cambio en el medio. Leer no bloquea al escritor
+ */
+typedef struct {
+    volatile uint32_t seq;
+} seqlock_t;
+
+/**
+ * @brief Comienza una lectura
+ * @param lock puntero al seqlock
+ * @return secuencia a pasar a seqlock_read_retry
+ */
+static inline uint32_t seqlock_read_begin(const seqlock_t *lock) {
+    uint32_t seq;
+    // Impar: el escritor esta en el otro nucleo, termina en pocos ciclos
+    while ((seq = __atomic_load_n(&lock->seq, __ATOMIC_ACQUIRE)) & 1);
+    return seq;
+}
+
+/**
+ * @brief Termina una lectura
+ * @param lock puntero al seqlock
+ * @param seq valor devuelto por seqlock_read_begin
+ * @return true si los datos cambiaron durante la lectura y hay que repetirla
+ */
+static inline bool seqlock_read_retry(const seqlock_t *lock, uint32_t seq) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&lock->seq, __ATOMIC_RELAXED) != seq;
+}
+
+/**
+ * @brief Comienza una escritura. En un mismo nucleo debe hacerse dentro de una
+ * seccion critica, asi un lector de mayor prioridad nunca ve la secuencia impar
+ * @param lock puntero al seqlock
+ */
+static inline void seqlock_write_begin(seqlock_t *lock) {
+    __atomic_store_n(&lock->seq, lock->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Termina una escritura
+ * @param lock puntero al seqlock
+ */
+static inline void seqlock_write_end(seqlock_t *lock) {
+    __atomic_store_n(&lock->seq, lock->seq + 1, __ATOMIC_RELEASE);
+}
+
+#endif
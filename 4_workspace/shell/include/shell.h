@@ -0,0 +1,76 @@
+#ifndef _SHELL_H_
+#define _SHELL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "seqlock.h"
+
+// Largo maximo de una linea de comando
+#define SHELL_LINE_MAX      64
+// Cantidad maxima de palabras de una linea, incluido el comando
+#define SHELL_MAX_ARGS      4
+// Largo maximo de una respuesta
+#define SHELL_OUTPUT_MAX    64
+// Tamaño maximo de la estructura de configuracion
+#define SHELL_CONFIG_MAX    64
+
+typedef struct shell shell_t;
+
+/**
+ * @brief Comando de la tabla
+ */
+typedef struct {
+    const char *name;                                           // Nombre del comando
+    const char *help;                                           // Descripcion breve
+    void (*handler)(shell_t *sh, int argc, char *argv[]);       // Funcion que lo ejecuta
+} shell_command_t;
+
+/**
+ * @brief Tipos de parametros
+ */
+typedef enum {
+    SHELL_PARAM_FLOAT,
+    SHELL_PARAM_UINT
+} shell_param_type_t;
+
+/**
+ * @brief Parametro ajustable, un campo de la estructura de configuracion
+ */
+typedef struct {
+    const char *name;           // Nombre del parametro
+    shell_param_type_t type;    // float o uint32_t
+    size_t offset;              // offsetof del campo en la configuracion
+    float min;                  // Valor minimo aceptado
+    float max;                  // Valor maximo aceptado
+} shell_param_t;
+
+/**
+ * @brief Estado del interprete, sin memoria dinamica
+ */
+struct shell {
+    const shell_command_t *commands;    // Tabla de comandos
+    size_t command_count;
+    const shell_param_t *params;        // Tabla de parametros
+    size_t param_count;
+    void *config;                       // Estructura de configuracion
+    size_t config_size;
+    seqlock_t *lock;                    // Protege la configuracion
+    void (*output)(const char *text);   // Salida de las respuestas, una linea por llamado
+    char line[SHELL_LINE_MAX + 1];      // Linea en edicion
+    size_t len;
+    bool overflow;                      // La linea actual supero SHELL_LINE_MAX
+};
+
+// Prototipos de funciones
+void shell_init(shell_t *sh, const shell_command_t *commands, size_t command_count, void (*output)(const char *text));
+bool shell_set_params(shell_t *sh, const shell_param_t *params, size_t param_count, void *config, size_t config_size, seqlock_t *lock);
+void shell_input(shell_t *sh, char c);
+void shell_execute(shell_t *sh, char *line);
+void shell_printf(shell_t *sh, const char *format, ...);
+void shell_config_read(const shell_t *sh, void *dst);
+void shell_config_write(shell_t *sh, size_t offset, const void *value, size_t size);
+bool shell_start(shell_t *sh, uint32_t priority);
+
+#endif
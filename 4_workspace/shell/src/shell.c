@@ -0,0 +1,255 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "shell.h"
+
+/**
+ * @brief Inicializa el interprete
+ * @param sh puntero al interprete
+ * @param commands tabla de comandos propios
+ * @param command_count cantidad de comandos
+ * @param output funcion que envia una linea de respuesta
+ */
+void shell_init(shell_t *sh, const shell_command_t *commands, size_t command_count, void (*output)(const char *text)) {
+    sh->commands = commands;
+    sh->command_count = command_count;
+    sh->params = NULL;
+    sh->param_count = 0;
+    sh->config = NULL;
+    sh->config_size = 0;
+    sh->lock = NULL;
+    sh->output = output;
+    sh->len = 0;
+    sh->overflow = false;
+}
+
+/**
+ * @brief Asocia una estructura de configuracion para los comandos get y set
+ * @param sh puntero al interprete
+ * @param params tabla de parametros
+ * @param param_count cantidad de parametros
+ * @param config estructura de configuracion
+ * @param config_size tamaño de la estructura
+ * @param lock seqlock que protege la estructura
+ * @return false si la estructura supera SHELL_CONFIG_MAX
+ */
+bool shell_set_params(shell_t *sh, const shell_param_t *params, size_t param_count, void *config, size_t config_size, seqlock_t *lock) {
+    if (config_size > SHELL_CONFIG_MAX) { return false; }
+    sh->params = params;
+    sh->param_count = param_count;
+    sh->config = config;
+    sh->config_size = config_size;
+    sh->lock = lock;
+    return true;
+}
+
+/**
+ * @brief Envia una linea de respuesta con formato, recortada a SHELL_OUTPUT_MAX
+ * @param sh puntero al interprete
+ * @param format formato de printf
+ */
+void shell_printf(shell_t *sh, const char *format, ...) {
+    char text[SHELL_OUTPUT_MAX + 1];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    sh->output(text);
+}
+
+/**
+ * @brief Copia la configuracion completa y consistente. No bloquea al escritor
+ * @param sh puntero al interprete
+ * @param dst destino de config_size bytes
+ */
+void shell_config_read(const shell_t *sh, void *dst) {
+    uint32_t seq;
+    do {
+        seq = seqlock_read_begin(sh->lock);
+        memcpy(dst, sh->config, sh->config_size);
+    } while (seqlock_read_retry(sh->lock, seq));
+}
+
+/**
+ * @brief Busca un parametro por nombre
+ * @param sh puntero al interprete
+ * @param name nombre del parametro
+ * @return puntero al parametro o NULL si no existe
+ */
+static const shell_param_t *shell_find_param(const shell_t *sh, const char *name) {
+    for (size_t i = 0; i < sh->param_count; i++) {
+        if (!strcmp(sh->params[i].name, name)) { return &sh->params[i]; }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Muestra el valor de un parametro
+ * @param sh puntero al interprete
+ * @param param puntero al parametro
+ * @param config copia de la configuracion
+ */
+static void shell_print_param(shell_t *sh, const shell_param_t *param, const uint8_t *config) {
+    if (param->type == SHELL_PARAM_FLOAT) {
+        float value;
+        memcpy(&value, config + param->offset, sizeof(value));
+        shell_printf(sh, "%s = %g", param->name, value);
+    } else {
+        uint32_t value;
+        memcpy(&value, config + param->offset, sizeof(value));
+        shell_printf(sh, "%s = %lu", param->name, (unsigned long)value);
+    }
+}
+
+/**
+ * @brief Comando get: muestra un parametro o todos
+ * @param sh puntero al interprete
+ * @param argc cantidad de palabras
+ * @param argv palabras de la linea
+ */
+static void shell_cmd_get(shell_t *sh, int argc, char *argv[]) {
+    uint8_t config[SHELL_CONFIG_MAX];
+    shell_config_read(sh, config);
+
+    if (argc < 2) {
+        for (size_t i = 0; i < sh->param_count; i++) { shell_print_param(sh, &sh->params[i], config); }
+        return;
+    }
+    const shell_param_t *param = shell_find_param(sh, argv[1]);
+    if (!param) {
+        shell_printf(sh, "error: parametro %s desconocido", argv[1]);
+        return;
+    }
+    shell_print_param(sh, param, config);
+}
+
+/**
+ * @brief Comando set: valida y cambia un parametro
+ * @param sh puntero al interprete
+ * @param argc cantidad de palabras
+ * @param argv palabras de la linea
+ */
+static void shell_cmd_set(shell_t *sh, int argc, char *argv[]) {
+    if (argc != 3) {
+        sh->output("uso: set <parametro> <valor>");
+        return;
+    }
+    const shell_param_t *param = shell_find_param(sh, argv[1]);
+    if (!param) {
+        shell_printf(sh, "error: parametro %s desconocido", argv[1]);
+        return;
+    }
+
+    // Todo el texto tiene que ser un numero
+    char *end;
+    float value = strtof(argv[2], &end);
+    if (end == argv[2] || *end || !(value >= param->min && value <= param->max)) {
+        shell_printf(sh, "error: %s fuera de rango [%g, %g]", argv[2], param->min, param->max);
+        return;
+    }
+
+    if (param->type == SHELL_PARAM_FLOAT) {
+        shell_config_write(sh, param->offset, &value, sizeof(value));
+    } else {
+        uint32_t integer = (uint32_t)value;
+        if (integer != value) {
+            shell_printf(sh, "error: %s debe ser entero", argv[2]);
+            return;
+        }
+        shell_config_write(sh, param->offset, &integer, sizeof(integer));
+    }
+    shell_printf(sh, "ok %s", param->name);
+}
+
+/**
+ * @brief Comando help: lista los comandos
+ * @param sh puntero al interprete
+ * @param argc cantidad de palabras
+ * @param argv palabras de la linea
+ */
+static void shell_cmd_help(shell_t *sh, int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+    sh->output("help: esta ayuda");
+    if (sh->param_count) {
+        sh->output("get [parametro]: muestra la configuracion");
+        sh->output("set <parametro> <valor>: cambia la configuracion");
+    }
+    for (size_t i = 0; i < sh->command_count; i++) {
+        shell_printf(sh, "%s: %s", sh->commands[i].name, sh->commands[i].help);
+    }
+}
+
+// Comandos propios del interprete
+static const shell_command_t builtins[] = {
+    { "help", "", shell_cmd_help },
+    { "get", "", shell_cmd_get },
+    { "set", "", shell_cmd_set }
+};
+
+/**
+ * @brief Separa la linea en palabras y ejecuta el comando. Modifica la linea
+ * @param sh puntero al interprete
+ * @param line linea terminada en cero
+ */
+void shell_execute(shell_t *sh, char *line) {
+    char *argv[SHELL_MAX_ARGS];
+    int argc = 0;
+
+    // Las palabras quedan apuntando dentro de la misma linea
+    while (*line) {
+        while (*line == ' ' || *line == '\t') { *line++ = '\0'; }
+        if (!*line) { break; }
+        if (argc == SHELL_MAX_ARGS) {
+            sh->output("error: demasiados argumentos");
+            return;
+        }
+        argv[argc++] = line;
+        while (*line && *line != ' ' && *line != '\t') { line++; }
+    }
+    if (!argc) { return; }
+
+    for (size_t i = 0; i < sizeof(builtins) / sizeof(builtins[0]); i++) {
+        // get y set solo existen si hay configuracion
+        if (i && !sh->param_count) { break; }
+        if (!strcmp(argv[0], builtins[i].name)) {
+            builtins[i].handler(sh, argc, argv);
+            return;
+        }
+    }
+    for (size_t i = 0; i < sh->command_count; i++) {
+        if (!strcmp(argv[0], sh->commands[i].name)) {
+            sh->commands[i].handler(sh, argc, argv);
+            return;
+        }
+    }
+    shell_printf(sh, "error: comando %s desconocido", argv[0]);
+}
+
+/**
+ * @brief Procesa un caracter recibido. Al llegar el fin de linea ejecuta el comando
+ * @param sh puntero al interprete
+ * @param c caracter
+ */
+void shell_input(shell_t *sh, char c) {
+    if (c == '\r' || c == '\n') {
+        if (sh->overflow) {
+            sh->output("error: linea demasiado larga");
+        } else if (sh->len) {
+            sh->line[sh->len] = '\0';
+            shell_execute(sh, sh->line);
+        }
+        sh->len = 0;
+        sh->overflow = false;
+    } else if (c == '\b' || c == 0x7F) {
+        if (sh->len) { sh->len--; }
+    } else if (c >= ' ' && c <= '~') {
+        // Los caracteres que no entran se descartan hasta el fin de linea
+        if (sh->len < SHELL_LINE_MAX) {
+            sh->line[sh->len++] = c;
+        } else {
+            sh->overflow = true;
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#include <string.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "shell.h"
+
+// Los tamaños de stack que genera stack_usage.py reemplazan a los de la biblioteca
+#if __has_include("task_stacks.h")
+#include "task_stacks.h"
+#endif
+
+// Stack de la tarea del interprete
+#ifndef SHELL_TASK_STACK
+#define SHELL_TASK_STACK    (configMINIMAL_STACK_SIZE + 256)
+#endif
+
+// Tarea del interprete
+static TaskHandle_t shell_handle = NULL;
+
+/**
+ * @brief Callback de stdio cuando llegan caracteres, se ejecuta en interrupcion
+ * @param param sin uso
+ */
+static void shell_chars_available(void *param) {
+    BaseType_t to_higher_priority_task = pdFALSE;
+    vTaskNotifyGiveFromISR(shell_handle, &to_higher_priority_task);
+    portYIELD_FROM_ISR(to_higher_priority_task);
+}
+
+/**
+ * @brief Tarea del interprete. Duerme hasta que llegan caracteres, sin sondear
+ * @param pvParameters puntero al interprete
+ */
+static void shell_task(void *pvParameters) {
+    shell_t *sh = pvParameters;
+    int c;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+            shell_input(sh, (char)c);
+        }
+    }
+}
+
+/**
+ * @brief Escribe un campo de la configuracion. La seccion critica es de unos
+ * pocos ciclos y evita que una tarea lectora de mayor prioridad espere al escritor
+ * @param sh puntero al interprete
+ * @param offset offset del campo
+ * @param value nuevo valor
+ * @param size tamaño del campo
+ */
+void shell_config_write(shell_t *sh, size_t offset, const void *value, size_t size) {
+    taskENTER_CRITICAL();
+    seqlock_write_begin(sh->lock);
+    memcpy((uint8_t *)sh->config + offset, value, size);
+    seqlock_write_end(sh->lock);
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Crea la tarea del interprete y la asocia a la entrada de stdio
+ * @param sh puntero al interprete, debe seguir existiendo
+ * @param priority prioridad de la tarea, menor que las de control
+ * @return true si se pudo crear la tarea
+ */
+bool shell_start(shell_t *sh, uint32_t priority) {
+    if (xTaskCreate(shell_task, "Shell", SHELL_TASK_STACK, sh, priority, &shell_handle) != pdPASS) {
+        return false;
+    }
+    stdio_set_chars_available_callback(shell_chars_available, NULL);
+    return true;
+}
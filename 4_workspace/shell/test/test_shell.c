@@ -0,0 +1,311 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "check.h"
+#include "shell.h"
+
+// Respuestas guardadas para comparar, las de una linea de comando entran de sobra
+#define LOG_LINES       16
+
+typedef struct {
+    float setpoint;
+    uint32_t period_ms;
+} config_t;
+
+static config_t config;
+static seqlock_t config_lock;
+static shell_t shell;
+
+static const shell_param_t params[] = {
+    { "setpoint", SHELL_PARAM_FLOAT, offsetof(config_t, setpoint), -40.0f, 85.0f },
+    { "period_ms", SHELL_PARAM_UINT, offsetof(config_t, period_ms), 100.0f, 60000.0f }
+};
+
+// Respuestas recibidas desde el ultimo log_clear
+static char log_text[LOG_LINES][SHELL_OUTPUT_MAX + 1];
+static int log_count;
+static size_t log_longest;
+
+// Palabras recibidas por el comando x en su ultimo llamado
+static char x_argv[SHELL_MAX_ARGS][SHELL_LINE_MAX + 1];
+static int x_argc;
+static int x_calls;
+
+// Generador congruencial, la secuencia de caracteres es siempre la misma
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+/**
+ * @brief En la placa escribe dentro de una seccion critica (shell_task.c). En la
+ * PC hay un solo hilo y alcanza con el seqlock
+ */
+void shell_config_write(shell_t *sh, size_t offset, const void *value, size_t size) {
+    seqlock_write_begin(sh->lock);
+    memcpy((uint8_t *)sh->config + offset, value, size);
+    seqlock_write_end(sh->lock);
+}
+
+static void output(const char *text) {
+    size_t len = strlen(text);
+    if (len > log_longest) { log_longest = len; }
+    if (log_count < LOG_LINES) { strcpy(log_text[log_count], text); }
+    log_count++;
+}
+
+static void log_clear(void) {
+    log_count = 0;
+}
+
+// Comando de prueba: guarda las palabras que recibe
+static void cmd_x(shell_t *sh, int argc, char *argv[]) {
+    (void)sh;
+    x_argc = argc;
+    for (int i = 0; i < argc; i++) { strcpy(x_argv[i], argv[i]); }
+    x_calls++;
+}
+
+static void cmd_long(shell_t *sh, int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+    shell_printf(sh, "%0*d", 3 * SHELL_OUTPUT_MAX, 7);
+}
+
+static const shell_command_t commands[] = {
+    { "x", "guarda las palabras", cmd_x },
+    { "long", "respuesta demasiado larga", cmd_long }
+};
+
+static void setup(bool with_params) {
+    config.setpoint = 25.0f;
+    config.period_ms = 1000;
+    config_lock.seq = 0;
+    shell_init(&shell, commands, 2, output);
+    if (with_params) { shell_set_params(&shell, params, 2, &config, sizeof(config), &config_lock); }
+    log_clear();
+    x_calls = 0;
+}
+
+static void type(const char *text) {
+    while (*text) { shell_input(&shell, *text++); }
+}
+
+// Ejecuta una linea completa y devuelve la primera respuesta
+static const char *run(const char *line) {
+    log_clear();
+    type(line);
+    shell_input(&shell, '\r');
+    return log_count ? log_text[0] : "";
+}
+
+static void test_commands(void) {
+    setup(false);
+    run("help");
+    CHECK_EQ(log_count, 3);                                 // Sin parametros no hay get ni set
+    CHECK(!strcmp(log_text[1], "x: guarda las palabras"));
+    CHECK(!strcmp(run("get"), "error: comando get desconocido"));
+
+    setup(true);
+    run("help");
+    CHECK_EQ(log_count, 5);
+    CHECK(!strcmp(run("nada 1 2"), "error: comando nada desconocido"));
+
+    // Espacios al principio, en el medio y al final
+    run("  x  a b ");
+    CHECK_EQ(x_calls, 1);
+    CHECK_EQ(x_argc, 3);
+    CHECK(!strcmp(x_argv[1], "a") && !strcmp(x_argv[2], "b"));
+
+    // shell_input descarta los tabuladores, shell_execute tambien los separa
+    char tabs[] = "\tx\ta \tb\t";
+    log_clear();
+    shell_execute(&shell, tabs);
+    CHECK_EQ(x_calls, 2);
+    CHECK_EQ(x_argc, 3);
+    CHECK(!strcmp(x_argv[1], "a") && !strcmp(x_argv[2], "b"));
+    CHECK(!strcmp(run("x\ta"), "error: comando xa desconocido"));
+    CHECK(!strcmp(run("x 1 2 3 4"), "error: demasiados argumentos"));
+    CHECK_EQ(x_calls, 2);
+    run("   ");
+    CHECK_EQ(log_count, 0);
+
+    // Las respuestas se recortan a SHELL_OUTPUT_MAX
+    CHECK_EQ(strlen(run("long")), SHELL_OUTPUT_MAX);
+}
+
+static void test_params(void) {
+    setup(true);
+    CHECK(!strcmp(run("set setpoint 27.5"), "ok setpoint"));
+    CHECK(config.setpoint == 27.5f);
+    CHECK_EQ(config_lock.seq, 2);
+    CHECK(!strcmp(run("get setpoint"), "setpoint = 27.5"));
+    run("get");
+    CHECK_EQ(log_count, 2);
+    CHECK(!strcmp(log_text[1], "period_ms = 1000"));
+
+    CHECK(!strcmp(run("set period_ms 10"), "error: 10 fuera de rango [100, 60000]"));
+    CHECK(!strcmp(run("set period_ms 150.5"), "error: 150.5 debe ser entero"));
+    CHECK(!strcmp(run("set setpoint 20x"), "error: 20x fuera de rango [-40, 85]"));
+    CHECK(!strcmp(run("set setpoint nan"), "error: nan fuera de rango [-40, 85]"));
+    CHECK(!strcmp(run("set setpoint"), "uso: set <parametro> <valor>"));
+    CHECK(!strcmp(run("set otro 1"), "error: parametro otro desconocido"));
+    CHECK(!strcmp(run("get otro"), "error: parametro otro desconocido"));
+    CHECK(config.setpoint == 27.5f && config.period_ms == 1000);
+
+    CHECK(!strcmp(run("set period_ms 60000"), "ok period_ms"));
+    CHECK_EQ(config.period_ms, 60000);
+}
+
+static void test_editing(void) {
+    char line[SHELL_LINE_MAX + 2];
+
+    setup(true);
+    // Borrado con backspace y DEL, y de mas sobre la linea vacia
+    run("\b\bxy\b z\x7F" "a");
+    CHECK_EQ(x_calls, 1);
+    CHECK_EQ(x_argc, 2);
+    CHECK(!strcmp(x_argv[1], "a"));
+
+    // Una linea de SHELL_LINE_MAX caracteres entra, una mas larga se descarta completa
+    memset(line, 'a', sizeof(line));
+    line[0] = 'x';
+    line[1] = ' ';
+    line[SHELL_LINE_MAX] = '\0';
+    run(line);
+    CHECK_EQ(x_calls, 2);
+    CHECK_EQ(strlen(x_argv[1]), SHELL_LINE_MAX - 2);
+    line[SHELL_LINE_MAX] = 'a';
+    line[SHELL_LINE_MAX + 1] = '\0';
+    CHECK(!strcmp(run(line), "error: linea demasiado larga"));
+    CHECK_EQ(x_calls, 2);
+
+    // Los caracteres de control se ignoran y CR LF no ejecuta dos veces
+    run("x\x01\x1b b\xff");
+    CHECK_EQ(x_calls, 3);
+    CHECK(!strcmp(x_argv[1], "b"));
+    shell_input(&shell, '\n');
+    CHECK_EQ(log_count, 0);
+    CHECK_EQ(x_calls, 3);
+}
+
+/**
+ * @brief Caracter al azar, con mas peso en los que cambian el estado del parser
+ */
+static char random_char(void) {
+    static const char pool[] = "xxxx  \t\t\r\n\b\x7F" "ab1";
+    uint32_t r = next_random();
+    if (r % 8 == 0) { return (char)(next_random() & 0xFF); }
+    return pool[r % (sizeof(pool) - 1)];
+}
+
+/**
+ * @brief Fuzz del parser: cada caracter al azar se pasa al interprete y a un modelo
+ * simple de la edicion de linea y la separacion en palabras. Al terminar cada linea
+ * las respuestas y las palabras que recibe el comando tienen que coincidir
+ */
+static void test_fuzz(void) {
+    char model[4 * SHELL_LINE_MAX];
+    size_t len = 0;
+    bool overflow = false;
+    int lines = 0, executed = 0, errors = 0;
+
+    setup(true);
+    log_longest = 0;
+    for (int i = 0; i < 2000000; i++) {
+        char c = random_char();
+        int calls = x_calls;
+
+        log_clear();
+        shell_input(&shell, c);
+
+        if (c == '\r' || c == '\n') {
+            char *argv[16];
+            int argc = 0;
+
+            model[len] = '\0';
+            for (char *word = strtok(model, " \t"); word; word = strtok(NULL, " \t")) {
+                if (argc < 16) { argv[argc] = word; }
+                argc++;
+            }
+            lines++;
+            if (overflow) {
+                CHECK_EQ(log_count, 1);
+                CHECK(!strcmp(log_text[0], "error: linea demasiado larga"));
+                CHECK_EQ(x_calls, calls);
+                errors++;
+            } else if (argc > SHELL_MAX_ARGS) {
+                CHECK_EQ(log_count, 1);
+                CHECK(!strcmp(log_text[0], "error: demasiados argumentos"));
+                CHECK_EQ(x_calls, calls);
+                errors++;
+            } else if (argc && !strcmp(argv[0], "x")) {
+                CHECK_EQ(log_count, 0);
+                CHECK_EQ(x_calls, calls + 1);
+                CHECK_EQ(x_argc, argc);
+                for (int j = 0; j < argc && j < x_argc; j++) { CHECK(!strcmp(x_argv[j], argv[j])); }
+                executed++;
+            } else if (argc) {
+                CHECK_EQ(x_calls, calls);
+                CHECK(log_count >= 1);
+            } else {
+                CHECK_EQ(log_count, 0);
+            }
+            len = 0;
+            overflow = false;
+        } else {
+            CHECK_EQ(log_count, 0);
+            if (c == '\b' || c == 0x7F) {
+                if (len) { len--; }
+            } else if (c >= ' ' && c <= '~') {
+                if (len < SHELL_LINE_MAX) { model[len++] = c; } else { overflow = true; }
+            }
+        }
+        CHECK_EQ(shell.len, len);
+        if (check_failures > 20) { break; }
+    }
+    printf("fuzz: %d lineas, %d ejecutadas, %d con error, respuesta mas larga %zu\n",
+           lines, executed, errors, log_longest);
+    CHECK(executed > 1000 && errors > 1000);
+    CHECK(log_longest <= SHELL_OUTPUT_MAX);
+}
+
+/**
+ * @brief Fuzz de set: valores al azar nunca dejan la configuracion fuera de rango
+ */
+static void test_fuzz_set(void) {
+    static const char *values[] = { "0", "-40", "85", "85.0001", "1e2", "1e9", "-0", "0x20", "inf",
+                                    "-inf", "nan", "4294967296", "100.5", "  ", "1e-40", "." };
+    char line[SHELL_LINE_MAX + 1];
+    int accepted = 0;
+
+    setup(true);
+    for (int i = 0; i < 100000; i++) {
+        const char *name = next_random() & 1 ? "setpoint" : "period_ms";
+        const char *value = values[next_random() % (sizeof(values) / sizeof(values[0]))];
+        if (next_random() & 1) {
+            snprintf(line, sizeof(line), "set %s %s", name, value);
+        } else {
+            // Numero al azar con signo, entero o con decimales
+            snprintf(line, sizeof(line), "set %s %d.%u", name, (int)(next_random() % 140000) - 70000, next_random() % 4);
+        }
+        if (!strncmp(run(line), "ok", 2)) { accepted++; }
+        CHECK(config.setpoint >= -40.0f && config.setpoint <= 85.0f);
+        CHECK(config.period_ms >= 100 && config.period_ms <= 60000);
+        CHECK_EQ(config_lock.seq & 1, 0);
+    }
+    printf("set: %d de 100000 aceptados\n", accepted);
+    CHECK(accepted > 1000);
+}
+
+int main(void) {
+    test_commands();
+    test_params();
+    test_editing();
+    test_fuzz();
+    test_fuzz_set();
+    return check_result("shell");
+}
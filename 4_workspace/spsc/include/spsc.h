@@ -0,0 +1,218 @@
+#ifndef _SPSC_H_
+#define _SPSC_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Separacion entre los indices del productor y del consumidor. El RP2040 y el
+// RP2350 no tienen cache de datos, alcanza con una palabra; en la PC se separan
+// en lineas de cache distintas para que los dos hilos no se invaliden entre si
+#ifndef SPSC_CACHE_LINE
+#if PICO_ON_DEVICE
+#define SPSC_CACHE_LINE     4
+#else
+#define SPSC_CACHE_LINE     64
+#endif
+#endif
+
+// Indice de notificacion que usa spsc_pop_wait
+#ifndef SPSC_NOTIFY_INDEX
+#define SPSC_NOTIFY_INDEX   2
+#endif
+
+// Declara el buffer de datos de un ring de 2^bits elementos del tipo indicado
+#define SPSC_BUFFER(name, type, bits)   type name[1u << (bits)] __attribute__((aligned(SPSC_CACHE_LINE)))
+
+/**
+ * @brief Buffer circular sin bloqueos para un productor y un consumidor
+ * (por ejemplo, una ISR y una tarea). Los indices crecen libremente y se
+ * enmascaran al acceder, asi lleno y vacio se distinguen sin perder un lugar
+ */
+typedef struct {
+    // Lado del productor
+    volatile uint32_t head __attribute__((aligned(SPSC_CACHE_LINE)));     // Proximo lugar a escribir
+    uint32_t tail_cache;                // Ultimo tail leido, evita leer el del consumidor en cada push
+    // Lado del consumidor
+    volatile uint32_t tail __attribute__((aligned(SPSC_CACHE_LINE)));     // Proximo lugar a leer
+    uint32_t head_cache;                // Ultimo head leido
+    // Constantes
+    uint8_t *buf __attribute__((aligned(SPSC_CACHE_LINE)));
+    uint32_t mask;                      // Capacidad menos uno
+    size_t item_size;                   // Bytes por elemento
+    void *consumer;                     // Tarea a notificar (TaskHandle_t) o NULL
+} spsc_t;
+
+/**
+ * @brief Inicializa un ring vacio
+ * @param r puntero al ring
+ * @param buf buffer de capacity elementos (ver SPSC_BUFFER)
+ * @param item_size bytes por elemento
+ * @param capacity cantidad de elementos, potencia de dos
+ * @return false si la capacidad no es potencia de dos
+ */
+static inline bool spsc_init(spsc_t *r, void *buf, size_t item_size, uint32_t capacity) {
+    if (!capacity || (capacity & (capacity - 1))) { return false; }
+    r->head = r->tail = 0;
+    r->tail_cache = r->head_cache = 0;
+    r->buf = buf;
+    r->mask = capacity - 1;
+    r->item_size = item_size;
+    r->consumer = NULL;
+    return true;
+}
+
+/**
+ * @brief Copia elementos entre el ring y un arreglo, partiendo la copia en dos
+ * si da la vuelta al final del buffer
+ * @param r puntero al ring
+ * @param index indice libre del primer elemento
+ * @param data arreglo de count elementos
+ * @param count cantidad de elementos
+ * @param to_ring true para escribir en el ring
+ */
+static inline void spsc_copy(spsc_t *r, uint32_t index, void *data, uint32_t count, bool to_ring) {
+    uint32_t start = index & r->mask;
+    uint32_t first = r->mask + 1 - start;
+    if (first > count) { first = count; }
+    uint8_t *slot = r->buf + start * r->item_size;
+    uint8_t *rest = (uint8_t *)data + first * r->item_size;
+
+    if (to_ring) {
+        memcpy(slot, data, first * r->item_size);
+        if (count > first) { memcpy(r->buf, rest, (count - first) * r->item_size); }
+    } else {
+        memcpy(data, slot, first * r->item_size);
+        if (count > first) { memcpy(rest, r->buf, (count - first) * r->item_size); }
+    }
+}
+
+/**
+ * @brief Agrega elementos, solo desde el productor. Si no entran todos, agrega
+ * los que entran
+ * @param r puntero al ring
+ * @param src elementos a agregar
+ * @param count cantidad de elementos
+ * @return elementos agregados
+ */
+static inline uint32_t spsc_push(spsc_t *r, const void *src, uint32_t count) {
+    uint32_t head = r->head;
+    uint32_t capacity = r->mask + 1;
+
+    // Solo se lee el indice del consumidor si el ultimo valor visto no alcanza
+    if (capacity - (head - r->tail_cache) < count) {
+        r->tail_cache = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+    }
+    uint32_t room = capacity - (head - r->tail_cache);
+    if (count > room) { count = room; }
+    if (!count) { return 0; }
+
+    spsc_copy(r, head, (void *)src, count, true);
+    // Los datos quedan visibles antes que el nuevo indice
+    __atomic_store_n(&r->head, head + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+/**
+ * @brief Saca elementos, solo desde el consumidor
+ * @param r puntero al ring
+ * @param dst arreglo donde se copian
+ * @param count cantidad maxima de elementos
+ * @return elementos copiados
+ */
+static inline uint32_t spsc_pop(spsc_t *r, void *dst, uint32_t count) {
+    uint32_t tail = r->tail;
+
+    if (r->head_cache - tail < count) {
+        // Barrera completa: si el productor no ve el tail nuevo, este lee su head
+        // nuevo. Sin ella, los dos pueden ver el ring lleno de elementos ya
+        // consumidos y el consumidor se bloquea sin notificacion (ver spsc_push_from_isr)
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        r->head_cache = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    }
+    uint32_t available = r->head_cache - tail;
+    if (count > available) { count = available; }
+    if (!count) { return 0; }
+
+    spsc_copy(r, tail, dst, count, false);
+    // Los datos se terminan de leer antes de liberar los lugares
+    __atomic_store_n(&r->tail, tail + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+/**
+ * @brief Elementos disponibles. Desde el consumidor es un minimo, desde el
+ * productor un maximo
+ * @param r puntero al ring
+ * @return cantidad de elementos
+ */
+static inline uint32_t spsc_count(const spsc_t *r) {
+    return __atomic_load_n(&r->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Lugares libres
+ * @param r puntero al ring
+ * @return cantidad de elementos que se pueden agregar
+ */
+static inline uint32_t spsc_free(const spsc_t *r) {
+    return r->mask + 1 - spsc_count(r);
+}
+
+#ifdef INC_FREERTOS_H
+#include "task.h"
+
+/**
+ * @brief Registra la tarea que consume y se bloquea en spsc_pop_wait
+ * @param r puntero al ring
+ * @param consumer tarea consumidora
+ */
+static inline void spsc_set_consumer(spsc_t *r, TaskHandle_t consumer) {
+    r->consumer = consumer;
+}
+
+/**
+ * @brief Agrega elementos desde una ISR y notifica a la tarea consumidora solo
+ * si el ring estaba vacio. Una rafaga completa toca el kernel una sola vez
+ * @param r puntero al ring
+ * @param src elementos a agregar
+ * @param count cantidad de elementos
+ * @param to_higher_priority_task se pone en pdTRUE si hay que cambiar de tarea
+ * @return elementos agregados
+ */
+static inline uint32_t spsc_push_from_isr(spsc_t *r, const void *src, uint32_t count, BaseType_t *to_higher_priority_task) {
+    uint32_t head = r->head;
+    uint32_t pushed = spsc_push(r, src, count);
+
+    if (pushed && r->consumer) {
+        // Barrera completa, pareja de la de spsc_pop: si el consumidor ya saco
+        // todo lo anterior puede estar por bloquearse y hay que notificarlo
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&r->tail, __ATOMIC_RELAXED) == head) {
+            vTaskNotifyGiveIndexedFromISR(r->consumer, SPSC_NOTIFY_INDEX, to_higher_priority_task);
+        }
+    }
+    return pushed;
+}
+
+/**
+ * @brief Saca elementos y, si el ring esta vacio, bloquea la tarea hasta que
+ * el productor agregue o pase el timeout
+ * @param r puntero al ring
+ * @param dst arreglo donde se copian
+ * @param count cantidad maxima de elementos
+ * @param timeout ticks de espera maxima
+ * @return elementos copiados, 0 si paso el timeout
+ */
+static inline uint32_t spsc_pop_wait(spsc_t *r, void *dst, uint32_t count, TickType_t timeout) {
+    uint32_t popped = spsc_pop(r, dst, count);
+    // Una notificacion vieja solo causa una vuelta extra
+    while (!popped && ulTaskNotifyTakeIndexed(SPSC_NOTIFY_INDEX, pdTRUE, timeout)) {
+        popped = spsc_pop(r, dst, count);
+    }
+    return popped;
+}
+#endif
+
+#endif
@@ -0,0 +1,130 @@
+// clock_gettime y pthread con -std=c11
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "check.h"
+#include "spsc.h"
+
+// Elementos por medicion
+#define ITEMS       4000000u
+// Ring de 2^RING_BITS elementos de 32 bits para las dos implementaciones
+#define RING_BITS   8
+#define CAPACITY    (1u << RING_BITS)
+
+/**
+ * @brief Ring con los mismos indices protegido por un mutex, el equivalente en la PC
+ * de una cola que toma una seccion critica en cada operacion
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    uint32_t head, tail;
+    uint32_t buf[CAPACITY];
+} locked_t;
+
+static uint32_t locked_push(locked_t *q, const uint32_t *src, uint32_t count) {
+    pthread_mutex_lock(&q->lock);
+    uint32_t room = CAPACITY - (q->head - q->tail);
+    if (count > room) { count = room; }
+    for (uint32_t i = 0; i < count; i++) { q->buf[(q->head + i) & (CAPACITY - 1)] = src[i]; }
+    q->head += count;
+    pthread_mutex_unlock(&q->lock);
+    return count;
+}
+
+static uint32_t locked_pop(locked_t *q, uint32_t *dst, uint32_t count) {
+    pthread_mutex_lock(&q->lock);
+    uint32_t available = q->head - q->tail;
+    if (count > available) { count = available; }
+    for (uint32_t i = 0; i < count; i++) { dst[i] = q->buf[(q->tail + i) & (CAPACITY - 1)]; }
+    q->tail += count;
+    pthread_mutex_unlock(&q->lock);
+    return count;
+}
+
+static SPSC_BUFFER(ring_buf, uint32_t, RING_BITS);
+static spsc_t ring;
+static locked_t locked = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+// Implementacion y rafaga de la medicion en curso
+static bool use_spsc;
+static uint32_t batch_size;
+static uint64_t sum;
+
+static uint32_t push(const uint32_t *src, uint32_t count) {
+    return use_spsc ? spsc_push(&ring, src, count) : locked_push(&locked, src, count);
+}
+
+static uint32_t pop(uint32_t *dst, uint32_t count) {
+    return use_spsc ? spsc_pop(&ring, dst, count) : locked_pop(&locked, dst, count);
+}
+
+static void *producer(void *arg) {
+    uint32_t batch[64];
+    (void)arg;
+
+    for (uint32_t seq = 0; seq < ITEMS; seq += batch_size) {
+        for (uint32_t i = 0; i < batch_size; i++) { batch[i] = seq + i; }
+        uint32_t pushed = 0;
+        while ((pushed += push(batch + pushed, batch_size - pushed)) < batch_size) { sched_yield(); }
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg) {
+    uint32_t batch[64], received = 0;
+    uint64_t total = 0;
+    (void)arg;
+
+    while (received < ITEMS) {
+        uint32_t count = pop(batch, 64);
+        if (!count) {
+            sched_yield();
+            continue;
+        }
+        for (uint32_t i = 0; i < count; i++) { total += batch[i]; }
+        received += count;
+    }
+    sum = total;
+    return NULL;
+}
+
+/**
+ * @brief Pasa ITEMS elementos de un hilo a otro
+ * @return nanosegundos por elemento
+ */
+static double measure(bool spsc, uint32_t batch) {
+    pthread_t threads[2];
+    struct timespec start, end;
+
+    use_spsc = spsc;
+    batch_size = batch;
+    spsc_init(&ring, ring_buf, sizeof(uint32_t), CAPACITY);
+    locked.head = locked.tail = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_create(&threads[0], NULL, consumer, NULL);
+    pthread_create(&threads[1], NULL, producer, NULL);
+    pthread_join(threads[1], NULL);
+    pthread_join(threads[0], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    // Suma de 0 a ITEMS - 1: no se perdio ni se repitio nada
+    CHECK_EQ(sum, (uint64_t)ITEMS * (ITEMS - 1) / 2);
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / ITEMS;
+}
+
+int main(void) {
+    static const uint32_t batches[] = { 1, 16 };
+
+    printf("%-8s %12s %12s\n", "rafaga", "spsc", "mutex");
+    for (size_t i = 0; i < sizeof(batches) / sizeof(batches[0]); i++) {
+        double lockfree = measure(true, batches[i]);
+        double mutex = measure(false, batches[i]);
+        printf("%-8u %9.1f ns %9.1f ns\n", batches[i], lockfree, mutex);
+    }
+    return check_result("spsc_bench");
+}
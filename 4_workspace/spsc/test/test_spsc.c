@@ -0,0 +1,145 @@
+// sched_yield y pthread con -std=c11
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#include "check.h"
+#include "spsc.h"
+
+// Elementos que pasan del productor al consumidor en la prueba de dos hilos
+#define ITEMS       2000000u
+// Ring chico para pasar muchas veces por lleno, vacio y la vuelta del buffer
+#define RING_BITS   4
+// Rafagas de hasta BATCH_MAX elementos, como una ISR que junta varias muestras
+#define BATCH_MAX   7
+
+// Elemento de 12 bytes: el tamaño no es potencia de dos y la copia se parte
+typedef struct {
+    uint32_t seq;
+    uint32_t check;
+    uint32_t pad;
+} item_t;
+
+static SPSC_BUFFER(ring_buf, item_t, RING_BITS);
+static spsc_t ring;
+
+// Resultados del consumidor, se leen despues del join
+static uint32_t received;
+static uint32_t bad_items;
+static uint32_t empty_pops;
+static uint32_t full_pushes;
+
+// Generador congruencial por hilo, las rafagas son siempre las mismas
+static uint32_t next_random(uint32_t *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 16;
+}
+
+static uint32_t item_check(uint32_t seq) {
+    return seq * 2654435761u ^ 0xA5A5A5A5u;
+}
+
+// Casos de un solo hilo: capacidad, lleno, vacio y copia partida
+static void test_single(void) {
+    item_t in[20], out[20];
+    uint8_t bytes[3 * 8];
+
+    CHECK(!spsc_init(&ring, ring_buf, sizeof(item_t), 12));
+    CHECK(!spsc_init(&ring, ring_buf, sizeof(item_t), 0));
+    CHECK(spsc_init(&ring, ring_buf, sizeof(item_t), 1u << RING_BITS));
+
+    for (uint32_t i = 0; i < 20; i++) { in[i] = (item_t){ i, item_check(i), 0 }; }
+    CHECK_EQ(spsc_pop(&ring, out, 1), 0);
+    CHECK_EQ(spsc_push(&ring, in, 20), 16);                 // Agrega los que entran
+    CHECK_EQ(spsc_count(&ring), 16);
+    CHECK_EQ(spsc_free(&ring), 0);
+    CHECK_EQ(spsc_push(&ring, in, 1), 0);
+    CHECK_EQ(spsc_pop(&ring, out, 10), 10);
+    CHECK_EQ(spsc_push(&ring, in + 16, 4), 4);              // Da la vuelta al final del buffer
+    CHECK_EQ(spsc_pop(&ring, out + 10, 20), 10);
+    for (uint32_t i = 0; i < 20; i++) { CHECK_EQ(out[i].seq, i); }
+    CHECK_EQ(spsc_count(&ring), 0);
+
+    // Elementos de 3 bytes, los indices libres pasan por el desborde de 32 bits
+    uint8_t small[8 * 3];
+    spsc_t r;
+    CHECK(spsc_init(&r, small, 3, 8));
+    r.head = r.tail = r.head_cache = r.tail_cache = UINT32_MAX - 5;
+    for (uint32_t round = 0; round < 4; round++) {
+        for (int i = 0; i < 6 * 3; i++) { bytes[i] = (uint8_t)(round * 31 + i); }
+        CHECK_EQ(spsc_push(&r, bytes, 6), 6);
+        uint8_t back[6 * 3];
+        CHECK_EQ(spsc_pop(&r, back, 6), 6);
+        CHECK(!memcmp(back, bytes, sizeof(back)));
+    }
+}
+
+static void *producer(void *arg) {
+    uint32_t seed = 12345, seq = 0;
+    item_t batch[BATCH_MAX];
+    (void)arg;
+
+    while (seq < ITEMS) {
+        uint32_t count = 1 + next_random(&seed) % BATCH_MAX;
+        if (count > ITEMS - seq) { count = ITEMS - seq; }
+        for (uint32_t i = 0; i < count; i++) { batch[i] = (item_t){ seq + i, item_check(seq + i), 0 }; }
+
+        // Reintenta lo que no entro, como una ISR que no puede esperar reintentaria en la proxima
+        uint32_t pushed = spsc_push(&ring, batch, count);
+        while (pushed < count) {
+            full_pushes++;
+            sched_yield();
+            pushed += spsc_push(&ring, batch + pushed, count - pushed);
+        }
+        seq += count;
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg) {
+    uint32_t seed = 54321, expected = 0;
+    item_t batch[BATCH_MAX + 3];
+    (void)arg;
+
+    while (expected < ITEMS) {
+        uint32_t count = spsc_pop(&ring, batch, 1 + next_random(&seed) % (BATCH_MAX + 3));
+        if (!count) {
+            empty_pops++;
+            sched_yield();
+            continue;
+        }
+        // Cada elemento llega una vez, en orden y sin mezclar datos viejos y nuevos
+        for (uint32_t i = 0; i < count; i++, expected++) {
+            if (batch[i].seq != expected || batch[i].check != item_check(expected)) { bad_items++; }
+        }
+    }
+    received = expected;
+    return NULL;
+}
+
+// Un hilo productor y uno consumidor, verificados con ThreadSanitizer
+static void test_threads(void) {
+    pthread_t threads[2];
+
+    spsc_init(&ring, ring_buf, sizeof(item_t), 1u << RING_BITS);
+    CHECK(!pthread_create(&threads[0], NULL, consumer, NULL));
+    CHECK(!pthread_create(&threads[1], NULL, producer, NULL));
+    pthread_join(threads[1], NULL);
+    pthread_join(threads[0], NULL);
+
+    printf("dos hilos: %u elementos, %u fuera de orden o mezclados, %u veces lleno, %u vacio\n",
+           received, bad_items, full_pushes, empty_pops);
+    CHECK_EQ(received, ITEMS);
+    CHECK_EQ(bad_items, 0);
+    CHECK_EQ(spsc_count(&ring), 0);
+    // La prueba tiene que haber pasado por los dos extremos
+    CHECK(full_pushes > 0 && empty_pops > 0);
+}
+
+int main(void) {
+    test_single();
+    test_threads();
+    return check_result("spsc");
+}
@@ -0,0 +1,36 @@
+# Analisis de stack de las tareas de FreeRTOS
+#
+# Con -DSTACK_USAGE=ON el compilador deja, junto a cada objeto, el tamaño del
+# frame de cada funcion (.su) y el grafo de llamadas (.ci). El target que crea
+# stack_usage_report() los recorre y regenera el header de tamaños de stack.
+
+set(STACK_USAGE_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+option(STACK_USAGE "Generar la informacion de uso de stack de cada funcion" OFF)
+
+# Mediciones de la placa, la salida del comando stack del shell
+set(STACK_USAGE_RUNTIME "" CACHE FILEPATH "Archivo con las marcas de agua medidas en la placa")
+
+if(STACK_USAGE)
+    add_compile_options(-fstack-usage -fcallgraph-info=su)
+endif()
+
+# stack_usage_report(<target> HEADER <archivo> TASKS <MACRO:funcion[:nombre[:palabras]]>...)
+function(stack_usage_report target)
+    cmake_parse_arguments(ARG "" "HEADER" "TASKS" ${ARGN})
+    find_package(Python3 COMPONENTS Interpreter REQUIRED)
+
+    set(args ${CMAKE_BINARY_DIR} --header ${ARG_HEADER})
+    foreach(task ${ARG_TASKS})
+        list(APPEND args --task ${task})
+    endforeach()
+    if(STACK_USAGE_RUNTIME)
+        list(APPEND args --runtime ${STACK_USAGE_RUNTIME})
+    endif()
+
+    add_custom_target(${target}
+        COMMAND ${Python3_EXECUTABLE} ${STACK_USAGE_DIR}/stack_usage.py ${args}
+        COMMENT "Analizando el uso de stack de las tareas"
+        VERBATIM
+    )
+endfunction()
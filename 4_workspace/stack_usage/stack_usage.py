@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+"""Analisis de stack de las tareas de FreeRTOS.
+
+Combina el peor camino del grafo de llamadas que genera GCC (-fstack-usage
+-fcallgraph-info=su) con la marca de agua medida en la placa
+(uxTaskGetStackHighWaterMark) y genera un header con el tamaño sugerido de
+cada stack, en palabras, para usar en xTaskCreate.
+
+Uso:
+    stack_usage.py build --task STACK_SENSOR:vTaskSensor:Sensor --header task_stacks.h
+    stack_usage.py build --task ... --runtime medido.txt --header task_stacks.h
+
+Cada tarea se indica como MACRO:funcion[:nombre[,nombre...][:palabras]]. El
+nombre es el de la tarea en FreeRTOS y se usa para buscarla en el archivo de
+mediciones; si varias tareas comparten la macro se usa la de mayor consumo. El
+archivo tiene lineas "stack <nombre> <tamaño> <libre minimo>" en palabras (las
+que escribe el comando stack del shell). Las palabras son el tamaño que queda
+en el header si la tarea no aparece en el grafo ni en las mediciones; se marca
+como sin analizar.
+
+Si el peor camino tiene llamadas indirectas, recursion, funciones sin datos o
+marcos dinamicos sin cota, el estatico es solo una cota inferior. Sin medicion
+el tamaño sugerido nunca baja del que ya tiene el header ni de las palabras por
+defecto, y si no hay ninguno de los dos el script falla.
+"""
+
+import argparse
+import math
+import os
+import re
+import sys
+from collections import defaultdict
+
+NODE = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+FRAME = re.compile(r"(\d+) bytes \(([\w,]+)\)")
+RUNTIME = re.compile(r"stack (.+?) (\d+) (\d+)\s*$")
+DEFINE = re.compile(r"#define\s+(\w+)\s+(\d+)")
+INDIRECT = "__indirect_call"
+
+
+class CallGraph:
+    """Grafo de llamadas de todos los objetos de un directorio de build."""
+
+    def __init__(self):
+        self.frames = {}                # funcion -> (bytes, calificador)
+        self.edges = defaultdict(set)   # funcion -> funciones llamadas
+        self.memo = {}
+
+    def load(self, build_dir):
+        files = 0
+        for root, _, names in os.walk(build_dir):
+            for name in names:
+                if name.endswith(".ci"):
+                    self.load_ci(os.path.join(root, name))
+                    files += 1
+        return files
+
+    def load_ci(self, path):
+        with open(path, errors="replace") as f:
+            text = f.read()
+        for title, label in NODE.findall(text):
+            match = FRAME.search(label)
+            # Los nodos sin tamaño son declaraciones, no pisan una definicion de otro archivo
+            if match:
+                self.frames[title] = (int(match.group(1)), match.group(2))
+        for source, target in EDGE.findall(text):
+            self.edges[source].add(target)
+
+    def resolve(self, name):
+        """Busca una funcion; las static aparecen como archivo.c:funcion."""
+        if name in self.frames:
+            return name
+        matches = [title for title in self.frames if title.endswith(":" + name)]
+        return matches[0] if len(matches) == 1 else None
+
+    def worst(self, name, stack=()):
+        """Peor camino desde una funcion.
+
+        Devuelve (bytes, camino, avisos). Los avisos son funciones sin datos
+        (bibliotecas precompiladas), llamadas indirectas, recursion y marcos
+        de tamaño dinamico, que no se pueden acotar desde el grafo.
+        """
+        if name in self.memo:
+            return self.memo[name]
+        if name == INDIRECT:
+            return 0, [], {"llamada indirecta"}
+        if name in stack:
+            return 0, [], {"recursion en " + name}
+        if name not in self.frames:
+            return 0, [name], {"sin datos: " + name}
+
+        size, qualifier = self.frames[name]
+        warnings = set()
+        if qualifier != "static":
+            warnings.add("marco %s en %s" % (qualifier, name))
+        best, best_path = 0, []
+        for callee in sorted(self.edges[name]):
+            callee_size, callee_path, callee_warnings = self.worst(callee, stack + (name,))
+            warnings |= callee_warnings
+            if callee_size > best or not best_path:
+                best, best_path = callee_size, callee_path
+        result = (size + best, [name] + best_path, warnings)
+        # Con recursion el resultado depende del camino, no se guarda
+        if not any(w.startswith("recursion") for w in warnings):
+            self.memo[name] = result
+        return result
+
+
+def unbounded(warning):
+    """True si el aviso deja al estatico como cota inferior: todos menos un marco dinamico acotado."""
+    return not (warning.startswith("marco ") and "bounded" in warning)
+
+
+def load_header(path):
+    """Tamaños del header generado antes: macro -> palabras."""
+    if not path or not os.path.exists(path):
+        return {}
+    with open(path, errors="replace") as f:
+        return {macro: int(words) for macro, words in DEFINE.findall(f.read())}
+
+
+def load_runtime(path):
+    """Marcas de agua medidas: nombre -> (tamaño, libre minimo) en palabras."""
+    runtime = {}
+    with open(path, errors="replace") as f:
+        for line in f:
+            match = RUNTIME.search(line)
+            if match:
+                name, size, free = match.group(1), int(match.group(2)), int(match.group(3))
+                # Con varias mediciones vale la de menor margen
+                if name not in runtime or free < runtime[name][1]:
+                    runtime[name] = (size, free)
+    return runtime
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("build", help="directorio de build compilado con -fstack-usage -fcallgraph-info=su")
+    parser.add_argument("--task", action="append", default=[], metavar="MACRO:FUNCION[:NOMBRE,...][:PALABRAS]",
+                        help="tarea a analizar")
+    parser.add_argument("--runtime", help="archivo con las lineas del comando stack")
+    parser.add_argument("--header", help="header a generar con los tamaños sugeridos")
+    parser.add_argument("--context", type=int, default=208,
+                        help="bytes del contexto guardado en el stack de la tarea (por defecto 208: "
+                             "marco de excepcion y registros de la FPU del Cortex-M33)")
+    parser.add_argument("--margin", type=float, default=20.0, help="margen sobre el peor caso, en %% (por defecto 20)")
+    parser.add_argument("--word", type=int, default=4, help="bytes por palabra del stack")
+    parser.add_argument("--min", type=int, default=128,
+                        help="tamaño minimo en palabras (por defecto 128, configMINIMAL_STACK_SIZE)")
+    args = parser.parse_args()
+
+    graph = CallGraph()
+    if not graph.load(args.build):
+        # Sin grafo solo quedan las mediciones y los tamaños por defecto
+        print("aviso: no hay archivos .ci en %s, compilar con -fstack-usage -fcallgraph-info=su" % args.build,
+              file=sys.stderr)
+    runtime = load_runtime(args.runtime) if args.runtime else {}
+    current = load_header(args.header)
+
+    rows = []
+    print("%-22s %9s %9s %9s %9s %9s" % ("tarea", "estatico", "medido", "actual", "margen", "sugerido"))
+    for spec in args.task:
+        parts = spec.split(":")
+        if len(parts) < 2:
+            parser.error("tarea mal indicada: %s" % spec)
+        macro, function = parts[0], parts[1]
+        names = parts[2].split(",") if len(parts) > 2 and parts[2] else [function]
+        default = int(parts[3]) if len(parts) > 3 else None
+        name = "/".join(names)
+
+        # Si varias tareas comparten la macro, vale la que mas stack uso
+        entry = graph.resolve(function)
+        size, used = None, None
+        for task in names:
+            if task in runtime:
+                task_size, task_free = runtime[task]
+                if used is None or (task_size - task_free) * args.word > used:
+                    size, used = task_size, (task_size - task_free) * args.word
+        if not entry and used is None:
+            if default is None:
+                print("%s: no se encontro %s en el grafo ni hay medicion" % (name, function), file=sys.stderr)
+                return 1
+            print("%-22s %9s %9s %9s %9s %8dw" % (name, "-", "-", "-", "-", default))
+            print("    sin analizar: %s no esta en el grafo ni hay medicion, queda el tamaño por defecto" % function)
+            rows.append((macro, default, function, None, None, False))
+            continue
+        static, path, warnings = graph.worst(entry) if entry else (0, [], {"sin datos: " + function})
+        static += args.context
+
+        need = max(static, used or 0)
+        words = max(args.min, math.ceil(need * (1 + args.margin / 100) / args.word))
+
+        # Sin cota y sin medicion el estatico no alcanza para achicar el stack
+        kept = False
+        if used is None and any(unbounded(w) for w in warnings):
+            floor = [w for w in (default, current.get(macro)) if w is not None]
+            if not floor:
+                print("%s: el peor camino de %s no tiene cota y no hay medicion ni tamaño actual o por defecto"
+                      % (name, function), file=sys.stderr)
+                return 1
+            if words < max(floor):
+                words, kept = max(floor), True
+        margin = "%d%%" % (100 * (size * args.word - need) / need) if size is not None else "-"
+        print("%-22s %8dB %9s %9s %9s %8dw" % (name, static, "%dB" % used if used is not None else "-",
+                                                "%dw" % size if size is not None else "-", margin, words))
+        print("    peor camino: %s" % " > ".join(os.path.basename(f) for f in path))
+        unknown = sorted(os.path.basename(w[len("sin datos: "):]) for w in warnings if w.startswith("sin datos: "))
+        for warning in sorted(w for w in warnings if not w.startswith("sin datos: ")):
+            print("    aviso: %s" % warning)
+        if unknown:
+            print("    sin datos (no suman al estatico): %s" % ", ".join(unknown))
+        if kept:
+            print("    sin cota y sin medicion: queda el tamaño actual o por defecto")
+        rows.append((macro, words, function, static, used, kept))
+
+    if args.header:
+        guard = "_" + re.sub(r"\W", "_", os.path.basename(args.header)).upper() + "_"
+        with open(args.header, "w") as f:
+            f.write("// Generado por stack_usage.py, no editar a mano\n")
+            f.write("#ifndef %s\n#define %s\n\n" % (guard, guard))
+            f.write("// Tamaños de stack en palabras: peor caso entre el grafo de llamadas (mas %d B de\n" % args.context)
+            f.write("// contexto) y la marca de agua medida, con %g%% de margen\n" % args.margin)
+            if all(row[3] is None for row in rows):
+                f.write("// Sin grafo de llamadas ni mediciones: todos son los tamaños por defecto\n")
+            for macro, words, function, static, used, kept in rows:
+                if static is None:
+                    f.write("#define %-24s %5d   // %s: sin analizar, tamaño por defecto\n" % (macro, words, function))
+                    continue
+                measured = ", medido %d B" % used if used is not None else ""
+                bound = ", sin cota: no se achica" if kept else ""
+                f.write("#define %-24s %5d   // %s: estatico %d B%s%s\n" % (macro, words, function, static, measured,
+                                                                             bound))
+            f.write("\n#endif\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
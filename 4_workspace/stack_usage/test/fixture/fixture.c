@@ -0,0 +1,40 @@
+// Tareas de prueba para stack_usage.py. Los .ci y .su de esta carpeta salen de
+//   gcc -O1 -fno-inline -mno-red-zone -fstack-usage -fcallgraph-info=su -c fixture.c
+extern void external(char *buffer);
+
+static void (*volatile hook)(void);
+
+// Marco fijo, acotado desde el grafo
+static int leaf(const char *text) {
+    volatile char copy[64];
+    for (int i = 0; i < 64; i++) { copy[i] = text[i & 7]; }
+    return copy[0] + copy[63];
+}
+
+void task_direct(void *params) {
+    char line[32];
+    for (int i = 0; i < 32; i++) { line[i] = (char)(long)params; }
+    leaf(line);
+}
+
+// Llamada por puntero
+void task_indirect(void *params) {
+    char line[32];
+    for (int i = 0; i < 32; i++) { line[i] = (char)(long)params; }
+    leaf(line);
+    hook();
+}
+
+// Marco de tamaño dinamico
+void task_dynamic(void *params) {
+    char line[(long)params & 0xFF];
+    for (long i = 0; i < ((long)params & 0xFF); i++) { line[i] = 0; }
+    leaf(line);
+}
+
+// Funcion de otra biblioteca, sin datos
+void task_external(void *params) {
+    char line[16];
+    (void)params;
+    external(line);
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""Prueba de stack_usage.py con el grafo de fixture/, sin contexto y sin minimo.
+
+Uso:
+    test_stack_usage.py directorio_temporal
+"""
+
+import os
+import re
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SCRIPT = os.path.join(HERE, "..", "stack_usage.py")
+FIXTURE = os.path.join(HERE, "fixture")
+failures = 0
+
+
+def check(condition, message):
+    global failures
+    if not condition:
+        print("falla: %s" % message, file=sys.stderr)
+        failures += 1
+
+
+def analyze(header, *tasks, runtime=None):
+    """Corre el script y devuelve el codigo de salida y las macros del header."""
+    args = [sys.executable, SCRIPT, FIXTURE, "--header", header, "--context", "0", "--min", "16"]
+    for task in tasks:
+        args += ["--task", task]
+    if runtime:
+        args += ["--runtime", runtime]
+    result = subprocess.run(args, capture_output=True, text=True)
+    print(result.stdout + result.stderr)
+    macros = {}
+    if os.path.exists(header):
+        with open(header) as f:
+            macros = {m: (int(w), c) for m, w, c in re.findall(r"#define (\w+)\s+(\d+)\s+// (.*)", f.read())}
+    return result.returncode, macros
+
+
+def main():
+    out = sys.argv[1]
+    os.makedirs(out, exist_ok=True)
+    header = os.path.join(out, "task_stacks.h")
+    if os.path.exists(header):
+        os.remove(header)
+
+    # 128 B con 20 % de margen son 39 palabras. Las tareas sin cota tienen menos
+    # estatico pero no bajan de su tamaño por defecto
+    code, macros = analyze(header, "STACK_DIRECT:task_direct::200", "STACK_INDIRECT:task_indirect::100",
+                           "STACK_DYNAMIC:task_dynamic::90", "STACK_EXTERNAL:task_external::80")
+    check(code == 0, "con tamaños por defecto no falla")
+    check(macros.get("STACK_DIRECT", (0, ""))[0] == 39, "acotada: el estatico aunque el defecto sea mayor")
+    check("sin cota" not in macros.get("STACK_DIRECT", (0, ""))[1], "acotada: sin marca")
+    check(macros.get("STACK_INDIRECT", (0, ""))[0] == 100, "llamada indirecta: no baja del defecto")
+    check(macros.get("STACK_DYNAMIC", (0, ""))[0] == 90, "marco dinamico: no baja del defecto")
+    check(macros.get("STACK_EXTERNAL", (0, ""))[0] == 80, "funcion sin datos: no baja del defecto")
+    check(all("sin cota" in macros.get(m, (0, ""))[1] for m in ("STACK_INDIRECT", "STACK_DYNAMIC", "STACK_EXTERNAL")),
+          "las tres marcadas sin cota")
+
+    # El header ya tiene un tamaño mayor que el defecto: se conserva
+    with open(header, "w") as f:
+        f.write("#define STACK_INDIRECT 150\n")
+    code, macros = analyze(header, "STACK_INDIRECT:task_indirect::100")
+    check(code == 0 and macros.get("STACK_INDIRECT", (0, ""))[0] == 150, "no baja del tamaño actual")
+
+    # Sin defecto ni tamaño actual no hay de donde sacar el tamaño
+    os.remove(header)
+    code, _ = analyze(header, "STACK_INDIRECT:task_indirect")
+    check(code == 1, "sin cota, sin medicion y sin tamaño: falla")
+    check(not os.path.exists(header), "sin header si falla")
+
+    # Con medicion manda la medicion, aunque quede por debajo del defecto
+    runtime = os.path.join(out, "stack.txt")
+    with open(runtime, "w") as f:
+        f.write("stack task_indirect 64 40\n")
+    code, macros = analyze(header, "STACK_INDIRECT:task_indirect::100", runtime=runtime)
+    check(code == 0 and macros.get("STACK_INDIRECT", (0, ""))[0] == 39, "con medicion se achica")
+
+    print("stack_usage: %s (%d fallas)" % ("FALLA" if failures else "ok", failures))
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,37 @@
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include "pico/stdlib.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "telemetry_frame.h"
+
+// Los tamaños de stack que genera stack_usage.py reemplazan a los de la biblioteca
+#if __has_include("task_stacks.h")
+#include "task_stacks.h"
+#endif
+
+// Tamaño de cada uno de los dos buffers de transmision
+#define TELEMETRY_BUFFER_SIZE   2048
+
+// Tiempo maximo que una trama espera en el buffer antes de enviarse
+#define TELEMETRY_FLUSH_MS      10
+
+// Prioridad y stack de la tarea de transmision
+#define TELEMETRY_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+#ifndef TELEMETRY_TASK_STACK
+#define TELEMETRY_TASK_STACK    (configMINIMAL_STACK_SIZE + 128)
+#endif
+
+// Prototipos de funciones
+bool telemetry_init(void);
+bool telemetry_send(telemetry_type_t type, const void *payload, size_t len);
+bool telemetry_sample(uint8_t channel, const float *values, size_t count);
+bool telemetry_stats(uint8_t channel, float mean, float stddev, float min, float max);
+bool telemetry_event(uint16_t id, uint32_t arg);
+bool telemetry_text(const char *text);
+uint32_t telemetry_dropped(void);
+
+#endif
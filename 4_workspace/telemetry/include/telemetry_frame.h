@@ -0,0 +1,36 @@
+#ifndef _TELEMETRY_FRAME_H_
+#define _TELEMETRY_FRAME_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Bytes maximos de datos de una trama
+#define TELEMETRY_MAX_PAYLOAD   64
+
+// Encabezado (tipo, secuencia y marca de tiempo) y CRC16
+#define TELEMETRY_HEADER_SIZE   6
+#define TELEMETRY_CRC_SIZE      2
+
+// Tamaño maximo de una trama sin codificar y codificada con COBS mas el delimitador
+#define TELEMETRY_RAW_MAX       (TELEMETRY_HEADER_SIZE + TELEMETRY_MAX_PAYLOAD + TELEMETRY_CRC_SIZE)
+#define TELEMETRY_FRAME_MAX     (TELEMETRY_RAW_MAX + TELEMETRY_RAW_MAX / 254 + 2)
+
+/**
+ * @brief Tipos de trama
+ */
+typedef enum {
+    TELEMETRY_SAMPLE = 1,       // Canal (uint8_t) y valores (float)
+    TELEMETRY_STATS = 2,        // Canal (uint8_t), media, desvio, minimo y maximo (float)
+    TELEMETRY_EVENT = 3,        // Identificador (uint16_t) y argumento (uint32_t)
+    TELEMETRY_TEXT = 4,         // Texto sin terminador
+    TELEMETRY_I2C = 5           // Transaccion del bus I2C (i2c_trace_entry_t hasta el ultimo dato)
+} telemetry_type_t;
+
+// Prototipos de funciones
+uint16_t telemetry_crc16(uint16_t crc, const uint8_t *data, size_t len);
+size_t telemetry_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst);
+size_t telemetry_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst);
+size_t telemetry_frame_encode(uint8_t type, uint8_t seq, uint32_t time_us, const void *payload, size_t len, uint8_t *dst);
+
+#endif
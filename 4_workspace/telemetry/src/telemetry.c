@@ -0,0 +1,168 @@
+#include <string.h>
+#include "telemetry.h"
+#include "pico/stdio_usb.h"
+#include "pico/stdio/driver.h"
+
+// Buffers de transmision: uno se llena mientras el otro se envia
+static uint8_t buffers[2][TELEMETRY_BUFFER_SIZE];
+static size_t fill[2];
+// Buffer que se esta llenando y buffer entregado a la tarea (-1 si ninguno)
+static uint8_t active = 0;
+static int8_t pending = -1;
+// Numero de secuencia de la proxima trama
+static uint8_t seq = 0;
+// Tramas descartadas por falta de lugar
+static volatile uint32_t dropped = 0;
+// Tarea de transmision
+static TaskHandle_t tx_handle = NULL;
+
+/**
+ * @brief Entrega el buffer activo a la tarea de transmision y pasa al otro.
+ * Debe llamarse dentro de una seccion critica
+ * @return false si la tarea todavia esta enviando el otro buffer
+ */
+static bool telemetry_swap(void) {
+    if (pending >= 0) { return false; }
+    pending = active;
+    active ^= 1;
+    fill[active] = 0;
+    return true;
+}
+
+/**
+ * @brief Tarea de transmision. Envia un buffer cuando se llena o cuando la
+ * trama mas vieja lleva TELEMETRY_FLUSH_MS esperando
+ * @param pvParameters sin uso
+ */
+static void telemetry_task(void *pvParameters) {
+    while (1) {
+        // Sin notificacion, vence el plazo y se envia lo que haya
+        if (!ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TELEMETRY_FLUSH_MS))) {
+            taskENTER_CRITICAL();
+            if (fill[active]) { telemetry_swap(); }
+            taskEXIT_CRITICAL();
+        }
+
+        while (pending >= 0) {
+            // Escribo directo en el driver de USB, sin la traduccion de fin de linea de printf
+            stdio_usb.out_chars((const char *)buffers[pending], fill[pending]);
+            taskENTER_CRITICAL();
+            pending = -1;
+            // Si el activo se lleno mientras se enviaba, sale sin esperar
+            if (fill[active] > TELEMETRY_BUFFER_SIZE - TELEMETRY_FRAME_MAX) { telemetry_swap(); }
+            taskEXIT_CRITICAL();
+        }
+    }
+}
+
+/**
+ * @brief Crea la tarea de transmision. El USB se inicializa con stdio_init_all
+ * @return true si se pudo crear la tarea
+ */
+bool telemetry_init(void) {
+    return xTaskCreate(telemetry_task, "Telemetry", TELEMETRY_TASK_STACK, NULL, TELEMETRY_TASK_PRIORITY, &tx_handle) == pdPASS;
+}
+
+/**
+ * @brief Encola una trama. Nunca bloquea: si los dos buffers estan ocupados la
+ * trama se descarta y se cuenta. Solo desde tareas
+ * @param type tipo de trama
+ * @param payload datos
+ * @param len cantidad de bytes, hasta TELEMETRY_MAX_PAYLOAD
+ * @return false si la trama se descarto
+ */
+bool telemetry_send(telemetry_type_t type, const void *payload, size_t len) {
+    uint8_t frame[TELEMETRY_FRAME_MAX];
+    bool notify = false, queued = false;
+
+    // La trama se arma fuera de la seccion critica. Si otra tarea se adelanta
+    // entre la secuencia y la copia, dos tramas pueden llegar invertidas
+    taskENTER_CRITICAL();
+    uint8_t frame_seq = seq++;
+    taskEXIT_CRITICAL();
+    size_t n = telemetry_frame_encode(type, frame_seq, time_us_32(), payload, len, frame);
+    if (!n) { return false; }
+
+    // Solo la copia se hace con las interrupciones deshabilitadas
+    taskENTER_CRITICAL();
+    if (fill[active] + n > TELEMETRY_BUFFER_SIZE) {
+        notify = telemetry_swap();
+    }
+    if (fill[active] + n <= TELEMETRY_BUFFER_SIZE) {
+        memcpy(&buffers[active][fill[active]], frame, n);
+        fill[active] += n;
+        queued = true;
+        // Buffer lleno, no tiene sentido esperar el plazo
+        if (fill[active] > TELEMETRY_BUFFER_SIZE - TELEMETRY_FRAME_MAX) {
+            notify |= telemetry_swap();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (!queued) { dropped++; }
+    if (notify) { xTaskNotifyGive(tx_handle); }
+    return queued;
+}
+
+/**
+ * @brief Envia los valores de un canal
+ * @param channel numero de canal
+ * @param values valores
+ * @param count cantidad de valores
+ * @return false si la trama se descarto
+ */
+bool telemetry_sample(uint8_t channel, const float *values, size_t count) {
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+    if (1 + count * sizeof(float) > sizeof(payload)) { return false; }
+    payload[0] = channel;
+    memcpy(&payload[1], values, count * sizeof(float));
+    return telemetry_send(TELEMETRY_SAMPLE, payload, 1 + count * sizeof(float));
+}
+
+/**
+ * @brief Envia el resumen estadistico de un canal
+ * @param channel numero de canal
+ * @param mean media
+ * @param stddev desvio estandar
+ * @param min minimo
+ * @param max maximo
+ * @return false si la trama se descarto
+ */
+bool telemetry_stats(uint8_t channel, float mean, float stddev, float min, float max) {
+    const float values[] = { mean, stddev, min, max };
+    uint8_t payload[1 + sizeof(values)];
+    payload[0] = channel;
+    memcpy(&payload[1], values, sizeof(values));
+    return telemetry_send(TELEMETRY_STATS, payload, sizeof(payload));
+}
+
+/**
+ * @brief Envia un evento de traza
+ * @param id identificador del evento
+ * @param arg argumento del evento
+ * @return false si la trama se descarto
+ */
+bool telemetry_event(uint16_t id, uint32_t arg) {
+    uint8_t payload[sizeof(id) + sizeof(arg)];
+    memcpy(&payload[0], &id, sizeof(id));
+    memcpy(&payload[sizeof(id)], &arg, sizeof(arg));
+    return telemetry_send(TELEMETRY_EVENT, payload, sizeof(payload));
+}
+
+/**
+ * @brief Envia un texto, recortado a TELEMETRY_MAX_PAYLOAD caracteres
+ * @param text cadena terminada en cero
+ * @return false si la trama se descarto
+ */
+bool telemetry_text(const char *text) {
+    size_t len = strlen(text);
+    return telemetry_send(TELEMETRY_TEXT, text, len > TELEMETRY_MAX_PAYLOAD ? TELEMETRY_MAX_PAYLOAD : len);
+}
+
+/**
+ * @brief Cantidad de tramas descartadas desde el arranque
+ * @return tramas descartadas
+ */
+uint32_t telemetry_dropped(void) {
+    return dropped;
+}
@@ -0,0 +1,102 @@
+#include <string.h>
+#include "telemetry_frame.h"
+
+/**
+ * @brief CRC16-CCITT (polinomio 0x1021) sin tabla
+ * @param crc valor inicial (0xFFFF)
+ * @param data puntero a los datos
+ * @param len cantidad de bytes
+ * @return CRC actualizado
+ */
+uint16_t telemetry_crc16(uint16_t crc, const uint8_t *data, size_t len) {
+    while (len--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Codifica con COBS: elimina los ceros de los datos para que el cero
+ * quede libre como delimitador de tramas. Agrega un byte cada 254
+ * @param src datos
+ * @param len cantidad de bytes
+ * @param dst salida, de al menos len + len / 254 + 1 bytes
+ * @return bytes escritos, sin delimitador
+ */
+size_t telemetry_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst) {
+    size_t code_pos = 0, out = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (src[i]) {
+            dst[out++] = src[i];
+            code++;
+        }
+        // Cada cero, o cada 254 bytes sin ceros, cierra un bloque
+        if (!src[i] || code == 0xFF) {
+            dst[code_pos] = code;
+            code = 1;
+            // Un bloque de 254 bytes al final no necesita otro codigo
+            if (src[i] && i + 1 == len) { return out; }
+            code_pos = out++;
+        }
+    }
+    dst[code_pos] = code;
+    return out;
+}
+
+/**
+ * @brief Decodifica una trama COBS sin su delimitador
+ * @param src datos codificados
+ * @param len cantidad de bytes
+ * @param dst salida, de al menos len bytes
+ * @return bytes decodificados o 0 si la trama es invalida
+ */
+size_t telemetry_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst) {
+    size_t in = 0, out = 0;
+
+    while (in < len) {
+        uint8_t code = src[in++];
+        if (!code || in + code - 1 > len) { return 0; }
+        for (uint8_t i = 1; i < code; i++) {
+            if (!src[in]) { return 0; }
+            dst[out++] = src[in++];
+        }
+        // El cero implicito no va despues del ultimo bloque ni de uno de 254 bytes
+        if (code != 0xFF && in < len) { dst[out++] = 0; }
+    }
+    return out;
+}
+
+/**
+ * @brief Arma una trama completa: encabezado, datos y CRC16, codificada con
+ * COBS y terminada en cero
+ * @param type tipo de trama (telemetry_type_t)
+ * @param seq numero de secuencia, permite detectar tramas perdidas
+ * @param time_us marca de tiempo
+ * @param payload datos
+ * @param len cantidad de bytes, hasta TELEMETRY_MAX_PAYLOAD
+ * @param dst salida, de al menos TELEMETRY_FRAME_MAX bytes
+ * @return bytes de la trama o 0 si los datos son demasiado largos
+ */
+size_t telemetry_frame_encode(uint8_t type, uint8_t seq, uint32_t time_us, const void *payload, size_t len, uint8_t *dst) {
+    uint8_t raw[TELEMETRY_RAW_MAX];
+
+    if (len > TELEMETRY_MAX_PAYLOAD) { return 0; }
+
+    // Encabezado en little endian, igual que la memoria del micro
+    raw[0] = type;
+    raw[1] = seq;
+    memcpy(&raw[2], &time_us, sizeof(time_us));
+    memcpy(&raw[TELEMETRY_HEADER_SIZE], payload, len);
+    uint16_t crc = telemetry_crc16(0xFFFF, raw, TELEMETRY_HEADER_SIZE + len);
+    raw[TELEMETRY_HEADER_SIZE + len] = crc & 0xFF;
+    raw[TELEMETRY_HEADER_SIZE + len + 1] = crc >> 8;
+
+    size_t n = telemetry_cobs_encode(raw, TELEMETRY_HEADER_SIZE + len + TELEMETRY_CRC_SIZE, dst);
+    dst[n++] = 0;
+    return n;
+}
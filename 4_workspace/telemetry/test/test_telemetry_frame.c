@@ -0,0 +1,283 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "check.h"
+#include "telemetry_frame.h"
+
+// Generador congruencial, las tramas son siempre las mismas
+static uint32_t seed = 12345;
+
+static uint32_t next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 16;
+}
+
+/**
+ * @brief Trama decodificada
+ */
+typedef struct {
+    uint8_t type;
+    uint8_t seq;
+    uint32_t time_us;
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+    size_t len;
+} frame_t;
+
+/**
+ * @brief Decodifica una trama sin su delimitador, como telemetry_decode.py
+ * @return false si falla COBS, el largo o el CRC
+ */
+static bool frame_decode(const uint8_t *src, size_t len, frame_t *frame) {
+    uint8_t raw[TELEMETRY_FRAME_MAX];
+    if (len > sizeof(raw)) { return false; }
+    size_t n = telemetry_cobs_decode(src, len, raw);
+    if (n < TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE || n > TELEMETRY_RAW_MAX) { return false; }
+    n -= TELEMETRY_CRC_SIZE;
+    uint16_t crc = raw[n] | (uint16_t)raw[n + 1] << 8;
+    if (crc != telemetry_crc16(0xFFFF, raw, n)) { return false; }
+    frame->type = raw[0];
+    frame->seq = raw[1];
+    memcpy(&frame->time_us, &raw[2], sizeof(frame->time_us));
+    frame->len = n - TELEMETRY_HEADER_SIZE;
+    memcpy(frame->payload, &raw[TELEMETRY_HEADER_SIZE], frame->len);
+    return true;
+}
+
+// Datos al azar con una densidad de ceros dada (de 0 a 256 sobre 256)
+static void random_data(uint8_t *data, size_t len, uint32_t zeros) {
+    for (size_t i = 0; i < len; i++) {
+        data[i] = next_random() % 256 < zeros ? 0 : 1 + next_random() % 255;
+    }
+}
+
+// CRC-16/CCITT-FALSE, valor de verificacion del catalogo de CRC
+static void test_crc(void) {
+    CHECK_EQ(telemetry_crc16(0xFFFF, (const uint8_t *)"123456789", 9), 0x29B1);
+    CHECK_EQ(telemetry_crc16(0xFFFF, NULL, 0), 0xFFFF);
+    // Por partes da lo mismo
+    CHECK_EQ(telemetry_crc16(telemetry_crc16(0xFFFF, (const uint8_t *)"1234", 4), (const uint8_t *)"56789", 5), 0x29B1);
+}
+
+// Ejemplos de la descripcion de COBS (Cheshire y Baker), sin el delimitador
+static void test_cobs_vectors(void) {
+    static uint8_t src[300], expected[300], out[300], back[300];
+    // Cada caso arma los datos en src y lo esperado en expected
+    for (int c = 0; c < 10; c++) {
+        size_t len = 0, enc = 0;
+        switch (c) {
+        case 0: src[len++] = 0x00; expected[enc++] = 0x01; expected[enc++] = 0x01; break;
+        case 1: src[len++] = 0x00; src[len++] = 0x00; for (int i = 0; i < 3; i++) { expected[enc++] = 0x01; } break;
+        case 2:
+            src[len++] = 0x00; src[len++] = 0x11; src[len++] = 0x00;
+            expected[enc++] = 0x01; expected[enc++] = 0x02; expected[enc++] = 0x11; expected[enc++] = 0x01;
+            break;
+        case 3:
+            src[len++] = 0x11; src[len++] = 0x22; src[len++] = 0x00; src[len++] = 0x33;
+            expected[enc++] = 0x03; expected[enc++] = 0x11; expected[enc++] = 0x22; expected[enc++] = 0x02;
+            expected[enc++] = 0x33;
+            break;
+        case 4:
+            src[len++] = 0x11; src[len++] = 0x22; src[len++] = 0x33; src[len++] = 0x44;
+            expected[enc++] = 0x05; expected[enc++] = 0x11; expected[enc++] = 0x22; expected[enc++] = 0x33;
+            expected[enc++] = 0x44;
+            break;
+        case 5:
+            src[len++] = 0x11; src[len++] = 0x00; src[len++] = 0x00; src[len++] = 0x00;
+            expected[enc++] = 0x02; expected[enc++] = 0x11; expected[enc++] = 0x01; expected[enc++] = 0x01;
+            expected[enc++] = 0x01;
+            break;
+        case 6:     // 01 a FE: un bloque de 254 bytes justo al final
+            for (int i = 1; i <= 0xFE; i++) { src[len++] = (uint8_t)i; }
+            expected[enc++] = 0xFF;
+            for (int i = 1; i <= 0xFE; i++) { expected[enc++] = (uint8_t)i; }
+            break;
+        case 7:     // 00 a FE
+            for (int i = 0; i <= 0xFE; i++) { src[len++] = (uint8_t)i; }
+            expected[enc++] = 0x01;
+            expected[enc++] = 0xFF;
+            for (int i = 1; i <= 0xFE; i++) { expected[enc++] = (uint8_t)i; }
+            break;
+        case 8:     // 01 a FF
+            for (int i = 1; i <= 0xFF; i++) { src[len++] = (uint8_t)i; }
+            expected[enc++] = 0xFF;
+            for (int i = 1; i <= 0xFE; i++) { expected[enc++] = (uint8_t)i; }
+            expected[enc++] = 0x02;
+            expected[enc++] = 0xFF;
+            break;
+        case 9:     // 02 a FF y 00
+            for (int i = 2; i <= 0xFF; i++) { src[len++] = (uint8_t)i; }
+            src[len++] = 0x00;
+            expected[enc++] = 0xFF;
+            for (int i = 2; i <= 0xFF; i++) { expected[enc++] = (uint8_t)i; }
+            expected[enc++] = 0x01;
+            expected[enc++] = 0x01;
+            break;
+        }
+        size_t got = telemetry_cobs_encode(src, len, out);
+        CHECK_EQ(got, enc);
+        CHECK(got == enc && !memcmp(out, expected, enc));
+        CHECK_EQ(telemetry_cobs_decode(expected, enc, back), len);
+        CHECK(!memcmp(back, src, len));
+    }
+}
+
+// Ida y vuelta de datos al azar de todos los largos y densidades de ceros
+static void test_cobs_random(void) {
+    static uint8_t src[1200], enc[1300], back[1300];
+    for (size_t len = 1; len < 1200; len += 1 + len / 50) {
+        for (uint32_t zeros = 0; zeros <= 256; zeros += 16) {
+            random_data(src, len, zeros);
+            size_t n = telemetry_cobs_encode(src, len, enc);
+            // Sin ceros y con a lo sumo un byte cada 254
+            CHECK(n <= len + len / 254 + 1);
+            CHECK(memchr(enc, 0, n) == NULL);
+            CHECK_EQ(telemetry_cobs_decode(enc, n, back), len);
+            CHECK(!memcmp(back, src, len));
+        }
+    }
+
+    // Tramas invalidas: codigo cero, bloque que se pasa del final, cero adentro
+    const uint8_t zero_code[] = { 0x00, 0x11 };
+    const uint8_t overrun[] = { 0x05, 0x11, 0x22 };
+    const uint8_t inner_zero[] = { 0x03, 0x11, 0x00 };
+    CHECK_EQ(telemetry_cobs_decode(zero_code, sizeof(zero_code), back), 0);
+    CHECK_EQ(telemetry_cobs_decode(overrun, sizeof(overrun), back), 0);
+    CHECK_EQ(telemetry_cobs_decode(inner_zero, sizeof(inner_zero), back), 0);
+}
+
+// Tramas completas de todos los tipos y largos
+static void test_frames(void) {
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD + 1], out[TELEMETRY_FRAME_MAX];
+    frame_t frame;
+
+    for (uint8_t type = TELEMETRY_SAMPLE; type <= TELEMETRY_I2C; type++) {
+        for (size_t len = 0; len <= TELEMETRY_MAX_PAYLOAD; len++) {
+            random_data(payload, len, next_random() % 128);
+            uint8_t seq = next_random() & 0xFF;
+            // Marcas de tiempo con y sin bytes en cero
+            uint32_t time_us = len & 1 ? next_random() << 16 : 0x01020304u * (len + 1);
+            size_t n = telemetry_frame_encode(type, seq, time_us, payload, len, out);
+
+            CHECK(n > 0 && n <= TELEMETRY_FRAME_MAX);
+            CHECK_EQ(out[n - 1], 0);
+            CHECK(memchr(out, 0, n - 1) == NULL);
+            CHECK(frame_decode(out, n - 1, &frame));
+            CHECK_EQ(frame.type, type);
+            CHECK_EQ(frame.seq, seq);
+            CHECK_EQ(frame.time_us, time_us);
+            CHECK_EQ(frame.len, len);
+            CHECK(!memcmp(frame.payload, payload, len));
+        }
+    }
+    CHECK_EQ(telemetry_frame_encode(TELEMETRY_TEXT, 0, 0, payload, TELEMETRY_MAX_PAYLOAD + 1, out), 0);
+}
+
+/**
+ * @brief Errores de un bit: en los bytes de datos el CRC los detecta siempre;
+ * en los codigos de COBS cambian la estructura y casi siempre falla COBS o el largo
+ */
+static void test_bit_errors(void) {
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD], out[TELEMETRY_FRAME_MAX];
+    frame_t frame;
+    uint32_t data_flips = 0, code_flips = 0, code_accepted = 0;
+
+    for (int trial = 0; trial < 200; trial++) {
+        size_t len = next_random() % (TELEMETRY_MAX_PAYLOAD + 1);
+        random_data(payload, len, 32);
+        size_t n = telemetry_frame_encode(TELEMETRY_SAMPLE, trial & 0xFF, next_random(), payload, len, out) - 1;
+
+        // Posicion de los codigos de COBS
+        bool is_code[TELEMETRY_FRAME_MAX] = { false };
+        for (size_t i = 0; i < n; i += out[i]) { is_code[i] = true; }
+
+        for (size_t i = 0; i < n; i++) {
+            for (int bit = 0; bit < 8; bit++) {
+                out[i] ^= 1u << bit;
+                bool accepted = frame_decode(out, n, &frame);
+                out[i] ^= 1u << bit;
+                if (is_code[i]) {
+                    code_flips++;
+                    code_accepted += accepted;
+                } else {
+                    data_flips++;
+                    CHECK(!accepted);
+                }
+            }
+        }
+    }
+    printf("errores de un bit: %u en datos, todos detectados; %u en codigos COBS, %u aceptados\n", data_flips,
+           code_flips, code_accepted);
+    // Un codigo alterado que igual decodifica deja una trama de otro largo o con ceros movidos:
+    // el CRC la rechaza salvo con probabilidad 2^-16
+    CHECK(code_accepted <= code_flips / 10000 + 1);
+}
+
+/**
+ * @brief Flujo de tramas con basura intercalada y bytes perdidos: al separar
+ * por el delimitador se recuperan todas las tramas sanas y ninguna falsa
+ */
+static void test_stream(void) {
+    static uint8_t stream[200000];
+    static uint8_t sent_ok[4000];
+    uint8_t payload[TELEMETRY_MAX_PAYLOAD], out[TELEMETRY_FRAME_MAX];
+    size_t pos = 0;
+    uint32_t frames = 0, damaged = 0;
+
+    for (frames = 0; frames < 4000; frames++) {
+        size_t len = next_random() % (TELEMETRY_MAX_PAYLOAD + 1);
+        random_data(payload, len, 32);
+        // El contenido se puede reconstruir del numero de trama
+        for (size_t i = 0; i + 1 < len; i += 2) {
+            payload[i] = (frames & 0xFF) | 1;
+            payload[i + 1] = (frames >> 8) | 1;
+        }
+        size_t n = telemetry_frame_encode(TELEMETRY_SAMPLE, frames & 0xFF, frames, payload, len, out);
+        sent_ok[frames] = 1;
+        // Algunas tramas pierden un byte en el camino
+        if (next_random() % 20 == 0 && n > 2) {
+            size_t drop = next_random() % (n - 1);
+            memmove(&out[drop], &out[drop + 1], n - drop - 1);
+            n--;
+            sent_ok[frames] = 0;
+            damaged++;
+        }
+        memcpy(&stream[pos], out, n);
+        pos += n;
+        // Y a veces hay basura entre tramas, terminada en el delimitador
+        if (next_random() % 25 == 0) {
+            size_t junk = 1 + next_random() % 40;
+            random_data(&stream[pos], junk, 8);
+            pos += junk;
+            stream[pos++] = 0;
+        }
+    }
+
+    // Separo por el delimitador
+    uint32_t received = 0, wrong = 0, start = 0;
+    frame_t frame;
+    for (size_t i = 0; i < pos; i++) {
+        if (stream[i]) { continue; }
+        if (i > start && frame_decode(&stream[start], i - start, &frame)) {
+            if (frame.time_us >= 4000 || !sent_ok[frame.time_us] || frame.seq != (frame.time_us & 0xFF)) {
+                wrong++;
+            } else {
+                sent_ok[frame.time_us] = 2;
+                received++;
+            }
+        }
+        start = i + 1;
+    }
+    printf("flujo: %u tramas, %u dañadas, %u recuperadas, %u falsas\n", frames, damaged, received, wrong);
+    CHECK_EQ(received, frames - damaged);
+    CHECK_EQ(wrong, 0);
+}
+
+int main(void) {
+    test_crc();
+    test_cobs_vectors();
+    test_cobs_random();
+    test_frames();
+    test_bit_errors();
+    test_stream();
+    return check_result("telemetry_frame");
+}
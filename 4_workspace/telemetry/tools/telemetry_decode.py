@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""Decodificador de la telemetria binaria (tramas COBS con CRC16).
+
+Uso:
+    telemetry_decode.py /dev/ttyACM0       # muestra las tramas del puerto, las lineas escritas van al shell
+    telemetry_decode.py /dev/ttyACM0 --i2c bus.trace   # ademas guarda la traza del bus I2C
+    telemetry_decode.py --bench 10         # mide el decodificador durante 10 s sobre un pty
+"""
+
+import argparse
+import os
+import struct
+import sys
+import threading
+import time
+
+HEADER = struct.Struct("<BBI")
+TYPES = {1: "SAMPLE", 2: "STATS", 3: "EVENT", 4: "TEXT", 5: "I2C"}
+I2C_HEADER = struct.Struct("<IHBBhB")
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC16-CCITT (polinomio 0x1021), igual que telemetry_crc16."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+        crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray(b"\x00")
+    code_pos, code = 0, 1
+    for i, byte in enumerate(data):
+        if byte:
+            out.append(byte)
+            code += 1
+        if not byte or code == 0xFF:
+            out[code_pos] = code
+            code = 1
+            # Un bloque de 254 bytes al final no necesita otro codigo
+            if byte and i + 1 == len(data):
+                return bytes(out)
+            code_pos = len(out)
+            out.append(0)
+    out[code_pos] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if not code or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def frame_encode(ftype, seq, time_us, payload):
+    raw = HEADER.pack(ftype, seq, time_us) + payload
+    return cobs_encode(raw + struct.pack("<H", crc16(raw))) + b"\x00"
+
+
+def parse_payload(ftype, payload):
+    if ftype == 1:
+        return payload[0], struct.unpack("<%df" % ((len(payload) - 1) // 4), payload[1:])
+    if ftype == 2:
+        return payload[0], struct.unpack("<4f", payload[1:17])
+    if ftype == 3:
+        return struct.unpack("<HI", payload[:6])
+    if ftype == 4:
+        return payload.decode(errors="replace")
+    if ftype == 5:
+        return i2c_format(payload)
+    return payload
+
+
+def i2c_format(payload):
+    """Transaccion I2C en el formato de texto de i2c_trace_format."""
+    time_us, duration, addr, flags, result, length = I2C_HEADER.unpack_from(payload)
+    return "%d %d %02x %s %s %d %d %s" % (time_us, duration, addr, "R" if flags & 1 else "W", "N" if flags & 2 else "S",
+                                         result, length, payload[I2C_HEADER.size:].hex())
+
+
+class Decoder:
+    """Separa las tramas por el delimitador cero y verifica el CRC."""
+
+    def __init__(self):
+        self.pending = bytearray()
+        self.frames = 0
+        self.errors = 0
+        self.lost = 0
+        self.expected = None
+
+    def feed(self, data):
+        self.pending += data
+        *chunks, self.pending = self.pending.split(b"\x00")
+        for chunk in chunks:
+            raw = cobs_decode(chunk) if chunk else None
+            if not raw or len(raw) < HEADER.size + 2 or crc16(raw[:-2]) != struct.unpack("<H", raw[-2:])[0]:
+                self.errors += 1
+                continue
+            ftype, seq, time_us = HEADER.unpack_from(raw)
+            # Saltos de secuencia hacia adelante son tramas perdidas, hacia atras son tramas invertidas
+            if self.expected is not None:
+                gap = (seq - self.expected) & 0xFF
+                if gap < 128:
+                    self.lost += gap
+            self.expected = (seq + 1) & 0xFF
+            self.frames += 1
+            yield ftype, seq, time_us, raw[HEADER.size:-2]
+
+
+def monitor(path, trace=None):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    try:
+        import tty
+        tty.setraw(fd)
+    except (ImportError, OSError):
+        pass
+
+    # Lo que se escribe en la consola se envia como comando al shell del Pico
+    def commands():
+        for line in sys.stdin:
+            os.write(fd, line.encode())
+
+    threading.Thread(target=commands, daemon=True).start()
+    decoder = Decoder()
+    while True:
+        data = os.read(fd, 4096)
+        if not data:
+            break
+        for ftype, seq, time_us, payload in decoder.feed(data):
+            print("%10.6f %3d %-6s %s" % (time_us / 1e6, seq, TYPES.get(ftype, ftype), parse_payload(ftype, payload)))
+            if trace and ftype == 5:
+                trace.write(i2c_format(payload) + "\n")
+                trace.flush()
+
+
+def bench(seconds):
+    """Escribe tramas en un pty como si fuera el puerto CDC y mide el decodificador."""
+    import tty
+    master, slave = os.openpty()
+    tty.setraw(slave)
+    stop = threading.Event()
+
+    def writer():
+        frames = [frame_encode(1, seq, seq * 1000, struct.pack("<B4f", 0, 25.0, seq, -1.0, 1e6)) for seq in range(256)]
+        block = b"".join(frames)
+        while not stop.is_set():
+            os.write(master, block)
+
+    thread = threading.Thread(target=writer, daemon=True)
+    thread.start()
+    decoder = Decoder()
+    received = 0
+    start = time.monotonic()
+    while time.monotonic() - start < seconds:
+        data = os.read(slave, 65536)
+        received += len(data)
+        for _ in decoder.feed(data):
+            pass
+    elapsed = time.monotonic() - start
+    stop.set()
+    print("%.1f kB/s, %d tramas (%.0f/s), %d errores, %d perdidas" %
+          (received / elapsed / 1000, decoder.frames, decoder.frames / elapsed, decoder.errors, decoder.lost))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", nargs="?", help="puerto serie del Pico")
+    parser.add_argument("--bench", type=float, metavar="SEG", help="mide el decodificador sobre un pty")
+    parser.add_argument("--i2c", metavar="ARCHIVO", help="guarda las transacciones I2C como traza de texto")
+    args = parser.parse_args()
+    if args.bench:
+        bench(args.bench)
+    elif args.port:
+        if args.i2c:
+            with open(args.i2c, "w") as trace:
+                monitor(args.port, trace)
+        else:
+            monitor(args.port)
+    else:
+        parser.print_help()
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,38 @@
+#ifndef _CHECK_H_
+#define _CHECK_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Fallas de la prueba en curso, una prueba es un ejecutable
+static int check_failures;
+
+// Verifica una condicion, sigue con la prueba para ver todas las fallas
+#define CHECK(cond) do {                                                        \
+    if (!(cond)) {                                                              \
+        fprintf(stderr, "%s:%d: falla %s\n", __FILE__, __LINE__, #cond);        \
+        check_failures++;                                                       \
+    }                                                                           \
+} while (0)
+
+// Igual que CHECK con los dos valores enteros en el mensaje
+#define CHECK_EQ(a, b) do {                                                     \
+    long long _a = (long long)(a), _b = (long long)(b);                         \
+    if (_a != _b) {                                                             \
+        fprintf(stderr, "%s:%d: falla %s == %s (%lld != %lld)\n",               \
+                __FILE__, __LINE__, #a, #b, _a, _b);                            \
+        check_failures++;                                                       \
+    }                                                                           \
+} while (0)
+
+/**
+ * @brief Resultado de la prueba para devolver desde main
+ * @param name nombre de la prueba
+ * @return EXIT_SUCCESS si no hubo fallas
+ */
+static inline int check_result(const char *name) {
+    printf("%s: %s (%d fallas)\n", name, check_failures ? "FALLA" : "ok", check_failures);
+    return check_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#endif
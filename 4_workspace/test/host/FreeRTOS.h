@@ -0,0 +1,28 @@
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+// Lo minimo de FreeRTOS para correr las bibliotecas en la PC, no es FreeRTOS.
+// Un solo hilo: cada tarea corre cuando la prueba llama a host_task_run
+#include <stdint.h>
+#include "pico/stdlib.h"
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE                         0
+#define pdTRUE                          1
+#define pdPASS                          pdTRUE
+#define pdFAIL                          pdFALSE
+#define portMAX_DELAY                   ((TickType_t)0xFFFFFFFF)
+
+#define configMINIMAL_STACK_SIZE        128
+#define configMAX_PRIORITIES            8
+#define configTICK_RATE_HZ              1000
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   3
+#define configSTACK_DEPTH_TYPE          uint32_t
+
+#define pdMS_TO_TICKS(ms)               ((TickType_t)((uint64_t)(ms) * configTICK_RATE_HZ / 1000))
+#define portYIELD_FROM_ISR(x)           ((void)(x))
+
+#endif
@@ -0,0 +1,139 @@
+#include <setjmp.h>
+#include <string.h>
+
+#include "task.h"
+
+// Tareas que se pueden crear en una prueba
+#define HOST_MAX_TASKS      16
+
+/**
+ * @brief Una tarea. No tiene stack propio: corre en el de host_task_run y,
+ * cuando se bloquea, vuelve ahi con longjmp. La proxima vez empieza de nuevo
+ * desde el principio de la funcion, asi que sirve para tareas cuyo lazo no
+ * guarda estado local entre un bloqueo y el siguiente
+ */
+struct host_task {
+    TaskFunction_t code;
+    void *params;
+    const char *name;
+    UBaseType_t priority;
+    uint32_t notify[configTASK_NOTIFICATION_ARRAY_ENTRIES];
+    TickType_t timeout;         // Timeout del ultimo bloqueo
+    jmp_buf blocked;
+};
+
+int host_critical_nesting = 0;
+
+static struct host_task tasks[HOST_MAX_TASKS];
+static size_t task_count = 0;
+static struct host_task *current = NULL;
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint32_t stack, void *params, UBaseType_t priority,
+                       TaskHandle_t *handle) {
+    (void)stack;
+    if (task_count == HOST_MAX_TASKS) { return pdFAIL; }
+    struct host_task *task = &tasks[task_count++];
+    memset(task, 0, sizeof(*task));
+    task->code = code;
+    task->params = params;
+    task->name = name;
+    task->priority = priority;
+    if (handle) { *handle = task; }
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return current;
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)(host_time_us * configTICK_RATE_HZ / 1000000);
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task) {
+    return (task ? task : current)->priority;
+}
+
+void vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority) {
+    (task ? task : current)->priority = priority;
+}
+
+/**
+ * @brief Toma una notificacion. Sin notificaciones pendientes y con timeout,
+ * la tarea se bloquea: vuelve a host_task_run
+ */
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear, TickType_t timeout) {
+    uint32_t value = current->notify[index];
+    if (!value) {
+        if (timeout) {
+            current->timeout = timeout;
+            longjmp(current->blocked, 1);
+        }
+        return 0;
+    }
+    current->notify[index] = clear ? 0 : value - 1;
+    return value;
+}
+
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index) {
+    task->notify[index]++;
+    return pdPASS;
+}
+
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t *to_higher_priority_task) {
+    task->notify[index]++;
+    if (to_higher_priority_task && (!current || task->priority > current->priority)) { *to_higher_priority_task = pdTRUE; }
+}
+
+/**
+ * @brief Busca una tarea por nombre
+ * @return la tarea o NULL
+ */
+TaskHandle_t host_task_find(const char *name) {
+    for (size_t i = 0; i < task_count; i++) {
+        if (!strcmp(tasks[i].name, name)) { return &tasks[i]; }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Corre una tarea hasta que se bloquea esperando una notificacion
+ * @param task tarea
+ * @return false si la funcion de la tarea termino
+ */
+bool host_task_run(TaskHandle_t task) {
+    struct host_task *previous = current;
+    bool blocked = false;
+
+    current = task;
+    if (!setjmp(task->blocked)) {
+        task->code(task->params);
+    } else {
+        blocked = true;
+    }
+    current = previous;
+    return blocked;
+}
+
+/**
+ * @brief Notificaciones pendientes de una tarea
+ */
+uint32_t host_task_notified(TaskHandle_t task, UBaseType_t index) {
+    return task->notify[index];
+}
+
+/**
+ * @brief Timeout con el que la tarea se bloqueo por ultima vez
+ */
+TickType_t host_task_timeout(TaskHandle_t task) {
+    return task->timeout;
+}
+
+/**
+ * @brief Borra todas las tareas, para empezar otra prueba
+ */
+void host_task_reset(void) {
+    task_count = 0;
+    current = NULL;
+    host_critical_nesting = 0;
+}
@@ -0,0 +1,7 @@
+#ifndef _PICO_H
+#define _PICO_H
+
+// Cabecera base del SDK, en la PC solo lo de pico/stdlib.h
+#include "pico/stdlib.h"
+
+#endif
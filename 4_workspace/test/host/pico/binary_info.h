@@ -0,0 +1,7 @@
+#ifndef _PICO_BINARY_INFO_H
+#define _PICO_BINARY_INFO_H
+
+// La informacion del binario no existe en la PC
+#define bi_decl(...)
+
+#endif
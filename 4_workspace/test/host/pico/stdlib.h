@@ -0,0 +1,33 @@
+#ifndef _PICO_STDLIB_H
+#define _PICO_STDLIB_H
+
+// Lo minimo del SDK para compilar los drivers en la PC, no es el SDK
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PICO_ON_DEVICE          0
+#define PICO_OK                 0
+#define PICO_ERROR_GENERIC      (-1)
+#define PICO_ERROR_TIMEOUT      (-2)
+
+#define _u(x)                   x ## u
+
+// En la PC no hay flash ni RAM separadas
+#define __not_in_flash_func(f)  f
+
+typedef unsigned int uint;
+
+// Reloj simulado en microsegundos, solo avanza con sleep_us o desde la prueba
+extern uint64_t host_time_us;
+
+// Detiene el programa con el mensaje. Sin noreturn: una prueba la puede reemplazar
+// con --wrap=panic para ver que se llamo y seguir
+void panic(const char *fmt, ...);
+
+static inline uint32_t time_us_32(void) { return (uint32_t)host_time_us; }
+static inline uint64_t time_us_64(void) { return host_time_us; }
+static inline void sleep_us(uint64_t us) { host_time_us += us; }
+static inline void sleep_ms(uint32_t ms) { host_time_us += (uint64_t)ms * 1000; }
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#include <stdbool.h>
+#include "FreeRTOS.h"
+
+typedef struct host_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+// Anidamiento de secciones criticas, la prueba verifica que vuelva a cero
+extern int host_critical_nesting;
+
+#define taskENTER_CRITICAL()                (host_critical_nesting++)
+#define taskEXIT_CRITICAL()                 (host_critical_nesting--)
+#define taskENTER_CRITICAL_FROM_ISR()       ((UBaseType_t)host_critical_nesting++)
+#define taskEXIT_CRITICAL_FROM_ISR(state)   (host_critical_nesting = (int)(state))
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name, uint32_t stack, void *params, UBaseType_t priority,
+                       TaskHandle_t *handle);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+TickType_t xTaskGetTickCount(void);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task);
+void vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority);
+
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear, TickType_t timeout);
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index);
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t *to_higher_priority_task);
+
+#define ulTaskNotifyTake(clear, timeout)            ulTaskNotifyTakeIndexed(0, (clear), (timeout))
+#define xTaskNotifyGive(task)                       xTaskNotifyGiveIndexed((task), 0)
+#define vTaskNotifyGiveFromISR(task, woken)         vTaskNotifyGiveIndexedFromISR((task), 0, (woken))
+
+// Control de las tareas desde la prueba
+TaskHandle_t host_task_find(const char *name);
+bool host_task_run(TaskHandle_t task);
+uint32_t host_task_notified(TaskHandle_t task, UBaseType_t index);
+TickType_t host_task_timeout(TaskHandle_t task);
+void host_task_reset(void);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef INC_TIMERS_H
+#define INC_TIMERS_H
+
+#include "FreeRTOS.h"
+
+typedef void (*PendedFunction_t)(void *, uint32_t);
+
+#endif
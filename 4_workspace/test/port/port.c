@@ -0,0 +1,170 @@
+// pthread con -std=c11
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Hilo de una tarea. Vive en la punta del stack de la tarea, que en este
+ * port no se usa para otra cosa
+ */
+typedef struct {
+    pthread_t thread;
+    pthread_cond_t turn;        // Se avisa cuando le toca correr
+    bool running;
+    TaskFunction_t code;
+    void *params;
+} host_thread_t;
+
+void (*host_port_isr)(void) = NULL;
+TickType_t host_port_tick_limit = portMAX_DELAY;
+bool host_port_timed_out = false;
+
+// El lock solo protege el paso del turno: las tareas nunca corren a la vez
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ended = PTHREAD_COND_INITIALIZER;
+static bool scheduler_ended;
+static UBaseType_t critical_nesting;
+static bool yield_pending;
+
+/**
+ * @brief Hilo de la tarea en curso: pxTopOfStack es el primer campo del TCB y
+ * apunta al hilo, como lo devolvio pxPortInitialiseStack
+ */
+static host_thread_t *current_thread(void) {
+    return *(host_thread_t **)xTaskGetCurrentTaskHandle();
+}
+
+static void *thread_main(void *arg) {
+    host_thread_t *thread = arg;
+
+    pthread_mutex_lock(&lock);
+    while (!thread->running) { pthread_cond_wait(&thread->turn, &lock); }
+    pthread_mutex_unlock(&lock);
+    // Las tareas no terminan, sin vTaskDelete de la propia tarea
+    thread->code(thread->params);
+    return NULL;
+}
+
+/**
+ * @brief Elige la proxima tarea y le pasa el turno. El hilo que llama espera
+ * hasta que lo vuelvan a elegir
+ */
+static void switch_context(void) {
+    host_thread_t *prev = current_thread();
+    vTaskSwitchContext();
+    host_thread_t *next = current_thread();
+    if (next == prev) { return; }
+
+    pthread_mutex_lock(&lock);
+    prev->running = false;
+    next->running = true;
+    pthread_cond_signal(&next->turn);
+    while (!prev->running) { pthread_cond_wait(&prev->turn, &lock); }
+    pthread_mutex_unlock(&lock);
+}
+
+/**
+ * @brief Guarda el hilo de la tarea en la punta del stack y lo crea esperando su turno
+ */
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters) {
+    uintptr_t end = (uintptr_t)(pxTopOfStack + 1);
+    host_thread_t *thread = (host_thread_t *)((end - sizeof(host_thread_t)) & ~(uintptr_t)(portBYTE_ALIGNMENT - 1));
+
+    memset(thread, 0, sizeof(*thread));
+    thread->code = pxCode;
+    thread->params = pvParameters;
+    pthread_cond_init(&thread->turn, NULL);
+    pthread_create(&thread->thread, NULL, thread_main, thread);
+    return (StackType_t *)thread;
+}
+
+void vPortYield(void) {
+    if (critical_nesting) {
+        yield_pending = true;
+    } else {
+        switch_context();
+    }
+}
+
+void vPortEnterCritical(void) {
+    critical_nesting++;
+}
+
+void vPortExitCritical(void) {
+    if (--critical_nesting == 0 && yield_pending) {
+        yield_pending = false;
+        switch_context();
+    }
+}
+
+uint32_t ulPortSetInterruptMaskFromISR(void) {
+    vPortEnterCritical();
+    return 0;
+}
+
+void vPortClearInterruptMaskFromISR(uint32_t state) {
+    (void)state;
+    vPortExitCritical();
+}
+
+/**
+ * @brief Tick virtual: la tarea de menor prioridad, se turna con la ociosa. Solo
+ * corre con todas las demas bloqueadas, asi que el tiempo salta de un evento al
+ * siguiente y un handler no consume ticks
+ */
+static void tick_task(void *params) {
+    (void)params;
+    while (1) {
+        vPortEnterCritical();
+        if (xTaskIncrementTick() != pdFALSE) { vPortYield(); }
+        if (host_port_isr) { host_port_isr(); }
+        vPortExitCritical();
+
+        if (xTaskGetTickCount() >= host_port_tick_limit) {
+            host_port_timed_out = true;
+            vTaskEndScheduler();
+        }
+        taskYIELD();
+    }
+}
+
+/**
+ * @brief Crea la tarea del tick y le da el turno a la primera tarea. Vuelve
+ * cuando alguna tarea llama a vTaskEndScheduler
+ */
+BaseType_t xPortStartScheduler(void) {
+    critical_nesting = 0;
+    yield_pending = false;
+    scheduler_ended = false;
+    // Con la prioridad de la ociosa no desplaza a la tarea elegida. Sin heap, como
+    // la ociosa y la de los timers, para que una prueba pueda contar las reservas
+    static StaticTask_t tick_control;
+    static StackType_t tick_stack[configMINIMAL_STACK_SIZE];
+    xTaskCreateStatic(tick_task, "Tick", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, tick_stack, &tick_control);
+
+    host_thread_t *first = current_thread();
+    pthread_mutex_lock(&lock);
+    first->running = true;
+    pthread_cond_signal(&first->turn);
+    while (!scheduler_ended) { pthread_cond_wait(&ended, &lock); }
+    pthread_mutex_unlock(&lock);
+    return pdFALSE;
+}
+
+/**
+ * @brief Despierta a xPortStartScheduler. La tarea que llama no vuelve a correr
+ */
+void vPortEndScheduler(void) {
+    host_thread_t *self = current_thread();
+
+    pthread_mutex_lock(&lock);
+    scheduler_ended = true;
+    self->running = false;
+    pthread_cond_signal(&ended);
+    while (!self->running) { pthread_cond_wait(&self->turn, &lock); }
+    pthread_mutex_unlock(&lock);
+}
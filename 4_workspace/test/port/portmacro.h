@@ -0,0 +1,73 @@
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+// Port de FreeRTOS para la PC con hilos POSIX, para correr el kernel del proyecto
+// sin cambios en las pruebas. Cada tarea es un hilo y corre una sola por vez: el
+// cambio de contexto pasa el turno de un hilo a otro. El tiempo es virtual, el
+// tick avanza cuando todas las tareas estan bloqueadas (ver port.c)
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define portCHAR                    char
+#define portFLOAT                   float
+#define portDOUBLE                  double
+#define portLONG                    long
+#define portSHORT                   short
+#define portSTACK_TYPE              uintptr_t
+#define portBASE_TYPE               long
+#define portPOINTER_SIZE_TYPE       uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY               ((TickType_t)0xffffffffUL)
+#define portTICK_TYPE_IS_ATOMIC     1
+
+#define portSTACK_GROWTH            (-1)
+#define portTICK_PERIOD_MS          ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT          16
+
+// Un cambio pedido dentro de una seccion critica se hace al salir, como PendSV
+#define portYIELD()                 vPortYield()
+#define portYIELD_FROM_ISR(x)       do { if (x) { vPortYield(); } } while (0)
+#define portEND_SWITCHING_ISR(x)    portYIELD_FROM_ISR(x)
+
+// Las interrupciones simuladas corren en la tarea del tick con la seccion critica tomada
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()                    vPortEnterCritical()
+#define portEXIT_CRITICAL()                     vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()       ulPortSetInterruptMaskFromISR()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    vPortClearInterruptMaskFromISR(x)
+#define portCRITICAL_NESTING_IN_TCB             0
+
+#define portTASK_FUNCTION_PROTO(vFunction, pvParameters)    void vFunction(void *pvParameters)
+#define portTASK_FUNCTION(vFunction, pvParameters)          void vFunction(void *pvParameters)
+
+#define portNOP()
+#define portMEMORY_BARRIER()        __asm volatile("" ::: "memory")
+
+void vPortYield(void);
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+uint32_t ulPortSetInterruptMaskFromISR(void);
+void vPortClearInterruptMaskFromISR(uint32_t state);
+
+// Interrupcion simulada: se llama en cada tick, despues de xTaskIncrementTick
+extern void (*host_port_isr)(void);
+// Tick en el que el port termina el scheduler, para que una prueba trabada no quede colgada
+extern TickType_t host_port_tick_limit;
+// true si el scheduler termino por host_port_tick_limit
+extern bool host_port_timed_out;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif